@@ -152,6 +152,21 @@ if (NOT WINDOWS)
   endif (HDF5_ENABLE_DIRECT_VFD)
 endif (NOT WINDOWS)
 
+#-----------------------------------------------------------------------------
+#  Check if the asynchronous I/O driver can be built: it is Linux-only and
+#  needs the kernel's io_uring or native AIO interface
+#-----------------------------------------------------------------------------
+if (CMAKE_SYSTEM_NAME MATCHES "Linux")
+  option (HDF5_ENABLE_ASYNC_VFD "Build the Linux asynchronous I/O Virtual File Driver" OFF)
+  if (HDF5_ENABLE_ASYNC_VFD)
+    CHECK_INCLUDE_FILES ("linux/io_uring.h" H5_HAVE_LINUX_IO_URING_H)
+    CHECK_INCLUDE_FILES ("linux/aio_abi.h"  H5_HAVE_LINUX_AIO_ABI_H)
+    if (H5_HAVE_LINUX_IO_URING_H OR H5_HAVE_LINUX_AIO_ABI_H)
+      set (H5_HAVE_ASYNC_VFD 1)
+    endif (H5_HAVE_LINUX_IO_URING_H OR H5_HAVE_LINUX_AIO_ABI_H)
+  endif (HDF5_ENABLE_ASYNC_VFD)
+endif (CMAKE_SYSTEM_NAME MATCHES "Linux")
+
 #-----------------------------------------------------------------------------
 # Check if C has __float128 extension
 #-----------------------------------------------------------------------------
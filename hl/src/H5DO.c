@@ -97,6 +97,82 @@ done:
     return(ret_value);
 } /* end H5DOwrite_chunk() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5DOread_chunk
+ *
+ * Purpose:     Reads an entire chunk from the file directly, as it is
+ *		stored: the filters are not applied.  The chunk's filter
+ *		mask is returned in FILTERS.  BUF must be at least as large
+ *		as the size returned by H5Dget_chunk_storage_size.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5DOread_chunk(hid_t dset_id, hid_t dxpl_id, const hsize_t *offset,
+         uint32_t *filters, void *buf)
+{
+    hbool_t created_dxpl = FALSE;       /* Whether we created a DXPL */
+    hbool_t do_direct_read = TRUE;      /* Flag for direct reads */
+    herr_t  ret_value = FAIL;           /* Return value */
+
+    /* Check arguments */
+    if(dset_id < 0)
+        goto done;
+    if(!buf)
+        goto done;
+    if(!offset)
+        goto done;
+    if(!filters)
+        goto done;
+
+    /* If the user passed in a default DXPL, create one to pass to H5Dread() */
+    if(H5P_DEFAULT == dxpl_id) {
+	if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+            goto done;
+        created_dxpl = TRUE;
+    } /* end if */
+    else if(TRUE != H5Pisa_class(dxpl_id, H5P_DATASET_XFER))
+        goto done;
+
+    /* Set direct read parameters */
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME, &offset) < 0)
+        goto done;
+
+    /* Read chunk */
+    if(H5Dread(dset_id, 0, H5S_ALL, H5S_ALL, dxpl_id, buf) < 0)
+        goto done;
+
+    /* Retrieve the chunk's filter mask */
+    if(H5Pget(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME, filters) < 0)
+        goto done;
+
+    /* Indicate success */
+    ret_value = SUCCEED;
+
+done:
+    if(created_dxpl) {
+        if(H5Pclose(dxpl_id) < 0)
+            ret_value = FAIL;
+    } /* end if */
+    else if(dxpl_id >= 0) {
+        /* Reset the direct read parameters on user DXPL */
+        hsize_t *no_offset = NULL;
+
+        do_direct_read = FALSE;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+            ret_value = FAIL;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME, &no_offset) < 0)
+            ret_value = FAIL;
+    } /* end else */
+
+    return(ret_value);
+} /* end H5DOread_chunk() */
+
 
 /*
  * Function:	H5DOappend()
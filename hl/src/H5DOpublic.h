@@ -30,6 +30,9 @@ extern "C" {
 H5_HLDLL herr_t H5DOwrite_chunk(hid_t dset_id, hid_t dxpl_id, uint32_t filters, 
     const hsize_t *offset, size_t data_size, const void *buf);
 
+H5_HLDLL herr_t H5DOread_chunk(hid_t dset_id, hid_t dxpl_id,
+    const hsize_t *offset, uint32_t *filters, void *buf);
+
 H5_HLDLL herr_t H5DOappend(hid_t dset_id, hid_t dxpl_id, unsigned axis,
     size_t extension, hid_t memtype, const void *buf);
 
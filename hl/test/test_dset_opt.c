@@ -34,6 +34,7 @@
 #define DATASETNAME4        "data_conv"
 #define DATASETNAME5        "contiguous_dset"
 #define DATASETNAME6        "invalid_argue"
+#define DATASETNAME7        "direct_read"
 #define RANK         2
 #define NX     16
 #define NY     16
@@ -1089,10 +1090,185 @@ error:
     return 1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:	test_direct_chunk_read
+ *
+ * Purpose:	Test the basic functionality of H5DOread_chunk and
+ *              H5Dget_chunk_storage_size: reading chunks which are still
+ *              dirty in the chunk cache, returning the filter mask of a
+ *              chunk written with H5DOwrite_chunk, and chunks that are
+ *              not allocated.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifdef H5_HAVE_FILTER_DEFLATE
+static int
+test_direct_chunk_read (hid_t file)
+{
+    hid_t       dataspace = -1, dataset = -1;
+    hid_t       cparms = -1, dxpl = -1;
+    hsize_t     dims[2]  = {NX, NY};
+    hsize_t     new_dims[2]  = {NX + CHUNK_NX, NY};
+    hsize_t     maxdims[2] = {H5S_UNLIMITED, H5S_UNLIMITED};
+    hsize_t     chunk_dims[2] ={CHUNK_NX, CHUNK_NY};
+    hsize_t     offset[2];
+    hsize_t     chunk_nbytes;
+    herr_t      status;
+    int         data[NX][NY];
+    int         direct_buf[CHUNK_NX][CHUNK_NY];
+    int         check_chunk[CHUNK_NX][CHUNK_NY];
+    uint32_t    filter_mask;
+    uLongf      z_dst_nbytes;
+    void        *inbuf = NULL;          /* Buffer for stored chunk */
+    int         i, j, k, n;
+
+    TESTING("basic functionality of H5DOread_chunk");
+
+    /* Create a compressed dataset with unlimited dimensions */
+    if((dataspace = H5Screate_simple(RANK, dims, maxdims)) < 0)
+        goto error;
+    if((cparms = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+    if(H5Pset_chunk(cparms, RANK, chunk_dims) < 0)
+        goto error;
+    if(H5Pset_deflate(cparms, 6) < 0)
+        goto error;
+    if((dataset = H5Dcreate2(file, DATASETNAME7, H5T_NATIVE_INT, dataspace, H5P_DEFAULT,
+			cparms, H5P_DEFAULT)) < 0)
+        goto error;
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+
+    /* Write the data, which stays (dirty) in the chunk cache */
+    for(i = n = 0; i < NX; i++)
+        for(j = 0; j < NY; j++)
+	    data[i][j] = n++;
+    if(H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, data) < 0)
+        goto error;
+
+    /* Read every chunk as it is stored and decompress it here */
+    for(i = 0; i < NX / CHUNK_NX; i++)
+        for(j = 0; j < NY / CHUNK_NY; j++) {
+            offset[0] = (hsize_t)(i * CHUNK_NX);
+            offset[1] = (hsize_t)(j * CHUNK_NY);
+            if(H5Dget_chunk_storage_size(dataset, offset, &chunk_nbytes) < 0)
+                goto error;
+            if(chunk_nbytes == 0 || chunk_nbytes > sizeof(check_chunk) + 64)
+                goto error;
+            if(NULL == (inbuf = HDmalloc((size_t)chunk_nbytes)))
+                goto error;
+            if(H5DOread_chunk(dataset, dxpl, offset, &filter_mask, inbuf) < 0)
+                goto error;
+            if(filter_mask != 0)
+                goto error;
+            z_dst_nbytes = (uLongf)sizeof(check_chunk);
+            if(Z_OK != uncompress((Bytef *)check_chunk, &z_dst_nbytes, (const Bytef *)inbuf, (uLong)chunk_nbytes))
+                goto error;
+            if(z_dst_nbytes != sizeof(check_chunk))
+                goto error;
+            HDfree(inbuf);
+            inbuf = NULL;
+
+            for(k = 0; k < CHUNK_NX; k++)
+                for(n = 0; n < CHUNK_NY; n++)
+                    if(check_chunk[k][n] != data[i * CHUNK_NX + k][j * CHUNK_NY + n]) {
+                        printf("    1. Read different values than written.");
+                        printf("    At chunk %d,%d index %d,%d\n", i, j, k, n);
+                        goto error;
+                    }
+        }
+
+    /* Write one chunk uncompressed, skipping the filter, and read it back */
+    for(i = n = 0; i < CHUNK_NX; i++)
+        for(j = 0; j < CHUNK_NY; j++)
+	    direct_buf[i][j] = n++ * 3;
+    offset[0] = CHUNK_NX;
+    offset[1] = CHUNK_NY;
+    if(H5DOwrite_chunk(dataset, dxpl, (uint32_t)1, offset, sizeof(direct_buf), direct_buf) < 0)
+        goto error;
+    if(H5Dget_chunk_storage_size(dataset, offset, &chunk_nbytes) < 0)
+        goto error;
+    if(chunk_nbytes != sizeof(direct_buf))
+        goto error;
+    if(H5DOread_chunk(dataset, H5P_DEFAULT, offset, &filter_mask, check_chunk) < 0)
+        goto error;
+    if(filter_mask != 1)
+        goto error;
+    if(HDmemcmp(direct_buf, check_chunk, sizeof(direct_buf)))
+        goto error;
+
+    /* Chunks which are not allocated have no storage and can't be read */
+    if(H5Dset_extent(dataset, new_dims) < 0)
+        goto error;
+    offset[0] = NX;
+    offset[1] = 0;
+    if(H5Dget_chunk_storage_size(dataset, offset, &chunk_nbytes) < 0)
+        goto error;
+    if(chunk_nbytes != 0)
+        goto error;
+    H5E_BEGIN_TRY {
+        status = H5DOread_chunk(dataset, dxpl, offset, &filter_mask, check_chunk);
+    } H5E_END_TRY;
+    if(status >= 0)
+        goto error;
+
+    /* Offsets must fall on a chunk's boundary, within the dataset */
+    offset[0] = 1;
+    H5E_BEGIN_TRY {
+        status = H5Dget_chunk_storage_size(dataset, offset, &chunk_nbytes);
+    } H5E_END_TRY;
+    if(status >= 0)
+        goto error;
+    offset[0] = NX + CHUNK_NX;
+    H5E_BEGIN_TRY {
+        status = H5DOread_chunk(dataset, dxpl, offset, &filter_mask, check_chunk);
+    } H5E_END_TRY;
+    if(status >= 0)
+        goto error;
+
+    /* The transfer property list should still work for regular reads */
+    if(H5Sselect_all(dataspace) < 0)
+        goto error;
+    if(H5Dread(dataset, H5T_NATIVE_INT, dataspace, dataspace, dxpl, data) < 0)
+        goto error;
+    if(data[CHUNK_NX][CHUNK_NY + 1] != direct_buf[0][1])
+        goto error;
+
+    /*
+     * Close/release resources.
+     */
+    H5Dclose(dataset);
+    H5Sclose(dataspace);
+    H5Pclose(cparms);
+    H5Pclose(dxpl);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Sclose(dataspace);
+        H5Pclose(cparms);
+        H5Pclose(dxpl);
+    } H5E_END_TRY;
+
+    if(inbuf)
+        HDfree(inbuf);
+
+    return 1;
+}
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
 /*-------------------------------------------------------------------------
  * Function:	Main function
  *
- * Purpose:	Test direct chunk write function H5DOwrite_chunk
+ * Purpose:	Test direct chunk write function H5DOwrite_chunk and direct
+ *              chunk read function H5DOread_chunk
  *
  * Return:	Success:	0
  *
@@ -1122,6 +1298,9 @@ int main( void )
     nerrors += test_skip_compress_write2(file_id);
     nerrors += test_data_conv(file_id);
     nerrors += test_invalid_parameters(file_id);
+#ifdef H5_HAVE_FILTER_DEFLATE
+    nerrors += test_direct_chunk_read(file_id);
+#endif /* H5_HAVE_FILTER_DEFLATE */
 
     if(H5Fclose(file_id) < 0)
         goto error;
@@ -1747,6 +1747,56 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5AC_reset_cache_hit_rate_stats() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_verify_chksum
+ *
+ * Purpose:     Wrapper function for H5C_verify_chksum(), for the
+ *		clients' deserialize callbacks to check the metadata
+ *		checksums of their images with.
+ *
+ * Return:      TRUE if the checksum is good or its verification was
+ *		skipped, FALSE if it is bad.
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5AC_verify_chksum(const H5F_t *f, const void *image, size_t len,
+    uint32_t stored_chksum)
+{
+    hbool_t ret_value;          /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    ret_value = H5C_verify_chksum(f, image, len, stored_chksum);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_verify_chksum() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_get_cache_chksum_stats
+ *
+ * Purpose:     Wrapper function for H5C_get_cache_chksum_stats().
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_get_cache_chksum_stats(H5AC_t *cache_ptr, H5F_mdc_chksum_stats_t *stats_ptr)
+{
+    herr_t ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if(H5C_get_cache_chksum_stats((H5C_t *)cache_ptr, stats_ptr) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_get_cache_chksum_stats() failed.")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_get_cache_chksum_stats() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5AC_set_cache_auto_resize_config
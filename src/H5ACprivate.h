@@ -357,6 +357,10 @@ H5_DLL herr_t H5AC_get_cache_size(H5AC_t *cache_ptr, size_t *max_size_ptr,
     size_t *min_clean_size_ptr, size_t *cur_size_ptr, int32_t *cur_num_entries_ptr);
 H5_DLL herr_t H5AC_get_cache_hit_rate(H5AC_t *cache_ptr, double *hit_rate_ptr);
 H5_DLL herr_t H5AC_reset_cache_hit_rate_stats(H5AC_t *cache_ptr);
+H5_DLL hbool_t H5AC_verify_chksum(const H5F_t *f, const void *image, size_t len,
+    uint32_t stored_chksum);
+H5_DLL herr_t H5AC_get_cache_chksum_stats(H5AC_t *cache_ptr,
+    H5F_mdc_chksum_stats_t *stats_ptr);
 H5_DLL herr_t H5AC_set_cache_auto_resize_config(H5AC_t *cache_ptr,
     H5AC_cache_config_t *config_ptr);
 H5_DLL herr_t H5AC_validate_config(H5AC_cache_config_t *config_ptr);
@@ -105,6 +105,10 @@
 #define H5C_IMAGE_EXTRA_SPACE 0
 #endif /* H5C_DO_MEMORY_SANITY_CHECKS */
 
+/* Nominal speed of the metadata checksum (bytes/second), for estimating
+ * the time saved by skipped verifications */
+#define H5C_CHKSUM_EST_RATE 1.0e9
+
 
 /******************/
 /* Local Typedefs */
@@ -453,6 +457,11 @@ H5C_create(size_t		      max_cache_size,
 
     H5C_stats__reset(cache_ptr);
 
+    cache_ptr->chksums_verified			= 0;
+    cache_ptr->chksum_bytes_verified		= 0;
+    cache_ptr->chksums_skipped			= 0;
+    cache_ptr->chksum_bytes_skipped		= 0;
+
     cache_ptr->prefix[0]			= '\0';  /* empty string */
 
     /* Set return value */
@@ -2581,6 +2590,96 @@ done:
 
 } /* H5C_reset_cache_hit_rate_stats() */
 
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C_verify_chksum()
+ *
+ * Purpose:     Check the metadata checksum stored in an entry's on disk
+ *		image against the checksum of the first LEN bytes of
+ *		the image.
+ *
+ *		The checks are made by the clients' deserialize callbacks,
+ *		which H5C_load_entry() calls once the image has been read,
+ *		through this function, so that the verifications of a
+ *		file opened with H5Pset_skip_metadata_checksums() are all
+ *		skipped here.  The verifications made and skipped are
+ *		counted for H5C_get_cache_chksum_stats().
+ *
+ * Return:      TRUE if the checksums match or the verification was
+ *		skipped, FALSE if they don't match.
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5C_verify_chksum(const H5F_t *f, const void *image, size_t len,
+    uint32_t stored_chksum)
+{
+    H5C_t      *cache_ptr;
+    hbool_t     ret_value = TRUE;       /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(image);
+
+    cache_ptr = f->shared->cache;
+
+    if(f->shared->skip_md_chksum) {
+        if(cache_ptr) {
+            cache_ptr->chksums_skipped++;
+            cache_ptr->chksum_bytes_skipped += (int64_t)len;
+        } /* end if */
+    } /* end if */
+    else {
+        if(cache_ptr) {
+            cache_ptr->chksums_verified++;
+            cache_ptr->chksum_bytes_verified += (int64_t)len;
+        } /* end if */
+        ret_value = (hbool_t)(H5_checksum_metadata(image, len, 0) == stored_chksum);
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_verify_chksum() */
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C_get_cache_chksum_stats()
+ *
+ * Purpose:     Retrieve the counts of metadata checksum verifications
+ *		made and skipped as entries were loaded, and estimate the
+ *		time saved by the skipped ones.  The estimate assumes the
+ *		checksum runs at a nominal H5C_CHKSUM_EST_RATE bytes per
+ *		second; it isn't measured, to keep this call cheap.
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_get_cache_chksum_stats(H5C_t *cache_ptr, H5F_mdc_chksum_stats_t *stats_ptr)
+{
+    herr_t	ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if((cache_ptr == NULL) || (cache_ptr->magic != H5C__H5C_T_MAGIC))
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry.")
+    if(stats_ptr == NULL)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad stats_ptr on entry.")
+
+    stats_ptr->nverified = (hsize_t)cache_ptr->chksums_verified;
+    stats_ptr->bytes_verified = (hsize_t)cache_ptr->chksum_bytes_verified;
+    stats_ptr->nskipped = (hsize_t)cache_ptr->chksums_skipped;
+    stats_ptr->bytes_skipped = (hsize_t)cache_ptr->chksum_bytes_skipped;
+    stats_ptr->time_saved = (double)cache_ptr->chksum_bytes_skipped / H5C_CHKSUM_EST_RATE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_get_cache_chksum_stats() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5C_set_cache_auto_resize_config
@@ -3795,6 +3795,24 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
  *	this field will be reset every automatic resize epoch.
  *
  *
+ * Metadata checksum verification fields:
+ *
+ * The clients' deserialize callbacks check the metadata checksums of the
+ * images they are given with H5C_verify_chksum(), which skips the checks
+ * for files opened with H5Pset_skip_metadata_checksums().  The following
+ * fields count the checks made and skipped since the cache was created.
+ *
+ * chksums_verified: Number of metadata checksums verified.
+ *
+ * chksum_bytes_verified: Total number of bytes covered by the checksums
+ *	verified.
+ *
+ * chksums_skipped: Number of metadata checksum verifications skipped.
+ *
+ * chksum_bytes_skipped: Total number of bytes covered by the checksums
+ *	whose verification was skipped.
+ *
+ *
  * Statistics collection fields:
  *
  * When enabled, these fields are used to collect statistics as described
@@ -4164,6 +4182,12 @@ struct H5C_t {
     int64_t			cache_hits;
     int64_t			cache_accesses;
 
+    /* Fields for metadata checksum verification statistics */
+    int64_t			chksums_verified;
+    int64_t			chksum_bytes_verified;
+    int64_t			chksums_skipped;
+    int64_t			chksum_bytes_skipped;
+
 #if H5C_COLLECT_CACHE_STATS
     /* stats fields */
     int64_t                     hits[H5C__MAX_NUM_TYPE_IDS + 1];
@@ -2000,6 +2000,10 @@ H5_DLL herr_t H5C_create_flush_dependency(void *parent_thing, void *child_thing)
 H5_DLL void * H5C_protect(H5F_t *f, hid_t dxpl_id, const H5C_class_t *type,
     haddr_t addr, void *udata, unsigned flags);
 H5_DLL herr_t H5C_reset_cache_hit_rate_stats(H5C_t *cache_ptr);
+H5_DLL hbool_t H5C_verify_chksum(const H5F_t *f, const void *image, size_t len,
+    uint32_t stored_chksum);
+H5_DLL herr_t H5C_get_cache_chksum_stats(H5C_t *cache_ptr,
+    H5F_mdc_chksum_stats_t *stats_ptr);
 H5_DLL herr_t H5C_resize_entry(void *thing, size_t new_size);
 H5_DLL herr_t H5C_set_cache_auto_resize_config(H5C_t *cache_ptr, H5C_auto_size_ctl_t *config_ptr);
 H5_DLL herr_t H5C_set_evictions_enabled(H5C_t *cache_ptr, hbool_t evictions_enabled);
@@ -39,10 +39,25 @@
 /* Local Typedefs */
 /******************/
 
+/* Callback info for H5Dget_chunk_info_all */
+typedef struct H5D_chunk_info_all_ud_t {
+    unsigned    ndims;                  /* Rank of dataset */
+    size_t      nalloc;                 /* # of chunks the arrays hold */
+    size_t      nchunks;                /* # of chunks stored so far */
+    hsize_t     *offsets;               /* Logical offsets of chunks */
+    unsigned    *filter_masks;          /* Filter masks of chunks */
+    haddr_t     *addrs;                 /* Addresses of chunks */
+    hsize_t     *nbytes;                /* Stored sizes of chunks */
+} H5D_chunk_info_all_ud_t;
+
 
 /********************/
 /* Local Prototypes */
 /********************/
+static int H5D__get_num_chunks_cb(const hsize_t *offset, unsigned filter_mask,
+    haddr_t addr, hsize_t nbytes, void *op_data);
+static int H5D__get_chunk_info_all_cb(const hsize_t *offset, unsigned filter_mask,
+    haddr_t addr, hsize_t nbytes, void *op_data);
 
 
 /*********************/
@@ -586,6 +601,347 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Dget_storage_size() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_storage_size
+ *
+ * Purpose:	Returns the number of bytes the chunk of a chunked dataset
+ *		which starts at logical coordinates OFFSET occupies in the
+ *		file, i.e. after the filter pipeline was applied.  This is
+ *		the size of buffer needed by H5DOread_chunk.  The size is
+ *		zero if the chunk has not been allocated.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_storage_size(hid_t dset_id, const hsize_t *offset,
+    hsize_t *chunk_nbytes/*out*/)
+{
+    H5D_t	*dset;          /* Dataset to query */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "i*hx", dset_id, offset, chunk_nbytes);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(NULL == offset)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk offset")
+    if(NULL == chunk_nbytes)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk size pointer")
+
+    /* Get the size of the chunk */
+    if(H5D__get_chunk_storage_size(dset, H5AC_ind_read_dxpl_id, offset, chunk_nbytes) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get size of chunk's storage")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_storage_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__get_num_chunks_cb
+ *
+ * Purpose:	Count a chunk for H5Dget_num_chunks.
+ *
+ * Return:	H5_ITER_CONT
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__get_num_chunks_cb(const hsize_t H5_ATTR_UNUSED *offset, unsigned H5_ATTR_UNUSED filter_mask,
+    haddr_t H5_ATTR_UNUSED addr, hsize_t H5_ATTR_UNUSED nbytes, void *op_data)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    (*(hsize_t *)op_data)++;
+
+    FUNC_LEAVE_NOAPI(H5_ITER_CONT)
+} /* end H5D__get_num_chunks_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_num_chunks
+ *
+ * Purpose:	Returns the number of chunks of a chunked dataset which are
+ *		allocated in the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_num_chunks(hid_t dset_id, hsize_t *nchunks/*out*/)
+{
+    H5D_t	*dset;          /* Dataset to query */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dset_id, nchunks);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(NULL == nchunks)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk count pointer")
+
+    /* Count the chunks */
+    *nchunks = 0;
+    if(H5D__chunk_iter(dset, H5AC_ind_read_dxpl_id, H5D__get_num_chunks_cb, nchunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't count chunks")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_num_chunks() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__get_chunk_info_all_cb
+ *
+ * Purpose:	Store the information about a chunk for
+ *		H5Dget_chunk_info_all.
+ *
+ * Return:	H5_ITER_CONT, or H5_ITER_STOP when the arrays are full
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__get_chunk_info_all_cb(const hsize_t *offset, unsigned filter_mask,
+    haddr_t addr, hsize_t nbytes, void *op_data)
+{
+    H5D_chunk_info_all_ud_t *udata = (H5D_chunk_info_all_ud_t *)op_data;
+    size_t n = udata->nchunks;          /* Position of chunk in the arrays */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(udata->offsets)
+        HDmemcpy(&udata->offsets[n * udata->ndims], offset, udata->ndims * sizeof(hsize_t));
+    if(udata->filter_masks)
+        udata->filter_masks[n] = filter_mask;
+    if(udata->addrs)
+        udata->addrs[n] = addr;
+    if(udata->nbytes)
+        udata->nbytes[n] = nbytes;
+    udata->nchunks++;
+
+    FUNC_LEAVE_NOAPI(udata->nchunks < udata->nalloc ? H5_ITER_CONT : H5_ITER_STOP)
+} /* end H5D__get_chunk_info_all_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_info_all
+ *
+ * Purpose:	Retrieves the logical offset, filter mask, file address and
+ *		stored size of each chunk of a chunked dataset which is
+ *		allocated in the file, in the order of the dataset's chunk
+ *		index, with a single pass over the index.
+ *
+ *		The information for up to NALLOC chunks is stored.  OFFSETS
+ *		holds the dataset's rank coordinates for each chunk; the
+ *		other arrays one value for each chunk.  Any of the arrays
+ *		may be NULL.  The number of chunks stored is returned in
+ *		NCHUNKS.  H5Dget_num_chunks returns the number of chunks
+ *		for sizing the arrays.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_info_all(hid_t dset_id, size_t nalloc, hsize_t *offsets/*out*/,
+    unsigned *filter_masks/*out*/, haddr_t *addrs/*out*/, hsize_t *nbytes/*out*/,
+    size_t *nchunks/*out*/)
+{
+    H5D_t	*dset;          /* Dataset to query */
+    H5D_chunk_info_all_ud_t udata;      /* User data for callback */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "izxxxxx", dset_id, nalloc, offsets, filter_masks, addrs,
+             nbytes, nchunks);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(NULL == nchunks)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk count pointer")
+
+    /* Retrieve the chunk information */
+    udata.ndims = dset->shared->ndims;
+    udata.nalloc = nalloc;
+    udata.nchunks = 0;
+    udata.offsets = offsets;
+    udata.filter_masks = filter_masks;
+    udata.addrs = addrs;
+    udata.nbytes = nbytes;
+    if(nalloc > 0 && H5D__chunk_iter(dset, H5AC_ind_read_dxpl_id, H5D__get_chunk_info_all_cb, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve chunk information")
+
+    *nchunks = udata.nchunks;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_info_all() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dchunk_iter
+ *
+ * Purpose:	Iterates over the chunks of a chunked dataset which are
+ *		allocated in the file, in the order of the dataset's chunk
+ *		index, calling OP for each with the chunk's logical offset,
+ *		filter mask, file address and stored size.
+ *
+ *		OP returns zero to continue the iteration, a positive value
+ *		to stop it and return that value, or a negative value to
+ *		stop it with a failure.
+ *
+ * Return:	Success:	The last value returned by OP (zero if all
+ *				the chunks were visited)
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dchunk_iter(hid_t dset_id, H5D_chunk_iter_op_t op, void *op_data)
+{
+    H5D_t	*dset;          /* Dataset to query */
+    herr_t	ret_value;      /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "ix*x", dset_id, op, op_data);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(NULL == op)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no operator specified")
+
+    /* Iterate over the chunks */
+    if((ret_value = H5D__chunk_iter(dset, H5AC_ind_read_dxpl_id, op, op_data)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "chunk iteration failed")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dchunk_iter() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_cache_stats
+ *
+ * Purpose:	Retrieves the raw data chunk cache statistics of a chunked
+ *		dataset, accumulated since the dataset was opened or since
+ *		they were last reset with H5Dreset_chunk_cache_stats.
+ *
+ *		Chunks which bypass the cache (e.g. ones too large to be
+ *		cached) are not counted.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_cache_stats(hid_t dset_id, H5D_chunk_cache_stats_t *stats/*out*/)
+{
+    H5D_t	*dset;          /* Dataset to query */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dset_id, stats);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(NULL == stats)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no statistics pointer")
+
+    *stats = dset->shared->cache.chunk.stats;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_cache_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dreset_chunk_cache_stats
+ *
+ * Purpose:	Resets the raw data chunk cache statistics of a chunked
+ *		dataset, including the access footprint used by
+ *		H5Dget_chunk_cache_advice.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dreset_chunk_cache_stats(hid_t dset_id)
+{
+    H5D_t	*dset;          /* Dataset to reset */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", dset_id);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+    HDmemset(&dset->shared->cache.chunk.stats, 0, sizeof(dset->shared->cache.chunk.stats));
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dreset_chunk_cache_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_cache_advice
+ *
+ * Purpose:	Recommends values for the RDCC_NSLOTS and RDCC_NBYTES
+ *		parameters of H5Pset_chunk_cache, based on the chunks
+ *		touched by the I/O operations on the dataset so far.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_cache_advice(hid_t dset_id, size_t *rdcc_nslots/*out*/,
+    size_t *rdcc_nbytes/*out*/)
+{
+    H5D_t	*dset;          /* Dataset to query */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "ixx", dset_id, rdcc_nslots, rdcc_nbytes);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(NULL == rdcc_nslots || NULL == rdcc_nbytes)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no output pointers")
+
+    if(H5D__chunk_cache_advice(dset, rdcc_nslots, rdcc_nbytes) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute chunk cache advice")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_cache_advice() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Dget_offset
@@ -38,6 +38,21 @@
  *		be added to the cache the heap is pruned by preempting
  *		entries near the front of the list to make room for the new
  *		entry which is added to the end of the list.
+ *
+ *		The above is the default (LRU) replacement policy.  With the
+ *		2Q policy every cached chunk gets its own slot (the slot
+ *		table grows on demand and a separate chained hash maps
+ *		chunk coordinates to slots), and the list is split in two:
+ *		chunks seen once enter a FIFO ('A1in') at the front of the
+ *		list, chunks seen again after being preempted from it are
+ *		kept in LRU order ('Am') at the end of the list.
+ *
+ *		If the file access property list sets a shared chunk cache
+ *		size, the entries of all the file's chunked datasets are
+ *		also on one file-wide list in least recently used order.
+ *		Once a dataset's own cache has made room for a new chunk,
+ *		entries are preempted from the front of that list (from any
+ *		dataset) until the new chunk also fits in the shared size.
  */
 
 /****************/
@@ -108,11 +123,49 @@
 
 /*#define H5D_CHUNK_DEBUG */
 
+/*
+ * Running the filter pipeline on several chunks concurrently requires a
+ * thread-safe build (for the threading primitives and per-thread error
+ * stacks) and must be disabled when global, unprotected bookkeeping is done
+ * by the pipeline or the memory allocator.
+ */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5Z_DEBUG) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK)
+#define H5D_CHUNK_PARALLEL_FILTERS
+#endif
+
+/* Number of chunks decoded per thread in each batch of parallel decodes */
+#define H5D_CHUNK_DECODE_BATCH_FACTOR   2
+
+/* Maximum number of threads used to decode chunks */
+#define H5D_CHUNK_DECODE_MAX_THREADS    64
+
+/* Maximum number of bytes of adjacent chunks combined into one write when
+ * dirty chunks are written back in address order
+ */
+#define H5D_CHUNK_FLUSH_COALESCE_MAX    (4 * 1024 * 1024)
+
+/* Largest number of chunks stored raw without trying the filters, after
+ * a run of incompressible chunks (see H5Pset_chunk_store_raw)
+ */
+#define H5D_CHUNK_STORE_RAW_MAX_SKIP    16
+
+/* Number of hash slots recommended by H5D__chunk_cache_advice() for each
+ * chunk which the cache should be able to hold
+ */
+#define H5D_CHUNK_ADVICE_SLOTS_PER_CHUNK 100
+
 /* Flags for the "edge_chunk_state" field below */
 #define H5D_RDCC_DISABLE_FILTERS 0x01u          /* Disable filters on this chunk */
 #define H5D_RDCC_NEWLY_DISABLED_FILTERS 0x02u   /* Filters have been disabled since
                                                  * the last flush */
 
+/* Fraction of the 2Q chunk cache's bytes that the 'A1in' FIFO may hold
+ * before its chunks are preferred for preemption */
+#define H5D_RDCC_2Q_A1IN_DIVISOR        4
+
+/* Multiplier for hashing chunk coordinates in the 2Q chunk cache */
+#define H5D_RDCC_2Q_HASH_MULT           0x9e3779b97f4a7c15ULL
+
 
 /******************/
 /* Local Typedefs */
@@ -135,9 +188,61 @@ typedef struct H5D_rdcc_ent_t {
     struct H5D_rdcc_ent_t *prev;/*previous item in doubly-linked list	*/
     struct H5D_rdcc_ent_t *tmp_next;/*next item in temporary doubly-linked list */
     struct H5D_rdcc_ent_t *tmp_prev;/*previous item in temporary doubly-linked list */
+    struct H5D_rdcc_ent_t *hnext;/*next item in hash bucket (2Q only)	*/
+    hbool_t     in_am;          /*entry is in the 'Am' queue (2Q only)	*/
+    struct H5D_rdcc_ent_t *fnext;/*next item in file-wide list		*/
+    struct H5D_rdcc_ent_t *fprev;/*previous item in file-wide list	*/
+    H5D_shared_t *shared;       /*dataset the entry belongs to		*/
 } H5D_rdcc_ent_t;
 typedef H5D_rdcc_ent_t *H5D_rdcc_ent_ptr_t; /* For free lists */
 
+/*
+ * Replacement policy for the chunk cache.  The policy chooses the slot that
+ * holds each chunk and the order in which chunks are preempted.  The code
+ * common to all policies maintains the 'slot' array, the doubly-linked list
+ * of entries, the byte & entry counts, and flushes entries when they are
+ * evicted.
+ */
+typedef struct H5D_rdcc_class_t {
+    H5D_chunk_cache_policy_t policy;    /* Policy implemented */
+    hbool_t extent_hash;                /* Whether slots depend on the dataset's extent */
+
+    /* Set up the slots & policy information (when cache is enabled) */
+    herr_t (*init)(H5D_rdcc_t *rdcc);
+
+    /* Return the slot of a cached chunk, or UINT_MAX if not cached */
+    unsigned (*find)(const H5D_shared_t *shared, const hsize_t *scaled);
+
+    /* Make room for a new chunk & choose its slot (UINT_MAX to not cache it) */
+    herr_t (*admit)(const H5D_t *dset, hid_t dxpl_id,
+        const H5D_dxpl_cache_t *dxpl_cache, const hsize_t *scaled, unsigned *idx);
+
+    /* Link a new entry (already in its slot) into the list */
+    void (*insert)(H5D_shared_t *shared, H5D_rdcc_ent_t *ent);
+
+    /* Record a cache hit on an entry */
+    void (*hit)(H5D_rdcc_t *rdcc, H5D_rdcc_ent_t *ent);
+
+    /* Release policy information for an entry about to be evicted (optional) */
+    void (*remove)(H5D_shared_t *shared, H5D_rdcc_ent_t *ent);
+
+    /* Preempt entries until there is room for SIZE more bytes */
+    herr_t (*prune)(const H5D_t *dset, hid_t dxpl_id,
+        const H5D_dxpl_cache_t *dxpl_cache, size_t size);
+
+    /* Release the slots & policy information */
+    void (*dest)(H5D_rdcc_t *rdcc);
+} H5D_rdcc_class_t;
+
+/* Raw data chunk cache shared by all the chunked datasets in a file */
+typedef struct H5D_rdcc_file_t {
+    size_t		nbytes_max; /* Maximum cached raw data in bytes	*/
+    size_t		nbytes_used; /* Current cached raw data in bytes */
+    unsigned		nusers;	/* Number of dataset caches attached	*/
+    H5D_rdcc_ent_t	*head;	/* Least recently used entry		*/
+    H5D_rdcc_ent_t	*tail;	/* Most recently used entry		*/
+} H5D_rdcc_file_t;
+
 /* Callback info for iteration to prune chunks */
 typedef struct H5D_chunk_it_ud1_t {
     H5D_chunk_common_ud_t common;       /* Common info for B-tree user data (must be first) */
@@ -207,6 +312,13 @@ typedef struct H5D_chunk_it_ud5_t {
     hsize_t       	*dset_dims;             /* Dataset dimensions */
 } H5D_chunk_it_ud5_t;
 
+/* Callback info for iteration on behalf of the application */
+typedef struct H5D_chunk_it_ud6_t {
+    const H5O_layout_chunk_t *layout;           /* Chunk layout description */
+    H5D_chunk_iter_op_t op;                     /* Application callback */
+    void                *op_data;               /* Application callback's data */
+} H5D_chunk_it_ud6_t;
+
 /* Callback info for nonexistent readvv operation */
 typedef struct H5D_chunk_readvv_ud_t {
     unsigned char *rbuf;        /* Read buffer to initialize */
@@ -222,6 +334,63 @@ typedef struct H5D_chunk_file_iter_ud_t {
 #endif /* H5_HAVE_PARALLEL */
 } H5D_chunk_file_iter_ud_t;
 
+/* Chunk which is read ahead of a sequential read */
+typedef struct H5D_chunk_ra_t {
+    hsize_t     scaled[H5O_LAYOUT_NDIMS];   /* Scaled coordinates of chunk */
+    H5D_chunk_ud_t udata;               /* Chunk index pass-through */
+    void        *decoded;               /* Chunk already run through the pipeline */
+    size_t      decoded_alloc;          /* Allocated size of decoded chunk's buffer */
+} H5D_chunk_ra_t;
+
+/* Dirty chunk which is written back in address order */
+typedef struct H5D_chunk_wb_t {
+    H5D_rdcc_ent_t *ent;                /* Cache entry of chunk */
+    hsize_t     idx;                    /* Linear index of chunk */
+    H5D_chunk_ud_t udata;               /* Chunk index pass-through */
+    void        *buf;                   /* Chunk as written to the file */
+    size_t      buf_alloc;              /* Size of the filtered chunk's buffer */
+    hbool_t     need_insert;            /* Whether the chunk must be inserted into the index */
+} H5D_chunk_wb_t;
+
+/* Dirty chunks chosen for preemption, which are written back together */
+typedef struct H5D_chunk_victims_t {
+    H5D_rdcc_ent_t **ent;               /* Cache entries of chunks */
+    size_t      nused;                  /* # of chunks chosen */
+    size_t      nalloc;                 /* # of chunks allocated in array */
+    size_t      nbytes;                 /* # of bytes of cache they occupy */
+} H5D_chunk_victims_t;
+
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+/* Chunk which is read serially, then decoded by one of the decode threads */
+typedef struct H5D_chunk_decode_t {
+    const H5D_chunk_info_t *chunk_info; /* Chunk this buffer belongs to */
+    unsigned    filter_mask;            /* Excluded filters for the chunk */
+    size_t      nbytes;                 /* # of valid bytes in buffer */
+    size_t      buf_alloc;              /* Allocated size of buffer */
+    void        *buf;                   /* Chunk buffer (filtered on input, unfiltered on output) */
+    herr_t      status;                 /* Result of running the pipeline */
+} H5D_chunk_decode_t;
+
+/* Batch of chunks to decode in parallel */
+typedef struct H5D_chunk_decode_batch_t {
+    const H5O_pline_t *pline;           /* I/O pipeline to run (reversed) */
+    H5Z_EDC_t   err_detect;             /* Error detection setting */
+    unsigned    nthreads;               /* # of threads to decode with */
+    H5D_chunk_decode_t *item;           /* Chunks in the batch */
+    size_t      nalloc;                 /* # of chunks allocated in array */
+    size_t      nused;                  /* # of chunks in current batch */
+    size_t      next;                   /* Next chunk to hand to the I/O loop */
+    H5SL_node_t *last_node;             /* Last chunk node examined for the batch */
+} H5D_chunk_decode_batch_t;
+
+/* Information for a single decode thread */
+typedef struct H5D_chunk_decode_thread_t {
+    H5D_chunk_decode_batch_t *batch;    /* Batch to work on */
+    unsigned    nthreads;               /* # of threads decoding the batch */
+    unsigned    thread_idx;             /* Index of thread (selects the chunks decoded) */
+} H5D_chunk_decode_thread_t;
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+
 #ifdef H5_HAVE_PARALLEL
 /* information to construct a collective I/O operation for filling chunks */
 typedef struct H5D_chunk_coll_info_t {
@@ -259,12 +428,17 @@ H5D__nonexistent_readvv(const H5D_io_info_t *io_info,
 
 /* format convert cb */
 static int H5D__chunk_format_convert_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static int H5D__chunk_iter_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
 
 /* Helper routines */
 static herr_t H5D__chunk_set_info_real(H5O_layout_chunk_t *layout, unsigned ndims,
     const hsize_t *curr_dims, const hsize_t *max_dims);
 static void *H5D__chunk_mem_alloc(size_t size, const H5O_pline_t *pline);
 static void *H5D__chunk_mem_xfree(void *chk, const H5O_pline_t *pline);
+static void *H5D__chunk_mem_release(void *chk, size_t size,
+    const H5O_pline_t *pline);
+static void *H5D__chunk_mem_alloc_read(const H5D_t *dset, size_t nbytes,
+    size_t *buf_alloc);
 static void *H5D__chunk_mem_realloc(void *chk, size_t size,
     const H5O_pline_t *pline);
 static herr_t H5D__chunk_cinfo_cache_reset(H5D_chunk_cached_t *last);
@@ -283,23 +457,87 @@ static herr_t H5D__chunk_file_cb(void *elem, const H5T_t *type, unsigned ndims,
 static herr_t H5D__chunk_mem_cb(void *elem, const H5T_t *type, unsigned ndims,
     const hsize_t *coords, void *fm);
 static unsigned H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled);
+static hbool_t H5D__chunk_store_raw_mask(const H5O_pline_t *pline,
+    unsigned *filter_mask);
+static herr_t H5D__chunk_flush_prep(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t reset,
+    H5D_chunk_ud_t *udata, void **buf, size_t *buf_alloc, hbool_t *need_insert,
+    hbool_t *point_of_no_return);
+static herr_t H5D__chunk_flush_done(const H5D_t *dset, hid_t dxpl_id,
+    H5D_rdcc_ent_t *ent, H5D_chunk_ud_t *udata, hbool_t need_insert);
+static herr_t H5D__chunk_flush_sorted(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t **ents, size_t nents);
+static int H5D__chunk_flush_idx_cmp(const void *_wb1, const void *_wb2);
+static int H5D__chunk_flush_addr_cmp(const void *_wb1, const void *_wb2);
 static herr_t H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t reset);
 static herr_t H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t flush);
+static herr_t H5D__chunk_cache_preempt(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent,
+    H5D_chunk_victims_t *victims);
+static herr_t H5D__chunk_cache_preempt_flush(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_chunk_victims_t *victims);
 static hbool_t H5D__chunk_is_partial_edge_chunk(unsigned dset_ndims,
     const uint32_t *chunk_dims, const hsize_t *chunk_scaled, const hsize_t *dset_dims);
 static void *H5D__chunk_lock(const H5D_io_info_t *io_info,
-    H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk);
+    H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk,
+    void *decoded_chunk);
 static herr_t H5D__chunk_unlock(const H5D_io_info_t *io_info,
     const H5D_chunk_ud_t *udata, hbool_t dirty, void *chunk,
     uint32_t naccessed);
+static herr_t H5D__chunk_cache_lru_init(H5D_rdcc_t *rdcc);
+static unsigned H5D__chunk_cache_lru_find(const H5D_shared_t *shared,
+    const hsize_t *scaled);
+static herr_t H5D__chunk_cache_lru_admit(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, const hsize_t *scaled, unsigned *idx);
+static void H5D__chunk_cache_lru_insert(H5D_shared_t *shared, H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_lru_hit(H5D_rdcc_t *rdcc, H5D_rdcc_ent_t *ent);
 static herr_t H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, size_t size);
+static void H5D__chunk_cache_lru_dest(H5D_rdcc_t *rdcc);
+static hsize_t H5D__chunk_cache_2q_hash(unsigned ndims, const hsize_t *scaled);
+static herr_t H5D__chunk_cache_2q_rehash(H5D_shared_t *shared);
+static herr_t H5D__chunk_cache_2q_ghost(H5D_shared_t *shared,
+    const H5D_rdcc_ent_t *ent);
+static herr_t H5D__chunk_cache_2q_init(H5D_rdcc_t *rdcc);
+static unsigned H5D__chunk_cache_2q_find(const H5D_shared_t *shared,
+    const hsize_t *scaled);
+static herr_t H5D__chunk_cache_2q_admit(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, const hsize_t *scaled, unsigned *idx);
+static void H5D__chunk_cache_2q_insert(H5D_shared_t *shared, H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_2q_hit(H5D_rdcc_t *rdcc, H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_2q_remove(H5D_shared_t *shared, H5D_rdcc_ent_t *ent);
+static herr_t H5D__chunk_cache_2q_prune(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, size_t size);
+static void H5D__chunk_cache_2q_dest(H5D_rdcc_t *rdcc);
+static herr_t H5D__chunk_cache_file_attach(H5F_t *f, H5D_rdcc_t *rdcc);
+static void H5D__chunk_cache_file_detach(H5F_t *f, H5D_rdcc_t *rdcc);
+static void H5D__chunk_cache_file_insert(H5D_shared_t *shared, H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_file_hit(H5D_rdcc_file_t *rdcc_file, H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_file_remove(H5D_shared_t *shared, H5D_rdcc_ent_t *ent);
+static herr_t H5D__chunk_cache_file_prune(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, size_t size);
+static herr_t H5D__chunk_direct_lookup(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *offset, hsize_t scaled[], H5D_chunk_ud_t *udata);
+static herr_t H5D__chunk_read_ahead(const H5D_io_info_t *io_info,
+    hsize_t chunk_idx, hbool_t prefetch);
+static int H5D__chunk_read_ahead_cmp(const void *_ra1, const void *_ra2);
+static herr_t H5D__chunk_sparse_fill_init(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, void **fill_buf);
 static herr_t H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk);
 static herr_t H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info,
     const H5F_block_t *old_chunk, H5F_block_t *new_chunk, hbool_t *need_insert,
     hsize_t scaled[]);
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+static htri_t H5D__chunk_decode_can_batch(const H5D_io_info_t *io_info);
+static herr_t H5D__chunk_decode_batch(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, H5SL_node_t *chunk_node,
+    H5D_chunk_decode_batch_t *batch);
+static void H5D__chunk_decode_run(H5D_chunk_decode_batch_t *batch);
+static void *H5D__chunk_decode_thread(void *_udata);
+static void H5D__chunk_decode_release(H5D_chunk_decode_batch_t *batch);
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__chunk_collective_fill(const H5D_t *dset, hid_t dxpl_id,
     H5D_chunk_coll_info_t *chunk_info, size_t chunk_size, const void *fill_buf);
@@ -352,12 +590,43 @@ const H5D_layout_ops_t H5D_LOPS_NONEXISTENT[1] = {{
     NULL
 }};
 
+/* Chunk cache replacement policies, indexed by H5D_chunk_cache_policy_t */
+static const H5D_rdcc_class_t H5D_RDCC_CLS_g[] = {
+    {   /* H5D_CHUNK_CACHE_LRU */
+        H5D_CHUNK_CACHE_LRU,
+        TRUE,
+        H5D__chunk_cache_lru_init,
+        H5D__chunk_cache_lru_find,
+        H5D__chunk_cache_lru_admit,
+        H5D__chunk_cache_lru_insert,
+        H5D__chunk_cache_lru_hit,
+        NULL,
+        H5D__chunk_cache_prune,
+        H5D__chunk_cache_lru_dest
+    },
+    {   /* H5D_CHUNK_CACHE_2Q */
+        H5D_CHUNK_CACHE_2Q,
+        FALSE,
+        H5D__chunk_cache_2q_init,
+        H5D__chunk_cache_2q_find,
+        H5D__chunk_cache_2q_admit,
+        H5D__chunk_cache_2q_insert,
+        H5D__chunk_cache_2q_hit,
+        H5D__chunk_cache_2q_remove,
+        H5D__chunk_cache_2q_prune,
+        H5D__chunk_cache_2q_dest
+    }
+};
+
 /* Declare a free list to manage the H5F_rdcc_ent_ptr_t sequence information */
 H5FL_SEQ_DEFINE_STATIC(H5D_rdcc_ent_ptr_t);
 
 /* Declare a free list to manage H5D_rdcc_ent_t objects */
 H5FL_DEFINE_STATIC(H5D_rdcc_ent_t);
 
+/* Declare a free list to manage H5D_rdcc_file_t objects */
+H5FL_DEFINE_STATIC(H5D_rdcc_file_t);
+
 /* Declare a free list to manage the H5D_chunk_info_t struct */
 H5FL_DEFINE(H5D_chunk_info_t);
 
@@ -491,6 +760,177 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* end H5D__chunk_direct_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_direct_lookup
+ *
+ * Purpose:	Look up the chunk of a dataset which starts at logical
+ *		coordinates OFFSET in the chunk index, for accessing the
+ *		chunk as it is stored in the file.  If the chunk is dirty
+ *		in the chunk cache it is written to the file first (and
+ *		stays cached), so that the index describes its current
+ *		contents.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_direct_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *offset,
+    hsize_t scaled[], H5D_chunk_ud_t *udata)
+{
+    const H5O_layout_t *layout = &(dset->shared->layout);       /* Dataset layout */
+    unsigned u;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(offset);
+    HDassert(scaled);
+    HDassert(udata);
+
+    if(H5D_CHUNKED != layout->type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+    /* Make sure the offset is within the dataset and falls on a chunk's boundary */
+    for(u = 0; u < dset->shared->ndims; u++) {
+        if(offset[u] >= dset->shared->curr_dims[u])
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "offset exceeds dimensions of dataset")
+        if(offset[u] % layout->u.chunk.dim[u])
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "offset doesn't fall on chunks's boundary")
+    } /* end for */
+
+    /* Calculate the index of this chunk */
+    H5VM_chunk_scaled(dset->shared->ndims, offset, layout->u.chunk.dim, scaled);
+    scaled[dset->shared->ndims] = 0;
+
+    /* Find out the file address of the chunk (if any) */
+    if(H5D__chunk_lookup(dset, dxpl_id, scaled, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+    /* Write the cached chunk first, if it was modified */
+    if(UINT_MAX != udata->idx_hint && dset->shared->cache.chunk.slot[udata->idx_hint]->dirty) {
+        H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+        H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+
+        /* Fill the DXPL cache values for later use */
+        if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+        if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, dset->shared->cache.chunk.slot[udata->idx_hint], FALSE) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush raw data chunk")
+
+        /* The chunk may have moved in the file */
+        if(H5D__chunk_lookup(dset, dxpl_id, scaled, udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+    } /* end if */
+
+    /* Sanity check */
+    HDassert((H5F_addr_defined(udata->chunk_block.offset) && udata->chunk_block.length > 0) ||
+            (!H5F_addr_defined(udata->chunk_block.offset) && udata->chunk_block.length == 0));
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_direct_lookup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_direct_read
+ *
+ * Purpose:	Internal routine to read a chunk directly from the file
+ *		into BUF, as it is stored: without running it through the
+ *		filter pipeline.  The chunk's filter mask is returned in
+ *		FILTERS.  BUF must be large enough for the stored chunk
+ *		(see H5D__get_chunk_storage_size).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_direct_read(const H5D_t *dset, hid_t dxpl_id, const hsize_t *offset,
+    uint32_t *filters, void *buf)
+{
+    H5D_chunk_ud_t udata;               /* User data for querying chunk info */
+    hsize_t scaled[H5S_MAX_RANK];       /* Scaled coordinates for this chunk */
+    H5D_io_info_t io_info;              /* to hold the dset and two dxpls (meta and raw data) */
+    hbool_t md_dxpl_generated = FALSE;  /* bool to indicate whether we should free the md_dxpl_id at exit */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Sanity check */
+    HDassert(filters);
+    HDassert(buf);
+
+    io_info.dset = dset;
+    io_info.raw_dxpl_id = dxpl_id;
+    io_info.md_dxpl_id = dxpl_id;
+
+    /* set the dxpl IO type for sanity checking at the FD layer */
+#ifdef H5_DEBUG_BUILD
+    if(H5D_set_io_info_dxpls(&io_info, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't set metadata and raw data dxpls")
+    md_dxpl_generated = TRUE;
+#endif /* H5_DEBUG_BUILD */
+
+    /* Find out where the chunk is stored */
+    if(H5D__chunk_direct_lookup(dset, io_info.md_dxpl_id, offset, scaled, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk")
+    if(!H5F_addr_defined(udata.chunk_block.offset))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk storage is not allocated")
+
+    /* Read the chunk straight into the application's buffer */
+    if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, (size_t)udata.chunk_block.length, io_info.raw_dxpl_id, buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+    *filters = udata.filter_mask;
+
+done:
+#ifdef H5_DEBUG_BUILD
+    if(md_dxpl_generated && H5I_dec_ref(io_info.md_dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_direct_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__get_chunk_storage_size
+ *
+ * Purpose:	Internal routine to retrieve the number of bytes the chunk
+ *		which starts at logical coordinates OFFSET occupies in the
+ *		file (after filtering).  Zero is returned for a chunk which
+ *		is not allocated.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__get_chunk_storage_size(const H5D_t *dset, hid_t dxpl_id, const hsize_t *offset,
+    hsize_t *storage_size)
+{
+    H5D_chunk_ud_t udata;               /* User data for querying chunk info */
+    hsize_t scaled[H5S_MAX_RANK];       /* Scaled coordinates for this chunk */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Sanity check */
+    HDassert(storage_size);
+
+    /* Find out where the chunk is stored */
+    if(H5D__chunk_direct_lookup(dset, dxpl_id, offset, scaled, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk")
+
+    *storage_size = udata.chunk_block.length;
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__get_chunk_storage_size() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_set_info_real
@@ -745,21 +1185,49 @@ H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
     if(H5P_get(dapl, H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME, &rdcc->nbytes_max) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get data cache byte size")
     if(rdcc->nbytes_max == H5D_CHUNK_CACHE_NBYTES_DEFAULT)
-        rdcc->nbytes_max = H5F_RDCC_NBYTES(f);
+        /* (The file-wide cache's size limits datasets in the file by default) */
+        rdcc->nbytes_max = H5F_RDCC_SHARED_NBYTES(f) > 0 ? H5F_RDCC_SHARED_NBYTES(f) : H5F_RDCC_NBYTES(f);
 
     if(H5P_get(dapl, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, &rdcc->w0) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get preempt read chunks")
     if(rdcc->w0 < 0)
         rdcc->w0 = H5F_RDCC_W0(f);
 
+    if(H5P_get(dapl, H5D_ACS_DATA_CACHE_POLICY_NAME, &rdcc->policy) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get data cache replacement policy")
+    if(rdcc->policy != H5D_CHUNK_CACHE_LRU && rdcc->policy != H5D_CHUNK_CACHE_2Q)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid data cache replacement policy")
+    rdcc->cls = &H5D_RDCC_CLS_g[rdcc->policy];
+    HDassert(rdcc->cls->policy == rdcc->policy);
+
+    if(H5P_get(dapl, H5D_ACS_READ_AHEAD_NAME, &rdcc->ra.nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get chunk read-ahead")
+    rdcc->ra.expect = rdcc->ra.next = 0;
+
+    if(H5P_get(dapl, H5D_ACS_FLUSH_SORTED_NAME, &rdcc->flush_sorted) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get sorted chunk flush")
+
     /* If nbytes_max or nslots is 0, set them both to 0 and avoid allocating space */
     if(!rdcc->nbytes_max || !rdcc->nslots)
         rdcc->nbytes_max = rdcc->nslots = 0;
     else {
-        rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots);
-        if(NULL == rdcc->slot)
+        /* Keep slot indices distinguishable from the "not cached" hint */
+        if(rdcc->nslots >= UINT_MAX)
+            rdcc->nslots = UINT_MAX - 1;
+
+        if((rdcc->cls->init)(rdcc) < 0)
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
 
+        /* Share the file-wide chunk cache with the file's other datasets */
+        if(H5F_RDCC_SHARED_NBYTES(f) > 0
+#ifdef H5_HAVE_PARALLEL
+                /* (Chunks can't be flushed independently of other processes) */
+                && !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI)
+#endif /* H5_HAVE_PARALLEL */
+                )
+            if(H5D__chunk_cache_file_attach(f, rdcc) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't attach to file-wide chunk cache")
+
         /* Reset any cached chunk info for this dataset */
         H5D__chunk_cinfo_cache_reset(&(rdcc->last));
     } /* end else */
@@ -1099,6 +1567,14 @@ H5D__chunk_io_init(const H5D_io_info_t *io_info, const H5D_type_info_t *type_inf
         } /* end else */
     } /* end else */
 
+    /* Track the largest number of chunks touched by one I/O operation */
+    {
+        hsize_t nsel_chunks = fm->use_single ? 1 : (hsize_t)H5SL_count(fm->sel_chunks);
+
+        if(nsel_chunks > dataset->shared->cache.chunk.stats.max_sel_chunks)
+            dataset->shared->cache.chunk.stats.max_sel_chunks = nsel_chunks;
+    } /* end block */
+
 done:
     /* Release the [potentially partially built] chunk mapping information if an error occurs */
     if(ret_value < 0) {
@@ -1134,7 +1610,8 @@ done:
  *
  * Purpose:	Allocate space for a chunk in memory.  This routine allocates
  *              memory space for non-filtered chunks from a block free list
- *              and uses malloc()/free() for filtered chunks.
+ *              and takes filtered chunks from the filter pipeline's buffer
+ *              pool, which the filters allocate their output from too.
  *
  * Return:	Pointer to memory for chunk on success/NULL on failure
  *
@@ -1153,7 +1630,7 @@ H5D__chunk_mem_alloc(size_t size, const H5O_pline_t *pline)
     HDassert(size);
 
     if(pline && pline->nused)
-        ret_value = H5MM_malloc(size);
+        ret_value = H5Z_buf_alloc(size, NULL);
     else
         ret_value = H5FL_BLK_MALLOC(chunk, size);
 
@@ -1190,6 +1667,70 @@ H5D__chunk_mem_xfree(void *chk, const H5O_pline_t *pline)
     FUNC_LEAVE_NOAPI(NULL)
 } /* H5D__chunk_mem_xfree() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_mem_release
+ *
+ * Purpose:	Free space for a chunk in memory, like H5D__chunk_mem_xfree,
+ *		but return filtered chunks of (at least) SIZE bytes to the
+ *		filter pipeline's buffer pool for reuse.
+ *
+ * Return:	NULL (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__chunk_mem_release(void *chk, size_t size, const H5O_pline_t *pline)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    if(chk) {
+        if(pline && pline->nused)
+            H5Z_buf_free(chk, size);
+        else
+            chk = H5FL_BLK_FREE(chunk, chk);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(NULL)
+} /* H5D__chunk_mem_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_mem_alloc_read
+ *
+ * Purpose:	Allocate a buffer to read NBYTES of a filtered chunk from
+ *		the file into.  The buffer is made large enough to hold the
+ *		chunk once it's decoded, so the filters can decode into
+ *		buffers of the same size and hand them to each other (and
+ *		to the chunk cache) through the buffer pool.
+ *
+ *		The size stored in *BUF_ALLOC is the decoded chunk's size
+ *		(or NBYTES, if larger), even when the pool hands out a
+ *		larger buffer: it's passed to the filter pipeline, which
+ *		tells the filters to expect output of that size.
+ *
+ * Return:	Pointer to memory for chunk on success/NULL on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__chunk_mem_alloc_read(const H5D_t *dset, size_t nbytes, size_t *buf_alloc)
+{
+    size_t size = MAX(nbytes, (size_t)dset->shared->layout.u.chunk.size);  /* Size of buffer */
+    void *ret_value = NULL;		/* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(dset);
+    HDassert(nbytes);
+    HDassert(buf_alloc);
+
+    if(NULL != (ret_value = H5Z_buf_alloc(size, NULL)))
+        *buf_alloc = size;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_mem_alloc_read() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_mem_realloc
@@ -1950,9 +2491,10 @@ done:
  */
 static herr_t
 H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
-    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
+    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t *mem_space,
     H5D_chunk_map_t *fm)
 {
+    const H5O_storage_chunk_t *sc = &(io_info->dset->shared->layout.storage.u.chunk);
     H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
     H5D_io_info_t nonexistent_io_info;  /* "nonexistent" I/O info object */
     H5D_io_info_t ctg_io_info;          /* Contiguous I/O info object */
@@ -1962,6 +2504,14 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    src_accessed_bytes = 0; /* Total accessed size in a chunk */
     hbool_t     skip_missing_chunks = FALSE;    /* Whether to skip missing chunks */
+    void        *decoded_chunk = NULL;  /* Chunk already run through the pipeline */
+    size_t      decoded_alloc = 0;      /* Allocated size of decoded chunk's buffer */
+    void        *sparse_fill = NULL;    /* Fill value for chunks never written, in memory type */
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+    H5D_chunk_decode_batch_t batch;     /* Chunks decoded in parallel */
+    hbool_t     use_batch = FALSE;      /* Whether to decode chunks in parallel */
+    hbool_t     need_batch = TRUE;      /* Whether a new batch must be decoded */
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
     herr_t	ret_value = SUCCEED;	/*return value		*/
 
     FUNC_ENTER_STATIC
@@ -2010,6 +2560,44 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
             skip_missing_chunks = TRUE;
     }
 
+    /* Prepare to store the fill value for chunks which were never written
+     * straight into the application's buffer, bypassing the chunk cache
+     */
+    if(!skip_missing_chunks)
+        if(H5D__chunk_sparse_fill_init(io_info, type_info, &sparse_fill) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't initialize fill value")
+
+    /* If no chunk has been written or is cached, the whole selection reads
+     * the fill value (or is left alone)
+     */
+    if((skip_missing_chunks || sparse_fill) && 0 == io_info->dset->shared->cache.chunk.nused
+            && !(sc->ops->is_space_alloc)(sc)) {
+        if(sparse_fill && H5S_select_fill(sparse_fill, type_info->dst_type_size, mem_space, io_info->u.rbuf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTENCODE, FAIL, "filling selection failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+    /* Check if the filter pipeline should be run on several chunks at once */
+    HDmemset(&batch, 0, sizeof(batch));
+    if(io_info->dxpl_cache->filter_nthreads > 1 && !fm->use_single
+            && H5SL_count(fm->sel_chunks) > 1) {
+        htri_t can_batch;               /* Whether chunks can be decoded in parallel */
+
+        if((can_batch = H5D__chunk_decode_can_batch(io_info)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunks can be decoded in parallel")
+        if(can_batch) {
+            batch.pline = &(io_info->dset->shared->dcpl_cache.pline);
+            batch.err_detect = io_info->dxpl_cache->err_detect;
+            batch.nthreads = MIN(io_info->dxpl_cache->filter_nthreads, H5D_CHUNK_DECODE_MAX_THREADS);
+            batch.nalloc = (size_t)batch.nthreads * H5D_CHUNK_DECODE_BATCH_FACTOR;
+            if(NULL == (batch.item = (H5D_chunk_decode_t *)H5MM_calloc(batch.nalloc * sizeof(H5D_chunk_decode_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk decode batch")
+            use_batch = TRUE;
+        } /* end if */
+    } /* end if */
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+
     /* Iterate through nodes in chunk skip list */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
@@ -2019,6 +2607,29 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
         /* Get the actual chunk information from the skip list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
 
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+        if(use_batch) {
+            /* Read & decode the next group of uncached chunks, if needed */
+            if(need_batch) {
+                if(H5D__chunk_decode_batch(io_info, fm, chunk_node, &batch) < 0)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "unable to decode raw data chunks")
+                need_batch = FALSE;
+            } /* end if */
+
+            /* Take ownership of this chunk's buffer, if it was decoded */
+            if(batch.next < batch.nused && batch.item[batch.next].chunk_info == chunk_info) {
+                decoded_chunk = batch.item[batch.next].buf;
+                decoded_alloc = batch.item[batch.next].buf_alloc;
+                batch.item[batch.next].buf = NULL;
+                batch.next++;
+            } /* end if */
+
+            /* Start a new batch after the last chunk examined for this one */
+            if(chunk_node == batch.last_node)
+                need_batch = TRUE;
+        } /* end if */
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+
         /* Get the info for the chunk in the file */
         if(H5D__chunk_lookup(io_info->dset, io_info->md_dxpl_id, chunk_info->scaled, &udata) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
@@ -2026,9 +2637,15 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
         /* Sanity check */
         HDassert((H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) || 
                 (!H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length == 0));
+        HDassert(!decoded_chunk || (H5F_addr_defined(udata.chunk_block.offset) && UINT_MAX == udata.idx_hint));
 
+        /* Store the fill value directly for a chunk which was never written */
+        if(sparse_fill && !H5F_addr_defined(udata.chunk_block.offset) && UINT_MAX == udata.idx_hint) {
+            if(H5S_select_fill(sparse_fill, type_info->dst_type_size, chunk_info->mspace, io_info->u.rbuf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTENCODE, FAIL, "filling selection failed")
+        } /* end if */
         /* Check for non-existant chunk & skip it if appropriate */
-        if(H5F_addr_defined(udata.chunk_block.offset) || UINT_MAX != udata.idx_hint
+        else if(H5F_addr_defined(udata.chunk_block.offset) || UINT_MAX != udata.idx_hint
                 || !skip_missing_chunks) {
             H5D_io_info_t *chk_io_info;     /* Pointer to I/O info object for this chunk */
             void *chunk = NULL;             /* Pointer to locked chunk buffer */
@@ -2048,7 +2665,10 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 src_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->src_type_size;
 
                 /* Lock the chunk into the cache */
-                if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, FALSE, FALSE)))
+                /* (the decoded chunk buffer, if any, now belongs to the cache) */
+                chunk = H5D__chunk_lock(io_info, &udata, FALSE, FALSE, decoded_chunk);
+                decoded_chunk = NULL;
+                if(NULL == chunk)
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
                 /* Set up the storage buffer information for this chunk */
@@ -2075,74 +2695,642 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked read failed")
 
             /* Release the cache lock on the chunk. */
-            if(chunk && H5D__chunk_unlock(io_info, &udata, FALSE, chunk, src_accessed_bytes) < 0)
-                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+            if(chunk) {
+                hbool_t prefetch = TRUE;    /* Whether chunks may be read ahead */
+
+                if(H5D__chunk_unlock(io_info, &udata, FALSE, chunk, src_accessed_bytes) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+                /* Don't read ahead chunks still waiting in the decode batch */
+                if(use_batch && batch.next < batch.nused)
+                    prefetch = FALSE;
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+
+                /* Read ahead, if the chunks are being read in sequence */
+                if(io_info->dset->shared->cache.chunk.ra.nchunks > 0
+                        && H5D__chunk_read_ahead(io_info, chunk_info->index, prefetch) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read ahead raw data chunks")
+            } /* end if */
         } /* end if */
+        HDassert(NULL == decoded_chunk);
 
         /* Advance to next chunk in list */
         chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
     } /* end while */
 
 done:
+    /* Release any decoded chunks not handed to the cache */
+    if(decoded_chunk)
+        decoded_chunk = H5D__chunk_mem_release(decoded_chunk, decoded_alloc, &(io_info->dset->shared->dcpl_cache.pline));
+    H5MM_xfree(sparse_fill);
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+    if(use_batch) {
+        H5D__chunk_decode_release(&batch);
+        batch.item = (H5D_chunk_decode_t *)H5MM_xfree(batch.item);
+    } /* end if */
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_read() */
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_write
+ * Function:	H5D__chunk_sparse_fill_init
  *
- * Purpose:	Writes to a chunked dataset.
+ * Purpose:	Convert the dataset's fill value to the memory datatype of
+ *		a read once, so that the parts of the application's buffer
+ *		which map to chunks that were never written can be filled
+ *		directly, without building the chunks in the chunk cache.
  *
- * Return:	Non-negative on success/Negative on failure
+ *		*FILL_BUF is set to NULL if the fill value can't be stored
+ *		this way: for variable-length data, data transforms and
+ *		conversions which need the contents of the application's
+ *		buffer.  Otherwise it must be freed by the caller.
  *
- * Programmer:	Raymond Lu
- *		Thursday, April 10, 2003
+ * Return:	Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
-    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
-    H5D_chunk_map_t *fm)
+H5D__chunk_sparse_fill_init(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, void **fill_buf)
 {
-    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
-    H5D_io_info_t ctg_io_info;          /* Contiguous I/O info object */
-    H5D_storage_t ctg_store;            /* Chunk storage information as contiguous dataset */
-    H5D_io_info_t cpt_io_info;          /* Compact I/O info object */
-    H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
-    hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
-    uint32_t    dst_accessed_bytes = 0; /* Total accessed size in a chunk */
-    herr_t	ret_value = SUCCEED;	/* Return value		*/
+    const H5O_fill_t *fill = &(io_info->dset->shared->dcpl_cache.fill);    /* Fill value info */
+    void        *buf = NULL;            /* Converted fill value */
+    htri_t      has_vlen;               /* Whether the datatype has variable-length data */
+    herr_t      ret_value = SUCCEED;    /* Return value */
 
     FUNC_ENTER_STATIC
 
-    /* Sanity check */
     HDassert(io_info);
-    HDassert(io_info->u.wbuf);
     HDassert(type_info);
-    HDassert(fm);
+    HDassert(fill_buf);
 
-    /* Set up contiguous I/O info object */
-    HDmemcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
-    ctg_io_info.store = &ctg_store;
-    ctg_io_info.layout_ops = *H5D_LOPS_CONTIG;
+    *fill_buf = NULL;
 
-    /* Initialize temporary contiguous storage info */
-    H5_CHECKED_ASSIGN(ctg_store.contig.dset_size, hsize_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
+    /* Check if the fill value can be stored directly */
+    if(!type_info->is_xform_noop || type_info->need_bkg != H5T_BKG_NO)
+        HGOTO_DONE(SUCCEED)
+    if(fill->buf && (size_t)fill->size != type_info->src_type_size)
+        HGOTO_DONE(SUCCEED)
+    if((has_vlen = H5T_detect_class(io_info->dset->shared->type, H5T_VLEN, FALSE)) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to detect vlen datatypes")
+    if(has_vlen)
+        HGOTO_DONE(SUCCEED)
 
-    /* Set up compact I/O info object */
-    HDmemcpy(&cpt_io_info, io_info, sizeof(cpt_io_info));
-    cpt_io_info.store = &cpt_store;
-    cpt_io_info.layout_ops = *H5D_LOPS_COMPACT;
+    /* Convert the fill value (zero, if none is defined) to the memory type */
+    if(NULL == (buf = H5MM_calloc(type_info->max_type_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for fill value")
+    if(fill->buf)
+        HDmemcpy(buf, fill->buf, type_info->src_type_size);
+    if(!type_info->is_conv_noop)
+        if(H5T_convert(type_info->tpath, type_info->src_type_id, type_info->dst_type_id,
+                (size_t)1, (size_t)0, (size_t)0, buf, NULL, io_info->md_dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
 
-    /* Initialize temporary compact storage info */
-    cpt_store.compact.dirty = &cpt_dirty;
+    *fill_buf = buf;
+    buf = NULL;
 
-    /* Iterate through nodes in chunk skip list */
-    chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
-    while(chunk_node) {
-        H5D_chunk_info_t *chunk_info;   /* Chunk information */
-	H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+done:
+    H5MM_xfree(buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_sparse_fill_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_read_ahead
+ *
+ * Purpose:	Keep track of whether a dataset's chunks are being read in
+ *		sequence (in chunk index order) and, while they are, load
+ *		the next RDCC->RA.NCHUNKS chunks into the chunk cache before
+ *		the application asks for them.  CHUNK_IDX is the index of
+ *		the chunk just read.  If PREFETCH is FALSE, only the
+ *		sequence is tracked.
+ *
+ *		The window of chunks read ahead is refilled once half of it
+ *		has been consumed.  The chunks are read in order of their
+ *		addresses in the file and, if the transfer property list
+ *		allows it, run through the filter pipeline by several
+ *		threads at once.  Chunks which are already cached or not
+ *		allocated in the file are skipped.
+ *
+ *		Reading ahead is only a hint: a chunk which can't be
+ *		located, read or decoded is dropped (its error is cleared
+ *		and reported again if the application reads it).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_read_ahead(const H5D_io_info_t *io_info, hsize_t chunk_idx,
+    hbool_t prefetch)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_layout_t *layout = &(dset->shared->layout); /* Dataset layout */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    H5D_io_info_t ra_io_info;           /* I/O info for the chunks read ahead */
+    H5D_storage_t ra_store;             /* Storage info for the chunks read ahead */
+    H5D_chunk_ra_t *ra = NULL;          /* Chunks to read ahead */
+    size_t      nra = 0;                /* # of chunks to read ahead */
+    size_t      nmax;                   /* Max. # of chunks in the window */
+    hsize_t     first, last, idx;       /* Range of chunks to read ahead */
+    size_t      u;                      /* Local index variable */
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+    H5D_chunk_decode_batch_t batch;     /* Chunks decoded in parallel */
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(rdcc->ra.nchunks > 0);
+    HDassert(chunk_idx < layout->u.chunk.nchunks);
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+    HDmemset(&batch, 0, sizeof(batch));
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+
+    /* Check if this chunk continues the current run */
+    if(chunk_idx != rdcc->ra.expect || 0 == chunk_idx) {
+        rdcc->ra.expect = chunk_idx + 1;
+        rdcc->ra.next = 0;
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+    rdcc->ra.expect = chunk_idx + 1;
+
+    /* Limit the window to the chunks the cache can hold besides this one */
+    nmax = rdcc->nbytes_max / layout->u.chunk.size;
+    if(rdcc->file)
+        nmax = MIN(nmax, rdcc->file->nbytes_max / layout->u.chunk.size);
+    if(nmax < 2)
+        HGOTO_DONE(SUCCEED)
+    nmax = MIN(nmax - 1, rdcc->ra.nchunks);
+
+    /* Refill the window once half of it has been consumed */
+    if(!prefetch || rdcc->ra.next > chunk_idx + (nmax + 1) / 2)
+        HGOTO_DONE(SUCCEED)
+    first = MAX(rdcc->ra.next, chunk_idx + 1);
+    last = MIN(chunk_idx + nmax, layout->u.chunk.nchunks - 1);
+    rdcc->ra.next = chunk_idx + nmax + 1;
+    if(first > last)
+        HGOTO_DONE(SUCCEED)
+
+    /* Locate the chunks which need to be read */
+    if(NULL == (ra = (H5D_chunk_ra_t *)H5MM_malloc((size_t)(last - first + 1) * sizeof(H5D_chunk_ra_t)))) {
+        H5E_clear_stack(NULL);
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+    for(idx = first; idx <= last; idx++) {
+        H5D_chunk_ra_t *item = &ra[nra];
+
+        item->decoded = NULL;
+        if(H5VM_array_calc_pre(idx, dset->shared->ndims, layout->u.chunk.down_chunks, item->scaled) < 0) {
+            H5E_clear_stack(NULL);
+            continue;
+        } /* end if */
+        item->scaled[dset->shared->ndims] = 0;
+        if(H5D__chunk_lookup(dset, io_info->md_dxpl_id, item->scaled, &item->udata) < 0) {
+            H5E_clear_stack(NULL);
+            continue;
+        } /* end if */
+        if(H5F_addr_defined(item->udata.chunk_block.offset) && UINT_MAX == item->udata.idx_hint)
+            nra++;
+    } /* end for */
+
+    /* Read the chunks in file address order */
+    if(nra > 1)
+        HDqsort(ra, nra, sizeof(H5D_chunk_ra_t), H5D__chunk_read_ahead_cmp);
+
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+    /* Run the filter pipeline on the chunks in parallel, if possible */
+    if(io_info->dxpl_cache->filter_nthreads > 1 && nra > 1) {
+        htri_t can_batch;               /* Whether chunks can be decoded in parallel */
+
+        if((can_batch = H5D__chunk_decode_can_batch(io_info)) < 0) {
+            H5E_clear_stack(NULL);
+            can_batch = FALSE;
+        } /* end if */
+        if(can_batch) {
+            batch.pline = &(dset->shared->dcpl_cache.pline);
+            batch.err_detect = io_info->dxpl_cache->err_detect;
+            batch.nthreads = MIN(io_info->dxpl_cache->filter_nthreads, H5D_CHUNK_DECODE_MAX_THREADS);
+            batch.nalloc = nra;
+            if(NULL == (batch.item = (H5D_chunk_decode_t *)H5MM_calloc(batch.nalloc * sizeof(H5D_chunk_decode_t))))
+                H5E_clear_stack(NULL);
+        } /* end if */
+        if(batch.item) {
+            /* Read the filtered chunks (except unfiltered edge chunks), leaving
+             * those which can't be read to the serial path */
+            for(u = 0; u < nra; u++)
+                if(!((layout->u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                        && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims,
+                            layout->u.chunk.dim, ra[u].scaled, dset->shared->curr_dims))) {
+                    H5D_chunk_decode_t *item = &batch.item[batch.nused++];
+
+                    H5_CHECKED_ASSIGN(item->nbytes, size_t, ra[u].udata.chunk_block.length, hsize_t);
+                    item->filter_mask = ra[u].udata.filter_mask;
+                    item->status = SUCCEED;
+                    if(NULL == (item->buf = H5D__chunk_mem_alloc_read(dset, item->nbytes, &item->buf_alloc))) {
+                        H5E_clear_stack(NULL);
+                        item->status = FAIL;
+                    } /* end if */
+                    else if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, ra[u].udata.chunk_block.offset, item->nbytes, io_info->raw_dxpl_id, item->buf) < 0) {
+                        H5E_clear_stack(NULL);
+                        item->buf = H5D__chunk_mem_release(item->buf, item->buf_alloc, batch.pline);
+                        item->status = FAIL;
+                    } /* end if */
+                } /* end if */
+
+            H5D__chunk_decode_run(&batch);
+
+            /* Hand the decoded chunks over, leaving failures to the serial path */
+            for(u = 0, idx = 0; u < nra; u++)
+                if(!((layout->u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                        && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims,
+                            layout->u.chunk.dim, ra[u].scaled, dset->shared->curr_dims))) {
+                    H5D_chunk_decode_t *item = &batch.item[idx++];
+
+                    if(item->status >= 0) {
+                        ra[u].decoded = item->buf;
+                        ra[u].decoded_alloc = item->buf_alloc;
+                        item->buf = NULL;
+                    } /* end if */
+                } /* end if */
+        } /* end if */
+    } /* end if */
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+
+    /* Load the chunks into the cache, through a copy of the I/O info which
+     * points at each chunk in turn */
+    ra_io_info = *io_info;
+    ra_store = *io_info->store;
+    ra_io_info.store = &ra_store;
+    for(u = 0; u < nra; u++) {
+        void *chunk;                    /* Pointer to locked chunk buffer */
+
+        /* (sorting moved the coordinates the index pass-through points to) */
+        ra[u].udata.common.scaled = ra[u].scaled;
+        ra_store.chunk.scaled = ra[u].scaled;
+
+        /* (the decoded chunk buffer, if any, now belongs to the cache) */
+        chunk = H5D__chunk_lock(&ra_io_info, &ra[u].udata, FALSE, FALSE, ra[u].decoded);
+        ra[u].decoded = NULL;
+        if(NULL == chunk) {
+            H5E_clear_stack(NULL);
+            continue;
+        } /* end if */
+        if(H5D__chunk_unlock(&ra_io_info, &ra[u].udata, FALSE, chunk, (uint32_t)0) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+    } /* end for */
+
+done:
+    if(ra) {
+        for(u = 0; u < nra; u++)
+            if(ra[u].decoded)
+                ra[u].decoded = H5D__chunk_mem_release(ra[u].decoded, ra[u].decoded_alloc, &(dset->shared->dcpl_cache.pline));
+        ra = (H5D_chunk_ra_t *)H5MM_xfree(ra);
+    } /* end if */
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+    if(batch.item) {
+        H5D__chunk_decode_release(&batch);
+        batch.item = (H5D_chunk_decode_t *)H5MM_xfree(batch.item);
+    } /* end if */
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_read_ahead_cmp
+ *
+ * Purpose:	Compare the file addresses of two chunks to read ahead, for
+ *		sorting them.
+ *
+ * Return:	-1, 0 or 1, as for qsort()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_read_ahead_cmp(const void *_ra1, const void *_ra2)
+{
+    const H5D_chunk_ra_t *ra1 = (const H5D_chunk_ra_t *)_ra1;
+    const H5D_chunk_ra_t *ra2 = (const H5D_chunk_ra_t *)_ra2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    FUNC_LEAVE_NOAPI(H5F_addr_cmp(ra1->udata.chunk_block.offset, ra2->udata.chunk_block.offset))
+} /* end H5D__chunk_read_ahead_cmp() */
+
+
+#ifdef H5D_CHUNK_PARALLEL_FILTERS
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_decode_can_batch
+ *
+ * Purpose:	Check if the chunks of a dataset can be run through the
+ *		filter pipeline by several threads at once.  This is only
+ *		possible when the pipeline is composed entirely of the
+ *		library's internal filters (which don't use global state)
+ *		and no filter callback is set, since that could be invoked
+ *		from any thread.
+ *
+ * Return:	TRUE/FALSE on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__chunk_decode_can_batch(const H5D_io_info_t *io_info)
+{
+    const H5O_pline_t *pline = &(io_info->dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    size_t u;                   /* Local index variable */
+    htri_t ret_value = TRUE;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check for filters and filter callback */
+    if(0 == pline->nused || io_info->dxpl_cache->filter_cb.func)
+        HGOTO_DONE(FALSE)
+
+    /* Make certain that all the filters are internal and registered, so
+     * that running the pipeline won't load or register any filters */
+    for(u = 0; u < pline->nused; u++) {
+        htri_t avail;           /* Whether the filter is available */
+
+        if(pline->filter[u].id >= H5Z_FILTER_RESERVED)
+            HGOTO_DONE(FALSE)
+        if((avail = H5Z_filter_avail(pline->filter[u].id)) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't check filter availability")
+        if(!avail)
+            HGOTO_DONE(FALSE)
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_decode_can_batch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_decode_batch
+ *
+ * Purpose:	Starting from CHUNK_NODE, locate the next group of selected
+ *		chunks which exist in the file but are not in the chunk
+ *		cache, read them from the file and run the filter pipeline
+ *		on them with BATCH->NTHREADS threads.
+ *
+ *		The raw data is read serially, in skip list (i.e. chunk
+ *		index) order, only the decoding is done concurrently.  A
+ *		chunk which fails to decode is dropped from the batch, so
+ *		that the regular (serial) read path reports the error.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_decode_batch(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
+    H5SL_node_t *chunk_node, H5D_chunk_decode_batch_t *batch)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_layout_t *layout = &(dset->shared->layout); /* Dataset layout */
+    size_t      u, v;                   /* Local index variables */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(batch);
+    HDassert(batch->nalloc > 0);
+    HDassert(batch->next == batch->nused);
+
+    /* Reset the batch */
+    batch->nused = batch->next = 0;
+    batch->last_node = NULL;
+
+    /* Gather the chunks to decode */
+    while(chunk_node && batch->nused < batch->nalloc) {
+        const H5D_chunk_info_t *chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node); /* Chunk information */
+        H5D_chunk_ud_t udata;           /* Chunk index pass-through */
+
+        /* Get the info for the chunk in the file */
+        if(H5D__chunk_lookup(dset, io_info->md_dxpl_id, chunk_info->scaled, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Only chunks which will be read from the file & filtered qualify */
+        if(H5F_addr_defined(udata.chunk_block.offset) && UINT_MAX == udata.idx_hint
+                && !((layout->u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                    && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims,
+                        layout->u.chunk.dim, chunk_info->scaled, dset->shared->curr_dims))) {
+            H5D_chunk_decode_t *item = &batch->item[batch->nused];
+
+            /* Read the filtered chunk */
+            H5_CHECKED_ASSIGN(item->nbytes, size_t, udata.chunk_block.length, hsize_t);
+            if(NULL == (item->buf = H5D__chunk_mem_alloc_read(dset, item->nbytes, &item->buf_alloc)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+            batch->nused++;
+            if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, item->nbytes, io_info->raw_dxpl_id, item->buf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+            item->chunk_info = chunk_info;
+            item->filter_mask = udata.filter_mask;
+            item->status = SUCCEED;
+        } /* end if */
+
+        batch->last_node = chunk_node;
+        chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+    } /* end while */
+
+    /* Run the pipeline on the chunks */
+    H5D__chunk_decode_run(batch);
+
+    /* Drop the chunks which failed to decode, leaving them to the serial path */
+    for(u = v = 0; u < batch->nused; u++) {
+        if(batch->item[u].status < 0)
+            batch->item[u].buf = H5D__chunk_mem_release(batch->item[u].buf, batch->item[u].buf_alloc, batch->pline);
+        else
+            batch->item[v++] = batch->item[u];
+    } /* end for */
+    batch->nused = v;
+
+done:
+    if(ret_value < 0) {
+        H5D__chunk_decode_release(batch);
+        batch->last_node = NULL;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_decode_batch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_decode_run
+ *
+ * Purpose:	Run the (reversed) filter pipeline on the chunks of a batch
+ *		which have been read, with up to BATCH->NTHREADS threads
+ *		(the calling thread included).  The calling thread also
+ *		decodes the chunks of any thread that can't be created.
+ *		The result for each chunk is left in its STATUS field.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_decode_run(H5D_chunk_decode_batch_t *batch)
+{
+    H5D_chunk_decode_thread_t thread_info[H5D_CHUNK_DECODE_MAX_THREADS]; /* Per-thread info */
+    H5TS_thread_t threads[H5D_CHUNK_DECODE_MAX_THREADS];  /* Decode threads */
+    hbool_t     started[H5D_CHUNK_DECODE_MAX_THREADS];  /* Whether each thread was created */
+    unsigned    nthreads;               /* # of threads used for this batch */
+    unsigned    u;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    nthreads = (unsigned)MIN(batch->nthreads, batch->nused);
+    for(u = 0; u < nthreads; u++) {
+        thread_info[u].batch = batch;
+        thread_info[u].nthreads = nthreads;
+        thread_info[u].thread_idx = u;
+    } /* end for */
+    for(u = 1; u < nthreads; u++)
+        started[u] = (hbool_t)(H5TS_try_create_thread(&threads[u], H5D__chunk_decode_thread, NULL, &thread_info[u]) >= 0);
+    if(nthreads > 0)
+        (void)H5D__chunk_decode_thread(&thread_info[0]);
+
+    /* Decode the share of any thread that couldn't be created here */
+    for(u = 1; u < nthreads; u++)
+        if(!started[u])
+            (void)H5D__chunk_decode_thread(&thread_info[u]);
+    for(u = 1; u < nthreads; u++)
+        if(started[u])
+            H5TS_wait_for_thread(threads[u]);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_decode_run() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_decode_thread
+ *
+ * Purpose:	Thread routine which runs the (reversed) filter pipeline on
+ *		every NTHREADS'th chunk of a batch, starting at the thread's
+ *		index.
+ *
+ * Return:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__chunk_decode_thread(void *_udata)
+{
+    H5D_chunk_decode_thread_t *udata = (H5D_chunk_decode_thread_t *)_udata;
+    H5D_chunk_decode_batch_t *batch = udata->batch;
+    H5Z_cb_t    filter_cb = {NULL, NULL};       /* No filter callback */
+    size_t      u;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = udata->thread_idx; u < batch->nused; u += udata->nthreads) {
+        H5D_chunk_decode_t *item = &batch->item[u];
+
+        /* Skip chunks which couldn't be read */
+        if(item->status < 0)
+            continue;
+        if(H5Z_pipeline(batch->pline, H5Z_FLAG_REVERSE, &item->filter_mask,
+                batch->err_detect, filter_cb, &item->nbytes, &item->buf_alloc,
+                &item->buf) < 0) {
+            /* The error is reported again by the serial read path */
+            H5E_clear_stack(NULL);
+            item->status = FAIL;
+        } /* end if */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(NULL)
+} /* end H5D__chunk_decode_thread() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_decode_release
+ *
+ * Purpose:	Release the chunk buffers which were decoded but not yet
+ *		handed to the chunk cache and empty the batch.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_decode_release(H5D_chunk_decode_batch_t *batch)
+{
+    size_t u;                   /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = batch->next; u < batch->nused; u++)
+        if(batch->item[u].buf)
+            batch->item[u].buf = H5D__chunk_mem_release(batch->item[u].buf, batch->item[u].buf_alloc, batch->pline);
+    batch->nused = batch->next = 0;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_decode_release() */
+#endif /* H5D_CHUNK_PARALLEL_FILTERS */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write
+ *
+ * Purpose:	Writes to a chunked dataset.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Raymond Lu
+ *		Thursday, April 10, 2003
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
+    H5D_chunk_map_t *fm)
+{
+    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
+    H5D_io_info_t ctg_io_info;          /* Contiguous I/O info object */
+    H5D_storage_t ctg_store;            /* Chunk storage information as contiguous dataset */
+    H5D_io_info_t cpt_io_info;          /* Compact I/O info object */
+    H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
+    hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
+    uint32_t    dst_accessed_bytes = 0; /* Total accessed size in a chunk */
+    herr_t	ret_value = SUCCEED;	/* Return value		*/
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(io_info);
+    HDassert(io_info->u.wbuf);
+    HDassert(type_info);
+    HDassert(fm);
+
+    /* Set up contiguous I/O info object */
+    HDmemcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
+    ctg_io_info.store = &ctg_store;
+    ctg_io_info.layout_ops = *H5D_LOPS_CONTIG;
+
+    /* Initialize temporary contiguous storage info */
+    H5_CHECKED_ASSIGN(ctg_store.contig.dset_size, hsize_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
+
+    /* Set up compact I/O info object */
+    HDmemcpy(&cpt_io_info, io_info, sizeof(cpt_io_info));
+    cpt_io_info.store = &cpt_store;
+    cpt_io_info.layout_ops = *H5D_LOPS_COMPACT;
+
+    /* Initialize temporary compact storage info */
+    cpt_store.compact.dirty = &cpt_dirty;
+
+    /* Iterate through nodes in chunk skip list */
+    chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
+    while(chunk_node) {
+        H5D_chunk_info_t *chunk_info;   /* Chunk information */
+	H5D_chk_idx_info_t idx_info;    /* Chunked index info */
         H5D_io_info_t *chk_io_info;     /* Pointer to I/O info object for this chunk */
         void *chunk;                    /* Pointer to locked chunk buffer */
         H5D_chunk_ud_t udata;		/* Index pass-through	*/
@@ -2182,7 +3370,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 entire_chunk = FALSE;
 
             /* Lock the chunk into the cache */
-            if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk, FALSE)))
+            if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk, FALSE, NULL)))
                 HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
             /* Set up the storage buffer information for this chunk */
@@ -2283,6 +3471,13 @@ H5D__chunk_flush(H5D_t *dset, hid_t dxpl_id)
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
+    /* Write the dirty chunks back in address order, if requested */
+    if(rdcc->flush_sorted) {
+        if(H5D__chunk_flush_sorted(dset, dxpl_id, dxpl_cache, NULL, (size_t)0) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
     /* Loop over all entries in the chunk cache */
     for(ent = rdcc->head; ent; ent = next) {
 	next = ent->next;
@@ -2383,6 +3578,11 @@ H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         nerrors++;
 
+    /* Write the dirty chunks back in address order, if requested */
+    if(rdcc->flush_sorted && nerrors == 0)
+        if(H5D__chunk_flush_sorted(dset, dxpl_id, dxpl_cache, NULL, (size_t)0) < 0)
+            nerrors++;
+
     /* Flush all the cached chunks */
     for(ent = rdcc->head; ent; ent = next) {
 	next = ent->next;
@@ -2395,8 +3595,11 @@ H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
 	HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
 
     /* Release cache structures */
-    if(rdcc->slot)
-        rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+    if(rdcc->file)
+        H5D__chunk_cache_file_detach(dset->oloc.file, rdcc);
+    if(rdcc->cls)
+        (rdcc->cls->dest)(rdcc);
+    HDassert(NULL == rdcc->slot);
     HDmemset(rdcc, 0, sizeof(H5D_rdcc_t));
 
     /* Compose chunked index info struct */
@@ -2709,23 +3912,13 @@ H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
 
     /* Check for chunk in cache */
     if(dset->shared->cache.chunk.nslots > 0) {
-        /* Determine the chunk's location in the hash table */
-	idx = H5D__chunk_hash_val(dset->shared, scaled);
+        /* Determine the chunk's location in the cache */
+        idx = (dset->shared->cache.chunk.cls->find)(dset->shared, scaled);
 
         /* Get the chunk cache entry for that location */
-        ent = dset->shared->cache.chunk.slot[idx];
-        if(ent) {
-            unsigned u;                  /* Counter */
-
-            /* Speculatively set the 'found' flag */
+        if(UINT_MAX != idx) {
+            ent = dset->shared->cache.chunk.slot[idx];
             found = TRUE;
-
-            /* Verify that the cache entry is the correct chunk */
-            for(u = 0; u < dset->shared->ndims; u++)
-                if(scaled[u] != ent->scaled[u]) {
-                    found = FALSE;
-                    break;
-                } /* end if */
         } /* end if */
     } /* end if */
 
@@ -2785,25 +3978,499 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_flush_entry
- *
- * Purpose:	Writes a chunk to disk.  If RESET is non-zero then the
- *		entry is cleared -- it's slightly faster to flush a chunk if
- *		the RESET flag is turned on because it results in one fewer
- *		memory copy.
+ * Function:	H5D__chunk_store_raw_mask
  *
- * Return:	Non-negative on success/Negative on failure
+ * Purpose:	Sets FILTER_MASK for storing a chunk unfiltered: every
+ *		filter in the pipeline is skipped except fletcher32, so that
+ *		raw chunks are still checksummed.
  *
- * Programmer:	Robb Matzke
- *              Thursday, May 21, 1998
+ * Return:	TRUE if a filter still has to be applied, FALSE otherwise
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
+static hbool_t
+H5D__chunk_store_raw_mask(const H5O_pline_t *pline, unsigned *filter_mask)
+{
+    hbool_t     ret_value = FALSE;      /* Return value */
+    size_t      u;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(pline);
+    HDassert(filter_mask);
+
+    *filter_mask = 0;
+    for(u = 0; u < pline->nused; u++)
+        if(pline->filter[u].id == H5Z_FILTER_FLETCHER32)
+            ret_value = TRUE;
+        else
+            *filter_mask |= (unsigned)1 << u;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_store_raw_mask() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_prep
+ *
+ * Purpose:	Prepares a dirty chunk for writing to disk: runs it through
+ *		the filter pipeline (into a copy of the chunk, unless RESET
+ *		is set) and allocates or resizes its space in the file.
+ *		On return, BUF points to the data to write and UDATA
+ *		describes the chunk's location in the file.  When BUF is
+ *		not the entry's chunk, it is a filter pipeline buffer of
+ *		BUF_ALLOC bytes (0 if the pipeline failed).  A chunk the
+ *		filters don't shrink below the dataset's store-raw ratio is
+ *		written unfiltered (see H5Pset_chunk_store_raw).
+ *
+ *		If POINT_OF_NO_RETURN is set on return the entry's chunk
+ *		has been handed to the pipeline and can't be recovered if
+ *		anything fails.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_prep(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache,
+    H5D_rdcc_ent_t *ent, hbool_t reset, H5D_chunk_ud_t *udata, void **buf,
+    size_t *buf_alloc, hbool_t *need_insert, hbool_t *point_of_no_return)
+{
+    hbool_t must_alloc = FALSE;         /* Whether the chunk must be allocated */
+    herr_t	ret_value = SUCCEED;	/* Return value			*/
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(ent);
+    HDassert(ent->dirty);
+    HDassert(udata);
+    HDassert(buf && *buf == ent->chunk);
+    HDassert(buf_alloc);
+    HDassert(need_insert);
+    HDassert(point_of_no_return);
+
+    *need_insert = FALSE;
+    *buf_alloc = 0;
+
+    /* Set up user data for index callbacks */
+    udata->common.layout = &dset->shared->layout.u.chunk;
+    udata->common.storage = &dset->shared->layout.storage.u.chunk;
+    udata->common.scaled = ent->scaled;
+    udata->chunk_block.offset = ent->chunk_block.offset;
+    udata->chunk_block.length = dset->shared->layout.u.chunk.size;
+    udata->filter_mask = 0;
+    udata->chunk_idx = ent->chunk_idx;
+
+    /* Should the chunk be filtered before writing it to disk? */
+    if(dset->shared->dcpl_cache.pline.nused
+            && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)) {
+        H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+        double store_raw = dset->shared->dcpl_cache.store_raw; /* Store-raw size ratio */
+        size_t alloc = udata->chunk_block.length;       /* Bytes allocated for BUF	*/
+        size_t nbytes;                      /* Chunk size (in bytes) */
+        hbool_t raw = FALSE;                /* Whether the chunk is stored unfiltered */
+
+        /* Don't try to filter the chunk if the chunks before it didn't compress */
+        if(store_raw > 0.0 && rdcc->raw.skip > 0) {
+            rdcc->raw.skip--;
+            rdcc->stats.nraw_untried++;
+            raw = TRUE;
+        } /* end if */
+        /*
+         * When resetting, the original buffer is only needed if the chunk
+         * may be stored raw, which is likely only while the chunks before
+         * it haven't compressed.  Otherwise a chunk which doesn't shrink
+         * enough is stored filtered.
+         */
+        else if(!reset || (store_raw > 0.0 && rdcc->raw.backoff > 0)) {
+            /*
+             * Copy the chunk to a new buffer before running it through
+             * the pipeline because we'll want to save the original buffer
+             * for later.
+             */
+            if(NULL == (*buf = H5Z_buf_alloc(alloc, &alloc)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+            HDmemcpy(*buf, ent->chunk, (size_t)udata->chunk_block.length);
+        } /* end if */
+        else {
+            /*
+             * If we are reseting and something goes wrong after this
+             * point then it's too late to recover because we may have
+             * destroyed the original data by calling H5Z_pipeline().
+             * The only safe option is to continue with the reset
+             * even if we can't write the data to disk.
+             */
+            *point_of_no_return = TRUE;
+            ent->chunk = NULL;
+        } /* end else */
+        H5_CHECKED_ASSIGN(nbytes, size_t, udata->chunk_block.length, hsize_t);
+        if(!raw) {
+            if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata->filter_mask), dxpl_cache->err_detect,
+                     dxpl_cache->filter_cb, &nbytes, &alloc, buf) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+
+            /* Store the chunk raw if the filters didn't shrink it enough, and
+             * skip the filters for a growing number of the following chunks
+             * while they keep failing to.
+             */
+            if(store_raw > 0.0) {
+                if((double)nbytes >= store_raw * (double)udata->chunk_block.length) {
+                    if(ent->chunk) {
+                        H5Z_buf_free(*buf, alloc);
+                        *buf = ent->chunk;
+                        alloc = 0;
+                        H5_CHECKED_ASSIGN(nbytes, size_t, udata->chunk_block.length, hsize_t);
+                        raw = TRUE;
+                    } /* end if */
+                    rdcc->raw.backoff = rdcc->raw.backoff ? MIN(2 * rdcc->raw.backoff, H5D_CHUNK_STORE_RAW_MAX_SKIP) : 1;
+                    rdcc->raw.skip = rdcc->raw.backoff;
+                } /* end if */
+                else
+                    rdcc->raw.backoff = 0;
+            } /* end if */
+        } /* end if */
+
+        /* Store the chunk unfiltered, except for its checksum */
+        if(raw) {
+            rdcc->stats.nraw++;
+            if(H5D__chunk_store_raw_mask(&(dset->shared->dcpl_cache.pline), &(udata->filter_mask))) {
+                alloc = nbytes;
+                if(NULL == (*buf = H5Z_buf_alloc(alloc, &alloc)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+                HDmemcpy(*buf, ent->chunk, nbytes);
+                if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata->filter_mask), dxpl_cache->err_detect,
+                         dxpl_cache->filter_cb, &nbytes, &alloc, buf) < 0)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+            } /* end if */
+        } /* end if */
+        *buf_alloc = alloc;
+#if H5_SIZEOF_SIZE_T > 4
+        /* Check for the chunk expanding too much to encode in a 32-bit value */
+        if(nbytes > ((size_t)0xffffffff))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+        H5_CHECKED_ASSIGN(udata->chunk_block.length, hsize_t, nbytes, size_t);
+
+        /* Indicate that the chunk must be allocated */
+        must_alloc = TRUE;
+    } /* end if */
+    else if(!H5F_addr_defined(udata->chunk_block.offset)) {
+        /* Indicate that the chunk must be allocated */
+        must_alloc = TRUE;
+
+        /* This flag could be set for this chunk, just remove and ignore it
+         */
+        ent->edge_chunk_state &= ~H5D_RDCC_NEWLY_DISABLED_FILTERS;
+    } /* end else */
+    else if(ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS) {
+        /* Chunk on disk is still filtered, must insert to allocate correct
+         * size */
+        must_alloc = TRUE;
+
+        /* Set the disable filters field back to the standard disable
+         * filters setting, as it no longer needs to be inserted with every
+         * flush */
+        ent->edge_chunk_state &= ~H5D_RDCC_NEWLY_DISABLED_FILTERS;
+    } /* end else */
+
+    HDassert(!(ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS));
+
+    /* Check if the chunk needs to be allocated (it also could exist already
+     *      and the chunk alloc operation could resize it)
+     */
+    if(must_alloc) {
+        H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.dxpl_id = dxpl_id;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+        /* Create the chunk it if it doesn't exist, or reallocate the chunk
+         *  if its size changed.
+         */
+        if(H5D__chunk_file_alloc(&idx_info, &(ent->chunk_block), &udata->chunk_block, need_insert, ent->scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+
+        /* Update the chunk entry's info, in case it was allocated or relocated */
+        ent->chunk_block.offset = udata->chunk_block.offset;
+        ent->chunk_block.length = udata->chunk_block.length;
+    } /* end if */
+
+    HDassert(H5F_addr_defined(udata->chunk_block.offset));
+    H5_CHECK_OVERFLOW(udata->chunk_block.length, hsize_t, size_t);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_prep() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_done
+ *
+ * Purpose:	Finishes flushing a chunk once it has been written to disk:
+ *		inserts the chunk into the index if needed and marks the
+ *		cache entry clean.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_done(const H5D_t *dset, hid_t dxpl_id, H5D_rdcc_ent_t *ent,
+    H5D_chunk_ud_t *udata, hbool_t need_insert)
+{
+    herr_t	ret_value = SUCCEED;	/* Return value			*/
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(ent);
+    HDassert(udata);
+
+    /* Insert the chunk record into the index */
+    if(need_insert && dset->shared->layout.storage.u.chunk.ops->insert) {
+        H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.dxpl_id = dxpl_id;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+        if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, udata, dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+    } /* end if */
+
+    /* Cache the chunk's info, in case it's accessed again shortly */
+    H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, udata);
+
+    /* Mark cache entry as clean */
+    ent->dirty = FALSE;
+
+    /* Increment # of flushed entries */
+    dset->shared->cache.chunk.stats.nflushes++;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_done() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_sorted
+ *
+ * Purpose:	Writes the dirty chunks in ENTS (or, if ENTS is NULL, all
+ *		the dirty, unlocked chunks) of a dataset to disk together.
+ *		The chunks are prepared (filtered and allocated)
+ *		in chunk index order, so that newly allocated chunks tend
+ *		to be placed contiguously in the file, then written in
+ *		order of their addresses, combining runs of adjacent chunks
+ *		into single writes of up to H5D_CHUNK_FLUSH_COALESCE_MAX
+ *		bytes.  The entries stay in the cache.
+ *
+ *		Writing stops at the first write which fails: the chunks
+ *		not written yet stay dirty.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_sorted(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache,
+    H5D_rdcc_ent_t **ents, size_t nents)
+{
+    const H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);     /* Dataset's chunk cache */
+    H5D_rdcc_ent_t *ent;                /* Cache entry */
+    H5D_chunk_wb_t *wb = NULL;          /* Dirty chunks to write back */
+    size_t      nwb = 0;                /* # of dirty chunks */
+    size_t      nprep = 0;              /* # of chunks prepared for writing */
+    uint8_t     *run_buf = NULL;        /* Buffer for combining adjacent chunks */
+    size_t      run_buf_size = 0;       /* Size of run_buf */
+    size_t      u, v;                   /* Local index variables */
+    unsigned    nerrors = 0;            /* Count of chunks which couldn't be flushed */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    HDassert(dset);
+    HDassert(dxpl_cache);
+
+    /* Gather the dirty chunks */
+    if(ents)
+        nwb = nents;
+    else
+        for(ent = rdcc->head; ent; ent = ent->next)
+            if(ent->dirty && !ent->locked)
+                nwb++;
+    if(0 == nwb)
+        HGOTO_DONE(SUCCEED)
+    if(NULL == (wb = (H5D_chunk_wb_t *)H5MM_malloc(nwb * sizeof(H5D_chunk_wb_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for dirty chunk list")
+    if(ents)
+        for(u = 0; u < nwb; u++) {
+            HDassert(ents[u]->dirty);
+            wb[u].ent = ents[u];
+        } /* end for */
+    else
+        for(ent = rdcc->head, u = 0; ent; ent = ent->next)
+            if(ent->dirty && !ent->locked)
+                wb[u++].ent = ent;
+    for(u = 0; u < nwb; u++)
+        wb[u].idx = H5VM_array_offset_pre(dset->shared->ndims, dset->shared->layout.u.chunk.down_chunks, wb[u].ent->scaled);
+
+    /* Filter the chunks and allocate their space, in chunk index order */
+    HDqsort(wb, nwb, sizeof(H5D_chunk_wb_t), H5D__chunk_flush_idx_cmp);
+    for(u = 0; u < nwb; u++) {
+        hbool_t point_of_no_return = FALSE;     /* Not used, since the entries aren't reset */
+
+        wb[nprep] = wb[u];
+        wb[nprep].buf = wb[nprep].ent->chunk;
+        if(H5D__chunk_flush_prep(dset, dxpl_id, dxpl_cache, wb[nprep].ent, FALSE, &wb[nprep].udata, &wb[nprep].buf, &wb[nprep].buf_alloc, &wb[nprep].need_insert, &point_of_no_return) < 0) {
+            if(wb[nprep].buf != wb[nprep].ent->chunk)
+                H5Z_buf_free(wb[nprep].buf, wb[nprep].buf_alloc);
+            nerrors++;
+        } /* end if */
+        else
+            nprep++;
+    } /* end for */
+
+    /* Write the chunks in address order, combining adjacent chunks */
+    HDqsort(wb, nprep, sizeof(H5D_chunk_wb_t), H5D__chunk_flush_addr_cmp);
+    for(u = 0; u < nprep; u = v) {
+        haddr_t run_addr = wb[u].udata.chunk_block.offset;     /* Address of run */
+        size_t  run_size = (size_t)wb[u].udata.chunk_block.length;  /* Size of run */
+        const void *write_buf = wb[u].buf;      /* Data to write */
+
+        /* Find the chunks which follow on in the file */
+        for(v = u + 1; v < nprep; v++) {
+            if(H5F_addr_ne(run_addr + run_size, wb[v].udata.chunk_block.offset)
+                    || run_size + (size_t)wb[v].udata.chunk_block.length > H5D_CHUNK_FLUSH_COALESCE_MAX)
+                break;
+            run_size += (size_t)wb[v].udata.chunk_block.length;
+        } /* end for */
+
+        /* Combine the chunks of the run */
+        if(v > u + 1) {
+            size_t w;           /* Local index variable */
+            size_t off = 0;     /* Offset in run_buf */
+
+            if(run_size > run_buf_size) {
+                H5MM_xfree(run_buf);
+                if(NULL == (run_buf = (uint8_t *)H5MM_malloc(run_size))) {
+                    run_buf_size = 0;
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for write buffer")
+                } /* end if */
+                run_buf_size = run_size;
+            } /* end if */
+            for(w = u; w < v; w++) {
+                HDmemcpy(run_buf + off, wb[w].buf, (size_t)wb[w].udata.chunk_block.length);
+                off += (size_t)wb[w].udata.chunk_block.length;
+            } /* end for */
+            write_buf = run_buf;
+        } /* end if */
+
+        /* Write the run to the file (the space of the chunks not written
+         * yet isn't in the index, so stop rather than moving on) */
+        if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, run_addr, run_size, H5AC_rawdata_dxpl_id, write_buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write raw data chunks")
+
+        /* Finish off the chunks */
+        for( ; u < v; u++)
+            if(H5D__chunk_flush_done(dset, dxpl_id, wb[u].ent, &wb[u].udata, wb[u].need_insert) < 0)
+                nerrors++;
+    } /* end for */
+
+    if(nerrors)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+
+done:
+    if(wb) {
+        for(u = 0; u < nprep; u++)
+            if(wb[u].buf != wb[u].ent->chunk)
+                H5Z_buf_free(wb[u].buf, wb[u].buf_alloc);
+        H5MM_xfree(wb);
+    } /* end if */
+    H5MM_xfree(run_buf);
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_flush_sorted() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_idx_cmp
+ *
+ * Purpose:	Compare the chunk indices of two dirty chunks, for sorting
+ *		them.
+ *
+ * Return:	-1, 0 or 1, as for qsort()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_flush_idx_cmp(const void *_wb1, const void *_wb2)
+{
+    const H5D_chunk_wb_t *wb1 = (const H5D_chunk_wb_t *)_wb1;
+    const H5D_chunk_wb_t *wb2 = (const H5D_chunk_wb_t *)_wb2;
+    int ret_value = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(wb1->idx < wb2->idx)
+        ret_value = -1;
+    else if(wb1->idx > wb2->idx)
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_idx_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_addr_cmp
+ *
+ * Purpose:	Compare the file addresses of two dirty chunks, for sorting
+ *		them.
+ *
+ * Return:	-1, 0 or 1, as for qsort()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_flush_addr_cmp(const void *_wb1, const void *_wb2)
+{
+    const H5D_chunk_wb_t *wb1 = (const H5D_chunk_wb_t *)_wb1;
+    const H5D_chunk_wb_t *wb2 = (const H5D_chunk_wb_t *)_wb2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    FUNC_LEAVE_NOAPI(H5F_addr_cmp(wb1->udata.chunk_block.offset, wb2->udata.chunk_block.offset))
+} /* end H5D__chunk_flush_addr_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_entry
+ *
+ * Purpose:	Writes a chunk to disk.  If RESET is non-zero then the
+ *		entry is cleared -- it's slightly faster to flush a chunk if
+ *		the RESET flag is turned on because it results in one fewer
+ *		memory copy.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
 H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache,
     H5D_rdcc_ent_t *ent, hbool_t reset)
 {
     void	*buf = NULL;	        /* Temporary buffer		*/
+    size_t	buf_alloc = 0;		/* Size of temporary buffer	*/
     hbool_t	point_of_no_return = FALSE;
     H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
     herr_t	ret_value = SUCCEED;	/* Return value			*/
@@ -2819,123 +4486,20 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
 
     buf = ent->chunk;
     if(ent->dirty) {
-	H5D_chk_idx_info_t idx_info;    /* Chunked index info */
         H5D_chunk_ud_t 	udata;		/* pass through B-tree		*/
-        hbool_t must_alloc = FALSE;     /* Whether the chunk must be allocated */
 	hbool_t need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
 
-        /* Set up user data for index callbacks */
-        udata.common.layout = &dset->shared->layout.u.chunk;
-        udata.common.storage = &dset->shared->layout.storage.u.chunk;
-	udata.common.scaled = ent->scaled;
-        udata.chunk_block.offset = ent->chunk_block.offset;
-        udata.chunk_block.length = dset->shared->layout.u.chunk.size;
-        udata.filter_mask = 0;
-	udata.chunk_idx = ent->chunk_idx;
-
-        /* Should the chunk be filtered before writing it to disk? */
-        if(dset->shared->dcpl_cache.pline.nused
-                && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)) {
-            size_t alloc = udata.chunk_block.length;        /* Bytes allocated for BUF	*/
-            size_t nbytes;                      /* Chunk size (in bytes) */
-
-            if(!reset) {
-                /*
-                 * Copy the chunk to a new buffer before running it through
-                 * the pipeline because we'll want to save the original buffer
-                 * for later.
-                 */
-                if(NULL == (buf = H5MM_malloc(alloc)))
-                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
-                HDmemcpy(buf, ent->chunk, alloc);
-            } /* end if */
-            else {
-                /*
-                 * If we are reseting and something goes wrong after this
-                 * point then it's too late to recover because we may have
-                 * destroyed the original data by calling H5Z_pipeline().
-                 * The only safe option is to continue with the reset
-                 * even if we can't write the data to disk.
-                 */
-                point_of_no_return = TRUE;
-                ent->chunk = NULL;
-            } /* end else */
-            H5_CHECKED_ASSIGN(nbytes, size_t, udata.chunk_block.length, hsize_t);
-            if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask), dxpl_cache->err_detect,
-                     dxpl_cache->filter_cb, &nbytes, &alloc, &buf) < 0)
-                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
-#if H5_SIZEOF_SIZE_T > 4
-            /* Check for the chunk expanding too much to encode in a 32-bit value */
-            if(nbytes > ((size_t)0xffffffff))
-                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
-#endif /* H5_SIZEOF_SIZE_T > 4 */
-            H5_CHECKED_ASSIGN(udata.chunk_block.length, hsize_t, nbytes, size_t);
-
-            /* Indicate that the chunk must be allocated */
-            must_alloc = TRUE;
-        } /* end if */
-        else if(!H5F_addr_defined(udata.chunk_block.offset)) {
-            /* Indicate that the chunk must be allocated */
-            must_alloc = TRUE;
-
-            /* This flag could be set for this chunk, just remove and ignore it
-             */
-            ent->edge_chunk_state &= ~H5D_RDCC_NEWLY_DISABLED_FILTERS;
-        } /* end else */
-        else if(ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS) {
-            /* Chunk on disk is still filtered, must insert to allocate correct
-             * size */
-            must_alloc = TRUE;
-
-            /* Set the disable filters field back to the standard disable
-             * filters setting, as it no longer needs to be inserted with every
-             * flush */
-            ent->edge_chunk_state &= ~H5D_RDCC_NEWLY_DISABLED_FILTERS;
-        } /* end else */
-
-        HDassert(!(ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS));
-
-        /* Check if the chunk needs to be allocated (it also could exist already
-         *      and the chunk alloc operation could resize it)
-         */
-        if(must_alloc) {
-            /* Compose chunked index info struct */
-            idx_info.f = dset->oloc.file;
-            idx_info.dxpl_id = dxpl_id;
-            idx_info.pline = &dset->shared->dcpl_cache.pline;
-            idx_info.layout = &dset->shared->layout.u.chunk;
-            idx_info.storage = &dset->shared->layout.storage.u.chunk;
-
-            /* Create the chunk it if it doesn't exist, or reallocate the chunk
-             *  if its size changed.
-             */
-	    if(H5D__chunk_file_alloc(&idx_info, &(ent->chunk_block), &udata.chunk_block, &need_insert, ent->scaled) < 0)
-		HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
-
-            /* Update the chunk entry's info, in case it was allocated or relocated */
-            ent->chunk_block.offset = udata.chunk_block.offset;
-            ent->chunk_block.length = udata.chunk_block.length;
-        } /* end if */
+        /* Filter the chunk and allocate its space in the file */
+        if(H5D__chunk_flush_prep(dset, dxpl_id, dxpl_cache, ent, reset, &udata, &buf, &buf_alloc, &need_insert, &point_of_no_return) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to prepare chunk for writing")
 
         /* Write the data to the file */
-        HDassert(H5F_addr_defined(udata.chunk_block.offset));
-        H5_CHECK_OVERFLOW(udata.chunk_block.length, hsize_t, size_t);
         if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, (size_t)udata.chunk_block.length, H5AC_rawdata_dxpl_id, buf) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
 
-        /* Insert the chunk record into the index */
-	if(need_insert && dset->shared->layout.storage.u.chunk.ops->insert)
-            if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, dset) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
-
-        /* Cache the chunk's info, in case it's accessed again shortly */
-        H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, &udata);
-
-        /* Mark cache entry as clean */
-        ent->dirty = FALSE;
-
-        /* Increment # of flushed entries */
-        dset->shared->cache.chunk.stats.nflushes++;
+        /* Insert the chunk into the index and mark the entry clean */
+        if(H5D__chunk_flush_done(dset, dxpl_id, ent, &udata, need_insert) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to finish flushing chunk")
     } /* end if */
 
     /* Reset, but do not free or removed from list */
@@ -2944,7 +4508,8 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
         if(buf == ent->chunk)
             buf = NULL;
         if(ent->chunk != NULL)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
+            ent->chunk = (uint8_t *)H5D__chunk_mem_release(ent->chunk,
+                    (size_t)dset->shared->layout.u.chunk.size,
                     ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
                     : &(dset->shared->dcpl_cache.pline)));
     } /* end if */
@@ -2952,7 +4517,7 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
 done:
     /* Free the temp buffer only if it's different than the entry chunk */
     if(buf != ent->chunk)
-        H5MM_xfree(buf);
+        H5Z_buf_free(buf, buf_alloc);
 
     /*
      * If we reached the point of no return then we have no choice but to
@@ -2962,7 +4527,8 @@ done:
      */
     if(ret_value < 0 && point_of_no_return)
         if(ent->chunk)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
+            ent->chunk = (uint8_t *)H5D__chunk_mem_release(ent->chunk,
+                    (size_t)dset->shared->layout.u.chunk.size,
                     ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
                     : &(dset->shared->dcpl_cache.pline)));
 
@@ -3006,11 +4572,18 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     else {
         /* Don't flush, just free chunk */
 	if(ent->chunk != NULL)
-	    ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
+	    ent->chunk = (uint8_t *)H5D__chunk_mem_release(ent->chunk,
+                    (size_t)dset->shared->layout.u.chunk.size,
                     ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
                     : &(dset->shared->dcpl_cache.pline)));
     } /* end else */
 
+    /* Release any replacement policy information */
+    if(rdcc->cls->remove)
+        (rdcc->cls->remove)(dset->shared, ent);
+    if(rdcc->file)
+        H5D__chunk_cache_file_remove(dset->shared, ent);
+
     /* Unlink from list */
     if(ent->prev)
 	ent->prev->next = ent->next;
@@ -3037,125 +4610,1248 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
          */
         rdcc->slot[ent->idx] = NULL;
 
-    /* Remove from cache */
-    HDassert(rdcc->slot[ent->idx] != ent);
-    ent->idx = UINT_MAX;
-    rdcc->nbytes_used -= dset->shared->layout.u.chunk.size;
-    --rdcc->nused;
+    /* Remove from cache */
+    HDassert(rdcc->slot[ent->idx] != ent);
+    ent->idx = UINT_MAX;
+    rdcc->nbytes_used -= dset->shared->layout.u.chunk.size;
+    --rdcc->nused;
+
+    /* Free */
+    ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_evict() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_preempt
+ *
+ * Purpose:	Preempts an entry chosen by one of the pruning routines.
+ *		If the dataset's dirty chunks are written back in address
+ *		order, a dirty entry is only added to VICTIMS, to be
+ *		written back with the other victims and evicted by
+ *		H5D__chunk_cache_preempt_flush.  Until then the entry is
+ *		marked as locked, so it isn't chosen again.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_preempt(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent,
+    H5D_chunk_victims_t *victims)
+{
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(ent);
+    HDassert(!ent->locked);
+    HDassert(victims);
+
+    if(ent->dirty && dset->shared->cache.chunk.flush_sorted) {
+        if(victims->nused == victims->nalloc) {
+            size_t na = MAX(victims->nalloc * 2, 8);
+            H5D_rdcc_ent_t **x;
+
+            if(NULL == (x = (H5D_rdcc_ent_t **)H5MM_realloc(victims->ent, na * sizeof(H5D_rdcc_ent_t *))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for preempted chunks")
+            victims->ent = x;
+            victims->nalloc = na;
+        } /* end if */
+        ent->locked = TRUE;
+        victims->ent[victims->nused++] = ent;
+        victims->nbytes += dset->shared->layout.u.chunk.size;
+    } /* end if */
+    else {
+        if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt chunk from cache")
+        dset->shared->cache.chunk.stats.nevictions++;
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_preempt() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_preempt_flush
+ *
+ * Purpose:	Writes the dirty chunks collected in VICTIMS back in
+ *		address order, then evicts them and empties VICTIMS.  A
+ *		chunk which couldn't be written with the others is flushed
+ *		on its own as it's evicted.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_preempt_flush(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_chunk_victims_t *victims)
+{
+    size_t      u;                      /* Local index variable */
+    int         nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(victims);
+
+    if(victims->nused) {
+        for(u = 0; u < victims->nused; u++)
+            victims->ent[u]->locked = FALSE;
+        if(H5D__chunk_flush_sorted(dset, dxpl_id, dxpl_cache, victims->ent, victims->nused) < 0)
+            nerrors++;
+        for(u = 0; u < victims->nused; u++)
+            if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, victims->ent[u], TRUE) < 0)
+                nerrors++;
+            else
+                dset->shared->cache.chunk.stats.nevictions++;
+    } /* end if */
+    victims->ent = (H5D_rdcc_ent_t **)H5MM_xfree(victims->ent);
+    victims->nused = victims->nalloc = victims->nbytes = 0;
+
+    if(nerrors)
+	HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_preempt_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_prune
+ *
+ * Purpose:	Prune the cache by preempting some things until the cache has
+ *		room for something which is SIZE bytes.  Only unlocked
+ *		entries are considered for preemption.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, size_t size)
+{
+    const H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);
+    size_t		total = rdcc->nbytes_max;
+    const int		nmeth = 2;	/*number of methods		*/
+    int		        w[1];		/*weighting as an interval	*/
+    H5D_rdcc_ent_t	*p[2], *cur;	/*list pointers			*/
+    H5D_rdcc_ent_t	*n[2];		/*list next pointers		*/
+    H5D_chunk_victims_t victims;        /* Dirty chunks written back together */
+    int		nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDmemset(&victims, 0, sizeof(victims));
+
+    /*
+     * Preemption is accomplished by having multiple pointers (currently two)
+     * slide down the list beginning at the head. Pointer p(N+1) will start
+     * traversing the list when pointer pN reaches wN percent of the original
+     * list.  In other words, preemption method N gets to consider entries in
+     * approximate least recently used order w0 percent before method N+1
+     * where 100% means tha method N will run to completion before method N+1
+     * begins.  The pointers participating in the list traversal are each
+     * given a chance at preemption before any of the pointers are advanced.
+     */
+    w[0] = (int)(rdcc->nused * rdcc->w0);
+    p[0] = rdcc->head;
+    p[1] = NULL;
+
+    while((p[0] || p[1]) && (rdcc->nbytes_used - victims.nbytes + size) > total) {
+        int i;          /* Local index variable */
+
+	/* Introduce new pointers */
+	for(i = 0; i < nmeth - 1; i++)
+            if(0 == w[i])
+                p[i + 1] = rdcc->head;
+
+	/* Compute next value for each pointer */
+	for(i = 0; i < nmeth; i++)
+            n[i] = p[i] ? p[i]->next : NULL;
+
+	/* Give each method a chance */
+	for(i = 0; i < nmeth && (rdcc->nbytes_used - victims.nbytes + size) > total; i++) {
+	    if(0 == i && p[0] && !p[0]->locked &&
+                    ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
+                     (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
+                     (dset->shared->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
+		/*
+		 * Method 0: Preempt entries that have been completely written
+		 * and/or completely read but not entries that are partially
+		 * written or partially read.
+		 */
+		cur = p[0];
+	    } else if(1 == i && p[1] && !p[1]->locked) {
+		/*
+		 * Method 1: Preempt the entry without regard to
+		 * considerations other than being locked.  This is the last
+		 * resort preemption.
+		 */
+		cur = p[1];
+	    } else {
+		/* Nothing to preempt at this point */
+		cur = NULL;
+	    }
+
+	    if(cur) {
+                int j;          /* Local index variable */
+
+		for(j = 0; j < nmeth; j++) {
+		    if(p[j] == cur)
+                        p[j] = NULL;
+		    if(n[j] == cur)
+                        n[j] = cur->next;
+		} /* end for */
+		if(H5D__chunk_cache_preempt(dset, dxpl_id, dxpl_cache, cur, &victims) < 0)
+                    nerrors++;
+	    } /* end if */
+	} /* end for */
+
+	/* Advance pointers */
+	for(i = 0; i < nmeth; i++)
+            p[i] = n[i];
+	for(i = 0; i < nmeth - 1; i++)
+            w[i] -= 1;
+    } /* end while */
+
+    /* Write back and evict the dirty chunks chosen */
+    if(H5D__chunk_cache_preempt_flush(dset, dxpl_id, dxpl_cache, &victims) < 0)
+        nerrors++;
+
+    if(nerrors)
+	HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_prune() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_lru_init
+ *
+ * Purpose:	Allocate the hash table for the LRU chunk cache policy.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_lru_init(H5D_rdcc_t *rdcc)
+{
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(rdcc);
+    HDassert(rdcc->nslots > 0);
+
+    if(NULL == (rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_lru_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_lru_find
+ *
+ * Purpose:	Look up a chunk in the LRU chunk cache.  The chunk can only
+ *		be in the slot its coordinates hash to.
+ *
+ * Return:	Slot of the chunk, or UINT_MAX if it's not cached
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_cache_lru_find(const H5D_shared_t *shared, const hsize_t *scaled)
+{
+    const H5D_rdcc_ent_t *ent;  /* Cache entry */
+    unsigned    idx;            /* Index of chunk's slot */
+    unsigned    u;              /* Local index variable */
+    unsigned    ret_value = UINT_MAX;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(shared);
+    HDassert(scaled);
+
+    /* Determine the chunk's location in the hash table */
+    idx = H5D__chunk_hash_val(shared, scaled);
+
+    /* Verify that the cache entry at that location is the correct chunk */
+    if(NULL != (ent = shared->cache.chunk.slot[idx])) {
+        for(u = 0; u < shared->ndims; u++)
+            if(scaled[u] != ent->scaled[u])
+                HGOTO_DONE(UINT_MAX)
+        ret_value = idx;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_lru_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_lru_admit
+ *
+ * Purpose:	Make room in the LRU chunk cache for a new chunk.  The chunk
+ *		currently in the slot the new chunk hashes to is preempted,
+ *		unless it's locked, in which case the new chunk is not
+ *		cached (and *IDX is set to UINT_MAX).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_lru_admit(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, const hsize_t *scaled, unsigned *idx)
+{
+    const H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);  /* Raw data chunk cache */
+    H5D_rdcc_ent_t *ent;        /* Entry in the chunk's slot */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(idx);
+
+    /* Calculate the index */
+    *idx = H5D__chunk_hash_val(dset->shared, scaled);
+
+    /* Add the chunk to the cache only if the slot is not already locked */
+    ent = rdcc->slot[*idx];
+    if(ent && ent->locked) {
+        *idx = UINT_MAX;
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Preempt enough things from the cache to make room */
+    if(ent) {
+        if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "unable to preempt chunk from cache")
+        dset->shared->cache.chunk.stats.nevictions++;
+        dset->shared->cache.chunk.stats.ncollisions++;
+    } /* end if */
+    if(H5D__chunk_cache_prune(dset, dxpl_id, dxpl_cache, (size_t)dset->shared->layout.u.chunk.size) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "unable to preempt chunk(s) from cache")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_lru_admit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_lru_insert
+ *
+ * Purpose:	Add a new entry to the end of the LRU chunk cache's list.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_lru_insert(H5D_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(ent);
+
+    if(rdcc->tail) {
+        rdcc->tail->next = ent;
+        ent->prev = rdcc->tail;
+        rdcc->tail = ent;
+    } /* end if */
+    else
+        rdcc->head = rdcc->tail = ent;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_lru_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_lru_hit
+ *
+ * Purpose:	If the chunk is not at the beginning of the cache; move it
+ *		backward by one slot.  This is how we implement the LRU
+ *		preemption algorithm.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_lru_hit(H5D_rdcc_t *rdcc, H5D_rdcc_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(rdcc);
+    HDassert(ent);
+
+    if(ent->next) {
+        if(ent->next->next)
+            ent->next->next->prev = ent;
+        else
+            rdcc->tail = ent;
+        ent->next->prev = ent->prev;
+        if(ent->prev)
+            ent->prev->next = ent->next;
+        else
+            rdcc->head = ent->next;
+        ent->prev = ent->next;
+        ent->next = ent->next->next;
+        ent->prev->next = ent;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_lru_hit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_lru_dest
+ *
+ * Purpose:	Release the hash table of the LRU chunk cache policy.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_lru_dest(H5D_rdcc_t *rdcc)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(rdcc);
+    HDassert(NULL == rdcc->head);
+
+    if(rdcc->slot)
+        rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_lru_dest() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_hash
+ *
+ * Purpose:	Hash the scaled coordinates of a chunk for the 2Q chunk
+ *		cache.  Unlike H5D__chunk_hash_val(), the value does not
+ *		depend on the dataset's extent or the number of slots, so
+ *		it can also be remembered after the chunk is preempted.
+ *
+ * Return:	Hash value
+ *
+ *-------------------------------------------------------------------------
+ */
+static hsize_t
+H5D__chunk_cache_2q_hash(unsigned ndims, const hsize_t *scaled)
+{
+    hsize_t     val = 0;        /* Hash value */
+    unsigned    u;              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(scaled);
+
+    for(u = 0; u < ndims; u++)
+        val = (val ^ scaled[u]) * H5D_RDCC_2Q_HASH_MULT;
+
+    /* Fold the well-mixed high bits into the low bits used for buckets */
+    val ^= val >> 29;
+
+    FUNC_LEAVE_NOAPI(val)
+} /* end H5D__chunk_cache_2q_hash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_rehash
+ *
+ * Purpose:	Resize the hash buckets of the 2Q chunk cache so there is
+ *		at least one bucket per slot, and rechain all entries.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_2q_rehash(H5D_shared_t *shared)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    H5D_rdcc_ent_t **bucket;    /* New hash buckets */
+    H5D_rdcc_ent_t *ent;        /* Cache entry */
+    size_t      nbuckets;       /* New number of buckets */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    nbuckets = (size_t)H5VM_power2up((hsize_t)rdcc->nslots);
+    if(NULL == (bucket = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, nbuckets)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk cache buckets")
+
+    /* All cached chunks are on the list */
+    for(ent = rdcc->head; ent; ent = ent->next) {
+        size_t b = (size_t)H5D__chunk_cache_2q_hash(shared->ndims, ent->scaled) & (nbuckets - 1);
+
+        ent->hnext = bucket[b];
+        bucket[b] = ent;
+    } /* end for */
+
+    if(rdcc->q2.bucket)
+        rdcc->q2.bucket = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->q2.bucket);
+    rdcc->q2.bucket = bucket;
+    rdcc->q2.nbuckets = nbuckets;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_2q_rehash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_init
+ *
+ * Purpose:	Allocate the slots, free slot stack and hash buckets of the
+ *		2Q chunk cache policy.  The number of slots is the initial
+ *		size of the slot table, which grows as needed.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_2q_init(H5D_rdcc_t *rdcc)
+{
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(rdcc);
+    HDassert(rdcc->nslots > 0);
+    HDassert(NULL == rdcc->head);
+
+    if(NULL == (rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    if(NULL == (rdcc->q2.free_idx = (unsigned *)H5MM_malloc(rdcc->nslots * sizeof(unsigned))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+
+    /* Hand out the lowest slots first */
+    for(u = 0; u < rdcc->nslots; u++)
+        rdcc->q2.free_idx[u] = (unsigned)(rdcc->nslots - u - 1);
+    rdcc->q2.nfree = rdcc->nslots;
+
+    rdcc->q2.nbuckets = (size_t)H5VM_power2up((hsize_t)rdcc->nslots);
+    if(NULL == (rdcc->q2.bucket = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->q2.nbuckets)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+
+    rdcc->q2.am_head = NULL;
+    rdcc->q2.a1in_nbytes = 0;
+
+done:
+    if(ret_value < 0)
+        H5D__chunk_cache_2q_dest(rdcc);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_2q_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_find
+ *
+ * Purpose:	Look up a chunk in the 2Q chunk cache.
+ *
+ * Return:	Slot of the chunk, or UINT_MAX if it's not cached
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_cache_2q_find(const H5D_shared_t *shared, const hsize_t *scaled)
+{
+    const H5D_rdcc_t *rdcc = &(shared->cache.chunk);    /* Raw data chunk cache */
+    const H5D_rdcc_ent_t *ent;  /* Cache entry */
+    size_t      b;              /* Bucket of chunk */
+    unsigned    ret_value = UINT_MAX;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(scaled);
+    HDassert(rdcc->q2.bucket);
+
+    b = (size_t)H5D__chunk_cache_2q_hash(shared->ndims, scaled) & (rdcc->q2.nbuckets - 1);
+    for(ent = rdcc->q2.bucket[b]; ent; ent = ent->hnext) {
+        unsigned u;             /* Local index variable */
+
+        for(u = 0; u < shared->ndims; u++)
+            if(scaled[u] != ent->scaled[u])
+                break;
+        if(u == shared->ndims)
+            HGOTO_DONE(ent->idx)
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_2q_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_admit
+ *
+ * Purpose:	Make room in the 2Q chunk cache for a new chunk and return
+ *		a free slot for it, doubling the slot table if all slots
+ *		are in use.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_2q_admit(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, const hsize_t *scaled, unsigned *idx)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(scaled);
+    HDassert(idx);
+
+    /* Chunks referenced again after leaving 'A1in' will be promoted to 'Am'.
+     * (Check before pruning, which may push the chunk's hash out of the ring)
+     */
+    rdcc->q2.promote = FALSE;
+    if(rdcc->q2.ghost_set) {
+        hsize_t hash = H5D__chunk_cache_2q_hash(dset->shared->ndims, scaled);
+
+        rdcc->q2.promote = (NULL != H5SL_remove(rdcc->q2.ghost_set, &hash));
+    } /* end if */
+
+    /* Preempt enough things from the cache to make room */
+    if(H5D__chunk_cache_2q_prune(dset, dxpl_id, dxpl_cache, (size_t)dset->shared->layout.u.chunk.size) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "unable to preempt chunk(s) from cache")
+
+    /* Grow the slot table, if it's full */
+    if(0 == rdcc->q2.nfree) {
+        H5D_rdcc_ent_t **slot;  /* Resized slot table */
+        unsigned *free_idx;     /* Resized free slot stack */
+        size_t new_nslots;      /* New number of slots */
+        size_t u;               /* Local index variable */
+
+        /* Don't cache the chunk if the table can't grow any further */
+        new_nslots = MIN(rdcc->nslots * 2, (size_t)(UINT_MAX - 1));
+        if(new_nslots <= rdcc->nslots) {
+            *idx = UINT_MAX;
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+
+        if(NULL == (slot = H5FL_SEQ_REALLOC(H5D_rdcc_ent_ptr_t, rdcc->slot, new_nslots)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk cache slots")
+        rdcc->slot = slot;
+        if(NULL == (free_idx = (unsigned *)H5MM_realloc(rdcc->q2.free_idx, new_nslots * sizeof(unsigned))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk cache slots")
+        rdcc->q2.free_idx = free_idx;
+
+        /* Initialize the new slots and put them on the free stack */
+        for(u = rdcc->nslots; u < new_nslots; u++) {
+            rdcc->slot[u] = NULL;
+            rdcc->q2.free_idx[rdcc->q2.nfree++] = (unsigned)(new_nslots - (u - rdcc->nslots) - 1);
+        } /* end for */
+        rdcc->nslots = new_nslots;
+
+        /* Keep at least one bucket per slot */
+        if(rdcc->q2.nbuckets < rdcc->nslots)
+            if(H5D__chunk_cache_2q_rehash(dset->shared) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTRESIZE, FAIL, "unable to resize chunk cache hash table")
+    } /* end if */
+
+    *idx = rdcc->q2.free_idx[--rdcc->q2.nfree];
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_2q_admit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_insert
+ *
+ * Purpose:	Add a new entry to the 2Q chunk cache.  Chunks which were
+ *		recently preempted from the 'A1in' FIFO (as determined by
+ *		H5D__chunk_cache_2q_admit) go to the end of the 'Am' LRU
+ *		queue; all other chunks go to the end of the 'A1in' FIFO.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_2q_insert(H5D_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    hsize_t     hash;           /* Hash of the chunk's coordinates */
+    size_t      b;              /* Bucket of chunk */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(ent);
+    HDassert(!ent->hnext);
+
+    /* Add to the hash bucket */
+    hash = H5D__chunk_cache_2q_hash(shared->ndims, ent->scaled);
+    b = (size_t)hash & (rdcc->q2.nbuckets - 1);
+    ent->hnext = rdcc->q2.bucket[b];
+    rdcc->q2.bucket[b] = ent;
+
+    /* Chunks referenced again after leaving 'A1in' are promoted to 'Am' */
+    ent->in_am = rdcc->q2.promote;
+    rdcc->q2.promote = FALSE;
+
+    if(ent->in_am || NULL == rdcc->q2.am_head) {
+        /* Append to the end of the list */
+        if(rdcc->tail) {
+            rdcc->tail->next = ent;
+            ent->prev = rdcc->tail;
+            rdcc->tail = ent;
+        } /* end if */
+        else
+            rdcc->head = rdcc->tail = ent;
+        if(ent->in_am && NULL == rdcc->q2.am_head)
+            rdcc->q2.am_head = ent;
+    } /* end if */
+    else {
+        /* Insert just before the first 'Am' entry */
+        ent->next = rdcc->q2.am_head;
+        ent->prev = rdcc->q2.am_head->prev;
+        if(ent->prev)
+            ent->prev->next = ent;
+        else
+            rdcc->head = ent;
+        rdcc->q2.am_head->prev = ent;
+    } /* end else */
+
+    if(!ent->in_am)
+        rdcc->q2.a1in_nbytes += shared->layout.u.chunk.size;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_2q_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_hit
+ *
+ * Purpose:	Move a chunk in the 'Am' queue of the 2Q chunk cache to the
+ *		end of the list.  Hits on chunks in the 'A1in' FIFO are
+ *		correlated references and don't change their position.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_2q_hit(H5D_rdcc_t *rdcc, H5D_rdcc_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(rdcc);
+    HDassert(ent);
+
+    if(ent->in_am && ent->next) {
+        if(rdcc->q2.am_head == ent)
+            rdcc->q2.am_head = ent->next;
+
+        /* Unlink */
+        ent->next->prev = ent->prev;
+        if(ent->prev)
+            ent->prev->next = ent->next;
+        else
+            rdcc->head = ent->next;
+
+        /* Append */
+        rdcc->tail->next = ent;
+        ent->prev = rdcc->tail;
+        ent->next = NULL;
+        rdcc->tail = ent;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_2q_hit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_remove
+ *
+ * Purpose:	Remove an entry which is about to be evicted from the 2Q
+ *		chunk cache's hash bucket & queue accounting and return its
+ *		slot to the free stack.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_2q_remove(H5D_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    H5D_rdcc_ent_t **pent;      /* Pointer to entry in bucket chain */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(ent);
+    HDassert(ent->idx < rdcc->nslots);
+    HDassert(rdcc->q2.nfree < rdcc->nslots);
+
+    if(rdcc->q2.am_head == ent)
+        rdcc->q2.am_head = ent->next;
+    if(!ent->in_am) {
+        HDassert(rdcc->q2.a1in_nbytes >= shared->layout.u.chunk.size);
+        rdcc->q2.a1in_nbytes -= shared->layout.u.chunk.size;
+    } /* end if */
+
+    /* Unlink from the hash bucket */
+    pent = &rdcc->q2.bucket[(size_t)H5D__chunk_cache_2q_hash(shared->ndims, ent->scaled) & (rdcc->q2.nbuckets - 1)];
+    while(*pent != ent) {
+        HDassert(*pent);
+        pent = &(*pent)->hnext;
+    } /* end while */
+    *pent = ent->hnext;
+    ent->hnext = NULL;
+
+    /* Release the slot */
+    rdcc->q2.free_idx[rdcc->q2.nfree++] = ent->idx;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_2q_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_ghost
+ *
+ * Purpose:	Remember the hash of a chunk preempted from the 'A1in' FIFO
+ *		of the 2Q chunk cache.  The ring holds the hashes of as
+ *		many chunks as would fit in half the cache; the oldest one
+ *		is forgotten when it's full.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_2q_ghost(H5D_shared_t *shared, const H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    hsize_t     hash;           /* Hash of the chunk's coordinates */
+    hsize_t     *pos;           /* Position in ring */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(ent);
+
+    /* Set up the ring on first use */
+    if(NULL == rdcc->q2.ghost) {
+        rdcc->q2.nghost_max = MAX(1, (rdcc->nbytes_max / shared->layout.u.chunk.size) / 2);
+        if(NULL == (rdcc->q2.ghost = (hsize_t *)H5MM_calloc(rdcc->q2.nghost_max * sizeof(hsize_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk cache ghost list")
+        if(NULL == (rdcc->q2.ghost_set = H5SL_create(H5SL_TYPE_HSIZE, NULL)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create skip list for chunk cache ghost list")
+        rdcc->q2.ghost_next = 0;
+    } /* end if */
+
+    /* Nothing to do if the hash is already known */
+    hash = H5D__chunk_cache_2q_hash(shared->ndims, ent->scaled);
+    if(NULL != H5SL_search(rdcc->q2.ghost_set, &hash))
+        HGOTO_DONE(SUCCEED)
+
+    /* Forget the hash currently at this position of the ring, unless it was
+     * already removed (promoted) or re-added elsewhere in the ring
+     */
+    pos = &rdcc->q2.ghost[rdcc->q2.ghost_next];
+    if(H5SL_search(rdcc->q2.ghost_set, pos) == pos)
+        H5SL_remove(rdcc->q2.ghost_set, pos);
+
+    *pos = hash;
+    if(H5SL_insert(rdcc->q2.ghost_set, pos, pos) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't insert chunk into cache ghost list")
+    rdcc->q2.ghost_next = (rdcc->q2.ghost_next + 1) % rdcc->q2.nghost_max;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_2q_ghost() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_prune
+ *
+ * Purpose:	Prune the 2Q chunk cache by preempting unlocked entries
+ *		until the cache has room for something which is SIZE bytes.
+ *		Entries are taken from the front of the 'A1in' FIFO while
+ *		it holds more than its share of the cache, otherwise from
+ *		the front of the 'Am' LRU queue.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_2q_prune(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, size_t size)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    H5D_chunk_victims_t victims;        /* Dirty chunks written back together */
+    int		nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDmemset(&victims, 0, sizeof(victims));
+
+    while((rdcc->nbytes_used - victims.nbytes + size) > rdcc->nbytes_max) {
+        H5D_rdcc_ent_t *cur = NULL;     /* Entry to preempt */
+        H5D_rdcc_ent_t *ent;            /* Cache entry */
+
+        /* Oldest unlocked chunk in 'A1in', if it's over its share */
+        if(rdcc->q2.a1in_nbytes > (rdcc->nbytes_max / H5D_RDCC_2Q_A1IN_DIVISOR)
+                || NULL == rdcc->q2.am_head)
+            for(ent = rdcc->head; ent && ent != rdcc->q2.am_head && !cur; ent = ent->next)
+                if(!ent->locked)
+                    cur = ent;
+
+        /* Least recently used unlocked chunk in 'Am' */
+        for(ent = rdcc->q2.am_head; ent && !cur; ent = ent->next)
+            if(!ent->locked)
+                cur = ent;
+
+        /* Last resort: any unlocked chunk in 'A1in' */
+        for(ent = rdcc->head; ent && ent != rdcc->q2.am_head && !cur; ent = ent->next)
+            if(!ent->locked)
+                cur = ent;
+
+        /* Nothing to preempt at this point */
+        if(!cur)
+            break;
+
+        /* Remember chunks leaving 'A1in' */
+        if(!cur->in_am)
+            if(H5D__chunk_cache_2q_ghost(dset->shared, cur) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't remember preempted chunk")
+
+        if(H5D__chunk_cache_preempt(dset, dxpl_id, dxpl_cache, cur, &victims) < 0)
+            nerrors++;
+    } /* end while */
+
+    if(nerrors)
+	HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+done:
+    /* Write back and evict the dirty chunks chosen */
+    if(H5D__chunk_cache_preempt_flush(dset, dxpl_id, dxpl_cache, &victims) < 0)
+        HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_2q_prune() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_2q_dest
+ *
+ * Purpose:	Release the slots, hash buckets and ghost ring of the 2Q
+ *		chunk cache policy.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_2q_dest(H5D_rdcc_t *rdcc)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(rdcc);
+    HDassert(NULL == rdcc->head);
+
+    if(rdcc->slot)
+        rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+    if(rdcc->q2.bucket)
+        rdcc->q2.bucket = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->q2.bucket);
+    rdcc->q2.free_idx = (unsigned *)H5MM_xfree(rdcc->q2.free_idx);
+    if(rdcc->q2.ghost_set) {
+        H5SL_close(rdcc->q2.ghost_set);
+        rdcc->q2.ghost_set = NULL;
+    } /* end if */
+    rdcc->q2.ghost = (hsize_t *)H5MM_xfree(rdcc->q2.ghost);
+    HDmemset(&rdcc->q2, 0, sizeof(rdcc->q2));
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_2q_dest() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_file_attach
+ *
+ * Purpose:	Attach a dataset's chunk cache to the file-wide chunk cache,
+ *		creating the latter for the first dataset that uses it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_file_attach(H5F_t *f, H5D_rdcc_t *rdcc)
+{
+    H5D_rdcc_file_t *rdcc_file;         /* File-wide chunk cache */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(f);
+    HDassert(rdcc);
+    HDassert(NULL == rdcc->file);
+
+    if(NULL == (rdcc_file = H5F_RDCC_FILE(f))) {
+        if(NULL == (rdcc_file = H5FL_CALLOC(H5D_rdcc_file_t)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for file-wide chunk cache")
+        rdcc_file->nbytes_max = H5F_RDCC_SHARED_NBYTES(f);
+
+        if(H5F_SET_RDCC_FILE(f, rdcc_file) < 0) {
+            rdcc_file = H5FL_FREE(H5D_rdcc_file_t, rdcc_file);
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't set file-wide chunk cache")
+        } /* end if */
+    } /* end if */
+
+    rdcc_file->nusers++;
+    rdcc->file = rdcc_file;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_file_attach() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_file_detach
+ *
+ * Purpose:	Detach a dataset's (empty) chunk cache from the file-wide
+ *		chunk cache, releasing the latter after the last dataset.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_file_detach(H5F_t *f, H5D_rdcc_t *rdcc)
+{
+    H5D_rdcc_file_t *rdcc_file = rdcc->file;   /* File-wide chunk cache */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(f);
+    HDassert(rdcc_file);
+    HDassert(rdcc_file == H5F_RDCC_FILE(f));
+    HDassert(NULL == rdcc->head);
+    HDassert(rdcc_file->nusers > 0);
+
+    if(0 == --rdcc_file->nusers) {
+        HDassert(NULL == rdcc_file->head);
+        HDassert(0 == rdcc_file->nbytes_used);
+
+        (void)H5F_SET_RDCC_FILE(f, NULL);
+        rdcc_file = H5FL_FREE(H5D_rdcc_file_t, rdcc_file);
+    } /* end if */
+
+    rdcc->file = NULL;
+    rdcc->owner = NULL;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_file_detach() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_file_insert
+ *
+ * Purpose:	Add a new entry to the end of the file-wide chunk cache's
+ *		list.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_file_insert(H5D_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_file_t *rdcc_file = shared->cache.chunk.file;     /* File-wide chunk cache */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(rdcc_file);
+    HDassert(ent);
+    HDassert(NULL == ent->shared);
+
+    ent->shared = shared;
+    if(rdcc_file->tail) {
+        rdcc_file->tail->fnext = ent;
+        ent->fprev = rdcc_file->tail;
+        rdcc_file->tail = ent;
+    } /* end if */
+    else
+        rdcc_file->head = rdcc_file->tail = ent;
+    rdcc_file->nbytes_used += shared->layout.u.chunk.size;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_file_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_file_hit
+ *
+ * Purpose:	Move an entry to the end of the file-wide chunk cache's
+ *		list.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_file_hit(H5D_rdcc_file_t *rdcc_file, H5D_rdcc_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(rdcc_file);
+    HDassert(ent);
+
+    if(ent->fnext) {
+        /* Unlink */
+        ent->fnext->fprev = ent->fprev;
+        if(ent->fprev)
+            ent->fprev->fnext = ent->fnext;
+        else
+            rdcc_file->head = ent->fnext;
+
+        /* Append */
+        ent->fprev = rdcc_file->tail;
+        ent->fnext = NULL;
+        rdcc_file->tail->fnext = ent;
+        rdcc_file->tail = ent;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_file_hit() */
 
-    /* Free */
-    ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_file_remove
+ *
+ * Purpose:	Unlink an entry about to be evicted from the file-wide
+ *		chunk cache's list.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_file_remove(H5D_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_file_t *rdcc_file = shared->cache.chunk.file;     /* File-wide chunk cache */
 
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_cache_evict() */
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(rdcc_file);
+    HDassert(ent);
+    HDassert(ent->shared == shared);
+    HDassert(rdcc_file->nbytes_used >= shared->layout.u.chunk.size);
+
+    if(ent->fprev)
+        ent->fprev->fnext = ent->fnext;
+    else
+        rdcc_file->head = ent->fnext;
+    if(ent->fnext)
+        ent->fnext->fprev = ent->fprev;
+    else
+        rdcc_file->tail = ent->fprev;
+    ent->fprev = ent->fnext = NULL;
+    ent->shared = NULL;
+    rdcc_file->nbytes_used -= shared->layout.u.chunk.size;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_file_remove() */
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_cache_prune
+ * Function:	H5D__chunk_cache_file_prune
  *
- * Purpose:	Prune the cache by preempting some things until the cache has
- *		room for something which is SIZE bytes.  Only unlocked
- *		entries are considered for preemption.
+ * Purpose:	Preempt the least recently used chunks of the file's
+ *		datasets until the file-wide chunk cache has room for
+ *		something which is SIZE bytes.  Only unlocked entries are
+ *		considered, and entries of other datasets only when one of
+ *		their dataset's open handles can be used to flush them.
+ *		Those are flushed with the filter callback and error
+ *		detection setting of their own dataset's last access.
+ *		There may still not be room when this returns.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Robb Matzke
- *              Thursday, May 21, 1998
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
+H5D__chunk_cache_file_prune(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, size_t size)
 {
-    const H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);
-    size_t		total = rdcc->nbytes_max;
-    const int		nmeth = 2;	/*number of methods		*/
-    int		        w[1];		/*weighting as an interval	*/
-    H5D_rdcc_ent_t	*p[2], *cur;	/*list pointers			*/
-    H5D_rdcc_ent_t	*n[2];		/*list next pointers		*/
-    int		nerrors = 0;            /* Accumulated error count during preemptions */
-    herr_t      ret_value = SUCCEED;       /* Return value */
+    H5D_rdcc_file_t *rdcc_file = dset->shared->cache.chunk.file;   /* File-wide chunk cache */
+    H5D_rdcc_ent_t *ent, *next;         /* Pointers to current & next entries */
+    H5D_chunk_victims_t victims;        /* Dirty chunks of DSET written back together */
+    int         nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t      ret_value = SUCCEED;    /* Return value */
 
     FUNC_ENTER_STATIC
 
-    /*
-     * Preemption is accomplished by having multiple pointers (currently two)
-     * slide down the list beginning at the head. Pointer p(N+1) will start
-     * traversing the list when pointer pN reaches wN percent of the original
-     * list.  In other words, preemption method N gets to consider entries in
-     * approximate least recently used order w0 percent before method N+1
-     * where 100% means tha method N will run to completion before method N+1
-     * begins.  The pointers participating in the list traversal are each
-     * given a chance at preemption before any of the pointers are advanced.
-     */
-    w[0] = (int)(rdcc->nused * rdcc->w0);
-    p[0] = rdcc->head;
-    p[1] = NULL;
-
-    while((p[0] || p[1]) && (rdcc->nbytes_used + size) > total) {
-        int i;          /* Local index variable */
-
-	/* Introduce new pointers */
-	for(i = 0; i < nmeth - 1; i++)
-            if(0 == w[i])
-                p[i + 1] = rdcc->head;
-
-	/* Compute next value for each pointer */
-	for(i = 0; i < nmeth; i++)
-            n[i] = p[i] ? p[i]->next : NULL;
-
-	/* Give each method a chance */
-	for(i = 0; i < nmeth && (rdcc->nbytes_used + size) > total; i++) {
-	    if(0 == i && p[0] && !p[0]->locked &&
-                    ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
-                     (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
-                     (dset->shared->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
-		/*
-		 * Method 0: Preempt entries that have been completely written
-		 * and/or completely read but not entries that are partially
-		 * written or partially read.
-		 */
-		cur = p[0];
-	    } else if(1 == i && p[1] && !p[1]->locked) {
-		/*
-		 * Method 1: Preempt the entry without regard to
-		 * considerations other than being locked.  This is the last
-		 * resort preemption.
-		 */
-		cur = p[1];
-	    } else {
-		/* Nothing to preempt at this point */
-		cur = NULL;
-	    }
+    HDassert(rdcc_file);
+    HDmemset(&victims, 0, sizeof(victims));
 
-	    if(cur) {
-                int j;          /* Local index variable */
+    for(ent = rdcc_file->head; ent && (rdcc_file->nbytes_used - victims.nbytes + size) > rdcc_file->nbytes_max; ent = next) {
+        const H5D_t *owner;     /* Dataset to preempt the entry through */
 
-		for(j = 0; j < nmeth; j++) {
-		    if(p[j] == cur)
-                        p[j] = NULL;
-		    if(n[j] == cur)
-                        n[j] = cur->next;
-		} /* end for */
-		if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, cur, TRUE) < 0)
-                    nerrors++;
-	    } /* end if */
-	} /* end for */
+        next = ent->fnext;
+        if(ent->locked)
+            continue;
+        if(ent->shared == dset->shared) {
+            owner = dset;
+            if(H5D__chunk_cache_preempt(owner, dxpl_id, dxpl_cache, ent, &victims) < 0)
+                nerrors++;
+        } /* end if */
+        else {
+            H5D_dxpl_cache_t owner_dxpl_cache = *dxpl_cache;   /* Transfer settings of the entry's dataset */
+
+            if(NULL == (owner = ent->shared->cache.chunk.owner))
+                continue;
+            owner_dxpl_cache.err_detect = owner->shared->cache.chunk.owner_err_detect;
+            owner_dxpl_cache.filter_cb = owner->shared->cache.chunk.owner_filter_cb;
+            if(H5D__chunk_cache_evict(owner, dxpl_id, &owner_dxpl_cache, ent, TRUE) < 0)
+                nerrors++;
+            else
+                owner->shared->cache.chunk.stats.nevictions++;
+        } /* end else */
+    } /* end for */
 
-	/* Advance pointers */
-	for(i = 0; i < nmeth; i++)
-            p[i] = n[i];
-	for(i = 0; i < nmeth - 1; i++)
-            w[i] -= 1;
-    } /* end while */
+    /* Write back and evict the dirty chunks of this dataset chosen */
+    if(H5D__chunk_cache_preempt_flush(dset, dxpl_id, dxpl_cache, &victims) < 0)
+        nerrors++;
 
     if(nerrors)
 	HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_cache_prune() */
+} /* end H5D__chunk_cache_file_prune() */
 
 
 /*-------------------------------------------------------------------------
@@ -3176,6 +5872,12 @@ done:
  *		for output functions that are about to overwrite the entire
  *		chunk.
  *
+ *		If DECODED_CHUNK is non-NULL it is a buffer holding the
+ *		chunk's data, already read from the file and run through
+ *		the filter pipeline, which is used instead of reading the
+ *		chunk again.  The buffer is owned by this routine from then
+ *		on and is either placed in the cache or released.
+ *
  * Return:	Success:	Ptr to a file chunk.
  *
  *		Failure:	NULL
@@ -3187,7 +5889,7 @@ done:
  */
 static void *
 H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
-    hbool_t relax, hbool_t prev_unfilt_chunk)
+    hbool_t relax, hbool_t prev_unfilt_chunk, void *decoded_chunk)
 {
     const H5D_t         *dset = io_info->dset;  /* Local pointer to the dataset info */
     const H5O_pline_t   *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info - always equal to the pline passed to H5D__chunk_mem_alloc */
@@ -3214,6 +5916,15 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
     HDassert(TRUE == H5P_isa_class(io_info->raw_dxpl_id, H5P_DATASET_XFER));
     HDassert(!(udata->new_unfilt_chunk && prev_unfilt_chunk));
     HDassert(!rdcc->tmp_head);
+    HDassert(!decoded_chunk || (!relax && !prev_unfilt_chunk && !udata->new_unfilt_chunk));
+    HDassert(!decoded_chunk || UINT_MAX == udata->idx_hint);
+
+    /* Other datasets in the file may flush this dataset's chunks through it */
+    if(rdcc->file) {
+        rdcc->owner = dset;
+        rdcc->owner_err_detect = io_info->dxpl_cache->err_detect;
+        rdcc->owner_filter_cb = io_info->dxpl_cache->filter_cb;
+    } /* end if */
 
     /* Get the chunk's size */
     HDassert(layout->u.chunk.size > 0);
@@ -3303,25 +6014,10 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
             } /* end else */
         } /* end if */
 
-        /*
-         * If the chunk is not at the beginning of the cache; move it backward
-         * by one slot.  This is how we implement the LRU preemption
-         * algorithm.
-         */
-        if(ent->next) {
-            if(ent->next->next)
-                ent->next->next->prev = ent;
-            else
-                rdcc->tail = ent;
-            ent->next->prev = ent->prev;
-            if(ent->prev)
-                ent->prev->next = ent->next;
-            else
-                rdcc->head = ent->next;
-            ent->prev = ent->next;
-            ent->next = ent->next->next;
-            ent->prev->next = ent;
-        } /* end if */
+        /* Let the replacement policy know the chunk was used */
+        (rdcc->cls->hit)(rdcc, ent);
+        if(rdcc->file)
+            H5D__chunk_cache_file_hit(rdcc->file, ent);
     } /* end if */
     else {
         haddr_t             chunk_addr;         /* Address of chunk on disk */
@@ -3386,17 +6082,35 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
              *      or an init if it isn't.
              */
 
+            /* Check if the chunk was already read & decoded */
+            if(decoded_chunk) {
+                HDassert(H5F_addr_defined(chunk_addr));
+                HDassert(old_pline == pline);
+
+                chunk = decoded_chunk;
+                decoded_chunk = NULL;
+
+                /* Increment # of cache misses */
+                rdcc->stats.nmisses++;
+                rdcc->stats.nbytes_read += udata->chunk_block.length;
+                rdcc->stats.nbytes_decoded += chunk_size;
+            } /* end if */
             /* Check if the chunk exists on disk */
-            if(H5F_addr_defined(chunk_addr)) {
+            else if(H5F_addr_defined(chunk_addr)) {
                 size_t my_chunk_alloc = chunk_alloc;	/* Allocated buffer size */
                 size_t buf_alloc = chunk_alloc;	        /* [Re-]allocated buffer size */
 
                 /* Chunk size on disk isn't [likely] the same size as the final chunk
                  * size in memory, so allocate memory big enough. */
-                if(NULL == (chunk = H5D__chunk_mem_alloc(my_chunk_alloc, (udata->new_unfilt_chunk ? old_pline : pline))))
+                if(old_pline && old_pline->nused)
+                    chunk = H5D__chunk_mem_alloc_read(dset, my_chunk_alloc, &buf_alloc);
+                else
+                    chunk = H5D__chunk_mem_alloc(my_chunk_alloc, (udata->new_unfilt_chunk ? old_pline : pline));
+                if(NULL == chunk)
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
                 if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, chunk_addr, my_chunk_alloc, io_info->raw_dxpl_id, chunk) < 0)
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "unable to read raw data chunk")
+                rdcc->stats.nbytes_read += my_chunk_alloc;
 
 		if(old_pline && old_pline->nused) {
                     if(H5Z_pipeline(old_pline, H5Z_FLAG_REVERSE,
@@ -3405,6 +6119,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                             io_info->dxpl_cache->filter_cb,
                             &my_chunk_alloc, &buf_alloc, &chunk) < 0)
                         HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, NULL, "data pipeline read failed")
+                    rdcc->stats.nbytes_decoded += my_chunk_alloc;
 
                     /* Reallocate chunk if necessary */
                     if(udata->new_unfilt_chunk) {
@@ -3415,7 +6130,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
                         } /* end if */
                         HDmemcpy(chunk, tmp_chunk, chunk_size);
-                        (void)H5D__chunk_mem_xfree(tmp_chunk, old_pline);
+                        (void)H5D__chunk_mem_release(tmp_chunk, buf_alloc, old_pline);
                     } /* end if */
                 } /* end if */
 
@@ -3468,21 +6183,28 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         } /* end else */
 
         /* See if the chunk can be cached */
-        if(rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max) {
-            /* Calculate the index */
-            udata->idx_hint = H5D__chunk_hash_val(io_info->dset->shared, udata->common.scaled);
-
-            /* Add the chunk to the cache only if the slot is not already locked */
-            ent = rdcc->slot[udata->idx_hint];
-            if(!ent || !ent->locked) {
-                /* Preempt enough things from the cache to make room */
-                if(ent) {
-                    if(H5D__chunk_cache_evict(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, ent, TRUE) < 0)
-                        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
-                } /* end if */
-                if(H5D__chunk_cache_prune(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, chunk_size) < 0)
+        if(rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max
+                && (NULL == rdcc->file || chunk_size <= rdcc->file->nbytes_max)) {
+            hbool_t file_room = TRUE;   /* Whether the file-wide cache has room */
+
+            /* Make room in the file-wide cache first.  If the chunks left
+             * in it are locked or can't be flushed, don't cache this one.
+             */
+            if(rdcc->file) {
+                if(H5D__chunk_cache_file_prune(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, chunk_size) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from file-wide cache")
+                file_room = (hbool_t)((rdcc->file->nbytes_used + chunk_size) <= rdcc->file->nbytes_max);
+            } /* end if */
+
+            /* Preempt enough things from the cache to make room and
+             * choose the slot for the chunk (if it can be cached now)
+             */
+            if(file_room)
+                if((rdcc->cls->admit)(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, udata->common.scaled, &udata->idx_hint) < 0)
                     HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
 
+            /* Add the chunk to the cache only if a slot is available */
+            if(UINT_MAX != udata->idx_hint) {
                 /* Create a new entry */
                 if(NULL == (ent = H5FL_CALLOC(H5D_rdcc_ent_t)))
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate raw data chunk entry")
@@ -3501,6 +6223,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                 ent->chunk = (uint8_t *)chunk;
 
                 /* Add it to the cache */
+                HDassert(udata->idx_hint < rdcc->nslots);
                 HDassert(NULL == rdcc->slot[udata->idx_hint]);
                 rdcc->slot[udata->idx_hint] = ent;
                 ent->idx = udata->idx_hint;
@@ -3508,13 +6231,9 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                 rdcc->nused++;
 
                 /* Add it to the linked list */
-                if(rdcc->tail) {
-                    rdcc->tail->next = ent;
-                    ent->prev = rdcc->tail;
-                    rdcc->tail = ent;
-                } /* end if */
-                else
-                    rdcc->head = rdcc->tail = ent;
+                (rdcc->cls->insert)(io_info->dset->shared, ent);
+                if(rdcc->file)
+                    H5D__chunk_cache_file_insert(io_info->dset->shared, ent);
 		ent->tmp_next = NULL;
 		ent->tmp_prev = NULL;
 
@@ -3554,6 +6273,10 @@ done:
         if(chunk)
             chunk = H5D__chunk_mem_xfree(chunk, pline);
 
+    /* Release the decoded chunk, if it wasn't used */
+    if(decoded_chunk)
+        decoded_chunk = H5D__chunk_mem_xfree(decoded_chunk, &(dset->shared->dcpl_cache.pline));
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_lock() */
 
@@ -3635,7 +6358,9 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
         } /* end if */
         else {
             if(chunk)
-                chunk = H5D__chunk_mem_xfree(chunk, (is_unfiltered_edge_chunk ? NULL
+                chunk = H5D__chunk_mem_release(chunk,
+                        (size_t)io_info->dset->shared->layout.u.chunk.size,
+                        (is_unfiltered_edge_chunk ? NULL
 			: &(io_info->dset->shared->dcpl_cache.pline)));
         } /* end else */
     } /* end if */
@@ -3753,6 +6478,113 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_allocated() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_iter_cb
+ *
+ * Purpose:	Convert a chunk record from the index into the chunk's
+ *		logical offset, address, stored size and filter mask and
+ *		pass them to the application's callback.
+ *
+ * Return:	Value returned by the application's callback
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_iter_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
+{
+    const H5D_chunk_it_ud6_t *udata = (const H5D_chunk_it_ud6_t *)_udata; /* User data for callback */
+    hsize_t offset[H5O_LAYOUT_NDIMS];   /* Logical offset of chunk */
+    unsigned u;                         /* Local index variable */
+    int ret_value;                      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Convert the scaled coordinates of the chunk into its logical offset */
+    for(u = 0; u < udata->layout->ndims - 1; u++)
+        offset[u] = chunk_rec->scaled[u] * udata->layout->dim[u];
+
+    /* Make the application's callback */
+    ret_value = (udata->op)(offset, (unsigned)chunk_rec->filter_mask,
+            chunk_rec->chunk_addr, (hsize_t)chunk_rec->nbytes, udata->op_data);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_iter_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_iter
+ *
+ * Purpose:	Iterate over all the chunks of a dataset which are allocated
+ *		in the file, in the order of the dataset's chunk index,
+ *		calling OP with each chunk's logical offset, filter mask,
+ *		address and stored size.  Chunks that are dirty in the
+ *		chunk cache are written first, so that their records are
+ *		up to date.
+ *
+ *		Iteration stops early when OP returns non-zero.
+ *
+ * Return:	Success:	Last value returned by OP (zero if all the
+ *				chunks were visited)
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_iter(const H5D_t *dset, hid_t dxpl_id, H5D_chunk_iter_op_t op, void *op_data)
+{
+    const H5D_rdcc_t   *rdcc = &(dset->shared->cache.chunk);	/* Raw data chunk cache */
+    H5D_rdcc_ent_t     *ent;            /* Cache entry  */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Sanity check */
+    HDassert(dset);
+    HDassert(dset->shared);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+    HDassert(op);
+
+    /* Write out the chunks which haven't been written yet */
+    if(rdcc->nused > 0) {
+        H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+        H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+
+        /* Fill the DXPL cache values for later use */
+        if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+        for(ent = rdcc->head; ent; ent = ent->next)
+            if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+    } /* end if */
+
+    /* Iterate over the chunks, if the index exists */
+    if((*dset->shared->layout.ops->is_space_alloc)(&dset->shared->layout.storage)) {
+        H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+        H5D_chunk_it_ud6_t udata;       /* User data for callback */
+
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.dxpl_id = dxpl_id;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+        /* Set up user data for callback */
+        udata.layout = &dset->shared->layout.u.chunk;
+        udata.op = op;
+        udata.op_data = op_data;
+
+        if((ret_value = (dset->shared->layout.storage.u.chunk.ops->iterate)(&idx_info, H5D__chunk_iter_cb, &udata)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to iterate over chunk index")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_iter() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_allocate
@@ -4344,7 +7176,7 @@ H5D__chunk_update_old_edge_chunks(H5D_t *dset, hid_t dxpl_id, hsize_t old_dim[])
                     || (UINT_MAX != chk_udata.idx_hint)) {
                 /* Lock the chunk into cache.  H5D__chunk_lock will take care of
                 * updating the chunk to no longer be an edge chunk. */
-                if(NULL == (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_udata, FALSE, TRUE)))
+                if(NULL == (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_udata, FALSE, TRUE, NULL)))
                     HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
                 /* Unlock the chunk */
@@ -4612,7 +7444,7 @@ H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "unable to select hyperslab")
 
     /* Lock the chunk into the cache, to get a pointer to the chunk buffer */
-    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE, FALSE)))
+    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE, FALSE, NULL)))
         HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
 
@@ -5294,6 +8126,10 @@ H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id)
     /* Check the rank */
     HDassert((dset->shared->layout.u.chunk.ndims - 1) > 1);
 
+    /* Nothing to do if the cache's slots don't depend on the extent */
+    if(NULL == rdcc->cls || !rdcc->cls->extent_hash)
+        HGOTO_DONE(SUCCEED)
+
     /* Fill the DXPL cache values for later use */
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
@@ -5378,6 +8214,44 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_update_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_copy_resize
+ *
+ * Purpose:     Record that the chunk buffer of a chunk copy is now
+ *              BUF_SIZE bytes, growing the background buffer to match.
+ *              The filter pipeline may hand back a chunk buffer of a
+ *              different size than it was given, and the datatype
+ *              conversions need a background buffer at least as large.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_copy_resize(H5D_chunk_it_ud3_t *udata, size_t buf_size)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(buf_size > udata->buf_size) {
+        if(udata->bkg) {
+            void *new_bkg;      /* New background buffer */
+
+            if(NULL == (new_bkg = H5MM_realloc(udata->bkg, buf_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+            udata->bkg = new_bkg;
+            if(!udata->cpy_info->expand_ref)
+                HDmemset((uint8_t *)udata->bkg + udata->buf_size, 0, (size_t)(buf_size - udata->buf_size));
+        } /* end if */
+    } /* end if */
+    udata->buf_size = buf_size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_copy_resize() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_copy_cb
@@ -5449,18 +8323,12 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
         if(NULL == (new_buf = H5MM_realloc(udata->buf, nbytes)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, H5_ITER_ERROR, "memory allocation failed for raw data chunk")
         udata->buf = new_buf;
-        if(udata->bkg) {
-            if(NULL == (new_buf = H5MM_realloc(udata->bkg, nbytes)))
-                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, H5_ITER_ERROR, "memory allocation failed for raw data chunk")
-            udata->bkg = new_buf;
-            if(!udata->cpy_info->expand_ref)
-                HDmemset((uint8_t *)udata->bkg + buf_size, 0, (size_t)(nbytes - buf_size));
-
-            bkg = udata->bkg;
-        } /* end if */
+        if(H5D__chunk_copy_resize(udata, nbytes) < 0)
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, H5_ITER_ERROR, "memory allocation failed for raw data chunk")
 
+        bkg = udata->bkg;
         buf = udata->buf;
-        udata->buf_size = buf_size = nbytes;
+        buf_size = nbytes;
     } /* end if */
 
     /* read chunk data from the source file */
@@ -5474,6 +8342,11 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
         cb_struct.func = NULL; /* no callback function when failed */
         if(H5Z_pipeline(pline, H5Z_FLAG_REVERSE, &filter_mask, H5Z_NO_EDC, cb_struct, &nbytes, &buf_size, &buf) < 0)
             HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, H5_ITER_ERROR, "data pipeline read failed")
+        udata->buf = buf;
+        if(H5D__chunk_copy_resize(udata, buf_size) < 0)
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, H5_ITER_ERROR, "memory allocation failed for raw data chunk")
+        bkg = udata->bkg;
+        buf_size = udata->buf_size;
     } /* end if */
 
     /* Perform datatype conversion, if necessary */
@@ -5543,7 +8416,8 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
 #endif /* H5_SIZEOF_SIZE_T > 4 */
         H5_CHECKED_ASSIGN(udata_dst.chunk_block.length, uint32_t, nbytes, size_t);
 	udata->buf = buf;
-	udata->buf_size = buf_size;
+        if(H5D__chunk_copy_resize(udata, buf_size) < 0)
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, H5_ITER_ERROR, "memory allocation failed for raw data chunk")
     } /* end if */
 
     udata_dst.chunk_idx = H5VM_array_offset_pre(udata_dst.common.layout->ndims - 1, 
@@ -6019,6 +8893,64 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_dump_index() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_advice
+ *
+ * Purpose:	Recommend raw data chunk cache parameters for a dataset,
+ *		based on the access pattern observed since the dataset was
+ *		opened (or its cache statistics were last reset).
+ *
+ *		The cache should hold every chunk touched by a single I/O
+ *		operation, plus the chunks which are read ahead, so the
+ *		recommended number of bytes is that many (uncompressed)
+ *		chunks.  The recommended number of slots is the first prime
+ *		number at or above H5D_CHUNK_ADVICE_SLOTS_PER_CHUNK times
+ *		that number of chunks, which keeps hash collisions rare.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_cache_advice(const H5D_t *dset, size_t *nslots, size_t *nbytes)
+{
+    const H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);  /* Raw data chunk cache */
+    size_t      chunk_size;             /* Size of an uncompressed chunk */
+    hsize_t     nchunks;                /* # of chunks the cache should hold */
+    size_t      n;                      /* Candidate # of slots */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(dset);
+    HDassert(H5D_CHUNKED == dset->shared->layout.type);
+    HDassert(nslots);
+    HDassert(nbytes);
+
+    /* Chunks the cache should hold at once */
+    nchunks = MAX(rdcc->stats.max_sel_chunks, 1) + rdcc->ra.nchunks;
+    chunk_size = (size_t)dset->shared->layout.u.chunk.size;
+    if(nchunks > ((size_t)-1 / H5D_CHUNK_ADVICE_SLOTS_PER_CHUNK) / MAX(chunk_size, 1))
+        HGOTO_ERROR(H5E_DATASET, H5E_OVERFLOW, FAIL, "recommended chunk cache size is too large")
+    *nbytes = (size_t)nchunks * chunk_size;
+
+    /* Find the first prime at or above the target number of slots */
+    for(n = (size_t)nchunks * H5D_CHUNK_ADVICE_SLOTS_PER_CHUNK; ; n++) {
+        size_t d;               /* Trial divisor */
+
+        for(d = 2; d * d <= n; d++)
+            if(0 == n % d)
+                break;
+        if(d * d > n)
+            break;
+    } /* end for */
+    *nslots = n;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_advice() */
+
 #ifdef H5D_CHUNK_DEBUG
 
 /*-------------------------------------------------------------------------
@@ -6061,9 +8993,9 @@ H5D__chunk_stats(const H5D_t *dset, hbool_t headers)
 #endif
 
     if (headers) {
-        if (rdcc->nhits>0 || rdcc->nmisses>0) {
-            miss_rate = 100.0 * rdcc->nmisses /
-                    (rdcc->nhits + rdcc->nmisses);
+        if (rdcc->stats.nhits>0 || rdcc->stats.nmisses>0) {
+            miss_rate = 100.0 * (double)rdcc->stats.nmisses /
+                    (double)(rdcc->stats.nhits + rdcc->stats.nmisses);
         } else {
             miss_rate = 0.0;
         }
@@ -6073,9 +9005,11 @@ H5D__chunk_stats(const H5D_t *dset, hbool_t headers)
             sprintf(ascii, "%7.2f%%", miss_rate);
         }
 
-        fprintf(H5DEBUG(AC), "   %-18s %8u %8u %7s %8d+%-9ld\n",
-            "raw data chunks", rdcc->nhits, rdcc->nmisses, ascii,
-            rdcc->ninits, (long)(rdcc->nflushes)-(long)(rdcc->ninits));
+        fprintf(H5DEBUG(AC), "   %-18s %8lu %8lu %7s %8lu+%-9ld\n",
+            "raw data chunks", (unsigned long)rdcc->stats.nhits,
+            (unsigned long)rdcc->stats.nmisses, ascii,
+            (unsigned long)rdcc->stats.ninits,
+            (long)(rdcc->stats.nflushes)-(long)(rdcc->stats.ninits));
     }
 
 done:
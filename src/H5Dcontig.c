@@ -50,6 +50,9 @@
 /* Local Macros */
 /****************/
 
+/* Number of pieces batched into one vector read or write */
+#define H5D_CONTIG_VEC_SIZE     256
+
 
 /******************/
 /* Local Typedefs */
@@ -70,6 +73,13 @@ typedef struct H5D_contig_readvv_ud_t {
     haddr_t dset_addr;          /* Address of dataset */
     unsigned char *rbuf;        /* Pointer to buffer to fill */
     hid_t dxpl_id;              /* DXPL for operation */
+
+    /* Pieces batched for the next vector read */
+    size_t nvec;                                /* Number of pieces batched */
+    H5FD_mem_t types[H5D_CONTIG_VEC_SIZE];      /* Memory type of each piece */
+    haddr_t addrs[H5D_CONTIG_VEC_SIZE];         /* File address of each piece */
+    size_t sizes[H5D_CONTIG_VEC_SIZE];          /* Size of each piece */
+    void *bufs[H5D_CONTIG_VEC_SIZE];            /* Buffer for each piece */
 } H5D_contig_readvv_ud_t;
 
 /* Callback info for sieve buffer writevv operation */
@@ -87,6 +97,13 @@ typedef struct H5D_contig_writevv_ud_t {
     haddr_t dset_addr;          /* Address of dataset */
     const unsigned char *wbuf;  /* Pointer to buffer to write */
     hid_t dxpl_id;              /* DXPL for operation */
+
+    /* Pieces batched for the next vector write */
+    size_t nvec;                                /* Number of pieces batched */
+    H5FD_mem_t types[H5D_CONTIG_VEC_SIZE];      /* Memory type of each piece */
+    haddr_t addrs[H5D_CONTIG_VEC_SIZE];         /* File address of each piece */
+    size_t sizes[H5D_CONTIG_VEC_SIZE];          /* Size of each piece */
+    const void *bufs[H5D_CONTIG_VEC_SIZE];      /* Buffer for each piece */
 } H5D_contig_writevv_ud_t;
 
 
@@ -112,6 +129,9 @@ static herr_t H5D__contig_flush(H5D_t *dset, hid_t dxpl_id);
 /* Helper routines */
 static herr_t H5D__contig_write_one(H5D_io_info_t *io_info, hsize_t offset,
     size_t size);
+static htri_t H5D__contig_use_vector(const H5D_io_info_t *io_info,
+    hbool_t writing, size_t dset_max_nseq, size_t dset_curr_seq,
+    const size_t dset_len_arr[], const hsize_t dset_off_arr[]);
 
 
 /*********************/
@@ -450,7 +470,9 @@ done:
  * Function:	H5D__contig_init
  *
  * Purpose:	Initialize the contiguous info for a dataset.  This is
- *		called when the dataset is initialized.
+ *		called when the dataset is initialized.  The expected
+ *		pattern of access to the storage, from the dataset access
+ *		property list, is passed on to the file driver here.
  *
  * Return:	Non-negative on success/Negative on failure
  *
@@ -460,9 +482,11 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__contig_init(H5F_t H5_ATTR_UNUSED *f, hid_t H5_ATTR_UNUSED dxpl_id,
-    const H5D_t *dset, hid_t H5_ATTR_UNUSED dapl_id)
+H5D__contig_init(H5F_t *f, hid_t H5_ATTR_UNUSED dxpl_id, const H5D_t *dset,
+    hid_t dapl_id)
 {
+    H5P_genplist_t *dapl;               /* Data access property list object pointer */
+    H5FD_advice_t advice;               /* Expected pattern of access to the raw data */
     hsize_t tmp_size;                   /* Temporary holder for raw data size */
     size_t tmp_sieve_buf_size;          /* Temporary holder for sieve buffer size */
     herr_t ret_value = SUCCEED;         /* Return value */
@@ -514,6 +538,17 @@ H5D__contig_init(H5F_t H5_ATTR_UNUSED *f, hid_t H5_ATTR_UNUSED dxpl_id,
     else
         dset->shared->cache.contig.sieve_buf_size = tmp_sieve_buf_size;
 
+    /* Pass the expected pattern of access to the storage on to the file driver */
+    if(H5F_addr_defined(dset->shared->layout.storage.u.contig.addr) && tmp_size > 0) {
+        if(NULL == (dapl = (H5P_genplist_t *)H5I_object(dapl_id)))
+            HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for dapl ID")
+        if(H5P_get(dapl, H5D_ACS_ACCESS_ADVICE_NAME, &advice) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get access advice")
+        if(H5FD_ADVICE_NORMAL != advice)
+            if(H5F_advise(f, dset->shared->layout.storage.u.contig.addr, tmp_size, advice) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to pass on access advice")
+    } /* end if */
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__contig_init() */
@@ -685,6 +720,86 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* end H5D__contig_write_one() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_use_vector
+ *
+ * Purpose:	Decides whether the sequences of a readvv/writevv operation
+ *		are read or written with vector I/O, rather than through
+ *		the dataset's sieve buffer.
+ *
+ *		Vector I/O is used when the file driver doesn't support
+ *		data sieving, or the sieve buffer has been disabled.  It is
+ *		also used when the driver carries out vector I/O itself
+ *		and the sequences are too sparse for sieving to pay: they
+ *		span more than the sieve buffer holds, and are on average
+ *		more than half a sieve buffer apart, so each sieve buffer
+ *		fill would be a large read for one or two sequences.
+ *
+ *		When data sieving is bypassed, a dirty sieve buffer that
+ *		overlaps the sequences is flushed first.  A write also
+ *		invalidates an overlapping sieve buffer.
+ *
+ * Return:	TRUE/FALSE/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__contig_use_vector(const H5D_io_info_t *io_info, hbool_t writing,
+    size_t dset_max_nseq, size_t dset_curr_seq, const size_t dset_len_arr[],
+    const hsize_t dset_off_arr[])
+{
+    H5F_t *file = io_info->dset->oloc.file;     /* File for dataset */
+    H5D_rdcdc_t *dset_contig = &(io_info->dset->shared->cache.contig); /* Cached information about contiguous data */
+    haddr_t start, end;         /* File addresses the sequences span */
+    size_t nseq;                /* Number of sequences */
+    htri_t ret_value = FALSE;   /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Without data sieving, always use vector I/O */
+    if(!H5F_HAS_FEATURE(file, H5FD_FEAT_DATA_SIEVE))
+        HGOTO_DONE(TRUE)
+
+    /* Nothing to do? */
+    if(dset_curr_seq >= dset_max_nseq)
+        HGOTO_DONE(FALSE)
+
+    /* Compute the span of the sequences (their offsets are increasing) */
+    nseq = dset_max_nseq - dset_curr_seq;
+    start = io_info->store->contig.dset_addr + dset_off_arr[dset_curr_seq];
+    end = io_info->store->contig.dset_addr + dset_off_arr[dset_max_nseq - 1] + dset_len_arr[dset_max_nseq - 1];
+
+    /* Check for the sieve buffer being disabled or not paying off */
+    if(0 == dset_contig->sieve_buf_size)
+        ret_value = TRUE;
+    else if(H5F_HAS_VECTOR_IO(file) && (end - start) > dset_contig->sieve_buf_size
+            && (end - start) / nseq > dset_contig->sieve_buf_size / 2)
+        ret_value = TRUE;
+
+    /* Keep the sieve buffer coherent with I/O that bypasses it */
+    if(ret_value && dset_contig->sieve_buf && H5F_addr_defined(dset_contig->sieve_loc)
+            && H5F_addr_overlap(start, end - start, dset_contig->sieve_loc, dset_contig->sieve_size)) {
+        /* Flush the sieve buffer, if it's dirty */
+        if(dset_contig->sieve_dirty) {
+            if(H5F_block_write(file, H5FD_MEM_DRAW, dset_contig->sieve_loc, dset_contig->sieve_size, io_info->raw_dxpl_id, dset_contig->sieve_buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+
+            /* Reset sieve buffer dirty flag */
+            dset_contig->sieve_dirty = FALSE;
+        } /* end if */
+
+        /* Force the sieve buffer to be re-read the next time */
+        if(writing) {
+            dset_contig->sieve_loc = HADDR_UNDEF;
+            dset_contig->sieve_size = 0;
+        } /* end if */
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5D__contig_use_vector() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__contig_readvv_sieve_cb
@@ -864,6 +979,10 @@ done:
  *
  * Purpose:	Callback operator for H5D__contig_readvv() without sieve buffer.
  *
+ *		The pieces are batched and read with one vector read for
+ *		each H5D_CONTIG_VEC_SIZE of them.  H5D__contig_readvv()
+ *		reads the last, partial, batch.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Quincey Koziol
@@ -879,10 +998,19 @@ H5D__contig_readvv_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata
 
     FUNC_ENTER_STATIC
 
-    /* Write data */
-    if(H5F_block_read(udata->file, H5FD_MEM_DRAW, (udata->dset_addr + dst_off),
-            len, udata->dxpl_id, (udata->rbuf + src_off)) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+    /* Add the piece to the batch */
+    udata->types[udata->nvec] = H5FD_MEM_DRAW;
+    udata->addrs[udata->nvec] = udata->dset_addr + dst_off;
+    udata->sizes[udata->nvec] = len;
+    udata->bufs[udata->nvec] = udata->rbuf + src_off;
+
+    /* Read the batch, once it is full */
+    if(++udata->nvec == H5D_CONTIG_VEC_SIZE) {
+        if(H5F_block_read_vector(udata->file, udata->nvec, udata->types, udata->addrs,
+                udata->sizes, udata->dxpl_id, udata->bufs) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "vector read failed")
+        udata->nvec = 0;
+    } /* end if */
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -912,6 +1040,7 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
     size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
     size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[])
 {
+    htri_t use_vector;          /* Whether to bypass the sieve buffer */
     ssize_t ret_value = -1;     /* Return value */
 
     FUNC_ENTER_STATIC
@@ -925,8 +1054,11 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
-    /* Check if data sieving is enabled */
-    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
+    /* Check whether to read through the sieve buffer or with vector reads */
+    if((use_vector = H5D__contig_use_vector(io_info, FALSE, dset_max_nseq, *dset_curr_seq, dset_len_arr, dset_off_arr)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't choose how to read")
+
+    if(!use_vector) {
         H5D_contig_readvv_sieve_ud_t udata;     /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
@@ -950,12 +1082,19 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
         udata.dset_addr = io_info->store->contig.dset_addr;
         udata.rbuf = (unsigned char *)io_info->u.rbuf;
         udata.dxpl_id = io_info->raw_dxpl_id;
+        udata.nvec = 0;
 
         /* Call generic sequence operation routine */
         if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
                 mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
                 H5D__contig_readvv_cb, &udata)) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized read")
+
+        /* Read the last batch of pieces */
+        if(udata.nvec > 0)
+            if(H5F_block_read_vector(udata.file, udata.nvec, udata.types, udata.addrs,
+                    udata.sizes, udata.dxpl_id, udata.bufs) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "vector read failed")
     } /* end else */
 
 done:
@@ -1189,7 +1328,11 @@ done:
 /*-------------------------------------------------------------------------
  * Function:	H5D__contig_writevv_cb
  *
- * Purpose:	Callback operator for H5D__contig_writevv().
+ * Purpose:	Callback operator for H5D__contig_writevv() without sieve buffer.
+ *
+ *		The pieces are batched and written with one vector write
+ *		for each H5D_CONTIG_VEC_SIZE of them.  H5D__contig_writevv()
+ *		writes the last, partial, batch.
  *
  * Return:	Non-negative on success/Negative on failure
  *
@@ -1206,9 +1349,19 @@ H5D__contig_writevv_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udat
 
     FUNC_ENTER_STATIC
 
-    /* Write data */
-    if(H5F_block_write(udata->file, H5FD_MEM_DRAW, (udata->dset_addr + dst_off), len, udata->dxpl_id, (udata->wbuf + src_off)) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+    /* Add the piece to the batch */
+    udata->types[udata->nvec] = H5FD_MEM_DRAW;
+    udata->addrs[udata->nvec] = udata->dset_addr + dst_off;
+    udata->sizes[udata->nvec] = len;
+    udata->bufs[udata->nvec] = udata->wbuf + src_off;
+
+    /* Write the batch, once it is full */
+    if(++udata->nvec == H5D_CONTIG_VEC_SIZE) {
+        if(H5F_block_write_vector(udata->file, udata->nvec, udata->types, udata->addrs,
+                udata->sizes, udata->dxpl_id, udata->bufs) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "vector write failed")
+        udata->nvec = 0;
+    } /* end if */
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -1238,6 +1391,7 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
     size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
     size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[])
 {
+    htri_t use_vector;                  /* Whether to bypass the sieve buffer */
     ssize_t ret_value = -1;             /* Return value (Size of sequence in bytes) */
 
     FUNC_ENTER_STATIC
@@ -1251,8 +1405,11 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
-    /* Check if data sieving is enabled */
-    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
+    /* Check whether to write through the sieve buffer or with vector writes */
+    if((use_vector = H5D__contig_use_vector(io_info, TRUE, dset_max_nseq, *dset_curr_seq, dset_len_arr, dset_off_arr)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't choose how to write")
+
+    if(!use_vector) {
         H5D_contig_writevv_sieve_ud_t udata;    /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
@@ -1276,12 +1433,19 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
         udata.dset_addr = io_info->store->contig.dset_addr;
         udata.wbuf = (const unsigned char *)io_info->u.wbuf;
         udata.dxpl_id = io_info->raw_dxpl_id;
+        udata.nvec = 0;
 
         /* Call generic sequence operation routine */
         if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
                 mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
                 H5D__contig_writevv_cb, &udata)) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized read")
+
+        /* Write the last batch of pieces */
+        if(udata.nvec > 0)
+            if(H5F_block_write_vector(udata.file, udata.nvec, udata.types, udata.addrs,
+                    udata.sizes, udata.dxpl_id, udata.bufs) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "vector write failed")
     } /* end else */
 
 done:
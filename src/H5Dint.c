@@ -369,6 +369,10 @@ H5D__get_dxpl_cache_real(hid_t dxpl_id, H5D_dxpl_cache_t *cache)
     if(H5P_get(dx_plist, H5D_XFER_HYPER_VECTOR_SIZE_NAME, &cache->vec_size) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve I/O vector size")
 
+    /* Get # of threads for the filter pipeline */
+    if(H5P_get(dx_plist, H5D_XFER_FILTER_NTHREADS_NAME, &cache->filter_nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve # of filter threads")
+
 #ifdef H5_HAVE_PARALLEL
     /* Collect Parallel I/O information for possible later use */
     if(H5P_get(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &cache->xfer_mode) < 0)
@@ -1198,6 +1202,8 @@ H5D__create(H5F_t *file, hid_t type_id, const H5S_t *space, hid_t dcpl_id,
         if(H5P_get(dc_plist, H5D_CRT_EXT_FILE_LIST_NAME, efl) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, NULL, "can't retrieve external file list")
         efl_copied = TRUE;
+        if(H5P_get(dc_plist, H5D_CRT_STORE_RAW_NAME, &new_dset->shared->dcpl_cache.store_raw) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, NULL, "can't retrieve store-raw ratio")
 
         /* Check that chunked layout is used if filters are enabled */
         if(pline->nused > 0 && H5D_CHUNKED != layout->type)
@@ -1928,6 +1934,10 @@ H5D_close(H5D_t *dataset)
         dataset->shared = H5FL_FREE(H5D_shared_t, dataset->shared);
     } /* end if */
     else {
+        /* Don't let the file-wide chunk cache flush chunks through this handle */
+        if(H5D_CHUNKED == dataset->shared->layout.type && dataset->shared->cache.chunk.owner == dataset)
+            dataset->shared->cache.chunk.owner = NULL;
+
         /* Decrement the ref. count for this object in the top file */
         if(H5FO_top_decr(dataset->oloc.file, dataset->oloc.addr) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't decrement count for object")
@@ -3490,6 +3500,12 @@ H5D_get_access_plist(H5D_t *dset)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache byte size")
         if(H5P_set(new_plist, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, &(dset->shared->cache.chunk.w0)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set preempt read chunks")
+        if(H5P_set(new_plist, H5D_ACS_DATA_CACHE_POLICY_NAME, &(dset->shared->cache.chunk.policy)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache replacement policy")
+        if(H5P_set(new_plist, H5D_ACS_READ_AHEAD_NAME, &(dset->shared->cache.chunk.ra.nchunks)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set chunk read-ahead")
+        if(H5P_set(new_plist, H5D_ACS_FLUSH_SORTED_NAME, &(dset->shared->cache.chunk.flush_sorted)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set sorted chunk flush")
         if(H5P_set(new_plist, H5D_ACS_APPEND_FLUSH_NAME, &dset->shared->append_flush) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set append flush property")
     } /* end if */
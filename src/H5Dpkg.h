@@ -402,16 +402,13 @@ typedef struct H5D_virtual_held_file_t {
 
 /* The raw data chunk cache */
 struct H5D_rdcc_ent_t;  /* Forward declaration of struct used below */
+struct H5D_rdcc_class_t; /* Forward declaration of struct used below */
 typedef struct H5D_rdcc_t {
-    struct {
-        unsigned	ninits;	/* Number of chunk creations		*/
-        unsigned	nhits;	/* Number of cache hits			*/
-        unsigned	nmisses;/* Number of cache misses		*/
-        unsigned	nflushes;/* Number of cache flushes		*/
-    } stats;
+    H5D_chunk_cache_stats_t stats; /* Cache statistics */
     size_t		nbytes_max; /* Maximum cached raw data in bytes	*/
     size_t		nslots;	/* Number of chunk slots allocated	*/
     double		w0;     /* Chunk preemption policy          */
+    H5D_chunk_cache_policy_t policy; /* Chunk replacement policy      */
     struct H5D_rdcc_ent_t *head; /* Head of doubly linked list		*/
     struct H5D_rdcc_ent_t *tail; /* Tail of doubly linked list		*/
     struct H5D_rdcc_ent_t *tmp_head; /* Head of temporary doubly linked list.  Chunks on this list are not in the hash table (slot).  The head entry is a sentinel (does not refer to an actual chunk). */
@@ -419,6 +416,40 @@ typedef struct H5D_rdcc_t {
     int			nused;	/* Number of chunk slots in use		*/
     H5D_chunk_cached_t last;    /* Cached copy of last chunk information */
     struct H5D_rdcc_ent_t **slot; /* Chunk slots, each points to a chunk*/
+    const struct H5D_rdcc_class_t *cls; /* Replacement policy of the cache */
+    struct H5D_rdcc_file_t *file; /* File-wide cache shared with other datasets (or NULL) */
+    const H5D_t         *owner; /* Open dataset that can flush the chunks on behalf of the file-wide cache */
+    H5Z_EDC_t           owner_err_detect; /* Error detection setting of the owner's last access */
+    H5Z_cb_t            owner_filter_cb; /* Filter callback of the owner's last access */
+
+    /* Information used only by the 2Q replacement policy */
+    struct {
+        struct H5D_rdcc_ent_t **bucket; /* Hash buckets, chained through the entries */
+        size_t          nbuckets;   /* Number of hash buckets (a power of 2) */
+        unsigned        *free_idx;  /* Stack of unused slot indices */
+        size_t          nfree;      /* Number of indices on the stack */
+        struct H5D_rdcc_ent_t *am_head; /* First entry of the 'Am' part of the list */
+        size_t          a1in_nbytes; /* Cached raw data in 'A1in' part of the list */
+        hsize_t         *ghost;     /* Ring of hashes of chunks recently preempted from 'A1in' */
+        size_t          nghost_max; /* Capacity of the ring */
+        size_t          ghost_next; /* Next position to use in the ring */
+        H5SL_t          *ghost_set; /* Hashes currently in the ring */
+        hbool_t         promote;    /* Whether the chunk being admitted goes to 'Am' */
+    } q2;
+
+    /* Information used for reading ahead of sequential reads */
+    struct {
+        unsigned        nchunks;    /* Max. # of chunks to read ahead (0 disables read-ahead) */
+        hsize_t         expect;     /* Index of the chunk that continues the current run */
+        hsize_t         next;       /* Index of the first chunk not read ahead yet */
+    } ra;
+    hbool_t             flush_sorted; /* Whether dirty chunks are written back together, in address order */
+
+    /* Information used for storing incompressible chunks raw */
+    struct {
+        unsigned        backoff;    /* # of chunks skipped after the last incompressible one */
+        unsigned        skip;       /* # of chunks still to store raw without filtering */
+    } raw;
     H5SL_t		*sel_chunks; /* Skip list containing information for each chunk selected */
     H5S_t		*single_space; /* Dataspace for single element I/O on chunks */
     H5D_chunk_info_t    *single_chunk_info;  /* Pointer to single chunk's info */
@@ -661,6 +692,8 @@ H5_DLL hbool_t H5D__chunk_is_space_alloc(const H5O_storage_t *storage);
 H5_DLL herr_t H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id,
     const hsize_t *scaled, H5D_chunk_ud_t *udata);
 H5_DLL herr_t H5D__chunk_allocated(H5D_t *dset, hid_t dxpl_id, hsize_t *nbytes);
+H5_DLL herr_t H5D__chunk_iter(const H5D_t *dset, hid_t dxpl_id,
+    H5D_chunk_iter_op_t op, void *op_data);
 H5_DLL herr_t H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_t old_dim[]);
 H5_DLL herr_t H5D__chunk_update_old_edge_chunks(H5D_t *dset, hid_t dxpl_id,
     hsize_t old_dim[]);
@@ -682,6 +715,12 @@ H5_DLL herr_t H5D__chunk_delete(H5F_t *f, hid_t dxpl_id, H5O_t *oh,
     H5O_storage_t *store);
 H5_DLL herr_t H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters, 
          hsize_t *offset, uint32_t data_size, const void *buf);
+H5_DLL herr_t H5D__chunk_direct_read(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *offset, uint32_t *filters, void *buf);
+H5_DLL herr_t H5D__get_chunk_storage_size(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *offset, hsize_t *storage_size);
+H5_DLL herr_t H5D__chunk_cache_advice(const H5D_t *dset, size_t *nslots,
+    size_t *nbytes);
 #ifdef H5D_CHUNK_DEBUG
 H5_DLL herr_t H5D__chunk_stats(const H5D_t *dset, hbool_t headers);
 #endif /* H5D_CHUNK_DEBUG */
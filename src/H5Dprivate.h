@@ -47,11 +47,16 @@
 #define H5D_CRT_FILL_VALUE_NAME    "fill_value"         /* Fill value */
 #define H5D_CRT_ALLOC_TIME_STATE_NAME "alloc_time_state" /* Space allocation time state */
 #define H5D_CRT_EXT_FILE_LIST_NAME "efl"                /* External file list */
+#define H5D_CRT_STORE_RAW_NAME     "store_raw"          /* Size ratio above which filtered chunks are stored raw */
 
 /* ========  Dataset access property names ======== */
 #define H5D_ACS_DATA_CACHE_NUM_SLOTS_NAME   "rdcc_nslots"   /* Size of raw data chunk cache(slots) */
 #define H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME   "rdcc_nbytes"   /* Size of raw data chunk cache(bytes) */
 #define H5D_ACS_PREEMPT_READ_CHUNKS_NAME    "rdcc_w0"       /* Preemption read chunks first */
+#define H5D_ACS_DATA_CACHE_POLICY_NAME      "rdcc_policy"   /* Replacement policy of raw data chunk cache */
+#define H5D_ACS_READ_AHEAD_NAME             "rdcc_read_ahead" /* # of chunks to read ahead of sequential reads */
+#define H5D_ACS_FLUSH_SORTED_NAME           "rdcc_flush_sorted" /* Whether dirty chunks are written back in address order */
+#define H5D_ACS_ACCESS_ADVICE_NAME          "access_advice" /* Expected pattern of access to the raw data */
 #define H5D_ACS_VDS_VIEW_NAME               "vds_view"      /* VDS view option */
 #define H5D_ACS_VDS_PRINTF_GAP_NAME         "vds_printf_gap" /* VDS printf gap size */
 #define H5D_ACS_APPEND_FLUSH_NAME    "append_flush"         /* Append flush actions */
@@ -70,6 +75,7 @@
 #define H5D_XFER_VFL_ID_NAME            "vfl_id"        /* File driver ID */
 #define H5D_XFER_VFL_INFO_NAME          "vfl_info"      /* File driver info */
 #define H5D_XFER_HYPER_VECTOR_SIZE_NAME "vec_size"      /* Hyperslab vector size */
+#define H5D_XFER_FILTER_NTHREADS_NAME   "filter_nthreads" /* Number of threads for filter pipeline */
 #define H5D_XFER_IO_XFER_MODE_NAME      "io_xfer_mode"  /* I/O transfer mode */
 #define H5D_XFER_MPIO_COLLECTIVE_OPT_NAME "mpio_collective_opt" /* Optimization of MPI-IO transfer mode */
 #define H5D_XFER_MPIO_CHUNK_OPT_HARD_NAME "mpio_chunk_opt_hard"
@@ -130,6 +136,7 @@ typedef struct H5D_dxpl_cache_t {
     H5Z_EDC_t err_detect;       /* Error detection info (H5D_XFER_EDC_NAME) */
     double btree_split_ratio[3];/* B-tree split ratios (H5D_XFER_BTREE_SPLIT_RATIO_NAME) */
     size_t vec_size;            /* Size of hyperslab vector (H5D_XFER_HYPER_VECTOR_SIZE_NAME) */
+    unsigned filter_nthreads;   /* # of threads for running filters (H5D_XFER_FILTER_NTHREADS_NAME) */
 #ifdef H5_HAVE_PARALLEL
     H5FD_mpio_xfer_t xfer_mode; /* Parallel transfer for this request (H5D_XFER_IO_XFER_MODE_NAME) */
     H5FD_mpio_collective_opt_t coll_opt_mode; /* Parallel transfer with independent IO or collective IO with this mode */
@@ -143,6 +150,7 @@ typedef struct H5D_dcpl_cache_t {
     H5O_fill_t fill;            /* Fill value info (H5D_CRT_FILL_VALUE_NAME) */
     H5O_pline_t pline;          /* I/O pipeline info (H5O_CRT_PIPELINE_NAME) */
     H5O_efl_t efl;              /* External file list info (H5D_CRT_EXT_FILE_LIST_NAME) */
+    double store_raw;           /* Store-raw size ratio (H5D_CRT_STORE_RAW_NAME) */
 } H5D_dcpl_cache_t;
 
 /* Callback information for copying datasets */
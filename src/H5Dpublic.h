@@ -42,6 +42,11 @@
 #define H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_NAME	"direct_chunk_filters"
 #define H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME		"direct_chunk_offset"
 #define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME	"direct_chunk_datasize"
+
+/* Property names for H5DOread_chunk */
+#define H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME		"direct_chunk_read_flag"
+#define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME		"direct_chunk_read_offset"
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME		"direct_chunk_read_filters"
  
 /*******************/
 /* Public Typedefs */
@@ -109,6 +114,28 @@ typedef enum H5D_vds_view_t {
     H5D_VDS_LAST_AVAILABLE      = 1
 } H5D_vds_view_t;
 
+/* Values for the raw data chunk cache replacement policy */
+typedef enum H5D_chunk_cache_policy_t {
+    H5D_CHUNK_CACHE_POLICY_ERROR = -1,
+    H5D_CHUNK_CACHE_LRU         = 0,    /* Hashed slots, w0-weighted LRU (default) */
+    H5D_CHUNK_CACHE_2Q          = 1     /* Growable slots, scan-resistant 2Q */
+} H5D_chunk_cache_policy_t;
+
+/* Raw data chunk cache statistics for an open dataset (H5Dget_chunk_cache_stats) */
+typedef struct H5D_chunk_cache_stats_t {
+    hsize_t nhits;              /* Chunk accesses satisfied from the cache */
+    hsize_t nmisses;            /* Chunks read from the file into the cache */
+    hsize_t ninits;             /* Chunks created in the cache (not in the file yet) */
+    hsize_t nevictions;         /* Chunks preempted to make room for others */
+    hsize_t ncollisions;        /* Preemptions caused by a hash slot collision */
+    hsize_t nflushes;           /* Chunks written from the cache to the file */
+    hsize_t nbytes_read;        /* Bytes read from the file into the cache */
+    hsize_t nbytes_decoded;     /* Bytes produced by the filter pipeline on read */
+    hsize_t max_sel_chunks;     /* Most chunks touched by a single I/O operation */
+    hsize_t nraw;               /* Filtered chunks written unfiltered (H5Pset_chunk_store_raw) */
+    hsize_t nraw_untried;       /* ...of which without trying the filters */
+} H5D_chunk_cache_stats_t;
+
 /* Callback for H5Pset_append_flush() in a dataset access property list */
 typedef herr_t (*H5D_append_cb_t)(hid_t dataset_id, hsize_t *cur_dims, void *op_data);
 
@@ -136,6 +163,10 @@ typedef herr_t (*H5D_scatter_func_t)(const void **src_buf/*out*/,
 typedef herr_t (*H5D_gather_func_t)(const void *dst_buf,
                                     size_t dst_buf_bytes_used, void *op_data);
 
+/* Define the operator function pointer for H5Dchunk_iter() */
+typedef int (*H5D_chunk_iter_op_t)(const hsize_t *offset, unsigned filter_mask,
+                                   haddr_t addr, hsize_t nbytes, void *op_data);
+
 H5_DLL hid_t H5Dcreate2(hid_t loc_id, const char *name, hid_t type_id,
     hid_t space_id, hid_t lcpl_id, hid_t dcpl_id, hid_t dapl_id);
 H5_DLL hid_t H5Dcreate_anon(hid_t file_id, hid_t type_id, hid_t space_id,
@@ -148,6 +179,19 @@ H5_DLL hid_t H5Dget_type(hid_t dset_id);
 H5_DLL hid_t H5Dget_create_plist(hid_t dset_id);
 H5_DLL hid_t H5Dget_access_plist(hid_t dset_id);
 H5_DLL hsize_t H5Dget_storage_size(hid_t dset_id);
+H5_DLL herr_t H5Dget_chunk_storage_size(hid_t dset_id, const hsize_t *offset,
+    hsize_t *chunk_nbytes/*out*/);
+H5_DLL herr_t H5Dget_num_chunks(hid_t dset_id, hsize_t *nchunks/*out*/);
+H5_DLL herr_t H5Dget_chunk_info_all(hid_t dset_id, size_t nalloc,
+    hsize_t *offsets/*out*/, unsigned *filter_masks/*out*/,
+    haddr_t *addrs/*out*/, hsize_t *nbytes/*out*/, size_t *nchunks/*out*/);
+H5_DLL herr_t H5Dchunk_iter(hid_t dset_id, H5D_chunk_iter_op_t op,
+    void *op_data);
+H5_DLL herr_t H5Dget_chunk_cache_stats(hid_t dset_id,
+    H5D_chunk_cache_stats_t *stats/*out*/);
+H5_DLL herr_t H5Dreset_chunk_cache_stats(hid_t dset_id);
+H5_DLL herr_t H5Dget_chunk_cache_advice(hid_t dset_id, size_t *rdcc_nslots/*out*/,
+    size_t *rdcc_nbytes/*out*/);
 H5_DLL haddr_t H5Dget_offset(hid_t dset_id);
 H5_DLL herr_t H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			hid_t file_space_id, hid_t plist_id, void *buf/*out*/);
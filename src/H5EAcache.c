@@ -286,7 +286,6 @@ H5EA__cache_hdr_deserialize(const void *_image, size_t len, void *_udata,
     H5EA_hdr_cache_ud_t *udata = (H5EA_hdr_cache_ud_t *)_udata;
     const uint8_t	*image = (const uint8_t *)_image;       /* Pointer into raw data buffer */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
 
     /* Check arguments */
     HDassert(image);
@@ -361,15 +360,11 @@ H5EA__cache_hdr_deserialize(const void *_image, size_t len, void *_udata,
     /* (allow for checksum not decoded yet) */
     HDassert((size_t)(image - (const uint8_t *)_image) == (len - H5EA_SIZEOF_CHKSUM));
 
-    /* Compute checksum on entire header */
-    /* (including the filter information, if present) */
-    computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5EA_SIZEOF_CHKSUM), stored_chksum))
 	H5E_THROW(H5E_BADVALUE, "incorrect metadata checksum for extensible array header")
 
     /* Sanity check */
@@ -585,7 +580,6 @@ H5EA__cache_iblock_deserialize(const void *_image, size_t len,
     H5EA_hdr_t *hdr = (H5EA_hdr_t *)_udata;     /* User data for callback */
     const uint8_t	*image = (const uint8_t *)_image;       /* Pointer into raw data buffer */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
     haddr_t             arr_addr;       /* Address of array header in the file */
     size_t              u;              /* Local index variable */
 
@@ -649,9 +643,6 @@ H5EA__cache_iblock_deserialize(const void *_image, size_t len,
     /* Save the index block's size */
     iblock->size = len;
 
-    /* Compute checksum on index block */
-    computed_chksum = H5_checksum_metadata((const uint8_t *)_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -659,7 +650,7 @@ H5EA__cache_iblock_deserialize(const void *_image, size_t len,
     HDassert((size_t)(image - (const uint8_t *)_image) == iblock->size);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(hdr->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5EA_SIZEOF_CHKSUM), stored_chksum))
 	H5E_THROW(H5E_BADVALUE, "incorrect metadata checksum for extensible array index block")
 
     /* Set return value */
@@ -955,7 +946,6 @@ H5EA__cache_sblock_deserialize(const void *_image, size_t len,
     H5EA_sblock_cache_ud_t *udata = (H5EA_sblock_cache_ud_t *)_udata;      /* User data */
     const uint8_t	*image = (const uint8_t *)_image;       /* Pointer into raw data buffer */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
     haddr_t             arr_addr;       /* Address of array header in the file */
     size_t              u;              /* Local index variable */
 
@@ -1016,9 +1006,6 @@ H5EA__cache_sblock_deserialize(const void *_image, size_t len,
     /* Save the super block's size */
     sblock->size = len;
 
-    /* Compute checksum on super block */
-    computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -1026,7 +1013,7 @@ H5EA__cache_sblock_deserialize(const void *_image, size_t len,
     HDassert((size_t)(image - (const uint8_t *)_image) == sblock->size);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->hdr->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5EA_SIZEOF_CHKSUM), stored_chksum))
 	H5E_THROW(H5E_BADVALUE, "incorrect metadata checksum for extensible array super block")
 
     /* Set return value */
@@ -1322,7 +1309,6 @@ H5EA__cache_dblock_deserialize(const void *_image, size_t len,
     H5EA_dblock_cache_ud_t *udata = (H5EA_dblock_cache_ud_t *)_udata;      /* User data */
     const uint8_t	*image = (const uint8_t *)_image;       /* Pointer into raw data buffer */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
     haddr_t             arr_addr;       /* Address of array header in the file */
 
     /* Check arguments */
@@ -1382,9 +1368,6 @@ H5EA__cache_dblock_deserialize(const void *_image, size_t len,
     /* (Note: This is not the same as the image length, for paged data blocks) */
     dblock->size = H5EA_DBLOCK_SIZE(dblock);
 
-    /* Compute checksum on data block */
-    computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -1392,7 +1375,7 @@ H5EA__cache_dblock_deserialize(const void *_image, size_t len,
     HDassert((size_t)(image - (const uint8_t *)_image) == len);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->hdr->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5EA_SIZEOF_CHKSUM), stored_chksum))
 	H5E_THROW(H5E_BADVALUE, "incorrect metadata checksum for extensible array data block")
 
     /* Set return value */
@@ -1708,7 +1691,6 @@ H5EA__cache_dblk_page_deserialize(const void *_image, size_t len,
     H5EA_dblk_page_cache_ud_t *udata = (H5EA_dblk_page_cache_ud_t *)_udata;      /* User data for loading data block page */
     const uint8_t	*image = (const uint8_t *)_image;       /* Pointer into raw data buffer */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
 
     /* Sanity check */
     HDassert(udata);
@@ -1738,9 +1720,6 @@ H5EA__cache_dblk_page_deserialize(const void *_image, size_t len,
     /* Set the data block page's size */
     dblk_page->size = len;
 
-    /* Compute checksum on data block page */
-    computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -1748,7 +1727,7 @@ H5EA__cache_dblk_page_deserialize(const void *_image, size_t len,
     HDassert((size_t)(image - (const uint8_t *)_image) == dblk_page->size);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->hdr->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5EA_SIZEOF_CHKSUM), stored_chksum))
 	H5E_THROW(H5E_BADVALUE, "incorrect metadata checksum for extensible array data block page")
 
     /* Set return value */
@@ -1226,6 +1226,124 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* H5Freset_mdc_hit_rate_stats() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Fget_mdc_chksum_stats
+ *
+ * Purpose:     Retrieves the counts of metadata checksums verified and
+ *		skipped as metadata was loaded into the metadata cache
+ *		since the file was opened, along with an estimate of the
+ *		time the skipped verifications would have taken.
+ *		Verifications are skipped when the file was opened with
+ *		H5Pset_skip_metadata_checksums().
+ *
+ *		The estimate assumes the checksum runs at 10^9 bytes per
+ *		second, a typical speed; it isn't measured.
+ *
+ * Return:      Success:        SUCCEED
+ *              Failure:        FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Fget_mdc_chksum_stats(hid_t file_id, H5F_mdc_chksum_stats_t *stats_ptr)
+{
+    H5F_t      *file;                   /* File object for file ID */
+    herr_t     ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*x", file_id, stats_ptr);
+
+    /* Check args */
+    if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
+    if(NULL == stats_ptr)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL stats pointer")
+
+    /* Go get the checksum statistics */
+    if(H5AC_get_cache_chksum_stats(file->shared->cache, stats_ptr) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5AC_get_cache_chksum_stats() failed.")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* H5Fget_mdc_chksum_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Fget_page_buffering_stats
+ *
+ * Purpose:     Retrieves the page buffer's statistics for a file: the
+ *		number of accesses made through it, the hits and misses
+ *		among them, the pages evicted, the accesses too large to
+ *		be buffered and the pages written to the file, each for
+ *		metadata and for raw data.  The counts start when the
+ *		file is opened or the statistics are reset with
+ *		H5Freset_page_buffering_stats().  Fails if the file was
+ *		not opened with a page buffer.
+ *
+ * Return:      Success:        SUCCEED
+ *              Failure:        FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Fget_page_buffering_stats(hid_t file_id, H5F_page_buf_stats_t *stats_ptr)
+{
+    H5F_t      *file;                   /* File object for file ID */
+    herr_t     ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*x", file_id, stats_ptr);
+
+    /* Check args */
+    if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
+    if(NULL == stats_ptr)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL stats pointer")
+    if(NULL == file->shared->page_buf)
+        HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffering not enabled on file")
+
+    /* Copy out the statistics */
+    *stats_ptr = file->shared->page_buf->stats;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* H5Fget_page_buffering_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Freset_page_buffering_stats
+ *
+ * Purpose:     Resets the page buffer's statistics for a file to zero.
+ *		Fails if the file was not opened with a page buffer.
+ *
+ * Return:      Success:        SUCCEED
+ *              Failure:        FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Freset_page_buffering_stats(hid_t file_id)
+{
+    H5F_t      *file;                   /* File object for file ID */
+    herr_t     ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", file_id);
+
+    /* Check args */
+    if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
+    if(NULL == file->shared->page_buf)
+        HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffering not enabled on file")
+
+    /* Reset the statistics */
+    HDmemset(&file->shared->page_buf->stats, 0, sizeof(H5F_page_buf_stats_t));
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* H5Freset_page_buffering_stats() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Fget_name
@@ -225,7 +225,6 @@ H5FA__cache_hdr_deserialize(const void *_image, size_t len,
     H5FA_hdr_cache_ud_t *udata = (H5FA_hdr_cache_ud_t *)_udata;
     const uint8_t	*image = (const uint8_t *)_image;       /* Pointer into raw data buffer */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
 
     /* Check arguments */
     HDassert(udata);
@@ -289,10 +288,6 @@ H5FA__cache_hdr_deserialize(const void *_image, size_t len,
     /* (allow for checksum not decoded yet) */
     HDassert((size_t)(image - (const uint8_t *)_image) == (len - H5FA_SIZEOF_CHKSUM));
 
-    /* Compute checksum on entire header */
-    /* (including the filter information, if present) */
-    computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -300,7 +295,7 @@ H5FA__cache_hdr_deserialize(const void *_image, size_t len,
     HDassert((size_t)(image - (const uint8_t *)_image) == len);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5FA_SIZEOF_CHKSUM), stored_chksum))
 	H5E_THROW(H5E_BADVALUE, "incorrect metadata checksum for fixed array header")
 
     /* Finish initializing fixed array header */
@@ -520,7 +515,6 @@ H5FA__cache_dblock_deserialize(const void *_image, size_t len,
     H5FA_dblock_cache_ud_t *udata = (H5FA_dblock_cache_ud_t *)_udata; /* User data for loading data block */
     const uint8_t  *image = (const uint8_t *)_image;    /* Pointer into raw data buffer */
     uint32_t       stored_chksum;   /* Stored metadata checksum value */
-    uint32_t       computed_chksum; /* Computed metadata checksum value */
     haddr_t        arr_addr;        /* Address of array header in the file */
 
     /* Sanity check */
@@ -577,9 +571,6 @@ H5FA__cache_dblock_deserialize(const void *_image, size_t len,
     /* Set the data block's size */
     dblock->size = H5FA_DBLOCK_SIZE(dblock);
 
-    /* Compute checksum on data block */
-    computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -587,7 +578,7 @@ H5FA__cache_dblock_deserialize(const void *_image, size_t len,
     HDassert((size_t)(image - (const uint8_t *)_image) == len);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->hdr->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5FA_SIZEOF_CHKSUM), stored_chksum))
 	H5E_THROW(H5E_BADVALUE, "incorrect metadata checksum for fixed array data block")
 
     /* Set return value */
@@ -844,7 +835,6 @@ H5FA__cache_dblk_page_deserialize(const void *_image, size_t len,
     H5FA_dblk_page_cache_ud_t *udata = (H5FA_dblk_page_cache_ud_t *)_udata; /* User data for loading data block page */
     const uint8_t	*image = (const uint8_t *)_image;       /* Pointer into raw data buffer */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
 
     /* Sanity check */
     HDassert(udata);
@@ -874,9 +864,6 @@ H5FA__cache_dblk_page_deserialize(const void *_image, size_t len,
     /* Set the data block page's size */
     dblk_page->size = len;
 
-    /* Compute checksum on data block */
-    computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -884,7 +871,7 @@ H5FA__cache_dblk_page_deserialize(const void *_image, size_t len,
     HDassert((size_t)(image - (const uint8_t *)_image) == dblk_page->size);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->hdr->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5FA_SIZEOF_CHKSUM), stored_chksum))
 	H5E_THROW(H5E_BADVALUE, "incorrect metadata checksum for fixed array data block page")
 
     /* Set return value */
@@ -0,0 +1,1813 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: The Linux asynchronous I/O file driver.  Single reads and
+ *          writes are made with pread() and pwrite(), as the sec2 driver
+ *          makes them.  The pieces of a vector read or write request are
+ *          submitted to the kernel through io_uring, or native AIO where
+ *          io_uring is not available, keeping up to the queue depth of
+ *          them outstanding at once, so that a device which serves many
+ *          requests in parallel (an NVMe drive, say) is kept busy.
+ *
+ *          The kernel interfaces are reached through syscall(), so the
+ *          driver needs only the kernel's headers, not liburing or
+ *          libaio.
+ */
+
+#include "H5FDdrvr_module.h" /* This source code file is part of the H5FD driver module */
+
+
+#include "H5private.h"      /* Generic Functions        */
+#include "H5Eprivate.h"     /* Error handling           */
+#include "H5Fprivate.h"     /* File access              */
+#include "H5FDprivate.h"    /* File drivers             */
+#include "H5FDasync.h"      /* Async file driver        */
+#include "H5FLprivate.h"    /* Free Lists               */
+#include "H5Iprivate.h"     /* IDs                      */
+#include "H5MMprivate.h"    /* Memory management        */
+#include "H5Pprivate.h"     /* Property lists           */
+
+#ifdef H5_HAVE_ASYNC_VFD
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#ifdef H5_HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#endif /* H5_HAVE_LINUX_IO_URING_H */
+#ifdef H5_HAVE_LINUX_AIO_ABI_H
+#include <linux/aio_abi.h>
+#endif /* H5_HAVE_LINUX_AIO_ABI_H */
+
+/* Which engines can be built: the kernel headers must describe the
+ * interface, and the C library must know its system call numbers.
+ */
+#if defined(H5_HAVE_LINUX_IO_URING_H) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define H5FD_ASYNC_HAVE_IO_URING
+#endif
+#if defined(H5_HAVE_LINUX_AIO_ABI_H) && defined(__NR_io_setup) && defined(__NR_io_destroy) \
+        && defined(__NR_io_submit) && defined(__NR_io_getevents)
+#define H5FD_ASYNC_HAVE_LINUX_AIO
+#endif
+
+/* The driver identification number, initialized at runtime */
+static hid_t H5FD_ASYNC_g = 0;
+
+/* Driver-specific file access properties.  When returned for an open
+ * file, 'engine' is the engine the file is using.
+ */
+typedef struct H5FD_async_fapl_t {
+    unsigned            queue_depth;    /* Most operations outstanding  */
+    H5FD_async_engine_t engine;         /* Engine to submit them with   */
+} H5FD_async_fapl_t;
+
+/* An operation of a vector request in flight.  A slot whose size is zero
+ * is free.
+ */
+typedef struct H5FD_async_op_t {
+    H5FD_mem_t      type;       /* Type of the piece                */
+    haddr_t         addr;       /* File address of the piece        */
+    size_t          size;       /* Size of the piece                */
+    void            *rbuf;      /* Buffer a read fills, or          */
+    const void      *wbuf;      /* Buffer a write empties           */
+    struct iovec    iov;        /* The piece, for io_uring          */
+} H5FD_async_op_t;
+
+/* A finished operation */
+typedef struct H5FD_async_done_t {
+    unsigned        slot;       /* Slot of the operation            */
+    long            res;        /* Bytes moved, or negative errno   */
+} H5FD_async_done_t;
+
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+/* An io_uring instance: the submission and completion rings shared with
+ * the kernel, and the number of submission queue entries published to the
+ * kernel but not yet submitted by io_uring_enter().
+ */
+typedef struct H5FD_async_uring_t {
+    int                 fd;             /* io_uring file descriptor     */
+    void                *sq_map;        /* Submission ring mapping      */
+    size_t              sq_map_size;
+    void                *cq_map;        /* Completion ring mapping      */
+    size_t              cq_map_size;
+    struct io_uring_sqe *sqes;          /* Submission queue entries     */
+    size_t              sqes_size;
+    unsigned            *sq_head;
+    unsigned            *sq_tail;
+    unsigned            *sq_mask;
+    unsigned            *sq_array;
+    unsigned            *cq_head;
+    unsigned            *cq_tail;
+    unsigned            *cq_mask;
+    struct io_uring_cqe *cqes;
+    unsigned            nqueued;        /* Entries queued, not submitted */
+} H5FD_async_uring_t;
+
+/* The rings' head and tail indices are shared with the kernel */
+#define H5FD_ASYNC_LOAD_ACQUIRE(P)      __atomic_load_n((P), __ATOMIC_ACQUIRE)
+#define H5FD_ASYNC_STORE_RELEASE(P, V)  __atomic_store_n((P), (V), __ATOMIC_RELEASE)
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+/* A native AIO context, with a control block for each slot and the
+ * blocks filled in but not yet submitted.
+ */
+typedef struct H5FD_async_aio_t {
+    aio_context_t       ctx;            /* AIO context                  */
+    struct iocb         *iocbs;         /* Control block of each slot   */
+    struct iocb         **pending;      /* Blocks not yet submitted     */
+    unsigned            npending;
+    struct io_event     *events;        /* Events of one io_getevents() */
+} H5FD_async_aio_t;
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+
+/* The description of a file belonging to this driver.  The 'eoa' and
+ * 'eof' determine the amount of hdf5 address space in use and the
+ * high-water mark of the file (the current size of the underlying
+ * filesystem file), as they do for the sec2 driver.
+ *
+ * The slots in 'ops', one for each operation the queue depth allows
+ * outstanding, hold the pieces of a vector request in flight; 'free_ops'
+ * is a stack of the free ones.  The engine reports the operations that
+ * finish in 'done'.  No operation is left in flight when a vector request
+ * returns.
+ */
+typedef struct H5FD_async_t {
+    H5FD_t              pub;        /* public stuff, must be first      */
+    int                 fd;         /* the filesystem file descriptor   */
+    haddr_t             eoa;        /* end of allocated region          */
+    haddr_t             eof;        /* end of file; current file size   */
+    H5FD_async_fapl_t   fa;         /* queue depth and engine in use    */
+    char                filename[H5FD_MAX_FILENAME_LEN];    /* Copy of file name from open operation */
+    dev_t               device;     /* file device number               */
+    ino_t               inode;      /* file i-node number               */
+    H5FD_async_op_t     *ops;       /* operation slots                  */
+    unsigned            *free_ops;  /* stack of free slots              */
+    unsigned            nfree;      /* # of free slots                  */
+    H5FD_async_done_t   *done;      /* operations finished              */
+    unsigned            ndone;      /* # of operations finished         */
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+    H5FD_async_uring_t  ring;       /* io_uring engine                  */
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+    H5FD_async_aio_t    aio;        /* native AIO engine                */
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+} H5FD_async_t;
+
+/*
+ * These macros check for overflow of various quantities.  These macros
+ * assume that HDoff_t is signed and haddr_t and size_t are unsigned.
+ *
+ * ADDR_OVERFLOW:   Checks whether a file address of type `haddr_t'
+ *                  is too large to be represented by the second argument
+ *                  of the file seek function.
+ *
+ * SIZE_OVERFLOW:   Checks whether a buffer size of type `hsize_t' is too
+ *                  large to be represented by the `size_t' type.
+ *
+ * REGION_OVERFLOW: Checks whether an address and size pair describe data
+ *                  which can be addressed entirely by the second
+ *                  argument of the file seek function.
+ */
+#define MAXADDR (((haddr_t)1<<(8*sizeof(HDoff_t)-1))-1)
+#define ADDR_OVERFLOW(A)    (HADDR_UNDEF==(A) || ((A) & ~(haddr_t)MAXADDR))
+#define SIZE_OVERFLOW(Z)    ((Z) & ~(hsize_t)MAXADDR)
+#define REGION_OVERFLOW(A,Z)    (ADDR_OVERFLOW(A) || SIZE_OVERFLOW(Z) ||    \
+                                 HADDR_UNDEF==(A)+(Z) ||                    \
+                                (HDoff_t)((A)+(Z))<(HDoff_t)(A))
+
+/* Prototypes */
+static herr_t H5FD_async_term(void);
+static void *H5FD_async_fapl_get(H5FD_t *file);
+static void *H5FD_async_fapl_copy(const void *_old_fa);
+static H5FD_t *H5FD_async_open(const char *name, unsigned flags, hid_t fapl_id,
+            haddr_t maxaddr);
+static herr_t H5FD_async_close(H5FD_t *_file);
+static int H5FD_async_cmp(const H5FD_t *_f1, const H5FD_t *_f2);
+static herr_t H5FD_async_query(const H5FD_t *_f1, unsigned long *flags);
+static haddr_t H5FD_async_get_eoa(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t H5FD_async_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr);
+static haddr_t H5FD_async_get_eof(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t  H5FD_async_get_handle(H5FD_t *_file, hid_t fapl, void** file_handle);
+static herr_t H5FD_async_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, void *buf);
+static herr_t H5FD_async_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, const void *buf);
+static herr_t H5FD_async_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
+static herr_t H5FD_async_lock(H5FD_t *_file, hbool_t rw);
+static herr_t H5FD_async_unlock(H5FD_t *_file);
+static herr_t H5FD_async_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]);
+static herr_t H5FD_async_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[]);
+static herr_t H5FD_async_engine_open(H5FD_async_t *file, H5FD_async_engine_t engine);
+static void H5FD_async_engine_close(H5FD_async_t *file);
+static void H5FD_async_queue(H5FD_async_t *file, unsigned slot, hbool_t writing);
+static herr_t H5FD_async_submit(H5FD_async_t *file, unsigned inflight);
+static unsigned H5FD_async_drop(H5FD_async_t *file);
+static herr_t H5FD_async_xfer(H5FD_async_t *file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *rbufs[], const void *wbufs[]);
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+static herr_t H5FD_async_uring_setup(H5FD_async_t *file);
+static void H5FD_async_uring_teardown(H5FD_async_t *file);
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+static herr_t H5FD_async_aio_setup(H5FD_async_t *file);
+static void H5FD_async_aio_teardown(H5FD_async_t *file);
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+
+static const H5FD_class_t H5FD_async_g = {
+    "async",                    /* name                 */
+    MAXADDR,                    /* maxaddr              */
+    H5F_CLOSE_WEAK,             /* fc_degree            */
+    H5FD_async_term,            /* terminate            */
+    NULL,                       /* sb_size              */
+    NULL,                       /* sb_encode            */
+    NULL,                       /* sb_decode            */
+    sizeof(H5FD_async_fapl_t),  /* fapl_size            */
+    H5FD_async_fapl_get,        /* fapl_get             */
+    H5FD_async_fapl_copy,       /* fapl_copy            */
+    NULL,                       /* fapl_free            */
+    0,                          /* dxpl_size            */
+    NULL,                       /* dxpl_copy            */
+    NULL,                       /* dxpl_free            */
+    H5FD_async_open,            /* open                 */
+    H5FD_async_close,           /* close                */
+    H5FD_async_cmp,             /* cmp                  */
+    H5FD_async_query,           /* query                */
+    NULL,                       /* get_type_map         */
+    NULL,                       /* alloc                */
+    NULL,                       /* free                 */
+    H5FD_async_get_eoa,         /* get_eoa              */
+    H5FD_async_set_eoa,         /* set_eoa              */
+    H5FD_async_get_eof,         /* get_eof              */
+    H5FD_async_get_handle,      /* get_handle           */
+    H5FD_async_read,            /* read                 */
+    H5FD_async_write,           /* write                */
+    NULL,                       /* flush                */
+    H5FD_async_truncate,        /* truncate             */
+    H5FD_async_lock,            /* lock                 */
+    H5FD_async_unlock,          /* unlock               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD_async_read_vector,     /* read_vector          */
+    H5FD_async_write_vector,    /* write_vector         */
+    NULL                        /* advise               */
+};
+
+/* Declare a free list to manage the H5FD_async_t struct */
+H5FL_DEFINE_STATIC(H5FD_async_t);
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__init_package
+ *
+ * Purpose:     Initializes any interface-specific data or routines.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__init_package(void)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if(H5FD_async_init() < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to initialize async VFD")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5FD__init_package() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_init
+ *
+ * Purpose:     Initialize this driver by registering the driver with the
+ *              library.
+ *
+ * Return:      Success:    The driver ID for the async driver.
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+hid_t
+H5FD_async_init(void)
+{
+    hid_t ret_value = H5I_INVALID_HID;          /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if(H5I_VFL != H5I_get_type(H5FD_ASYNC_g))
+        H5FD_ASYNC_g = H5FD_register(&H5FD_async_g, sizeof(H5FD_class_t), FALSE);
+
+    /* Set return value */
+    ret_value = H5FD_ASYNC_g;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_init() */
+
+
+/*---------------------------------------------------------------------------
+ * Function:    H5FD_async_term
+ *
+ * Purpose:     Shut down the VFD
+ *
+ * Returns:     SUCCEED (Can't fail)
+ *
+ *---------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_term(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Reset VFL ID */
+    H5FD_ASYNC_g = 0;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_async_term() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_fapl_async
+ *
+ * Purpose:     Modify the file access property list to use the H5FD_ASYNC
+ *              driver defined in this source file.  QUEUE_DEPTH is the
+ *              most reads or writes of a vector request the driver keeps
+ *              outstanding at once; zero selects the default.  ENGINE is
+ *              the kernel interface they are submitted through:
+ *              H5FD_ASYNC_ENGINE_DEFAULT tries io_uring, then native AIO,
+ *              then falls back to pread()/pwrite(); naming an engine
+ *              makes opening a file fail if that engine isn't available.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_fapl_async(hid_t fapl_id, unsigned queue_depth, H5FD_async_engine_t engine)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    H5FD_async_fapl_t   fa;             /* Driver properties */
+    herr_t ret_value;
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "iIuDe", fapl_id, queue_depth, engine);
+
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access property list")
+    if(queue_depth > H5FD_ASYNC_QUEUE_DEPTH_MAX)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "queue depth too large")
+    if(engine < H5FD_ASYNC_ENGINE_DEFAULT || engine > H5FD_ASYNC_ENGINE_SYNC)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid engine")
+
+    fa.queue_depth = queue_depth ? queue_depth : H5FD_ASYNC_QUEUE_DEPTH_DEF;
+    fa.engine = engine;
+
+    ret_value = H5P_set_driver(plist, H5FD_ASYNC, &fa);
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_fapl_async() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_fapl_async
+ *
+ * Purpose:     Returns information about the async file access property
+ *              list through the function arguments.  For the access
+ *              property list of an open file, the engine returned is the
+ *              one the file is using.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_fapl_async(hid_t fapl_id, unsigned *queue_depth/*out*/,
+    H5FD_async_engine_t *engine/*out*/)
+{
+    H5P_genplist_t          *plist;     /* Property list pointer */
+    const H5FD_async_fapl_t *fa;        /* Driver properties */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "ixx", fapl_id, queue_depth, engine);
+
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access list")
+    if(H5FD_ASYNC != H5P_peek_driver(plist))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "incorrect VFL driver")
+    if(NULL == (fa = (const H5FD_async_fapl_t *)H5P_peek_driver_info(plist)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "bad VFL driver info")
+    if(queue_depth)
+        *queue_depth = fa->queue_depth;
+    if(engine)
+        *engine = fa->engine;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_fapl_async() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_fapl_get
+ *
+ * Purpose:     Returns a file access property list which indicates how the
+ *              specified file is being accessed.  The engine in it is the
+ *              one the file is using.
+ *
+ * Return:      Success:    Ptr to new file access property list with all
+ *                          members copied from the file struct.
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD_async_fapl_get(H5FD_t *_file)
+{
+    H5FD_async_t    *file = (H5FD_async_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(H5FD_async_fapl_copy(&(file->fa)))
+} /* end H5FD_async_fapl_get() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_fapl_copy
+ *
+ * Purpose:     Copies the async-specific file access properties.
+ *
+ * Return:      Success:    Ptr to a new property list
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD_async_fapl_copy(const void *_old_fa)
+{
+    const H5FD_async_fapl_t *old_fa = (const H5FD_async_fapl_t *)_old_fa;
+    H5FD_async_fapl_t       *new_fa = NULL;
+    void                    *ret_value = NULL;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(NULL == (new_fa = (H5FD_async_fapl_t *)H5MM_malloc(sizeof(H5FD_async_fapl_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
+
+    /* Copy the general information */
+    *new_fa = *old_fa;
+
+    ret_value = new_fa;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_fapl_copy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_open
+ *
+ * Purpose:     Create and/or opens a file as an HDF5 file, and sets up the
+ *              engine its vector requests are submitted through.
+ *
+ * Return:      Success:    A pointer to a new file data structure. The
+ *                          public fields will be initialized by the
+ *                          caller, which is always H5FD_open().
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5FD_t *
+H5FD_async_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
+{
+    H5FD_async_t    *file       = NULL;     /* async VFD info           */
+    int             fd          = -1;       /* File descriptor          */
+    int             o_flags;                /* Flags for open() call    */
+    H5P_genplist_t  *plist;                 /* Property list pointer    */
+    const H5FD_async_fapl_t *fa;            /* Driver properties        */
+    H5FD_async_fapl_t default_fa;           /* Properties if none set   */
+    h5_stat_t       sb;
+    unsigned        u;
+    H5FD_t          *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check on file offsets */
+    HDcompile_assert(sizeof(HDoff_t) >= sizeof(size_t));
+
+    /* Check arguments */
+    if(!name || !*name)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "invalid file name")
+    if(0 == maxaddr || HADDR_UNDEF == maxaddr)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, NULL, "bogus maxaddr")
+    if(ADDR_OVERFLOW(maxaddr))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, NULL, "bogus maxaddr")
+
+    /* Get the driver specific information */
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "not a file access property list")
+    if(NULL == (fa = (const H5FD_async_fapl_t *)H5P_peek_driver_info(plist))) {
+        default_fa.queue_depth = H5FD_ASYNC_QUEUE_DEPTH_DEF;
+        default_fa.engine = H5FD_ASYNC_ENGINE_DEFAULT;
+        fa = &default_fa;
+    } /* end if */
+
+    /* Build the open flags */
+    o_flags = (H5F_ACC_RDWR & flags) ? O_RDWR : O_RDONLY;
+    if(H5F_ACC_TRUNC & flags)
+        o_flags |= O_TRUNC;
+    if(H5F_ACC_CREAT & flags)
+        o_flags |= O_CREAT;
+    if(H5F_ACC_EXCL & flags)
+        o_flags |= O_EXCL;
+
+    /* Open the file */
+    if((fd = HDopen(name, o_flags, 0666)) < 0) {
+        int myerrno = errno;
+        HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to open file: name = '%s', errno = %d, error message = '%s', flags = %x, o_flags = %x", name, myerrno, HDstrerror(myerrno), flags, (unsigned)o_flags);
+    } /* end if */
+
+    if(HDfstat(fd, &sb) < 0)
+        HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, NULL, "unable to fstat file")
+
+    /* Create the new file struct */
+    if(NULL == (file = H5FL_CALLOC(H5FD_async_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate file struct")
+
+    file->fd = fd;
+    H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
+    file->device = sb.st_dev;
+    file->inode = sb.st_ino;
+    file->fa.queue_depth = fa->queue_depth;
+    file->fa.engine = H5FD_ASYNC_ENGINE_SYNC;
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+    file->ring.fd = -1;
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+
+    /* Retain a copy of the name used to open the file, for possible error reporting */
+    HDstrncpy(file->filename, name, sizeof(file->filename));
+    file->filename[sizeof(file->filename) - 1] = '\0';
+
+    /* Allocate the operation slots, all free */
+    if(NULL == (file->ops = (H5FD_async_op_t *)H5MM_calloc(file->fa.queue_depth * sizeof(H5FD_async_op_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate operation slots")
+    if(NULL == (file->free_ops = (unsigned *)H5MM_malloc(file->fa.queue_depth * sizeof(unsigned))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate operation slots")
+    if(NULL == (file->done = (H5FD_async_done_t *)H5MM_malloc(file->fa.queue_depth * sizeof(H5FD_async_done_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate completion list")
+    for(u = 0; u < file->fa.queue_depth; u++)
+        file->free_ops[u] = file->fa.queue_depth - u - 1;
+    file->nfree = file->fa.queue_depth;
+
+    /* Set up the engine */
+    if(H5FD_async_engine_open(file, fa->engine) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, NULL, "unable to set up I/O engine")
+
+    /* Set return value */
+    ret_value = (H5FD_t*)file;
+
+done:
+    if(NULL == ret_value) {
+        if(fd >= 0)
+            HDclose(fd);
+        if(file) {
+            H5MM_xfree(file->ops);
+            H5MM_xfree(file->free_ops);
+            H5MM_xfree(file->done);
+            file = H5FL_FREE(H5FD_async_t, file);
+        } /* end if */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_open() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_close
+ *
+ * Purpose:     Closes an HDF5 file, and tears down its engine.
+ *
+ * Return:      Success:    SUCCEED
+ *              Failure:    FAIL, file not closed.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_close(H5FD_t *_file)
+{
+    H5FD_async_t    *file = (H5FD_async_t *)_file;
+    herr_t          ret_value = SUCCEED;                /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check */
+    HDassert(file);
+
+    /* Tear down the engine */
+    H5FD_async_engine_close(file);
+
+    /* Close the underlying file */
+    if(HDclose(file->fd) < 0)
+        HSYS_GOTO_ERROR(H5E_IO, H5E_CANTCLOSEFILE, FAIL, "unable to close file")
+
+    /* Release the file info */
+    H5MM_xfree(file->ops);
+    H5MM_xfree(file->free_ops);
+    H5MM_xfree(file->done);
+    file = H5FL_FREE(H5FD_async_t, file);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_close() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_cmp
+ *
+ * Purpose:     Compares two files belonging to this driver using an
+ *              arbitrary (but consistent) ordering.
+ *
+ * Return:      Success:    A value like strcmp()
+ *              Failure:    never fails (arguments were checked by the
+ *                          caller).
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5FD_async_cmp(const H5FD_t *_f1, const H5FD_t *_f2)
+{
+    const H5FD_async_t  *f1 = (const H5FD_async_t *)_f1;
+    const H5FD_async_t  *f2 = (const H5FD_async_t *)_f2;
+    int ret_value = 0;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5_DEV_T_IS_SCALAR
+    if(f1->device < f2->device) HGOTO_DONE(-1)
+    if(f1->device > f2->device) HGOTO_DONE(1)
+#else /* H5_DEV_T_IS_SCALAR */
+    /* If dev_t isn't a scalar value on this system, just use memcmp to
+     * determine if the values are the same or not.  The actual return value
+     * shouldn't really matter...
+     */
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) < 0) HGOTO_DONE(-1)
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) > 0) HGOTO_DONE(1)
+#endif /* H5_DEV_T_IS_SCALAR */
+    if(f1->inode < f2->inode) HGOTO_DONE(-1)
+    if(f1->inode > f2->inode) HGOTO_DONE(1)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_query
+ *
+ * Purpose:     Set the flags that this VFL driver is capable of supporting.
+ *              (listed in H5FDpublic.h)
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_query(const H5FD_t H5_ATTR_UNUSED *_file, unsigned long *flags /* out */)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Set the VFL feature flags that this driver supports */
+    if(flags) {
+        *flags = 0;
+        *flags |= H5FD_FEAT_AGGREGATE_METADATA;     /* OK to aggregate metadata allocations                             */
+        *flags |= H5FD_FEAT_ACCUMULATE_METADATA;    /* OK to accumulate metadata for faster writes                      */
+        *flags |= H5FD_FEAT_DATA_SIEVE;             /* OK to perform data sieving for faster raw data reads & writes    */
+        *flags |= H5FD_FEAT_AGGREGATE_SMALLDATA;    /* OK to aggregate "small" raw data allocations                     */
+        *flags |= H5FD_FEAT_POSIX_COMPAT_HANDLE;    /* VFD handle is POSIX I/O call compatible                          */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_async_query() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_get_eoa
+ *
+ * Purpose:     Gets the end-of-address marker for the file. The EOA marker
+ *              is the first address past the last byte allocated in the
+ *              format address space.
+ *
+ * Return:      The end-of-address marker.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_async_get_eoa(const H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type)
+{
+    const H5FD_async_t  *file = (const H5FD_async_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eoa)
+} /* end H5FD_async_get_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_set_eoa
+ *
+ * Purpose:     Set the end-of-address marker for the file. This function is
+ *              called shortly after an existing HDF5 file is opened in order
+ *              to tell the driver where the end of the HDF5 data is located.
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_set_eoa(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, haddr_t addr)
+{
+    H5FD_async_t    *file = (H5FD_async_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    file->eoa = addr;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_async_set_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_get_eof
+ *
+ * Purpose:     Returns the end-of-file marker, the current size of the
+ *              filesystem file.
+ *
+ * Return:      End of file address, the first address past the end of the
+ *              filesystem file.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_async_get_eof(const H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type)
+{
+    const H5FD_async_t  *file = (const H5FD_async_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eof)
+} /* end H5FD_async_get_eof() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_get_handle
+ *
+ * Purpose:     Returns the file handle of async file driver.
+ *
+ * Returns:     SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_get_handle(H5FD_t *_file, hid_t H5_ATTR_UNUSED fapl, void **file_handle)
+{
+    H5FD_async_t    *file = (H5FD_async_t *)_file;
+    herr_t          ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(!file_handle)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "file handle not valid")
+
+    *file_handle = &(file->fd);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_get_handle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_read
+ *
+ * Purpose:     Reads SIZE bytes of data from FILE beginning at address ADDR
+ *              into buffer BUF according to data transfer properties in
+ *              DXPL_ID.  A single read gains nothing from the queue, and
+ *              is made with pread().
+ *
+ * Return:      Success:    SUCCEED. Result is stored in caller-supplied
+ *                          buffer BUF.
+ *              Failure:    FAIL, Contents of buffer BUF are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUSED dxpl_id,
+    haddr_t addr, size_t size, void *buf /*out*/)
+{
+    H5FD_async_t    *file       = (H5FD_async_t *)_file;
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(buf);
+
+    /* Check for overflow conditions */
+    if(!H5F_addr_defined(addr))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+    if(REGION_OVERFLOW(addr, size))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
+
+    /* Read data, being careful of interrupted system calls, partial results,
+     * and the end of the file.
+     */
+    while(size > 0) {
+        h5_posix_io_t       bytes_in        = 0;    /* # of bytes to read       */
+        h5_posix_io_ret_t   bytes_read      = -1;   /* # of bytes actually read */
+
+        /* Trying to read more bytes than the return type can handle is
+         * undefined behavior in POSIX.
+         */
+        if(size > H5_POSIX_MAX_IO_BYTES)
+            bytes_in = H5_POSIX_MAX_IO_BYTES;
+        else
+            bytes_in = (h5_posix_io_t)size;
+
+        do {
+            bytes_read = HDpread(file->fd, buf, bytes_in, (HDoff_t)addr);
+        } while(-1 == bytes_read && EINTR == errno);
+
+        if(-1 == bytes_read) { /* error */
+            int myerrno = errno;
+            time_t mytime = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total read size = %llu, bytes this sub-read = %llu, bytes actually read = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_read, (unsigned long long)addr);
+        } /* end if */
+
+        if(0 == bytes_read) {
+            /* end of file but not end of format address space */
+            HDmemset(buf, 0, size);
+            break;
+        } /* end if */
+
+        HDassert(bytes_read >= 0);
+        HDassert((size_t)bytes_read <= size);
+
+        size -= (size_t)bytes_read;
+        addr += (haddr_t)bytes_read;
+        buf = (char *)buf + bytes_read;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_write
+ *
+ * Purpose:     Writes SIZE bytes of data to FILE beginning at address ADDR
+ *              from buffer BUF according to data transfer properties in
+ *              DXPL_ID.  A single write is made with pwrite().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUSED dxpl_id,
+                haddr_t addr, size_t size, const void *buf)
+{
+    H5FD_async_t    *file       = (H5FD_async_t *)_file;
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(buf);
+
+    /* Check for overflow conditions */
+    if(!H5F_addr_defined(addr))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+    if(REGION_OVERFLOW(addr, size))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addr, (unsigned long long)size)
+
+    /* Write the data, being careful of interrupted system calls and partial
+     * results
+     */
+    while(size > 0) {
+        h5_posix_io_t       bytes_in        = 0;    /* # of bytes to write  */
+        h5_posix_io_ret_t   bytes_wrote     = -1;   /* # of bytes written   */
+
+        /* Trying to write more bytes than the return type can handle is
+         * undefined behavior in POSIX.
+         */
+        if(size > H5_POSIX_MAX_IO_BYTES)
+            bytes_in = H5_POSIX_MAX_IO_BYTES;
+        else
+            bytes_in = (h5_posix_io_t)size;
+
+        do {
+            bytes_wrote = HDpwrite(file->fd, buf, bytes_in, (HDoff_t)addr);
+        } while(-1 == bytes_wrote && EINTR == errno);
+
+        if(-1 == bytes_wrote) { /* error */
+            int myerrno = errno;
+            time_t mytime = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total write size = %llu, bytes this sub-write = %llu, bytes actually written = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_wrote, (unsigned long long)addr);
+        } /* end if */
+
+        HDassert(bytes_wrote > 0);
+        HDassert((size_t)bytes_wrote <= size);
+
+        size -= (size_t)bytes_wrote;
+        addr += (haddr_t)bytes_wrote;
+        buf = (const char *)buf + bytes_wrote;
+    } /* end while */
+
+    /* Update eof */
+    if(addr > file->eof)
+        file->eof = addr;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_truncate
+ *
+ * Purpose:     Makes sure that the true file size is the same (or larger)
+ *              than the end-of-address.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_truncate(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATTR_UNUSED closing)
+{
+    H5FD_async_t    *file = (H5FD_async_t *)_file;
+    herr_t          ret_value = SUCCEED;                 /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    /* Extend the file to make sure it's large enough */
+    if(!H5F_addr_eq(file->eoa, file->eof)) {
+        if(-1 == HDftruncate(file->fd, (HDoff_t)file->eoa))
+            HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to extend file properly")
+
+        /* Update the eof value */
+        file->eof = file->eoa;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_truncate() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_lock
+ *
+ * Purpose:     To place an advisory lock on a file.
+ *		The lock type to apply depends on the parameter "rw":
+ *			TRUE--opens for write: an exclusive lock
+ *			FALSE--opens for read: a shared lock
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_lock(H5FD_t *_file, hbool_t rw)
+{
+    H5FD_async_t    *file = (H5FD_async_t *)_file;  /* VFD file struct */
+    int             lock;                           /* The type of lock */
+    herr_t          ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    /* Determine the type of lock */
+    lock = rw ? LOCK_EX : LOCK_SH;
+
+    /* Place the lock with non-blocking */
+    if(HDflock(file->fd, lock | LOCK_NB) < 0)
+        HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "unable to flock file")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_lock() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_unlock
+ *
+ * Purpose:     To remove the existing lock on the file
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_unlock(H5FD_t *_file)
+{
+    H5FD_async_t    *file = (H5FD_async_t *)_file;  /* VFD file struct */
+    herr_t          ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    if(HDflock(file->fd, LOCK_UN) < 0)
+        HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "unable to flock (unlock) file")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_unlock() */
+
+
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_uring_setup
+ *
+ * Purpose:     Creates an io_uring instance with room for the queue depth
+ *              of FILE, and maps its rings.  On failure, what was set up
+ *              is left for H5FD_async_uring_teardown() to undo.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_uring_setup(H5FD_async_t *file)
+{
+    H5FD_async_uring_t      *ring = &file->ring;
+    struct io_uring_params  params;
+    void                    *map;
+    herr_t                  ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDmemset(&params, 0, sizeof(params));
+    if((ring->fd = (int)syscall(__NR_io_uring_setup, file->fa.queue_depth, &params)) < 0)
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to set up io_uring")
+
+    /* Map the rings, which share one mapping on kernels that allow it */
+    ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+#ifdef IORING_FEAT_SINGLE_MMAP
+    /* Headers older than Linux 5.4 have neither the flag nor params.features */
+    if(params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sq_map_size = MAX(ring->sq_map_size, ring->cq_map_size);
+        ring->cq_map_size = ring->sq_map_size;
+    } /* end if */
+#endif /* IORING_FEAT_SINGLE_MMAP */
+    if(MAP_FAILED == (map = HDmmap(NULL, ring->sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, (HDoff_t)IORING_OFF_SQ_RING)))
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission ring")
+    ring->sq_map = map;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    if(params.features & IORING_FEAT_SINGLE_MMAP)
+        ring->cq_map = ring->sq_map;
+    else
+#endif /* IORING_FEAT_SINGLE_MMAP */
+    {
+        if(MAP_FAILED == (map = HDmmap(NULL, ring->cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, (HDoff_t)IORING_OFF_CQ_RING)))
+            HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring completion ring")
+        ring->cq_map = map;
+    } /* end else */
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    if(MAP_FAILED == (map = HDmmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, (HDoff_t)IORING_OFF_SQES)))
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission queue entries")
+    ring->sqes = (struct io_uring_sqe *)map;
+
+    ring->sq_head = (unsigned *)((char *)ring->sq_map + params.sq_off.head);
+    ring->sq_tail = (unsigned *)((char *)ring->sq_map + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)((char *)ring->sq_map + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)((char *)ring->sq_map + params.sq_off.array);
+    ring->cq_head = (unsigned *)((char *)ring->cq_map + params.cq_off.head);
+    ring->cq_tail = (unsigned *)((char *)ring->cq_map + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)((char *)ring->cq_map + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)((char *)ring->cq_map + params.cq_off.cqes);
+    ring->nqueued = 0;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_uring_setup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_uring_teardown
+ *
+ * Purpose:     Unmaps the rings of FILE's io_uring instance and closes it.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_async_uring_teardown(H5FD_async_t *file)
+{
+    H5FD_async_uring_t  *ring = &file->ring;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(ring->sqes)
+        HDmunmap(ring->sqes, ring->sqes_size);
+    if(ring->cq_map && ring->cq_map != ring->sq_map)
+        HDmunmap(ring->cq_map, ring->cq_map_size);
+    if(ring->sq_map)
+        HDmunmap(ring->sq_map, ring->sq_map_size);
+    if(ring->fd >= 0)
+        HDclose(ring->fd);
+    HDmemset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_async_uring_teardown() */
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+
+
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_aio_setup
+ *
+ * Purpose:     Creates a native AIO context with room for the queue depth
+ *              of FILE, and its control blocks.  On failure, what was set
+ *              up is left for H5FD_async_aio_teardown() to undo.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_aio_setup(H5FD_async_t *file)
+{
+    H5FD_async_aio_t    *aio = &file->aio;
+    unsigned            depth = file->fa.queue_depth;
+    herr_t              ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(NULL == (aio->iocbs = (struct iocb *)H5MM_calloc(depth * sizeof(struct iocb))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate AIO control blocks")
+    if(NULL == (aio->pending = (struct iocb **)H5MM_malloc(depth * sizeof(struct iocb *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate AIO control blocks")
+    if(NULL == (aio->events = (struct io_event *)H5MM_malloc(depth * sizeof(struct io_event))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate AIO events")
+
+    aio->ctx = 0;
+    if(syscall(__NR_io_setup, depth, &aio->ctx) < 0) {
+        aio->ctx = 0;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to set up AIO context")
+    } /* end if */
+    aio->npending = 0;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_aio_setup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_aio_teardown
+ *
+ * Purpose:     Destroys FILE's native AIO context, which waits for any
+ *              operations still in flight, and frees its control blocks.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_async_aio_teardown(H5FD_async_t *file)
+{
+    H5FD_async_aio_t    *aio = &file->aio;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(aio->ctx)
+        (void)syscall(__NR_io_destroy, aio->ctx);
+    H5MM_xfree(aio->iocbs);
+    H5MM_xfree(aio->pending);
+    H5MM_xfree(aio->events);
+    HDmemset(aio, 0, sizeof(*aio));
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_async_aio_teardown() */
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_engine_open
+ *
+ * Purpose:     Sets up ENGINE for FILE.  The default engine is the first
+ *              of io_uring and native AIO that can be set up, or else
+ *              pread()/pwrite(); an engine named explicitly must be set
+ *              up, or opening the file fails.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_engine_open(H5FD_async_t *file, H5FD_async_engine_t engine)
+{
+    herr_t      status;                     /* Status of one engine's setup */
+    herr_t      ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Try the kernel interfaces quietly if the engine wasn't named */
+    switch(engine) {
+        case H5FD_ASYNC_ENGINE_DEFAULT:
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+            H5E_BEGIN_TRY {
+                status = H5FD_async_uring_setup(file);
+            } H5E_END_TRY;
+            if(status >= 0) {
+                file->fa.engine = H5FD_ASYNC_ENGINE_IO_URING;
+                break;
+            } /* end if */
+            H5FD_async_uring_teardown(file);
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+            H5E_BEGIN_TRY {
+                status = H5FD_async_aio_setup(file);
+            } H5E_END_TRY;
+            if(status >= 0) {
+                file->fa.engine = H5FD_ASYNC_ENGINE_LINUX_AIO;
+                break;
+            } /* end if */
+            H5FD_async_aio_teardown(file);
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+            file->fa.engine = H5FD_ASYNC_ENGINE_SYNC;
+            break;
+
+        case H5FD_ASYNC_ENGINE_IO_URING:
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+            if((status = H5FD_async_uring_setup(file)) < 0) {
+                H5FD_async_uring_teardown(file);
+                HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "io_uring is not available")
+            } /* end if */
+            file->fa.engine = H5FD_ASYNC_ENGINE_IO_URING;
+            break;
+#else /* H5FD_ASYNC_HAVE_IO_URING */
+            HGOTO_ERROR(H5E_VFL, H5E_UNSUPPORTED, FAIL, "io_uring support is not built")
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+
+        case H5FD_ASYNC_ENGINE_LINUX_AIO:
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+            if((status = H5FD_async_aio_setup(file)) < 0) {
+                H5FD_async_aio_teardown(file);
+                HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "native AIO is not available")
+            } /* end if */
+            file->fa.engine = H5FD_ASYNC_ENGINE_LINUX_AIO;
+            break;
+#else /* H5FD_ASYNC_HAVE_LINUX_AIO */
+            HGOTO_ERROR(H5E_VFL, H5E_UNSUPPORTED, FAIL, "native AIO support is not built")
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+
+        case H5FD_ASYNC_ENGINE_SYNC:
+            file->fa.engine = H5FD_ASYNC_ENGINE_SYNC;
+            break;
+
+        case H5FD_ASYNC_ENGINE_ERROR:
+        default:
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid engine")
+    } /* end switch */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_engine_open() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_engine_close
+ *
+ * Purpose:     Tears down FILE's engine, leaving it using pread() and
+ *              pwrite().
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_async_engine_close(H5FD_async_t *file)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+    if(H5FD_ASYNC_ENGINE_IO_URING == file->fa.engine)
+        H5FD_async_uring_teardown(file);
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+    if(H5FD_ASYNC_ENGINE_LINUX_AIO == file->fa.engine)
+        H5FD_async_aio_teardown(file);
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+    file->fa.engine = H5FD_ASYNC_ENGINE_SYNC;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_async_engine_close() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_queue
+ *
+ * Purpose:     Queues the operation in slot SLOT of FILE on its engine,
+ *              to be submitted by the next H5FD_async_submit().
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_async_queue(H5FD_async_t *file, unsigned slot, hbool_t writing)
+{
+    H5FD_async_op_t     *op = &file->ops[slot];
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+    if(H5FD_ASYNC_ENGINE_IO_URING == file->fa.engine) {
+        H5FD_async_uring_t  *ring = &file->ring;
+        unsigned            tail = *ring->sq_tail;
+        unsigned            idx = tail & *ring->sq_mask;
+        struct io_uring_sqe *sqe = &ring->sqes[idx];
+
+        /* A write's buffer is only read by the kernel */
+        op->iov.iov_base = writing ? (void *)(uintptr_t)op->wbuf : op->rbuf;
+        op->iov.iov_len = op->size;
+        HDmemset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = (uint8_t)(writing ? IORING_OP_WRITEV : IORING_OP_READV);
+        sqe->fd = file->fd;
+        sqe->off = (uint64_t)op->addr;
+        sqe->addr = (uint64_t)(uintptr_t)&op->iov;
+        sqe->len = 1;
+        sqe->user_data = (uint64_t)slot;
+        ring->sq_array[idx] = idx;
+        H5FD_ASYNC_STORE_RELEASE(ring->sq_tail, tail + 1);
+        ring->nqueued++;
+    } /* end if */
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+    if(H5FD_ASYNC_ENGINE_LINUX_AIO == file->fa.engine) {
+        H5FD_async_aio_t    *aio = &file->aio;
+        struct iocb         *iocb = &aio->iocbs[slot];
+
+        HDmemset(iocb, 0, sizeof(*iocb));
+        iocb->aio_data = (uint64_t)slot;
+        iocb->aio_lio_opcode = (uint16_t)(writing ? IOCB_CMD_PWRITE : IOCB_CMD_PREAD);
+        iocb->aio_fildes = (uint32_t)file->fd;
+        iocb->aio_buf = (uint64_t)(uintptr_t)(writing ? op->wbuf : op->rbuf);
+        iocb->aio_nbytes = (uint64_t)op->size;
+        iocb->aio_offset = (int64_t)op->addr;
+        aio->pending[aio->npending++] = iocb;
+    } /* end if */
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_async_queue() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_submit
+ *
+ * Purpose:     Submits the operations queued on FILE's engine, and waits
+ *              for at least one of the INFLIGHT operations submitted or
+ *              queued to finish.  The operations that have finished are
+ *              added to FILE's completion list.
+ *
+ *              The kernel may take only some of the operations queued;
+ *              the rest stay queued for the next call, which then waits
+ *              only if something is in flight.  On failure, operations
+ *              still queued are left for H5FD_async_drop().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_submit(H5FD_async_t *file, unsigned inflight)
+{
+    herr_t      ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+    if(H5FD_ASYNC_ENGINE_IO_URING == file->fa.engine) {
+        H5FD_async_uring_t  *ring = &file->ring;
+        unsigned            to_submit = ring->nqueued;
+        unsigned            head, tail;
+        long                ret;
+
+        /* Submit the entries queued and wait for a completion with one
+         * system call.  The kernel skips the wait when it takes only some
+         * of the entries.
+         */
+        do {
+            ret = syscall(__NR_io_uring_enter, ring->fd, to_submit, 1U, IORING_ENTER_GETEVENTS, NULL, (size_t)0);
+        } while(ret < 0 && EINTR == errno);
+        if(ret < 0 && (EAGAIN == errno || EBUSY == errno) && inflight > to_submit) {
+            /* Out of kernel resources: wait for what's in flight instead */
+            do {
+                ret = syscall(__NR_io_uring_enter, ring->fd, 0U, 1U, IORING_ENTER_GETEVENTS, NULL, (size_t)0);
+            } while(ret < 0 && EINTR == errno);
+        } /* end if */
+        if(ret < 0) {
+            int myerrno = errno;
+
+            HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "io_uring_enter failed: filename = '%s', errno = %d, error message = '%s', operations queued = %u", file->filename, myerrno, HDstrerror(myerrno), to_submit)
+        } /* end if */
+        ring->nqueued -= (unsigned)MIN((unsigned long)ret, (unsigned long)to_submit);
+
+        /* Reap the completions */
+        head = *ring->cq_head;
+        tail = H5FD_ASYNC_LOAD_ACQUIRE(ring->cq_tail);
+        while(head != tail) {
+            const struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+
+            HDassert(file->ndone < file->fa.queue_depth);
+            file->done[file->ndone].slot = (unsigned)cqe->user_data;
+            file->done[file->ndone].res = (long)cqe->res;
+            file->ndone++;
+            head++;
+        } /* end while */
+        H5FD_ASYNC_STORE_RELEASE(ring->cq_head, head);
+    } /* end if */
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+    if(H5FD_ASYNC_ENGINE_LINUX_AIO == file->fa.engine) {
+        H5FD_async_aio_t    *aio = &file->aio;
+        long                ret;
+        long                u;
+
+        /* Submit the control blocks pending */
+        if(aio->npending > 0) {
+            do {
+                ret = syscall(__NR_io_submit, aio->ctx, (long)aio->npending, aio->pending);
+            } while(ret < 0 && EINTR == errno);
+            if(ret < 0 && !(EAGAIN == errno && inflight > aio->npending)) {
+                int myerrno = errno;
+
+                HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "io_submit failed: filename = '%s', errno = %d, error message = '%s', operations queued = %u", file->filename, myerrno, HDstrerror(myerrno), aio->npending)
+            } /* end if */
+            if(ret > 0) {
+                aio->npending -= (unsigned)ret;
+                HDmemmove(aio->pending, aio->pending + ret, aio->npending * sizeof(struct iocb *));
+            } /* end if */
+        } /* end if */
+
+        /* Wait for at least one of the operations submitted */
+        if(inflight > aio->npending) {
+            do {
+                ret = syscall(__NR_io_getevents, aio->ctx, 1L, (long)file->fa.queue_depth, aio->events, NULL);
+            } while(ret < 0 && EINTR == errno);
+            if(ret < 0)
+                HSYS_GOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "io_getevents failed")
+            for(u = 0; u < ret; u++) {
+                HDassert(file->ndone < file->fa.queue_depth);
+                file->done[file->ndone].slot = (unsigned)aio->events[u].data;
+                file->done[file->ndone].res = (long)aio->events[u].res;
+                file->ndone++;
+            } /* end for */
+        } /* end if */
+    } /* end if */
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_submit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_drop
+ *
+ * Purpose:     Drops the operations queued on FILE's engine that were
+ *              never submitted, freeing their slots.
+ *
+ * Return:      The number of operations dropped
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5FD_async_drop(H5FD_async_t *file)
+{
+    unsigned    ndropped = 0;               /* # of operations dropped */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5FD_ASYNC_HAVE_IO_URING
+    if(H5FD_ASYNC_ENGINE_IO_URING == file->fa.engine) {
+        H5FD_async_uring_t  *ring = &file->ring;
+
+        /* The kernel hasn't looked at the entries yet, so taking back the
+         * tail takes them back
+         */
+        while(ring->nqueued > 0) {
+            unsigned tail = *ring->sq_tail - 1;
+            unsigned slot = (unsigned)ring->sqes[tail & *ring->sq_mask].user_data;
+
+            H5FD_ASYNC_STORE_RELEASE(ring->sq_tail, tail);
+            file->ops[slot].size = 0;
+            file->free_ops[file->nfree++] = slot;
+            ring->nqueued--;
+            ndropped++;
+        } /* end while */
+    } /* end if */
+#endif /* H5FD_ASYNC_HAVE_IO_URING */
+#ifdef H5FD_ASYNC_HAVE_LINUX_AIO
+    if(H5FD_ASYNC_ENGINE_LINUX_AIO == file->fa.engine) {
+        H5FD_async_aio_t    *aio = &file->aio;
+
+        while(aio->npending > 0) {
+            unsigned slot = (unsigned)aio->pending[--aio->npending]->aio_data;
+
+            file->ops[slot].size = 0;
+            file->free_ops[file->nfree++] = slot;
+            ndropped++;
+        } /* end while */
+    } /* end if */
+#endif /* H5FD_ASYNC_HAVE_LINUX_AIO */
+
+    FUNC_LEAVE_NOAPI(ndropped)
+} /* end H5FD_async_drop() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_xfer
+ *
+ * Purpose:     Reads the COUNT pieces of a vector request into RBUFS, or
+ *              writes them from WBUFS, through FILE's engine.  The queue is
+ *              kept full: whenever operations finish, more pieces are
+ *              queued in their slots, and one system call submits them and
+ *              waits for the next to finish.
+ *
+ *              A piece the kernel moves only part of (a read at the end of
+ *              the file, say) is finished with H5FD_async_read() or
+ *              H5FD_async_write().  A piece written over the area of a
+ *              write still in flight waits for it, so that the later
+ *              write lands last.  After a failure no more pieces are
+ *              queued, but those in flight are waited for: none is left
+ *              writing to or reading from the caller's buffers when this
+ *              returns.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_xfer(H5FD_async_t *file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *rbufs[], const void *wbufs[])
+{
+    hbool_t     writing = (NULL != wbufs);  /* Whether the request writes */
+    size_t      next = 0;                   /* Next piece to queue */
+    unsigned    inflight = 0;               /* # of operations queued or submitted */
+    haddr_t     hiwater = 0;                /* End of the pieces queued so far */
+    hbool_t     failed = FALSE;             /* Whether any piece failed */
+    int         op_errno = 0;               /* errno of the first failed operation */
+    haddr_t     op_addr = HADDR_UNDEF;      /* Address of the first failed operation */
+    size_t      op_size = 0;                /* Size of the first failed operation */
+    size_t      u;                          /* Local index variable */
+    herr_t      ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+    HDassert(H5FD_ASYNC_ENGINE_IO_URING == file->fa.engine || H5FD_ASYNC_ENGINE_LINUX_AIO == file->fa.engine);
+    HDassert(file->nfree == file->fa.queue_depth && 0 == file->ndone);
+
+    /* Check all the pieces before any is submitted */
+    for(u = 0; u < count; u++) {
+        if(!H5F_addr_defined(addrs[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+        if(REGION_OVERFLOW(addrs[u], sizes[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addrs[u], (unsigned long long)sizes[u])
+    } /* end for */
+
+    while(next < count || inflight > 0) {
+        unsigned    v;                      /* Local index variable */
+
+        /* Queue pieces while there are free slots */
+        while(!failed && next < count && file->nfree > 0) {
+            H5FD_async_op_t *op;
+            unsigned        slot;
+
+            if(0 == sizes[next]) {
+                next++;
+                continue;
+            } /* end if */
+
+            /* A write over a write in flight waits for it */
+            if(writing && addrs[next] < hiwater && inflight > 0) {
+                hbool_t overlaps = FALSE;
+
+                for(slot = 0; slot < file->fa.queue_depth; slot++)
+                    if(file->ops[slot].size > 0 && addrs[next] < file->ops[slot].addr + file->ops[slot].size
+                            && file->ops[slot].addr < addrs[next] + sizes[next]) {
+                        overlaps = TRUE;
+                        break;
+                    } /* end if */
+                if(overlaps)
+                    break;
+            } /* end if */
+
+            slot = file->free_ops[--file->nfree];
+            op = &file->ops[slot];
+            op->type = types[next];
+            op->addr = addrs[next];
+            op->size = sizes[next];
+            if(writing)
+                op->wbuf = wbufs[next];
+            else
+                op->rbuf = rbufs[next];
+            H5FD_async_queue(file, slot, writing);
+            hiwater = MAX(hiwater, op->addr + op->size);
+            inflight++;
+            next++;
+        } /* end while */
+        if(failed)
+            next = count;
+        if(0 == inflight)
+            continue;
+
+        /* Submit the pieces queued, and wait for some to finish */
+        if(H5FD_async_submit(file, inflight) < 0) {
+            unsigned ndropped = H5FD_async_drop(file);
+
+            failed = TRUE;
+            inflight -= ndropped;
+            if(0 == ndropped) {
+                /* Waiting itself failed: tearing the engine down is the
+                 * only way left to wait for what's in flight
+                 */
+                H5FD_async_engine_close(file);
+                for(v = 0; v < file->fa.queue_depth; v++) {
+                    file->ops[v].size = 0;
+                    file->free_ops[v] = v;
+                } /* end for */
+                file->nfree = file->fa.queue_depth;
+                file->ndone = 0;
+                inflight = 0;
+            } /* end if */
+            continue;
+        } /* end if */
+
+        /* Retire the operations that finished */
+        for(v = 0; v < file->ndone; v++) {
+            H5FD_async_op_t *op = &file->ops[file->done[v].slot];
+            long            res = file->done[v].res;
+
+            HDassert(op->size > 0);
+            if(-EAGAIN == res || -EINTR == res)
+                res = 0;
+            if(res < 0) {
+                if(!failed) {
+                    op_errno = (int)-res;
+                    op_addr = op->addr;
+                    op_size = op->size;
+                } /* end if */
+                failed = TRUE;
+            } /* end if */
+            else {
+                if(writing && op->addr + (haddr_t)res > file->eof)
+                    file->eof = op->addr + (haddr_t)res;
+
+                /* Finish a piece the kernel moved only part of */
+                if((size_t)res < op->size && !failed) {
+                    if(writing) {
+                        if(H5FD_async_write((H5FD_t *)file, op->type, dxpl_id, op->addr + (haddr_t)res, op->size - (size_t)res, (const char *)op->wbuf + res) < 0)
+                            failed = TRUE;
+                    } /* end if */
+                    else {
+                        if(H5FD_async_read((H5FD_t *)file, op->type, dxpl_id, op->addr + (haddr_t)res, op->size - (size_t)res, (char *)op->rbuf + res) < 0)
+                            failed = TRUE;
+                    } /* end else */
+                } /* end if */
+            } /* end else */
+
+            op->size = 0;
+            file->free_ops[file->nfree++] = file->done[v].slot;
+            inflight--;
+        } /* end for */
+        file->ndone = 0;
+    } /* end while */
+
+    if(failed) {
+        if(op_errno) {
+            time_t mytime = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, writing ? H5E_WRITEERROR : H5E_READERROR, FAIL, "file vector %s failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', size = %llu, offset = %llu", writing ? "write" : "read", HDctime(&mytime), file->filename, file->fd, op_errno, HDstrerror(op_errno), (unsigned long long)op_size, (unsigned long long)op_addr)
+        } /* end if */
+        else
+            HGOTO_ERROR(H5E_IO, writing ? H5E_WRITEERROR : H5E_READERROR, FAIL, "file vector %s failed", writing ? "write" : "read")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_xfer() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_read_vector
+ *
+ * Purpose:     Reads the COUNT pieces of a vector read request from FILE
+ *              into the buffers BUFS, keeping up to the queue depth of
+ *              them outstanding at once.  Without an asynchronous engine,
+ *              the pieces are read one at a time.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[])
+{
+    H5FD_async_t    *file = (H5FD_async_t *)_file;
+    size_t          u;                          /* Local index variable */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    if(H5FD_ASYNC_ENGINE_SYNC == file->fa.engine || count < 2) {
+        for(u = 0; u < count; u++)
+            if(H5FD_async_read(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+    } /* end if */
+    else if(H5FD_async_xfer(file, dxpl_id, count, types, addrs, sizes, bufs, NULL) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file vector read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_async_write_vector
+ *
+ * Purpose:     Writes the COUNT pieces of a vector write request to FILE
+ *              from the buffers BUFS, keeping up to the queue depth of
+ *              them outstanding at once.  Without an asynchronous engine,
+ *              the pieces are written one at a time.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_async_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    H5FD_async_t    *file = (H5FD_async_t *)_file;
+    size_t          u;                          /* Local index variable */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    if(H5FD_ASYNC_ENGINE_SYNC == file->fa.engine || count < 2) {
+        for(u = 0; u < count; u++)
+            if(H5FD_async_write(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+    } /* end if */
+    else if(H5FD_async_xfer(file, dxpl_id, count, types, addrs, sizes, NULL, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_async_write_vector() */
+
+#endif /* H5_HAVE_ASYNC_VFD */
@@ -0,0 +1,60 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	The public header file for the async driver.
+ */
+#ifndef H5FDasync_H
+#define H5FDasync_H
+
+#ifdef H5_HAVE_ASYNC_VFD
+#       define H5FD_ASYNC	(H5FD_async_init())
+#else
+#       define H5FD_ASYNC       (-1)
+#endif /* H5_HAVE_ASYNC_VFD */
+
+/* The kernel interfaces the async driver can submit I/O through */
+typedef enum H5FD_async_engine_t {
+    H5FD_ASYNC_ENGINE_ERROR = -1,
+    H5FD_ASYNC_ENGINE_DEFAULT = 0,      /* The first of the others that works */
+    H5FD_ASYNC_ENGINE_IO_URING = 1,     /* io_uring                         */
+    H5FD_ASYNC_ENGINE_LINUX_AIO = 2,    /* Linux native AIO                 */
+    H5FD_ASYNC_ENGINE_SYNC = 3          /* pread()/pwrite(), one at a time  */
+} H5FD_async_engine_t;
+
+/* Default number of reads or writes the async driver keeps outstanding */
+#define H5FD_ASYNC_QUEUE_DEPTH_DEF      64
+
+/* Largest queue depth the async driver accepts */
+#define H5FD_ASYNC_QUEUE_DEPTH_MAX      4096
+
+#ifdef H5_HAVE_ASYNC_VFD
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+H5_DLL hid_t H5FD_async_init(void);
+H5_DLL herr_t H5Pset_fapl_async(hid_t fapl_id, unsigned queue_depth,
+    H5FD_async_engine_t engine);
+H5_DLL herr_t H5Pget_fapl_async(hid_t fapl_id, unsigned *queue_depth/*out*/,
+    H5FD_async_engine_t *engine/*out*/);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H5_HAVE_ASYNC_VFD */
+
+#endif
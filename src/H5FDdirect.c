@@ -56,22 +56,16 @@ typedef struct H5FD_direct_fapl_t {
 /*
  * The description of a file belonging to this driver. The `eoa' and `eof'
  * determine the amount of hdf5 address space in use and the high-water mark
- * of the file (the current size of the underlying Unix file). The `pos'
- * value is used to eliminate file position updates when they would be a
- * no-op. Unfortunately we've found systems that use separate file position
- * indicators for reading and writing so the lseek can only be eliminated if
- * the current operation is the same as the previous operation.  When opening
- * a file the `eof' will be set to the current file size, `eoa' will be set
- * to zero, `pos' will be set to H5F_ADDR_UNDEF (as it is when an error
- * occurs), and `op' will be set to H5F_OP_UNKNOWN.
+ * of the file (the current size of the underlying Unix file). When opening
+ * a file the `eof' will be set to the current file size and `eoa' will be
+ * set to zero.  Reads and writes are positional (pread/pwrite, which every
+ * system with O_DIRECT has), so the driver keeps no file position.
  */
 typedef struct H5FD_direct_t {
     H5FD_t  pub;      /*public stuff, must be first  */
     int    fd;      /*the unix file      */
     haddr_t  eoa;      /*end of allocated region  */
     haddr_t  eof;      /*end of file; current file size*/
-    haddr_t  pos;      /*current file I/O position  */
-    int    op;      /*last operation    */
     H5FD_direct_fapl_t  fa;    /*file access properties  */
 #ifndef H5_HAVE_WIN32_API
     /*
@@ -173,7 +167,10 @@ static const H5FD_class_t H5FD_direct_g = {
     H5FD_direct_truncate,      	/*truncate    */
     H5FD_direct_lock,          	/*lock                  */
     H5FD_direct_unlock,        	/*unlock                */
-    H5FD_FLMAP_DICHOTOMY       	/*fl_map                */
+    H5FD_FLMAP_DICHOTOMY,       	/*fl_map                */
+    NULL,                              /*read_vector           */
+    NULL,                              /*write_vector          */
+    NULL                               /*advise                */
 };
 
 /* Declare a free list to manage the H5FD_direct_t struct */
@@ -507,8 +504,6 @@ H5FD_direct_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxadd
 
     file->fd = fd;
     H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
-    file->pos = HADDR_UNDEF;
-    file->op = OP_UNKNOWN;
 #ifdef H5_HAVE_WIN32_API
     filehandle = _get_osfhandle(fd);
     (void)GetFileInformationByHandle((HANDLE)filehandle, &fileinfo);
@@ -867,6 +862,7 @@ H5FD_direct_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UN
     size_t    _fbsize;
     size_t    _cbsize;
     haddr_t    read_size;              /* Size to read into copy buffer */
+    haddr_t    read_addr;              /* Address to read copy buffer from */
     size_t    copy_size = size;       /* Size remaining to read when using copy buffer */
     size_t              copy_offset;            /* Offset into copy buffer of the requested data */
 
@@ -898,15 +894,11 @@ H5FD_direct_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UN
      * and aligned data first, then copy the data into memory buffer.
      */
     if(!_must_align || ((addr%_fbsize==0) && (size%_fbsize==0) && ((size_t)buf%_boundary==0))) {
-      /* Seek to the correct location */
-      if ((addr!=file->pos || OP_READ!=file->op) &&
-        HDlseek(file->fd, (HDoff_t)addr, SEEK_SET)<0)
-    HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
        /* Read the aligned data in file first, being careful of interrupted
        * system calls and partial results. */
       while (size>0) {
     do {
-        nbytes = HDread(file->fd, buf, size);
+        nbytes = HDpread(file->fd, buf, size, (HDoff_t)addr);
     } while (-1==nbytes && EINTR==errno);
     if (-1==nbytes) /* error */
         HSYS_GOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
@@ -938,10 +930,8 @@ H5FD_direct_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UN
     HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "HDposix_memalign failed")
 
             /* look for the aligned position for reading the data */
-            HDassert(!(((addr / _fbsize) * _fbsize) % _fbsize));
-            if(HDlseek(file->fd, (HDoff_t)((addr / _fbsize) * _fbsize),
-                    SEEK_SET) < 0)
-                HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
+            read_addr = (addr / _fbsize) * _fbsize;
+            HDassert(!(read_addr % _fbsize));
 
       /*
        * Read the aligned data in file into aligned buffer first, then copy the data
@@ -966,11 +956,12 @@ H5FD_direct_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UN
 
                 HDassert(!(read_size % _fbsize));
         do {
-        nbytes = HDread(file->fd, copy_buf, read_size);
+        nbytes = HDpread(file->fd, copy_buf, read_size, (HDoff_t)read_addr);
         } while(-1==nbytes && EINTR==errno);
 
         if (-1==nbytes) /* error */
         HSYS_GOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+        read_addr += read_size;
 
         /* Copy the needed data from the copy buffer to the output
          * buffer, and update copy_size.  If the copy buffer does not
@@ -1001,19 +992,11 @@ H5FD_direct_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UN
             } /* end if */
     }
 
-    /* Update current position */
-    file->pos = addr;
-    file->op = OP_READ;
-
 done:
     if(ret_value<0) {
         /* Free with HDfree since it came from posix_memalign */
         if(copy_buf)
             HDfree(copy_buf);
-
-        /* Reset last file I/O information */
-        file->pos = HADDR_UNDEF;
-        file->op = OP_UNKNOWN;
     } /* end if */
 
     FUNC_LEAVE_NOAPI(ret_value)
@@ -1055,6 +1038,7 @@ H5FD_direct_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_U
     haddr_t             write_addr;             /* Address to write copy buffer */
     haddr_t             write_size;             /* Size to write from copy buffer */
     haddr_t             read_size;              /* Size to read into copy buffer */
+    haddr_t             read_addr = HADDR_UNDEF;        /* Address to read copy buffer from */
     size_t              copy_size = size;       /* Size remaining to write when using copy buffer */
     size_t              copy_offset;            /* Offset into copy buffer of the data to write */
 
@@ -1086,14 +1070,9 @@ H5FD_direct_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_U
      * first, update buffer with user data, then write the data out.
      */
     if(!_must_align || ((addr%_fbsize==0) && (size%_fbsize==0) && ((size_t)buf%_boundary==0))) {
-      /* Seek to the correct location */
-      if ((addr!=file->pos || OP_WRITE!=file->op) &&
-        HDlseek(file->fd, (HDoff_t)addr, SEEK_SET)<0)
-    HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
-
       while (size>0) {
     do {
-        nbytes = HDwrite(file->fd, buf, size);
+        nbytes = HDpwrite(file->fd, buf, size, (HDoff_t)addr);
     } while (-1==nbytes && EINTR==errno);
     if (-1==nbytes) /* error */
         HSYS_GOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
@@ -1123,10 +1102,6 @@ H5FD_direct_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_U
       if (HDposix_memalign(&copy_buf, _boundary, alloc_size) != 0)
     HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "HDposix_memalign failed")
 
-            /* look for the right position for reading or writing the data */
-            if(HDlseek(file->fd, (HDoff_t)write_addr, SEEK_SET) < 0)
-                HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
-
       p3 = buf;
       do {
                 /* Calculate how much data we have to write in this iteration
@@ -1149,6 +1124,7 @@ H5FD_direct_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_U
         HDmemset(copy_buf, 0, _fbsize);
 
                 if(copy_offset > 0) {
+                    read_addr = write_addr;
                     if((write_addr + write_size) > (addr + size)) {
                         HDassert((write_addr + write_size) - (addr + size) < _fbsize);
                         read_size = write_size;
@@ -1164,12 +1140,9 @@ H5FD_direct_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_U
                     read_size = _fbsize;
                     p1 = (unsigned char *)copy_buf + write_size - _fbsize;
 
-                    /* Seek to the last block, for reading */
-                    HDassert(!((write_addr + write_size - _fbsize) % _fbsize));
-                    if(HDlseek(file->fd,
-                            (HDoff_t)(write_addr + write_size - _fbsize),
-                            SEEK_SET) < 0)
-                        HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
+                    /* Read the last block */
+                    read_addr = write_addr + write_size - _fbsize;
+                    HDassert(!(read_addr % _fbsize));
                 } /* end if */
                 else
                     p1 = NULL;
@@ -1177,7 +1150,7 @@ H5FD_direct_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_U
                 if(p1) {
                     HDassert(!(read_size % _fbsize));
                     do {
-                        nbytes = HDread(file->fd, p1, read_size);
+                        nbytes = HDpread(file->fd, p1, read_size, (HDoff_t)read_addr);
                     } while (-1==nbytes && EINTR==errno);
 
                     if (-1==nbytes) /* error */
@@ -1202,10 +1175,8 @@ H5FD_direct_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_U
                     copy_offset = 0;
                 } /* end else */
 
-        /*look for the aligned position for writing the data*/
+        /*the aligned position for writing the data*/
         HDassert(!(write_addr % _fbsize));
-        if(HDlseek(file->fd, (HDoff_t)write_addr, SEEK_SET) < 0)
-        HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
 
         /*
           * Write the data. It doesn't truncate the extra data introduced by
@@ -1213,7 +1184,7 @@ H5FD_direct_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_U
          */
         HDassert(!(write_size % _fbsize));
     do {
-        nbytes = HDwrite(file->fd, copy_buf, write_size);
+        nbytes = HDpwrite(file->fd, copy_buf, write_size, (HDoff_t)write_addr);
     } while (-1==nbytes && EINTR==errno);
 
     if (-1==nbytes) /* error */
@@ -1234,21 +1205,15 @@ H5FD_direct_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_U
         } /* end if */
     }
 
-    /* Update current position and eof */
-    file->pos = addr;
-    file->op = OP_WRITE;
-    if (file->pos>file->eof)
-        file->eof = file->pos;
+    /* Update eof */
+    if (addr>file->eof)
+        file->eof = addr;
 
 done:
     if(ret_value<0) {
         /* Free with HDfree since it came from posix_memalign */
         if(copy_buf)
             HDfree(copy_buf);
-
-        /* Reset last file I/O information */
-        file->pos = HADDR_UNDEF;
-        file->op = OP_UNKNOWN;
     } /* end if */
 
     FUNC_LEAVE_NOAPI(ret_value)
@@ -1302,10 +1267,6 @@ H5FD_direct_truncate(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATT
 
         /* Update the eof value */
         file->eof = file->eoa;
-
-        /* Reset last file I/O information */
-        file->pos = HADDR_UNDEF;
-        file->op = OP_UNKNOWN;
     }
     else if (file->fa.must_align){
   /*Even though eof is equal to eoa, file is still truncated because Direct I/O
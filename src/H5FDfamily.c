@@ -79,6 +79,19 @@ typedef struct H5FD_family_fapl_t {
     hid_t	memb_fapl_id;	/*file access property list of each memb*/
 } H5FD_family_fapl_t;
 
+/* A vector I/O request split at member boundaries */
+typedef struct H5FD_family_vec_t {
+    size_t	count;		/*number of pieces			*/
+    unsigned	*memb;		/*member holding each piece		*/
+    H5FD_mem_t	*types;		/*memory type of each piece		*/
+    haddr_t	*addrs;		/*address of each piece in its member	*/
+    size_t	*sizes;		/*size of each piece			*/
+    union {
+        const void **w;		/*buffer of each piece, for writing	*/
+        void	**r;		/*buffer of each piece, for reading	*/
+    } bufs;
+} H5FD_family_vec_t;
+
 /* Callback prototypes */
 static herr_t H5FD_family_term(void);
 static void *H5FD_family_fapl_get(H5FD_t *_file);
@@ -106,6 +119,21 @@ static herr_t H5FD_family_flush(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t H5FD_family_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t H5FD_family_lock(H5FD_t *_file, hbool_t rw);
 static herr_t H5FD_family_unlock(H5FD_t *_file);
+static herr_t H5FD_family_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]);
+static herr_t H5FD_family_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[]);
+
+/* Helper routines */
+static void H5FD_family_vec_fill(const H5FD_family_t *file, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void * const bufs[], H5FD_family_vec_t *vec);
+static herr_t H5FD_family_vec_split(const H5FD_family_t *file, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void * const bufs[], H5FD_family_vec_t *vec/*out*/);
+static void H5FD_family_vec_free(H5FD_family_vec_t *vec);
 
 /* The class struct */
 static const H5FD_class_t H5FD_family_g = {
@@ -140,7 +168,10 @@ static const H5FD_class_t H5FD_family_g = {
     H5FD_family_truncate,			/*truncate		*/
     H5FD_family_lock,                           /*lock                  */
     H5FD_family_unlock,                         /*unlock                */
-    H5FD_FLMAP_DICHOTOMY                        /*fl_map                */
+    H5FD_FLMAP_DICHOTOMY,                       /*fl_map                */
+    H5FD_family_read_vector,                    /*read_vector           */
+    H5FD_family_write_vector,                   /*write_vector          */
+    NULL                                        /*advise                */
 };
 
 
@@ -1397,3 +1428,220 @@ H5FD_family_unlock(H5FD_t *_file)
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_family_unlock() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_family_vec_fill
+ *
+ * Purpose:	Splits the COUNT pieces of a vector I/O request at member
+ *		boundaries, the same way H5FD_family_read() and
+ *		H5FD_family_write() split a single piece, counting the
+ *		pieces that result in VEC->count.  When VEC's arrays are
+ *		allocated the pieces are stored in them too.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_family_vec_fill(const H5FD_family_t *file, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void * const bufs[], H5FD_family_vec_t *vec)
+{
+    size_t	u;		/* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    vec->count = 0;
+    for(u = 0; u < count; u++) {
+        const unsigned char *buf = (const unsigned char *)bufs[u];
+        haddr_t	addr = addrs[u];
+        size_t	size = sizes[u];
+
+        while(size > 0) {
+            hsize_t tempreq;
+            size_t req;
+            unsigned memb;
+
+            H5_CHECKED_ASSIGN(memb, unsigned, addr / file->memb_size, hsize_t);
+            tempreq = file->memb_size - (addr % file->memb_size);
+            if(tempreq > SIZET_MAX)
+                tempreq = SIZET_MAX;
+            req = MIN(size, (size_t)tempreq);
+
+            if(vec->memb) {
+                vec->memb[vec->count] = memb;
+                vec->types[vec->count] = types[u];
+                vec->addrs[vec->count] = addr % file->memb_size;
+                vec->sizes[vec->count] = req;
+                vec->bufs.w[vec->count] = buf;
+            } /* end if */
+            vec->count++;
+
+            addr += req;
+            buf += req;
+            size -= req;
+        } /* end while */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_family_vec_fill() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_family_vec_split
+ *
+ * Purpose:	Splits the COUNT pieces of a vector I/O request at member
+ *		boundaries into VEC, whose arrays are released with
+ *		H5FD_family_vec_free().
+ *
+ * Return:	SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_family_vec_split(const H5FD_family_t *file, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void * const bufs[], H5FD_family_vec_t *vec/*out*/)
+{
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDmemset(vec, 0, sizeof(*vec));
+
+    /* Count the pieces, then allocate room for them & store them */
+    H5FD_family_vec_fill(file, count, types, addrs, sizes, bufs, vec);
+    if(vec->count > 0) {
+        if(NULL == (vec->memb = (unsigned *)H5MM_malloc(vec->count * sizeof(unsigned)))
+                || NULL == (vec->types = (H5FD_mem_t *)H5MM_malloc(vec->count * sizeof(H5FD_mem_t)))
+                || NULL == (vec->addrs = (haddr_t *)H5MM_malloc(vec->count * sizeof(haddr_t)))
+                || NULL == (vec->sizes = (size_t *)H5MM_malloc(vec->count * sizeof(size_t)))
+                || NULL == (vec->bufs.w = (const void **)H5MM_malloc(vec->count * sizeof(void *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate split vector")
+        H5FD_family_vec_fill(file, count, types, addrs, sizes, bufs, vec);
+    } /* end if */
+
+done:
+    if(ret_value < 0)
+        H5FD_family_vec_free(vec);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_family_vec_split() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_family_vec_free
+ *
+ * Purpose:	Releases the arrays of a split vector I/O request.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_family_vec_free(H5FD_family_vec_t *vec)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    vec->memb = (unsigned *)H5MM_xfree(vec->memb);
+    vec->types = (H5FD_mem_t *)H5MM_xfree(vec->types);
+    vec->addrs = (haddr_t *)H5MM_xfree(vec->addrs);
+    vec->sizes = (size_t *)H5MM_xfree(vec->sizes);
+    vec->bufs.w = (const void **)H5MM_xfree(vec->bufs.w);
+    vec->count = 0;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_family_vec_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_family_read_vector
+ *
+ * Purpose:	Reads the COUNT pieces of a vector read request from FILE
+ *		into the buffers BUFS.  The pieces are split at member
+ *		boundaries and each run of pieces in the same member is
+ *		passed on to that member as one vector read.
+ *
+ * Return:	SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_family_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[])
+{
+    H5FD_family_t	*file = (H5FD_family_t *)_file;
+    H5FD_family_vec_t	vec;		/* Request split at member boundaries */
+    size_t		u, v;		/* Local index variables */
+    herr_t		ret_value = SUCCEED;	/* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDmemset(&vec, 0, sizeof(vec));
+
+    if(H5FD_family_vec_split(file, count, types, addrs, sizes, (const void * const *)bufs, &vec) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "can't split vector read request")
+
+    /* Read each run of pieces from its member */
+    for(u = 0; u < vec.count; u = v) {
+        for(v = u + 1; v < vec.count && vec.memb[v] == vec.memb[u]; v++)
+            ;
+        HDassert(vec.memb[u] < file->nmembs);
+
+        if(H5FDread_vector(file->memb[vec.memb[u]], dxpl_id, v - u, vec.types + u, vec.addrs + u, vec.sizes + u, vec.bufs.r + u) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "member file vector read failed")
+    } /* end for */
+
+done:
+    H5FD_family_vec_free(&vec);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_family_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_family_write_vector
+ *
+ * Purpose:	Writes the COUNT pieces of a vector write request to FILE
+ *		from the buffers BUFS.  The pieces are split at member
+ *		boundaries and each run of pieces in the same member is
+ *		passed on to that member as one vector write.
+ *
+ * Return:	SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_family_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    H5FD_family_t	*file = (H5FD_family_t *)_file;
+    H5FD_family_vec_t	vec;		/* Request split at member boundaries */
+    size_t		u, v;		/* Local index variables */
+    herr_t		ret_value = SUCCEED;	/* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDmemset(&vec, 0, sizeof(vec));
+
+    if(H5FD_family_vec_split(file, count, types, addrs, sizes, bufs, &vec) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "can't split vector write request")
+
+    /* Write each run of pieces to its member */
+    for(u = 0; u < vec.count; u = v) {
+        for(v = u + 1; v < vec.count && vec.memb[v] == vec.memb[u]; v++)
+            ;
+        HDassert(vec.memb[u] < file->nmembs);
+
+        if(H5FDwrite_vector(file->memb[vec.memb[u]], dxpl_id, v - u, vec.types + u, vec.addrs + u, vec.sizes + u, vec.bufs.w + u) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "member file vector write failed")
+    } /* end for */
+
+done:
+    H5FD_family_vec_free(&vec);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_family_write_vector() */
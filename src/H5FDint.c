@@ -39,6 +39,7 @@
 #include "H5Fprivate.h"         /* File access				*/
 #include "H5FDpkg.h"		/* File Drivers				*/
 #include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 
 
 /****************/
@@ -59,6 +60,9 @@
 /********************/
 /* Local Prototypes */
 /********************/
+static herr_t H5FD__vector_addrs(const H5FD_t *file, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    haddr_t **abs_addrs/*out*/);
 
 
 /*********************/
@@ -279,6 +283,214 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD__vector_addrs
+ *
+ * Purpose:	Checks that the COUNT pieces of a vector I/O request are
+ *		all within the end of the allocated space for their types,
+ *		and translates their (relative) addresses into the absolute
+ *		addresses the driver uses.
+ *
+ *		If the file has a non-zero base address, the absolute
+ *		addresses are returned in a new array in *ABS_ADDRS, which
+ *		the caller frees; otherwise *ABS_ADDRS is set to NULL and
+ *		the addresses in ADDRS are used as they are.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__vector_addrs(const H5FD_t *file, size_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], haddr_t **abs_addrs/*out*/)
+{
+    H5FD_mem_t  eoa_type = H5FD_MEM_NOLIST;     /* Type of EOA in 'eoa' */
+    haddr_t     eoa = HADDR_UNDEF;              /* EOA for current type */
+    size_t      u;                              /* Local index variable */
+    herr_t      ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(file && file->cls);
+    HDassert(abs_addrs);
+
+    *abs_addrs = NULL;
+
+    /* Check each piece against the EOA for its type */
+    for(u = 0; u < count; u++) {
+        if(types[u] != eoa_type) {
+            if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, types[u])))
+                HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+            eoa_type = types[u];
+        } /* end if */
+        if((addrs[u] + file->base_addr + sizes[u]) > eoa)
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size=%llu, eoa=%llu",
+                        (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u], (unsigned long long)eoa)
+    } /* end for */
+
+    /* Translate the addresses, if the file has a base address */
+    if(file->base_addr > 0) {
+        if(NULL == (*abs_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate address array")
+        for(u = 0; u < count; u++)
+            (*abs_addrs)[u] = addrs[u] + file->base_addr;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__vector_addrs() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_read_vector
+ *
+ * Purpose:	Private version of H5FDread_vector()
+ *
+ *		Reads COUNT pieces of a file, each of SIZES[i] bytes at
+ *		(relative) address ADDRS[i] with memory type TYPES[i], into
+ *		the buffers BUFS[i].  Drivers with a 'read_vector' callback
+ *		are handed the whole request at once, others get one 'read'
+ *		call per piece.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_read_vector(H5FD_t *file, const H5P_genplist_t *dxpl, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]/*out*/)
+{
+    haddr_t    *abs_addrs = NULL;       /* Absolute addresses, if needed */
+    const haddr_t *drv_addrs;           /* Addresses handed to the driver */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(TRUE == H5P_class_isa(H5P_CLASS(dxpl), H5P_CLS_DATASET_XFER_g));
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* The no-op case */
+    if(0 == count)
+        HGOTO_DONE(SUCCEED)
+
+    /* Check the request & get the driver's addresses for it */
+    if(H5FD__vector_addrs(file, count, types, addrs, sizes, &abs_addrs) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_BADRANGE, FAIL, "invalid vector read request")
+    drv_addrs = abs_addrs ? abs_addrs : addrs;
+
+    /* Dispatch to driver */
+    if(file->cls->read_vector) {
+        if((file->cls->read_vector)(file, H5P_PLIST_ID(dxpl), count, types, drv_addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver vector read request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(sizes[u] > 0)
+                if((file->cls->read)(file, types[u], H5P_PLIST_ID(dxpl), drv_addrs[u], sizes[u], bufs[u]) < 0)
+                    HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read request failed")
+
+done:
+    H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_write_vector
+ *
+ * Purpose:	Private version of H5FDwrite_vector()
+ *
+ *		Writes COUNT pieces of a file, each of SIZES[i] bytes at
+ *		(relative) address ADDRS[i] with memory type TYPES[i], from
+ *		the buffers BUFS[i].  Drivers with a 'write_vector' callback
+ *		are handed the whole request at once, others get one
+ *		'write' call per piece.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_write_vector(H5FD_t *file, const H5P_genplist_t *dxpl, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    haddr_t    *abs_addrs = NULL;       /* Absolute addresses, if needed */
+    const haddr_t *drv_addrs;           /* Addresses handed to the driver */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(TRUE == H5P_class_isa(H5P_CLASS(dxpl), H5P_CLS_DATASET_XFER_g));
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* The no-op case */
+    if(0 == count)
+        HGOTO_DONE(SUCCEED)
+
+    /* Check the request & get the driver's addresses for it */
+    if(H5FD__vector_addrs(file, count, types, addrs, sizes, &abs_addrs) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_BADRANGE, FAIL, "invalid vector write request")
+    drv_addrs = abs_addrs ? abs_addrs : addrs;
+
+    /* Dispatch to driver */
+    if(file->cls->write_vector) {
+        if((file->cls->write_vector)(file, H5P_PLIST_ID(dxpl), count, types, drv_addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver vector write request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(sizes[u] > 0)
+                if((file->cls->write)(file, types[u], H5P_PLIST_ID(dxpl), drv_addrs[u], sizes[u], bufs[u]) < 0)
+                    HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver write request failed")
+
+done:
+    H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_write_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_advise
+ *
+ * Purpose:	Passes the expected pattern of access to the SIZE bytes at
+ *		(relative) address ADDR on to the driver, if it has an
+ *		'advise' callback.  Drivers without one ignore the advice.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_advise(H5FD_t *file, haddr_t addr, hsize_t size, H5FD_advice_t advice)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+
+    /* Dispatch to driver */
+    if(file->cls->advise)
+        if((file->cls->advise)(file, addr + file->base_addr, size, advice) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_CANTSET, FAIL, "driver access advice failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_advise() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5FD_set_eoa
@@ -66,22 +66,28 @@ static const char *flavors[]={
 
 /* The description of a file belonging to this driver. The `eoa' and `eof'
  * determine the amount of hdf5 address space in use and the high-water mark
- * of the file (the current size of the underlying filesystem file). The
- * `pos' value is used to eliminate file position updates when they would be a
- * no-op. Unfortunately we've found systems that use separate file position
- * indicators for reading and writing so the lseek can only be eliminated if
- * the current operation is the same as the previous operation.  When opening
- * a file the `eof' will be set to the current file size, `eoa' will be set
- * to zero, `pos' will be set to H5F_ADDR_UNDEF (as it is when an error
- * occurs), and `op' will be set to H5F_OP_UNKNOWN.
+ * of the file (the current size of the underlying filesystem file). When
+ * opening a file the `eof' will be set to the current file size and `eoa'
+ * will be set to zero.
+ *
+ * As in the sec2 driver, I/O is positional (pread/pwrite) where available,
+ * so there are no seeks to log.  Otherwise, the `pos' value is used to
+ * eliminate file position updates when they would be a no-op. Unfortunately
+ * we've found systems that use separate file position indicators for reading
+ * and writing so the lseek can only be eliminated if the current operation
+ * is the same as the previous operation.  When opening a file `pos' will be
+ * set to H5F_ADDR_UNDEF (as it is when an error occurs), and `op' will be set
+ * to H5F_OP_UNKNOWN.
  */
 typedef struct H5FD_log_t {
     H5FD_t          pub;    /* public stuff, must be first      */
     int             fd;     /* the unix file                    */
     haddr_t         eoa;    /* end of allocated region          */
     haddr_t         eof;    /* end of file; current file size   */
+#ifndef H5_HAVE_PREADWRITE
     haddr_t         pos;    /* current file I/O position        */
     H5FD_file_op_t  op;     /* last operation                   */
+#endif /* H5_HAVE_PREADWRITE */
     char            filename[H5FD_MAX_FILENAME_LEN];    /* Copy of file name from open operation */
 #ifndef H5_HAVE_WIN32_API
     /* On most systems the combination of device and i-node number uniquely
@@ -214,7 +220,10 @@ static const H5FD_class_t H5FD_log_g = {
     H5FD_log_truncate,				/*truncate		*/
     H5FD_log_lock,                              /*lock                  */
     H5FD_log_unlock,                            /*unlock                */
-    H5FD_FLMAP_DICHOTOMY			/*fl_map		*/
+    H5FD_FLMAP_DICHOTOMY,			/*fl_map		*/
+    NULL,                                       /*read_vector           */
+    NULL,                                       /*write_vector          */
+    NULL                                        /*advise                */
 };
 
 /* Declare a free list to manage the H5FD_log_t struct */
@@ -569,8 +578,10 @@ H5FD_log_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
 
     file->fd = fd;
     H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
+#ifndef H5_HAVE_PREADWRITE
     file->pos = HADDR_UNDEF;
     file->op = OP_UNKNOWN;
+#endif /* H5_HAVE_PREADWRITE */
 #ifdef H5_HAVE_WIN32_API
     file->hFile = (HANDLE)_get_osfhandle(fd);
     if(INVALID_HANDLE_VALUE == file->hFile)
@@ -1136,7 +1147,8 @@ H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t H5_ATTR_UNUSED dxpl_id, hadd
         } /* end if */
     } /* end if */
 
-    /* Seek to the correct location */
+#ifndef H5_HAVE_PREADWRITE
+    /* Seek to the correct location (if we don't have pread/pwrite) */
     if(addr != file->pos || OP_READ != file->op) {
 #ifdef H5_HAVE_GETTIMEOFDAY
         if(file->fa.flags & H5FD_LOG_TIME_SEEK)
@@ -1179,6 +1191,7 @@ H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t H5_ATTR_UNUSED dxpl_id, hadd
 #endif /* H5_HAVE_GETTIMEOFDAY */
         } /* end if */
     } /* end if */
+#endif /* H5_HAVE_PREADWRITE */
 
     /*
      * Read data, being careful of interrupted system calls, partial results,
@@ -1202,13 +1215,21 @@ H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t H5_ATTR_UNUSED dxpl_id, hadd
             bytes_in = (h5_posix_io_t)size;
 
         do {
+#ifdef H5_HAVE_PREADWRITE
+            bytes_read = HDpread(file->fd, buf, bytes_in, (HDoff_t)addr);
+#else /* H5_HAVE_PREADWRITE */
             bytes_read = HDread(file->fd, buf, bytes_in);
+#endif /* H5_HAVE_PREADWRITE */
         } while(-1 == bytes_read && EINTR == errno);
 
         if(-1 == bytes_read) { /* error */
             int myerrno = errno;
             time_t mytime = HDtime(NULL);
+#ifdef H5_HAVE_PREADWRITE
+            HDoff_t myoffset = (HDoff_t)addr;
+#else /* H5_HAVE_PREADWRITE */
             HDoff_t myoffset = HDlseek(file->fd, (HDoff_t)0, SEEK_CUR);
+#endif /* H5_HAVE_PREADWRITE */
 
             if(file->fa.flags & H5FD_LOG_LOC_READ)
                 HDfprintf(file->logfp, "Error! Reading: %10a-%10a (%10Zu bytes)\n", orig_addr, (orig_addr + orig_size) - 1, orig_size);
@@ -1268,16 +1289,20 @@ H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t H5_ATTR_UNUSED dxpl_id, hadd
 #endif /* H5_HAVE_GETTIMEOFDAY */
     } /* end if */
 
+#ifndef H5_HAVE_PREADWRITE
     /* Update current position */
     file->pos = addr;
     file->op = OP_READ;
+#endif /* H5_HAVE_PREADWRITE */
 
 done:
+#ifndef H5_HAVE_PREADWRITE
     if(ret_value < 0) {
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
     } /* end if */
+#endif /* H5_HAVE_PREADWRITE */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_log_read() */
@@ -1338,7 +1363,8 @@ H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t H5_ATTR_UNUSED dxpl_id, had
             file->nwrite[tmp_addr++]++;
     } /* end if */
 
-    /* Seek to the correct location */
+#ifndef H5_HAVE_PREADWRITE
+    /* Seek to the correct location (if we don't have pread/pwrite) */
     if(addr != file->pos || OP_WRITE != file->op) {
 #ifdef H5_HAVE_GETTIMEOFDAY
         if(file->fa.flags & H5FD_LOG_TIME_SEEK)
@@ -1381,6 +1407,7 @@ H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t H5_ATTR_UNUSED dxpl_id, had
 #endif /* H5_HAVE_GETTIMEOFDAY */
         } /* end if */
     } /* end if */
+#endif /* H5_HAVE_PREADWRITE */
 
     /*
      * Write the data, being careful of interrupted system calls and partial
@@ -1404,13 +1431,21 @@ H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t H5_ATTR_UNUSED dxpl_id, had
             bytes_in = (h5_posix_io_t)size;
 
         do {
+#ifdef H5_HAVE_PREADWRITE
+            bytes_wrote = HDpwrite(file->fd, buf, bytes_in, (HDoff_t)addr);
+#else /* H5_HAVE_PREADWRITE */
             bytes_wrote = HDwrite(file->fd, buf, bytes_in);
+#endif /* H5_HAVE_PREADWRITE */
         } while(-1 == bytes_wrote && EINTR == errno);
 
         if(-1 == bytes_wrote) { /* error */
             int myerrno = errno;
             time_t mytime = HDtime(NULL);
+#ifdef H5_HAVE_PREADWRITE
+            HDoff_t myoffset = (HDoff_t)addr;
+#else /* H5_HAVE_PREADWRITE */
             HDoff_t myoffset = HDlseek(file->fd, (HDoff_t)0, SEEK_CUR);
+#endif /* H5_HAVE_PREADWRITE */
 
             if(file->fa.flags & H5FD_LOG_LOC_WRITE)
                 HDfprintf(file->logfp, "Error! Writing: %10a-%10a (%10Zu bytes)\n", orig_addr, (orig_addr + orig_size) - 1, orig_size);
@@ -1468,17 +1503,21 @@ H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t H5_ATTR_UNUSED dxpl_id, had
     } /* end if */
 
     /* Update current position and eof */
+#ifndef H5_HAVE_PREADWRITE
     file->pos = addr;
     file->op = OP_WRITE;
-    if(file->pos > file->eof)
-        file->eof = file->pos;
+#endif /* H5_HAVE_PREADWRITE */
+    if(addr > file->eof)
+        file->eof = addr;
 
 done:
+#ifndef H5_HAVE_PREADWRITE
     if(ret_value < 0) {
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
     } /* end if */
+#endif /* H5_HAVE_PREADWRITE */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_log_write() */
@@ -1547,9 +1586,11 @@ H5FD_log_truncate(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATTR_U
         /* Update the eof value */
         file->eof = file->eoa;
 
+#ifndef H5_HAVE_PREADWRITE
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
+#endif /* H5_HAVE_PREADWRITE */
     } /* end if */
 
 done:
@@ -235,6 +235,17 @@ typedef enum H5F_mem_t	H5FD_mem_t;
      */
 #define H5FD_FEAT_CAN_USE_FILE_IMAGE_CALLBACKS 0x00000800
 
+/* Expected pattern of access to a range of a file, which drivers that can
+ * pass it on to the operating system do (see H5Pset_access_advice)
+ */
+typedef enum H5FD_advice_t {
+    H5FD_ADVICE_ERROR           = -1,
+    H5FD_ADVICE_NORMAL          = 0,    /* No particular pattern (default) */
+    H5FD_ADVICE_SEQUENTIAL      = 1,    /* Read in order, once */
+    H5FD_ADVICE_RANDOM          = 2,    /* Read in no particular order */
+    H5FD_ADVICE_WILLNEED        = 3     /* Read soon, worth reading ahead now */
+} H5FD_advice_t;
+
 /* Forward declaration */
 typedef struct H5FD_t H5FD_t;
 
@@ -277,6 +288,17 @@ typedef struct H5FD_class_t {
     herr_t  (*lock)(H5FD_t *file, hbool_t rw);
     herr_t  (*unlock)(H5FD_t *file);
     H5FD_mem_t fl_map[H5FD_MEM_NTYPES];
+
+    /* Optional callbacks, after the original fields so that the class
+     * initializers of existing drivers leave them NULL */
+    herr_t  (*read_vector)(H5FD_t *file, hid_t dxpl, size_t count,
+                           const H5FD_mem_t types[], const haddr_t addrs[],
+                           const size_t sizes[], void *bufs[]/*out*/);
+    herr_t  (*write_vector)(H5FD_t *file, hid_t dxpl, size_t count,
+                            const H5FD_mem_t types[], const haddr_t addrs[],
+                            const size_t sizes[], const void *bufs[]);
+    herr_t  (*advise)(H5FD_t *file, haddr_t addr, hsize_t size,
+                      H5FD_advice_t advice);
 } H5FD_class_t;
 
 /* A free list is a singly-linked list of address/size pairs. */
@@ -353,6 +375,12 @@ H5_DLL herr_t H5FDread(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id,
                        haddr_t addr, size_t size, void *buf/*out*/);
 H5_DLL herr_t H5FDwrite(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id,
                         haddr_t addr, size_t size, const void *buf);
+H5_DLL herr_t H5FDread_vector(H5FD_t *file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]/*out*/);
+H5_DLL herr_t H5FDwrite_vector(H5FD_t *file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[]);
 H5_DLL herr_t H5FDflush(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
 H5_DLL herr_t H5FDtruncate(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
 H5_DLL herr_t H5FDlock(H5FD_t *file, hbool_t rw);
@@ -38,27 +38,38 @@
 #include "H5MMprivate.h"    /* Memory management        */
 #include "H5Pprivate.h"     /* Property lists           */
 
+#ifdef H5_HAVE_PREADWRITEV
+#include <sys/uio.h>
+#endif /* H5_HAVE_PREADWRITEV */
+
 /* The driver identification number, initialized at runtime */
 static hid_t H5FD_SEC2_g = 0;
 
 /* The description of a file belonging to this driver. The 'eoa' and 'eof'
  * determine the amount of hdf5 address space in use and the high-water mark
- * of the file (the current size of the underlying filesystem file). The
- * 'pos' value is used to eliminate file position updates when they would be a
- * no-op. Unfortunately we've found systems that use separate file position
- * indicators for reading and writing so the lseek can only be eliminated if
- * the current operation is the same as the previous operation.  When opening
- * a file the 'eof' will be set to the current file size, `eoa' will be set
- * to zero, 'pos' will be set to H5F_ADDR_UNDEF (as it is when an error
- * occurs), and 'op' will be set to H5F_OP_UNKNOWN.
+ * of the file (the current size of the underlying filesystem file). When
+ * opening a file the 'eof' will be set to the current file size and `eoa'
+ * will be set to zero.
+ *
+ * Where pread/pwrite are available, reads and writes are made at their
+ * offsets without touching the file descriptor's file position, so the
+ * driver keeps no seek state and concurrent reads from one file are safe.
+ * Otherwise, the 'pos' value is used to eliminate file position updates when
+ * they would be a no-op. Unfortunately we've found systems that use separate
+ * file position indicators for reading and writing so the lseek can only be
+ * eliminated if the current operation is the same as the previous operation.
+ * When opening a file 'pos' will be set to H5F_ADDR_UNDEF (as it is when an
+ * error occurs), and 'op' will be set to H5F_OP_UNKNOWN.
  */
 typedef struct H5FD_sec2_t {
     H5FD_t          pub;    /* public stuff, must be first      */
     int             fd;     /* the filesystem file descriptor   */
     haddr_t         eoa;    /* end of allocated region          */
     haddr_t         eof;    /* end of file; current file size   */
+#ifndef H5_HAVE_PREADWRITE
     haddr_t         pos;    /* current file I/O position        */
     H5FD_file_op_t  op;     /* last operation                   */
+#endif /* H5_HAVE_PREADWRITE */
     char            filename[H5FD_MAX_FILENAME_LEN];    /* Copy of file name from open operation */
 #ifndef H5_HAVE_WIN32_API
     /* On most systems the combination of device and i-node number uniquely
@@ -122,6 +133,17 @@ typedef struct H5FD_sec2_t {
                                  HADDR_UNDEF==(A)+(Z) ||                    \
                                 (HDoff_t)((A)+(Z))<(HDoff_t)(A))
 
+/* Most file-adjacent pieces of a vector I/O request moved by one
+ * preadv()/pwritev() call
+ */
+#ifdef H5_HAVE_PREADWRITEV
+#if defined(IOV_MAX) && IOV_MAX < 256
+#define H5FD_SEC2_MAX_IOV   IOV_MAX
+#else
+#define H5FD_SEC2_MAX_IOV   256
+#endif
+#endif /* H5_HAVE_PREADWRITEV */
+
 /* Prototypes */
 static herr_t H5FD_sec2_term(void);
 static H5FD_t *H5FD_sec2_open(const char *name, unsigned flags, hid_t fapl_id,
@@ -140,6 +162,17 @@ static herr_t H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, had
 static herr_t H5FD_sec2_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t H5FD_sec2_lock(H5FD_t *_file, hbool_t rw);
 static herr_t H5FD_sec2_unlock(H5FD_t *_file);
+static herr_t H5FD_sec2_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]);
+static herr_t H5FD_sec2_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[]);
+#ifdef H5_HAVE_PREADWRITEV
+static size_t H5FD_sec2_gather(size_t count, const haddr_t addrs[],
+    const size_t sizes[], const void * const bufs[], struct iovec *iov,
+    size_t *total);
+#endif /* H5_HAVE_PREADWRITEV */
 
 static const H5FD_class_t H5FD_sec2_g = {
     "sec2",                     /* name                 */
@@ -173,7 +206,10 @@ static const H5FD_class_t H5FD_sec2_g = {
     H5FD_sec2_truncate,         /* truncate             */
     H5FD_sec2_lock,             /* lock                 */
     H5FD_sec2_unlock,           /* unlock               */
-    H5FD_FLMAP_DICHOTOMY        /* fl_map               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD_sec2_read_vector,      /* read_vector          */
+    H5FD_sec2_write_vector,     /* write_vector         */
+    NULL                        /* advise               */
 };
 
 /* Declare a free list to manage the H5FD_sec2_t struct */
@@ -357,8 +393,10 @@ H5FD_sec2_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
 
     file->fd = fd;
     H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
+#ifndef H5_HAVE_PREADWRITE
     file->pos = HADDR_UNDEF;
     file->op = OP_UNKNOWN;
+#endif /* H5_HAVE_PREADWRITE */
 #ifdef H5_HAVE_WIN32_API
     file->hFile = (HANDLE)_get_osfhandle(fd);
     if(INVALID_HANDLE_VALUE == file->hFile)
@@ -682,11 +720,13 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
     if(REGION_OVERFLOW(addr, size))
         HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
 
-    /* Seek to the correct location */
+#ifndef H5_HAVE_PREADWRITE
+    /* Seek to the correct location (if we don't have pread/pwrite) */
     if(addr != file->pos || OP_READ != file->op) {
         if(HDlseek(file->fd, (HDoff_t)addr, SEEK_SET) < 0)
             HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
     } /* end if */
+#endif /* H5_HAVE_PREADWRITE */
 
     /* Read data, being careful of interrupted system calls, partial results,
      * and the end of the file.
@@ -705,13 +745,21 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
             bytes_in = (h5_posix_io_t)size;
 
         do {
+#ifdef H5_HAVE_PREADWRITE
+            bytes_read = HDpread(file->fd, buf, bytes_in, (HDoff_t)addr);
+#else /* H5_HAVE_PREADWRITE */
             bytes_read = HDread(file->fd, buf, bytes_in);
+#endif /* H5_HAVE_PREADWRITE */
         } while(-1 == bytes_read && EINTR == errno);
         
         if(-1 == bytes_read) { /* error */
             int myerrno = errno;
             time_t mytime = HDtime(NULL);
+#ifdef H5_HAVE_PREADWRITE
+            HDoff_t myoffset = (HDoff_t)addr;
+#else /* H5_HAVE_PREADWRITE */
             HDoff_t myoffset = HDlseek(file->fd, (HDoff_t)0, SEEK_CUR);
+#endif /* H5_HAVE_PREADWRITE */
 
             HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total read size = %llu, bytes this sub-read = %llu, bytes actually read = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_read, (unsigned long long)myoffset);
         } /* end if */
@@ -730,16 +778,20 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
         buf = (char *)buf + bytes_read;
     } /* end while */
 
+#ifndef H5_HAVE_PREADWRITE
     /* Update current position */
     file->pos = addr;
     file->op = OP_READ;
+#endif /* H5_HAVE_PREADWRITE */
 
 done:
+#ifndef H5_HAVE_PREADWRITE
     if(ret_value < 0) {
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
     } /* end if */
+#endif /* H5_HAVE_PREADWRITE */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_read() */
@@ -777,11 +829,13 @@ H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNU
     if(REGION_OVERFLOW(addr, size))
         HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addr, (unsigned long long)size)
 
-    /* Seek to the correct location */
+#ifndef H5_HAVE_PREADWRITE
+    /* Seek to the correct location (if we don't have pread/pwrite) */
     if(addr != file->pos || OP_WRITE != file->op) {
         if(HDlseek(file->fd, (HDoff_t)addr, SEEK_SET) < 0)
             HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
     } /* end if */
+#endif /* H5_HAVE_PREADWRITE */
 
     /* Write the data, being careful of interrupted system calls and partial
      * results
@@ -800,13 +854,21 @@ H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNU
             bytes_in = (h5_posix_io_t)size;
 
         do {
+#ifdef H5_HAVE_PREADWRITE
+            bytes_wrote = HDpwrite(file->fd, buf, bytes_in, (HDoff_t)addr);
+#else /* H5_HAVE_PREADWRITE */
             bytes_wrote = HDwrite(file->fd, buf, bytes_in);
+#endif /* H5_HAVE_PREADWRITE */
         } while(-1 == bytes_wrote && EINTR == errno);
         
         if(-1 == bytes_wrote) { /* error */
             int myerrno = errno;
             time_t mytime = HDtime(NULL);
+#ifdef H5_HAVE_PREADWRITE
+            HDoff_t myoffset = (HDoff_t)addr;
+#else /* H5_HAVE_PREADWRITE */
             HDoff_t myoffset = HDlseek(file->fd, (HDoff_t)0, SEEK_CUR);
+#endif /* H5_HAVE_PREADWRITE */
 
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total write size = %llu, bytes this sub-write = %llu, bytes actually written = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_wrote, (unsigned long long)myoffset);
         } /* end if */
@@ -820,17 +882,21 @@ H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNU
     } /* end while */
 
     /* Update current position and eof */
+#ifndef H5_HAVE_PREADWRITE
     file->pos = addr;
     file->op = OP_WRITE;
-    if(file->pos > file->eof)
-        file->eof = file->pos;
+#endif /* H5_HAVE_PREADWRITE */
+    if(addr > file->eof)
+        file->eof = addr;
 
 done:
+#ifndef H5_HAVE_PREADWRITE
     if(ret_value < 0) {
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
     } /* end if */
+#endif /* H5_HAVE_PREADWRITE */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_write() */
@@ -895,9 +961,11 @@ H5FD_sec2_truncate(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATTR_
         /* Update the eof value */
         file->eof = file->eoa;
 
+#ifndef H5_HAVE_PREADWRITE
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
+#endif /* H5_HAVE_PREADWRITE */
     } /* end if */
 
 done:
@@ -970,3 +1038,222 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_unlock() */
 
+
+#ifdef H5_HAVE_PREADWRITEV
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_gather
+ *
+ * Purpose:     Gathers the leading pieces of a vector I/O request that are
+ *              adjacent in the file (each piece starting where the one
+ *              before it ends) into IOV, as one preadv()/pwritev() call
+ *              moves them.  At most H5FD_SEC2_MAX_IOV pieces, and no more
+ *              than H5_POSIX_MAX_IO_BYTES bytes, are gathered.
+ *
+ * Return:      The number of pieces gathered, with their total size in
+ *              *TOTAL.  Zero if the first piece alone is larger than one
+ *              call can move.
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5FD_sec2_gather(size_t count, const haddr_t addrs[], const size_t sizes[],
+    const void * const bufs[], struct iovec *iov, size_t *total)
+{
+    haddr_t     end = addrs[0];     /* End of the pieces gathered so far */
+    size_t      niov = 0;           /* # of pieces gathered */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    *total = 0;
+    while(niov < count && niov < H5FD_SEC2_MAX_IOV && addrs[niov] == end
+            && sizes[niov] <= (size_t)H5_POSIX_MAX_IO_BYTES - *total) {
+        union {
+            const void *cbuf;
+            void *buf;
+        } base;             /* iovec's buffer, which is only read from for writes */
+
+        base.cbuf = bufs[niov];
+        iov[niov].iov_base = base.buf;
+        iov[niov].iov_len = sizes[niov];
+        *total += sizes[niov];
+        end += sizes[niov];
+        niov++;
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(niov)
+} /* end H5FD_sec2_gather() */
+#endif /* H5_HAVE_PREADWRITEV */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_read_vector
+ *
+ * Purpose:     Reads the COUNT pieces of a vector read request from FILE
+ *              into the buffers BUFS.
+ *
+ *              Runs of pieces adjacent in the file are read with a single
+ *              preadv() each, where it is available.  A run that comes
+ *              up short (at the end of the file, for example) is finished
+ *              piece by piece with H5FD_sec2_read().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[])
+{
+#ifdef H5_HAVE_PREADWRITEV
+    H5FD_sec2_t     *file = (H5FD_sec2_t *)_file;
+    struct iovec    iov[H5FD_SEC2_MAX_IOV];     /* Pieces of one preadv() */
+#endif /* H5_HAVE_PREADWRITEV */
+    size_t          u = 0;                      /* Local index variable */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(_file && _file->cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    while(u < count) {
+#ifdef H5_HAVE_PREADWRITEV
+        h5_posix_io_ret_t   bytes_read = -1;    /* # of bytes actually read */
+        size_t  total;                          /* # of bytes in the run */
+        size_t  niov;                           /* # of pieces in the run */
+        size_t  v;                              /* Local index variable */
+
+        /* Gather the run of pieces adjacent to this one */
+        niov = H5FD_sec2_gather(count - u, addrs + u, sizes + u, (const void * const *)(bufs + u), iov, &total);
+        if(niov > 1) {
+            if(!H5F_addr_defined(addrs[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+            if(REGION_OVERFLOW(addrs[u], total))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addrs[u])
+
+            do {
+                bytes_read = HDpreadv(file->fd, iov, (int)niov, (HDoff_t)addrs[u]);
+            } while(-1 == bytes_read && EINTR == errno);
+
+            if(-1 == bytes_read) { /* error */
+                int myerrno = errno;
+                time_t mytime = HDtime(NULL);
+
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file vector read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', pieces = %llu, total read size = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), (unsigned long long)niov, (unsigned long long)total, (unsigned long long)addrs[u]);
+            } /* end if */
+
+            /* Finish the pieces a short read left incomplete */
+            for(v = u; v < u + niov; v++) {
+                if((size_t)bytes_read >= sizes[v])
+                    bytes_read -= (h5_posix_io_ret_t)sizes[v];
+                else {
+                    if(H5FD_sec2_read(_file, types[v], dxpl_id, addrs[v] + (haddr_t)bytes_read, sizes[v] - (size_t)bytes_read, (char *)bufs[v] + bytes_read) < 0)
+                        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+                    bytes_read = 0;
+                } /* end else */
+            } /* end for */
+
+            u += niov;
+            continue;
+        } /* end if */
+#endif /* H5_HAVE_PREADWRITEV */
+
+        /* Read a lone piece */
+        if(H5FD_sec2_read(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+        u++;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_write_vector
+ *
+ * Purpose:     Writes the COUNT pieces of a vector write request to FILE
+ *              from the buffers BUFS.
+ *
+ *              Runs of pieces adjacent in the file are written with a
+ *              single pwritev() each, where it is available.  A run that
+ *              is only partly written is finished piece by piece with
+ *              H5FD_sec2_write().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+#ifdef H5_HAVE_PREADWRITEV
+    H5FD_sec2_t     *file = (H5FD_sec2_t *)_file;
+    struct iovec    iov[H5FD_SEC2_MAX_IOV];     /* Pieces of one pwritev() */
+#endif /* H5_HAVE_PREADWRITEV */
+    size_t          u = 0;                      /* Local index variable */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(_file && _file->cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    while(u < count) {
+#ifdef H5_HAVE_PREADWRITEV
+        h5_posix_io_ret_t   bytes_wrote = -1;   /* # of bytes written */
+        size_t  total;                          /* # of bytes in the run */
+        size_t  niov;                           /* # of pieces in the run */
+        size_t  v;                              /* Local index variable */
+
+        /* Gather the run of pieces adjacent to this one */
+        niov = H5FD_sec2_gather(count - u, addrs + u, sizes + u, bufs + u, iov, &total);
+        if(niov > 1) {
+            if(!H5F_addr_defined(addrs[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+            if(REGION_OVERFLOW(addrs[u], total))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addrs[u], (unsigned long long)total)
+
+            do {
+                bytes_wrote = HDpwritev(file->fd, iov, (int)niov, (HDoff_t)addrs[u]);
+            } while(-1 == bytes_wrote && EINTR == errno);
+
+            if(-1 == bytes_wrote) { /* error */
+                int myerrno = errno;
+                time_t mytime = HDtime(NULL);
+
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', pieces = %llu, total write size = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), (unsigned long long)niov, (unsigned long long)total, (unsigned long long)addrs[u]);
+            } /* end if */
+
+            /* Update eof for the part written */
+            if(addrs[u] + (haddr_t)bytes_wrote > file->eof)
+                file->eof = addrs[u] + (haddr_t)bytes_wrote;
+
+            /* Finish the pieces a short write left incomplete */
+            for(v = u; v < u + niov; v++) {
+                if((size_t)bytes_wrote >= sizes[v])
+                    bytes_wrote -= (h5_posix_io_ret_t)sizes[v];
+                else {
+                    if(H5FD_sec2_write(_file, types[v], dxpl_id, addrs[v] + (haddr_t)bytes_wrote, sizes[v] - (size_t)bytes_wrote, (const char *)bufs[v] + bytes_wrote) < 0)
+                        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+                    bytes_wrote = 0;
+                } /* end else */
+            } /* end for */
+
+            u += niov;
+            continue;
+        } /* end if */
+#endif /* H5_HAVE_PREADWRITEV */
+
+        /* Write a lone piece */
+        if(H5FD_sec2_write(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+        u++;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_write_vector() */
@@ -212,7 +212,6 @@ H5FS__cache_hdr_deserialize(const void *_image, size_t len, void *_udata,
     H5FS_hdr_cache_ud_t *udata = (H5FS_hdr_cache_ud_t *)_udata;  /* User data for callback */
     const uint8_t	*image = (const uint8_t *)_image;       /* Pointer into raw data buffer */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
     unsigned            nclasses;       /* Number of section classes */
     H5FS_t		*ret_value = NULL;      /* Return value */
 
@@ -285,9 +284,6 @@ H5FS__cache_hdr_deserialize(const void *_image, size_t len, void *_udata,
     /* Allocated size of serialized free space sections */
     H5F_DECODE_LENGTH(udata->f, image, fspace->alloc_sect_size);
 
-    /* Compute checksum on indirect block */
-    computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -295,7 +291,7 @@ H5FS__cache_hdr_deserialize(const void *_image, size_t len, void *_udata,
     HDassert((size_t)(image - (const uint8_t *)_image) <= len);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5FS_SIZEOF_CHKSUM), stored_chksum))
 	HGOTO_ERROR(H5E_FSPACE, H5E_BADVALUE, NULL, "incorrect metadata checksum for fractal heap indirect block")
 
     /* Set return value */
@@ -843,7 +839,6 @@ H5FS__cache_sinfo_deserialize(const void *_image, size_t len, void *_udata,
     size_t                  old_sect_size;  /* Old section size */
     const uint8_t          *image = (const uint8_t *)_image;    /* Pointer into raw data buffer */
     uint32_t                stored_chksum;  /* Stored metadata checksum  */
-    uint32_t                computed_chksum;    /* Computed metadata checksum */
     void *                  ret_value = NULL;   /* Return value */
 
     FUNC_ENTER_STATIC
@@ -950,14 +945,11 @@ H5FS__cache_sinfo_deserialize(const void *_image, size_t len, void *_udata,
         HDassert(old_tot_space == fspace->tot_space);
     } /* end if */
 
-    /* Compute checksum on indirect block */
-    computed_chksum = H5_checksum_metadata((const uint8_t *)_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5FS_SIZEOF_CHKSUM), stored_chksum))
         HGOTO_ERROR(H5E_FSPACE, H5E_BADVALUE, NULL, "incorrect metadata checksum for fractal heap indirect block")
 
     /* Sanity check */
@@ -155,6 +155,8 @@ H5F_get_access_plist(H5F_t *f, hbool_t app_ref)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache byte size")
     if(H5P_set(new_plist, H5F_ACS_PREEMPT_READ_CHUNKS_NAME, &(f->shared->rdcc_w0)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set preempt read chunks")
+    if(H5P_set(new_plist, H5F_ACS_DATA_CACHE_SHARED_NBYTES_NAME, &(f->shared->rdcc_shared_nbytes)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set file-wide data cache byte size")
     if(H5P_set(new_plist, H5F_ACS_ALIGN_THRHD_NAME, &(f->shared->threshold)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set alignment threshold")
     if(H5P_set(new_plist, H5F_ACS_ALIGN_NAME, &(f->shared->alignment)) < 0)
@@ -171,8 +173,22 @@ H5F_get_access_plist(H5F_t *f, hbool_t app_ref)
         latest_format = TRUE;
     if(H5P_set(new_plist, H5F_ACS_LATEST_FORMAT_NAME, &latest_format) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set 'latest format' flag")
+    if(H5P_set(new_plist, H5F_ACS_SKIP_MD_CHKSUM_NAME, &(f->shared->skip_md_chksum)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set 'skip metadata checksums' flag")
     if(H5P_set(new_plist, H5F_ACS_OBJECT_FLUSH_CB_NAME, &(f->shared->object_flush)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set object flush callback")
+    if(f->shared->page_buf) {
+        size_t page_buf_size = f->shared->page_buf->max_pages * f->shared->page_buf->page_size;
+
+        if(H5P_set(new_plist, H5F_ACS_PAGE_BUF_SIZE_NAME, &page_buf_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer size")
+        if(H5P_set(new_plist, H5F_ACS_PAGE_BUF_PAGE_SIZE_NAME, &(f->shared->page_buf->page_size)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer page size")
+        if(H5P_set(new_plist, H5F_ACS_PAGE_BUF_MIN_META_PERC_NAME, &(f->shared->page_buf->min_meta_perc)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set minimum metadata percentage of page buffer")
+        if(H5P_set(new_plist, H5F_ACS_PAGE_BUF_MIN_RAW_PERC_NAME, &(f->shared->page_buf->min_raw_perc)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set minimum raw data percentage of page buffer")
+    } /* end if */
 
     if(f->shared->efc)
         efc_size = H5F_efc_max_nfiles(f->shared->efc);
@@ -582,6 +598,12 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
         H5P_genplist_t *plist;          /* Property list */
         unsigned        efc_size;       /* External file cache size */
         hbool_t	latest_format;	        /* Always use the latest format?	*/
+        size_t          page_buf_size;  /* Size of page buffer */
+        size_t          page_size;      /* Page size of page buffer */
+        unsigned        page_buf_min_meta_perc; /* Minimum metadata percentage of page buffer */
+        unsigned        page_buf_min_raw_perc;  /* Minimum raw data percentage of page buffer */
+        H5P_genplist_t *fc_plist;       /* File creation property list */
+        hsize_t         userblock_size; /* Size of userblock */
         size_t u;                       /* Local index variable */
 
         HDassert(lf != NULL);
@@ -629,6 +651,8 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get data cache byte size")
         if(H5P_get(plist, H5F_ACS_PREEMPT_READ_CHUNKS_NAME, &(f->shared->rdcc_w0)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get preempt read chunk")
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_SHARED_NBYTES_NAME, &(f->shared->rdcc_shared_nbytes)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get file-wide data cache byte size")
         if(H5P_get(plist, H5F_ACS_ALIGN_THRHD_NAME, &(f->shared->threshold)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get alignment threshold")
         if(H5P_get(plist, H5F_ACS_ALIGN_NAME, &(f->shared->alignment)) < 0)
@@ -642,6 +666,8 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
         /* For latest format, activate all latest version support */
         if(latest_format)
             f->shared->latest_flags |= H5F_LATEST_ALL_FLAGS;
+        if(H5P_get(plist, H5F_ACS_SKIP_MD_CHKSUM_NAME, &(f->shared->skip_md_chksum)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get 'skip metadata checksums' flag")
         if(H5P_get(plist, H5F_ACS_META_BLOCK_SIZE_NAME, &(f->shared->meta_aggr.alloc_size)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata cache size")
         f->shared->meta_aggr.feature_flag = H5FD_FEAT_AGGREGATE_METADATA;
@@ -686,6 +712,54 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
         if(H5P_get(plist, H5F_ACS_OBJECT_FLUSH_CB_NAME, &(f->shared->object_flush)) < 0)
             HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get object flush cb info")
 
+        /* Set up the page buffer, if one was requested */
+        if(H5P_get(plist, H5F_ACS_PAGE_BUF_SIZE_NAME, &page_buf_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get page buffer size")
+        if(page_buf_size > 0) {
+            if(H5P_get(plist, H5F_ACS_PAGE_BUF_PAGE_SIZE_NAME, &page_size) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get page buffer page size")
+            if(H5P_get(plist, H5F_ACS_PAGE_BUF_MIN_META_PERC_NAME, &page_buf_min_meta_perc) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get minimum metadata percentage of page buffer")
+            if(H5P_get(plist, H5F_ACS_PAGE_BUF_MIN_RAW_PERC_NAME, &page_buf_min_raw_perc) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get minimum raw data percentage of page buffer")
+
+            /* The processes of a parallel file can't share a page buffer */
+            if(H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+                HGOTO_ERROR(H5E_FILE, H5E_UNSUPPORTED, NULL, "page buffering is not supported with parallel I/O")
+
+            /* Drivers that don't aggregate metadata, like the multi driver,
+             *  split the address space between files at addresses that
+             *  aren't on page boundaries */
+            if(!H5F_HAS_FEATURE(f, H5FD_FEAT_AGGREGATE_METADATA))
+                HGOTO_ERROR(H5E_FILE, H5E_UNSUPPORTED, NULL, "page buffering is not supported by this file driver")
+
+            /* The page buffer takes over from the metadata accumulator */
+            f->shared->feature_flags &= ~(unsigned long)H5FD_FEAT_ACCUMULATE_METADATA;
+
+            /* Unless the application has chosen an alignment, align objects
+             *  of a page or more on page boundaries and aggregate metadata
+             *  and "small" raw data a page at a time, so that metadata and
+             *  raw data pages are kept apart as much as possible.  (A new
+             *  file's userblock must be a multiple of the alignment, so leave
+             *  the alignment alone when it isn't a multiple of the page size.)
+             */
+            if(NULL == (fc_plist = (H5P_genplist_t *)H5I_object(f->shared->fcpl_id)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "not a property list")
+            if(H5P_get(fc_plist, H5F_CRT_USER_BLOCK_NAME, &userblock_size) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get userblock size")
+            if(f->shared->alignment == 1 && 0 == (userblock_size % page_size)) {
+                f->shared->alignment = (hsize_t)page_size;
+                f->shared->threshold = (hsize_t)page_size;
+                lf->alignment = f->shared->alignment;
+                lf->threshold = f->shared->threshold;
+                f->shared->meta_aggr.alloc_size = ((f->shared->meta_aggr.alloc_size + page_size - 1) / page_size) * page_size;
+                f->shared->sdata_aggr.alloc_size = ((f->shared->sdata_aggr.alloc_size + page_size - 1) / page_size) * page_size;
+            } /* end if */
+
+            if(H5F__page_create(f->shared, page_size, page_buf_size, page_buf_min_meta_perc, page_buf_min_raw_perc) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to create page buffer")
+        } /* end if */
+
         /*
          * Create a metadata cache with the specified number of elements.
          * The cache might be created with a different number of elements and
@@ -719,6 +793,9 @@ done:
             if(f->shared->efc)
                 if(H5F_efc_destroy(f->shared->efc) < 0)
                     HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, NULL, "can't destroy external file cache")
+            if(f->shared->page_buf)
+                if(H5F__page_dest(f->shared) < 0)
+                    HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, NULL, "can't destroy page buffer")
             if(f->shared->fcpl_id > 0)
                 if(H5I_dec_ref(f->shared->fcpl_id) < 0)
                     HDONE_ERROR(H5E_FILE, H5E_CANTDEC, NULL, "can't close property list")
@@ -848,6 +925,14 @@ H5F_dest(H5F_t *f, hid_t dxpl_id, hbool_t flush)
         if(H5F__accum_reset(&fio_info, TRUE) < 0)
             /* Push error, but keep going*/
             HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "problems closing file")
+        if(f->shared->page_buf) {
+            if((H5F_INTENT(f) & H5F_ACC_RDWR) && H5F__page_flush(&fio_info) < 0)
+                /* Push error, but keep going*/
+                HDONE_ERROR(H5E_FILE, H5E_CANTFLUSH, FAIL, "unable to flush page buffer")
+            if(H5F__page_dest(f->shared) < 0)
+                /* Push error, but keep going*/
+                HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "problems closing file")
+        } /* end if */
         if(H5FO_dest(f) < 0)
             /* Push error, but keep going*/
             HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "problems closing file")
@@ -873,6 +958,9 @@ H5F_dest(H5F_t *f, hid_t dxpl_id, hbool_t flush)
         f->shared->mtab.child = (H5F_mount_t *)H5MM_xfree(f->shared->mtab.child);
         f->shared->mtab.nalloc = 0;
 
+        /* The datasets sharing the file-wide chunk cache have all been closed */
+        HDassert(NULL == f->shared->rdcc_file);
+
         /* Destroy shared file struct */
         f->shared = (H5F_file_t *)H5FL_FREE(H5F_file_t, f->shared);
 
@@ -1201,6 +1289,11 @@ H5F_flush(H5F_t *f, hid_t dxpl_id, hbool_t closing)
         /* Push error, but keep going*/
         HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush metadata accumulator")
 
+    /* Flush out the page buffer */
+    if(f->shared->page_buf && H5F__page_flush(&fio_info) < 0)
+        /* Push error, but keep going*/
+        HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush page buffer")
+
     /* Flush file buffers to disk. */
     if(H5FD_flush(f->shared->lf, dxpl_id, closing) < 0)
         /* Push error, but keep going*/
@@ -1854,6 +1947,33 @@ H5F_set_grp_btree_shared(H5F_t *f, H5UC_t *rc)
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* H5F_set_grp_btree_shared() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F_set_rdcc_file
+ *
+ * Purpose:     Set (or reset, with NULL) the file-wide raw data chunk
+ *              cache that the file's chunked datasets share.
+ *
+ * Return:      Success:        SUCCEED
+ *              Failure:        FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_set_rdcc_file(H5F_t *f, struct H5D_rdcc_file_t *rdcc_file)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(f->shared);
+
+    f->shared->rdcc_file = rdcc_file;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5F_set_rdcc_file() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5F_set_sohm_addr
@@ -2065,6 +2185,16 @@ H5F_get_file_image(H5F_t *file, void *buf_ptr, size_t buf_len, hid_t dxpl_id)
         if(NULL == (xfer_plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
             HGOTO_ERROR(H5E_CACHE, H5E_BADATOM, FAIL, "can't get new property list object")
 
+        /* Write any dirty pages in the page buffer, so the image has them */
+        if(file->shared->page_buf && (H5F_INTENT(file) & H5F_ACC_RDWR)) {
+            H5F_io_info_t fio_info;             /* I/O info for operation */
+
+            fio_info.f = file;
+            fio_info.dxpl = xfer_plist;
+            if(H5F__page_flush(&fio_info) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTFLUSH, FAIL, "unable to flush page buffer")
+        } /* end if */
+
         /* read in the file image */
         /* (Note compensation for base address addition in internal routine) */
         if(H5FD_read(fd_ptr, xfer_plist, H5FD_MEM_DEFAULT, 0, space_needed, buf_ptr) < 0)
@@ -129,9 +129,15 @@ HDfprintf(stderr, "%s: read from addr = %a, size = %Zu\n", FUNC, addr, size);
     if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(my_dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
-    /* Pass through metadata accumulator layer */
-    if(H5F__accum_read(&fio_info, map_type, addr, size, buf) < 0)
-        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through metadata accumulator failed")
+    /* Pass through the page buffer, if there is one, else through the
+     *  metadata accumulator layer */
+    if(f->shared->page_buf) {
+        if(H5F__page_read(&fio_info, map_type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through page buffer failed")
+    } /* end if */
+    else
+        if(H5F__accum_read(&fio_info, map_type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through metadata accumulator failed")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -191,9 +197,15 @@ HDfprintf(stderr, "%s: write to addr = %a, size = %Zu\n", FUNC, addr, size);
     if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(my_dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
-    /* Pass through metadata accumulator layer */
-    if(H5F__accum_write(&fio_info, map_type, addr, size, buf) < 0)
-        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through metadata accumulator failed")
+    /* Pass through the page buffer, if there is one, else through the
+     *  metadata accumulator layer */
+    if(f->shared->page_buf) {
+        if(H5F__page_write(&fio_info, map_type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through page buffer failed")
+    } /* end if */
+    else
+        if(H5F__accum_write(&fio_info, map_type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through metadata accumulator failed")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -236,6 +248,10 @@ H5F_flush_tagged_metadata(H5F_t * f, haddr_t tag, hid_t dxpl_id)
     if(H5F__accum_reset(&fio_info, TRUE) < 0)
         HGOTO_ERROR(H5E_IO, H5E_CANTRESET, FAIL, "can't reset accumulator")
 
+    /* Write out the page buffer */
+    if(f->shared->page_buf && H5F__page_flush(&fio_info) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush page buffer")
+
     /* Flush file buffers to disk. */
     if(H5FD_flush(f->shared->lf, dxpl_id, FALSE) < 0)
         HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "low level flush failed")
@@ -282,3 +298,154 @@ done:
     FUNC_LEAVE_NOAPI(ret_value);
 } /* end H5F_evict_tagged_metadata */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_read_vector
+ *
+ * Purpose:	Reads COUNT pieces of a file into the buffers BUFS.  Piece
+ *		I is SIZES[I] bytes at address ADDRS[I], relative to the
+ *		base address for the file, of memory type TYPES[I].
+ *
+ *		Raw data bypasses the metadata accumulator, so a request
+ *		made up only of raw data pieces is handed to the file
+ *		driver as a single vector read.  Other requests, and all
+ *		requests when the file has a page buffer, are read piece
+ *		by piece through the metadata accumulator or page buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_read_vector(const H5F_t *f, size_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id, void *bufs[]/*out*/)
+{
+    H5P_genplist_t *dxpl;               /* DXPL object */
+    hbool_t     all_raw = (NULL == f->shared->page_buf); /* Whether all pieces are raw data, with no page buffer */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* Check for attempting I/O on 'temporary' file address */
+    for(u = 0; u < count; u++) {
+        HDassert(H5F_addr_defined(addrs[u]));
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+        if(H5FD_MEM_DRAW != types[u])
+            all_raw = FALSE;
+    } /* end for */
+
+    if(all_raw) {
+        if(NULL == (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+        /* Pass the whole request to the file driver */
+        if(H5FD_read_vector(f->shared->lf, dxpl, count, types, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver vector read request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(H5F_block_read(f, types[u], addrs[u], sizes[u], dxpl_id, bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_write_vector
+ *
+ * Purpose:	Writes COUNT pieces of a file from the buffers BUFS.  Piece
+ *		I is SIZES[I] bytes at address ADDRS[I], relative to the
+ *		base address for the file, of memory type TYPES[I].
+ *
+ *		Raw data bypasses the metadata accumulator, so a request
+ *		made up only of raw data pieces is handed to the file
+ *		driver as a single vector write.  Other requests, and all
+ *		requests when the file has a page buffer, are written
+ *		piece by piece through the metadata accumulator or page
+ *		buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_write_vector(const H5F_t *f, size_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id, const void *bufs[])
+{
+    H5P_genplist_t *dxpl;               /* DXPL object */
+    hbool_t     all_raw = (NULL == f->shared->page_buf); /* Whether all pieces are raw data, with no page buffer */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(H5F_INTENT(f) & H5F_ACC_RDWR);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* Check for attempting I/O on 'temporary' file address */
+    for(u = 0; u < count; u++) {
+        HDassert(H5F_addr_defined(addrs[u]));
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+        if(H5FD_MEM_DRAW != types[u])
+            all_raw = FALSE;
+    } /* end for */
+
+    if(all_raw) {
+        if(NULL == (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+        /* Pass the whole request to the file driver */
+        if(H5FD_write_vector(f->shared->lf, dxpl, count, types, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver vector write request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(H5F_block_write(f, types[u], addrs[u], sizes[u], dxpl_id, bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "block write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_write_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_advise
+ *
+ * Purpose:	Passes the expected pattern of access to the SIZE bytes at
+ *		address ADDR, relative to the base address for the file,
+ *		on to the file driver.  Only drivers with an 'advise'
+ *		callback (the mmap driver) act on the advice; for other
+ *		drivers this does nothing.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_advise(const H5F_t *f, haddr_t addr, hsize_t size, H5FD_advice_t advice)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(H5F_addr_defined(addr));
+
+    if(H5FD_advise(f->shared->lf, addr, size, advice) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTSET, FAIL, "driver access advice failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_advise() */
@@ -0,0 +1,827 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*-------------------------------------------------------------------------
+ *
+ * Created:             H5Fpage.c
+ *
+ * Purpose:             File "page buffer" routines.  (Used to cache
+ *                      fixed-size, aligned pages of the file, so that
+ *                      small metadata and raw data I/Os are turned into
+ *                      whole-page I/Os to the file driver)
+ *
+ *                      Reads and writes smaller than a page are made on
+ *                      pages in the buffer, which are read from the file
+ *                      when first touched and written back whole when
+ *                      evicted or flushed.  Larger I/Os go straight to
+ *                      the file driver, with the buffered pages they
+ *                      overlap kept consistent with them.  Pages are
+ *                      evicted in least-recently-used order, except
+ *                      that metadata and raw data pages are each kept
+ *                      to a minimum share of the buffer, so a stream of
+ *                      one can't push all of the other out.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5Fmodule.h"          /* This source code file is part of the H5F module */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Fpkg.h"             /* File access				*/
+#include "H5FDprivate.h"	/* File drivers				*/
+#include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5SLprivate.h"	/* Skip lists				*/
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Class of a page or an I/O: metadata or raw data */
+#define H5F_PAGE_CLASS(T)       ((H5FD_MEM_DRAW == (T)) ? H5F_PAGE_RAW : H5F_PAGE_META)
+
+/* Address of the page holding address A */
+#define H5F_PAGE_ADDR(PB, A)    ((A) - ((A) % (PB)->page_size))
+
+/* Least-recently-used list maintenance */
+#define H5F_PAGE_LRU_REMOVE(PB, P)                                            \
+{                                                                             \
+    if((P)->prev)                                                             \
+        (P)->prev->next = (P)->next;                                          \
+    else                                                                      \
+        (PB)->lru_head = (P)->next;                                           \
+    if((P)->next)                                                             \
+        (P)->next->prev = (P)->prev;                                          \
+    else                                                                      \
+        (PB)->lru_tail = (P)->prev;                                           \
+    (P)->prev = (P)->next = NULL;                                             \
+}
+#define H5F_PAGE_LRU_PREPEND(PB, P)                                           \
+{                                                                             \
+    (P)->prev = NULL;                                                         \
+    (P)->next = (PB)->lru_head;                                               \
+    if((PB)->lru_head)                                                        \
+        (PB)->lru_head->prev = (P);                                           \
+    else                                                                      \
+        (PB)->lru_tail = (P);                                                 \
+    (PB)->lru_head = (P);                                                     \
+}
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+
+/********************/
+/* Package Typedefs */
+/********************/
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+static const H5P_genplist_t *H5F__page_dxpl(const H5F_io_info_t *fio_info,
+    H5FD_mem_t type, const H5F_page_t *page);
+static hbool_t H5F__page_has_room(const H5F_page_buf_t *pb, unsigned cls);
+static htri_t H5F__page_past_eoa(const H5F_io_info_t *fio_info,
+    H5FD_mem_t type, haddr_t addr, size_t size);
+static herr_t H5F__page_write_back(const H5F_io_info_t *fio_info,
+    H5FD_mem_t type, H5F_page_t *page);
+static herr_t H5F__page_evict(const H5F_io_info_t *fio_info, H5FD_mem_t type);
+static H5F_page_t *H5F__page_protect(const H5F_io_info_t *fio_info,
+    H5FD_mem_t type, haddr_t page_addr);
+static void H5F__page_release(H5F_page_buf_t *pb, H5F_page_t *page);
+static herr_t H5F__page_free_cb(void *item, void *key, void *op_data);
+
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Declare free lists to manage the page buffer and its pages */
+H5FL_DEFINE_STATIC(H5F_page_buf_t);
+H5FL_DEFINE_STATIC(H5F_page_t);
+H5FL_BLK_DEFINE_STATIC(page_buf);
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_create
+ *
+ * Purpose:	Creates a page buffer of BUF_SIZE bytes of PAGE_SIZE-byte
+ *		pages for a file.  At least MIN_META_PERC percent of the
+ *		pages are kept for metadata and MIN_RAW_PERC percent for
+ *		raw data, once they have been filled.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_create(H5F_file_t *shared, size_t page_size, size_t buf_size,
+    unsigned min_meta_perc, unsigned min_raw_perc)
+{
+    H5F_page_buf_t *pb = NULL;          /* New page buffer */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(shared);
+    HDassert(NULL == shared->page_buf);
+    HDassert(page_size > 0);
+    HDassert(buf_size >= page_size);
+    HDassert(min_meta_perc + min_raw_perc <= 100);
+
+    if(NULL == (pb = H5FL_CALLOC(H5F_page_buf_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate page buffer")
+    if(NULL == (pb->pages = H5SL_create(H5SL_TYPE_HADDR, NULL)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTCREATE, FAIL, "can't create skip list for page buffer")
+    pb->page_size = page_size;
+    pb->max_pages = buf_size / page_size;
+    pb->min_pages[H5F_PAGE_META] = (pb->max_pages * min_meta_perc) / 100;
+    pb->min_pages[H5F_PAGE_RAW] = (pb->max_pages * min_raw_perc) / 100;
+    pb->min_meta_perc = min_meta_perc;
+    pb->min_raw_perc = min_raw_perc;
+
+    shared->page_buf = pb;
+
+done:
+    if(ret_value < 0 && pb)
+        pb = H5FL_FREE(H5F_page_buf_t, pb);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_dxpl
+ *
+ * Purpose:	Chooses the DXPL for I/O on a page: the one for the I/O
+ *		of TYPE that led to it when the page is of the same class,
+ *		or the library's own DXPL for the page's class when it
+ *		isn't, since the file driver may check which it gets.
+ *
+ * Return:	DXPL object (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static const H5P_genplist_t *
+H5F__page_dxpl(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    const H5F_page_t *page)
+{
+    const H5P_genplist_t *ret_value = fio_info->dxpl;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(H5F_PAGE_CLASS(type) != H5F_PAGE_CLASS(page->type))
+        ret_value = (const H5P_genplist_t *)H5I_object(H5FD_MEM_DRAW == page->type ?
+                H5AC_rawdata_dxpl_id : H5AC_ind_read_dxpl_id);
+    HDassert(ret_value);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_dxpl() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_has_room
+ *
+ * Purpose:	Checks whether a page of class CLS can be added to the
+ *		page buffer, either into free space or in place of a page
+ *		that may be evicted.  Pages of the other class can't be
+ *		evicted to make room once they are down to their minimum.
+ *
+ * Return:	TRUE/FALSE (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5F__page_has_room(const H5F_page_buf_t *pb, unsigned cls)
+{
+    unsigned    other = (H5F_PAGE_META == cls) ? H5F_PAGE_RAW : H5F_PAGE_META;
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(pb->npages[H5F_PAGE_META] + pb->npages[H5F_PAGE_RAW] < pb->max_pages
+            || pb->npages[cls] > 0 || pb->npages[other] > pb->min_pages[other])
+        ret_value = TRUE;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_has_room() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_past_eoa
+ *
+ * Purpose:	Checks whether the last page an I/O of TYPE touches runs
+ *		past the end of the allocated space while the file itself
+ *		goes further, as it does while the superblock is read, before
+ *		the file's allocated size is known.  Such a page can't be
+ *		read whole, so the I/O must not go through the page buffer.
+ *
+ * Return:	TRUE/FALSE/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5F__page_past_eoa(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t addr, size_t size)
+{
+    H5F_page_buf_t *pb = fio_info->f->shared->page_buf;
+    H5FD_t     *lf = fio_info->f->shared->lf;
+    haddr_t     eoa, eof;               /* End of allocated space, and of file */
+    htri_t      ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(lf, type)))
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "can't get end of allocated space")
+    if(H5F_addr_gt(H5F_PAGE_ADDR(pb, addr + size - 1) + pb->page_size, eoa)) {
+        if(HADDR_UNDEF == (eof = H5FD_get_eof(lf, type)))
+            HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "can't get end of file")
+        if(H5F_addr_gt(eof, eoa))
+            ret_value = TRUE;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_past_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_write_back
+ *
+ * Purpose:	Writes a dirty page to the file, for an I/O of TYPE.  Only
+ *		the part of the page below the end of the allocated space
+ *		is written, which is all of it except for the last page.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__page_write_back(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    H5F_page_t *page)
+{
+    H5F_page_buf_t *pb = fio_info->f->shared->page_buf;
+    H5FD_t     *lf = fio_info->f->shared->lf;
+    haddr_t     eoa;                    /* End of allocated space */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(page->dirty);
+
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(lf, page->type)))
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "can't get end of allocated space")
+
+    /* A page that is now wholly past the end of the file was freed */
+    if(H5F_addr_lt(page->addr, eoa)) {
+        size_t len = (size_t)MIN(pb->page_size, eoa - page->addr);
+
+        if(H5FD_write(lf, H5F__page_dxpl(fio_info, type, page), page->type, page->addr, len, page->buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver write request failed")
+        pb->stats.writes[H5F_PAGE_CLASS(page->type)]++;
+    } /* end if */
+    page->dirty = FALSE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_write_back() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_evict
+ *
+ * Purpose:	Evicts the least recently used page that may be evicted to
+ *		make room for a page of TYPE, writing it back first if it
+ *		is dirty.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__page_evict(const H5F_io_info_t *fio_info, H5FD_mem_t type)
+{
+    H5F_page_buf_t *pb = fio_info->f->shared->page_buf;
+    H5F_page_t *page;                   /* Page considered for eviction */
+    unsigned    cls = H5F_PAGE_CLASS(type);
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Find the least recently used page that may go */
+    for(page = pb->lru_tail; page; page = page->prev) {
+        unsigned page_cls = H5F_PAGE_CLASS(page->type);
+
+        if(page_cls == cls || pb->npages[page_cls] > pb->min_pages[page_cls])
+            break;
+    } /* end for */
+    HDassert(page);
+
+    if(page->dirty)
+        if(H5F__page_write_back(fio_info, type, page) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "can't write back page")
+
+    pb->stats.evictions[H5F_PAGE_CLASS(page->type)]++;
+    if(NULL == H5SL_remove(pb->pages, &page->addr))
+        HGOTO_ERROR(H5E_IO, H5E_CANTDELETE, FAIL, "can't remove page from page buffer")
+    H5F__page_release(pb, page);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_evict() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_protect
+ *
+ * Purpose:	Finds the page at PAGE_ADDR in the page buffer, for an I/O
+ *		of TYPE, reading it in from the file (and evicting another
+ *		page if the buffer is full) if it isn't there.  The page
+ *		becomes the most recently used.
+ *
+ *		Parts of the page past the end of the file's allocated
+ *		space, or past the end of the file itself, are zeroed
+ *		rather than read.
+ *
+ * Return:	Success:	The page
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5F_page_t *
+H5F__page_protect(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t page_addr)
+{
+    H5F_page_buf_t *pb = fio_info->f->shared->page_buf;
+    H5FD_t     *lf = fio_info->f->shared->lf;
+    H5F_page_t *page = NULL;            /* Page found or read */
+    unsigned    cls = H5F_PAGE_CLASS(type);
+    haddr_t     eoa, eof;               /* End of allocated space, and of file */
+    H5F_page_t *ret_value = NULL;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check for the page in the buffer */
+    if(NULL != (page = (H5F_page_t *)H5SL_search(pb->pages, &page_addr))) {
+        pb->stats.hits[cls]++;
+        if(page != pb->lru_head) {
+            H5F_PAGE_LRU_REMOVE(pb, page)
+            H5F_PAGE_LRU_PREPEND(pb, page)
+        } /* end if */
+        HGOTO_DONE(page)
+    } /* end if */
+    pb->stats.misses[cls]++;
+
+    /* Make room for the page */
+    if(pb->npages[H5F_PAGE_META] + pb->npages[H5F_PAGE_RAW] >= pb->max_pages)
+        if(H5F__page_evict(fio_info, type) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTEXPUNGE, NULL, "can't evict page from page buffer")
+
+    if(NULL == (page = H5FL_CALLOC(H5F_page_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "can't allocate page")
+    if(NULL == (page->buf = (unsigned char *)H5FL_BLK_MALLOC(page_buf, pb->page_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "can't allocate page")
+    page->addr = page_addr;
+    page->type = type;
+
+    /* Read the page's contents */
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(lf, type)))
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, NULL, "can't get end of allocated space")
+    if(HADDR_UNDEF == (eof = H5FD_get_eof(lf, type)))
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, NULL, "can't get end of file")
+    HDassert(H5F_addr_lt(page_addr, eoa));
+    if(H5F_addr_lt(page_addr, eof)) {
+        size_t len = (size_t)MIN(pb->page_size, eoa - page_addr);
+
+        if(H5FD_read(lf, fio_info->dxpl, type, page_addr, len, page->buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "driver read request failed")
+        if(len < pb->page_size)
+            HDmemset(page->buf + len, 0, pb->page_size - len);
+    } /* end if */
+    else
+        HDmemset(page->buf, 0, pb->page_size);
+
+    /* Add the page to the buffer */
+    if(H5SL_insert(pb->pages, page, &page->addr) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTINSERT, NULL, "can't insert page into page buffer")
+    H5F_PAGE_LRU_PREPEND(pb, page)
+    pb->npages[cls]++;
+
+    ret_value = page;
+
+done:
+    if(NULL == ret_value && page) {
+        if(page->buf)
+            page->buf = (unsigned char *)H5FL_BLK_FREE(page_buf, page->buf);
+        page = H5FL_FREE(H5F_page_t, page);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_protect() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_release
+ *
+ * Purpose:	Frees a page that has been taken out of the skip list.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5F__page_release(H5F_page_buf_t *pb, H5F_page_t *page)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    H5F_PAGE_LRU_REMOVE(pb, page)
+    HDassert(pb->npages[H5F_PAGE_CLASS(page->type)] > 0);
+    pb->npages[H5F_PAGE_CLASS(page->type)]--;
+    page->buf = (unsigned char *)H5FL_BLK_FREE(page_buf, page->buf);
+    page = H5FL_FREE(H5F_page_t, page);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5F__page_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_read
+ *
+ * Purpose:	Reads some data through a file's page buffer.  Reads
+ *		smaller than a page are served from the pages they fall
+ *		in; larger reads, reads of a class with no room left and
+ *		reads of a last page that can't be read whole go to the
+ *		file driver, with any newer data from dirty pages
+ *		copied over what was read.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_read(const H5F_io_info_t *fio_info, H5FD_mem_t type, haddr_t addr,
+    size_t size, void *_buf/*out*/)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    unsigned char *buf = (unsigned char *)_buf;
+    unsigned    cls = H5F_PAGE_CLASS(type);
+    htri_t      bypass = TRUE;          /* Whether the I/O goes to the file driver */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(fio_info);
+    HDassert(fio_info->f->shared->page_buf);
+    HDassert(buf);
+
+    pb = fio_info->f->shared->page_buf;
+    pb->stats.accesses[cls]++;
+
+    /* Check whether the I/O can go through the page buffer */
+    if(size < pb->page_size && H5F__page_has_room(pb, cls))
+        if((bypass = H5F__page_past_eoa(fio_info, type, addr, size)) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "can't check end of file")
+
+    if(bypass) {
+        haddr_t     first = H5F_PAGE_ADDR(pb, addr);
+        H5SL_node_t *node;              /* Skip list node for overlapping page */
+
+        pb->stats.bypasses[cls]++;
+        if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
+
+        /* Dirty pages hold newer data than the file */
+        for(node = H5SL_above(pb->pages, &first); node; node = H5SL_next(node)) {
+            H5F_page_t *page = (H5F_page_t *)H5SL_item(node);
+            haddr_t     start, end;     /* Overlap of page & read */
+
+            if(H5F_addr_le(addr + size, page->addr))
+                break;
+            if(!page->dirty)
+                continue;
+            start = MAX(addr, page->addr);
+            end = MIN(addr + size, page->addr + pb->page_size);
+            HDmemcpy(buf + (start - addr), page->buf + (start - page->addr), (size_t)(end - start));
+        } /* end for */
+    } /* end if */
+    else {
+        haddr_t     page_addr;          /* Address of current page */
+
+        for(page_addr = H5F_PAGE_ADDR(pb, addr); H5F_addr_lt(page_addr, addr + size); page_addr += pb->page_size) {
+            H5F_page_t *page;           /* Current page */
+            haddr_t     start, end;     /* Overlap of page & read */
+
+            if(NULL == (page = H5F__page_protect(fio_info, type, page_addr)))
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "can't load page")
+            start = MAX(addr, page_addr);
+            end = MIN(addr + size, page_addr + pb->page_size);
+            HDmemcpy(buf + (start - addr), page->buf + (start - page_addr), (size_t)(end - start));
+        } /* end for */
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_write
+ *
+ * Purpose:	Writes some data through a file's page buffer.  Writes
+ *		smaller than a page go into the pages they fall in, which
+ *		are read from the file first if they aren't buffered, so
+ *		that only whole pages are written back.  Larger writes,
+ *		writes of a class with no room left and writes of a last
+ *		page that can't be read whole go to the file driver and are
+ *		also copied into the pages they overlap.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_write(const H5F_io_info_t *fio_info, H5FD_mem_t type, haddr_t addr,
+    size_t size, const void *_buf)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    const unsigned char *buf = (const unsigned char *)_buf;
+    unsigned    cls = H5F_PAGE_CLASS(type);
+    htri_t      bypass = TRUE;          /* Whether the I/O goes to the file driver */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(fio_info);
+    HDassert(fio_info->f->shared->page_buf);
+    HDassert(buf);
+
+    pb = fio_info->f->shared->page_buf;
+    pb->stats.accesses[cls]++;
+
+    /* Check whether the I/O can go through the page buffer */
+    if(size < pb->page_size && H5F__page_has_room(pb, cls))
+        if((bypass = H5F__page_past_eoa(fio_info, type, addr, size)) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "can't check end of file")
+
+    if(bypass) {
+        haddr_t     first = H5F_PAGE_ADDR(pb, addr);
+        H5SL_node_t *node;              /* Skip list node for overlapping page */
+
+        pb->stats.bypasses[cls]++;
+        if(H5FD_write(fio_info->f->shared->lf, fio_info->dxpl, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver write request failed")
+
+        /* Keep the pages overlapped up to date.  A page that was wholly
+         * overwritten now matches the file.
+         */
+        for(node = H5SL_above(pb->pages, &first); node; node = H5SL_next(node)) {
+            H5F_page_t *page = (H5F_page_t *)H5SL_item(node);
+            haddr_t     start, end;     /* Overlap of page & write */
+
+            if(H5F_addr_le(addr + size, page->addr))
+                break;
+            start = MAX(addr, page->addr);
+            end = MIN(addr + size, page->addr + pb->page_size);
+            HDmemcpy(page->buf + (start - page->addr), buf + (start - addr), (size_t)(end - start));
+            if(end - start == pb->page_size)
+                page->dirty = FALSE;
+        } /* end for */
+    } /* end if */
+    else {
+        haddr_t     page_addr;          /* Address of current page */
+
+        for(page_addr = H5F_PAGE_ADDR(pb, addr); H5F_addr_lt(page_addr, addr + size); page_addr += pb->page_size) {
+            H5F_page_t *page;           /* Current page */
+            haddr_t     start, end;     /* Overlap of page & write */
+
+            if(NULL == (page = H5F__page_protect(fio_info, type, page_addr)))
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "can't load page")
+            start = MAX(addr, page_addr);
+            end = MIN(addr + size, page_addr + pb->page_size);
+            HDmemcpy(page->buf + (start - page_addr), buf + (start - addr), (size_t)(end - start));
+            page->dirty = TRUE;
+        } /* end for */
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_free
+ *
+ * Purpose:	Drops the pages wholly within a block of file space that
+ *		is being freed, without writing them back, since nothing
+ *		in them is needed any more.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_free(const H5F_t *f, haddr_t addr, hsize_t size)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    haddr_t     first;                  /* Address of first page within block */
+    H5SL_node_t *node;                  /* Skip list node for page */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(f);
+    HDassert(f->shared->page_buf);
+
+    pb = f->shared->page_buf;
+    first = H5F_PAGE_ADDR(pb, addr + pb->page_size - 1);
+    node = H5SL_above(pb->pages, &first);
+    while(node) {
+        H5F_page_t *page = (H5F_page_t *)H5SL_item(node);
+
+        if(H5F_addr_lt(addr + size, page->addr + pb->page_size))
+            break;
+        node = H5SL_next(node);
+        if(NULL == H5SL_remove(pb->pages, &page->addr))
+            HGOTO_ERROR(H5E_IO, H5E_CANTDELETE, FAIL, "can't remove page from page buffer")
+        H5F__page_release(pb, page);
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_flush
+ *
+ * Purpose:	Writes all dirty pages in a file's page buffer back to the
+ *		file, in address order and as a single vector write, so
+ *		that runs of adjacent pages can be written together.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_flush(const H5F_io_info_t *fio_info)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    H5FD_t     *lf;                     /* File driver */
+    H5FD_mem_t *types = NULL;           /* Type of each page written */
+    haddr_t    *addrs = NULL;           /* Address of each page written */
+    size_t     *sizes = NULL;           /* Size of each page written */
+    const void **bufs = NULL;           /* Each page written */
+    H5SL_node_t *node;                  /* Skip list node for page */
+    size_t      npages, count = 0;      /* Number of pages buffered & written */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(fio_info);
+    HDassert(fio_info->f->shared->page_buf);
+
+    pb = fio_info->f->shared->page_buf;
+    lf = fio_info->f->shared->lf;
+    if(0 == (npages = H5SL_count(pb->pages)))
+        HGOTO_DONE(SUCCEED)
+
+    if(NULL == (types = (H5FD_mem_t *)H5MM_malloc(npages * sizeof(H5FD_mem_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate page write request")
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(npages * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate page write request")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(npages * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate page write request")
+    if(NULL == (bufs = (const void **)H5MM_malloc(npages * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate page write request")
+
+    for(node = H5SL_first(pb->pages); node; node = H5SL_next(node)) {
+        H5F_page_t *page = (H5F_page_t *)H5SL_item(node);
+        haddr_t     eoa;                /* End of allocated space */
+
+        if(!page->dirty)
+            continue;
+
+        /* A page that is now wholly past the end of the file was freed */
+        if(HADDR_UNDEF == (eoa = H5FD_get_eoa(lf, page->type)))
+            HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "can't get end of allocated space")
+        if(H5F_addr_lt(page->addr, eoa)) {
+            types[count] = page->type;
+            addrs[count] = page->addr;
+            sizes[count] = (size_t)MIN(pb->page_size, eoa - page->addr);
+            bufs[count] = page->buf;
+            count++;
+        } /* end if */
+    } /* end for */
+
+    if(count > 0) {
+        size_t u;                       /* Local index variable */
+
+        if(H5FD_write_vector(lf, fio_info->dxpl, count, types, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver vector write request failed")
+        for(u = 0; u < count; u++)
+            pb->stats.writes[H5F_PAGE_CLASS(types[u])]++;
+    } /* end if */
+
+    /* The pages are clean now */
+    for(node = H5SL_first(pb->pages); node; node = H5SL_next(node))
+        ((H5F_page_t *)H5SL_item(node))->dirty = FALSE;
+
+done:
+    H5MM_xfree(types);
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_free_cb
+ *
+ * Purpose:	Skip list callback to free a page as the page buffer is
+ *		destroyed.
+ *
+ * Return:	0 (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__page_free_cb(void *item, void H5_ATTR_UNUSED *key, void H5_ATTR_UNUSED *op_data)
+{
+    H5F_page_t *page = (H5F_page_t *)item;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    page->buf = (unsigned char *)H5FL_BLK_FREE(page_buf, page->buf);
+    page = H5FL_FREE(H5F_page_t, page);
+
+    FUNC_LEAVE_NOAPI(0)
+} /* end H5F__page_free_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_dest
+ *
+ * Purpose:	Frees a file's page buffer, discarding its pages.  Dirty
+ *		pages are lost unless H5F__page_flush() was called first.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_dest(H5F_file_t *shared)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(shared);
+
+    if(NULL != (pb = shared->page_buf)) {
+        if(H5SL_destroy(pb->pages, H5F__page_free_cb, NULL) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTCLOSEOBJ, FAIL, "can't destroy page buffer skip list")
+        shared->page_buf = H5FL_FREE(H5F_page_buf_t, pb);
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_dest() */
@@ -42,6 +42,7 @@
 #include "H5FSprivate.h"	/* File free space                      */
 #include "H5Gprivate.h"		/* Groups 			  	*/
 #include "H5Oprivate.h"         /* Object header messages               */
+#include "H5SLprivate.h"	/* Skip lists				*/
 #include "H5UCprivate.h"	/* Reference counted object functions	*/
 
 
@@ -180,6 +181,34 @@ typedef struct H5F_meta_accum_t {
     hbool_t             dirty;          /* Flag to indicate that the accumulated metadata is dirty */
 } H5F_meta_accum_t;
 
+/* Classes of page in the page buffer */
+#define H5F_PAGE_META   0               /* Page of metadata */
+#define H5F_PAGE_RAW    1               /* Page of raw data */
+
+/* Structure for a page in the page buffer */
+typedef struct H5F_page_t {
+    haddr_t             addr;           /* File address of the page */
+    H5FD_mem_t          type;           /* Type of the I/O that read the page in */
+    hbool_t             dirty;          /* Whether the page is newer than the file */
+    unsigned char      *buf;            /* The page's contents */
+    struct H5F_page_t  *prev;           /* Previous (more recently used) page */
+    struct H5F_page_t  *next;           /* Next (less recently used) page */
+} H5F_page_t;
+
+/* Structure for page buffer fields */
+typedef struct H5F_page_buf_t {
+    size_t              page_size;      /* Size of each page (in bytes) */
+    size_t              max_pages;      /* Number of pages the buffer holds */
+    size_t              min_pages[2];   /* Pages of each class kept from eviction by the other */
+    size_t              npages[2];      /* Pages of each class in the buffer */
+    unsigned            min_meta_perc;  /* Minimum percentage of pages for metadata */
+    unsigned            min_raw_perc;   /* Minimum percentage of pages for raw data */
+    H5SL_t             *pages;          /* Pages, by address */
+    H5F_page_t         *lru_head;       /* Most recently used page */
+    H5F_page_t         *lru_tail;       /* Least recently used page */
+    H5F_page_buf_stats_t stats;         /* Statistics */
+} H5F_page_buf_t;
+
 /* Enum for free space manager state */
 typedef enum H5F_fs_state_t {
     H5F_FS_STATE_CLOSED,                /* Free space manager is closed */
@@ -264,12 +293,15 @@ struct H5F_file_t {
     size_t	rdcc_nslots;	/* Size of raw data chunk cache (slots)	*/
     size_t	rdcc_nbytes;	/* Size of raw data chunk cache	(bytes)	*/
     double	rdcc_w0;	/* Preempt read chunks first? [0.0..1.0]*/
+    size_t	rdcc_shared_nbytes; /* Size of file-wide raw data chunk cache (bytes) */
+    struct H5D_rdcc_file_t *rdcc_file; /* File-wide raw data chunk cache	*/
     size_t      sieve_buf_size; /* Size of the data sieve buffer allocated (in bytes) */
     hsize_t	threshold;	/* Threshold for alignment		*/
     hsize_t	alignment;	/* Alignment				*/
     unsigned	gc_ref;		/* Garbage-collect references?		*/
     unsigned	latest_flags;	/* The latest version support */
     hbool_t	store_msg_crt_idx;  /* Store creation index for object header messages?	*/
+    hbool_t	skip_md_chksum;	/* Skip verifying metadata checksums on load? */
     unsigned	ncwfs;		/* Num entries on cwfs list		*/
     struct H5HG_heap_t **cwfs;	/* Global heap cache			*/
     struct H5G_t *root_grp;	/* Open root group			*/
@@ -294,6 +326,9 @@ struct H5F_file_t {
     /* Metadata accumulator information */
     H5F_meta_accum_t accum;     /* Metadata accumulator info           	*/
 
+    /* Page buffer information */
+    H5F_page_buf_t *page_buf;   /* Page buffer, or NULL when not enabled */
+
     /* Object flush info */
     H5F_object_flush_t 	object_flush;		/* Information for object flush callback */
 };
@@ -377,6 +412,17 @@ H5_DLL herr_t H5F__accum_free(const H5F_io_info_t *fio_info, H5FD_mem_t type,
 H5_DLL herr_t H5F__accum_flush(const H5F_io_info_t *fio_info);
 H5_DLL herr_t H5F__accum_reset(const H5F_io_info_t *fio_info, hbool_t flush);
 
+/* Page buffer routines */
+H5_DLL herr_t H5F__page_create(H5F_file_t *shared, size_t page_size,
+    size_t buf_size, unsigned min_meta_perc, unsigned min_raw_perc);
+H5_DLL herr_t H5F__page_read(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t addr, size_t size, void *buf);
+H5_DLL herr_t H5F__page_write(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t addr, size_t size, const void *buf);
+H5_DLL herr_t H5F__page_free(const H5F_t *f, haddr_t addr, hsize_t size);
+H5_DLL herr_t H5F__page_flush(const H5F_io_info_t *fio_info);
+H5_DLL herr_t H5F__page_dest(H5F_file_t *shared);
+
 /* Shared file list related routines */
 H5_DLL herr_t H5F_sfile_add(H5F_file_t *shared);
 H5_DLL H5F_file_t * H5F_sfile_search(H5FD_t *lf);
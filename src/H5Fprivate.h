@@ -289,6 +289,7 @@
 #define H5F_DRIVER_ID(F)        ((F)->shared->lf->driver_id)
 #define H5F_GET_FILENO(F,FILENUM) ((FILENUM) = (F)->shared->lf->fileno)
 #define H5F_HAS_FEATURE(F,FL)   ((F)->shared->lf->feature_flags & (FL))
+#define H5F_HAS_VECTOR_IO(F)    ((F)->shared->lf->cls->read_vector && (F)->shared->lf->cls->write_vector)
 #define H5F_BASE_ADDR(F)        ((F)->shared->sblock->base_addr)
 #define H5F_SYM_LEAF_K(F)       ((F)->shared->sblock->sym_leaf_k)
 #define H5F_KVALUE(F,T)         ((F)->shared->sblock->btree_k[(T)->id])
@@ -306,6 +307,9 @@
 #define H5F_RDCC_NSLOTS(F)      ((F)->shared->rdcc_nslots)
 #define H5F_RDCC_NBYTES(F)      ((F)->shared->rdcc_nbytes)
 #define H5F_RDCC_W0(F)          ((F)->shared->rdcc_w0)
+#define H5F_RDCC_SHARED_NBYTES(F) ((F)->shared->rdcc_shared_nbytes)
+#define H5F_RDCC_FILE(F)        ((F)->shared->rdcc_file)
+#define H5F_SET_RDCC_FILE(F, C) (((F)->shared->rdcc_file = (C)), SUCCEED)
 #define H5F_SIEVE_BUF_SIZE(F)   ((F)->shared->sieve_buf_size)
 #define H5F_GC_REF(F)           ((F)->shared->gc_ref)
 #define H5F_USE_LATEST_FLAGS(F,FL)  ((F)->shared->latest_flags & (FL))
@@ -334,6 +338,7 @@
 #define H5F_DRIVER_ID(F)        (H5F_get_driver_id(F))
 #define H5F_GET_FILENO(F,FILENUM) (H5F_get_fileno((F), &(FILENUM)))
 #define H5F_HAS_FEATURE(F,FL)   (H5F_has_feature(F,FL))
+#define H5F_HAS_VECTOR_IO(F)    (H5F_has_vector_io(F))
 #define H5F_BASE_ADDR(F)        (H5F_get_base_addr(F))
 #define H5F_SYM_LEAF_K(F)       (H5F_sym_leaf_k(F))
 #define H5F_KVALUE(F,T)         (H5F_Kvalue(F,T))
@@ -351,6 +356,9 @@
 #define H5F_RDCC_NSLOTS(F)      (H5F_rdcc_nslots(F))
 #define H5F_RDCC_NBYTES(F)      (H5F_rdcc_nbytes(F))
 #define H5F_RDCC_W0(F)          (H5F_rdcc_w0(F))
+#define H5F_RDCC_SHARED_NBYTES(F) (H5F_rdcc_shared_nbytes(F))
+#define H5F_RDCC_FILE(F)        (H5F_rdcc_file(F))
+#define H5F_SET_RDCC_FILE(F, C) (H5F_set_rdcc_file((F), (C)))
 #define H5F_SIEVE_BUF_SIZE(F)   (H5F_sieve_buf_size(F))
 #define H5F_GC_REF(F)           (H5F_gc_ref(F))
 #define H5F_USE_LATEST_FLAGS(F,FL) (H5F_use_latest_flags(F,FL))
@@ -445,6 +453,7 @@
 #define H5F_ACS_DATA_CACHE_NUM_SLOTS_NAME       "rdcc_nslots"   /* Size of raw data chunk cache(slots) */
 #define H5F_ACS_DATA_CACHE_BYTE_SIZE_NAME       "rdcc_nbytes"   /* Size of raw data chunk cache(bytes) */
 #define H5F_ACS_PREEMPT_READ_CHUNKS_NAME        "rdcc_w0"       /* Preemption read chunks first */
+#define H5F_ACS_DATA_CACHE_SHARED_NBYTES_NAME   "rdcc_shared_nbytes" /* Size of file-wide raw data chunk cache(bytes) */
 #define H5F_ACS_ALIGN_THRHD_NAME                "threshold"     /* Threshold for alignment */
 #define H5F_ACS_ALIGN_NAME                      "align"         /* Alignment */
 #define H5F_ACS_META_BLOCK_SIZE_NAME            "meta_block_size" /* Minimum metadata allocation block size (when aggregating metadata allocations) */
@@ -465,6 +474,11 @@
 #define H5F_ACS_CORE_WRITE_TRACKING_FLAG_NAME       "core_write_tracking_flag" /* Whether or not core VFD backing store write tracking is enabled */
 #define H5F_ACS_CORE_WRITE_TRACKING_PAGE_SIZE_NAME  "core_write_tracking_page_size" /* The page size in kiB when core VFD write tracking is enabled */
 #define H5F_ACS_COLL_MD_WRITE_FLAG_NAME         "collective_metadata_write" /* property indicating whether metadata writes are done collectively or not */
+#define H5F_ACS_SKIP_MD_CHKSUM_NAME             "skip_md_chksum" /* Whether to skip verifying metadata checksums on load */
+#define H5F_ACS_PAGE_BUF_SIZE_NAME              "page_buf_size" /* Size of the page buffer, or 0 for none */
+#define H5F_ACS_PAGE_BUF_PAGE_SIZE_NAME         "page_buf_page_size" /* Size of the page buffer's pages */
+#define H5F_ACS_PAGE_BUF_MIN_META_PERC_NAME     "page_buf_min_meta_perc" /* Minimum percentage of the page buffer for metadata */
+#define H5F_ACS_PAGE_BUF_MIN_RAW_PERC_NAME      "page_buf_min_raw_perc" /* Minimum percentage of the page buffer for raw data */
 
 /* ======================== File Mount properties ====================*/
 #define H5F_MNT_SYM_LOCAL_NAME 		"local"                 /* Whether absolute symlinks local to file. */
@@ -580,6 +594,7 @@
 /* Forward declarations (for prototypes & type definitions) */
 struct H5B_class_t;
 struct H5UC_t;
+struct H5D_rdcc_file_t;
 struct H5O_loc_t;
 struct H5HG_heap_t;
 struct H5P_genplist_t;
@@ -663,6 +678,9 @@ H5_DLL H5F_close_degree_t H5F_get_fc_degree(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nbytes(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nslots(const H5F_t *f);
 H5_DLL double H5F_rdcc_w0(const H5F_t *f);
+H5_DLL size_t H5F_rdcc_shared_nbytes(const H5F_t *f);
+H5_DLL struct H5D_rdcc_file_t *H5F_rdcc_file(const H5F_t *f);
+H5_DLL herr_t H5F_set_rdcc_file(H5F_t *f, struct H5D_rdcc_file_t *rdcc_file);
 H5_DLL size_t H5F_sieve_buf_size(const H5F_t *f);
 H5_DLL unsigned H5F_gc_ref(const H5F_t *f);
 H5_DLL unsigned H5F_use_latest_flags(const H5F_t *f, unsigned fl);
@@ -681,6 +699,7 @@ H5_DLL void H5F_set_coll_md_read(H5F_t *f, H5P_coll_md_read_flag_t flag);
 H5_DLL hid_t H5F_get_driver_id(const H5F_t *f);
 H5_DLL herr_t H5F_get_fileno(const H5F_t *f, unsigned long *filenum);
 H5_DLL hbool_t H5F_has_feature(const H5F_t *f, unsigned feature);
+H5_DLL hbool_t H5F_has_vector_io(const H5F_t *f);
 H5_DLL haddr_t H5F_get_eoa(const H5F_t *f, H5FD_mem_t type);
 H5_DLL herr_t H5F_get_vfd_handle(const H5F_t *file, hid_t fapl, void **file_handle);
 
@@ -695,6 +714,14 @@ H5_DLL herr_t H5F_block_read(const H5F_t *f, H5FD_mem_t type, haddr_t addr,
                 size_t size, hid_t dxpl_id, void *buf/*out*/);
 H5_DLL herr_t H5F_block_write(const H5F_t *f, H5FD_mem_t type, haddr_t addr,
                 size_t size, hid_t dxpl_id, const void *buf);
+H5_DLL herr_t H5F_block_read_vector(const H5F_t *f, size_t count,
+                const H5FD_mem_t types[], const haddr_t addrs[],
+                const size_t sizes[], hid_t dxpl_id, void *bufs[]/*out*/);
+H5_DLL herr_t H5F_block_write_vector(const H5F_t *f, size_t count,
+                const H5FD_mem_t types[], const haddr_t addrs[],
+                const size_t sizes[], hid_t dxpl_id, const void *bufs[]);
+H5_DLL herr_t H5F_advise(const H5F_t *f, haddr_t addr, hsize_t size,
+                H5FD_advice_t advice);
 
 /* Functions that flush or evict */
 H5_DLL herr_t H5F_flush_tagged_metadata(H5F_t * f, haddr_t tag, hid_t dxpl_id);
@@ -178,6 +178,27 @@ typedef enum H5F_file_space_type_t {
 /* Callback for H5Pset_object_flush_cb() in a file access property list */
 typedef herr_t (*H5F_flush_cb_t)(hid_t object_id, void *udata);
 
+/* Metadata checksum verification statistics, from H5Fget_mdc_chksum_stats() */
+typedef struct H5F_mdc_chksum_stats_t {
+    hsize_t     nverified;      /* Number of metadata checksums verified on load */
+    hsize_t     bytes_verified; /* Bytes of metadata those checksums covered */
+    hsize_t     nskipped;       /* Number of verifications skipped (see H5Pset_skip_metadata_checksums) */
+    hsize_t     bytes_skipped;  /* Bytes of metadata the skipped checksums cover */
+    double      time_saved;     /* Estimated seconds the skipped verifications would have taken (at 1 GB/s) */
+} H5F_mdc_chksum_stats_t;
+
+/* Page buffer statistics, from H5Fget_page_buffering_stats().  Element 0
+ * of each array counts metadata and element 1 raw data.
+ */
+typedef struct H5F_page_buf_stats_t {
+    hsize_t     accesses[2];    /* Reads and writes made through the page buffer */
+    hsize_t     hits[2];        /* Pages found in the page buffer */
+    hsize_t     misses[2];      /* Pages read into the page buffer */
+    hsize_t     evictions[2];   /* Pages evicted to make room for others */
+    hsize_t     bypasses[2];    /* Reads and writes made directly to the file */
+    hsize_t     writes[2];      /* Pages written back to the file */
+} H5F_page_buf_stats_t;
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -214,6 +235,11 @@ H5_DLL herr_t H5Fget_mdc_size(hid_t file_id,
                               size_t * cur_size_ptr,
                               int * cur_num_entries_ptr);
 H5_DLL herr_t H5Freset_mdc_hit_rate_stats(hid_t file_id);
+H5_DLL herr_t H5Fget_mdc_chksum_stats(hid_t file_id,
+                                     H5F_mdc_chksum_stats_t * stats_ptr);
+H5_DLL herr_t H5Fget_page_buffering_stats(hid_t file_id,
+                                     H5F_page_buf_stats_t *stats_ptr);
+H5_DLL herr_t H5Freset_page_buffering_stats(hid_t file_id);
 H5_DLL ssize_t H5Fget_name(hid_t obj_id, char *name, size_t size);
 H5_DLL herr_t H5Fget_info2(hid_t obj_id, H5F_info2_t *finfo);
 H5_DLL ssize_t H5Fget_free_sections(hid_t file_id, H5F_mem_t type,
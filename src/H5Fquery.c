@@ -656,6 +656,52 @@ H5F_rdcc_w0(const H5F_t *f)
     FUNC_LEAVE_NOAPI(f->shared->rdcc_w0)
 } /* end H5F_rdcc_w0() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_rdcc_shared_nbytes
+ *
+ * Purpose:	Retrieve the size of the file-wide raw data chunk cache
+ *		that the file's chunked datasets share.
+ *
+ * Return:	Size of the cache in bytes (0 if it's disabled)
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5F_rdcc_shared_nbytes(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_shared_nbytes)
+} /* end H5F_rdcc_shared_nbytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_rdcc_file
+ *
+ * Purpose:	Retrieve the file-wide raw data chunk cache, if one has been
+ *		created for the file's open chunked datasets.
+ *
+ * Return:	Pointer to the cache (NULL if none)
+ *
+ *-------------------------------------------------------------------------
+ */
+struct H5D_rdcc_file_t *
+H5F_rdcc_file(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_file)
+} /* end H5F_rdcc_file() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5F_get_base_addr
@@ -888,6 +934,29 @@ H5F_has_feature(const H5F_t *f, unsigned feature)
     FUNC_LEAVE_NOAPI((hbool_t)(f->shared->lf->feature_flags&feature))
 } /* end H5F_has_feature() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_has_vector_io
+ *
+ * Purpose:	Check if a file's driver carries out vector I/O requests
+ *		itself, rather than one piece at a time
+ *
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5F_has_vector_io(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI((hbool_t)(f->shared->lf->cls->read_vector && f->shared->lf->cls->write_vector))
+} /* end H5F_has_vector_io() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5F_get_driver_id
@@ -374,7 +374,6 @@ H5F__cache_superblock_deserialize(const void *_image, size_t len, void *_udata,
 
         } /* end if */
         else {
-            uint32_t computed_chksum;       /* Computed checksum  */
             uint32_t read_chksum;           /* Checksum read from file  */
 
             /* Size of file addresses */
@@ -404,14 +403,11 @@ H5F__cache_superblock_deserialize(const void *_image, size_t len, void *_udata,
             H5F_addr_decode(udata->f, (const uint8_t **)&image, &udata->stored_eof/*out*/);
             H5F_addr_decode(udata->f, (const uint8_t **)&image, &sblock->root_addr/*out*/);
 
-            /* Compute checksum for superblock */
-            computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
             /* Decode checksum */
             UINT32DECODE(image, read_chksum);
 
             /* Verify correct checksum */
-            if(read_chksum != computed_chksum)
+            if(!H5AC_verify_chksum(udata->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5F_SIZEOF_CHKSUM), read_chksum))
                 HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "bad checksum on driver information block")
 
             /* The Driver Information Block may not appear with the version
@@ -399,7 +399,6 @@ H5HF__cache_hdr_deserialize(const void *_image, size_t len, void *_udata,
     const uint8_t       *image = (const uint8_t *)_image;       /* Pointer into into supplied image */
     size_t              size;           /* Header size */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
     uint8_t             heap_flags;     /* Status flags for heap */
     void *              ret_value = NULL;       /* Return value */
 
@@ -530,10 +529,6 @@ H5HF__cache_hdr_deserialize(const void *_image, size_t len, void *_udata,
         /* Set the heap header's size */
         hdr->heap_size = size;
 
-    /* Compute checksum on entire header */
-    /* (including the filter information, if present) */
-    computed_chksum = H5_checksum_metadata(_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -541,7 +536,7 @@ H5HF__cache_hdr_deserialize(const void *_image, size_t len, void *_udata,
     HDassert((size_t)(image - (const uint8_t *)_image) == hdr->heap_size);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5HF_SIZEOF_CHKSUM), stored_chksum))
         HGOTO_ERROR(H5E_HEAP, H5E_BADVALUE, NULL, "incorrect metadata checksum for fractal heap header")
 
     /* Finish initialization of heap header */
@@ -903,7 +898,6 @@ H5HF__cache_iblock_deserialize(const void *_image, size_t len, void *_udata,
     const uint8_t       *image = (const uint8_t *)_image;       /* Pointer into raw data buffer */
     haddr_t             heap_addr;      /* Address of heap header in the file */
     uint32_t            stored_chksum;  /* Stored metadata checksum value */
-    uint32_t            computed_chksum; /* Computed metadata checksum value */
     unsigned            u;              /* Local index variable */
     void *              ret_value = NULL;       /* Return value */
 
@@ -1030,9 +1024,6 @@ H5HF__cache_iblock_deserialize(const void *_image, size_t len, void *_udata,
     /* Sanity check */
     HDassert(iblock->nchildren);   /* indirect blocks w/no children should have been deleted */
 
-    /* Compute checksum on indirect block */
-    computed_chksum = H5_checksum_metadata((const uint8_t *)_image, (size_t)(image - (const uint8_t *)_image), 0);
-
     /* Metadata checksum */
     UINT32DECODE(image, stored_chksum);
 
@@ -1040,7 +1031,7 @@ H5HF__cache_iblock_deserialize(const void *_image, size_t len, void *_udata,
     HDassert((size_t)(image - (const uint8_t *)_image) == iblock->size);
 
     /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    if(!H5AC_verify_chksum(udata->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5HF_SIZEOF_CHKSUM), stored_chksum))
         HGOTO_ERROR(H5E_HEAP, H5E_BADVALUE, NULL, "incorrect metadata checksum for fractal heap indirect block")
 
     /* Check if we have any indirect block children */
@@ -1650,14 +1641,16 @@ H5HF__cache_dblock_deserialize(const void *_image, size_t len, void *_udata,
 
         /* Allocate buffer to perform I/O filtering on and copy image into
          * it.  Must do this as H5Z_pipeline() may re-sized the buffer 
-         * provided to it.
+         * provided to it.  Make it large enough for the unfiltered block,
+         * which tells the filters how much output to expect.
          */
+        nbytes = read_size;
+        read_size = MAX(read_size, (size_t)dblock->size);
         if(NULL == (read_buf = H5MM_malloc(read_size)))
             HGOTO_ERROR(H5E_HEAP, H5E_NOSPACE, NULL, "memory allocation failed for pipeline buffer")
         HDmemcpy(read_buf, _image, len);
 
         /* Push direct block data through I/O filter pipeline */
-        nbytes = read_size;
         filter_mask = udata->filter_mask;
         if(H5Z_pipeline(&(hdr->pline), H5Z_FLAG_REVERSE, &filter_mask, H5Z_ENABLE_EDC, filter_cb, &nbytes, &read_size, &read_buf) < 0)
             HGOTO_ERROR(H5E_HEAP, H5E_CANTFILTER, NULL, "output pipeline failed")
@@ -1710,7 +1703,6 @@ H5HF__cache_dblock_deserialize(const void *_image, size_t len, void *_udata,
     /* Decode checksum on direct block, if requested */
     if(hdr->checksum_dblocks) {
         uint32_t stored_chksum;         /* Metadata checksum value */
-        uint32_t computed_chksum;       /* Computed metadata checksum value */
 
         /* Metadata checksum */
         UINT32DECODE(image, stored_chksum);
@@ -1719,11 +1711,8 @@ H5HF__cache_dblock_deserialize(const void *_image, size_t len, void *_udata,
         /* (Casting away const OK - QAK) */
         HDmemset((uint8_t *)image - H5HF_SIZEOF_CHKSUM, 0, (size_t)H5HF_SIZEOF_CHKSUM);
 
-        /* Compute checksum on entire direct block */
-        computed_chksum = H5_checksum_metadata(dblock->blk, dblock->size, 0);
-
-        /* Verify checksum */
-        if(stored_chksum != computed_chksum)
+        /* Verify checksum on entire direct block */
+        if(!H5AC_verify_chksum(udata->f, dblock->blk, dblock->size, stored_chksum))
             HGOTO_ERROR(H5E_HEAP, H5E_BADVALUE, NULL, "incorrect metadata checksum for fractal heap direct block")
     } /* end if */
 
@@ -393,7 +393,6 @@ H5O__layout_decode(H5F_t *f, hid_t H5_ATTR_UNUSED dxpl_id, H5O_t H5_ATTR_UNUSED
                     size_t tmp_size;
                     hsize_t tmp_hsize;
                     uint32_t stored_chksum;
-                    uint32_t computed_chksum;
                     size_t i;
 
                     /* Read heap */
@@ -490,11 +489,8 @@ H5O__layout_decode(H5F_t *f, hid_t H5_ATTR_UNUSED dxpl_id, H5O_t H5_ATTR_UNUSED
                     /* Read stored checksum */
                     UINT32DECODE(heap_block_p, stored_chksum)
 
-                    /* Compute checksum */
-                    computed_chksum = H5_checksum_metadata(heap_block, block_size - (size_t)4, 0);
-
                     /* Verify checksum */
-                    if(stored_chksum != computed_chksum)
+                    if(!H5AC_verify_chksum(f, heap_block, block_size - (size_t)4, stored_chksum))
                         HGOTO_ERROR(H5E_OHDR, H5E_BADVALUE, NULL, "incorrect metadata checksum for global heap block")
 
                     /* Verify that the heap block size is correct */
@@ -63,6 +63,26 @@
 #define H5D_ACS_PREEMPT_READ_CHUNKS_DEF         H5D_CHUNK_CACHE_W0_DEFAULT
 #define H5D_ACS_PREEMPT_READ_CHUNKS_ENC         H5P__encode_double
 #define H5D_ACS_PREEMPT_READ_CHUNKS_DEC         H5P__decode_double
+/* Definitions for chunk cache replacement policy */
+#define H5D_ACS_DATA_CACHE_POLICY_SIZE          sizeof(H5D_chunk_cache_policy_t)
+#define H5D_ACS_DATA_CACHE_POLICY_DEF           H5D_CHUNK_CACHE_LRU
+#define H5D_ACS_DATA_CACHE_POLICY_ENC           H5P__dacc_cache_policy_enc
+#define H5D_ACS_DATA_CACHE_POLICY_DEC           H5P__dacc_cache_policy_dec
+/* Definitions for chunk read-ahead */
+#define H5D_ACS_READ_AHEAD_SIZE                 sizeof(unsigned)
+#define H5D_ACS_READ_AHEAD_DEF                  0
+#define H5D_ACS_READ_AHEAD_ENC                  H5P__encode_unsigned
+#define H5D_ACS_READ_AHEAD_DEC                  H5P__decode_unsigned
+/* Definitions for writing back dirty chunks in address order */
+#define H5D_ACS_FLUSH_SORTED_SIZE               sizeof(hbool_t)
+#define H5D_ACS_FLUSH_SORTED_DEF                FALSE
+#define H5D_ACS_FLUSH_SORTED_ENC                H5P__encode_hbool_t
+#define H5D_ACS_FLUSH_SORTED_DEC                H5P__decode_hbool_t
+/* Definitions for the expected pattern of access to the raw data */
+#define H5D_ACS_ACCESS_ADVICE_SIZE              sizeof(H5FD_advice_t)
+#define H5D_ACS_ACCESS_ADVICE_DEF               H5FD_ADVICE_NORMAL
+#define H5D_ACS_ACCESS_ADVICE_ENC               H5P__dacc_access_advice_enc
+#define H5D_ACS_ACCESS_ADVICE_DEC               H5P__dacc_access_advice_dec
 /* Definitions for VDS view option */
 #define H5D_ACS_VDS_VIEW_SIZE                   sizeof(H5D_vds_view_t)
 #define H5D_ACS_VDS_VIEW_DEF                    H5D_VDS_LAST_AVAILABLE
@@ -112,6 +132,10 @@ static herr_t H5P__encode_chunk_cache_nbytes(const void *value, void **_pp,
 static herr_t H5P__decode_chunk_cache_nbytes(const void **_pp, void *_value);
 
 /* Property list callbacks */
+static herr_t H5P__dacc_cache_policy_enc(const void *value, void **pp, size_t *size);
+static herr_t H5P__dacc_cache_policy_dec(const void **pp, void *value);
+static herr_t H5P__dacc_access_advice_enc(const void *value, void **pp, size_t *size);
+static herr_t H5P__dacc_access_advice_dec(const void **pp, void *value);
 static herr_t H5P__dacc_vds_view_enc(const void *value, void **pp, size_t *size);
 static herr_t H5P__dacc_vds_view_dec(const void **pp, void *value);
 
@@ -182,6 +206,10 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
     size_t rdcc_nslots = H5D_ACS_DATA_CACHE_NUM_SLOTS_DEF;      /* Default raw data chunk cache # of slots */
     size_t rdcc_nbytes = H5D_ACS_DATA_CACHE_BYTE_SIZE_DEF;      /* Default raw data chunk cache # of bytes */
     double rdcc_w0 = H5D_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
+    H5D_chunk_cache_policy_t rdcc_policy = H5D_ACS_DATA_CACHE_POLICY_DEF;  /* Default raw data chunk cache replacement policy */
+    unsigned rdcc_read_ahead = H5D_ACS_READ_AHEAD_DEF;          /* Default # of chunks to read ahead */
+    hbool_t rdcc_flush_sorted = H5D_ACS_FLUSH_SORTED_DEF;       /* Default dirty chunk write back order */
+    H5FD_advice_t access_advice = H5D_ACS_ACCESS_ADVICE_DEF;    /* Default raw data access advice */
     H5D_vds_view_t virtual_view = H5D_ACS_VDS_VIEW_DEF;         /* Default VDS view option */
     hsize_t printf_gap = H5D_ACS_VDS_PRINTF_GAP_DEF;            /* Default VDS printf gap */
     herr_t ret_value = SUCCEED;         /* Return value */
@@ -203,6 +231,30 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
              NULL, NULL, NULL, H5D_ACS_PREEMPT_READ_CHUNKS_ENC, H5D_ACS_PREEMPT_READ_CHUNKS_DEC, NULL, NULL, NULL, NULL) < 0)
          HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the replacement policy for the raw data chunk cache */
+    if(H5P_register_real(pclass, H5D_ACS_DATA_CACHE_POLICY_NAME, H5D_ACS_DATA_CACHE_POLICY_SIZE, &rdcc_policy,
+            NULL, NULL, NULL, H5D_ACS_DATA_CACHE_POLICY_ENC, H5D_ACS_DATA_CACHE_POLICY_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the # of chunks to read ahead of sequential reads */
+    if(H5P_register_real(pclass, H5D_ACS_READ_AHEAD_NAME, H5D_ACS_READ_AHEAD_SIZE, &rdcc_read_ahead,
+            NULL, NULL, NULL, H5D_ACS_READ_AHEAD_ENC, H5D_ACS_READ_AHEAD_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register whether to write back dirty chunks in address order */
+    if(H5P_register_real(pclass, H5D_ACS_FLUSH_SORTED_NAME, H5D_ACS_FLUSH_SORTED_SIZE, &rdcc_flush_sorted,
+            NULL, NULL, NULL, H5D_ACS_FLUSH_SORTED_ENC, H5D_ACS_FLUSH_SORTED_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the expected pattern of access to the raw data */
+    if(H5P_register_real(pclass, H5D_ACS_ACCESS_ADVICE_NAME, H5D_ACS_ACCESS_ADVICE_SIZE, &access_advice,
+            NULL, NULL, NULL, H5D_ACS_ACCESS_ADVICE_ENC, H5D_ACS_ACCESS_ADVICE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the VDS view option */
     if(H5P_register_real(pclass, H5D_ACS_VDS_VIEW_NAME, H5D_ACS_VDS_VIEW_SIZE, &virtual_view,
             NULL, NULL, NULL, H5D_ACS_VDS_VIEW_ENC, H5D_ACS_VDS_VIEW_DEC,
@@ -615,6 +667,318 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_chunk_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_cache_policy
+ *
+ * Purpose:	Set the replacement policy of the raw data chunk cache for
+ *		datasets opened with this dataset access property list.
+ *
+ *		H5D_CHUNK_CACHE_LRU (the default) hashes each chunk into one
+ *		of RDCC_NSLOTS slots and preempts in approximate least
+ *		recently used order, weighted by RDCC_W0.  Two chunks that
+ *		hash to the same slot cannot be cached at the same time.
+ *
+ *		H5D_CHUNK_CACHE_2Q gives each cached chunk its own slot,
+ *		growing the slot table as needed (RDCC_NSLOTS is only the
+ *		initial size), and preempts using the 2Q algorithm: chunks
+ *		touched once are held in a short FIFO queue and only chunks
+ *		touched again after leaving it are promoted to the main LRU
+ *		queue, so a single pass over many chunks cannot flush the
+ *		frequently used ones.  RDCC_W0 is ignored.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_policy(hid_t dapl_id, H5D_chunk_cache_policy_t policy)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iDp", dapl_id, policy);
+
+    /* Check argument */
+    if((policy != H5D_CHUNK_CACHE_LRU) && (policy != H5D_CHUNK_CACHE_2Q))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a valid chunk cache policy")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_DATA_CACHE_POLICY_NAME, &policy) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set chunk cache policy")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_policy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_cache_policy
+ *
+ * Purpose:	Retrieves the replacement policy of the raw data chunk
+ *		cache set with H5Pset_chunk_cache_policy.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_policy(hid_t dapl_id, H5D_chunk_cache_policy_t *policy/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, policy);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(policy)
+        if(H5P_get(plist, H5D_ACS_DATA_CACHE_POLICY_NAME, policy) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get chunk cache policy")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_policy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_read_ahead
+ *
+ * Purpose:	Set the number of chunks to read ahead when a dataset
+ *		opened with this dataset access property list is read
+ *		sequentially.
+ *
+ *		Once a read touches the chunk that follows (in chunk index
+ *		order) the chunk touched by the previous read, up to
+ *		NCHUNKS of the next allocated chunks are read from the file
+ *		in order of their addresses, run through the filter
+ *		pipeline and placed in the chunk cache.  The number of
+ *		chunks is limited to what the chunk cache can hold.
+ *		Zero (the default) disables read-ahead.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_read_ahead(hid_t dapl_id, unsigned nchunks)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5D_ACS_READ_AHEAD_NAME, &nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set chunk read-ahead")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_read_ahead
+ *
+ * Purpose:	Retrieves the number of chunks to read ahead set with
+ *		H5Pset_chunk_read_ahead.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_read_ahead(hid_t dapl_id, unsigned *nchunks/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(nchunks)
+        if(H5P_get(plist, H5D_ACS_READ_AHEAD_NAME, nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get chunk read-ahead")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_flush_sorted
+ *
+ * Purpose:	Set whether the dirty chunks in the chunk cache of a dataset
+ *		opened with this dataset access property list are written
+ *		back to the file together, in order of their addresses.
+ *
+ *		When set, flushing the dataset writes all of its dirty
+ *		chunks together, and the dirty chunks preempted from its
+ *		chunk cache to make room for another chunk are written
+ *		together: space for new chunks is allocated in chunk index
+ *		order, so that they tend to be contiguous in the file, and
+ *		runs of adjacent chunks are written with single I/O
+ *		operations.  This avoids many small random writes when a
+ *		dataset with a large chunk cache is flushed or closed.
+ *		The default (FALSE) writes each chunk as it is preempted,
+ *		in least recently used order.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_flush_sorted(hid_t dapl_id, hbool_t sorted)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", dapl_id, sorted);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5D_ACS_FLUSH_SORTED_NAME, &sorted) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set sorted chunk flush")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_flush_sorted() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_flush_sorted
+ *
+ * Purpose:	Retrieves whether dirty chunks are written back in address
+ *		order, set with H5Pset_chunk_flush_sorted.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_flush_sorted(hid_t dapl_id, hbool_t *sorted/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, sorted);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(sorted)
+        if(H5P_get(plist, H5D_ACS_FLUSH_SORTED_NAME, sorted) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get sorted chunk flush")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_flush_sorted() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_access_advice
+ *
+ * Purpose:	Set the expected pattern of access to the raw data of
+ *		datasets opened with this dataset access property list.
+ *
+ *		When a contiguous dataset is opened in a file that the
+ *		driver maps into memory (H5FD_MMAP), the advice is passed
+ *		on to the operating system for the dataset's storage:
+ *		H5FD_ADVICE_SEQUENTIAL lets it read ahead aggressively and
+ *		drop pages soon after they are read, H5FD_ADVICE_RANDOM
+ *		stops it reading ahead, and H5FD_ADVICE_WILLNEED starts
+ *		reading the whole dataset in right away.  Other drivers
+ *		and layouts ignore the advice.  H5FD_ADVICE_NORMAL (the
+ *		default) gives no advice.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_access_advice(hid_t dapl_id, H5FD_advice_t advice)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iDA", dapl_id, advice);
+
+    /* Check argument */
+    if(advice < H5FD_ADVICE_NORMAL || advice > H5FD_ADVICE_WILLNEED)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a valid access advice")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_ACCESS_ADVICE_NAME, &advice) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set access advice")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_access_advice() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_access_advice
+ *
+ * Purpose:	Retrieves the expected pattern of access to the raw data
+ *		set with H5Pset_access_advice.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_access_advice(hid_t dapl_id, H5FD_advice_t *advice/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, advice);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(advice)
+        if(H5P_get(plist, H5D_ACS_ACCESS_ADVICE_NAME, advice) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get access advice")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_access_advice() */
+
 
 /*-------------------------------------------------------------------------
  * Function:       H5P__encode_chunk_cache_nslots
@@ -991,6 +1355,140 @@ H5P__dacc_vds_view_dec(const void **_pp, void *_value)
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* end H5P__dacc_vds_view_dec() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5P__dacc_cache_policy_enc
+ *
+ * Purpose:     Callback routine which is called whenever the chunk cache
+ *              policy property in the dataset access property list is
+ *              encoded.
+ *
+ * Return:      Success:        Non-negative
+ *              Failure:        Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dacc_cache_policy_enc(const void *value, void **_pp, size_t *size)
+{
+    const H5D_chunk_cache_policy_t *policy = (const H5D_chunk_cache_policy_t *)value; /* Create local alias for values */
+    uint8_t **pp = (uint8_t **)_pp;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(policy);
+    HDassert(size);
+
+    if(NULL != *pp)
+        /* Encode chunk cache policy property */
+        *(*pp)++ = (uint8_t)*policy;
+
+    /* Size of chunk cache policy property */
+    (*size)++;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5P__dacc_cache_policy_enc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5P__dacc_cache_policy_dec
+ *
+ * Purpose:     Callback routine which is called whenever the chunk cache
+ *              policy property in the dataset access property list is
+ *              decoded.
+ *
+ * Return:      Success:        Non-negative
+ *              Failure:        Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dacc_cache_policy_dec(const void **_pp, void *_value)
+{
+    H5D_chunk_cache_policy_t *policy = (H5D_chunk_cache_policy_t *)_value;
+    const uint8_t **pp = (const uint8_t **)_pp;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(pp);
+    HDassert(*pp);
+    HDassert(policy);
+
+    /* Decode chunk cache policy property */
+    *policy = (H5D_chunk_cache_policy_t)*(*pp)++;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5P__dacc_cache_policy_dec() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5P__dacc_access_advice_enc
+ *
+ * Purpose:     Callback routine which is called whenever the access
+ *              advice property in the dataset access property list is
+ *              encoded.
+ *
+ * Return:      Success:        Non-negative
+ *              Failure:        Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dacc_access_advice_enc(const void *value, void **_pp, size_t *size)
+{
+    const H5FD_advice_t *advice = (const H5FD_advice_t *)value; /* Create local alias for values */
+    uint8_t **pp = (uint8_t **)_pp;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(advice);
+    HDassert(size);
+
+    if(NULL != *pp)
+        /* Encode access advice property */
+        *(*pp)++ = (uint8_t)*advice;
+
+    /* Size of access advice property */
+    (*size)++;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5P__dacc_access_advice_enc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5P__dacc_access_advice_dec
+ *
+ * Purpose:     Callback routine which is called whenever the access
+ *              advice property in the dataset access property list is
+ *              decoded.
+ *
+ * Return:      Success:        Non-negative
+ *              Failure:        Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dacc_access_advice_dec(const void **_pp, void *_value)
+{
+    H5FD_advice_t *advice = (H5FD_advice_t *)_value;
+    const uint8_t **pp = (const uint8_t **)_pp;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(pp);
+    HDassert(*pp);
+    HDassert(advice);
+
+    /* Decode access advice property */
+    *advice = (H5FD_advice_t)*(*pp)++;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5P__dacc_access_advice_dec() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_virtual_printf_gap
@@ -120,6 +120,11 @@
 #define H5D_CRT_EXT_FILE_LIST_COPY H5P__dcrt_ext_file_list_copy
 #define H5D_CRT_EXT_FILE_LIST_CMP  H5P__dcrt_ext_file_list_cmp
 #define H5D_CRT_EXT_FILE_LIST_CLOSE H5P__dcrt_ext_file_list_close
+/* Definitions for the store-raw size ratio */
+#define H5D_CRT_STORE_RAW_SIZE     sizeof(double)
+#define H5D_CRT_STORE_RAW_DEF      0.0
+#define H5D_CRT_STORE_RAW_ENC      H5P__encode_double
+#define H5D_CRT_STORE_RAW_DEC      H5P__decode_double
 
 
 /******************/
@@ -212,6 +217,7 @@ static const H5O_layout_t H5D_def_layout_g = H5D_CRT_LAYOUT_DEF;        /* Defau
 static const H5O_fill_t H5D_def_fill_g = H5D_CRT_FILL_VALUE_DEF;        /* Default fill value */
 static const unsigned H5D_def_alloc_time_state_g = H5D_CRT_ALLOC_TIME_STATE_DEF;  /* Default allocation time state */
 static const H5O_efl_t H5D_def_efl_g = H5D_CRT_EXT_FILE_LIST_DEF;                 /* Default external file list */
+static const double H5D_def_store_raw_g = H5D_CRT_STORE_RAW_DEF;                  /* Default store-raw size ratio */
 
 /* Defaults for each type of layout */
 #ifdef H5_HAVE_C99_DESIGNATED_INITIALIZER
@@ -271,6 +277,12 @@ H5P__dcrt_reg_prop(H5P_genclass_t *pclass)
             H5D_CRT_EXT_FILE_LIST_DEL, H5D_CRT_EXT_FILE_LIST_COPY, H5D_CRT_EXT_FILE_LIST_CMP, H5D_CRT_EXT_FILE_LIST_CLOSE) < 0)
        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the store-raw size ratio property */
+    if(H5P_register_real(pclass, H5D_CRT_STORE_RAW_NAME, H5D_CRT_STORE_RAW_SIZE, &H5D_def_store_raw_g,
+            NULL, NULL, NULL, H5D_CRT_STORE_RAW_ENC, H5D_CRT_STORE_RAW_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dcrt_reg_prop() */
@@ -2723,6 +2735,90 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_chunk_opts() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_store_raw
+ *
+ * Purpose:     Sets the size ratio above which the chunks of a filtered
+ *              dataset are stored unfiltered.  When the filter pipeline
+ *              shrinks a chunk to no less than RATIO times its raw size,
+ *              the chunk is written raw instead, with the filters marked
+ *              as skipped in the chunk's filter mask (a fletcher32
+ *              checksum is still computed).  After a chunk is stored raw
+ *              the next chunks are stored raw without trying the filters,
+ *              for a number of chunks that doubles with each further
+ *              incompressible chunk, up to 16.  (A chunk preempted from
+ *              the chunk cache just after chunks which did compress is
+ *              filtered in place, so it keeps the filter output, but
+ *              the chunks after it are still stored raw.)
+ *
+ *              A RATIO of 0 (the default) always keeps the filter
+ *              output.  The ratio is not stored in the file: it only
+ *              affects the chunks written through the dataset created
+ *              with this property list, while it stays open.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_store_raw(hid_t plist_id, double ratio)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "id", plist_id, ratio);
+
+    /* Check arguments */
+    if(ratio < 0.0 || ratio > 1.0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "store-raw ratio must be between 0 and 1")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set the ratio */
+    if(H5P_set(plist, H5D_CRT_STORE_RAW_NAME, &ratio) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set store-raw ratio")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_store_raw() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_store_raw
+ *
+ * Purpose:     Retrieves the size ratio above which chunks are stored
+ *              unfiltered (see H5Pset_chunk_store_raw).
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_store_raw(hid_t plist_id, double *ratio/*out*/)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, ratio);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get the ratio */
+    if(ratio)
+        if(H5P_get(plist, H5D_CRT_STORE_RAW_NAME, ratio) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get store-raw ratio")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_store_raw() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_external
@@ -3038,6 +3134,49 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pset_shuffle() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_bitshuffle_lz
+ *
+ * Purpose:	Sets the bitshuffle+lz filter, H5Z_FILTER_BITSHUFFLE_LZ,
+ *		which transposes the elements of each chunk into bit planes
+ *		and compresses them with a fast LZ codec.  The filter is
+ *		built into the library, so needs no plugin to be read.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_bitshuffle_lz(hid_t plist_id)
+{
+    H5O_pline_t         pline;
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value=SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", plist_id);
+
+    /* Check arguments */
+    if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_CREATE))
+        HGOTO_ERROR (H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset creation property list")
+
+    /* Get the plist structure */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(plist_id)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Add the filter */
+    if(H5P_peek(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get pipeline")
+    if(H5Z_append(&pline, H5Z_FILTER_BITSHUFFLE_LZ, H5Z_FLAG_OPTIONAL, (size_t)0, NULL) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to add bitshuffle+lz filter to pipeline")
+    if(H5P_poke(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to set pipeline")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_bitshuffle_lz() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_nbit
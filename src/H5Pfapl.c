@@ -78,6 +78,11 @@
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEF         0.75f
 #define H5F_ACS_PREEMPT_READ_CHUNKS_ENC         H5P__encode_double
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEC         H5P__decode_double
+/* Definition for size of file-wide raw data chunk cache(bytes) */
+#define H5F_ACS_DATA_CACHE_SHARED_NBYTES_SIZE   sizeof(size_t)
+#define H5F_ACS_DATA_CACHE_SHARED_NBYTES_DEF    0
+#define H5F_ACS_DATA_CACHE_SHARED_NBYTES_ENC    H5P__encode_size_t
+#define H5F_ACS_DATA_CACHE_SHARED_NBYTES_DEC    H5P__decode_size_t
 /* Definition for threshold for alignment */
 #define H5F_ACS_ALIGN_THRHD_SIZE                sizeof(hsize_t)
 #define H5F_ACS_ALIGN_THRHD_DEF                 1
@@ -181,6 +186,28 @@
 /* Definition for object flush callback */
 #define H5F_ACS_OBJECT_FLUSH_CB_SIZE		sizeof(H5F_object_flush_t)
 #define H5F_ACS_OBJECT_FLUSH_CB_DEF             {NULL, NULL}
+/* Definition for 'skip metadata checksums' flag */
+#define H5F_ACS_SKIP_MD_CHKSUM_SIZE             sizeof(hbool_t)
+#define H5F_ACS_SKIP_MD_CHKSUM_DEF              FALSE
+#define H5F_ACS_SKIP_MD_CHKSUM_ENC              H5P__encode_hbool_t
+#define H5F_ACS_SKIP_MD_CHKSUM_DEC              H5P__decode_hbool_t
+/* Definitions for the page buffer's size, page size and minimum shares */
+#define H5F_ACS_PAGE_BUF_SIZE_SIZE              sizeof(size_t)
+#define H5F_ACS_PAGE_BUF_SIZE_DEF               0
+#define H5F_ACS_PAGE_BUF_SIZE_ENC               H5P__encode_size_t
+#define H5F_ACS_PAGE_BUF_SIZE_DEC               H5P__decode_size_t
+#define H5F_ACS_PAGE_BUF_PAGE_SIZE_SIZE         sizeof(size_t)
+#define H5F_ACS_PAGE_BUF_PAGE_SIZE_DEF          4096
+#define H5F_ACS_PAGE_BUF_PAGE_SIZE_ENC          H5P__encode_size_t
+#define H5F_ACS_PAGE_BUF_PAGE_SIZE_DEC          H5P__decode_size_t
+#define H5F_ACS_PAGE_BUF_MIN_META_PERC_SIZE     sizeof(unsigned)
+#define H5F_ACS_PAGE_BUF_MIN_META_PERC_DEF      0
+#define H5F_ACS_PAGE_BUF_MIN_META_PERC_ENC      H5P__encode_unsigned
+#define H5F_ACS_PAGE_BUF_MIN_META_PERC_DEC      H5P__decode_unsigned
+#define H5F_ACS_PAGE_BUF_MIN_RAW_PERC_SIZE      sizeof(unsigned)
+#define H5F_ACS_PAGE_BUF_MIN_RAW_PERC_DEF       0
+#define H5F_ACS_PAGE_BUF_MIN_RAW_PERC_ENC       H5P__encode_unsigned
+#define H5F_ACS_PAGE_BUF_MIN_RAW_PERC_DEC       H5P__decode_unsigned
 #ifdef H5_HAVE_PARALLEL
 /* Definition of collective metadata read mode flag */
 #define H5F_ACS_COLL_MD_READ_FLAG_SIZE   sizeof(H5P_coll_md_read_flag_t)
@@ -278,6 +305,7 @@ static const H5AC_cache_config_t H5F_def_mdc_initCacheCfg_g = H5F_ACS_META_CACHE
 static const size_t H5F_def_rdcc_nslots_g = H5F_ACS_DATA_CACHE_NUM_SLOTS_DEF;      /* Default raw data chunk cache # of slots */
 static const size_t H5F_def_rdcc_nbytes_g = H5F_ACS_DATA_CACHE_BYTE_SIZE_DEF;      /* Default raw data chunk cache # of bytes */
 static const double H5F_def_rdcc_w0_g = H5F_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
+static const size_t H5F_def_rdcc_shared_nbytes_g = H5F_ACS_DATA_CACHE_SHARED_NBYTES_DEF; /* Default file-wide raw data chunk cache # of bytes */
 static const hsize_t H5F_def_threshold_g = H5F_ACS_ALIGN_THRHD_DEF;                /* Default allocation alignment threshold */
 static const hsize_t H5F_def_alignment_g = H5F_ACS_ALIGN_DEF;                      /* Default allocation alignment value */
 static const hsize_t H5F_def_meta_block_size_g = H5F_ACS_META_BLOCK_SIZE_DEF;      /* Default metadata allocation block size */
@@ -296,6 +324,11 @@ static const H5FD_file_image_info_t H5F_def_file_image_info_g = H5F_ACS_FILE_IMA
 static const hbool_t H5F_def_core_write_tracking_flag_g = H5F_ACS_CORE_WRITE_TRACKING_FLAG_DEF;              /* Default setting for core VFD write tracking */
 static const size_t H5F_def_core_write_tracking_page_size_g = H5F_ACS_CORE_WRITE_TRACKING_PAGE_SIZE_DEF;     /* Default core VFD write tracking page size */
 static const H5F_object_flush_t H5F_def_object_flush_cb_g = H5F_ACS_OBJECT_FLUSH_CB_DEF;      /* Default setting for object flush callback */
+static const hbool_t H5F_def_skip_md_chksum_g = H5F_ACS_SKIP_MD_CHKSUM_DEF;        /* Default setting for "skip metadata checksums" flag */
+static const size_t H5F_def_page_buf_size_g = H5F_ACS_PAGE_BUF_SIZE_DEF;          /* Default page buffer size */
+static const size_t H5F_def_page_buf_page_size_g = H5F_ACS_PAGE_BUF_PAGE_SIZE_DEF; /* Default page buffer page size */
+static const unsigned H5F_def_page_buf_min_meta_perc_g = H5F_ACS_PAGE_BUF_MIN_META_PERC_DEF; /* Default minimum share of the page buffer for metadata */
+static const unsigned H5F_def_page_buf_min_raw_perc_g = H5F_ACS_PAGE_BUF_MIN_RAW_PERC_DEF;   /* Default minimum share of the page buffer for raw data */
 #ifdef H5_HAVE_PARALLEL
 static const H5P_coll_md_read_flag_t H5F_def_coll_md_read_flag_g = H5F_ACS_COLL_MD_READ_FLAG_DEF;  /* Default setting for the collective metedata read flag */
 static const hbool_t H5F_def_coll_md_write_flag_g = H5F_ACS_COLL_MD_WRITE_FLAG_DEF;  /* Default setting for the collective metedata write flag */
@@ -345,6 +378,12 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the size of the file-wide raw data chunk cache(bytes) */
+    if(H5P_register_real(pclass, H5F_ACS_DATA_CACHE_SHARED_NBYTES_NAME, H5F_ACS_DATA_CACHE_SHARED_NBYTES_SIZE, &H5F_def_rdcc_shared_nbytes_g,
+            NULL, NULL, NULL, H5F_ACS_DATA_CACHE_SHARED_NBYTES_ENC, H5F_ACS_DATA_CACHE_SHARED_NBYTES_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the threshold for alignment */
     if(H5P_register_real(pclass, H5F_ACS_ALIGN_THRHD_NAME, H5F_ACS_ALIGN_THRHD_SIZE, &H5F_def_threshold_g, 
             NULL, NULL, NULL, H5F_ACS_ALIGN_THRHD_ENC, H5F_ACS_ALIGN_THRHD_DEC, 
@@ -462,6 +501,36 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the 'skip metadata checksums' flag */
+    if(H5P_register_real(pclass, H5F_ACS_SKIP_MD_CHKSUM_NAME, H5F_ACS_SKIP_MD_CHKSUM_SIZE, &H5F_def_skip_md_chksum_g,
+            NULL, NULL, NULL, H5F_ACS_SKIP_MD_CHKSUM_ENC, H5F_ACS_SKIP_MD_CHKSUM_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the page buffer size */
+    if(H5P_register_real(pclass, H5F_ACS_PAGE_BUF_SIZE_NAME, H5F_ACS_PAGE_BUF_SIZE_SIZE, &H5F_def_page_buf_size_g,
+            NULL, NULL, NULL, H5F_ACS_PAGE_BUF_SIZE_ENC, H5F_ACS_PAGE_BUF_SIZE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the page buffer page size */
+    if(H5P_register_real(pclass, H5F_ACS_PAGE_BUF_PAGE_SIZE_NAME, H5F_ACS_PAGE_BUF_PAGE_SIZE_SIZE, &H5F_def_page_buf_page_size_g,
+            NULL, NULL, NULL, H5F_ACS_PAGE_BUF_PAGE_SIZE_ENC, H5F_ACS_PAGE_BUF_PAGE_SIZE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the minimum share of the page buffer for metadata */
+    if(H5P_register_real(pclass, H5F_ACS_PAGE_BUF_MIN_META_PERC_NAME, H5F_ACS_PAGE_BUF_MIN_META_PERC_SIZE, &H5F_def_page_buf_min_meta_perc_g,
+            NULL, NULL, NULL, H5F_ACS_PAGE_BUF_MIN_META_PERC_ENC, H5F_ACS_PAGE_BUF_MIN_META_PERC_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the minimum share of the page buffer for raw data */
+    if(H5P_register_real(pclass, H5F_ACS_PAGE_BUF_MIN_RAW_PERC_NAME, H5F_ACS_PAGE_BUF_MIN_RAW_PERC_SIZE, &H5F_def_page_buf_min_raw_perc_g,
+            NULL, NULL, NULL, H5F_ACS_PAGE_BUF_MIN_RAW_PERC_ENC, H5F_ACS_PAGE_BUF_MIN_RAW_PERC_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 #ifdef H5_HAVE_PARALLEL
     /* Register the metadata collective read flag */
     if(H5P_register_real(pclass, H5_COLL_MD_READ_FLAG_NAME, H5F_ACS_COLL_MD_READ_FLAG_SIZE, &H5F_def_coll_md_read_flag_g, 
@@ -1462,6 +1531,81 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_shared_chunk_cache
+ *
+ * Purpose:	Set the size of a raw data chunk cache that is shared by
+ *		all the chunked datasets open in the file.  Chunks of all
+ *		the datasets are preempted in least recently used order
+ *		(across the datasets) to keep the total size of the cached
+ *		chunks within NBYTES.
+ *
+ *		Datasets still have their own chunk caches (whose slots
+ *		and preemption policy are set as usual), but those that
+ *		don't set a size on their dataset access property lists
+ *		may use the whole shared size instead of the file's
+ *		default per-dataset size.  A value of zero (the default)
+ *		disables the shared cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_shared_chunk_cache(hid_t plist_id, size_t nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set size */
+    if(H5P_set(plist, H5F_ACS_DATA_CACHE_SHARED_NBYTES_NAME, &nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET,FAIL, "can't set file-wide data cache byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_shared_chunk_cache() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_shared_chunk_cache
+ *
+ * Purpose:	Retrieves the size of the raw data chunk cache shared by
+ *		all the chunked datasets in the file (zero if disabled).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_shared_chunk_cache(hid_t plist_id, size_t *nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get size */
+    if(nbytes)
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_SHARED_NBYTES_NAME, nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get file-wide data cache byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_shared_chunk_cache() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_mdc_config
@@ -2160,6 +2304,192 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_libver_bounds() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_skip_metadata_checksums
+ *
+ * Purpose:	Sets whether files opened with this file access property
+ *		list skip verifying the checksums of metadata as it is
+ *		loaded into the metadata cache.  This is for files on
+ *		storage that is already verified end-to-end, where the
+ *		checks only cost time.  Checksums are still computed and
+ *		stored when metadata is written, so the files stay valid
+ *		for readers that do verify them.
+ *
+ *		This doesn't affect the fletcher32 filter on raw data; see
+ *		H5Pset_edc_check() for that.  H5Fget_mdc_chksum_stats()
+ *		reports the verifications skipped.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_skip_metadata_checksums(hid_t plist_id, hbool_t skip)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", plist_id, skip);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5F_ACS_SKIP_MD_CHKSUM_NAME, &skip) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set 'skip metadata checksums' flag")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_skip_metadata_checksums() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_skip_metadata_checksums
+ *
+ * Purpose:	Retrieves whether files opened with this file access
+ *		property list skip verifying metadata checksums on load.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_skip_metadata_checksums(hid_t plist_id, hbool_t *skip/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, skip);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(skip)
+        if(H5P_get(plist, H5F_ACS_SKIP_MD_CHKSUM_NAME, skip) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get 'skip metadata checksums' flag")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_skip_metadata_checksums() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_page_buffer
+ *
+ * Purpose:	Sets up a page buffer of BUF_SIZE bytes for files opened
+ *		with this file access property list.  The page buffer
+ *		caches the file in aligned pages of PAGE_SIZE bytes, which
+ *		must be a power of two of at least 512.  Metadata and raw
+ *		data I/O smaller than a page is made on the buffered pages,
+ *		and reaches the file only as whole pages, read when a page
+ *		is first touched and written when a dirty page is evicted or
+ *		the file is flushed.  Larger I/O goes to the file directly.
+ *		Pages are evicted least recently used first, but at least
+ *		MIN_META_PERC percent of the pages are kept for metadata and
+ *		MIN_RAW_PERC percent for raw data, once they are in use.
+ *		The page buffer replaces the metadata accumulator.
+ *
+ *		Unless an alignment has been set with H5Pset_alignment(),
+ *		objects of a page or more are aligned on page boundaries,
+ *		and metadata and "small" raw data are aggregated into whole
+ *		pages, so that new metadata and raw data don't share pages.
+ *
+ *		A BUF_SIZE of zero, the default, disables the page buffer.
+ *		The page buffer is not available with parallel I/O, nor
+ *		with the multi and split drivers.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_page_buffer(hid_t plist_id, size_t page_size, size_t buf_size,
+    unsigned min_meta_perc, unsigned min_raw_perc)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE5("e", "izzIuIu", plist_id, page_size, buf_size, min_meta_perc,
+             min_raw_perc);
+
+    /* Check args */
+    if(page_size < 512 || (page_size & (page_size - 1)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "page size must be a power of two of at least 512")
+    if(buf_size > 0 && buf_size < page_size)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "page buffer size must hold at least one page")
+    if(min_meta_perc > 100 || min_raw_perc > 100 || min_meta_perc + min_raw_perc > 100)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "minimum metadata and raw data percentages can't add up to more than 100")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set values */
+    if(H5P_set(plist, H5F_ACS_PAGE_BUF_PAGE_SIZE_NAME, &page_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer page size")
+    if(H5P_set(plist, H5F_ACS_PAGE_BUF_SIZE_NAME, &buf_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer size")
+    if(H5P_set(plist, H5F_ACS_PAGE_BUF_MIN_META_PERC_NAME, &min_meta_perc) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set minimum metadata percentage of page buffer")
+    if(H5P_set(plist, H5F_ACS_PAGE_BUF_MIN_RAW_PERC_NAME, &min_raw_perc) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set minimum raw data percentage of page buffer")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_page_buffer() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_page_buffer
+ *
+ * Purpose:	Retrieves the page buffer settings from a file access
+ *		property list.  Any of the pointers may be null.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_page_buffer(hid_t plist_id, size_t *page_size/*out*/,
+    size_t *buf_size/*out*/, unsigned *min_meta_perc/*out*/,
+    unsigned *min_raw_perc/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE5("e", "ixxxx", plist_id, page_size, buf_size, min_meta_perc,
+             min_raw_perc);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get values */
+    if(page_size)
+        if(H5P_get(plist, H5F_ACS_PAGE_BUF_PAGE_SIZE_NAME, page_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get page buffer page size")
+    if(buf_size)
+        if(H5P_get(plist, H5F_ACS_PAGE_BUF_SIZE_NAME, buf_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get page buffer size")
+    if(min_meta_perc)
+        if(H5P_get(plist, H5F_ACS_PAGE_BUF_MIN_META_PERC_NAME, min_meta_perc) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get minimum metadata percentage of page buffer")
+    if(min_raw_perc)
+        if(H5P_get(plist, H5F_ACS_PAGE_BUF_MIN_RAW_PERC_NAME, min_raw_perc) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get minimum raw data percentage of page buffer")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_page_buffer() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_elink_file_cache_size
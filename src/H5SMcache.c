@@ -184,7 +184,6 @@ H5SM__cache_table_deserialize(const void *_image, size_t len, void *_udata,
     H5SM_table_cache_ud_t  *udata = (H5SM_table_cache_ud_t *)_udata;    /* Pointer to user data */
     const uint8_t          *image = (const uint8_t *)_image;    /* Pointer into input buffer */
     uint32_t                stored_chksum;      /* Stored metadata checksum value */
-    uint32_t                computed_chksum;    /* Computed metadata checksum value */
     size_t                  u;                  /* Counter variable for index headers */
     void                   *ret_value = NULL;   /* Return value */
 
@@ -266,11 +265,8 @@ H5SM__cache_table_deserialize(const void *_image, size_t len, void *_udata,
     /* Sanity check */
     HDassert((size_t)(image - (const uint8_t *)_image) == table->table_size);
 
-    /* Compute checksum on entire header */
-    computed_chksum = H5_checksum_metadata(_image, (table->table_size - H5SM_SIZEOF_CHECKSUM), 0);
-
-    /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    /* Verify checksum on entire header */
+    if(!H5AC_verify_chksum(f, _image, (table->table_size - H5SM_SIZEOF_CHECKSUM), stored_chksum))
         HGOTO_ERROR(H5E_SOHM, H5E_BADVALUE, NULL, "incorrect metadata checksum for shared message table")
 
     /* Set return value */
@@ -508,7 +504,6 @@ H5SM__cache_list_deserialize(const void *_image, size_t len, void *_udata,
     H5SM_bt2_ctx_t        ctx;             /* Message encoding context */
     const uint8_t        *image = (const uint8_t *)_image;      /* Pointer into input buffer */
     uint32_t              stored_chksum;   /* Stored metadata checksum value */
-    uint32_t              computed_chksum; /* Computed metadata checksum value */
     size_t                u;               /* Counter variable for messages in list */
     void                 *ret_value = NULL;   /* Return value */
 
@@ -552,11 +547,8 @@ H5SM__cache_list_deserialize(const void *_image, size_t len, void *_udata,
     /* Sanity check */
     HDassert((size_t)(image - (const uint8_t *)_image) <= udata->header->list_size);
 
-    /* Compute checksum on entire header */
-    computed_chksum = H5_checksum_metadata(_image, ((size_t)(image - (const uint8_t *)_image) - H5SM_SIZEOF_CHECKSUM), 0);
-
-    /* Verify checksum */
-    if(stored_chksum != computed_chksum)
+    /* Verify checksum on entire list */
+    if(!H5AC_verify_chksum(udata->f, _image, ((size_t)(image - (const uint8_t *)_image) - H5SM_SIZEOF_CHECKSUM), stored_chksum))
         HGOTO_ERROR(H5E_SOHM, H5E_BADVALUE, NULL, "incorrect metadata checksum for shared message list")
 
     /* Initialize the rest of the array */
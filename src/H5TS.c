@@ -520,4 +520,42 @@ H5TS_create_thread(void *(*func)(void *), H5TS_attr_t *attr, void *udata)
 
 } /* H5TS_create_thread */
 
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_try_create_thread
+ *
+ * RETURNS
+ *    Non-negative on success / Negative if the thread couldn't be created
+ *
+ * DESCRIPTION
+ *    Spawn off a new thread calling function 'func' with input 'udata',
+ *    like H5TS_create_thread, but report whether that worked.  The new
+ *    thread's identifier is returned in 'thread', which is only valid
+ *    on success.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_try_create_thread(H5TS_thread_t *thread, void *(*func)(void *),
+    H5TS_attr_t *attr, void *udata)
+{
+    herr_t ret_value = SUCCEED;
+
+#ifdef  H5_HAVE_WIN_THREADS
+
+    if(NULL == (*thread = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)func, udata, 0, NULL)))
+        ret_value = FAIL;
+
+#else /* H5_HAVE_WIN_THREADS */
+
+    if(0 != pthread_create(thread, attr, (void * (*)(void *))func, udata))
+        ret_value = FAIL;
+
+#endif /* H5_HAVE_WIN_THREADS */
+
+    return ret_value;
+
+} /* H5TS_try_create_thread */
+
 #endif  /* H5_HAVE_THREADSAFE */
@@ -54,6 +54,29 @@ typedef enum {
     H5Z_PRELUDE_SET_LOCAL       /* Call "set local" callback */
 } H5Z_prelude_type_t;
 
+/* Number of buffers kept for reuse by the pool below, and their maximum
+ * total size
+ */
+#define H5Z_BUF_POOL_NBUFS      16
+#define H5Z_BUF_POOL_NBYTES     (64 * 1024 * 1024)
+
+/*
+ * Buffers released by the filters and the chunk cache, kept for reuse.
+ * They are ordinary H5MM_malloc() blocks, so a buffer handed out by the
+ * pool can be reallocated or freed like any other pipeline buffer, also
+ * by filters which know nothing about the pool.
+ */
+typedef struct H5Z_buf_pool_t {
+    void        *buf[H5Z_BUF_POOL_NBUFS];   /* Buffers in the pool */
+    size_t      size[H5Z_BUF_POOL_NBUFS];   /* Size of each buffer */
+    size_t      nbufs;                      /* # of buffers in the pool */
+    size_t      nbytes;                     /* Total size of the buffers */
+#ifdef H5_HAVE_THREADSAFE
+    hbool_t     lock_init;                  /* Whether the lock is initialized */
+    H5TS_mutex_simple_t lock;               /* Protects the pool from concurrent decode threads */
+#endif /* H5_HAVE_THREADSAFE */
+} H5Z_buf_pool_t;
+
 /* Package initialization variable */
 hbool_t H5_PKG_INIT_VAR = FALSE;
 
@@ -64,6 +87,7 @@ static H5Z_class2_t	*H5Z_table_g = NULL;
 #ifdef H5Z_DEBUG
 static H5Z_stats_t	*H5Z_stat_table_g = NULL;
 #endif /* H5Z_DEBUG */
+static H5Z_buf_pool_t   H5Z_buf_pool_g;
 
 /* Local functions */
 static int H5Z_find_idx(H5Z_filter_t id);
@@ -91,6 +115,14 @@ H5Z__init_package(void)
 
     FUNC_ENTER_PACKAGE
 
+#ifdef H5_HAVE_THREADSAFE
+    /* Set up the lock for the buffer pool */
+    if(!H5Z_buf_pool_g.lock_init) {
+        H5TS_mutex_init(&H5Z_buf_pool_g.lock);
+        H5Z_buf_pool_g.lock_init = TRUE;
+    } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
+
     /* Internal filters */
     if(H5Z_register(H5Z_SHUFFLE) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register shuffle filter")
@@ -100,9 +132,13 @@ H5Z__init_package(void)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register nbit filter")
     if(H5Z_register(H5Z_SCALEOFFSET) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register scaleoffset filter")
+    if(H5Z_register(H5Z_BITSHUFFLE_LZ) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register bitshuffle+lz filter")
 
     /* External filters */
 #ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Z__deflate_init() < 0)
+        HGOTO_ERROR (H5E_PLINE, H5E_CANTINIT, FAIL, "unable to initialize deflate filter")
     if(H5Z_register(H5Z_DEFLATE) < 0)
         HGOTO_ERROR (H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register deflate filter")
 #endif /* H5_HAVE_FILTER_DEFLATE */
@@ -200,6 +236,23 @@ H5Z_term_package(void)
             n++;
         } /* end if */
 
+#ifdef H5_HAVE_FILTER_DEFLATE
+        /* Free the zlib streams kept by the deflate filter */
+        if(H5Z__deflate_term() > 0)
+            n++;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+        /* Free the pooled buffers */
+        if(H5Z_buf_pool_g.nbufs) {
+            while(H5Z_buf_pool_g.nbufs > 0) {
+                H5Z_buf_pool_g.nbufs--;
+                H5Z_buf_pool_g.buf[H5Z_buf_pool_g.nbufs] = H5MM_xfree(H5Z_buf_pool_g.buf[H5Z_buf_pool_g.nbufs]);
+            } /* end while */
+            H5Z_buf_pool_g.nbytes = 0;
+
+            n++;
+        } /* end if */
+
 	/* Mark interface as closed */
         if(0 == n)
             H5_PKG_INIT_VAR = FALSE;
@@ -1278,6 +1331,14 @@ done:
  *		then the pipeline function should free the original buffer
  *		and return a fresh buffer, adjusting BUF_SIZE accordingly.
  *
+ *		When reading (H5Z_FLAG_REVERSE), BUF_SIZE also tells the
+ *		filters how much output to expect: callers which know the
+ *		size of the unfiltered data (like the chunk and fractal
+ *		heap code) should pass a buffer at least that large, with
+ *		BUF_SIZE set to that size (it may be smaller than the
+ *		buffer really is), so that decompressing filters can
+ *		allocate their output once, at the right size.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Robb Matzke
@@ -1375,7 +1436,6 @@ H5Z_pipeline(const H5O_pline_t *pline, unsigned flags,
                     || !cb_struct.func)
 		      HGOTO_ERROR(H5E_PLINE, H5E_READERROR, FAIL, "filter returned failure during read")
 
-                *nbytes = *buf_size;
                 failed |= (unsigned)1 << idx;
                 H5E_clear_stack(NULL);
             } else {
@@ -1415,7 +1475,6 @@ H5Z_pipeline(const H5O_pline_t *pline, unsigned flags,
                             || !cb_struct.func)
                         HGOTO_ERROR(H5E_PLINE, H5E_WRITEERROR, FAIL, "filter returned failure")
 
-                    *nbytes = *buf_size;
                 }
 
                 failed |= (unsigned)1 << idx;
@@ -1432,6 +1491,131 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_buf_alloc
+ *
+ * Purpose:	Allocates a buffer for the filter pipeline, reusing one of
+ *		the buffers released with H5Z_buf_free if there's one which
+ *		is large enough, but not more than twice as large as needed.
+ *		The size of the buffer returned is stored in *ALLOC_SIZE, if
+ *		that's not NULL.
+ *
+ *		The buffer may be freed with H5MM_xfree (and reallocated
+ *		with H5MM_realloc) instead of being released to the pool.
+ *
+ * Return:	Success:	Pointer to the buffer
+ *
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5Z_buf_alloc(size_t size, size_t *alloc_size)
+{
+    H5Z_buf_pool_t *pool = &H5Z_buf_pool_g;     /* Buffer pool */
+    size_t      best = H5Z_BUF_POOL_NBUFS;      /* Index of the best fitting buffer */
+    size_t      u;                      /* Local index variable */
+    void        *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_NOAPI(NULL)
+
+    HDassert(size);
+
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_lock_simple(&pool->lock);
+#endif /* H5_HAVE_THREADSAFE */
+    for(u = 0; u < pool->nbufs; u++)
+        if(pool->size[u] >= size && pool->size[u] / 2 <= size
+                && (best == H5Z_BUF_POOL_NBUFS || pool->size[u] < pool->size[best]))
+            best = u;
+    if(best < H5Z_BUF_POOL_NBUFS) {
+        ret_value = pool->buf[best];
+        size = pool->size[best];
+        pool->nbytes -= size;
+        pool->nbufs--;
+        pool->buf[best] = pool->buf[pool->nbufs];
+        pool->size[best] = pool->size[pool->nbufs];
+    } /* end if */
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_unlock_simple(&pool->lock);
+#endif /* H5_HAVE_THREADSAFE */
+
+    if(NULL == ret_value)
+        if(NULL == (ret_value = H5MM_malloc(size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for filter buffer")
+    if(alloc_size)
+        *alloc_size = size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_buf_alloc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_buf_free
+ *
+ * Purpose:	Releases a filter buffer of at least SIZE bytes to the pool
+ *		for reuse by H5Z_buf_alloc.  When the pool is full, the
+ *		smallest of the buffers is freed.
+ *
+ * Return:	NULL (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5Z_buf_free(void *buf, size_t size)
+{
+    H5Z_buf_pool_t *pool = &H5Z_buf_pool_g;     /* Buffer pool */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(buf) {
+        /* Once the package is shut down, just free the buffer */
+        if(!H5_PKG_INIT_VAR || 0 == size || size > H5Z_BUF_POOL_NBYTES)
+            H5MM_xfree(buf);
+        else {
+#ifdef H5_HAVE_THREADSAFE
+            H5TS_mutex_lock_simple(&pool->lock);
+#endif /* H5_HAVE_THREADSAFE */
+            /* Make room by trading the smallest buffers for this one */
+            while(pool->nbufs > 0 && (pool->nbufs == H5Z_BUF_POOL_NBUFS
+                    || pool->nbytes + size > H5Z_BUF_POOL_NBYTES)) {
+                size_t smallest = 0;    /* Index of the smallest buffer */
+                size_t u;               /* Local index variable */
+
+                for(u = 1; u < pool->nbufs; u++)
+                    if(pool->size[u] < pool->size[smallest])
+                        smallest = u;
+                if(pool->size[smallest] >= size)
+                    break;
+                H5MM_xfree(pool->buf[smallest]);
+                pool->nbytes -= pool->size[smallest];
+                pool->nbufs--;
+                pool->buf[smallest] = pool->buf[pool->nbufs];
+                pool->size[smallest] = pool->size[pool->nbufs];
+            } /* end while */
+
+            if(pool->nbufs < H5Z_BUF_POOL_NBUFS && pool->nbytes + size <= H5Z_BUF_POOL_NBYTES) {
+                pool->buf[pool->nbufs] = buf;
+                pool->size[pool->nbufs] = size;
+                pool->nbufs++;
+                pool->nbytes += size;
+                buf = NULL;
+            } /* end if */
+#ifdef H5_HAVE_THREADSAFE
+            H5TS_mutex_unlock_simple(&pool->lock);
+#endif /* H5_HAVE_THREADSAFE */
+
+            /* The pool holds larger buffers than this one */
+            if(buf)
+                H5MM_xfree(buf);
+        } /* end else */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(NULL)
+} /* end H5Z_buf_free() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z_filter_info
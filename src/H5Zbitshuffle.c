@@ -0,0 +1,919 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	The "bitshuffle+lz" filter: transposes each block of a chunk
+ *		into bit planes and compresses the planes with a small, fast
+ *		LZ77 codec (the block format of LZ4).  Both halves are built
+ *		into the library, so a file written with the filter can be
+ *		read by any copy of the library.
+ *
+ *		Filtered data is laid out as:
+ *
+ *		    8 bytes	Size of the unfiltered data
+ *		    4 bytes	Size of each block of unfiltered data
+ *		    ...		One entry per block:
+ *		      4 bytes	  Size of the block's payload; the high bit
+ *				  is set when the payload is the bit planes
+ *				  stored uncompressed
+ *		      ...	  Payload
+ *
+ *		All integers are little-endian.  Blocks are a multiple of
+ *		eight elements, except the last one, whose leftover elements
+ *		(and any bytes of a partial element) are stored untransposed
+ *		after its bit planes.
+ */
+
+#include "H5Zmodule.h"          /* This source code file is part of the H5Z module */
+
+
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Fprivate.h"         /* File access                          */
+#include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Pprivate.h"         /* Property lists                       */
+#include "H5Tprivate.h"		/* Datatypes         			*/
+#include "H5Zpkg.h"		/* Data filters				*/
+
+/* Local function prototypes */
+static herr_t H5Z_set_local_bitshuffle_lz(hid_t dcpl_id, hid_t type_id, hid_t space_id);
+static size_t H5Z_filter_bitshuffle_lz(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_BITSHUFFLE_LZ[1] = {{
+    H5Z_CLASS_T_VERS,           /* H5Z_class_t version */
+    H5Z_FILTER_BITSHUFFLE_LZ,   /* Filter id number		*/
+    1,                          /* encoder_present flag (set to true) */
+    1,                          /* decoder_present flag (set to true) */
+    "bitshuffle+lz",            /* Filter name for debugging	*/
+    NULL,                       /* The "can apply" callback     */
+    H5Z_set_local_bitshuffle_lz, /* The "set local" callback     */
+    H5Z_filter_bitshuffle_lz,   /* The actual filter function	*/
+}};
+
+/* Local macros */
+#define H5Z_BITSHUFFLE_LZ_PARM_SIZE     0       /* "Local" parameter for element size */
+
+#define H5Z_BITSHUFFLE_LZ_BLOCK_SIZE    8192    /* Target size of a block of unfiltered data */
+#define H5Z_BITSHUFFLE_LZ_MAX_BLOCK     0x40000000      /* Largest block allowed */
+#define H5Z_BITSHUFFLE_LZ_HDR_SIZE      12      /* Size of the header of filtered data */
+#define H5Z_BITSHUFFLE_LZ_RAW           0x80000000      /* Payload stored uncompressed */
+
+/* LZ codec limits (those of the LZ4 block format) */
+#define H5Z_LZ_MIN_MATCH        4       /* Shortest match encoded */
+#define H5Z_LZ_MFLIMIT          12      /* No match starts in the last bytes of a block */
+#define H5Z_LZ_LAST_LITERALS    5       /* The last bytes of a block are always literals */
+#define H5Z_LZ_MAX_OFFSET       65535   /* Farthest back a match may reach */
+#define H5Z_LZ_HASH_LOG         12      /* log2 of the number of match finder slots */
+#define H5Z_LZ_HASH(V)          (((V) * 2654435761U) >> (32 - H5Z_LZ_HASH_LOG))
+
+/* Transpose the 8x8 bit matrix in the 64-bit X, whose byte N is row N,
+ * using T as a temporary */
+#define H5Z_BITSHUFFLE_TRANSPOSE8(X, T) {                                     \
+    (T) = ((X) ^ ((X) >> 7)) & 0x00AA00AA00AA00AAULL;                         \
+    (X) = (X) ^ (T) ^ ((T) << 7);                                             \
+    (T) = ((X) ^ ((X) >> 14)) & 0x0000CCCC0000CCCCULL;                        \
+    (X) = (X) ^ (T) ^ ((T) << 14);                                            \
+    (T) = ((X) ^ ((X) >> 28)) & 0x00000000F0F0F0F0ULL;                        \
+    (X) = (X) ^ (T) ^ ((T) << 28);                                            \
+}
+
+/* The SSE2 kernels are built under the same conditions as the shuffle
+ * filter's, whose CPU check they share */
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(H5_NO_SHUFFLE_SIMD) && \
+        (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define H5Z_BITSHUFFLE_X86
+#include <immintrin.h>
+#define H5Z_BITSHUFFLE_SSE2_ATTR        __attribute__((target("sse2")))
+#define H5Z_BITSHUFFLE_AVX2_ATTR        __attribute__((target("avx2")))
+#endif /* H5Z_BITSHUFFLE_X86 */
+
+/* Local prototypes */
+static void H5Z__bitshuffle_block(hbool_t reverse, unsigned elmt_size,
+    size_t nbytes, const uint8_t *src, uint8_t *dest, uint8_t *scratch);
+static void H5Z__bitshuffle_split(const uint8_t *in, uint8_t *out,
+    size_t ngroups, size_t start);
+static void H5Z__bitshuffle_join(const uint8_t *in, uint8_t *out,
+    size_t ngroups, size_t start);
+#ifdef H5Z_BITSHUFFLE_X86
+static size_t H5Z__bitshuffle_split_sse2(const uint8_t *in, uint8_t *out,
+    size_t ngroups);
+static size_t H5Z__bitshuffle_join_sse2(const uint8_t *in, uint8_t *out,
+    size_t ngroups);
+static size_t H5Z__bitshuffle_split_avx2(const uint8_t *in, uint8_t *out,
+    size_t ngroups);
+static size_t H5Z__bitshuffle_join_avx2(const uint8_t *in, uint8_t *out,
+    size_t ngroups);
+#endif /* H5Z_BITSHUFFLE_X86 */
+static size_t H5Z__lz_compress(const uint8_t *src, size_t src_size,
+    uint8_t *dst, size_t dst_size, uint32_t *htab, size_t base);
+static hbool_t H5Z__lz_decompress(const uint8_t *src, size_t src_size,
+    uint8_t *dst, size_t dst_size);
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_set_local_bitshuffle_lz
+ *
+ * Purpose:	Set the "local" dataset parameter for the bitshuffle+lz
+ *              filter to be the size of the datatype.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_set_local_bitshuffle_lz(hid_t dcpl_id, hid_t type_id, hid_t H5_ATTR_UNUSED space_id)
+{
+    H5P_genplist_t *dcpl_plist;     /* Property list pointer */
+    const H5T_t	*type;                  /* Datatype */
+    unsigned flags;                     /* Filter flags */
+    size_t cd_nelmts = H5Z_BITSHUFFLE_LZ_USER_NPARMS;     /* Number of filter parameters */
+    unsigned cd_values[H5Z_BITSHUFFLE_LZ_TOTAL_NPARMS];  /* Filter parameters */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Get the plist structure */
+    if(NULL == (dcpl_plist = H5P_object_verify(dcpl_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get datatype */
+    if(NULL == (type = (const H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+
+    /* Get the filter's current parameters */
+    if(H5P_get_filter_by_id(dcpl_plist, H5Z_FILTER_BITSHUFFLE_LZ, &flags, &cd_nelmts, cd_values, (size_t)0, NULL, NULL) < 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't get bitshuffle+lz parameters")
+
+    /* Set "local" parameter for this dataset */
+    if((cd_values[H5Z_BITSHUFFLE_LZ_PARM_SIZE] = (unsigned)H5T_get_size(type)) == 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "bad datatype size")
+    if(cd_values[H5Z_BITSHUFFLE_LZ_PARM_SIZE] > H5Z_BITSHUFFLE_LZ_MAX_BLOCK / 8)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "datatype too large for bitshuffle+lz")
+
+    /* Modify the filter's parameters for this dataset */
+    if(H5P_modify_filter(dcpl_plist, H5Z_FILTER_BITSHUFFLE_LZ, flags, (size_t)H5Z_BITSHUFFLE_LZ_TOTAL_NPARMS, cd_values) < 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTSET, FAIL, "can't set local bitshuffle+lz parameters")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_set_local_bitshuffle_lz() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_filter_bitshuffle_lz
+ *
+ * Purpose:	Implement an I/O filter which splits a chunk into blocks,
+ *              gathers bit N of every element of a block together, for
+ *              each bit of the element, and compresses the result with an
+ *              LZ77 codec.  Neighbouring values of numeric data mostly
+ *              differ in their low bits only, so their high bit planes are
+ *              long runs which the codec removes quickly.  A block which
+ *              doesn't compress is stored transposed but uncompressed.
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_filter_bitshuffle_lz(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf)
+{
+    const uint8_t *src = (const uint8_t *)*buf;  /* Unfiltered/filtered data */
+    uint8_t     *dest = NULL;           /* Buffer to deposit the output into */
+    size_t      dest_alloc = 0;         /* Size of destination buffer */
+    uint8_t     *work = NULL;           /* Transposed block and scratch space */
+    uint32_t    *htab = NULL;           /* Match finder slots */
+    unsigned    elmt_size;              /* Number of bytes per element */
+    size_t      block_size;             /* Size of each block of unfiltered data */
+    size_t      done_size;              /* Unfiltered bytes handled so far */
+    size_t      ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_NOAPI(0)
+
+    /* Check arguments */
+    if(cd_nelmts != H5Z_BITSHUFFLE_LZ_TOTAL_NPARMS || cd_values[H5Z_BITSHUFFLE_LZ_PARM_SIZE] == 0
+            || cd_values[H5Z_BITSHUFFLE_LZ_PARM_SIZE] > H5Z_BITSHUFFLE_LZ_MAX_BLOCK / 8)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid bitshuffle+lz parameters")
+    elmt_size = cd_values[H5Z_BITSHUFFLE_LZ_PARM_SIZE];
+
+    if(flags & H5Z_FLAG_REVERSE) {
+        /** Input; decompress and untranspose each block **/
+        const uint8_t *src_end = src + nbytes;  /* End of the filtered data */
+        uint64_t    orig_size;          /* Size of the unfiltered data */
+        uint32_t    hdr_block_size;     /* Block size from the header */
+
+        if(nbytes < H5Z_BITSHUFFLE_LZ_HDR_SIZE)
+	    HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle+lz data is truncated")
+        UINT64DECODE(src, orig_size);
+        UINT32DECODE(src, hdr_block_size);
+        if(orig_size > (uint64_t)((size_t)-1) || hdr_block_size == 0 || hdr_block_size > H5Z_BITSHUFFLE_LZ_MAX_BLOCK)
+	    HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle+lz header is corrupt")
+        block_size = (size_t)hdr_block_size;
+
+        if(NULL == (dest = (uint8_t *)H5Z_buf_alloc(MAX((size_t)orig_size, 1), &dest_alloc)))
+	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle+lz buffer")
+        if(NULL == (work = (uint8_t *)H5MM_malloc(2 * block_size)))
+	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle+lz buffer")
+
+        for(done_size = 0; done_size < (size_t)orig_size; done_size += block_size) {
+            size_t      size = MIN(block_size, (size_t)orig_size - done_size);  /* Size of this block */
+            uint32_t    entry;          /* The block's size and flag */
+            size_t      payload_size;   /* Size of the block's payload */
+
+            if((size_t)(src_end - src) < 4)
+	        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle+lz data is truncated")
+            UINT32DECODE(src, entry);
+            payload_size = (size_t)(entry & ~(uint32_t)H5Z_BITSHUFFLE_LZ_RAW);
+            if(payload_size > (size_t)(src_end - src))
+	        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle+lz data is truncated")
+
+            if(entry & H5Z_BITSHUFFLE_LZ_RAW) {
+                if(payload_size != size)
+	            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle+lz block is corrupt")
+                H5Z__bitshuffle_block(TRUE, elmt_size, size, src, dest + done_size, work);
+            } /* end if */
+            else {
+                if(!H5Z__lz_decompress(src, payload_size, work + block_size, size))
+	            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle+lz block is corrupt")
+                H5Z__bitshuffle_block(TRUE, elmt_size, size, work + block_size, dest + done_size, work);
+            } /* end else */
+            src += payload_size;
+        } /* end for */
+
+        ret_value = (size_t)orig_size;
+    } /* end if */
+    else {
+        /** Output; transpose and compress each block **/
+        size_t      nblocks;            /* Number of blocks */
+        uint8_t     *dst;               /* Next output byte */
+
+        /* Use as many whole groups of eight elements as fit the target size */
+        block_size = (H5Z_BITSHUFFLE_LZ_BLOCK_SIZE / (8 * elmt_size)) * 8 * elmt_size;
+        if(block_size == 0)
+            block_size = 8 * (size_t)elmt_size;
+        nblocks = (nbytes + block_size - 1) / block_size;
+
+        /* A block never takes more room than it does unfiltered */
+        if(NULL == (dest = (uint8_t *)H5Z_buf_alloc(H5Z_BITSHUFFLE_LZ_HDR_SIZE + 4 * nblocks + nbytes, &dest_alloc)))
+	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle+lz buffer")
+        if(NULL == (work = (uint8_t *)H5MM_malloc(2 * block_size)))
+	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle+lz buffer")
+        if(NULL == (htab = (uint32_t *)H5MM_calloc(sizeof(uint32_t) << H5Z_LZ_HASH_LOG)))
+	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle+lz buffer")
+
+        dst = dest;
+        UINT64ENCODE(dst, (uint64_t)nbytes);
+        UINT32ENCODE(dst, (uint32_t)block_size);
+
+        for(done_size = 0; done_size < nbytes; done_size += block_size) {
+            size_t      size = MIN(block_size, nbytes - done_size);  /* Size of this block */
+            size_t      payload_size;   /* Size of the block's payload */
+            uint8_t     *entry = dst;   /* Where the block's size goes */
+
+            dst += 4;
+            H5Z__bitshuffle_block(FALSE, elmt_size, size, src + done_size, work + block_size, work);
+
+            /* Keep the block uncompressed unless the codec shrinks it */
+            if(0 == (payload_size = H5Z__lz_compress(work + block_size, size, dst, size - 1, htab, done_size))) {
+                HDmemcpy(dst, work + block_size, size);
+                payload_size = size;
+                UINT32ENCODE(entry, (uint32_t)size | H5Z_BITSHUFFLE_LZ_RAW);
+            } /* end if */
+            else
+                UINT32ENCODE(entry, (uint32_t)payload_size);
+            dst += payload_size;
+        } /* end for */
+
+        ret_value = (size_t)(dst - dest);
+    } /* end else */
+
+    /* Release the input buffer */
+    H5Z_buf_free(*buf, *buf_size);
+
+    /* Set the buffer information to return */
+    *buf = dest;
+    *buf_size = dest_alloc;
+    dest = NULL;
+
+done:
+    if(dest)
+        H5Z_buf_free(dest, dest_alloc);
+    if(work)
+        H5MM_xfree(work);
+    if(htab)
+        H5MM_xfree(htab);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_filter_bitshuffle_lz() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_block
+ *
+ * Purpose:	Transpose the NBYTES bytes of elements of ELMT_SIZE bytes in
+ *              SRC into bit planes in DEST (or back, when REVERSE is set).
+ *              The bytes of the elements are first shuffled into byte
+ *              planes, then each group of eight bytes in a byte plane is
+ *              transposed as an 8x8 bit matrix, putting bit N of eight
+ *              elements into the Nth bit plane of that byte.  Elements past
+ *              the last whole group of eight are copied unchanged.
+ *
+ *              SCRATCH must hold NBYTES bytes.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__bitshuffle_block(hbool_t reverse, unsigned elmt_size, size_t nbytes,
+    const uint8_t *src, uint8_t *dest, uint8_t *scratch)
+{
+    size_t      nelmts = (nbytes / elmt_size) & ~(size_t)7; /* Elements transposed */
+    size_t      ngroups = nelmts / 8;   /* Groups of eight elements */
+    size_t      plane_nbytes = nelmts * elmt_size;  /* Bytes transposed */
+    unsigned    u;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(nelmts > 0) {
+        H5Z_shuffle_kern_t kern = H5Z__shuffle_best_kern(); /* Vector kernels the CPU supports */
+
+        if(!reverse) {
+            const uint8_t *planes;      /* Byte planes */
+
+            /* Gather the bytes of each position in the elements together */
+            if(elmt_size > 1) {
+                H5Z__shuffle_bytes(kern, FALSE, elmt_size, plane_nbytes, src, scratch);
+                planes = scratch;
+            } /* end if */
+            else
+                planes = src;
+
+            /* Split each byte plane into its bit planes */
+            for(u = 0; u < elmt_size; u++) {
+                size_t start = 0;       /* First group the portable code does */
+
+#ifdef H5Z_BITSHUFFLE_X86
+                if(kern == H5Z_SHUFFLE_KERN_AVX2)
+                    start = H5Z__bitshuffle_split_avx2(planes + u * nelmts, dest + u * nelmts, ngroups);
+                else if(kern == H5Z_SHUFFLE_KERN_SSE2)
+                    start = H5Z__bitshuffle_split_sse2(planes + u * nelmts, dest + u * nelmts, ngroups);
+#endif /* H5Z_BITSHUFFLE_X86 */
+                H5Z__bitshuffle_split(planes + u * nelmts, dest + u * nelmts, ngroups, start);
+            } /* end for */
+        } /* end if */
+        else {
+            uint8_t *planes = elmt_size > 1 ? scratch : dest; /* Byte planes */
+
+            /* Rebuild each byte plane from its bit planes */
+            for(u = 0; u < elmt_size; u++) {
+                size_t start = 0;       /* First group the portable code does */
+
+#ifdef H5Z_BITSHUFFLE_X86
+                if(kern == H5Z_SHUFFLE_KERN_AVX2)
+                    start = H5Z__bitshuffle_join_avx2(src + u * nelmts, planes + u * nelmts, ngroups);
+                else if(kern == H5Z_SHUFFLE_KERN_SSE2)
+                    start = H5Z__bitshuffle_join_sse2(src + u * nelmts, planes + u * nelmts, ngroups);
+#endif /* H5Z_BITSHUFFLE_X86 */
+                H5Z__bitshuffle_join(src + u * nelmts, planes + u * nelmts, ngroups, start);
+            } /* end for */
+
+            /* Put the bytes of each element back together */
+            if(elmt_size > 1)
+                H5Z__shuffle_bytes(kern, TRUE, elmt_size, plane_nbytes, scratch, dest);
+        } /* end else */
+    } /* end if */
+
+    /* Leftover elements and bytes are stored as they are */
+    if(nbytes > plane_nbytes)
+        HDmemcpy(dest + plane_nbytes, src + plane_nbytes, nbytes - plane_nbytes);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__bitshuffle_block() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_split
+ *
+ * Purpose:	Split groups START to NGROUPS-1 of eight bytes of the byte
+ *              plane IN into the eight bit planes at OUT, each NGROUPS
+ *              bytes long: bit B of byte E of group G goes to bit E of byte
+ *              G of bit plane B.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__bitshuffle_split(const uint8_t *in, uint8_t *out, size_t ngroups,
+    size_t start)
+{
+    size_t      g;                      /* Local index variable */
+    unsigned    b;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(g = start, in += 8 * start; g < ngroups; g++, in += 8) {
+        uint64_t x, t;
+
+        /* Transpose the group as an 8x8 bit matrix */
+        x = (uint64_t)in[0] | ((uint64_t)in[1] << 8) | ((uint64_t)in[2] << 16) | ((uint64_t)in[3] << 24)
+            | ((uint64_t)in[4] << 32) | ((uint64_t)in[5] << 40) | ((uint64_t)in[6] << 48) | ((uint64_t)in[7] << 56);
+        H5Z_BITSHUFFLE_TRANSPOSE8(x, t);
+        for(b = 0; b < 8; b++)
+            out[b * ngroups + g] = (uint8_t)(x >> (8 * b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__bitshuffle_split() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_join
+ *
+ * Purpose:	The reverse of H5Z__bitshuffle_split: rebuild groups START
+ *              to NGROUPS-1 of the byte plane OUT from the eight bit planes
+ *              at IN.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__bitshuffle_join(const uint8_t *in, uint8_t *out, size_t ngroups,
+    size_t start)
+{
+    size_t      g;                      /* Local index variable */
+    unsigned    b;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(g = start, out += 8 * start; g < ngroups; g++, out += 8) {
+        uint64_t x = 0, t;
+
+        for(b = 0; b < 8; b++)
+            x |= (uint64_t)in[b * ngroups + g] << (8 * b);
+        H5Z_BITSHUFFLE_TRANSPOSE8(x, t);
+        for(b = 0; b < 8; b++)
+            out[b] = (uint8_t)(x >> (8 * b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__bitshuffle_join() */
+
+#ifdef H5Z_BITSHUFFLE_X86
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_split_sse2
+ *
+ * Purpose:	H5Z__bitshuffle_split for pairs of groups with SSE2: the
+ *              top bit of each of sixteen bytes is gathered with one
+ *              movemask, then the bytes are shifted up a bit, eight times.
+ *
+ * Return:	Number of groups split
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_BITSHUFFLE_SSE2_ATTR size_t
+H5Z__bitshuffle_split_sse2(const uint8_t *in, uint8_t *out, size_t ngroups)
+{
+    size_t      g;                      /* Local index variable */
+    int         b;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(g = 0; g + 2 <= ngroups; g += 2, in += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)in);
+
+        for(b = 7; b >= 0; b--) {
+            unsigned m = (unsigned)_mm_movemask_epi8(x);
+
+            out[(size_t)b * ngroups + g] = (uint8_t)m;
+            out[(size_t)b * ngroups + g + 1] = (uint8_t)(m >> 8);
+            x = _mm_add_epi8(x, x);
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(g)
+} /* end H5Z__bitshuffle_split_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_join_sse2
+ *
+ * Purpose:	H5Z__bitshuffle_join for runs of eight groups with SSE2:
+ *              eight bytes of each bit plane are transposed as an 8x8 byte
+ *              matrix with unpacks, which puts the eight bit plane bytes
+ *              of a group side by side, then each pair of groups is turned
+ *              back into bytes with movemask, from the top bit down.
+ *
+ * Return:	Number of groups joined
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_BITSHUFFLE_SSE2_ATTR size_t
+H5Z__bitshuffle_join_sse2(const uint8_t *in, uint8_t *out, size_t ngroups)
+{
+    size_t      g;                      /* Local index variable */
+    int         p, e;                   /* Local index variables */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(g = 0; g + 8 <= ngroups; g += 8, out += 64) {
+        __m128i a0, a1, a2, a3, b0, b1, b2, b3, pair[4];
+
+        a0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(in + g)), _mm_loadl_epi64((const __m128i *)(in + ngroups + g)));
+        a1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(in + 2 * ngroups + g)), _mm_loadl_epi64((const __m128i *)(in + 3 * ngroups + g)));
+        a2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(in + 4 * ngroups + g)), _mm_loadl_epi64((const __m128i *)(in + 5 * ngroups + g)));
+        a3 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(in + 6 * ngroups + g)), _mm_loadl_epi64((const __m128i *)(in + 7 * ngroups + g)));
+        b0 = _mm_unpacklo_epi16(a0, a1);
+        b1 = _mm_unpackhi_epi16(a0, a1);
+        b2 = _mm_unpacklo_epi16(a2, a3);
+        b3 = _mm_unpackhi_epi16(a2, a3);
+        pair[0] = _mm_unpacklo_epi32(b0, b2);
+        pair[1] = _mm_unpackhi_epi32(b0, b2);
+        pair[2] = _mm_unpacklo_epi32(b1, b3);
+        pair[3] = _mm_unpackhi_epi32(b1, b3);
+
+        for(p = 0; p < 4; p++) {
+            __m128i x = pair[p];
+
+            for(e = 7; e >= 0; e--) {
+                unsigned m = (unsigned)_mm_movemask_epi8(x);
+
+                out[16 * p + e] = (uint8_t)m;
+                out[16 * p + 8 + e] = (uint8_t)(m >> 8);
+                x = _mm_add_epi8(x, x);
+            } /* end for */
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(g)
+} /* end H5Z__bitshuffle_join_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_split_avx2
+ *
+ * Purpose:	H5Z__bitshuffle_split_sse2 for four groups at a time with
+ *              AVX2.
+ *
+ * Return:	Number of groups split
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_BITSHUFFLE_AVX2_ATTR size_t
+H5Z__bitshuffle_split_avx2(const uint8_t *in, uint8_t *out, size_t ngroups)
+{
+    size_t      g;                      /* Local index variable */
+    int         b;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(g = 0; g + 4 <= ngroups; g += 4, in += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)in);
+
+        for(b = 7; b >= 0; b--) {
+            uint32_t m = (uint32_t)_mm256_movemask_epi8(x);
+            uint8_t *o = out + (size_t)b * ngroups + g;
+
+            o[0] = (uint8_t)m;
+            o[1] = (uint8_t)(m >> 8);
+            o[2] = (uint8_t)(m >> 16);
+            o[3] = (uint8_t)(m >> 24);
+            x = _mm256_add_epi8(x, x);
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(g)
+} /* end H5Z__bitshuffle_split_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_join_avx2
+ *
+ * Purpose:	H5Z__bitshuffle_join_sse2 for sixteen groups at a time with
+ *              AVX2: the first eight groups are transposed in the low lane
+ *              and the next eight in the high lane.
+ *
+ * Return:	Number of groups joined
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_BITSHUFFLE_AVX2_ATTR size_t
+H5Z__bitshuffle_join_avx2(const uint8_t *in, uint8_t *out, size_t ngroups)
+{
+    size_t      g;                      /* Local index variable */
+    int         p, e;                   /* Local index variables */
+    unsigned    b;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(g = 0; g + 16 <= ngroups; g += 16, out += 128) {
+        __m256i row[8], a0, a1, a2, a3, b0, b1, b2, b3, pair[4];
+
+        for(b = 0; b < 8; b++)
+            row[b] = _mm256_inserti128_si256(_mm256_castsi128_si256(
+                        _mm_loadl_epi64((const __m128i *)(in + b * ngroups + g))),
+                    _mm_loadl_epi64((const __m128i *)(in + b * ngroups + g + 8)), 1);
+        a0 = _mm256_unpacklo_epi8(row[0], row[1]);
+        a1 = _mm256_unpacklo_epi8(row[2], row[3]);
+        a2 = _mm256_unpacklo_epi8(row[4], row[5]);
+        a3 = _mm256_unpacklo_epi8(row[6], row[7]);
+        b0 = _mm256_unpacklo_epi16(a0, a1);
+        b1 = _mm256_unpackhi_epi16(a0, a1);
+        b2 = _mm256_unpacklo_epi16(a2, a3);
+        b3 = _mm256_unpackhi_epi16(a2, a3);
+        pair[0] = _mm256_unpacklo_epi32(b0, b2);
+        pair[1] = _mm256_unpackhi_epi32(b0, b2);
+        pair[2] = _mm256_unpacklo_epi32(b1, b3);
+        pair[3] = _mm256_unpackhi_epi32(b1, b3);
+
+        for(p = 0; p < 4; p++) {
+            __m256i x = pair[p];
+
+            for(e = 7; e >= 0; e--) {
+                uint32_t m = (uint32_t)_mm256_movemask_epi8(x);
+
+                out[16 * p + e] = (uint8_t)m;
+                out[16 * p + 8 + e] = (uint8_t)(m >> 8);
+                out[64 + 16 * p + e] = (uint8_t)(m >> 16);
+                out[64 + 16 * p + 8 + e] = (uint8_t)(m >> 24);
+                x = _mm256_add_epi8(x, x);
+            } /* end for */
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(g)
+} /* end H5Z__bitshuffle_join_avx2() */
+#endif /* H5Z_BITSHUFFLE_X86 */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__lz_put_seq
+ *
+ * Purpose:	Append one LZ sequence to the compressed output at OP: the
+ *              NLIT literal bytes at LIT, then a match of MLEN bytes at
+ *              OFFSET bytes back (no match when MLEN is zero, as for the
+ *              last sequence of a block).
+ *
+ * Return:	Success: The byte after the sequence
+ *		Failure: NULL, when the sequence doesn't fit before OP_END
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint8_t *
+H5Z__lz_put_seq(uint8_t *op, const uint8_t *op_end, const uint8_t *lit,
+    size_t nlit, size_t offset, size_t mlen)
+{
+    uint8_t     *token = op;            /* The sequence's token byte */
+    size_t      len;                    /* Length left to encode */
+    uint8_t     *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check the worst case before writing anything */
+    if((size_t)(op_end - op) < 1 + nlit + nlit / 255 + 1 + (mlen ? 2 + mlen / 255 + 1 : 0))
+        HGOTO_DONE(NULL)
+    op++;
+
+    /* Literal run length, then the literals */
+    if(nlit >= 15) {
+        *token = (uint8_t)(15 << 4);
+        for(len = nlit - 15; len >= 255; len -= 255)
+            *op++ = 255;
+        *op++ = (uint8_t)len;
+    } /* end if */
+    else
+        *token = (uint8_t)(nlit << 4);
+    HDmemcpy(op, lit, nlit);
+    op += nlit;
+
+    /* Match offset and length */
+    if(mlen) {
+        *op++ = (uint8_t)(offset & 0xff);
+        *op++ = (uint8_t)(offset >> 8);
+        len = mlen - H5Z_LZ_MIN_MATCH;
+        if(len >= 15) {
+            *token |= 15;
+            for(len -= 15; len >= 255; len -= 255)
+                *op++ = 255;
+            *op++ = (uint8_t)len;
+        } /* end if */
+        else
+            *token |= (uint8_t)len;
+    } /* end if */
+
+    ret_value = op;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__lz_put_seq() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__lz_compress
+ *
+ * Purpose:	Compress the SRC_SIZE bytes at SRC into at most DST_SIZE
+ *              bytes at DST.  Matches are found greedily with a hash table
+ *              of the last position each 4-byte sequence was seen at, and
+ *              incompressible stretches are skipped over in growing steps.
+ *
+ *              HTAB is shared by the blocks of a chunk; its slots hold the
+ *              position in the chunk plus one, and BASE is the position of
+ *              SRC in the chunk, so slots left by earlier blocks are told
+ *              apart without clearing the table.
+ *
+ * Return:	Success: Size of the compressed data
+ *		Failure: 0, when it doesn't fit in DST_SIZE bytes
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__lz_compress(const uint8_t *src, size_t src_size, uint8_t *dst,
+    size_t dst_size, uint32_t *htab, size_t base)
+{
+    const uint8_t *ip = src;            /* Next input byte */
+    const uint8_t *anchor = src;        /* First literal not yet written */
+    const uint8_t *src_end = src + src_size;    /* End of the input */
+    uint8_t     *op = dst;              /* Next output byte */
+    uint8_t     *op_end = dst + dst_size;       /* End of the output */
+    size_t      ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(src_size > H5Z_LZ_MFLIMIT) {
+        const uint8_t *mflimit = src_end - H5Z_LZ_MFLIMIT;     /* Last match start */
+        const uint8_t *matchlimit = src_end - H5Z_LZ_LAST_LITERALS; /* Last match byte */
+
+        while(ip < mflimit) {
+            uint32_t    seq, slot;      /* Next four bytes and their slot's contents */
+            unsigned    h;              /* Slot of the next four bytes */
+
+            HDmemcpy(&seq, ip, sizeof(seq));
+            h = (unsigned)H5Z_LZ_HASH(seq);
+            slot = htab[h];
+            htab[h] = (uint32_t)(base + (size_t)(ip - src) + 1);
+
+            if(slot > base) {
+                const uint8_t *ref = src + (slot - base - 1);   /* Earlier occurrence */
+                uint32_t    ref_seq;    /* Its four bytes */
+
+                HDmemcpy(&ref_seq, ref, sizeof(ref_seq));
+                if((size_t)(ip - ref) <= H5Z_LZ_MAX_OFFSET && ref_seq == seq) {
+                    const uint8_t *mp = ip + H5Z_LZ_MIN_MATCH;  /* End of the match */
+
+                    ref += H5Z_LZ_MIN_MATCH;
+                    while(mp < matchlimit && *mp == *ref) {
+                        mp++;
+                        ref++;
+                    } /* end while */
+
+                    if(NULL == (op = H5Z__lz_put_seq(op, op_end, anchor, (size_t)(ip - anchor), (size_t)(mp - ref), (size_t)(mp - ip))))
+                        HGOTO_DONE(0)
+                    ip = anchor = mp;
+
+                    /* Remember a position inside the match too */
+                    if(ip < mflimit) {
+                        HDmemcpy(&seq, ip - 2, sizeof(seq));
+                        htab[H5Z_LZ_HASH(seq)] = (uint32_t)(base + (size_t)(ip - 2 - src) + 1);
+                    } /* end if */
+                    continue;
+                } /* end if */
+            } /* end if */
+
+            /* Step faster the longer no match has been found */
+            ip += 1 + ((size_t)(ip - anchor) >> 6);
+        } /* end while */
+    } /* end if */
+
+    /* The rest of the block is literals */
+    if(NULL == (op = H5Z__lz_put_seq(op, op_end, anchor, (size_t)(src_end - anchor), (size_t)0, (size_t)0)))
+        HGOTO_DONE(0)
+
+    ret_value = (size_t)(op - dst);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__lz_compress() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__lz_decompress
+ *
+ * Purpose:	Decompress the SRC_SIZE bytes at SRC into exactly DST_SIZE
+ *              bytes at DST.  The input comes from the file, so every
+ *              length and offset is checked against both buffers.
+ *
+ * Return:	TRUE if the data decompressed to DST_SIZE bytes, FALSE if
+ *              it is corrupt
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5Z__lz_decompress(const uint8_t *src, size_t src_size, uint8_t *dst,
+    size_t dst_size)
+{
+    const uint8_t *ip = src;            /* Next input byte */
+    const uint8_t *ip_end = src + src_size;     /* End of the input */
+    uint8_t     *op = dst;              /* Next output byte */
+    uint8_t     *op_end = dst + dst_size;       /* End of the output */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    while(ip < ip_end) {
+        unsigned    token = *ip++;      /* Sequence's token byte */
+        size_t      len = token >> 4;   /* Literal/match length */
+        size_t      offset;             /* Match offset */
+        unsigned    b;                  /* Length byte */
+
+        /* Literals */
+        if(len == 15)
+            do {
+                if(ip >= ip_end)
+                    HGOTO_DONE(FALSE)
+                b = *ip++;
+                len += b;
+            } while(b == 255);
+        if(len > (size_t)(ip_end - ip) || len > (size_t)(op_end - op))
+            HGOTO_DONE(FALSE)
+        if(len <= 16 && ip_end - ip >= 16 && op_end - op >= 16)
+            HDmemcpy(op, ip, 16);       /* (Short runs: one fixed-size copy) */
+        else
+            HDmemcpy(op, ip, len);
+        ip += len;
+        op += len;
+
+        /* The last sequence has no match */
+        if(ip == ip_end)
+            break;
+
+        /* Match */
+        if(ip_end - ip < 2)
+            HGOTO_DONE(FALSE)
+        offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if(offset == 0 || offset > (size_t)(op - dst))
+            HGOTO_DONE(FALSE)
+        len = token & 15;
+        if(len == 15)
+            do {
+                if(ip >= ip_end)
+                    HGOTO_DONE(FALSE)
+                b = *ip++;
+                len += b;
+            } while(b == 255);
+        len += H5Z_LZ_MIN_MATCH;
+        if(len > (size_t)(op_end - op))
+            HGOTO_DONE(FALSE)
+
+        /* Copy the match in pieces which don't overlap what they copy.  A
+         * match may overlap itself, repeating the last OFFSET bytes, so
+         * short periods are first laid down a byte at a time until a whole
+         * number of them spans at least eight bytes */
+        if(offset == 1)
+            HDmemset(op, op[-1], len);
+        else {
+            size_t  dist = offset;      /* How far back the pieces come from */
+            size_t  k = 0;              /* Bytes copied */
+
+            if(offset < 8) {
+                dist = offset * ((8 + offset - 1) / offset);
+                for(; k < MIN(len, 8); k++)
+                    op[k] = *(op + k - offset);
+            } /* end if */
+            if(dist >= 16)
+                for(; k + 16 <= len; k += 16)
+                    HDmemcpy(op + k, op + k - dist, 16);
+            for(; k + 8 <= len; k += 8)
+                HDmemcpy(op + k, op + k - dist, 8);
+            for(; k < len; k++)
+                op[k] = *(op + k - dist);
+        } /* end else */
+        op += len;
+    } /* end while */
+
+    ret_value = (hbool_t)(op == op_end);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__lz_decompress() */
+
@@ -38,6 +38,8 @@
 /* Local function prototypes */
 static size_t H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
     const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static z_stream *H5Z_deflate_get_stream(hbool_t compress, int level);
+static void H5Z_deflate_put_stream(z_stream *strm, hbool_t compress, int level);
 
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_DEFLATE[1] = {{
@@ -53,6 +55,205 @@ const H5Z_class2_t H5Z_DEFLATE[1] = {{
 
 #define H5Z_DEFLATE_SIZE_ADJUST(s) (HDceil(((double)(s)) * (double)1.001f) + 12)
 
+/* Number of zlib streams of each direction kept for reuse */
+#define H5Z_DEFLATE_POOL_NSTREAMS       8
+
+/*
+ * zlib streams kept for reuse.  Setting up a stream allocates zlib's
+ * state (a few hundred kilobytes to compress) and initializes it, which
+ * costs more than the compression of a small chunk; resetting a stream
+ * that was used before doesn't.  Each call of the filter, in whichever
+ * thread, takes a stream from here and gives it back when it's done.
+ */
+typedef struct H5Z_deflate_pool_t {
+    z_stream    *inflate[H5Z_DEFLATE_POOL_NSTREAMS];    /* Decompression streams */
+    size_t      ninflate;                               /* # of decompression streams */
+    z_stream    *deflate[H5Z_DEFLATE_POOL_NSTREAMS];    /* Compression streams */
+    int         level[H5Z_DEFLATE_POOL_NSTREAMS];       /* Compression level of each */
+    size_t      ndeflate;                               /* # of compression streams */
+#ifdef H5_HAVE_THREADSAFE
+    hbool_t     lock_init;                  /* Whether the lock is initialized */
+    H5TS_mutex_simple_t lock;               /* Protects the pool from concurrent decode threads */
+#endif /* H5_HAVE_THREADSAFE */
+} H5Z_deflate_pool_t;
+
+/* Streams kept for reuse */
+static H5Z_deflate_pool_t H5Z_deflate_pool_g;
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_init
+ *
+ * Purpose:	Set up the pool of zlib streams.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z__deflate_init(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+#ifdef H5_HAVE_THREADSAFE
+    if(!H5Z_deflate_pool_g.lock_init) {
+        H5TS_mutex_init(&H5Z_deflate_pool_g.lock);
+        H5Z_deflate_pool_g.lock_init = TRUE;
+    } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5Z__deflate_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_term
+ *
+ * Purpose:	Release the zlib streams kept for reuse.
+ *
+ * Return:	Number of streams released
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+H5Z__deflate_term(void)
+{
+    H5Z_deflate_pool_t *pool = &H5Z_deflate_pool_g;     /* Stream pool */
+    int         n = 0;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    while(pool->ninflate > 0) {
+        pool->ninflate--;
+        (void)inflateEnd(pool->inflate[pool->ninflate]);
+        pool->inflate[pool->ninflate] = (z_stream *)H5MM_xfree(pool->inflate[pool->ninflate]);
+        n++;
+    } /* end while */
+    while(pool->ndeflate > 0) {
+        pool->ndeflate--;
+        (void)deflateEnd(pool->deflate[pool->ndeflate]);
+        pool->deflate[pool->ndeflate] = (z_stream *)H5MM_xfree(pool->deflate[pool->ndeflate]);
+        n++;
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(n)
+} /* end H5Z__deflate_term() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_deflate_get_stream
+ *
+ * Purpose:	Get a zlib stream, ready to decompress (or, when COMPRESS
+ *		is set, to compress at LEVEL) a new buffer: one from the
+ *		pool, reset, if there is one, otherwise a new one.
+ *
+ * Return:	Success:	Pointer to the stream
+ *
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static z_stream *
+H5Z_deflate_get_stream(hbool_t compress, int level)
+{
+    H5Z_deflate_pool_t *pool = &H5Z_deflate_pool_g;     /* Stream pool */
+    z_stream    *strm = NULL;           /* Stream */
+    size_t      u;                      /* Local index variable */
+    z_stream    *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_lock_simple(&pool->lock);
+#endif /* H5_HAVE_THREADSAFE */
+    if(compress) {
+        /* (The level can't be changed cheaply, so only a stream at the same level will do) */
+        for(u = pool->ndeflate; u > 0; u--)
+            if(pool->level[u - 1] == level) {
+                strm = pool->deflate[u - 1];
+                pool->ndeflate--;
+                pool->deflate[u - 1] = pool->deflate[pool->ndeflate];
+                pool->level[u - 1] = pool->level[pool->ndeflate];
+                break;
+            } /* end if */
+    } /* end if */
+    else if(pool->ninflate > 0)
+        strm = pool->inflate[--pool->ninflate];
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_unlock_simple(&pool->lock);
+#endif /* H5_HAVE_THREADSAFE */
+
+    if(strm) {
+        /* Forget the previous buffer */
+        if(Z_OK != (compress ? deflateReset(strm) : inflateReset(strm))) {
+            (void)(compress ? deflateEnd(strm) : inflateEnd(strm));
+            strm = (z_stream *)H5MM_xfree(strm);
+        } /* end if */
+    } /* end if */
+
+    if(NULL == strm) {
+        if(NULL == (strm = (z_stream *)H5MM_calloc(sizeof(z_stream))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for zlib stream")
+        if(Z_OK != (compress ? deflateInit(strm, level) : inflateInit(strm))) {
+            strm = (z_stream *)H5MM_xfree(strm);
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, NULL, compress ? "deflateInit() failed" : "inflateInit() failed")
+        } /* end if */
+    } /* end if */
+
+    ret_value = strm;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_deflate_get_stream() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_deflate_put_stream
+ *
+ * Purpose:	Give a stream from H5Z_deflate_get_stream back to the pool,
+ *		or release it when the pool is full.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_deflate_put_stream(z_stream *strm, hbool_t compress, int level)
+{
+    H5Z_deflate_pool_t *pool = &H5Z_deflate_pool_g;     /* Stream pool */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(strm);
+
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_lock_simple(&pool->lock);
+#endif /* H5_HAVE_THREADSAFE */
+    if(compress) {
+        if(pool->ndeflate < H5Z_DEFLATE_POOL_NSTREAMS) {
+            pool->deflate[pool->ndeflate] = strm;
+            pool->level[pool->ndeflate] = level;
+            pool->ndeflate++;
+            strm = NULL;
+        } /* end if */
+    } /* end if */
+    else if(pool->ninflate < H5Z_DEFLATE_POOL_NSTREAMS) {
+        pool->inflate[pool->ninflate++] = strm;
+        strm = NULL;
+    } /* end if */
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_unlock_simple(&pool->lock);
+#endif /* H5_HAVE_THREADSAFE */
+
+    /* The pool is full */
+    if(strm) {
+        (void)(compress ? deflateEnd(strm) : inflateEnd(strm));
+        H5MM_xfree(strm);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_deflate_put_stream() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z_filter_deflate
@@ -92,28 +293,29 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 
     if (flags & H5Z_FLAG_REVERSE) {
 	/* Input; uncompress */
-	z_stream	z_strm;                 /* zlib parameters */
-	size_t		nalloc = *buf_size;     /* Number of bytes for output (compressed) buffer */
+	z_stream	*z_strm;                /* zlib parameters */
+	size_t		nalloc = *buf_size;     /* Number of bytes for output (uncompressed) buffer */
 
-        /* Allocate space for the compressed buffer */
-	if (NULL==(outbuf = H5MM_malloc(nalloc)))
+        /* Allocate space for the uncompressed buffer (the pipeline passes
+         * a buffer at least as large as the uncompressed data, when it
+         * knows that size) */
+	if (NULL==(outbuf = H5Z_buf_alloc(nalloc, NULL)))
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate uncompression")
 
-        /* Set the uncompression parameters */
-	HDmemset(&z_strm, 0, sizeof(z_strm));
-	z_strm.next_in = (Bytef *)*buf;
-        H5_CHECKED_ASSIGN(z_strm.avail_in, unsigned, nbytes, size_t);
-	z_strm.next_out = (Bytef *)outbuf;
-        H5_CHECKED_ASSIGN(z_strm.avail_out, unsigned, nalloc, size_t);
+        /* Get a stream to uncompress with */
+        if(NULL == (z_strm = H5Z_deflate_get_stream(FALSE, 0)))
+	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "can't get zlib stream")
 
-        /* Initialize the uncompression routines */
-	if (Z_OK!=inflateInit(&z_strm))
-	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflateInit() failed")
+        /* Set the uncompression parameters */
+	z_strm->next_in = (Bytef *)*buf;
+        H5_CHECKED_ASSIGN(z_strm->avail_in, unsigned, nbytes, size_t);
+	z_strm->next_out = (Bytef *)outbuf;
+        H5_CHECKED_ASSIGN(z_strm->avail_out, unsigned, nalloc, size_t);
 
         /* Loop to uncompress the buffer */
 	do {
             /* Uncompress some data */
-	    status = inflate(&z_strm, Z_SYNC_FLUSH);
+	    status = inflate(z_strm, Z_SYNC_FLUSH);
 
             /* Check if we are done uncompressing data */
 	    if (Z_STREAM_END==status)
@@ -121,40 +323,40 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 
             /* Check for error */
 	    if (Z_OK!=status) {
-		(void)inflateEnd(&z_strm);
+		H5Z_deflate_put_stream(z_strm, FALSE, 0);
 		HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflate() failed")
 	    }
             else {
                 /* If we're not done and just ran out of buffer space, get more */
-                if(0 == z_strm.avail_out) {
+                if(0 == z_strm->avail_out) {
                     void	*new_outbuf;         /* Pointer to new output buffer */
 
                     /* Allocate a buffer twice as big */
                     nalloc *= 2;
                     if(NULL == (new_outbuf = H5MM_realloc(outbuf, nalloc))) {
-                        (void)inflateEnd(&z_strm);
+                        H5Z_deflate_put_stream(z_strm, FALSE, 0);
                         HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate uncompression")
                     } /* end if */
                     outbuf = new_outbuf;
 
                     /* Update pointers to buffer for next set of uncompressed data */
-                    z_strm.next_out = (unsigned char*)outbuf + z_strm.total_out;
-                    z_strm.avail_out = (uInt)(nalloc - z_strm.total_out);
+                    z_strm->next_out = (unsigned char*)outbuf + z_strm->total_out;
+                    z_strm->avail_out = (uInt)(nalloc - z_strm->total_out);
                 } /* end if */
             } /* end else */
 	} while(status==Z_OK);
 
-        /* Free the input buffer */
-	H5MM_xfree(*buf);
+        /* Release the input buffer */
+	H5Z_buf_free(*buf, *buf_size);
 
         /* Set return values */
 	*buf = outbuf;
 	outbuf = NULL;
 	*buf_size = nalloc;
-	ret_value = z_strm.total_out;
+	ret_value = z_strm->total_out;
 
-        /* Finish uncompressing the stream */
-	(void)inflateEnd(&z_strm);
+        /* Keep the stream for the next buffer */
+	H5Z_deflate_put_stream(z_strm, FALSE, 0);
     } /* end if */
     else {
 	/*
@@ -162,39 +364,45 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 	 * input.  The library doesn't provide in-place compression, so we
 	 * must allocate a separate buffer for the result.
 	 */
-	const Bytef *z_src = (const Bytef*)(*buf);
-	Bytef	    *z_dst;		/*destination buffer		*/
-	uLongf	     z_dst_nbytes = (uLongf)H5Z_DEFLATE_SIZE_ADJUST(nbytes);
-	uLong	     z_src_nbytes = (uLong)nbytes;
+	z_stream    *z_strm;		/* zlib parameters */
+	size_t	     z_dst_nbytes = (size_t)H5Z_DEFLATE_SIZE_ADJUST(nbytes);
+        size_t       out_alloc;      /* Size of output buffer */
         int          aggression;     /* Compression aggression setting */
 
         /* Set the compression aggression level */
         H5_CHECKED_ASSIGN(aggression, int, cd_values[0], unsigned);
 
         /* Allocate output (compressed) buffer */
-	if(NULL == (outbuf = H5MM_malloc(z_dst_nbytes)))
+	if(NULL == (outbuf = H5Z_buf_alloc(z_dst_nbytes, &out_alloc)))
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate deflate destination buffer")
-        z_dst = (Bytef *)outbuf;
+
+        /* Get a stream to compress with */
+        if(NULL == (z_strm = H5Z_deflate_get_stream(TRUE, aggression)))
+	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "can't get zlib stream")
 
         /* Perform compression from the source to the destination buffer */
-	status = compress2(z_dst, &z_dst_nbytes, z_src, z_src_nbytes, aggression);
+	z_strm->next_in = (Bytef *)*buf;
+        H5_CHECKED_ASSIGN(z_strm->avail_in, unsigned, nbytes, size_t);
+	z_strm->next_out = (Bytef *)outbuf;
+        H5_CHECKED_ASSIGN(z_strm->avail_out, unsigned, z_dst_nbytes, size_t);
+	status = deflate(z_strm, Z_FINISH);
+        z_dst_nbytes = z_strm->total_out;
+	H5Z_deflate_put_stream(z_strm, TRUE, aggression);
 
         /* Check for various zlib errors */
-	if(Z_BUF_ERROR == status)
+	if(Z_OK == status || Z_BUF_ERROR == status)
 	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "overflow")
-	else if(Z_MEM_ERROR == status)
-	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "deflate memory error")
-	else if(Z_OK != status)
+	else if(Z_STREAM_END != status)
 	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "other deflate error")
-        /* Successfully uncompressed the buffer */
+        /* Successfully compressed the buffer */
         else {
-            /* Free the input buffer */
-	    H5MM_xfree(*buf);
+            /* Release the input buffer */
+	    H5Z_buf_free(*buf, *buf_size);
 
             /* Set return values */
 	    *buf = outbuf;
 	    outbuf = NULL;
-	    *buf_size = nbytes;
+	    *buf_size = out_alloc;
 	    ret_value = z_dst_nbytes;
 	} /* end else */
     } /* end else */
@@ -75,6 +75,7 @@ H5Z_filter_fletcher32 (unsigned flags, size_t H5_ATTR_UNUSED cd_nelmts, const un
                      size_t nbytes, size_t *buf_size, void **buf)
 {
     void    *outbuf = NULL;     /* Pointer to new buffer */
+    size_t  out_alloc;          /* Size of new buffer */
     unsigned char *src = (unsigned char*)(*buf);
     uint32_t fletcher;          /* Checksum value */
     uint32_t reversed_fletcher; /* Possible wrong checksum value */
@@ -136,7 +137,7 @@ H5Z_filter_fletcher32 (unsigned flags, size_t H5_ATTR_UNUSED cd_nelmts, const un
         /* Compute checksum (can't fail) */
         fletcher = H5_checksum_fletcher32(src, nbytes);
 
-	if (NULL == (outbuf = H5MM_malloc(nbytes + FLETCHER_LEN)))
+	if (NULL == (outbuf = H5Z_buf_alloc(nbytes + FLETCHER_LEN, &out_alloc)))
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate Fletcher32 checksum destination buffer")
 
         dst = (unsigned char *) outbuf;
@@ -148,14 +149,14 @@ H5Z_filter_fletcher32 (unsigned flags, size_t H5_ATTR_UNUSED cd_nelmts, const un
         dst += nbytes;
         UINT32ENCODE(dst, fletcher);
 
-        /* Free input buffer */
- 	H5MM_xfree(*buf);
+        /* Release input buffer */
+ 	H5Z_buf_free(*buf, *buf_size);
 
         /* Set return values */
-        *buf_size = nbytes + FLETCHER_LEN;
+        *buf_size = out_alloc;
 	*buf = outbuf;
 	outbuf = NULL;
-	ret_value = *buf_size;
+	ret_value = nbytes + FLETCHER_LEN;
     }
 
 done:
@@ -55,6 +55,17 @@ static herr_t H5Z_set_parms_array(const H5T_t *type, unsigned *cd_values_index,
 static herr_t H5Z_set_parms_compound(const H5T_t *type, unsigned *cd_values_index,
     unsigned cd_values[], hbool_t *need_not_compress);
 
+static hbool_t H5Z_nbit_atomic_fast(const parms_atomic *p);
+static uint64_t H5Z_nbit_get_atomic(const unsigned char *data, unsigned size,
+    unsigned order);
+static void H5Z_nbit_put_atomic(unsigned char *data, uint64_t val, unsigned size,
+    unsigned order);
+static void H5Z_nbit_unpack_atomic(unsigned char *data, unsigned d_nelmts,
+    const unsigned char *buffer, unsigned size, unsigned order,
+    unsigned precision, unsigned offset);
+static size_t H5Z_nbit_pack_atomic(const unsigned char *data, unsigned d_nelmts,
+    unsigned char *buffer, unsigned size, unsigned order,
+    unsigned precision, unsigned offset);
 static void H5Z_nbit_next_byte(size_t *j, size_t *buf_len);
 static void H5Z_nbit_decompress_one_byte(unsigned char *data, size_t data_offset,
     unsigned k, unsigned begin_i, unsigned end_i, unsigned char *buffer, size_t *j,
@@ -982,6 +993,7 @@ H5Z_filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
 {
     unsigned char *outbuf;      /* pointer to new output buffer */
     size_t size_out  = 0;       /* size of output buffer */
+    size_t out_alloc = 0;       /* allocated size of output buffer */
     unsigned d_nelmts = 0;      /* number of elements in the chunk */
     size_t ret_value = 0;       /* return value */
 
@@ -997,7 +1009,7 @@ H5Z_filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
      * cd_values[1] stores the flag if true indicating no need to compress
      */
     if(cd_values[1])
-        HGOTO_DONE(*buf_size)
+        HGOTO_DONE(nbytes)
 
     /* copy a filter parameter to d_nelmts */
     d_nelmts = cd_values[2];
@@ -1006,8 +1018,13 @@ H5Z_filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
     if(flags & H5Z_FLAG_REVERSE) {
         size_out = d_nelmts * cd_values[4]; /* cd_values[4] stores datatype size */
 
+        /* The packed bits of an atomic datatype must all be there
+         * (cd_values[6] stores its precision) */
+        if(cd_values[3] == H5Z_NBIT_ATOMIC && nbytes < ((size_t)d_nelmts * cd_values[6] + 7) / 8)
+            HGOTO_ERROR(H5E_PLINE, H5E_READERROR, 0, "nbit compressed data is truncated")
+
         /* allocate memory space for decompressed buffer */
-        if(NULL == (outbuf = (unsigned char *)H5MM_malloc(size_out)))
+        if(NULL == (outbuf = (unsigned char *)H5Z_buf_alloc(size_out, &out_alloc)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for nbit decompression")
 
         /* decompress the buffer */
@@ -1020,19 +1037,19 @@ H5Z_filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
         size_out = nbytes;
 
         /* allocate memory space for compressed buffer */
-        if(NULL == (outbuf = (unsigned char *)H5MM_malloc(size_out)))
+        if(NULL == (outbuf = (unsigned char *)H5Z_buf_alloc(size_out, &out_alloc)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for nbit compression")
 
         /* compress the buffer, size_out will be changed */
         H5Z_nbit_compress((unsigned char *)*buf, d_nelmts, outbuf, &size_out, cd_values);
     } /* end else */
 
-    /* free the input buffer */
-    H5MM_xfree(*buf);
+    /* release the input buffer */
+    H5Z_buf_free(*buf, *buf_size);
 
     /* set return values */
     *buf = outbuf;
-    *buf_size = size_out;
+    *buf_size = out_alloc;
     ret_value = size_out;
 
 done:
@@ -1045,8 +1062,278 @@ done:
  * assume size of unsigned char is one byte
  * assume one data item of certain datatype is stored continously in bytes
  * atomic datatype is treated on byte basis
+ *
+ * The packed data is a stream of bits, most significant bit of each byte
+ * first, holding the significant bits of each value from the most to the
+ * least significant one.  For an integer or floating-point dataset whose
+ * datatype is 1, 2, 4 or 8 bytes, the fast path below reads or writes the
+ * whole value as a word and moves its significant bits through a 64-bit
+ * accumulator, up to 32 bits at a time, instead of a byte at a time.
  */
 
+/* Whether the fast path can pack values of an atomic datatype */
+static hbool_t
+H5Z_nbit_atomic_fast(const parms_atomic *p)
+{
+    return (hbool_t)((p->size == 1 || p->size == 2 || p->size == 4 || p->size == 8) &&
+            p->precision > 0 && (p->order == H5Z_NBIT_ORDER_LE || p->order == H5Z_NBIT_ORDER_BE));
+}
+
+/* Read a value of an atomic datatype of SIZE bytes */
+static uint64_t
+H5Z_nbit_get_atomic(const unsigned char *data, unsigned size, unsigned order)
+{
+    uint64_t val = 0;
+    unsigned u;
+
+    if(order == H5Z_NBIT_ORDER_LE)
+        for(u = size; u > 0; u--)
+            val = (val << 8) | data[u - 1];
+    else
+        for(u = 0; u < size; u++)
+            val = (val << 8) | data[u];
+
+    return val;
+}
+
+/* Write a value of an atomic datatype of SIZE bytes */
+static void
+H5Z_nbit_put_atomic(unsigned char *data, uint64_t val, unsigned size, unsigned order)
+{
+    unsigned u;
+
+    if(order == H5Z_NBIT_ORDER_LE)
+        for(u = 0; u < size; u++, val >>= 8)
+            data[u] = (unsigned char)val;
+    else
+        for(u = size; u > 0; u--, val >>= 8)
+            data[u - 1] = (unsigned char)val;
+}
+
+/* Unpack D_NELMTS values of SIZE bytes from BUFFER, which holds at least all
+ * of their bits.  (Called with a constant size and byte order, which the
+ * compiler can specialize so the values are read and written whole.) */
+static void
+H5Z_nbit_unpack_atomic(unsigned char *data, unsigned d_nelmts,
+    const unsigned char *buffer, unsigned size, unsigned order,
+    unsigned precision, unsigned offset)
+{
+    size_t nbytes = ((size_t)d_nelmts * precision + 7) / 8;    /* Bytes of packed bits */
+    uint64_t acc = 0;           /* Bits read from the buffer but not yet used */
+    unsigned avail = 0;         /* Number of bits in acc */
+    unsigned high = precision > 32 ? precision - 32 : 0;   /* Bits above the low 32 */
+    unsigned low = precision - high;        /* Bits in the low part */
+    uint64_t low_mask = ((uint64_t)1 << low) - 1;
+    size_t j = 0;               /* Index in buffer */
+    unsigned i;
+
+    for(i = 0; i < d_nelmts; i++, data += size) {
+        uint64_t val = 0;
+
+        /* Values of more than 32 bits come in two parts (only 8-byte
+         * values have them).  With more than 32 bits of this value still
+         * to read, the buffer has another whole word. */
+        if(size == 8 && high) {
+            if(avail < high) {
+                acc = (acc << 32) | H5Z_nbit_get_atomic(buffer + j, 4, H5Z_NBIT_ORDER_BE);
+                j += 4;
+                avail += 32;
+            } /* end if */
+            avail -= high;
+            val = (acc >> avail) & (((uint64_t)1 << high) - 1);
+        } /* end if */
+
+        /* Top up the accumulator a 32-bit word at a time where the buffer
+         * has one left, and a byte at a time at its end */
+        if(avail < low) {
+            if(j + 4 <= nbytes) {
+                acc = (acc << 32) | H5Z_nbit_get_atomic(buffer + j, 4, H5Z_NBIT_ORDER_BE);
+                j += 4;
+                avail += 32;
+            } /* end if */
+            else
+                while(avail < low) {
+                    acc = (acc << 8) | buffer[j++];
+                    avail += 8;
+                } /* end while */
+        } /* end if */
+        avail -= low;
+        val = (val << low) | ((acc >> avail) & low_mask);
+
+        H5Z_nbit_put_atomic(data, val << offset, size, order);
+    } /* end for */
+}
+
+/* Pack D_NELMTS values of SIZE bytes into BUFFER and return the number of
+ * bytes of packed data.  (Called like H5Z_nbit_unpack_atomic) */
+static size_t
+H5Z_nbit_pack_atomic(const unsigned char *data, unsigned d_nelmts,
+    unsigned char *buffer, unsigned size, unsigned order,
+    unsigned precision, unsigned offset)
+{
+    uint64_t acc = 0;           /* Bits not yet written to the buffer */
+    unsigned nbits = 0;         /* Number of bits in acc */
+    unsigned high = precision > 32 ? precision - 32 : 0;   /* Bits above the low 32 */
+    unsigned low = precision - high;        /* Bits in the low part */
+    uint64_t low_mask = ((uint64_t)1 << low) - 1;
+    size_t j = 0;               /* Index in buffer */
+    unsigned i;
+
+    for(i = 0; i < d_nelmts; i++, data += size) {
+        uint64_t val = H5Z_nbit_get_atomic(data, size, order) >> offset;
+
+        /* Values of more than 32 bits go in two parts */
+        if(size == 8 && high) {
+            acc = (acc << high) | ((val >> 32) & (((uint64_t)1 << high) - 1));
+            nbits += high;
+            if(nbits >= 32) {
+                nbits -= 32;
+                H5Z_nbit_put_atomic(buffer + j, acc >> nbits, 4, H5Z_NBIT_ORDER_BE);
+                j += 4;
+            } /* end if */
+        } /* end if */
+
+        /* Write out each full 32-bit word */
+        acc = (acc << low) | (val & low_mask);
+        nbits += low;
+        if(nbits >= 32) {
+            nbits -= 32;
+            H5Z_nbit_put_atomic(buffer + j, acc >> nbits, 4, H5Z_NBIT_ORDER_BE);
+            j += 4;
+        } /* end if */
+    } /* end for */
+
+    /* Write out the remaining bits, padded with zeros in the last byte */
+    while(nbits >= 8) {
+        nbits -= 8;
+        buffer[j++] = (unsigned char)(acc >> nbits);
+    } /* end while */
+    buffer[j] = (unsigned char)(nbits ? (acc << (8 - nbits)) : 0);
+
+    /* (the same size the generic packer gives, with a whole last byte) */
+    return j + 1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__nbit_unpack
+ *
+ * Purpose:	Unpack D_NELMTS values of an integer or floating-point
+ *              datatype of SIZE (1, 2, 4 or 8) bytes and byte order ORDER
+ *              from BUFFER, the packed stream of the PRECISION bits of each
+ *              starting at bit OFFSET, into DATA.  The other bits of the
+ *              values are zeros.  BUFFER must hold all the packed bits.
+ *
+ * Return:	none
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__nbit_unpack(unsigned char *data, unsigned d_nelmts, const unsigned char *buffer,
+    unsigned size, H5T_order_t order, unsigned precision, unsigned offset)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(size == 1 || size == 2 || size == 4 || size == 8);
+    HDassert(order == H5T_ORDER_LE || order == H5T_ORDER_BE);
+    HDassert(precision > 0 && precision + offset <= size * 8);
+
+    if(order == H5T_ORDER_LE)
+        switch(size) {
+            case 1:
+                H5Z_nbit_unpack_atomic(data, d_nelmts, buffer, 1, H5Z_NBIT_ORDER_LE, precision, offset);
+                break;
+            case 2:
+                H5Z_nbit_unpack_atomic(data, d_nelmts, buffer, 2, H5Z_NBIT_ORDER_LE, precision, offset);
+                break;
+            case 4:
+                H5Z_nbit_unpack_atomic(data, d_nelmts, buffer, 4, H5Z_NBIT_ORDER_LE, precision, offset);
+                break;
+            default:
+                H5Z_nbit_unpack_atomic(data, d_nelmts, buffer, 8, H5Z_NBIT_ORDER_LE, precision, offset);
+                break;
+        } /* end switch */
+    else
+        switch(size) {
+            case 1:
+                H5Z_nbit_unpack_atomic(data, d_nelmts, buffer, 1, H5Z_NBIT_ORDER_BE, precision, offset);
+                break;
+            case 2:
+                H5Z_nbit_unpack_atomic(data, d_nelmts, buffer, 2, H5Z_NBIT_ORDER_BE, precision, offset);
+                break;
+            case 4:
+                H5Z_nbit_unpack_atomic(data, d_nelmts, buffer, 4, H5Z_NBIT_ORDER_BE, precision, offset);
+                break;
+            default:
+                H5Z_nbit_unpack_atomic(data, d_nelmts, buffer, 8, H5Z_NBIT_ORDER_BE, precision, offset);
+                break;
+        } /* end switch */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__nbit_unpack() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__nbit_pack
+ *
+ * Purpose:	Pack the PRECISION bits starting at bit OFFSET of D_NELMTS
+ *              values of an integer or floating-point datatype of SIZE (1,
+ *              2, 4 or 8) bytes and byte order ORDER from DATA into
+ *              BUFFER, which must have room for one byte more than the
+ *              packed bits need.
+ *
+ * Return:	The number of bytes of packed data: the packed bits and
+ *              then one more byte, partly or wholly padded with zeros
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5Z__nbit_pack(const unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
+    unsigned size, H5T_order_t order, unsigned precision, unsigned offset)
+{
+    size_t ret_value = 0;       /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(size == 1 || size == 2 || size == 4 || size == 8);
+    HDassert(order == H5T_ORDER_LE || order == H5T_ORDER_BE);
+    HDassert(precision > 0 && precision + offset <= size * 8);
+
+    if(order == H5T_ORDER_LE)
+        switch(size) {
+            case 1:
+                ret_value = H5Z_nbit_pack_atomic(data, d_nelmts, buffer, 1, H5Z_NBIT_ORDER_LE, precision, offset);
+                break;
+            case 2:
+                ret_value = H5Z_nbit_pack_atomic(data, d_nelmts, buffer, 2, H5Z_NBIT_ORDER_LE, precision, offset);
+                break;
+            case 4:
+                ret_value = H5Z_nbit_pack_atomic(data, d_nelmts, buffer, 4, H5Z_NBIT_ORDER_LE, precision, offset);
+                break;
+            default:
+                ret_value = H5Z_nbit_pack_atomic(data, d_nelmts, buffer, 8, H5Z_NBIT_ORDER_LE, precision, offset);
+                break;
+        } /* end switch */
+    else
+        switch(size) {
+            case 1:
+                ret_value = H5Z_nbit_pack_atomic(data, d_nelmts, buffer, 1, H5Z_NBIT_ORDER_BE, precision, offset);
+                break;
+            case 2:
+                ret_value = H5Z_nbit_pack_atomic(data, d_nelmts, buffer, 2, H5Z_NBIT_ORDER_BE, precision, offset);
+                break;
+            case 4:
+                ret_value = H5Z_nbit_pack_atomic(data, d_nelmts, buffer, 4, H5Z_NBIT_ORDER_BE, precision, offset);
+                break;
+            default:
+                ret_value = H5Z_nbit_pack_atomic(data, d_nelmts, buffer, 8, H5Z_NBIT_ORDER_BE, precision, offset);
+                break;
+        } /* end switch */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__nbit_pack() */
+
+
 static void
 H5Z_nbit_next_byte(size_t *j, size_t *buf_len)
 {
@@ -1279,6 +1566,21 @@ H5Z_nbit_decompress(unsigned char *data, unsigned d_nelmts, unsigned char *buffe
     parms_atomic p;
     unsigned parms_index; /* index in array parms used by compression/decompression functions */
 
+    /* Unpack values of a plain integer or floating-point datatype a word
+     * at a time */
+    if(parms[3] == H5Z_NBIT_ATOMIC) {
+        p.size = parms[4];
+        p.order = parms[5];
+        p.precision = parms[6];
+        p.offset = parms[7];
+        if(H5Z_nbit_atomic_fast(&p)) {
+            H5Z__nbit_unpack(data, d_nelmts, buffer, p.size,
+                    p.order == H5Z_NBIT_ORDER_LE ? H5T_ORDER_LE : H5T_ORDER_BE,
+                    p.precision, p.offset);
+            return;
+        }
+    }
+
     /* may not have to initialize to zeros */
     HDmemset(data, 0, d_nelmts * parms[4]);
 
@@ -1538,6 +1840,21 @@ H5Z_nbit_compress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
     parms_atomic p;
     unsigned parms_index; /* index in array parms used by compression/decompression functions */
 
+    /* Pack values of a plain integer or floating-point datatype a word
+     * at a time */
+    if(parms[3] == H5Z_NBIT_ATOMIC) {
+        p.size = parms[4];
+        p.order = parms[5];
+        p.precision = parms[6];
+        p.offset = parms[7];
+        if(H5Z_nbit_atomic_fast(&p)) {
+            *buffer_size = H5Z__nbit_pack(data, d_nelmts, buffer, p.size,
+                    p.order == H5Z_NBIT_ORDER_LE ? H5T_ORDER_LE : H5T_ORDER_BE,
+                    p.precision, p.offset);
+            return;
+        }
+    }
+
     /* must initialize buffer to be zeros */
     HDmemset(buffer, 0, *buffer_size);
 
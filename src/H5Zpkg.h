@@ -39,6 +39,9 @@ H5_DLLVAR H5Z_class2_t H5Z_NBIT[1];
 /* Scale/offset filter */
 H5_DLLVAR H5Z_class2_t H5Z_SCALEOFFSET[1];
 
+/* Bitshuffle+lz filter */
+H5_DLLVAR const H5Z_class2_t H5Z_BITSHUFFLE_LZ[1];
+
 /********************/
 /* External filters */
 /********************/
@@ -53,5 +56,40 @@ H5_DLLVAR const H5Z_class2_t H5Z_DEFLATE[1];
 H5_DLLVAR H5Z_class2_t H5Z_SZIP[1];
 #endif /* H5_HAVE_FILTER_SZIP */
 
+/****************************/
+/* Package Private Typedefs */
+/****************************/
+
+/* Byte transpose implementations for the shuffle filter, in order of speed */
+typedef enum H5Z_shuffle_kern_t {
+    H5Z_SHUFFLE_KERN_SCALAR = 0,    /* Portable, a byte at a time */
+    H5Z_SHUFFLE_KERN_SSE2,          /* 16 elements at a time with SSE2 */
+    H5Z_SHUFFLE_KERN_AVX2,          /* 32 elements at a time with AVX2 */
+    H5Z_SHUFFLE_KERN_NKERNS         /* Number of implementations (must be last) */
+} H5Z_shuffle_kern_t;
+
+/******************************/
+/* Package Private Prototypes */
+/******************************/
+
+/* Deflate routines */
+#ifdef H5_HAVE_FILTER_DEFLATE
+H5_DLL herr_t H5Z__deflate_init(void);
+H5_DLL int H5Z__deflate_term(void);
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+/* Nbit routines */
+H5_DLL void H5Z__nbit_unpack(unsigned char *data, unsigned d_nelmts,
+    const unsigned char *buffer, unsigned size, H5T_order_t order,
+    unsigned precision, unsigned offset);
+H5_DLL size_t H5Z__nbit_pack(const unsigned char *data, unsigned d_nelmts,
+    unsigned char *buffer, unsigned size, H5T_order_t order,
+    unsigned precision, unsigned offset);
+
+/* Shuffle routines */
+H5_DLL H5Z_shuffle_kern_t H5Z__shuffle_best_kern(void);
+H5_DLL void H5Z__shuffle_bytes(H5Z_shuffle_kern_t kern, hbool_t reverse,
+    unsigned elmt_size, size_t nbytes, const void *src, void *dest);
+
 #endif /* _H5Zpkg_H */
 
@@ -41,6 +41,7 @@ typedef int H5Z_filter_t;
 #define H5Z_FILTER_SZIP         4       /*szip compression              */
 #define H5Z_FILTER_NBIT         5       /*nbit compression              */
 #define H5Z_FILTER_SCALEOFFSET  6       /*scale+offset compression      */
+#define H5Z_FILTER_BITSHUFFLE_LZ 7      /*bit transpose+LZ compression  */
 #define H5Z_FILTER_RESERVED     256	/*filter ids below this value are reserved for library use */
 
 #define H5Z_FILTER_MAX		65535	/*maximum filter id		*/
@@ -79,6 +80,10 @@ typedef int H5Z_filter_t;
 #define H5Z_SHUFFLE_USER_NPARMS    0    /* Number of parameters that users can set */
 #define H5Z_SHUFFLE_TOTAL_NPARMS   1    /* Total number of parameters for filter */
 
+/* Macros for the bitshuffle+lz filter */
+#define H5Z_BITSHUFFLE_LZ_USER_NPARMS    0    /* Number of parameters that users can set */
+#define H5Z_BITSHUFFLE_LZ_TOTAL_NPARMS   1    /* Total number of parameters for filter */
+
 /* Macros for the szip filter */
 #define H5Z_SZIP_USER_NPARMS    2       /* Number of parameters that users can set */
 #define H5Z_SZIP_TOTAL_NPARMS   4       /* Total number of parameters for filter */
@@ -195,6 +200,11 @@ typedef herr_t (*H5Z_set_local_func_t)(hid_t dcpl_id, hid_t type_id, hid_t space
  * allocated size of the new buffer should be returned through the BUF_SIZE
  * pointer and the new buffer through the BUF pointer.
  *
+ * When the filter is called with H5Z_FLAG_REVERSE and the library knows
+ * the size of the data before any filters were applied to it (for example,
+ * the size of a dataset chunk), BUF_SIZE is at least that size, so a filter
+ * which decodes into a new buffer can usually allocate it just once.
+ *
  * The return value from the filter is the number of bytes in the output
  * buffer. If an error occurs then the function should return zero and leave
  * all pointer arguments unchanged.
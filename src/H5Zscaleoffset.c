@@ -30,13 +30,23 @@
 typedef struct {
    unsigned size;      /* datatype size */
    uint32_t minbits;   /* minimum bits to compress one value of such datatype */
-   unsigned mem_order; /* current memory endianness order */
+   unsigned mem_order; /* current memory endianness order (an H5T_order_t) */
 } parms_atomic;
 
 enum H5Z_scaleoffset_t {t_bad=0, t_uchar=1, t_ushort, t_uint, t_ulong, t_ulong_long,
                            t_schar, t_short, t_int, t_long, t_long_long,
                            t_float, t_double};
 
+/* The SSE2 search for the minimum and maximum values needs a compiler which
+ * can build code for an instruction set the whole library isn't compiled
+ * for (GCC 4.9 and later, or clang), like the shuffle filter's kernels */
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(H5_NO_SCALEOFFSET_SIMD) && \
+        (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define H5Z_SCALEOFFSET_X86
+#include <immintrin.h>
+#define H5Z_SCALEOFFSET_SSE2_ATTR   __attribute__((target("sse2")))
+#endif /* H5Z_SCALEOFFSET_X86 */
+
 /* Local function prototypes */
 static htri_t H5Z_can_apply_scaleoffset(hid_t dcpl_id, hid_t type_id, hid_t space_id);
 static enum H5Z_scaleoffset_t H5Z_scaleoffset_get_type(unsigned dtype_class,
@@ -61,21 +71,14 @@ static herr_t H5Z_scaleoffset_precompress_fd(void *data, unsigned d_nelmts,
 static herr_t H5Z_scaleoffset_postdecompress_fd(void *data, unsigned d_nelmts,
     enum H5Z_scaleoffset_t type, unsigned filavail, const unsigned cd_values[],
     uint32_t minbits, unsigned long long minval, double D_val);
-static void H5Z_scaleoffset_next_byte(size_t *j, unsigned *buf_len);
-static void H5Z_scaleoffset_decompress_one_byte(unsigned char *data, size_t data_offset,
-    unsigned k, unsigned begin_i, unsigned char *buffer, size_t *j, unsigned *buf_len,
-    parms_atomic p, unsigned dtype_len);
-static void H5Z_scaleoffset_compress_one_byte(unsigned char *data, size_t data_offset,
-    unsigned k, unsigned begin_i, unsigned char *buffer, size_t *j, unsigned *buf_len,
-    parms_atomic p, unsigned dtype_len);
-static void H5Z_scaleoffset_decompress_one_atomic(unsigned char *data, size_t data_offset,
-    unsigned char *buffer, size_t *j, unsigned *buf_len, parms_atomic p);
-static void H5Z_scaleoffset_compress_one_atomic(unsigned char *data, size_t data_offset,
-    unsigned char *buffer, size_t *j, unsigned *buf_len, parms_atomic p);
-static void H5Z_scaleoffset_decompress(unsigned char *data, unsigned d_nelmts,
-    unsigned char *buffer, parms_atomic p);
-static void H5Z_scaleoffset_compress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
-    size_t buffer_size, parms_atomic p);
+static unsigned H5Z_scaleoffset_max_min_vec(unsigned dtype_class, unsigned dtype_sign,
+    size_t dtype_size, const void *buf, unsigned start, unsigned d_nelmts,
+    const void *filval, double fil_eps, void *max, void *min);
+#ifdef H5Z_SCALEOFFSET_X86
+static unsigned H5Z_scaleoffset_max_min_sse2(unsigned dtype_class, unsigned dtype_sign,
+    size_t dtype_size, const void *buf, unsigned start, unsigned d_nelmts,
+    const void *filval, double fil_eps, void *max, void *min);
+#endif /* H5Z_SCALEOFFSET_X86 */
 
 /* This message derives from H5Z */
 H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
@@ -319,11 +322,16 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype") \
 }
 
-/* Find maximum and minimum values of a buffer with fill value defined for integer type */
-#define H5Z_scaleoffset_max_min_1(i, d_nelmts, buf, filval, max, min)\
+/* Find maximum and minimum values of a buffer with fill value defined for integer type
+ * (the vector search takes as many values as it can, a loop here the rest) */
+#define H5Z_scaleoffset_max_min_1(type, sign, i, d_nelmts, buf, filval, max, min)\
 {                                                                  \
    i = 0; while(i < d_nelmts && buf[i]== filval) i++;              \
-   if(i < d_nelmts) min = max = buf[i];                            \
+   if(i < d_nelmts) {                                              \
+      min = max = buf[i];                                          \
+      i = H5Z_scaleoffset_max_min_vec(H5Z_SCALEOFFSET_CLS_INTEGER, sign, sizeof(type), \
+              buf, i, d_nelmts, &filval, 0.0, &max, &min);         \
+   }                                                               \
    for(; i < d_nelmts; i++) {                                      \
       if(buf[i] == filval) continue; /* ignore fill value */       \
       if(buf[i] > max) max = buf[i];                               \
@@ -332,47 +340,36 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 }
 
 /* Find maximum and minimum values of a buffer with fill value undefined */
-#define H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)\
+#define H5Z_scaleoffset_max_min_2(type, cls, sign, i, d_nelmts, buf, max, min)\
 {                                                            \
    min = max = buf[0];                                       \
-   for(i = 0; i < d_nelmts; i++) {                           \
+   i = H5Z_scaleoffset_max_min_vec(cls, sign, sizeof(type),  \
+           buf, 0, d_nelmts, NULL, 0.0, &max, &min);         \
+   for(; i < d_nelmts; i++) {                                \
       if(buf[i] > max) max = buf[i];                         \
       if(buf[i] < min) min = buf[i];                         \
    }                                                         \
 }
 
 /* Find maximum and minimum values of a buffer with fill value defined for floating-point type */
-#define H5Z_scaleoffset_max_min_3(i, d_nelmts, buf, filval, max, min, D_val)      \
+#define H5Z_scaleoffset_max_min_3(type, i, d_nelmts, buf, filval, max, min, D_val) \
 {                                                                                 \
-   i = 0; while(i < d_nelmts && HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val)) i++; \
-   if(i < d_nelmts) min = max = buf[i];                                           \
+   double fil_eps = HDpow(10.0f, -D_val); /* closest to fill value that isn't */  \
+                                                                                  \
+   i = 0; while(i < d_nelmts && HDfabs(buf[i] - filval) < fil_eps) i++;           \
+   if(i < d_nelmts) {                                                             \
+      min = max = buf[i];                                                         \
+      i = H5Z_scaleoffset_max_min_vec(H5Z_SCALEOFFSET_CLS_FLOAT, 0, sizeof(type), \
+              buf, i, d_nelmts, &filval, fil_eps, &max, &min);                    \
+   }                                                                              \
    for(; i < d_nelmts; i++) {                                                     \
-      if(HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val))                          \
+      if(HDfabs(buf[i] - filval) < fil_eps)                                       \
          continue; /* ignore fill value */                                        \
       if(buf[i] > max) max = buf[i];                                              \
       if(buf[i] < min) min = buf[i];                                              \
    }                                                                              \
 }
 
-/* Find minimum value of a buffer with fill value defined for integer type */
-#define H5Z_scaleoffset_min_1(i, d_nelmts, buf, filval, min) \
-{                                                            \
-   i = 0; while(i < d_nelmts && buf[i]== filval) i++;        \
-   if(i < d_nelmts) min = buf[i];                            \
-   for(; i < d_nelmts; i++) {                                \
-      if(buf[i] == filval) continue; /* ignore fill value */ \
-      if(buf[i] < min) min = buf[i];                         \
-   }                                                         \
-}
-
-/* Find minimum value of a buffer with fill value undefined */
-#define H5Z_scaleoffset_min_2(i, d_nelmts, buf, min)\
-{                                                   \
-   min = buf[0];                                    \
-   for(i = 0; i < d_nelmts; i++)                    \
-      if(buf[i] < min) min = buf[i];                \
-}
-
 /* Check and handle special situation for unsigned integer type */
 #define H5Z_scaleoffset_check_1(type, max, min, minbits) \
 {                                                        \
@@ -421,23 +418,23 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
     if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */                \
         H5Z_scaleoffset_get_filval_1(type, cd_values, filval)                              \
         if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT) { /* minbits not set yet, calculate max, min, and minbits */ \
-            H5Z_scaleoffset_max_min_1(i, d_nelmts, buf, filval, max, min)                  \
+            H5Z_scaleoffset_max_min_1(type, H5Z_SCALEOFFSET_SGN_NONE, i, d_nelmts, buf, filval, max, min) \
             H5Z_scaleoffset_check_1(type, max, min, minbits)                               \
             span = (type)(max - min + 1);                                                  \
             *minbits = H5Z_scaleoffset_log2((unsigned long long)(span+1));                 \
         } else /* minbits already set, only calculate min */                               \
-            H5Z_scaleoffset_min_1(i, d_nelmts, buf, filval, min)                           \
+            H5Z_scaleoffset_max_min_1(type, H5Z_SCALEOFFSET_SGN_NONE, i, d_nelmts, buf, filval, max, min) \
         if(*minbits != sizeof(type)*8) /* change values if minbits != full precision */    \
             for(i = 0; i < d_nelmts; i++)                                                  \
                 buf[i] = (type)((buf[i] == filval) ? (((type)1 << *minbits) - 1) : (buf[i] - min)); \
     } else { /* fill value undefined */                                                    \
         if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT ) { /* minbits not set yet, calculate max, min, and minbits */ \
-            H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)                          \
+            H5Z_scaleoffset_max_min_2(type, H5Z_SCALEOFFSET_CLS_INTEGER, H5Z_SCALEOFFSET_SGN_NONE, i, d_nelmts, buf, max, min) \
             H5Z_scaleoffset_check_1(type, max, min, minbits)                               \
             span = (type)(max - min + 1);                                                  \
             *minbits = H5Z_scaleoffset_log2((unsigned long long)span);                     \
         } else /* minbits already set, only calculate min */                               \
-            H5Z_scaleoffset_min_2(i, d_nelmts, buf, min)                                   \
+            H5Z_scaleoffset_max_min_2(type, H5Z_SCALEOFFSET_CLS_INTEGER, H5Z_SCALEOFFSET_SGN_NONE, i, d_nelmts, buf, max, min) \
         if(*minbits != sizeof(type)*8) /* change values if minbits != full precision */    \
             for(i = 0; i < d_nelmts; i++)                                                  \
                 buf[i] = (type)(buf[i] - min);                                             \
@@ -454,23 +451,23 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
    if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */                   \
       H5Z_scaleoffset_get_filval_1(type, cd_values, filval)                                  \
       if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT) { /* minbits not set yet, calculate max, min, and minbits */ \
-         H5Z_scaleoffset_max_min_1(i, d_nelmts, buf, filval, max, min)                       \
+         H5Z_scaleoffset_max_min_1(type, H5Z_SCALEOFFSET_SGN_2, i, d_nelmts, buf, filval, max, min) \
          H5Z_scaleoffset_check_2(type, max, min, minbits)                                    \
          span = (unsigned type)(max - min + 1);                                              \
          *minbits = H5Z_scaleoffset_log2((unsigned long long)(span + 1));                    \
       } else /* minbits already set, only calculate min */                                   \
-         H5Z_scaleoffset_min_1(i, d_nelmts, buf, filval, min)                                \
+         H5Z_scaleoffset_max_min_1(type, H5Z_SCALEOFFSET_SGN_2, i, d_nelmts, buf, filval, max, min) \
       if(*minbits != sizeof(type) * 8) /* change values if minbits != full precision */      \
          for(i = 0; i < d_nelmts; i++)                                                       \
             buf[i] = (type)((buf[i] == filval) ? (type)(((unsigned type)1 << *minbits) - 1) : (buf[i] - min)); \
    } else { /* fill value undefined */                                                       \
       if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT ) { /* minbits not set yet, calculate max, min, and minbits */\
-         H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)                               \
+         H5Z_scaleoffset_max_min_2(type, H5Z_SCALEOFFSET_CLS_INTEGER, H5Z_SCALEOFFSET_SGN_2, i, d_nelmts, buf, max, min) \
          H5Z_scaleoffset_check_2(type, max, min, minbits)                                    \
          span = (unsigned type)(max - min + 1);                                              \
          *minbits = H5Z_scaleoffset_log2((unsigned long long)span);                          \
       } else /* minbits already set, only calculate min */                                   \
-         H5Z_scaleoffset_min_2(i, d_nelmts, buf, min)                                        \
+         H5Z_scaleoffset_max_min_2(type, H5Z_SCALEOFFSET_CLS_INTEGER, H5Z_SCALEOFFSET_SGN_2, i, d_nelmts, buf, max, min) \
       if(*minbits != sizeof(type) * 8) /* change values if minbits != full precision */      \
          for(i = 0; i < d_nelmts; i++)                                                       \
             buf[i] = (type)(buf[i] - min);                                                   \
@@ -481,26 +478,30 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Modify values of data in precompression if fill value defined for floating-point type */
 #define H5Z_scaleoffset_modify_1(i, type, pow_fun, abs_fun, lround_fun, llround_fun, buf, d_nelmts, filval, minbits, min, D_val) \
 {                                                                                     \
+   type scale = pow_fun(10.0f, (type)D_val);      /* computed once, not per value */  \
+   type fil_eps = pow_fun(10.0f, (type)-D_val);                                       \
+   type min_scaled = min * scale;                                                     \
+                                                                                      \
    if(sizeof(type) == sizeof(int))                                                    \
       for(i = 0; i < d_nelmts; i++) {                                                 \
-         if(abs_fun(buf[i] - filval) < pow_fun(10.0f, (type)-D_val))                  \
+         if(abs_fun(buf[i] - filval) < fil_eps)                                       \
             *(int *)&buf[i] = (int)(((unsigned int)1 << *minbits) - 1);               \
          else                                                                         \
-            *(int *)&buf[i] = (int)lround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val));  \
+            *(int *)&buf[i] = (int)lround_fun(buf[i] * scale - min_scaled);           \
       }                                                                               \
    else if(sizeof(type) == sizeof(long))                                              \
       for(i = 0; i < d_nelmts; i++) {                                                 \
-         if(abs_fun(buf[i] - filval) < pow_fun(10.0f, (type)-D_val))                  \
+         if(abs_fun(buf[i] - filval) < fil_eps)                                       \
             *(long *)&buf[i] = (long)(((unsigned long)1 << *minbits) - 1);            \
          else                                                                         \
-            *(long *)&buf[i] = lround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)); \
+            *(long *)&buf[i] = lround_fun(buf[i] * scale - min_scaled);               \
       }                                                                               \
    else if(sizeof(type) == sizeof(long long))                                         \
       for(i = 0; i < d_nelmts; i++) {                                                 \
-         if(abs_fun(buf[i] - filval) < pow_fun(10.0f, (type)-D_val))                  \
+         if(abs_fun(buf[i] - filval) < fil_eps)                                       \
             *(long long *)&buf[i] = (long long)(((unsigned long long)1 << *minbits) - 1); \
          else                                                                         \
-            *(long long *)&buf[i] = llround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)); \
+            *(long long *)&buf[i] = llround_fun(buf[i] * scale - min_scaled);         \
       }                                                                               \
    else                                                                               \
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype") \
@@ -509,15 +510,18 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Modify values of data in precompression if fill value undefined for floating-point type */
 #define H5Z_scaleoffset_modify_2(i, type, pow_fun, lround_fun, llround_fun, buf, d_nelmts, min, D_val)         \
 {                                                                                     \
+   type scale = pow_fun(10.0f, (type)D_val);      /* computed once, not per value */  \
+   type min_scaled = min * scale;                                                     \
+                                                                                      \
    if(sizeof(type) == sizeof(int))                                                    \
       for(i = 0; i < d_nelmts; i++)                                                   \
-         *(int *)&buf[i] = (int)lround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val));     \
+         *(int *)&buf[i] = (int)lround_fun(buf[i] * scale - min_scaled);              \
    else if(sizeof(type) == sizeof(long))                                              \
       for(i = 0; i < d_nelmts; i++)                                                   \
-         *(long *)&buf[i] = lround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val));    \
+         *(long *)&buf[i] = lround_fun(buf[i] * scale - min_scaled);                  \
    else if(sizeof(type) == sizeof(long long))                                         \
       for(i = 0; i < d_nelmts; i++)                                                   \
-         *(long long *)&buf[i] = llround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)); \
+         *(long long *)&buf[i] = llround_fun(buf[i] * scale - min_scaled);            \
    else                                                                               \
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype") \
 }
@@ -552,14 +556,14 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
    *minval = 0;                                                                          \
    if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */               \
       H5Z_scaleoffset_get_filval_2(type, cd_values, filval)                              \
-      H5Z_scaleoffset_max_min_3(i, d_nelmts, buf, filval, max, min, D_val)               \
+      H5Z_scaleoffset_max_min_3(type, i, d_nelmts, buf, filval, max, min, D_val)         \
       H5Z_scaleoffset_check_3(i, type, pow_fun, round_fun, max, min, minbits, D_val)                \
       span = (unsigned long long)(llround_fun(max * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)) + 1); \
       *minbits = H5Z_scaleoffset_log2(span + 1);                                         \
       if(*minbits != sizeof(type) * 8) /* change values if minbits != full precision */  \
          H5Z_scaleoffset_modify_1(i, type, pow_fun, abs_fun, lround_fun, llround_fun, buf, d_nelmts, filval, minbits, min, D_val)   \
    } else { /* fill value undefined */                                                   \
-      H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)                              \
+      H5Z_scaleoffset_max_min_2(type, H5Z_SCALEOFFSET_CLS_FLOAT, 0, i, d_nelmts, buf, max, min) \
       H5Z_scaleoffset_check_3(i, type, pow_fun, round_fun, max, min, minbits, D_val)                \
       span = (unsigned long long)(llround_fun(max * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)) + 1); \
       *minbits = H5Z_scaleoffset_log2(span);                                             \
@@ -619,18 +623,20 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Modify values of data in postdecompression if fill value defined for floating-point type */
 #define H5Z_scaleoffset_modify_3(i, type, pow_fun, buf, d_nelmts, filval, minbits, min, D_val)     \
 {                                                                                         \
+   type scale = pow_fun(10.0f, (type)D_val);        /* computed once, not per value */    \
+                                                                                          \
    if(sizeof(type) == sizeof(int))                                                          \
       for(i = 0; i < d_nelmts; i++)                                                       \
          buf[i] = (type)((*(int *)&buf[i] == (int)(((unsigned int)1 << minbits) - 1)) ?   \
-                  filval : (type)(*(int *)&buf[i]) / pow_fun(10.0f, (type)D_val) + min);        \
+                  filval : (type)(*(int *)&buf[i]) / scale + min);                        \
    else if(sizeof(type) == sizeof(long))                                                    \
       for(i = 0; i < d_nelmts; i++)                                                       \
          buf[i] = (type)((*(long *)&buf[i] == (long)(((unsigned long)1 << minbits) - 1)) ? \
-                  filval : (type)(*(long *)&buf[i]) / pow_fun(10.0f, (type)D_val) + min);       \
+                  filval : (type)(*(long *)&buf[i]) / scale + min);                       \
    else if(sizeof(type) == sizeof(long long))                                               \
       for(i = 0; i < d_nelmts; i++)                                                       \
          buf[i] = (type)((*(long long *)&buf[i] == (long long)(((unsigned long long)1 << minbits) - 1)) ? \
-                  filval : (type)(*(long long *)&buf[i]) / pow_fun(10.0f, (type)D_val) + min);  \
+                  filval : (type)(*(long long *)&buf[i]) / scale + min);                  \
    else                                                                                   \
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype")    \
 }
@@ -638,15 +644,17 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Modify values of data in postdecompression if fill value undefined for floating-point type */
 #define H5Z_scaleoffset_modify_4(i, type, pow_fun, buf, d_nelmts, min, D_val)                   \
 {                                                                                      \
+   type scale = pow_fun(10.0f, (type)D_val);        /* computed once, not per value */ \
+                                                                                       \
    if(sizeof(type)==sizeof(int))                                                       \
       for(i = 0; i < d_nelmts; i++)                                                    \
-         buf[i] = ((type)(*(int *)&buf[i]) / pow_fun(10.0f, (type)D_val) + min);       \
+         buf[i] = ((type)(*(int *)&buf[i]) / scale + min);                             \
    else if(sizeof(type)==sizeof(long))                                                 \
       for(i = 0; i < d_nelmts; i++)                                                    \
-         buf[i] = ((type)(*(long *)&buf[i]) / pow_fun(10.0f, (type)D_val) + min);      \
+         buf[i] = ((type)(*(long *)&buf[i]) / scale + min);                            \
    else if(sizeof(type)==sizeof(long long))                                            \
       for(i = 0; i < d_nelmts; i++)                                                    \
-         buf[i] = ((type)(*(long long *)&buf[i]) / pow_fun(10.0f, (type)D_val) + min); \
+         buf[i] = ((type)(*(long long *)&buf[i]) / scale + min);                       \
    else                                                                                \
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype") \
 }
@@ -1091,6 +1099,7 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
 {
     size_t ret_value = 0;           /* return value */
     size_t size_out  = 0;           /* size of output buffer */
+    size_t out_alloc = 0;           /* allocated size of output buffer */
     unsigned d_nelmts = 0;          /* number of data elements in the chunk */
     unsigned dtype_class;           /* datatype class */
     unsigned dtype_sign;            /* integer datatype sign */
@@ -1176,7 +1185,7 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
 
         /* no need to process data */
         if(scale_factor == (int)(cd_values[H5Z_SCALEOFFSET_PARM_SIZE] * 8)) {
-            ret_value = *buf_size;
+            ret_value = nbytes;
             goto done;
         }
         minbits = (uint32_t)scale_factor;
@@ -1195,6 +1204,9 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
         unsigned long long minval_mask = 0;
         unsigned minval_size = 0;
 
+        if(nbytes < buf_offset)
+            HGOTO_ERROR(H5E_PLINE, H5E_READERROR, 0, "scaleoffset compressed data is truncated")
+
         minbits = 0;
         for(i = 0; i < 4; i++) {
             minbits_mask = ((unsigned char *)*buf)[i];
@@ -1215,14 +1227,19 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
             minval |= minval_mask;
         }
 
-        HDassert(minbits <= p.size * 8);
+        if(minbits > p.size * 8)
+            HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, 0, "minimum number of bits exceeds maximum")
         p.minbits = minbits;
 
         /* calculate size of output buffer after decompression */
         size_out = d_nelmts * p.size;
 
+        /* The packed bits (or the values, at full precision) must all be there */
+        if(nbytes - buf_offset < (minbits == p.size * 8 ? size_out : ((size_t)d_nelmts * minbits + 7) / 8))
+            HGOTO_ERROR(H5E_PLINE, H5E_READERROR, 0, "scaleoffset compressed data is truncated")
+
         /* allocate memory space for decompressed buffer */
-        if(NULL == (outbuf = (unsigned char *)H5MM_malloc(size_out)))
+        if(NULL == (outbuf = (unsigned char *)H5Z_buf_alloc(size_out, &out_alloc)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for scaleoffset decompression")
 
         /* special case: minbits equal to full precision */
@@ -1233,16 +1250,18 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
             if(need_convert)
                 H5Z_scaleoffset_convert(outbuf, d_nelmts, p.size);
 
+            H5Z_buf_free(*buf, *buf_size);
             *buf = outbuf;
             outbuf = NULL;
-            *buf_size = size_out;
+            *buf_size = out_alloc;
             ret_value = size_out;
             goto done;
         }
 
         /* decompress the buffer if minbits not equal to zero */
         if(minbits != 0)
-            H5Z_scaleoffset_decompress(outbuf, d_nelmts, (unsigned char*)(*buf)+buf_offset, p);
+            H5Z__nbit_unpack(outbuf, d_nelmts, (unsigned char*)(*buf)+buf_offset, p.size,
+                             (H5T_order_t)p.mem_order, minbits, 0);
         else {
             /* fill value is not defined and all data elements have the same value */
             for(i = 0; i < size_out; i++) outbuf[i] = 0;
@@ -1301,7 +1320,7 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
         size_out = buf_offset + nbytes * p.minbits / (p.size * 8) + 1; /* may be 1 larger */
 
         /* allocate memory space for compressed buffer */
-        if(NULL == (outbuf = (unsigned char *)H5MM_malloc(size_out)))
+        if(NULL == (outbuf = (unsigned char *)H5Z_buf_alloc(size_out, &out_alloc)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for scaleoffset compression")
 
         /* store minbits and minval in the front of output compressed buffer
@@ -1326,9 +1345,10 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
         /* special case: minbits equal to full precision */
         if(minbits == p.size * 8) {
             HDmemcpy(outbuf + buf_offset, *buf, nbytes);
+            H5Z_buf_free(*buf, *buf_size);
             *buf = outbuf;
             outbuf = NULL;
-            *buf_size = size_out;
+            *buf_size = out_alloc;
             ret_value = buf_offset + nbytes;
             goto done;
         }
@@ -1338,16 +1358,17 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
          * all data elements have the same value
          */
         if(minbits != 0)
-            H5Z_scaleoffset_compress((unsigned char *)*buf, d_nelmts, outbuf + buf_offset, size_out - buf_offset, p);
+            size_out = buf_offset + H5Z__nbit_pack((unsigned char *)*buf, d_nelmts, outbuf + buf_offset,
+                             p.size, (H5T_order_t)p.mem_order, minbits, 0);
     }
 
-    /* free the input buffer */
-    H5MM_xfree(*buf);
+    /* release the input buffer */
+    H5Z_buf_free(*buf, *buf_size);
 
     /* set return values */
     *buf = outbuf;
     outbuf = NULL;
-    *buf_size = size_out;
+    *buf_size = out_alloc;
     ret_value = size_out;
 
 done:
@@ -1435,7 +1456,7 @@ H5Z_scaleoffset_precompress_i(void *data, unsigned d_nelmts, enum H5Z_scaleoffse
         if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */
             H5Z_scaleoffset_get_filval_1(signed char, cd_values, filval);
             if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT) { /* minbits not set yet, calculate max, min, and minbits */
-                H5Z_scaleoffset_max_min_1(i, d_nelmts, buf, filval, max, min)
+                H5Z_scaleoffset_max_min_1(signed char, H5Z_SCALEOFFSET_SGN_2, i, d_nelmts, buf, filval, max, min)
                 if((unsigned char)(max - min) > (unsigned char)(~(unsigned char)0 - 2)) {
                     *minbits = sizeof(signed char)*8;
                     return;
@@ -1443,13 +1464,13 @@ H5Z_scaleoffset_precompress_i(void *data, unsigned d_nelmts, enum H5Z_scaleoffse
                 span = (unsigned char)(max - min + 1);
                 *minbits = H5Z_scaleoffset_log2((unsigned long long)(span+1));
             } else /* minbits already set, only calculate min */
-                H5Z_scaleoffset_min_1(i, d_nelmts, buf, filval, min)
+                H5Z_scaleoffset_max_min_1(signed char, H5Z_SCALEOFFSET_SGN_2, i, d_nelmts, buf, filval, max, min)
             if(*minbits != sizeof(signed char)*8) /* change values if minbits != full precision */
                 for(i = 0; i < d_nelmts; i++)
                     buf[i] = (signed char)((buf[i] == filval) ? (((unsigned char)1 << *minbits) - 1) : (buf[i] - min));
         } else { /* fill value undefined */
             if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT) { /* minbits not set yet, calculate max, min, and minbits */
-                H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)
+                H5Z_scaleoffset_max_min_2(signed char, H5Z_SCALEOFFSET_CLS_INTEGER, H5Z_SCALEOFFSET_SGN_2, i, d_nelmts, buf, max, min)
                 if((unsigned char)(max - min) > (unsigned char)(~(unsigned char)0 - 2)) {
                     *minbits = sizeof(signed char)*8;
                     *minval = (unsigned long long)min;
@@ -1458,7 +1479,7 @@ H5Z_scaleoffset_precompress_i(void *data, unsigned d_nelmts, enum H5Z_scaleoffse
                 span = (unsigned char)(max - min + 1);
                 *minbits = H5Z_scaleoffset_log2((unsigned long long)span);
             } else /* minbits already set, only calculate min */
-                H5Z_scaleoffset_min_2(i, d_nelmts, buf, min)
+                H5Z_scaleoffset_max_min_2(signed char, H5Z_SCALEOFFSET_CLS_INTEGER, H5Z_SCALEOFFSET_SGN_2, i, d_nelmts, buf, max, min)
             if(*minbits != sizeof(signed char) * 8) /* change values if minbits != full precision */
                 for(i = 0; i < d_nelmts; i++)
                     buf[i] = (signed char)(buf[i] - min);
@@ -1572,177 +1593,184 @@ done:
    FUNC_LEAVE_NOAPI(ret_value)
 }
 
-static void
-H5Z_scaleoffset_next_byte(size_t *j, unsigned *buf_len)
+/* Fold values START to D_NELMTS of BUF into *MAX and *MIN, which already
+ * hold one of its values, a vector at a time.  Values equal to the fill
+ * value FILVAL (for floating-point values, closer to it than FIL_EPS) are
+ * ignored, unless FILVAL is NULL.  Returns the index of the first value not
+ * searched: the vector search leaves the values after its last whole
+ * vector, and datatypes or CPUs it doesn't know, to the caller's loop. */
+static unsigned
+H5Z_scaleoffset_max_min_vec(unsigned dtype_class, unsigned dtype_sign,
+    size_t dtype_size, const void *buf, unsigned start, unsigned d_nelmts,
+    const void *filval, double fil_eps, void *max, void *min)
 {
-   ++(*j);
-   *buf_len = 8 * sizeof(unsigned char);
+#ifdef H5Z_SCALEOFFSET_X86
+    /* (uses the shuffle filter's check of what the CPU supports) */
+    if(H5Z__shuffle_best_kern() >= H5Z_SHUFFLE_KERN_SSE2)
+        return H5Z_scaleoffset_max_min_sse2(dtype_class, dtype_sign, dtype_size,
+                buf, start, d_nelmts, filval, fil_eps, max, min);
+#endif /* H5Z_SCALEOFFSET_X86 */
+
+    return start;
 }
 
-static void
-H5Z_scaleoffset_decompress_one_byte(unsigned char *data, size_t data_offset,
-    unsigned k, unsigned begin_i, unsigned char *buffer, size_t *j, unsigned *buf_len,
-    parms_atomic p, unsigned dtype_len)
+#ifdef H5Z_SCALEOFFSET_X86
+/* SSE2 has no 32-bit integer maximum or minimum instructions */
+static H5_INLINE H5Z_SCALEOFFSET_SSE2_ATTR __m128i
+H5Z_scaleoffset_max_epi32(__m128i a, __m128i b)
 {
-   unsigned dat_len;    /* dat_len is the number of bits to be copied in each data byte */
-   unsigned char val;   /* value to be copied in each data byte */
+    __m128i gt = _mm_cmpgt_epi32(a, b);
 
-   /* initialize value and bits of unsigned char to be copied */
-   val = buffer[*j];
-   if(k == begin_i)
-      dat_len = 8 - (dtype_len - p.minbits) % 8;
-   else
-      dat_len = 8;
-
-   if(*buf_len > dat_len) {
-      data[data_offset + k] = (unsigned char)((unsigned)(val >> (*buf_len - dat_len)) & (unsigned)(~((unsigned)~0 << dat_len)));
-      *buf_len -= dat_len;
-   } /* end if */
-   else {
-      data[data_offset + k] = (unsigned char)((val & ~((unsigned)(~0) << *buf_len)) << (dat_len - *buf_len));
-      dat_len -= *buf_len;
-      H5Z_scaleoffset_next_byte(j, buf_len);
-      if(dat_len == 0)
-          return;
-
-      val = buffer[*j];
-      data[data_offset + k] |= (unsigned char)((unsigned)(val >> (*buf_len - dat_len)) & ~((unsigned)(~0) << dat_len));
-      *buf_len -= dat_len;
-   } /* end else */
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
 }
 
-static void
-H5Z_scaleoffset_decompress_one_atomic(unsigned char *data, size_t data_offset,
-    unsigned char *buffer, size_t *j, unsigned *buf_len, parms_atomic p)
+static H5_INLINE H5Z_SCALEOFFSET_SSE2_ATTR __m128i
+H5Z_scaleoffset_min_epi32(__m128i a, __m128i b)
 {
-   /* begin_i: the index of byte having first significant bit */
-   unsigned begin_i;
-   unsigned dtype_len;
-   int k;
-
-   HDassert(p.minbits > 0);
+    __m128i gt = _mm_cmpgt_epi32(a, b);
 
-   dtype_len = p.size * 8;
-
-   if(p.mem_order == H5Z_SCALEOFFSET_ORDER_LE) { /* little endian */
-      begin_i = p.size - 1 - (dtype_len - p.minbits) / 8;
-
-      for(k = (int)begin_i; k >= 0; k--)
-         H5Z_scaleoffset_decompress_one_byte(data, data_offset, (unsigned)k, begin_i,
-                                             buffer, j, buf_len, p, dtype_len);
-   }
-   else { /* big endian */
-      HDassert(p.mem_order == H5Z_SCALEOFFSET_ORDER_BE);
-
-      begin_i = (dtype_len - p.minbits) / 8;
-
-      for(k = (int)begin_i; k <= (int)(p.size - 1); k++)
-         H5Z_scaleoffset_decompress_one_byte(data, data_offset, (unsigned)k, begin_i,
-                                             buffer, j, buf_len, p, dtype_len);
-   }
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
 }
 
-static void
-H5Z_scaleoffset_decompress(unsigned char *data, unsigned d_nelmts,
-    unsigned char *buffer, parms_atomic p)
-{
-    /* i: index of data, j: index of buffer,
-       buf_len: number of bits to be filled in current byte */
-    size_t i, j;
-    unsigned buf_len;
-
-    /* must initialize to zeros */
-    for(i = 0; i < d_nelmts * p.size; i++)
-        data[i] = 0;
-
-    /* initialization before the loop */
-    j = 0;
-    buf_len = sizeof(unsigned char) * 8;
-
-    /* decompress */
-    for(i = 0; i < d_nelmts; i++)
-        H5Z_scaleoffset_decompress_one_atomic(data, i * p.size, buffer, &j, &buf_len, p);
+/* Search integers of TYPE, 16 bytes at a time.  The values are XORed with
+ * BIAS, to make them fit the signedness of the MAX_OP and MIN_OP
+ * instructions, and fill values are replaced by the lane's maximum or
+ * minimum so far before they're compared.  (SET1 takes a STYPE) */
+#define H5Z_SCALEOFFSET_SSE2_INT(type, stype, bias, set1, cmpeq, max_op, min_op) \
+{                                                                             \
+    const type *b = (const type *)buf;                                        \
+    const unsigned nlanes = 16 / sizeof(type);                                \
+    __m128i vbias = set1((stype)(bias));                                      \
+    __m128i vmax = _mm_xor_si128(set1((stype)*(type *)max), vbias);           \
+    __m128i vmin = _mm_xor_si128(set1((stype)*(type *)min), vbias);           \
+    type lmax[16 / sizeof(type)], lmin[16 / sizeof(type)];                    \
+                                                                              \
+    if(filval) {                                                              \
+        __m128i vfil = _mm_xor_si128(set1((stype)*(const type *)filval), vbias); \
+                                                                              \
+        for(; i + nlanes <= d_nelmts; i += nlanes) {                          \
+            __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(b + i)), vbias); \
+            __m128i fil = cmpeq(v, vfil);                                     \
+                                                                              \
+            vmax = max_op(vmax, _mm_or_si128(_mm_and_si128(fil, vmax), _mm_andnot_si128(fil, v))); \
+            vmin = min_op(vmin, _mm_or_si128(_mm_and_si128(fil, vmin), _mm_andnot_si128(fil, v))); \
+        }                                                                     \
+    }                                                                         \
+    else                                                                      \
+        for(; i + nlanes <= d_nelmts; i += nlanes) {                          \
+            __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(b + i)), vbias); \
+                                                                              \
+            vmax = max_op(vmax, v);                                           \
+            vmin = min_op(vmin, v);                                           \
+        }                                                                     \
+                                                                              \
+    _mm_storeu_si128((__m128i *)lmax, _mm_xor_si128(vmax, vbias));            \
+    _mm_storeu_si128((__m128i *)lmin, _mm_xor_si128(vmin, vbias));            \
+    for(u = 0; u < nlanes; u++) {                                             \
+        if(lmax[u] > *(type *)max) *(type *)max = lmax[u];                    \
+        if(lmin[u] < *(type *)min) *(type *)min = lmin[u];                    \
+    }                                                                         \
 }
 
-static void
-H5Z_scaleoffset_compress_one_byte(unsigned char *data, size_t data_offset,
-    unsigned k, unsigned begin_i, unsigned char *buffer, size_t *j, unsigned *buf_len,
-    parms_atomic p, unsigned dtype_len)
-{
-   unsigned dat_len;    /* dat_len is the number of bits to be copied in each data byte */
-   unsigned char val;   /* value to be copied in each data byte */
-
-   /* initialize value and bits of unsigned char to be copied */
-   val = data[data_offset + k];
-   if(k == begin_i)
-      dat_len = 8 - (dtype_len - p.minbits) % 8;
-   else
-      dat_len = 8;
-
-   if(*buf_len > dat_len) {
-      buffer[*j] |= (unsigned char)((val & ~((unsigned)(~0) << dat_len)) << (*buf_len - dat_len));
-      *buf_len -= dat_len;
-   } else {
-      buffer[*j] |= (unsigned char)((unsigned)(val >> (dat_len - *buf_len)) & ~((unsigned)(~0) << *buf_len));
-      dat_len -= *buf_len;
-      H5Z_scaleoffset_next_byte(j, buf_len);
-      if(dat_len == 0)
-          return;
-
-      buffer[*j] = (unsigned char)((val & ~((unsigned)(~0) << dat_len)) << (*buf_len - dat_len));
-      *buf_len -= dat_len;
-   } /* end else */
+/* Search floating-point values of TYPE, 16 bytes at a time.  FIL_NEAR(v)
+ * is the mask of the lanes of v close to the fill value.  _mm_max_ps(a, b),
+ * like the loop in H5Z_scaleoffset_max_min_3, is b when a is a NaN, and so
+ * are the others. */
+#define H5Z_SCALEOFFSET_SSE2_FP(type, vtype, sfx, fil_near)                   \
+{                                                                             \
+    const type *b = (const type *)buf;                                        \
+    const unsigned nlanes = 16 / sizeof(type);                                \
+    vtype vmax = _mm_set1_##sfx(*(type *)max);                                \
+    vtype vmin = _mm_set1_##sfx(*(type *)min);                                \
+    type lmax[16 / sizeof(type)], lmin[16 / sizeof(type)];                    \
+                                                                              \
+    if(filval)                                                                \
+        for(; i + nlanes <= d_nelmts; i += nlanes) {                          \
+            vtype v = _mm_loadu_##sfx(b + i);                                 \
+            vtype fil = fil_near(v);                                          \
+                                                                              \
+            vmax = _mm_max_##sfx(_mm_or_##sfx(_mm_and_##sfx(fil, vmax), _mm_andnot_##sfx(fil, v)), vmax); \
+            vmin = _mm_min_##sfx(_mm_or_##sfx(_mm_and_##sfx(fil, vmin), _mm_andnot_##sfx(fil, v)), vmin); \
+        }                                                                     \
+    else                                                                      \
+        for(; i + nlanes <= d_nelmts; i += nlanes) {                          \
+            vtype v = _mm_loadu_##sfx(b + i);                                 \
+                                                                              \
+            vmax = _mm_max_##sfx(v, vmax);                                    \
+            vmin = _mm_min_##sfx(v, vmin);                                    \
+        }                                                                     \
+                                                                              \
+    _mm_storeu_##sfx(lmax, vmax);                                             \
+    _mm_storeu_##sfx(lmin, vmin);                                             \
+    for(u = 0; u < nlanes; u++) {                                             \
+        if(lmax[u] > *(type *)max) *(type *)max = lmax[u];                    \
+        if(lmin[u] < *(type *)min) *(type *)min = lmin[u];                    \
+    }                                                                         \
 }
 
-static void
-H5Z_scaleoffset_compress_one_atomic(unsigned char *data, size_t data_offset,
-    unsigned char *buffer, size_t *j, unsigned *buf_len, parms_atomic p)
+/* Fill value masks for floats and doubles: |v - filval| < fil_eps, with
+ * |v - filval| computed in the value's precision */
+#define H5Z_SCALEOFFSET_SSE2_NEAR_PS(v)                                       \
+    _mm_cmple_ps(_mm_andnot_ps(vsign_ps, _mm_sub_ps(v, vfil_ps)), veps_ps)
+#define H5Z_SCALEOFFSET_SSE2_NEAR_PD(v)                                       \
+    _mm_cmplt_pd(_mm_andnot_pd(vsign_pd, _mm_sub_pd(v, vfil_pd)), veps_pd)
+
+/* H5Z_scaleoffset_max_min_vec with SSE2, for 1, 2 and 4-byte integers and
+ * for floats and doubles */
+static H5Z_SCALEOFFSET_SSE2_ATTR unsigned
+H5Z_scaleoffset_max_min_sse2(unsigned dtype_class, unsigned dtype_sign,
+    size_t dtype_size, const void *buf, unsigned start, unsigned d_nelmts,
+    const void *filval, double fil_eps, void *max, void *min)
 {
-   /* begin_i: the index of byte having first significant bit */
-   unsigned begin_i;
-   unsigned dtype_len;
-   int k;
-
-   HDassert(p.minbits > 0);
-
-   dtype_len = p.size * 8;
-
-   if(p.mem_order == H5Z_SCALEOFFSET_ORDER_LE) { /* little endian */
-      begin_i = p.size - 1 - (dtype_len - p.minbits) / 8;
-
-      for(k = (int)begin_i; k >= 0; k--)
-         H5Z_scaleoffset_compress_one_byte(data, data_offset, (unsigned)k, begin_i,
-                                           buffer, j, buf_len, p, dtype_len);
-   }
-   else { /* big endian */
-      HDassert(p.mem_order == H5Z_SCALEOFFSET_ORDER_BE);
-      begin_i = (dtype_len - p.minbits) / 8;
+    unsigned i = start, u;
+
+    if(dtype_class == H5Z_SCALEOFFSET_CLS_INTEGER) {
+        hbool_t is_signed = (hbool_t)(dtype_sign == H5Z_SCALEOFFSET_SGN_2);
+
+        /* 1-byte values are compared unsigned, others signed */
+        if(dtype_size == 1 && !is_signed)
+            H5Z_SCALEOFFSET_SSE2_INT(uint8_t, char, 0, _mm_set1_epi8, _mm_cmpeq_epi8, _mm_max_epu8, _mm_min_epu8)
+        else if(dtype_size == 1)
+            H5Z_SCALEOFFSET_SSE2_INT(int8_t, char, 0x80, _mm_set1_epi8, _mm_cmpeq_epi8, _mm_max_epu8, _mm_min_epu8)
+        else if(dtype_size == 2 && !is_signed)
+            H5Z_SCALEOFFSET_SSE2_INT(uint16_t, short, 0x8000, _mm_set1_epi16, _mm_cmpeq_epi16, _mm_max_epi16, _mm_min_epi16)
+        else if(dtype_size == 2)
+            H5Z_SCALEOFFSET_SSE2_INT(int16_t, short, 0, _mm_set1_epi16, _mm_cmpeq_epi16, _mm_max_epi16, _mm_min_epi16)
+        else if(dtype_size == 4 && !is_signed)
+            H5Z_SCALEOFFSET_SSE2_INT(uint32_t, int, 0x80000000, _mm_set1_epi32, _mm_cmpeq_epi32, H5Z_scaleoffset_max_epi32, H5Z_scaleoffset_min_epi32)
+        else if(dtype_size == 4)
+            H5Z_SCALEOFFSET_SSE2_INT(int32_t, int, 0, _mm_set1_epi32, _mm_cmpeq_epi32, H5Z_scaleoffset_max_epi32, H5Z_scaleoffset_min_epi32)
+    } /* end if */
+    else if(dtype_size == sizeof(float)) {
+        __m128 vsign_ps = _mm_set1_ps(-0.0f);
+        __m128 vfil_ps = _mm_setzero_ps(), veps_ps = _mm_setzero_ps();
+
+        if(filval) {
+            float eps = (float)fil_eps;
+
+            /* |v - filval| < fil_eps in double is |v - filval| <= eps in
+             * float for the largest float eps less than fil_eps */
+            if((double)eps >= fil_eps) {
+                uint32_t bits;
+
+                HDmemcpy(&bits, &eps, sizeof(bits));
+                bits--;
+                HDmemcpy(&eps, &bits, sizeof(eps));
+            } /* end if */
+            vfil_ps = _mm_set1_ps(*(const float *)filval);
+            veps_ps = _mm_set1_ps(eps);
+        } /* end if */
+        H5Z_SCALEOFFSET_SSE2_FP(float, __m128, ps, H5Z_SCALEOFFSET_SSE2_NEAR_PS)
+    } /* end if */
+    else if(dtype_size == sizeof(double)) {
+        __m128d vsign_pd = _mm_set1_pd(-0.0);
+        __m128d vfil_pd = _mm_setzero_pd(), veps_pd = _mm_set1_pd(fil_eps);
 
-      for(k = (int)begin_i; k <= (int)(p.size - 1); k++)
-         H5Z_scaleoffset_compress_one_byte(data, data_offset, (unsigned)k, begin_i,
-                                           buffer, j, buf_len, p, dtype_len);
-   }
-}
+        if(filval)
+            vfil_pd = _mm_set1_pd(*(const double *)filval);
+        H5Z_SCALEOFFSET_SSE2_FP(double, __m128d, pd, H5Z_SCALEOFFSET_SSE2_NEAR_PD)
+    } /* end if */
 
-static void
-H5Z_scaleoffset_compress(unsigned char *data, unsigned d_nelmts,
-    unsigned char *buffer, size_t buffer_size, parms_atomic p)
-{
-   /* i: index of data, j: index of buffer,
-      buf_len: number of bits to be filled in current byte */
-   size_t i, j;
-   unsigned buf_len;
-
-   /* must initialize buffer to be zeros */
-   for(j = 0; j < buffer_size; j++)
-      buffer[j] = 0;
-
-   /* initialization before the loop */
-   j = 0;
-   buf_len = sizeof(unsigned char) * 8;
-
-   /* compress */
-   for(i = 0; i < d_nelmts; i++)
-       H5Z_scaleoffset_compress_one_atomic(data, i * p.size, buffer, &j, &buf_len, p);
+    return i;
 }
-
+#endif /* H5Z_SCALEOFFSET_X86 */
@@ -44,6 +44,33 @@ const H5Z_class2_t H5Z_SHUFFLE[1] = {{
 /* Local macros */
 #define H5Z_SHUFFLE_PARM_SIZE      0       /* "Local" parameter for shuffling size */
 
+/* The SSE2 and AVX2 kernels need a compiler which can build code for an
+ * instruction set the whole library isn't compiled for, and which can ask
+ * the CPU what it supports (GCC 4.9 and later, or clang) */
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(H5_NO_SHUFFLE_SIMD) && \
+        (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define H5Z_SHUFFLE_X86
+#include <immintrin.h>
+#define H5Z_SHUFFLE_SSE2_ATTR   __attribute__((target("sse2")))
+#define H5Z_SHUFFLE_AVX2_ATTR   __attribute__((target("avx2")))
+#endif /* H5Z_SHUFFLE_X86 */
+
+/* Largest element size the vector kernels handle */
+#define H5Z_SHUFFLE_SIMD_MAX_SIZE   16
+
+/* Local prototypes */
+static void H5Z__shuffle_scalar(hbool_t reverse, unsigned elmt_size,
+    size_t nelmts, size_t start, const unsigned char *src, unsigned char *dest);
+#ifdef H5Z_SHUFFLE_X86
+static size_t H5Z__shuffle_sse2(hbool_t reverse, unsigned elmt_size,
+    size_t nelmts, const unsigned char *src, unsigned char *dest);
+static size_t H5Z__shuffle_avx2(hbool_t reverse, unsigned elmt_size,
+    size_t nelmts, const unsigned char *src, unsigned char *dest);
+#endif /* H5Z_SHUFFLE_X86 */
+
+/* Fastest kernel this CPU supports (set on first use) */
+static int H5Z_shuffle_best_kern_g = -1;
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z_set_local_shuffle
@@ -125,15 +152,9 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
                    size_t nbytes, size_t *buf_size, void **buf)
 {
     void *dest = NULL;          /* Buffer to deposit [un]shuffled bytes into */
-    unsigned char *_src=NULL;   /* Alias for source buffer */
-    unsigned char *_dest=NULL;  /* Alias for destination buffer */
+    size_t dest_alloc;          /* Size of destination buffer */
     unsigned bytesoftype;       /* Number of bytes per element */
     size_t numofelements;       /* Number of elements in buffer */
-    size_t i;                   /* Local index variables */
-#ifdef NO_DUFFS_DEVICE
-    size_t j;                   /* Local index variable */
-#endif /* NO_DUFFS_DEVICE */
-    size_t leftover;            /* Extra bytes at end of buffer */
     size_t ret_value = 0;       /* Return value */
 
     FUNC_ENTER_NOAPI(0)
@@ -150,142 +171,451 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
 
     /* Don't do anything for 1-byte elements, or "fractional" elements */
     if(bytesoftype > 1 && numofelements > 1) {
-        /* Compute the leftover bytes if there are any */
-        leftover = nbytes%bytesoftype;
-
         /* Allocate the destination buffer */
-        if (NULL==(dest = H5MM_malloc(nbytes)))
+        if (NULL==(dest = H5Z_buf_alloc(nbytes, &dest_alloc)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for shuffle buffer")
 
-        if(flags & H5Z_FLAG_REVERSE) {
-            /* Get the pointer to the source buffer */
-            _src =(unsigned char *)(*buf);
+        /* [Un]shuffle the bytes with the fastest kernel the CPU supports */
+        H5Z__shuffle_bytes(H5Z__shuffle_best_kern(), (hbool_t)((flags & H5Z_FLAG_REVERSE) != 0), bytesoftype, nbytes, *buf, dest);
+
+        /* Release the input buffer */
+        H5Z_buf_free(*buf, *buf_size);
+
+        /* Set the buffer information to return */
+        *buf = dest;
+        *buf_size=dest_alloc;
+    } /* end else */
+
+    /* Set the return value */
+    ret_value = nbytes;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_best_kern
+ *
+ * Purpose:	Determine the fastest shuffle kernel the CPU supports.  The
+ *              answer is computed once and remembered.
+ *
+ * Return:	The kernel to use (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+H5Z_shuffle_kern_t
+H5Z__shuffle_best_kern(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if(H5Z_shuffle_best_kern_g < 0) {
+        H5Z_shuffle_kern_t kern = H5Z_SHUFFLE_KERN_SCALAR;
+
+#ifdef H5Z_SHUFFLE_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+            kern = H5Z_SHUFFLE_KERN_AVX2;
+        else if(__builtin_cpu_supports("sse2"))
+            kern = H5Z_SHUFFLE_KERN_SSE2;
+#endif /* H5Z_SHUFFLE_X86 */
+
+        /* (Racing threads all store the same value) */
+        H5Z_shuffle_best_kern_g = (int)kern;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI((H5Z_shuffle_kern_t)H5Z_shuffle_best_kern_g)
+} /* end H5Z__shuffle_best_kern() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_bytes
+ *
+ * Purpose:	Shuffle (or unshuffle, when REVERSE is set) the NBYTES bytes
+ *              of elements of ELMT_SIZE bytes in SRC into DEST, which must
+ *              not overlap.  Bytes past the last whole element are copied
+ *              unchanged.
+ *
+ *              KERN selects the implementation; one the CPU doesn't
+ *              support is replaced with the best one it does.  Every
+ *              kernel produces the same bytes, the vector kernels only
+ *              handle element sizes of 2, 4, 8 and 16 bytes and leave
+ *              other sizes, and the elements after the last full block
+ *              of 16 or 32, to the portable code.
+ *
+ * Return:	none
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__shuffle_bytes(H5Z_shuffle_kern_t kern, hbool_t reverse, unsigned elmt_size,
+    size_t nbytes, const void *src, void *dest)
+{
+    size_t nelmts;              /* Number of whole elements */
+    size_t done = 0;            /* Number of elements the vector kernels handled */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(elmt_size > 0);
+    HDassert(src);
+    HDassert(dest);
+
+    nelmts = nbytes / elmt_size;
+
+    /* Don't use a kernel this CPU doesn't support */
+    if(kern > H5Z__shuffle_best_kern())
+        kern = H5Z__shuffle_best_kern();
+
+#ifdef H5Z_SHUFFLE_X86
+    /* The vector kernels only know power-of-two element sizes */
+    if(elmt_size <= H5Z_SHUFFLE_SIMD_MAX_SIZE && (elmt_size & (elmt_size - 1)) == 0) {
+        if(kern == H5Z_SHUFFLE_KERN_AVX2)
+            done = H5Z__shuffle_avx2(reverse, elmt_size, nelmts, (const unsigned char *)src, (unsigned char *)dest);
+        else if(kern == H5Z_SHUFFLE_KERN_SSE2)
+            done = H5Z__shuffle_sse2(reverse, elmt_size, nelmts, (const unsigned char *)src, (unsigned char *)dest);
+    } /* end if */
+#endif /* H5Z_SHUFFLE_X86 */
+
+    /* Finish the elements the vector kernels didn't */
+    if(done < nelmts)
+        H5Z__shuffle_scalar(reverse, elmt_size, nelmts, done, (const unsigned char *)src, (unsigned char *)dest);
+
+    /* Add leftover to the end of data */
+    if(nbytes > nelmts * elmt_size)
+        HDmemcpy((unsigned char *)dest + nelmts * elmt_size, (const unsigned char *)src + nelmts * elmt_size, nbytes - nelmts * elmt_size);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__shuffle_bytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_scalar
+ *
+ * Purpose:	[Un]shuffle elements START through NELMTS-1 of a buffer of
+ *              NELMTS elements a byte at a time.
+ *
+ * Return:	none
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__shuffle_scalar(hbool_t reverse, unsigned elmt_size, size_t nelmts,
+    size_t start, const unsigned char *src, unsigned char *dest)
+{
+    const unsigned char *_src;  /* Alias for source buffer */
+    unsigned char *_dest;       /* Alias for destination buffer */
+    size_t count = nelmts - start;      /* Number of elements to move */
+    unsigned i;                 /* Local index variables */
+#ifdef NO_DUFFS_DEVICE
+    size_t j;                   /* Local index variable */
+#endif /* NO_DUFFS_DEVICE */
+
+    FUNC_ENTER_STATIC_NOERR
 
-            /* Input; unshuffle */
-            for(i=0; i<bytesoftype; i++) {
-                _dest=((unsigned char *)dest)+i;
+    HDassert(start < nelmts);
+
+    if(reverse) {
+        /* Input; unshuffle */
+        for(i = 0; i < elmt_size; i++) {
+            _src = src + i * nelmts + start;
+            _dest = dest + start * elmt_size + i;
 #define DUFF_GUTS							    \
     *_dest=*_src++;                             \
-    _dest+=bytesoftype;
+    _dest+=elmt_size;
 #ifdef NO_DUFFS_DEVICE
-                j = numofelements;
-                while(j > 0) {
-                    DUFF_GUTS;
+            j = count;
+            while(j > 0) {
+                DUFF_GUTS;
 
-                    j--;
-                } /* end for */
+                j--;
+            } /* end for */
 #else /* NO_DUFFS_DEVICE */
-            {
-                size_t duffs_index; /* Counting index for Duff's device */
-
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
-                    default:
-                        HDassert(0 && "This Should never be executed!");
-                        break;
-                    case 0:
-                        do
-                          {
-                            DUFF_GUTS
-                    case 7:
-                            DUFF_GUTS
-                    case 6:
-                            DUFF_GUTS
-                    case 5:
-                            DUFF_GUTS
-                    case 4:
-                            DUFF_GUTS
-                    case 3:
-                            DUFF_GUTS
-                    case 2:
-                            DUFF_GUTS
-                    case 1:
-                            DUFF_GUTS
-                      } while (--duffs_index > 0);
-                } /* end switch */
-            }
+        {
+            size_t duffs_index; /* Counting index for Duff's device */
+
+            duffs_index = (count + 7) / 8;
+            switch (count % 8) {
+                default:
+                    HDassert(0 && "This Should never be executed!");
+                    break;
+                case 0:
+                    do
+                      {
+                        DUFF_GUTS
+                case 7:
+                        DUFF_GUTS
+                case 6:
+                        DUFF_GUTS
+                case 5:
+                        DUFF_GUTS
+                case 4:
+                        DUFF_GUTS
+                case 3:
+                        DUFF_GUTS
+                case 2:
+                        DUFF_GUTS
+                case 1:
+                        DUFF_GUTS
+                  } while (--duffs_index > 0);
+            } /* end switch */
+        }
 #endif /* NO_DUFFS_DEVICE */
 #undef DUFF_GUTS
-            } /* end for */
-
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _dest -= (bytesoftype - 1);     /*lint !e794 _dest is initialized */
-                HDmemcpy((void*)_dest, (void*)_src, leftover);
-            }
-        } /* end if */
-        else {
-            /* Get the pointer to the destination buffer */
-            _dest =(unsigned char *)dest;
-
-            /* Output; shuffle */
-            for(i=0; i<bytesoftype; i++) {
-                _src=((unsigned char *)(*buf))+i;
+        } /* end for */
+    } /* end if */
+    else {
+        /* Output; shuffle */
+        for(i = 0; i < elmt_size; i++) {
+            _src = src + start * elmt_size + i;
+            _dest = dest + i * nelmts + start;
 #define DUFF_GUTS							    \
     *_dest++=*_src;                             \
-    _src+=bytesoftype;
+    _src+=elmt_size;
 #ifdef NO_DUFFS_DEVICE
-                j = numofelements;
-                while(j > 0) {
-                    DUFF_GUTS;
+            j = count;
+            while(j > 0) {
+                DUFF_GUTS;
 
-                    j--;
-                } /* end for */
+                j--;
+            } /* end for */
 #else /* NO_DUFFS_DEVICE */
-            {
-                size_t duffs_index; /* Counting index for Duff's device */
-
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
-                    default:
-                        HDassert(0 && "This Should never be executed!");
-                        break;
-                    case 0:
-                        do
-                          {
-                            DUFF_GUTS
-                    case 7:
-                            DUFF_GUTS
-                    case 6:
-                            DUFF_GUTS
-                    case 5:
-                            DUFF_GUTS
-                    case 4:
-                            DUFF_GUTS
-                    case 3:
-                            DUFF_GUTS
-                    case 2:
-                            DUFF_GUTS
-                    case 1:
-                            DUFF_GUTS
-                      } while (--duffs_index > 0);
-                } /* end switch */
-            }
+        {
+            size_t duffs_index; /* Counting index for Duff's device */
+
+            duffs_index = (count + 7) / 8;
+            switch (count % 8) {
+                default:
+                    HDassert(0 && "This Should never be executed!");
+                    break;
+                case 0:
+                    do
+                      {
+                        DUFF_GUTS
+                case 7:
+                        DUFF_GUTS
+                case 6:
+                        DUFF_GUTS
+                case 5:
+                        DUFF_GUTS
+                case 4:
+                        DUFF_GUTS
+                case 3:
+                        DUFF_GUTS
+                case 2:
+                        DUFF_GUTS
+                case 1:
+                        DUFF_GUTS
+                  } while (--duffs_index > 0);
+            } /* end switch */
+        }
 #endif /* NO_DUFFS_DEVICE */
 #undef DUFF_GUTS
-            } /* end for */
+        } /* end for */
+    } /* end else */
 
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _src -= (bytesoftype - 1);      /*lint !e794 _src is initialized */
-                HDmemcpy((void*)_dest, (void*)_src, leftover);
-            }
-        } /* end else */
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__shuffle_scalar() */
 
-        /* Free the input buffer */
-        H5MM_xfree(*buf);
+
+#ifdef H5Z_SHUFFLE_X86
+/*
+ * The vector kernels transpose a block of 16 elements of N bytes (N a power
+ * of two) with rounds of byte interleaving: vector I and vector I+N/2 of the
+ * block are interleaved into vectors 2I and 2I+1.  Numbering the 16N bytes
+ * of the block's vectors in order, one round rotates each byte's number
+ * left by one bit.  A block loaded from the unshuffled data numbers its
+ * bytes element*N+byte, so four rounds move each byte to byte*16+element:
+ * N runs of 16 bytes, one for each byte of the elements.  Starting from
+ * those runs, log2(N) rounds go back.  The AVX2 kernel runs two blocks
+ * side by side in the two 128-bit halves of its vectors.
+ */
+#define H5Z_SHUFFLE_INTERLEAVE(V, T, N, UNPACKLO, UNPACKHI) {                \
+    unsigned _u;                                                             \
+                                                                             \
+    for(_u = 0; _u < (N) / 2; _u++) {                                        \
+        (T)[2 * _u] = UNPACKLO((V)[_u], (V)[_u + (N) / 2]);                  \
+        (T)[2 * _u + 1] = UNPACKHI((V)[_u], (V)[_u + (N) / 2]);              \
+    }                                                                        \
+    for(_u = 0; _u < (N); _u++)                                              \
+        (V)[_u] = (T)[_u];                                                   \
+}
 
-        /* Set the buffer information to return */
-        *buf = dest;
-        *buf_size=nbytes;
-    } /* end else */
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_sse2_blocks
+ *
+ * Purpose:	[Un]shuffle the first NBLOCKS blocks of 16 elements of a
+ *              buffer of NELMTS elements of ELMT_SIZE bytes with SSE2.
+ *              Inlined into H5Z__shuffle_sse2 for each element size, so
+ *              the loops over the vectors of a block are unrolled.
+ *
+ * Return:	none
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_INLINE H5Z_SHUFFLE_SSE2_ATTR __attribute__((always_inline)) void
+H5Z__shuffle_sse2_blocks(hbool_t reverse, const unsigned elmt_size,
+    const unsigned nrounds, size_t nelmts, size_t nblocks,
+    const unsigned char *src, unsigned char *dest)
+{
+    __m128i v[H5Z_SHUFFLE_SIMD_MAX_SIZE];       /* Vectors of the block */
+    __m128i t[H5Z_SHUFFLE_SIMD_MAX_SIZE];       /* Interleaving results */
+    size_t b;                   /* Local index variables */
+    unsigned u, r;
+
+    for(b = 0; b < nblocks; b++) {
+        size_t elmt = b * 16;   /* First element of the block */
+
+        if(reverse) {
+            for(u = 0; u < elmt_size; u++)
+                v[u] = _mm_loadu_si128((const __m128i *)(src + u * nelmts + elmt));
+            for(r = 0; r < nrounds; r++)
+                H5Z_SHUFFLE_INTERLEAVE(v, t, elmt_size, _mm_unpacklo_epi8, _mm_unpackhi_epi8)
+            for(u = 0; u < elmt_size; u++)
+                _mm_storeu_si128((__m128i *)(dest + elmt * elmt_size + u * 16), v[u]);
+        } /* end if */
+        else {
+            for(u = 0; u < elmt_size; u++)
+                v[u] = _mm_loadu_si128((const __m128i *)(src + elmt * elmt_size + u * 16));
+            for(r = 0; r < 4; r++)
+                H5Z_SHUFFLE_INTERLEAVE(v, t, elmt_size, _mm_unpacklo_epi8, _mm_unpackhi_epi8)
+            for(u = 0; u < elmt_size; u++)
+                _mm_storeu_si128((__m128i *)(dest + u * nelmts + elmt), v[u]);
+        } /* end else */
+    } /* end for */
+} /* end H5Z__shuffle_sse2_blocks() */
 
-    /* Set the return value */
-    ret_value = nbytes;
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_sse2
+ *
+ * Purpose:	[Un]shuffle the leading whole blocks of 16 elements of a
+ *              buffer of NELMTS elements of ELMT_SIZE (2, 4, 8 or 16)
+ *              bytes with SSE2.
+ *
+ * Return:	Number of elements [un]shuffled (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_SHUFFLE_SSE2_ATTR size_t
+H5Z__shuffle_sse2(hbool_t reverse, unsigned elmt_size, size_t nelmts,
+    const unsigned char *src, unsigned char *dest)
+{
+    size_t nblocks = nelmts / 16;       /* Number of whole blocks */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    switch(elmt_size) {
+        case 2:
+            H5Z__shuffle_sse2_blocks(reverse, 2, 1, nelmts, nblocks, src, dest);
+            break;
+        case 4:
+            H5Z__shuffle_sse2_blocks(reverse, 4, 2, nelmts, nblocks, src, dest);
+            break;
+        case 8:
+            H5Z__shuffle_sse2_blocks(reverse, 8, 3, nelmts, nblocks, src, dest);
+            break;
+        case 16:
+            H5Z__shuffle_sse2_blocks(reverse, 16, 4, nelmts, nblocks, src, dest);
+            break;
+        default:
+            nblocks = 0;
+            break;
+    } /* end switch */
+
+    FUNC_LEAVE_NOAPI(nblocks * 16)
+} /* end H5Z__shuffle_sse2() */
 
-done:
-    FUNC_LEAVE_NOAPI(ret_value)
-}
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_avx2_blocks
+ *
+ * Purpose:	[Un]shuffle the first NBLOCKS pairs of blocks of 16
+ *              elements of a buffer of NELMTS elements of ELMT_SIZE bytes
+ *              with AVX2.  Inlined into H5Z__shuffle_avx2 for each element
+ *              size.
+ *
+ * Return:	none
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_INLINE H5Z_SHUFFLE_AVX2_ATTR __attribute__((always_inline)) void
+H5Z__shuffle_avx2_blocks(hbool_t reverse, const unsigned elmt_size,
+    const unsigned nrounds, size_t nelmts, size_t nblocks,
+    const unsigned char *src, unsigned char *dest)
+{
+    __m256i v[H5Z_SHUFFLE_SIMD_MAX_SIZE];       /* Vectors of the block pair */
+    __m256i t[H5Z_SHUFFLE_SIMD_MAX_SIZE];       /* Interleaving results */
+    size_t b;                   /* Local index variables */
+    unsigned u, r;
+
+    for(b = 0; b < nblocks; b++) {
+        size_t elmt = b * 32;   /* First element of the block pair */
+
+        if(reverse) {
+            /* Each run holds the byte for both blocks */
+            for(u = 0; u < elmt_size; u++)
+                v[u] = _mm256_loadu_si256((const __m256i *)(src + u * nelmts + elmt));
+            for(r = 0; r < nrounds; r++)
+                H5Z_SHUFFLE_INTERLEAVE(v, t, elmt_size, _mm256_unpacklo_epi8, _mm256_unpackhi_epi8)
+            for(u = 0; u < elmt_size; u++) {
+                _mm_storeu_si128((__m128i *)(dest + elmt * elmt_size + u * 16), _mm256_castsi256_si128(v[u]));
+                _mm_storeu_si128((__m128i *)(dest + (elmt + 16) * elmt_size + u * 16), _mm256_extracti128_si256(v[u], 1));
+            } /* end for */
+        } /* end if */
+        else {
+            /* Put the first block in the low halves and the second in the high halves */
+            for(u = 0; u < elmt_size; u++)
+                v[u] = _mm256_inserti128_si256(_mm256_castsi128_si256(
+                            _mm_loadu_si128((const __m128i *)(src + elmt * elmt_size + u * 16))),
+                        _mm_loadu_si128((const __m128i *)(src + (elmt + 16) * elmt_size + u * 16)), 1);
+            for(r = 0; r < 4; r++)
+                H5Z_SHUFFLE_INTERLEAVE(v, t, elmt_size, _mm256_unpacklo_epi8, _mm256_unpackhi_epi8)
+            for(u = 0; u < elmt_size; u++)
+                _mm256_storeu_si256((__m256i *)(dest + u * nelmts + elmt), v[u]);
+        } /* end else */
+    } /* end for */
+} /* end H5Z__shuffle_avx2_blocks() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_avx2
+ *
+ * Purpose:	[Un]shuffle the leading whole blocks of 32 elements of a
+ *              buffer of NELMTS elements of ELMT_SIZE (2, 4, 8 or 16)
+ *              bytes with AVX2.
+ *
+ * Return:	Number of elements [un]shuffled (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_SHUFFLE_AVX2_ATTR size_t
+H5Z__shuffle_avx2(hbool_t reverse, unsigned elmt_size, size_t nelmts,
+    const unsigned char *src, unsigned char *dest)
+{
+    size_t nblocks = nelmts / 32;       /* Number of whole block pairs */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    switch(elmt_size) {
+        case 2:
+            H5Z__shuffle_avx2_blocks(reverse, 2, 1, nelmts, nblocks, src, dest);
+            break;
+        case 4:
+            H5Z__shuffle_avx2_blocks(reverse, 4, 2, nelmts, nblocks, src, dest);
+            break;
+        case 8:
+            H5Z__shuffle_avx2_blocks(reverse, 8, 3, nelmts, nblocks, src, dest);
+            break;
+        case 16:
+            H5Z__shuffle_avx2_blocks(reverse, 16, 4, nelmts, nblocks, src, dest);
+            break;
+        default:
+            nblocks = 0;
+            break;
+    } /* end switch */
+
+    FUNC_LEAVE_NOAPI(nblocks * 32)
+} /* end H5Z__shuffle_avx2() */
+#endif /* H5Z_SHUFFLE_X86 */
 
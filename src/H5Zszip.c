@@ -280,6 +280,7 @@ H5Z_filter_szip (unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
 {
     size_t ret_value = 0;       /* Return value */
     size_t size_out  = 0;       /* Size of output buffer */
+    size_t out_alloc = 0;       /* Allocated size of output buffer */
     unsigned char *outbuf = NULL;    /* Pointer to new output buffer */
     unsigned char *newbuf = NULL;    /* Pointer to input buffer */
     SZ_com_t sz_param;          /* szip parameter block */
@@ -317,7 +318,7 @@ H5Z_filter_szip (unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
         H5_CHECKED_ASSIGN(nalloc, size_t, stored_nalloc, uint32_t);
 
         /* Allocate space for the uncompressed buffer */
-        if(NULL==(outbuf = H5MM_malloc(nalloc)))
+        if(NULL==(outbuf = H5Z_buf_alloc(nalloc, &out_alloc)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for szip decompression")
 
         /* Decompress the buffer */
@@ -326,13 +327,13 @@ H5Z_filter_szip (unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "szip_filter: decompression failed")
         HDassert(size_out==nalloc);
 
-        /* Free the input buffer */
-        H5MM_xfree(*buf);
+        /* Release the input buffer */
+        H5Z_buf_free(*buf, *buf_size);
 
         /* Set return values */
         *buf = outbuf;
         outbuf = NULL;
-        *buf_size = nalloc;
+        *buf_size = out_alloc;
         ret_value = size_out;
     }
     /* Output; compress */
@@ -340,7 +341,7 @@ H5Z_filter_szip (unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
         unsigned char *dst = NULL;    /* Temporary pointer to new output buffer */
 
         /* Allocate space for the compressed buffer & header (assume data won't get bigger) */
-        if(NULL==(dst=outbuf = H5MM_malloc(nbytes+4)))
+        if(NULL==(dst=outbuf = H5Z_buf_alloc(nbytes+4, &out_alloc)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate szip destination buffer")
 
         /* Encode the uncompressed length */
@@ -353,13 +354,13 @@ H5Z_filter_szip (unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
 	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "overflow")
         HDassert(size_out<=nbytes);
 
-        /* Free the input buffer */
-        H5MM_xfree(*buf);
+        /* Release the input buffer */
+        H5Z_buf_free(*buf, *buf_size);
 
         /* Set return values */
         *buf = outbuf;
         outbuf = NULL;
-        *buf_size = nbytes+4;
+        *buf_size = out_alloc;
         ret_value = size_out+4;
     }
 
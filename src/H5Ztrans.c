@@ -60,16 +60,34 @@ typedef struct H5Z_node {
     H5Z_num_val         value;
 } H5Z_node;
 
+/* Kinds of instruction a parse tree is compiled to */
+typedef enum {
+    H5Z_XFORM_INST_LOAD,        /* Load the data into a slot            */
+    H5Z_XFORM_INST_SYM_NUM,     /* slot = slot OP value                 */
+    H5Z_XFORM_INST_NUM_SYM,     /* slot = value OP slot                 */
+    H5Z_XFORM_INST_SYM_SYM      /* slot = slot OP (slot + 1)            */
+} H5Z_xform_inst_kind_t;
+
+/* One instruction of a compiled data transform */
+typedef struct {
+    H5Z_xform_inst_kind_t kind;     /* Kind of instruction                  */
+    H5Z_token_type  op;             /* Arithmetic operation, H5Z_XFORM_PLUS, etc. */
+    unsigned        slot;           /* Tile slot holding the result         */
+    double          value;          /* Constant operand                     */
+} H5Z_xform_inst_t;
+
 struct H5Z_data_xform_t {
     char*       xform_exp;
     H5Z_node*       parse_root;
     H5Z_datval_ptrs*	dat_val_pointers;
+    H5Z_xform_inst_t   *prog;       /* Parse tree compiled to instructions  */
+    size_t      prog_len;           /* Number of instructions               */
+    unsigned    nslots;             /* Number of tile slots they use        */
 };
 
-typedef struct result {
-    H5Z_token_type type;
-    H5Z_num_val    value;
-} H5Z_result;
+/* Number of elements the compiled instructions work on at a time, small
+ * enough for all the tile slots of a typical expression to stay in cache */
+#define H5Z_XFORM_TILE_NELMTS   1024
 
 
 /* The token */
@@ -97,7 +115,9 @@ static void H5Z_do_op(H5Z_node* tree);
 static hbool_t H5Z_op_is_numbs(H5Z_node* _tree);
 static hbool_t H5Z_op_is_numbs2(H5Z_node* _tree);
 static hid_t H5Z_xform_find_type(const H5T_t* type);
-static herr_t H5Z_xform_eval_full(H5Z_node *tree, const size_t array_size, const hid_t array_type, H5Z_result* res);
+static herr_t H5Z_xform_eval_prog(const H5Z_data_xform_t *data_xform_prop, void *array, size_t array_size, hid_t array_type, size_t type_size);
+static herr_t H5Z_xform_compile(H5Z_data_xform_t *data_xform_prop);
+static herr_t H5Z_xform_lower(const H5Z_node *tree, H5Z_data_xform_t *data_xform_prop, size_t max_len, unsigned slot);
 static void H5Z_xform_destroy_parse_tree(H5Z_node *tree);
 static void* H5Z_xform_parse(const char *expression, H5Z_datval_ptrs* dat_val_pointers);
 static void* H5Z_xform_copy_tree(H5Z_node* tree, H5Z_datval_ptrs* dat_val_pointers, H5Z_datval_ptrs* new_dat_val_pointers);
@@ -107,180 +127,69 @@ static void H5Z_XFORM_DEBUG(H5Z_node *tree);
 static void H5Z_print(H5Z_node *tree, FILE *stream);
 #endif  /* H5Z_XFORM_DEBUG */
 
-/* PGCC (11.8-0) has trouble with the command *p++ = *p OP tree_val. It increments P first before 
- * doing the operation.  So I break down the command into two lines:
- *     *p = *p OP tree_val; p++;
- * Actually, the behavior of *p++ = *p OP tree_val is undefined. (SLU - 2012/3/19) 
+/* Apply one arithmetic instruction to the N elements of tile slot D (and of
+ * slot S, for an instruction with two data operands).  As when the parse tree
+ * was evaluated node by node, every intermediate result is converted back to
+ * TYPE.
  */
-#define H5Z_XFORM_DO_OP1(RESL,RESR,TYPE,OP,SIZE)                            \
-{   								  	    \
+#define H5Z_XFORM_DO_INST(TYPE, OP, KIND, D, S, VAL, N)                     \
+{                                                                           \
     size_t u;                                                               \
                                                                             \
-    if(((RESL).type == H5Z_XFORM_SYMBOL) && ((RESR).type != H5Z_XFORM_SYMBOL)) \
-    {   								    \
-	TYPE* p;                                                            \
-	double tree_val;                                                    \
-		                                                            \
-	tree_val = ((RESR).type==H5Z_XFORM_INTEGER ? (double)(RESR).value.int_val : (RESR).value.float_val); \
-	p = (TYPE*)(RESL).value.dat_val;                                    \
+    if((KIND) == H5Z_XFORM_INST_SYM_NUM)                                    \
+        for(u = 0; u < (N); u++)                                            \
+            (D)[u] = (TYPE)((double)(D)[u] OP (VAL));                       \
+    else if((KIND) == H5Z_XFORM_INST_NUM_SYM)                               \
+        for(u = 0; u < (N); u++)                                            \
+            (D)[u] = (TYPE)((VAL) OP (double)(D)[u]);                       \
+    else                                                                    \
+        for(u = 0; u < (N); u++)                                            \
+            (D)[u] = (TYPE)((D)[u] OP (S)[u]);                              \
+}
+
+/* Run the compiled instructions of a data transform over ARRAY, one tile of
+ * H5Z_XFORM_TILE_NELMTS elements at a time.  Slot 0 is the tile of ARRAY
+ * itself, so the result is left in place; the other slots (and, when "x"
+ * is used more than once, a saved copy of the original tile) are in TMP.
+ */
+#define H5Z_XFORM_DO_PROG(TYPE, XFORM, ARRAY, SIZE, TMP)                    \
+{                                                                           \
+    TYPE *x_tile = (TYPE *)(ARRAY);                                         \
+    TYPE *x_save = (TYPE *)(TMP);                                           \
+    TYPE *slots = (TYPE *)(TMP);                                            \
+    hbool_t save_x = (hbool_t)((XFORM)->dat_val_pointers->num_ptrs > 1);    \
+    size_t start, n, i;                                                     \
                                                                             \
-	for(u = 0; u < (SIZE); u++) {                                       \
-	    *p = (TYPE)((double)*p OP tree_val);                            \
-            p++;                                                            \
-        }                                                                   \
-    }									    \
-    else if(((RESR).type == H5Z_XFORM_SYMBOL) && ((RESL).type != H5Z_XFORM_SYMBOL)) \
-    {   								    \
-	TYPE* p;                                                            \
-	double tree_val;                                                    \
-		                                                            \
-        /* The case that the left operand is nothing, like -x or +x */      \
-	if((RESL).type == H5Z_XFORM_ERROR)                                  \
-            tree_val = 0;                                                   \
-	else                                                                \
-	    tree_val = ((RESL).type==H5Z_XFORM_INTEGER ? (double)(RESL).value.int_val : (RESL).value.float_val); \
+    if(save_x)                                                              \
+        slots += H5Z_XFORM_TILE_NELMTS;                                     \
+    for(start = 0; start < (SIZE); start += n, x_tile += n) {               \
+        n = MIN(H5Z_XFORM_TILE_NELMTS, (SIZE) - start);                     \
+        if(save_x)                                                          \
+            HDmemcpy(x_save, x_tile, n * sizeof(TYPE));                     \
+        for(i = 0; i < (XFORM)->prog_len; i++) {                            \
+            const H5Z_xform_inst_t *inst = &(XFORM)->prog[i];               \
+            TYPE *d = (inst->slot == 0) ? x_tile :                          \
+                    slots + (inst->slot - 1) * H5Z_XFORM_TILE_NELMTS;       \
+            TYPE *s = slots + inst->slot * H5Z_XFORM_TILE_NELMTS;           \
+            double val = inst->value;                                       \
                                                                             \
-	p = (TYPE*)(RESR).value.dat_val;                                    \
-	for(u = 0; u < (SIZE); u++) {                                       \
-	    *p = (TYPE)(tree_val OP (double)*p);                            \
-            p++;                                                            \
-        }                                                                   \
-    }									    \
-    else if( ((RESL).type == H5Z_XFORM_SYMBOL) && ((RESR).type == H5Z_XFORM_SYMBOL))  \
-    {									    \
-	TYPE* pl = (TYPE*)(RESL).value.dat_val;                             \
-	TYPE* pr = (TYPE*)(RESR).value.dat_val;                             \
-									    \
-	for(u = 0; u < (SIZE); u++) {                                       \
-	    *pl = (TYPE)(*pl OP *pr);                                       \
-            pl++; pr++;                                                     \
+            if(inst->kind == H5Z_XFORM_INST_LOAD) {                         \
+                /* Slot 0 is loaded only by the first instruction, while */ \
+                /* the tile still holds the original data */                \
+                if(inst->slot > 0)                                          \
+                    HDmemcpy(d, x_save, n * sizeof(TYPE));                  \
+            }                                                               \
+            else if(inst->op == H5Z_XFORM_PLUS)                             \
+                H5Z_XFORM_DO_INST(TYPE, +, inst->kind, d, s, val, n)        \
+            else if(inst->op == H5Z_XFORM_MINUS)                            \
+                H5Z_XFORM_DO_INST(TYPE, -, inst->kind, d, s, val, n)        \
+            else if(inst->op == H5Z_XFORM_MULT)                             \
+                H5Z_XFORM_DO_INST(TYPE, *, inst->kind, d, s, val, n)        \
+            else                                                            \
+                H5Z_XFORM_DO_INST(TYPE, /, inst->kind, d, s, val, n)        \
         }                                                                   \
-    }									    \
-    else								    \
-        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unexpected type conversion operation")	\
-}
-
-#if H5_SIZEOF_LONG_DOUBLE != 0
-#if CHAR_MIN >= 0
-#define H5Z_XFORM_TYPE_OP(RESL,RESR,TYPE,OP,SIZE)			\
-{									\
-    if((TYPE) == H5T_NATIVE_CHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), char, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_SCHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), signed char, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_SHORT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), short, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_USHORT)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned short, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_INT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), int, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UINT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned int, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_ULONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LLONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long long, OP, (SIZE))	        \
-    else if((TYPE) == H5T_NATIVE_ULLONG)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long long, OP, (SIZE)) \
-    else if((TYPE) == H5T_NATIVE_FLOAT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), float, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_DOUBLE)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), double, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_LDOUBLE)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long double, OP, (SIZE))	\
-}
-#else /* CHAR_MIN >= 0 */
-#define H5Z_XFORM_TYPE_OP(RESL,RESR,TYPE,OP,SIZE)			\
-{									\
-    if((TYPE) == H5T_NATIVE_CHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), char, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UCHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned char, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_SHORT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), short, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_USHORT)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned short, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_INT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), int, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UINT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned int, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_ULONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LLONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long long, OP, (SIZE))	        \
-    else if((TYPE) == H5T_NATIVE_ULLONG)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long long, OP, (SIZE)) \
-    else if((TYPE) == H5T_NATIVE_FLOAT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), float, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_DOUBLE)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), double, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_LDOUBLE)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long double, OP, (SIZE))	\
-}
-#endif /* CHAR_MIN >= 0 */
-#else
-#if CHAR_MIN >= 0
-#define H5Z_XFORM_TYPE_OP(RESL,RESR,TYPE,OP,SIZE)			\
-{									\
-    if((TYPE) == H5T_NATIVE_CHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), char, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_SCHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), signed char, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_SHORT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), short, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_USHORT)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned short, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_INT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), int, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UINT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned int, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_ULONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LLONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_ULLONG)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long long, OP, (SIZE)) \
-    else if((TYPE) == H5T_NATIVE_FLOAT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), float, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_DOUBLE)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), double, OP, (SIZE))		\
+    }                                                                       \
 }
-#else /* CHAR_MIN >= 0 */
-#define H5Z_XFORM_TYPE_OP(RESL,RESR,TYPE,OP,SIZE)			\
-{									\
-    if((TYPE) == H5T_NATIVE_CHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), char, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UCHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned char, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_SHORT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), short, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_USHORT)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned short, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_INT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), int, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UINT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned int, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_ULONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LLONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_ULLONG)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long long, OP, (SIZE)) \
-    else if((TYPE) == H5T_NATIVE_FLOAT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), float, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_DOUBLE)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), double, OP, (SIZE))		\
-}
-#endif /* CHAR_MIN >= 0 */
-#endif /*H5_SIZEOF_LONG_DOUBLE */
 
 #define H5Z_XFORM_DO_OP3(OP)                                                                                                                    \
 {                                                                                                                                               \
@@ -999,7 +908,7 @@ done:
 /*-------------------------------------------------------------------------
  * Function:    H5Z_xform_eval
  * Purpose: 	If the transform is trivial, this function applies it.
- * 		Otherwise, it calls H5Z_xform_eval_full to do the full
+ * 		Otherwise, it calls H5Z_xform_eval_prog to run the compiled
  * 		transform.
  * Return:      SUCCEED if transform applied succesfully, FAIL otherwise
  * Programmer:  Leon Arber
@@ -1013,8 +922,6 @@ H5Z_xform_eval(H5Z_data_xform_t *data_xform_prop, void* array, size_t array_size
 {
     H5Z_node *tree;
     hid_t array_type;
-    H5Z_result res;
-    size_t i;
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
@@ -1068,147 +975,219 @@ H5Z_xform_eval(H5Z_data_xform_t *data_xform_prop, void* array, size_t array_size
 #endif
 
     } /* end if */
-    /* Otherwise, do the full data transform */
+    /* Otherwise, run the compiled transform over the data */
     else {
-	/* Optimization for linear transform: */
-	if(data_xform_prop->dat_val_pointers->num_ptrs == 1)
-	    data_xform_prop->dat_val_pointers->ptr_dat_val[0] = array;
+	if(H5Z_xform_eval_prog(data_xform_prop, array, array_size, array_type, H5T_get_size(buf_type)) < 0)
+	    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error while performing data transform")
+    } /* end else */
 
-	/* If it's a quadratic transform, we have no choice but to store multiple copies of the data */
-	else {
-	    for(i = 0; i < data_xform_prop->dat_val_pointers->num_ptrs; i++) {
-		if(NULL == (data_xform_prop->dat_val_pointers->ptr_dat_val[i] = (void*)H5MM_malloc(array_size * H5T_get_size((H5T_t *)H5I_object(array_type)))))
-		    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "Ran out of memory trying to allocate space for data in data transform")
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_xform_eval() */
 
-                HDmemcpy(data_xform_prop->dat_val_pointers->ptr_dat_val[i], array, array_size * H5T_get_size((H5T_t *)H5I_object(array_type)));
-	    } /* end for */
-	} /* end else */
 
-	if(H5Z_xform_eval_full(tree, array_size, array_type, &res) < 0)
-	    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error while performing data transform")
+/*-------------------------------------------------------------------------
+ * Function:    H5Z_xform_eval_prog
+ * Purpose: 	Applies the compiled form of a (non-trivial) data transform
+ * 		to array, a tile of H5Z_XFORM_TILE_NELMTS elements at a
+ * 		time.
+ * Return:      SUCCEED if transform applied succesfully, FAIL otherwise
+ *
+ * Notes:   Only the tile slots (and, for a polynomial transform, a copy
+ * of the original tile) are allocated, never a temporary copy of the
+ * whole array.
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_xform_eval_prog(const H5Z_data_xform_t *data_xform_prop, void *array,
+    size_t array_size, hid_t array_type, size_t type_size)
+{
+    void *tmp = NULL;                   /* Tile slots after the first */
+    size_t ntiles;                      /* Number of tiles in tmp */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-	if(data_xform_prop->dat_val_pointers->num_ptrs > 1)
-	    HDmemcpy(array, res.value.dat_val, array_size * H5T_get_size((H5T_t *)H5I_object(array_type)));
+    FUNC_ENTER_NOAPI_NOINIT
 
-        /* Free the temporary arrays we used */
-        if(data_xform_prop->dat_val_pointers->num_ptrs > 1)
-            for(i=0; i<data_xform_prop->dat_val_pointers->num_ptrs; i++)
-                H5MM_xfree(data_xform_prop->dat_val_pointers->ptr_dat_val[i]);
-    } /* end else */
+    HDassert(data_xform_prop->prog && data_xform_prop->prog_len > 0);
+    HDassert(data_xform_prop->prog[0].kind == H5Z_XFORM_INST_LOAD && data_xform_prop->prog[0].slot == 0);
+
+    ntiles = (size_t)data_xform_prop->nslots - 1;
+    if(data_xform_prop->dat_val_pointers->num_ptrs > 1)
+        ntiles++;
+    if(ntiles > 0)
+        if(NULL == (tmp = H5MM_malloc(ntiles * H5Z_XFORM_TILE_NELMTS * type_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "Ran out of memory trying to allocate space for data in data transform")
+
+    if(array_type == H5T_NATIVE_CHAR)
+        H5Z_XFORM_DO_PROG(char, data_xform_prop, array, array_size, tmp)
+#if CHAR_MIN >= 0
+    else if(array_type == H5T_NATIVE_SCHAR)
+        H5Z_XFORM_DO_PROG(signed char, data_xform_prop, array, array_size, tmp)
+#else /* CHAR_MIN >= 0 */
+    else if(array_type == H5T_NATIVE_UCHAR)
+        H5Z_XFORM_DO_PROG(unsigned char, data_xform_prop, array, array_size, tmp)
+#endif /* CHAR_MIN >= 0 */
+    else if(array_type == H5T_NATIVE_SHORT)
+        H5Z_XFORM_DO_PROG(short, data_xform_prop, array, array_size, tmp)
+    else if(array_type == H5T_NATIVE_USHORT)
+        H5Z_XFORM_DO_PROG(unsigned short, data_xform_prop, array, array_size, tmp)
+    else if(array_type == H5T_NATIVE_INT)
+        H5Z_XFORM_DO_PROG(int, data_xform_prop, array, array_size, tmp)
+    else if(array_type == H5T_NATIVE_UINT)
+        H5Z_XFORM_DO_PROG(unsigned int, data_xform_prop, array, array_size, tmp)
+    else if(array_type == H5T_NATIVE_LONG)
+        H5Z_XFORM_DO_PROG(long, data_xform_prop, array, array_size, tmp)
+    else if(array_type == H5T_NATIVE_ULONG)
+        H5Z_XFORM_DO_PROG(unsigned long, data_xform_prop, array, array_size, tmp)
+    else if(array_type == H5T_NATIVE_LLONG)
+        H5Z_XFORM_DO_PROG(long long, data_xform_prop, array, array_size, tmp)
+    else if(array_type == H5T_NATIVE_ULLONG)
+        H5Z_XFORM_DO_PROG(unsigned long long, data_xform_prop, array, array_size, tmp)
+    else if(array_type == H5T_NATIVE_FLOAT)
+        H5Z_XFORM_DO_PROG(float, data_xform_prop, array, array_size, tmp)
+    else if(array_type == H5T_NATIVE_DOUBLE)
+        H5Z_XFORM_DO_PROG(double, data_xform_prop, array, array_size, tmp)
+#if H5_SIZEOF_LONG_DOUBLE !=0
+    else if(array_type == H5T_NATIVE_LDOUBLE)
+        H5Z_XFORM_DO_PROG(long double, data_xform_prop, array, array_size, tmp)
+#endif
+    else
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "Cannot perform data transform on this type.")
 
 done:
-    if(ret_value < 0) {
-	/* If we ran out of memory above copying the array for temp storage (which we easily can for
-	 * polynomial transforms of high order) we free those arrays which we already allocated */
-	if(data_xform_prop->dat_val_pointers->num_ptrs > 1)
-	    for(i = 0; i < data_xform_prop->dat_val_pointers->num_ptrs; i++)
-		if(data_xform_prop->dat_val_pointers->ptr_dat_val[i])
-		    H5MM_xfree(data_xform_prop->dat_val_pointers->ptr_dat_val[i]);
-    } /* end if */
+    if(tmp)
+        H5MM_xfree(tmp);
 
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5Z_xform_eval() */
+} /* end H5Z_xform_eval_prog() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:    H5Z_xform_eval_full
- * Purpose: 	Does a full evaluation of the parse tree contained in tree
- * 		and applies this transform to array.
- * Return:      Nothing
- * Programmer:  Leon Arber
- * 		5/1/04
- * Modifications:
- *
+ * Function:    H5Z_xform_compile
+ * Purpose: 	Lowers the (already reduced) parse tree of a data transform
+ * 		to the flat list of instructions H5Z_xform_eval_prog runs,
+ * 		so that evaluating it no longer walks the tree.
+ * Return:      SUCCEED, or FAIL if the tree is malformed or memory runs out
  *
- * Notes:   In the case of a polynomial data transform (ie, the left and right subtree
- * are both of type H5Z_XFORM_SYMBOL), the convention is that the left hand side
- * will accumulate changes and, at the end, the new data will be copied from the lhs.
+ * Notes:   A trivial transform (a constant) needs no instructions.  Every
+ * instruction comes from a distinct node of the tree, and every node
+ * from at least one character of the expression, so the length of the
+ * expression bounds the number of instructions.
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5Z_xform_eval_full(H5Z_node *tree, const size_t array_size,  const hid_t array_type, H5Z_result *res)
+H5Z_xform_compile(H5Z_data_xform_t *data_xform_prop)
 {
-    H5Z_result resl, resr;
+    size_t max_len;                     /* Most instructions there can be */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT
 
-    /* check args */
-    HDassert(tree);
+    HDassert(data_xform_prop && data_xform_prop->parse_root);
+    HDassert(data_xform_prop->prog == NULL);
 
-    HDmemset(&resl, 0, sizeof(H5Z_result));
-    HDmemset(&resr, 0, sizeof(H5Z_result));
+    data_xform_prop->prog_len = 0;
+    data_xform_prop->nslots = 0;
 
-    if (tree->type == H5Z_XFORM_INTEGER) {
-	res->type = H5Z_XFORM_INTEGER;
-	res->value.int_val = tree->value.int_val;
-    } /* end if */
-    else if (tree->type == H5Z_XFORM_FLOAT) {
-	res->type = H5Z_XFORM_FLOAT;
-	res->value.float_val = tree->value.float_val;
-    } /* end if */
-    else if (tree->type == H5Z_XFORM_SYMBOL) {
-	res->type = H5Z_XFORM_SYMBOL;
+    if(data_xform_prop->parse_root->type == H5Z_XFORM_INTEGER || data_xform_prop->parse_root->type == H5Z_XFORM_FLOAT)
+        HGOTO_DONE(SUCCEED)
 
-	/*since dat_val stores the address of the array which is really stored in the dat_val_pointers,
-	 * here we make dat_val store a pointer to the array itself instead of the address of it so that the
-	 * rest of the code below works normally. */
-	res->value.dat_val = *((void**)(tree->value.dat_val));
-    } /* end if */
-    else {
-	if(tree->lchild && H5Z_xform_eval_full(tree->lchild, array_size, array_type, &resl) < 0)
-	    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error while performing data transform")
-	if(H5Z_xform_eval_full(tree->rchild, array_size, array_type, &resr) < 0)
-	    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error while performing data transform")
+    max_len = HDstrlen(data_xform_prop->xform_exp);
+    if(NULL == (data_xform_prop->prog = (H5Z_xform_inst_t *)H5MM_malloc(max_len * sizeof(H5Z_xform_inst_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate memory for compiled data transform")
 
-	res->type = H5Z_XFORM_SYMBOL;
+    if(H5Z_xform_lower(data_xform_prop->parse_root, data_xform_prop, max_len, 0) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "unable to compile data transform")
 
-	/* For each type of operation:
-	 * 1.  See if "x" is on left hand side, right hand side, or if both sides are "x"
-	 * 2.  Figure out what type of data we're going to be manipulating
-	 * 3.  Do the operation on the data. */
-	switch (tree->type) {
-	    case H5Z_XFORM_PLUS:
-                H5Z_XFORM_TYPE_OP(resl, resr, array_type, +, array_size)
-                break;
+done:
+    if(ret_value < 0)
+        data_xform_prop->prog = (H5Z_xform_inst_t *)H5MM_xfree(data_xform_prop->prog);
 
-	    case H5Z_XFORM_MINUS:
-                H5Z_XFORM_TYPE_OP(resl, resr, array_type, -, array_size)
-                break;
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_xform_compile() */
 
-	    case H5Z_XFORM_MULT:
-                H5Z_XFORM_TYPE_OP(resl, resr, array_type, *, array_size)
-                break;
 
-	    case H5Z_XFORM_DIVIDE:
-                H5Z_XFORM_TYPE_OP(resl, resr, array_type, /, array_size)
-                break;
+/*-------------------------------------------------------------------------
+ * Function:    H5Z_xform_lower
+ * Purpose: 	Appends the instructions computing the subtree tree into
+ * 		tile slot slot to the compiled transform.  A constant
+ * 		operand becomes part of its operation's instruction, and the
+ * 		right operand of an operation on two subexpressions is
+ * 		computed in the next slot up.
+ * Return:      SUCCEED, or FAIL if the tree is malformed
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_xform_lower(const H5Z_node *tree, H5Z_data_xform_t *data_xform_prop,
+    size_t max_len, unsigned slot)
+{
+    const H5Z_node *num = NULL;         /* Constant operand, if any */
+    H5Z_xform_inst_t *inst;             /* Instruction appended */
+    H5Z_xform_inst_kind_t kind;         /* Kind of that instruction */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-            case H5Z_XFORM_ERROR:
-            case H5Z_XFORM_INTEGER:
-            case H5Z_XFORM_FLOAT:
-            case H5Z_XFORM_SYMBOL:
-            case H5Z_XFORM_LPAREN:
-            case H5Z_XFORM_RPAREN:
-            case H5Z_XFORM_END:
-	    default:
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(tree);
+
+    if(tree->type == H5Z_XFORM_SYMBOL)
+        kind = H5Z_XFORM_INST_LOAD;
+    else if(tree->type == H5Z_XFORM_PLUS || tree->type == H5Z_XFORM_MINUS ||
+            tree->type == H5Z_XFORM_MULT || tree->type == H5Z_XFORM_DIVIDE) {
+        const H5Z_node *lchild = tree->lchild;
+        const H5Z_node *rchild = tree->rchild;
+
+        if(NULL == rchild)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
+
+        /* Unary plus or minus: 0 OP x */
+        if(NULL == lchild) {
+            if(H5Z_xform_lower(rchild, data_xform_prop, max_len, slot) < 0)
                 HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
-	} /* end switch */
-
-	/* The result stores a pointer to the new data */
-	/* So, if the left hand side got its data modified, the result stores a pointers
-	 * to the left hand side's data, ditto for rhs */
-	if(resl.type ==  H5Z_XFORM_SYMBOL)
-	    res->value.dat_val = resl.value.dat_val;
-	else if(resr.type == H5Z_XFORM_SYMBOL)
-	    res->value.dat_val = resr.value.dat_val;
-	else
-	    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error during transform evaluation")
-    } /* end else */
+            kind = H5Z_XFORM_INST_NUM_SYM;
+        } /* end if */
+        else if(rchild->type == H5Z_XFORM_INTEGER || rchild->type == H5Z_XFORM_FLOAT) {
+            if(H5Z_xform_lower(lchild, data_xform_prop, max_len, slot) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
+            kind = H5Z_XFORM_INST_SYM_NUM;
+            num = rchild;
+        } /* end if */
+        else if(lchild->type == H5Z_XFORM_INTEGER || lchild->type == H5Z_XFORM_FLOAT) {
+            if(H5Z_xform_lower(rchild, data_xform_prop, max_len, slot) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
+            kind = H5Z_XFORM_INST_NUM_SYM;
+            num = lchild;
+        } /* end if */
+        else {
+            if(H5Z_xform_lower(lchild, data_xform_prop, max_len, slot) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
+            if(H5Z_xform_lower(rchild, data_xform_prop, max_len, slot + 1) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
+            kind = H5Z_XFORM_INST_SYM_SYM;
+        } /* end else */
+    } /* end if */
+    else
+        /* (Constant subexpressions were folded when the tree was reduced) */
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
+
+    if(data_xform_prop->prog_len >= max_len)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
+
+    inst = &data_xform_prop->prog[data_xform_prop->prog_len++];
+    inst->kind = kind;
+    inst->op = tree->type;
+    inst->slot = slot;
+    if(num)
+        inst->value = (num->type == H5Z_XFORM_INTEGER) ? (double)num->value.int_val : num->value.float_val;
+    else
+        inst->value = 0;
+
+    if(slot + 1 > data_xform_prop->nslots)
+        data_xform_prop->nslots = slot + 1;
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5Z_xform_eval_full() */
+} /* end H5Z_xform_lower() */
 
 
 /*-------------------------------------------------------------------------
@@ -1585,6 +1564,10 @@ H5Z_xform_create(const char *expr)
     if(count != data_xform_prop->dat_val_pointers->num_ptrs)
          HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "error copying the parse tree, did not find correct number of \"variables\"")
 
+    /* Compile the parse tree for evaluation */
+    if(H5Z_xform_compile(data_xform_prop) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "unable to compile data transform")
+
     /* Assign return value */
     ret_value=data_xform_prop;
 
@@ -1595,6 +1578,8 @@ done:
         if(data_xform_prop) {
             if(data_xform_prop->parse_root)
                 H5Z_xform_destroy_parse_tree(data_xform_prop->parse_root);
+            if(data_xform_prop->prog)
+                H5MM_xfree(data_xform_prop->prog);
             if(data_xform_prop->xform_exp)
                 H5MM_xfree(data_xform_prop->xform_exp);
 	    if(count > 0 && data_xform_prop->dat_val_pointers->ptr_dat_val)
@@ -1637,6 +1622,9 @@ H5Z_xform_destroy(H5Z_data_xform_t *data_xform_prop)
 	/* Destroy the parse tree */
         H5Z_xform_destroy_parse_tree(data_xform_prop->parse_root);
 
+        /* Free the compiled transform */
+        H5MM_xfree(data_xform_prop->prog);
+
         /* Free the expression */
         H5MM_xfree(data_xform_prop->xform_exp);
 
@@ -1717,6 +1705,10 @@ H5Z_xform_copy(H5Z_data_xform_t **data_xform_prop)
 	if(count != new_data_xform_prop->dat_val_pointers->num_ptrs)
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "error copying the parse tree, did not find correct number of \"variables\"")
 
+        /* Compile the copied parse tree */
+        if(H5Z_xform_compile(new_data_xform_prop) < 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "unable to compile data transform")
+
         /* Copy new information on top of old information */
         *data_xform_prop=new_data_xform_prop;
     } /* end if */
@@ -1727,6 +1719,8 @@ done:
         if(new_data_xform_prop) {
             if(new_data_xform_prop->parse_root)
                 H5Z_xform_destroy_parse_tree(new_data_xform_prop->parse_root);
+            if(new_data_xform_prop->prog)
+                H5MM_xfree(new_data_xform_prop->prog);
             if(new_data_xform_prop->xform_exp)
                 H5MM_xfree(new_data_xform_prop->xform_exp);
             H5MM_xfree(new_data_xform_prop);
@@ -33,6 +33,7 @@
 /* Headers */
 /***********/
 #include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
 
 
 /****************/
@@ -43,6 +44,36 @@
 /* (same as the IEEE 802.3 (Ethernet) quotient) */
 #define H5_CRC_QUOTIENT 0x04C11DB7
 
+/* Number of CRC tables, for updating the CRC with that many bytes at once
+ * ("slicing-by-8") */
+#define H5_CRC_NTABLES  8
+
+/* The SSE2 and AVX2 fletcher32 kernels need a compiler which can build code
+ * for an instruction set the whole library isn't compiled for, and which can
+ * ask the CPU what it supports (GCC 4.9 and later, or clang) */
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(H5_NO_CHECKSUM_SIMD) && \
+        (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define H5_CHECKSUM_X86
+#include <immintrin.h>
+#define H5_CHECKSUM_SSE2_ATTR   __attribute__((target("sse2")))
+#define H5_CHECKSUM_AVX2_ATTR   __attribute__((target("avx2")))
+#endif /* H5_CHECKSUM_X86 */
+
+/* Most 16-byte vectors the fletcher32 kernels sum before reducing the sums
+ * (the largest power of two whose weighted sums fit in 32 bits) */
+#define H5_FLETCHER32_SIMD_NVECS        256
+
+/* Shortest buffer the fletcher32 kernels are used for */
+#define H5_FLETCHER32_SIMD_MIN          64
+
+/* Whether lookup3 can read the key a 32-bit word at a time: its words are
+ * little-endian, so only on little-endian hosts */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define H5_LOOKUP3_WORD_LOADS
+#endif
+#endif
+
 
 /******************/
 /* Local Typedefs */
@@ -58,6 +89,13 @@
 /* Local Prototypes */
 /********************/
 
+static uint32_t H5_checksum_fletcher32_finish(const uint8_t *data,
+    size_t nwords, hbool_t odd, uint64_t sum1, uint64_t sum2, hbool_t nonzero);
+#ifdef H5_CHECKSUM_X86
+static uint32_t H5_checksum_fletcher32_sse2(const uint8_t *data, size_t len);
+static uint32_t H5_checksum_fletcher32_avx2(const uint8_t *data, size_t len);
+#endif /* H5_CHECKSUM_X86 */
+
 
 /*********************/
 /* Package Variables */
@@ -73,12 +111,25 @@
 /* Local Variables */
 /*******************/
 
-/* Table of CRCs of all 8-bit messages. */
-static uint32_t H5_crc_table[256];
+/* Table of CRCs of all 8-bit messages, followed by the tables for the
+ * CRC of each 8-bit message followed by 1 to 7 zero bytes */
+static uint32_t H5_crc_table[H5_CRC_NTABLES][256];
 
 /* Flag: has the table been computed? */
 static hbool_t H5_crc_table_computed = FALSE;
 
+#ifdef H5_CHECKSUM_X86
+/* Fletcher32 implementations */
+typedef enum H5_fletcher32_kern_t {
+    H5_FLETCHER32_KERN_SCALAR = 0,      /* Portable C */
+    H5_FLETCHER32_KERN_SSE2,            /* SSE2 */
+    H5_FLETCHER32_KERN_AVX2             /* AVX2 */
+} H5_fletcher32_kern_t;
+
+/* Fastest fletcher32 implementation this CPU supports (set on first use) */
+static int H5_fletcher32_kern_g = -1;
+#endif /* H5_CHECKSUM_X86 */
+
 
 
 /*-------------------------------------------------------------------------
@@ -114,6 +165,7 @@ H5_checksum_fletcher32(const void *_data, size_t _len)
     const uint8_t *data = (const uint8_t *)_data;  /* Pointer to the data to be summed */
     size_t len = _len / 2;      /* Length in 16-bit words */
     uint32_t sum1 = 0, sum2 = 0;
+    uint32_t ret_value;         /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT_NOERR
 
@@ -121,6 +173,29 @@ H5_checksum_fletcher32(const void *_data, size_t _len)
     HDassert(_data);
     HDassert(_len > 0);
 
+#ifdef H5_CHECKSUM_X86
+    /* Use the fastest vector implementation the CPU supports */
+    if(_len >= H5_FLETCHER32_SIMD_MIN) {
+        if(H5_fletcher32_kern_g < 0) {
+            H5_fletcher32_kern_t kern = H5_FLETCHER32_KERN_SCALAR;
+
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx2"))
+                kern = H5_FLETCHER32_KERN_AVX2;
+            else if(__builtin_cpu_supports("sse2"))
+                kern = H5_FLETCHER32_KERN_SSE2;
+
+            /* (Racing threads all store the same value) */
+            H5_fletcher32_kern_g = (int)kern;
+        } /* end if */
+
+        if(H5_fletcher32_kern_g == H5_FLETCHER32_KERN_AVX2)
+            HGOTO_DONE(H5_checksum_fletcher32_avx2(data, _len))
+        else if(H5_fletcher32_kern_g == H5_FLETCHER32_KERN_SSE2)
+            HGOTO_DONE(H5_checksum_fletcher32_sse2(data, _len))
+    } /* end if */
+#endif /* H5_CHECKSUM_X86 */
+
     /* Compute checksum for pairs of bytes */
     /* (the magic "360" value is is the largest number of sums that can be
      *  performed without numeric overflow)
@@ -149,14 +224,205 @@ H5_checksum_fletcher32(const void *_data, size_t _len)
     sum1 = (sum1 & 0xffff) + (sum1 >> 16);
     sum2 = (sum2 & 0xffff) + (sum2 >> 16);
 
-    FUNC_LEAVE_NOAPI((sum2 << 16) | sum1)
+    ret_value = (sum2 << 16) | sum1;
+
+#ifdef H5_CHECKSUM_X86
+done:
+#endif /* H5_CHECKSUM_X86 */
+    FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5_checksum_fletcher32() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_fletcher32_finish
+ *
+ * Purpose:	Add the last NWORDS 16-bit words at DATA, and the odd byte
+ *              after them if ODD is set, to fletcher32 sums SUM1 and SUM2
+ *              (kept modulo 65535), and return the checksum.
+ *
+ *              H5_checksum_fletcher32 folds its sums instead of taking
+ *              them modulo 65535, which never turns a non-zero sum into 0
+ *              but into 0xffff.  NONZERO tells whether any data summed so
+ *              far wasn't zero, so the result matches it bit for bit.
+ *
+ * Return:	32-bit fletcher checksum (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint32_t
+H5_checksum_fletcher32_finish(const uint8_t *data, size_t nwords, hbool_t odd,
+    uint64_t sum1, uint64_t sum2, hbool_t nonzero)
+{
+    uint32_t word;              /* Next 16-bit word */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    while(nwords--) {
+        word = ((uint32_t)data[0] << 8) | (uint32_t)data[1];
+        data += 2;
+        nonzero |= (hbool_t)(word != 0);
+        sum1 = (sum1 + word) % 65535;
+        sum2 = (sum2 + sum1) % 65535;
+    } /* end while */
+    if(odd) {
+        word = (uint32_t)data[0] << 8;
+        nonzero |= (hbool_t)(word != 0);
+        sum1 = (sum1 + word) % 65535;
+        sum2 = (sum2 + sum1) % 65535;
+    } /* end if */
+
+    if(nonzero) {
+        if(sum1 == 0)
+            sum1 = 0xffff;
+        if(sum2 == 0)
+            sum2 = 0xffff;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI((uint32_t)((sum2 << 16) | sum1))
+} /* end H5_checksum_fletcher32_finish() */
+
+#ifdef H5_CHECKSUM_X86
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_fletcher32_sse2
+ *
+ * Purpose:	Compute the fletcher32 checksum of LEN bytes at DATA with
+ *              SSE2, eight 16-bit words at a time.
+ *
+ *              Each of the eight 32-bit lanes J of A sums the words at
+ *              positions J, J+8, J+16, ... and B adds up A after each
+ *              vector.  For N words summed this way, the first sum grows
+ *              by the sum of A's lanes, and the second by N times the old
+ *              first sum, plus 8 times the sum of B's lanes, minus J times
+ *              A's lane J for each lane.
+ *
+ * Return:	32-bit fletcher checksum (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_CHECKSUM_SSE2_ATTR uint32_t
+H5_checksum_fletcher32_sse2(const uint8_t *data, size_t len)
+{
+    size_t      nwords = len / 2;       /* Words left to sum */
+    uint64_t    sum1 = 0, sum2 = 0;     /* Sums, modulo 65535 */
+    __m128i     zero = _mm_setzero_si128();
+    __m128i     nonzero = _mm_setzero_si128();  /* OR of all the data */
+    uint32_t    ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    while(nwords >= 8) {
+        size_t      nvecs = MIN(nwords / 8, H5_FLETCHER32_SIMD_NVECS);  /* Vectors summed */
+        __m128i     a_lo = zero, a_hi = zero, b_lo = zero, b_hi = zero;
+        uint32_t    a[8], b[8];         /* Lanes of A and B */
+        uint64_t    sum_a = 0, sum_b = 0, sum_ja = 0;
+        size_t      v;                  /* Local index variable */
+        unsigned    j;                  /* Local index variable */
+
+        for(v = 0; v < nvecs; v++, data += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i *)data);
+            __m128i w = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));   /* Big-endian words */
+
+            nonzero = _mm_or_si128(nonzero, x);
+            a_lo = _mm_add_epi32(a_lo, _mm_unpacklo_epi16(w, zero));
+            a_hi = _mm_add_epi32(a_hi, _mm_unpackhi_epi16(w, zero));
+            b_lo = _mm_add_epi32(b_lo, a_lo);
+            b_hi = _mm_add_epi32(b_hi, a_hi);
+        } /* end for */
+
+        _mm_storeu_si128((__m128i *)a, a_lo);
+        _mm_storeu_si128((__m128i *)(a + 4), a_hi);
+        _mm_storeu_si128((__m128i *)b, b_lo);
+        _mm_storeu_si128((__m128i *)(b + 4), b_hi);
+        for(j = 0; j < 8; j++) {
+            sum_a += a[j];
+            sum_b += b[j];
+            sum_ja += (uint64_t)j * a[j];
+        } /* end for */
+
+        sum2 = (sum2 + ((8 * nvecs) % 65535) * sum1 + 8 * (sum_b % 65535) + 65535 - sum_ja % 65535) % 65535;
+        sum1 = (sum1 + sum_a) % 65535;
+        nwords -= 8 * nvecs;
+    } /* end while */
+
+    ret_value = H5_checksum_fletcher32_finish(data, nwords, (hbool_t)(len % 2),
+            sum1, sum2, (hbool_t)(_mm_movemask_epi8(_mm_cmpeq_epi8(nonzero, zero)) != 0xffff));
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5_checksum_fletcher32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_fletcher32_avx2
+ *
+ * Purpose:	H5_checksum_fletcher32_sse2 with AVX2, sixteen 16-bit words
+ *              at a time.  The unpacks work within each 128-bit half, so
+ *              the lanes of A and B hold the words at positions 0-3 and
+ *              8-11 of each vector in the low half, and 4-7 and 12-15 in
+ *              the high half.
+ *
+ * Return:	32-bit fletcher checksum (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_CHECKSUM_AVX2_ATTR uint32_t
+H5_checksum_fletcher32_avx2(const uint8_t *data, size_t len)
+{
+    static const unsigned pos[16] = {0, 1, 2, 3, 8, 9, 10, 11, 4, 5, 6, 7, 12, 13, 14, 15};
+    size_t      nwords = len / 2;       /* Words left to sum */
+    uint64_t    sum1 = 0, sum2 = 0;     /* Sums, modulo 65535 */
+    __m256i     zero = _mm256_setzero_si256();
+    __m256i     nonzero = _mm256_setzero_si256();       /* OR of all the data */
+    uint32_t    ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    while(nwords >= 16) {
+        size_t      nvecs = MIN(nwords / 16, H5_FLETCHER32_SIMD_NVECS); /* Vectors summed */
+        __m256i     a_lo = zero, a_hi = zero, b_lo = zero, b_hi = zero;
+        uint32_t    a[16], b[16];       /* Lanes of A and B */
+        uint64_t    sum_a = 0, sum_b = 0, sum_ja = 0;
+        size_t      v;                  /* Local index variable */
+        unsigned    j;                  /* Local index variable */
+
+        for(v = 0; v < nvecs; v++, data += 32) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)data);
+            __m256i w = _mm256_or_si256(_mm256_slli_epi16(x, 8), _mm256_srli_epi16(x, 8));  /* Big-endian words */
+
+            nonzero = _mm256_or_si256(nonzero, x);
+            a_lo = _mm256_add_epi32(a_lo, _mm256_unpacklo_epi16(w, zero));
+            a_hi = _mm256_add_epi32(a_hi, _mm256_unpackhi_epi16(w, zero));
+            b_lo = _mm256_add_epi32(b_lo, a_lo);
+            b_hi = _mm256_add_epi32(b_hi, a_hi);
+        } /* end for */
+
+        _mm256_storeu_si256((__m256i *)a, a_lo);
+        _mm256_storeu_si256((__m256i *)(a + 8), a_hi);
+        _mm256_storeu_si256((__m256i *)b, b_lo);
+        _mm256_storeu_si256((__m256i *)(b + 8), b_hi);
+        for(j = 0; j < 16; j++) {
+            sum_a += a[j];
+            sum_b += b[j];
+            sum_ja += (uint64_t)pos[j] * a[j];
+        } /* end for */
+
+        sum2 = (sum2 + ((16 * nvecs) % 65535) * sum1 + 16 * (sum_b % 65535) + 65535 - sum_ja % 65535) % 65535;
+        sum1 = (sum1 + sum_a) % 65535;
+        nwords -= 16 * nvecs;
+    } /* end while */
+
+    ret_value = H5_checksum_fletcher32_finish(data, nwords, (hbool_t)(len % 2),
+            sum1, sum2, (hbool_t)((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(nonzero, zero)) != 0xffffffff));
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5_checksum_fletcher32_avx2() */
+#endif /* H5_CHECKSUM_X86 */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5_checksum_crc_make_table
  *
- * Purpose:	Compute the CRC table for the CRC checksum algorithm
+ * Purpose:	Compute the CRC tables for the CRC checksum algorithm
  *
  * Return:	none
  *
@@ -181,8 +447,14 @@ H5_checksum_crc_make_table(void)
                 c = H5_CRC_QUOTIENT ^ (c >> 1);
             else
                 c = c >> 1;
-        H5_crc_table[n] = c;
+        H5_crc_table[0][n] = c;
     }
+
+    /* Then for each byte value followed by 1 to 7 zero bytes */
+    for(n = 0; n < 256; n++)
+        for(k = 1; k < H5_CRC_NTABLES; k++)
+            H5_crc_table[k][n] = H5_crc_table[0][H5_crc_table[k - 1][n] & 0xff] ^ (H5_crc_table[k - 1][n] >> 8);
+
     H5_crc_table_computed = TRUE;
 
     FUNC_LEAVE_NOAPI_VOID
@@ -215,9 +487,23 @@ H5_checksum_crc_update(uint32_t crc, const uint8_t *buf, size_t len)
     if(!H5_crc_table_computed)
         H5_checksum_crc_make_table();
 
-    /* Update the CRC with the results from this buffer */
+    /* Update the CRC eight bytes at a time: the CRC of those bytes is the
+     * XOR of the CRCs of each of them followed by the bytes after it */
+    while(len >= H5_CRC_NTABLES) {
+        uint32_t lo = crc ^ ((uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24));
+        uint32_t hi = (uint32_t)buf[4] | ((uint32_t)buf[5] << 8) | ((uint32_t)buf[6] << 16) | ((uint32_t)buf[7] << 24);
+
+        crc = H5_crc_table[7][lo & 0xff] ^ H5_crc_table[6][(lo >> 8) & 0xff]
+            ^ H5_crc_table[5][(lo >> 16) & 0xff] ^ H5_crc_table[4][lo >> 24]
+            ^ H5_crc_table[3][hi & 0xff] ^ H5_crc_table[2][(hi >> 8) & 0xff]
+            ^ H5_crc_table[1][(hi >> 16) & 0xff] ^ H5_crc_table[0][hi >> 24];
+        buf += H5_CRC_NTABLES;
+        len -= H5_CRC_NTABLES;
+    } /* end while */
+
+    /* Update the CRC with the rest of this buffer */
     for(n = 0; n < len; n++)
-        crc = H5_crc_table[(crc ^ buf[n]) & 0xff] ^ (crc >> 8);
+        crc = H5_crc_table[0][(crc ^ buf[n]) & 0xff] ^ (crc >> 8);
 
     FUNC_LEAVE_NOAPI(crc)
 } /* end H5_checksum_crc_update() */
@@ -388,6 +674,14 @@ H5_checksum_lookup3(const void *key, size_t length, uint32_t initval)
     /*--------------- all but the last block: affect some 32 bits of (a,b,c) */
     while (length > 12)
     {
+#ifdef H5_LOOKUP3_WORD_LOADS
+      uint32_t w[3];
+
+      HDmemcpy(w, k, sizeof(w));
+      a += w[0];
+      b += w[1];
+      c += w[2];
+#else /* H5_LOOKUP3_WORD_LOADS */
       a += k[0];
       a += ((uint32_t)k[1])<<8;
       a += ((uint32_t)k[2])<<16;
@@ -400,6 +694,7 @@ H5_checksum_lookup3(const void *key, size_t length, uint32_t initval)
       c += ((uint32_t)k[9])<<8;
       c += ((uint32_t)k[10])<<16;
       c += ((uint32_t)k[11])<<24;
+#endif /* H5_LOOKUP3_WORD_LOADS */
       H5_lookup3_mix(a, b, c);
       length -= 12;
       k += 12;
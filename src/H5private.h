@@ -497,6 +497,22 @@
 #   define H5_POSIX_MAX_IO_BYTES        SSIZET_MAX
 #endif
 
+/*
+ * Positional POSIX I/O (pread/pwrite), which reads and writes at an offset
+ * without moving (or depending on) the file descriptor's file position.
+ */
+#if defined(H5_HAVE_PREAD) && defined(H5_HAVE_PWRITE) && !defined(H5_HAVE_WIN32_API)
+#   define H5_HAVE_PREADWRITE
+#endif
+
+/*
+ * Positional vectored POSIX I/O (preadv/pwritev), which moves one range of
+ * a file to or from several memory buffers in a single call.
+ */
+#if defined(H5_HAVE_PREADWRITE) && defined(H5_HAVE_PREADV) && defined(H5_HAVE_PWRITEV)
+#   define H5_HAVE_PREADWRITEV
+#endif
+
 /*
  * A macro to portably increment enumerated types.
  */
@@ -1068,6 +1084,9 @@ typedef off_t               h5_stat_size_t;
 #ifndef HDlseek
     #define HDlseek(F,O,W)  lseek(F,O,W)
 #endif /* HDlseek */
+#ifndef HDmadvise
+    #define HDmadvise(A,Z,V)    madvise(A,Z,V)
+#endif /* HDmadvise */
 #ifndef HDmalloc
     #define HDmalloc(Z)    malloc(Z)
 #endif /* HDmalloc */
@@ -1111,9 +1130,15 @@ typedef off_t               h5_stat_size_t;
 #ifndef HDmktime
     #define HDmktime(T)    mktime(T)
 #endif /* HDmktime */
+#ifndef HDmmap
+    #define HDmmap(A,Z,P,F,D,O)    mmap(A,Z,P,F,D,O)
+#endif /* HDmmap */
 #ifndef HDmodf
     #define HDmodf(X,Y)    modf(X,Y)
 #endif /* HDmodf */
+#ifndef HDmunmap
+    #define HDmunmap(A,Z)    munmap(A,Z)
+#endif /* HDmunmap */
 #ifndef HDopen
     #ifdef _O_BINARY
         #define HDopen(S,F,M)    open(S,F|_O_BINARY,M)
@@ -1142,9 +1167,21 @@ typedef off_t               h5_stat_size_t;
 #ifndef HDpowf
     #define HDpowf(X,Y)   powf(X,Y)
 #endif /* HDpowf */
+#ifndef HDpread
+    #define HDpread(F,M,Z,O)    pread(F,M,Z,O)
+#endif /* HDpread */
+#ifndef HDpreadv
+    #define HDpreadv(F,V,C,O)    preadv(F,V,C,O)
+#endif /* HDpreadv */
 #ifndef HDprintf
     #define HDprintf(...)   HDfprintf(stdout, __VA_ARGS__)
 #endif /* HDprintf */
+#ifndef HDpwrite
+    #define HDpwrite(F,M,Z,O)    pwrite(F,M,Z,O)
+#endif /* HDpwrite */
+#ifndef HDpwritev
+    #define HDpwritev(F,V,C,O)    pwritev(F,V,C,O)
+#endif /* HDpwritev */
 #ifndef HDputc
     #define HDputc(C,F)    putc(C,F)
 #endif /* HDputc*/
@@ -39,8 +39,9 @@
 #include "H5Ipkg.h"         /* IDs                                      */
 #include "H5MMprivate.h"    /* Memory management                        */
 
-#ifdef H5_HAVE_PARALLEL
 /* datatypes of predefined drivers needed by H5_trace() */
+#include "H5FDasync.h"
+#ifdef H5_HAVE_PARALLEL
 #include "H5FDmpio.h"
 #endif /* H5_HAVE_PARALLEL */
 
@@ -295,6 +296,44 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
 
             case 'D':
                 switch(type[1]) {
+                    case 'A':
+                        if(ptr) {
+                            if(vp)
+                                fprintf(out, "0x%lx", (unsigned long)vp);
+                            else
+                                fprintf(out, "NULL");
+                        } /* end if */
+                        else {
+                            H5FD_advice_t advice = (H5FD_advice_t)va_arg(ap, int);
+
+                            switch(advice) {
+                                case H5FD_ADVICE_ERROR:
+                                    fprintf(out, "H5FD_ADVICE_ERROR");
+                                    break;
+
+                                case H5FD_ADVICE_NORMAL:
+                                    fprintf(out, "H5FD_ADVICE_NORMAL");
+                                    break;
+
+                                case H5FD_ADVICE_SEQUENTIAL:
+                                    fprintf(out, "H5FD_ADVICE_SEQUENTIAL");
+                                    break;
+
+                                case H5FD_ADVICE_RANDOM:
+                                    fprintf(out, "H5FD_ADVICE_RANDOM");
+                                    break;
+
+                                case H5FD_ADVICE_WILLNEED:
+                                    fprintf(out, "H5FD_ADVICE_WILLNEED");
+                                    break;
+
+                                default:
+                                    fprintf(out, "%ld", (long)advice);
+                                    break;
+                            } /* end switch */
+                        } /* end else */
+                        break;
+
                     case 'a':
                         if(ptr) {
                             if(vp)
@@ -359,6 +398,44 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                         } /* end else */
                         break;
 
+                    case 'e':
+                        if(ptr) {
+                            if(vp)
+                                fprintf(out, "0x%lx", (unsigned long)vp);
+                            else
+                                fprintf(out, "NULL");
+                        } /* end if */
+                        else {
+                            H5FD_async_engine_t engine = (H5FD_async_engine_t)va_arg(ap, int);
+
+                            switch(engine) {
+                                case H5FD_ASYNC_ENGINE_ERROR:
+                                    fprintf(out, "H5FD_ASYNC_ENGINE_ERROR");
+                                    break;
+
+                                case H5FD_ASYNC_ENGINE_DEFAULT:
+                                    fprintf(out, "H5FD_ASYNC_ENGINE_DEFAULT");
+                                    break;
+
+                                case H5FD_ASYNC_ENGINE_IO_URING:
+                                    fprintf(out, "H5FD_ASYNC_ENGINE_IO_URING");
+                                    break;
+
+                                case H5FD_ASYNC_ENGINE_LINUX_AIO:
+                                    fprintf(out, "H5FD_ASYNC_ENGINE_LINUX_AIO");
+                                    break;
+
+                                case H5FD_ASYNC_ENGINE_SYNC:
+                                    fprintf(out, "H5FD_ASYNC_ENGINE_SYNC");
+                                    break;
+
+                                default:
+                                    fprintf(out, "%ld", (long)engine);
+                                    break;
+                            } /* end switch */
+                        } /* end else */
+                        break;
+
                     case 'f':
                         if(ptr) {
                             if(vp)
@@ -724,6 +801,36 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                         } /* end else */
                         break;
 
+                    case 'p':
+                        if(ptr) {
+                            if(vp)
+                                fprintf(out, "0x%lx", (unsigned long)vp);
+                            else
+                                fprintf(out, "NULL");
+                        } /* end if */
+                        else {
+                            H5D_chunk_cache_policy_t policy = (H5D_chunk_cache_policy_t)va_arg(ap, int);
+
+                            switch(policy) {
+                                case H5D_CHUNK_CACHE_POLICY_ERROR:
+                                    fprintf(out, "H5D_CHUNK_CACHE_POLICY_ERROR");
+                                    break;
+
+                                case H5D_CHUNK_CACHE_LRU:
+                                    fprintf(out, "H5D_CHUNK_CACHE_LRU");
+                                    break;
+
+                                case H5D_CHUNK_CACHE_2Q:
+                                    fprintf(out, "H5D_CHUNK_CACHE_2Q");
+                                    break;
+
+                                default:
+                                    fprintf(out, "%ld", (long)policy);
+                                    break;
+                            } /* end switch */
+                        } /* end else */
+                        break;
+
                     case 'v':
                         if(ptr) {
                             if(vp)
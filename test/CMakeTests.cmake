@@ -312,6 +312,7 @@ endif (HDF5_ENABLE_USING_MEMCHECKER)
 
 set (test_CLEANFILES
     accum.h5
+    page_buffer.h5
     cmpd_dset.h5
     compact_dataset.h5
     dataset.h5
@@ -519,6 +520,7 @@ set (H5TEST_TESTS
     fheap
     pool
     accum
+    page_buffer
     #hyperslab
     istore
     bittests
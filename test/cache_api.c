@@ -39,6 +39,7 @@ static hbool_t mdc_api_call_smoke_check(int express_test);
 static H5AC_cache_config_t * init_invalid_configs(void);
 static hbool_t check_fapl_mdc_api_errs(void);
 static hbool_t check_file_mdc_api_errs(void);
+static hbool_t check_skip_metadata_checksums(void);
 
 
 
@@ -2252,6 +2253,286 @@ check_file_mdc_api_errs(void)
 
 } /* check_file_mdc_api_errs() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    check_skip_metadata_checksums()
+ *
+ * Purpose:     Verify that a file opened with
+ *              H5Pset_skip_metadata_checksums() doesn't verify the
+ *              checksums of the metadata it loads, that metadata it
+ *              writes is still checksummed, and that
+ *              H5Fget_mdc_chksum_stats() counts the verifications made
+ *              and skipped.
+ *
+ *              The file is created with the latest format, so that its
+ *              superblock and object headers carry checksums, and then
+ *              the superblock checksum is corrupted.
+ *
+ * Return:      Test pass status (TRUE/FALSE)
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define SKIP_CHKSUM_SBLOCK_CHKSUM_OFF   44      /* Offset of v2 superblock checksum */
+#define SKIP_CHKSUM_NELMTS              64
+
+static hbool_t
+check_skip_metadata_checksums(void)
+{
+    char filename[512];
+    hid_t fapl_id = -1;
+    hid_t skip_fapl_id = -1;
+    hid_t acc_fapl_id = -1;
+    hid_t file_id = -1;
+    hid_t space_id = -1;
+    hid_t dcpl_id = -1;
+    hid_t dset_id = -1;
+    hid_t group_id = -1;
+    hsize_t dims[1] = {SKIP_CHKSUM_NELMTS};
+    hsize_t chunk_dims[1] = {SKIP_CHKSUM_NELMTS / 8};
+    int wbuf[SKIP_CHKSUM_NELMTS];
+    int rbuf[SKIP_CHKSUM_NELMTS];
+    hbool_t skip;
+    H5F_mdc_chksum_stats_t stats;
+    int fd = -1;
+    unsigned char byte;
+    int i;
+
+    TESTING("skipping metadata checksum verification");
+
+    pass = TRUE;
+
+    for ( i = 0; i < SKIP_CHKSUM_NELMTS; i++ )
+        wbuf[i] = i * 3;
+
+    /* setup the file name and the file access property lists */
+    if ( pass ) {
+
+        if ( ( h5_fixname(FILENAME[1], H5P_DEFAULT, filename, sizeof(filename))
+               == NULL ) ||
+             ( (fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0 ) ||
+             ( H5Pset_libver_bounds(fapl_id, H5F_LIBVER_LATEST,
+                                    H5F_LIBVER_LATEST) < 0 ) ||
+             ( (skip_fapl_id = H5Pcopy(fapl_id)) < 0 ) ||
+             ( H5Pset_skip_metadata_checksums(skip_fapl_id, TRUE) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't set up file access property lists.\n";
+        }
+    }
+
+    /* the setting defaults to FALSE and round trips */
+    if ( pass ) {
+
+        if ( ( H5Pget_skip_metadata_checksums(fapl_id, &skip) < 0 ) ||
+             ( skip != FALSE ) ||
+             ( H5Pget_skip_metadata_checksums(skip_fapl_id, &skip) < 0 ) ||
+             ( skip != TRUE ) ) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected 'skip metadata checksums' setting.\n";
+        }
+    }
+
+    /* create the file, with a chunked dataset */
+    if ( pass ) {
+
+        if ( ( (file_id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT,
+                                    fapl_id)) < 0 ) ||
+             ( (space_id = H5Screate_simple(1, dims, NULL)) < 0 ) ||
+             ( (dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0 ) ||
+             ( H5Pset_chunk(dcpl_id, 1, chunk_dims) < 0 ) ||
+             ( (dset_id = H5Dcreate2(file_id, "dset", H5T_NATIVE_INT, space_id,
+                                     H5P_DEFAULT, dcpl_id, H5P_DEFAULT)) < 0 ) ||
+             ( H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL,
+                        H5P_DEFAULT, wbuf) < 0 ) ||
+             ( H5Dclose(dset_id) < 0 ) ||
+             ( H5Fclose(file_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't create test file.\n";
+        }
+    }
+
+    /* reopen it: the checksums of the metadata loaded are verified */
+    if ( pass ) {
+
+        HDmemset(rbuf, 0, sizeof(rbuf));
+        if ( ( (file_id = H5Fopen(filename, H5F_ACC_RDONLY, fapl_id)) < 0 ) ||
+             ( (dset_id = H5Dopen2(file_id, "dset", H5P_DEFAULT)) < 0 ) ||
+             ( H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL,
+                       H5P_DEFAULT, rbuf) < 0 ) ||
+             ( H5Fget_mdc_chksum_stats(file_id, &stats) < 0 ) ||
+             ( H5Dclose(dset_id) < 0 ) ||
+             ( H5Fclose(file_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't read test file.\n";
+
+        } else if ( ( HDmemcmp(rbuf, wbuf, sizeof(wbuf)) != 0 ) ||
+                    ( stats.nverified == 0 ) ||
+                    ( stats.bytes_verified == 0 ) ||
+                    ( stats.nskipped != 0 ) ||
+                    ( stats.bytes_skipped != 0 ) ||
+                    ( stats.time_saved != 0.0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected checksum stats with verification.\n";
+        }
+    }
+
+    /* corrupt the superblock's checksum */
+    if ( pass ) {
+
+        if ( ( (fd = HDopen(filename, O_RDWR, 0)) < 0 ) ||
+             ( HDlseek(fd, (off_t)SKIP_CHKSUM_SBLOCK_CHKSUM_OFF, SEEK_SET) < 0 ) ||
+             ( HDread(fd, &byte, (size_t)1) != 1 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't read superblock checksum.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        byte ^= 0xff;
+        if ( ( HDlseek(fd, (off_t)SKIP_CHKSUM_SBLOCK_CHKSUM_OFF, SEEK_SET) < 0 ) ||
+             ( HDwrite(fd, &byte, (size_t)1) != 1 ) ||
+             ( HDclose(fd) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't corrupt superblock checksum.\n";
+        }
+    }
+
+    /* the file can no longer be opened with verification ... */
+    if ( pass ) {
+
+        H5E_BEGIN_TRY {
+            file_id = H5Fopen(filename, H5F_ACC_RDONLY, fapl_id);
+        } H5E_END_TRY;
+
+        if ( file_id >= 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "opened file with bad superblock checksum.\n";
+            H5Fclose(file_id);
+        }
+    }
+
+    /* ... but can be without */
+    if ( pass ) {
+
+        HDmemset(rbuf, 0, sizeof(rbuf));
+        if ( ( (file_id = H5Fopen(filename, H5F_ACC_RDWR, skip_fapl_id)) < 0 ) ||
+             ( (dset_id = H5Dopen2(file_id, "dset", H5P_DEFAULT)) < 0 ) ||
+             ( H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL,
+                       H5P_DEFAULT, rbuf) < 0 ) ||
+             ( H5Fget_mdc_chksum_stats(file_id, &stats) < 0 ) ||
+             ( (acc_fapl_id = H5Fget_access_plist(file_id)) < 0 ) ||
+             ( H5Pget_skip_metadata_checksums(acc_fapl_id, &skip) < 0 ) ||
+             ( H5Pclose(acc_fapl_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't read test file without verification.\n";
+
+        } else if ( ( HDmemcmp(rbuf, wbuf, sizeof(wbuf)) != 0 ) ||
+                    ( skip != TRUE ) ||
+                    ( stats.nverified != 0 ) ||
+                    ( stats.bytes_verified != 0 ) ||
+                    ( stats.nskipped == 0 ) ||
+                    ( stats.bytes_skipped == 0 ) ||
+                    ( stats.time_saved <= 0.0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected checksum stats without verification.\n";
+        }
+    }
+
+    /* metadata written is still checksummed: add a group, which rewrites
+     * the superblock (with a good checksum) when the file is closed
+     */
+    if ( pass ) {
+
+        if ( ( (group_id = H5Gcreate2(file_id, "group", H5P_DEFAULT,
+                                      H5P_DEFAULT, H5P_DEFAULT)) < 0 ) ||
+             ( H5Gclose(group_id) < 0 ) ||
+             ( H5Dclose(dset_id) < 0 ) ||
+             ( H5Fclose(file_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't modify test file without verification.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        if ( ( (file_id = H5Fopen(filename, H5F_ACC_RDONLY, fapl_id)) < 0 ) ||
+             ( (group_id = H5Gopen2(file_id, "group", H5P_DEFAULT)) < 0 ) ||
+             ( H5Gclose(group_id) < 0 ) ||
+             ( H5Fget_mdc_chksum_stats(file_id, &stats) < 0 ) ||
+             ( H5Fclose(file_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't verify metadata written without verification.\n";
+
+        } else if ( ( stats.nverified == 0 ) || ( stats.nskipped != 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected checksum stats after rewrite.\n";
+        }
+    }
+
+    /* H5Fget_mdc_chksum_stats() input errors */
+    if ( pass ) {
+
+        herr_t result;
+
+        H5E_BEGIN_TRY {
+            result = H5Fget_mdc_chksum_stats((hid_t)-1, &stats);
+        } H5E_END_TRY;
+
+        if ( result >= 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fget_mdc_chksum_stats() accepted bad file_id.";
+        }
+    }
+
+    if ( ( H5Pclose(dcpl_id) < 0 ) || ( H5Sclose(space_id) < 0 ) ||
+         ( H5Pclose(skip_fapl_id) < 0 ) || ( H5Pclose(fapl_id) < 0 ) ) {
+
+        pass = FALSE;
+        failure_mssg = "can't close property lists.\n";
+    }
+
+    if ( pass ) {
+
+        if ( HDremove(filename) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "HDremove() failed.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        PASSED();
+
+    } else {
+
+        H5_FAILED();
+    }
+
+    if ( ! pass ) {
+
+        HDfprintf(stdout, "%s: failure_mssg = \"%s\".\n", FUNC, failure_mssg);
+    }
+
+    return pass;
+
+} /* check_skip_metadata_checksums() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    main
@@ -2317,6 +2598,11 @@ main(void)
         nerrs += 1;
     }
 
+    if ( !check_skip_metadata_checksums() ) {
+
+        nerrs += 1;
+    }
+
     if ( invalid_configs ) {
 
         HDfree(invalid_configs);
@@ -54,6 +54,15 @@ const char *FILENAME[] = {
     "chunk_single",     /* 17 */
     "storage_size",	/* 18 */
     "dls_01_strings",   /* 19 */
+    "filter_nthreads",  /* 20 */
+    "chunk_cache_policy", /* 21 */
+    "shared_chunk_cache", /* 22 */
+    "chunk_read_ahead", /* 23 */
+    "chunk_iter",       /* 24 */
+    "chunk_flush_sorted", /* 25 */
+    "sparse_read",      /* 26 */
+    "chunk_cache_stats", /* 27 */
+    "chunk_store_raw",  /* 28 */
     NULL
 };
 #define FILENAME_BUF_SIZE       1024
@@ -74,6 +83,7 @@ const char *FILENAME[] = {
 #define DSET_TCONV_NAME		"tconv"
 #define DSET_DEFLATE_NAME	"deflate"
 #define DSET_SHUFFLE_NAME	"shuffle"
+#define DSET_BITSHUFFLE_LZ_NAME	"bitshuffle_lz"
 #define DSET_FLETCHER32_NAME	"fletcher32"
 #define DSET_FLETCHER32_NAME_2	"fletcher32_2"
 #define DSET_FLETCHER32_NAME_3	"fletcher32_3"
@@ -95,6 +105,13 @@ const char *FILENAME[] = {
 #define DSET_SET_LOCAL_NAME	"set_local"
 #define DSET_SET_LOCAL_NAME_2	"set_local_2"
 #define DSET_ONEBYTE_SHUF_NAME	"onebyte_shuffle"
+#define DSET_DEFLATE_STREAMS_NAME      "deflate_streams"
+#define DSET_DEFLATE_STREAMS_NDSETS    3
+#define DSET_DEFLATE_STREAMS_NCHUNKS   20
+#define DSET_DEFLATE_STREAMS_CHUNK     1000
+#define DSET_BITSHUFFLE_LZ_SIZES_NAME  "bitshuffle_lz_sizes"
+#define DSET_BITSHUFFLE_LZ_NELMTS      5003
+#define DSET_BITSHUFFLE_LZ_CHUNK       2000
 #define DSET_NBIT_INT_NAME             "nbit_int"
 #define DSET_NBIT_FLOAT_NAME           "nbit_float"
 #define DSET_NBIT_DOUBLE_NAME          "nbit_double"
@@ -104,12 +121,14 @@ const char *FILENAME[] = {
 #define DSET_NBIT_COMPOUND_NAME_3      "nbit_compound_3"
 #define DSET_NBIT_INT_SIZE_NAME        "nbit_int_size"
 #define DSET_NBIT_FLT_SIZE_NAME        "nbit_flt_size"
+#define DSET_NBIT_WIDTHS_NAME          "nbit_widths"
 #define DSET_SCALEOFFSET_INT_NAME      "scaleoffset_int"
 #define DSET_SCALEOFFSET_INT_NAME_2    "scaleoffset_int_2"
 #define DSET_SCALEOFFSET_FLOAT_NAME    "scaleoffset_float"
 #define DSET_SCALEOFFSET_FLOAT_NAME_2  "scaleoffset_float_2"
 #define DSET_SCALEOFFSET_DOUBLE_NAME   "scaleoffset_double"
 #define DSET_SCALEOFFSET_DOUBLE_NAME_2 "scaleoffset_double_2"
+#define DSET_SCALEOFFSET_WIDTHS_NAME  "scaleoffset_widths"
 #define DSET_COMPARE_DCPL_NAME		"compare_dcpl"
 #define DSET_COMPARE_DCPL_NAME_2	"compare_dcpl_2"
 #define DSET_COPY_DCPL_NAME_1		"copy_dcpl_1"
@@ -232,6 +251,18 @@ const char *FILENAME[] = {
 #define STORAGE_SIZE_CHUNK_DIM1 5
 #define STORAGE_SIZE_CHUNK_DIM2 5
 
+/* Parameters for multi-threaded filter pipeline test */
+#define FILTER_NTHREADS_DIM1    190
+#define FILTER_NTHREADS_DIM2    125
+#define FILTER_NTHREADS_CHUNK1  20
+#define FILTER_NTHREADS_CHUNK2  10
+
+/* Parameters for chunk cache replacement policy test */
+#define CACHE_POLICY_CHUNK      100     /* Elements per chunk */
+#define CACHE_POLICY_NCHUNKS    64      /* Chunks in dataset */
+#define CACHE_POLICY_NCACHED    8       /* Chunks which fit in the cache */
+#define CACHE_POLICY_NHOT       4       /* Chunks accessed repeatedly */
+
 /* Shared global arrays */
 #define DSET_DIM1       100
 #define DSET_DIM2       200
@@ -2218,6 +2249,7 @@ H5_ATTR_UNUSED
 #endif /* H5_HAVE_FILTER_SZIP */
 
     hsize_t     shuffle_size;       /* Size of dataset with shuffle filter */
+    hsize_t     bitshuffle_lz_size; /* Size of dataset with bitshuffle+lz filter */
 
 #if(defined H5_HAVE_FILTER_DEFLATE | defined H5_HAVE_FILTER_SZIP)
     hsize_t     combo_size;     /* Size of dataset with multiple filters */
@@ -2357,6 +2389,20 @@ H5_ATTR_UNUSED
     /* Clean up objects used for this test */
     if(H5Pclose (dc) < 0) goto error;
 
+    /*----------------------------------------------------------
+     * STEP 4a: Test bitshuffle+lz by itself.
+     *----------------------------------------------------------
+     */
+    puts("Testing bitshuffle+lz filter");
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    if(H5Pset_chunk (dc, 2, chunk_size) < 0) goto error;
+    if(H5Pset_bitshuffle_lz (dc) < 0) goto error;
+
+    if(test_filter_internal(file,DSET_BITSHUFFLE_LZ_NAME,dc,DISABLE_FLETCHER32,DATA_NOT_CORRUPTED,&bitshuffle_lz_size) < 0) goto error;
+
+    /* Clean up objects used for this test */
+    if(H5Pclose (dc) < 0) goto error;
+
     /*----------------------------------------------------------
      * STEP 5: Test shuffle + deflate + checksum in any order.
      *----------------------------------------------------------
@@ -2455,6 +2501,218 @@ error:
     return -1;
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	test_deflate_streams
+ *
+ * Purpose:	Tests reading and writing the chunks of several datasets
+ *              compressed at different deflate levels in turn, so that the
+ *              zlib streams the filter keeps are reused for other datasets
+ *              and levels.
+ *
+ * Return:	Success:	0
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_deflate_streams(hid_t file)
+{
+#ifdef H5_HAVE_FILTER_DEFLATE
+    const unsigned      level[DSET_DEFLATE_STREAMS_NDSETS] = {1, 9, 6};
+    hid_t               dsid[DSET_DEFLATE_STREAMS_NDSETS] = {-1, -1, -1};
+    hid_t               dcpl = -1, sid = -1, mem_sid = -1;
+    hsize_t             dims = DSET_DEFLATE_STREAMS_NCHUNKS * DSET_DEFLATE_STREAMS_CHUNK;
+    hsize_t             chunk_dims = DSET_DEFLATE_STREAMS_CHUNK;
+    hsize_t             start, count = DSET_DEFLATE_STREAMS_CHUNK;
+    int                 *wbuf = NULL, *rbuf = NULL;
+    char                name[32];
+    size_t              i, c;
+    unsigned            u;
+
+    TESTING("deflate filter with many datasets and levels");
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * DSET_DEFLATE_STREAMS_NCHUNKS * DSET_DEFLATE_STREAMS_CHUNK)))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(sizeof(int) * DSET_DEFLATE_STREAMS_CHUNK)))
+        TEST_ERROR
+    for(i = 0; i < DSET_DEFLATE_STREAMS_NCHUNKS * DSET_DEFLATE_STREAMS_CHUNK; i++)
+        wbuf[i] = (int)(i / 7) + (HDrandom() % 4);
+
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) TEST_ERROR
+    if((mem_sid = H5Screate_simple(1, &count, NULL)) < 0) TEST_ERROR
+
+    /* Write the same data to each dataset, chunk by chunk, in turn */
+    for(u = 0; u < DSET_DEFLATE_STREAMS_NDSETS; u++) {
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+        if(H5Pset_chunk(dcpl, 1, &chunk_dims) < 0) TEST_ERROR
+        if(H5Pset_deflate(dcpl, level[u]) < 0) TEST_ERROR
+        HDsnprintf(name, sizeof(name), "%s_%u", DSET_DEFLATE_STREAMS_NAME, level[u]);
+        if((dsid[u] = H5Dcreate2(file, name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) TEST_ERROR
+        if(H5Pclose(dcpl) < 0) TEST_ERROR
+        dcpl = -1;
+    } /* end for */
+    for(c = 0; c < DSET_DEFLATE_STREAMS_NCHUNKS; c++)
+        for(u = 0; u < DSET_DEFLATE_STREAMS_NDSETS; u++) {
+            start = c * DSET_DEFLATE_STREAMS_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) TEST_ERROR
+            if(H5Dwrite(dsid[u], H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, wbuf + start) < 0) TEST_ERROR
+        } /* end for */
+
+    /* Flush the chunks to the file and read them back, in turn */
+    for(u = 0; u < DSET_DEFLATE_STREAMS_NDSETS; u++) {
+        if(H5Dclose(dsid[u]) < 0) TEST_ERROR
+        HDsnprintf(name, sizeof(name), "%s_%u", DSET_DEFLATE_STREAMS_NAME, level[u]);
+        if((dsid[u] = H5Dopen2(file, name, H5P_DEFAULT)) < 0) TEST_ERROR
+        if(H5Dget_storage_size(dsid[u]) >= dims * sizeof(int)) TEST_ERROR
+    } /* end for */
+    for(c = 0; c < DSET_DEFLATE_STREAMS_NCHUNKS; c++)
+        for(u = 0; u < DSET_DEFLATE_STREAMS_NDSETS; u++) {
+            start = c * DSET_DEFLATE_STREAMS_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) TEST_ERROR
+            if(H5Dread(dsid[u], H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, rbuf) < 0) TEST_ERROR
+            if(HDmemcmp(rbuf, wbuf + start, sizeof(int) * DSET_DEFLATE_STREAMS_CHUNK)) {
+                H5_FAILED();
+                printf("    Chunk %lu of level %u dataset read back wrong\n", (unsigned long)c, level[u]);
+                goto error;
+            } /* end if */
+        } /* end for */
+
+    for(u = 0; u < DSET_DEFLATE_STREAMS_NDSETS; u++)
+        if(H5Dclose(dsid[u]) < 0) TEST_ERROR
+    if(H5Sclose(mem_sid) < 0) TEST_ERROR
+    if(H5Sclose(sid) < 0) TEST_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        for(u = 0; u < DSET_DEFLATE_STREAMS_NDSETS; u++)
+            H5Dclose(dsid[u]);
+        H5Pclose(dcpl);
+        H5Sclose(mem_sid);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+#else /* H5_HAVE_FILTER_DEFLATE */
+    TESTING("deflate filter with many datasets and levels");
+    SKIPPED();
+    puts("    Deflate filter not enabled");
+    return 0;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+} /* end test_deflate_streams() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_bitshuffle_lz
+ *
+ * Purpose:	Tests the bitshuffle+lz filter with elements of several
+ *              sizes, a number of elements which isn't a multiple of
+ *              eight, and both smooth data, which must compress, and
+ *              random data, which the filter stores uncompressed.
+ *
+ * Return:	Success:	0
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_bitshuffle_lz(hid_t file)
+{
+    const size_t        elmt_size[] = {1, 2, 4, 8, 12};
+    hid_t               dsid = -1, dcpl = -1, sid = -1, tid = -1;
+    hsize_t             dims = DSET_BITSHUFFLE_LZ_NELMTS;
+    hsize_t             chunk_dims = DSET_BITSHUFFLE_LZ_CHUNK;
+    size_t              nbytes;
+    unsigned char       *wbuf = NULL, *rbuf = NULL;
+    char                name[64];
+    size_t              i, s;
+    int                 smooth;
+
+    TESTING("bitshuffle+lz filter with several element sizes");
+
+    nbytes = DSET_BITSHUFFLE_LZ_NELMTS * elmt_size[NELMTS(elmt_size) - 1];
+    if(NULL == (wbuf = (unsigned char *)HDmalloc(nbytes)))
+        TEST_ERROR
+    if(NULL == (rbuf = (unsigned char *)HDmalloc(nbytes)))
+        TEST_ERROR
+
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) TEST_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dims) < 0) TEST_ERROR
+    if(H5Pset_bitshuffle_lz(dcpl) < 0) TEST_ERROR
+
+    for(s = 0; s < NELMTS(elmt_size); s++)
+        for(smooth = 0; smooth < 2; smooth++) {
+            nbytes = DSET_BITSHUFFLE_LZ_NELMTS * elmt_size[s];
+
+            /* Slowly growing little-endian values, or noise */
+            for(i = 0; i < nbytes; i++) {
+                size_t elmt = i / elmt_size[s], byte = i % elmt_size[s];
+
+                if(smooth)
+                    wbuf[i] = (unsigned char)(byte < sizeof(size_t) ? ((elmt * 3) >> (8 * byte)) : 0);
+                else
+                    wbuf[i] = (unsigned char)HDrandom();
+            } /* end for */
+
+            if((tid = H5Tcreate(H5T_OPAQUE, elmt_size[s])) < 0) TEST_ERROR
+            HDsnprintf(name, sizeof(name), "%s_%lu_%s", DSET_BITSHUFFLE_LZ_SIZES_NAME, (unsigned long)elmt_size[s], smooth ? "smooth" : "random");
+            if((dsid = H5Dcreate2(file, name, tid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) TEST_ERROR
+            if(H5Dwrite(dsid, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) TEST_ERROR
+            if(H5Dclose(dsid) < 0) TEST_ERROR
+
+            /* Read the data back after the chunks have left the cache */
+            if((dsid = H5Dopen2(file, name, H5P_DEFAULT)) < 0) TEST_ERROR
+            HDmemset(rbuf, 0, nbytes);
+            if(H5Dread(dsid, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) TEST_ERROR
+            if(HDmemcmp(rbuf, wbuf, nbytes)) {
+                H5_FAILED();
+                printf("    Dataset %s read back wrong\n", name);
+                goto error;
+            } /* end if */
+            if(smooth && H5Dget_storage_size(dsid) >= nbytes) {
+                H5_FAILED();
+                printf("    Dataset %s didn't compress\n", name);
+                goto error;
+            } /* end if */
+            if(H5Dclose(dsid) < 0) TEST_ERROR
+            if(H5Tclose(tid) < 0) TEST_ERROR
+        } /* end for */
+
+    if(H5Pclose(dcpl) < 0) TEST_ERROR
+    if(H5Sclose(sid) < 0) TEST_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Tclose(tid);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_bitshuffle_lz() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:	test_missing_filter
@@ -2794,6 +3052,99 @@ error:
     return -1;
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	test_shuffle_kernels
+ *
+ * Purpose:	Tests that every byte shuffle kernel the CPU supports
+ *              produces exactly the layout of the shuffle filter's
+ *              format, and undoes it, for element sizes which are and
+ *              aren't handled by the vector kernels and for buffers with
+ *              partial blocks and leftover bytes.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_shuffle_kernels(void)
+{
+    const size_t        nelmts_list[] = {2, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000, 1027};
+    unsigned char       *orig = NULL;   /* Unshuffled data */
+    unsigned char       *expect = NULL; /* Expected shuffled data */
+    unsigned char       *shuf = NULL;   /* Shuffled data */
+    unsigned char       *unshuf = NULL; /* Unshuffled again */
+    size_t              max_nbytes = 1027 * 17 + 16;
+    unsigned            elmt_size;
+    size_t              n, i, j;
+    int                 kern;
+
+    TESTING("shuffle kernels");
+
+    if(NULL == (orig = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR
+    if(NULL == (expect = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR
+    if(NULL == (shuf = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR
+    if(NULL == (unshuf = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR
+    for(i = 0; i < max_nbytes; i++)
+        orig[i] = (unsigned char)HDrandom();
+
+    for(elmt_size = 1; elmt_size <= 17; elmt_size++)
+        for(n = 0; n < NELMTS(nelmts_list); n++) {
+            size_t nelmts = nelmts_list[n];
+            size_t nbytes = nelmts * elmt_size + nelmts % elmt_size;
+
+            /* Build the shuffled layout byte by byte */
+            for(i = 0; i < nelmts; i++)
+                for(j = 0; j < elmt_size; j++)
+                    expect[j * nelmts + i] = orig[i * elmt_size + j];
+            for(i = nelmts * elmt_size; i < nbytes; i++)
+                expect[i] = orig[i];
+
+            for(kern = H5Z_SHUFFLE_KERN_SCALAR; kern < H5Z_SHUFFLE_KERN_NKERNS; kern++) {
+                H5Z__shuffle_bytes((H5Z_shuffle_kern_t)kern, FALSE, elmt_size, nbytes, orig, shuf);
+                if(HDmemcmp(shuf, expect, nbytes)) {
+                    H5_FAILED();
+                    printf("    Kernel %d shuffled %lu elements of %u bytes wrong\n", kern, (unsigned long)nelmts, elmt_size);
+                    goto error;
+                } /* end if */
+
+                H5Z__shuffle_bytes((H5Z_shuffle_kern_t)kern, TRUE, elmt_size, nbytes, shuf, unshuf);
+                if(HDmemcmp(unshuf, orig, nbytes)) {
+                    H5_FAILED();
+                    printf("    Kernel %d unshuffled %lu elements of %u bytes wrong\n", kern, (unsigned long)nelmts, elmt_size);
+                    goto error;
+                } /* end if */
+            } /* end for */
+        } /* end for */
+
+    HDfree(orig);
+    HDfree(expect);
+    HDfree(shuf);
+    HDfree(unshuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    if(orig)
+        HDfree(orig);
+    if(expect)
+        HDfree(expect);
+    if(shuf)
+        HDfree(shuf);
+    if(unshuf)
+        HDfree(unshuf);
+    return -1;
+} /* end test_shuffle_kernels() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_nbit_int
@@ -4416,6 +4767,127 @@ error:
     return -1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:    test_nbit_widths
+ *
+ * Purpose:     Tests the nbit filter on integers of 1, 2, 4 and 8 bytes
+ *              in both byte orders, with precisions from 1 bit to one
+ *              bit short of the whole integer, including those of more
+ *              than 32 bits.  Checks the values read back and that the
+ *              packed chunk has the size the nbit format gives it.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_nbit_widths(hid_t file)
+{
+    const hid_t     base_types[4][2] = {
+            {H5T_STD_U8LE, H5T_STD_U8BE}, {H5T_STD_U16LE, H5T_STD_U16BE},
+            {H5T_STD_U32LE, H5T_STD_U32BE}, {H5T_STD_U64LE, H5T_STD_U64BE}};
+    const size_t    precisions[] = {1, 3, 7, 12, 17, 24, 31, 33, 45, 63};
+    hid_t           dataset = -1, datatype = -1, space = -1, dc = -1;
+    hsize_t         dims[1] = {1001};     /* (not a multiple of 8 values) */
+    unsigned long long *orig_data = NULL, *new_data = NULL;
+    hsize_t         storage_size;
+    size_t          size_index, order, prec_index;
+    size_t          u;
+
+    TESTING("    nbit integer widths");
+
+    if(NULL == (orig_data = (unsigned long long *)HDmalloc((size_t)dims[0] * sizeof(unsigned long long))))
+        TEST_ERROR
+    if(NULL == (new_data = (unsigned long long *)HDmalloc((size_t)dims[0] * sizeof(unsigned long long))))
+        TEST_ERROR
+
+    if((space = H5Screate_simple(1, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dc, 1, dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_nbit(dc) < 0) FAIL_STACK_ERROR
+
+    for(size_index = 0; size_index < 4; size_index++)
+        for(order = 0; order < 2; order++)
+            for(prec_index = 0; prec_index < NELMTS(precisions); prec_index++) {
+                size_t precision = precisions[prec_index];
+                size_t nbits = (size_t)8 << size_index;     /* Bits in the integer */
+                char name[64];
+
+                if(precision >= nbits)
+                    continue;
+
+                /* Create an integer of that precision, in the middle of its
+                 * bytes */
+                if((datatype = H5Tcopy(base_types[size_index][order])) < 0) FAIL_STACK_ERROR
+                if(H5Tset_precision(datatype, precision) < 0) FAIL_STACK_ERROR
+                if(H5Tset_offset(datatype, (nbits - precision) / 2) < 0) FAIL_STACK_ERROR
+
+                HDsnprintf(name, sizeof(name), "%s_%u_%s_%u", DSET_NBIT_WIDTHS_NAME,
+                        (unsigned)nbits, order ? "be" : "le", (unsigned)precision);
+                if((dataset = H5Dcreate2(file, name, datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+                    FAIL_STACK_ERROR
+
+                /* Values using all the bits of the precision, and both ends
+                 * of its range */
+                for(u = 0; u < (size_t)dims[0]; u++) {
+                    orig_data[u] = ((unsigned long long)HDrandom() << 32) ^ (unsigned long long)HDrandom()
+                            ^ ((unsigned long long)HDrandom() << 48);
+                    orig_data[u] &= (~0ULL >> (64 - precision));
+                } /* end for */
+                orig_data[0] = 0;
+                orig_data[1] = ~0ULL >> (64 - precision);
+
+                if(H5Dwrite(dataset, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
+                    FAIL_STACK_ERROR
+                if(H5Dread(dataset, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+                    FAIL_STACK_ERROR
+
+                for(u = 0; u < (size_t)dims[0]; u++)
+                    if(new_data[u] != orig_data[u]) {
+                        H5_FAILED();
+                        printf("    Read different values than written for %s.\n", name);
+                        printf("    At index %lu\n", (unsigned long)u);
+                        goto error;
+                    } /* end if */
+
+                /* The packed bits, with the last byte always whole */
+                if((storage_size = H5Dget_storage_size(dataset)) != (dims[0] * precision) / 8 + 1) {
+                    H5_FAILED();
+                    HDfprintf(stdout, "    Wrong storage size for %s: %Hu\n", name, storage_size);
+                    goto error;
+                } /* end if */
+
+                if(H5Dclose(dataset) < 0) FAIL_STACK_ERROR
+                dataset = -1;
+                if(H5Tclose(datatype) < 0) FAIL_STACK_ERROR
+                datatype = -1;
+            } /* end for */
+
+    if(H5Pclose(dc) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(space) < 0) FAIL_STACK_ERROR
+    HDfree(orig_data);
+    HDfree(new_data);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Tclose(datatype);
+        H5Pclose(dc);
+        H5Sclose(space);
+    } H5E_END_TRY;
+    if(orig_data)
+        HDfree(orig_data);
+    if(new_data)
+        HDfree(new_data);
+    return -1;
+} /* end test_nbit_widths() */
+
 /*-------------------------------------------------------------------------
  * Function:    test_scaleoffset_int
  *
@@ -5140,6 +5612,138 @@ error:
     return -1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:    test_scaleoffset_widths
+ *
+ * Purpose:     Tests the scaleoffset filter on signed and unsigned
+ *              integers of 1, 2, 4 and 8 bytes and on floats and doubles,
+ *              with and without a fill value.  The smallest and largest
+ *              values are put both early in the chunk and in its last few
+ *              values, and the size of the chunk written checks that the
+ *              filter found them (and skipped the fill values).
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_scaleoffset_widths(hid_t file)
+{
+    const struct {
+        hid_t   type;           /* Dataset datatype */
+        double  min, max;       /* Range of the values */
+    } cases[] = {
+        {H5T_NATIVE_UCHAR, 3, 100},         {H5T_NATIVE_SCHAR, -100, 20},
+        {H5T_NATIVE_USHORT, 1000, 9000},    {H5T_NATIVE_SHORT, -3000, 3000},
+        {H5T_NATIVE_UINT, 100000, 900000},  {H5T_NATIVE_INT, -70000, 5000},
+        {H5T_NATIVE_ULLONG, 5, 60000},      {H5T_NATIVE_LLONG, -2000000, 3},
+        {H5T_NATIVE_FLOAT, -5.0, 20.47},    {H5T_NATIVE_DOUBLE, -1000.5, 2.25}};
+    hid_t           dataset = -1, space = -1, dc = -1;
+    hsize_t         dims[1] = {1001};     /* (not a multiple of a vector) */
+    double          *orig_data = NULL, *new_data = NULL;
+    hsize_t         storage_size;
+    size_t          case_index, u;
+    int             with_fill;
+
+    TESTING("    scaleoffset widths");
+
+    if(NULL == (orig_data = (double *)HDmalloc((size_t)dims[0] * sizeof(double))))
+        TEST_ERROR
+    if(NULL == (new_data = (double *)HDmalloc((size_t)dims[0] * sizeof(double))))
+        TEST_ERROR
+
+    if((space = H5Screate_simple(1, dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    for(case_index = 0; case_index < NELMTS(cases); case_index++)
+        for(with_fill = 0; with_fill < 2; with_fill++) {
+            hbool_t is_float = (hbool_t)(H5Tget_class(cases[case_index].type) == H5T_FLOAT);
+            double  scale = is_float ? 100.0 : 1.0;     /* 10 ^ decimal scale factor */
+            double  fillval = cases[case_index].max + 7;
+            unsigned long long span;
+            unsigned minbits;
+            char    name[64];
+
+            if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+            if(H5Pset_chunk(dc, 1, dims) < 0) FAIL_STACK_ERROR
+            if(with_fill && H5Pset_fill_value(dc, H5T_NATIVE_DOUBLE, &fillval) < 0) FAIL_STACK_ERROR
+            if(is_float) {
+                if(H5Pset_scaleoffset(dc, H5Z_SO_FLOAT_DSCALE, 2) < 0) FAIL_STACK_ERROR
+            } /* end if */
+            else
+                if(H5Pset_scaleoffset(dc, H5Z_SO_INT, H5Z_SO_INT_MINBITS_DEFAULT) < 0) FAIL_STACK_ERROR
+
+            HDsnprintf(name, sizeof(name), "%s_%u_%d", DSET_SCALEOFFSET_WIDTHS_NAME,
+                    (unsigned)case_index, with_fill);
+            if((dataset = H5Dcreate2(file, name, cases[case_index].type, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+                FAIL_STACK_ERROR
+
+            /* Values inside the range (multiples of 1 / scale), the ends
+             * of the range early and in the last few values, and fill
+             * values here and there */
+            for(u = 0; u < (size_t)dims[0]; u++) {
+                orig_data[u] = cases[case_index].min + 1 + (double)(HDrandom() %
+                        (long)((cases[case_index].max - cases[case_index].min - 1) * scale)) / scale;
+                if(with_fill && u % 13 == 5)
+                    orig_data[u] = fillval;
+            } /* end for */
+            orig_data[with_fill ? 1 : 0] = cases[case_index].min;
+            orig_data[(size_t)dims[0] - 2] = cases[case_index].max;
+
+            if(H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
+                FAIL_STACK_ERROR
+            if(H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+                FAIL_STACK_ERROR
+
+            for(u = 0; u < (size_t)dims[0]; u++)
+                if(HDfabs(new_data[u] - orig_data[u]) > (is_float ? 0.6 / scale : 0.0)) {
+                    H5_FAILED();
+                    printf("    Read different values than written for %s.\n", name);
+                    printf("    At index %lu: %g instead of %g\n", (unsigned long)u, new_data[u], orig_data[u]);
+                    goto error;
+                } /* end if */
+
+            /* The fewest bits that hold the span of the values, and the
+             * fill value's code */
+            span = (unsigned long long)((cases[case_index].max - cases[case_index].min) * scale + 0.5) + 1;
+            if(with_fill)
+                span++;
+            for(minbits = 0; minbits < 64 && ((unsigned long long)1 << minbits) < span; minbits++)
+                ;
+            if((storage_size = H5Dget_storage_size(dataset)) != 21 + (dims[0] * minbits) / 8 + 1) {
+                H5_FAILED();
+                HDfprintf(stdout, "    Wrong storage size for %s: %Hu, not the %u-bit size\n", name, storage_size, minbits);
+                goto error;
+            } /* end if */
+
+            if(H5Dclose(dataset) < 0) FAIL_STACK_ERROR
+            dataset = -1;
+            if(H5Pclose(dc) < 0) FAIL_STACK_ERROR
+            dc = -1;
+        } /* end for */
+
+    if(H5Sclose(space) < 0) FAIL_STACK_ERROR
+    HDfree(orig_data);
+    HDfree(new_data);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Pclose(dc);
+        H5Sclose(space);
+    } H5E_END_TRY;
+    if(orig_data)
+        HDfree(orig_data);
+    if(new_data)
+        HDfree(new_data);
+    return -1;
+} /* end test_scaleoffset_widths() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	test_multiopen
@@ -10648,6 +11252,1285 @@ error:
     return -1;
 } /* end test_storage_size() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_filter_nthreads
+ *
+ * Purpose:     Tests reading filtered chunks with several threads running
+ *              the filter pipeline (H5Pset_filter_nthreads), including
+ *              partial edge chunks which bypass the filters, chunks which
+ *              are already in the chunk cache and missing chunks.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_filter_nthreads(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dxpl = -1;              /* Dataset transfer property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dims[2] = {FILTER_NTHREADS_DIM1, FILTER_NTHREADS_DIM2};    /* Dataset dimensions */
+    hsize_t     cdims[2] = {FILTER_NTHREADS_CHUNK1, FILTER_NTHREADS_CHUNK2}; /* Chunk dimensions */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    static int  wbuf[FILTER_NTHREADS_DIM1][FILTER_NTHREADS_DIM2];    /* Write buffer */
+    static int  rbuf[FILTER_NTHREADS_DIM1][FILTER_NTHREADS_DIM2];    /* Read buffer */
+    unsigned    nthreads;               /* # of filter threads */
+    unsigned    opts;                   /* Chunk options */
+    herr_t      ret;                    /* Generic return value */
+    int         i, j;                   /* Local index variables */
+
+    TESTING("reading filtered chunks with several threads");
+
+    h5_fixname(FILENAME[20], fapl, filename, sizeof filename);
+
+    /* Check the property's default value and argument checking */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_filter_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_filter_nthreads(dxpl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pset_filter_nthreads(dxpl, 4) < 0) FAIL_STACK_ERROR
+    if(H5Pget_filter_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 4) TEST_ERROR
+
+    /* Create the file & dataset, leaving the first row of chunks unwritten */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, cdims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_opts(dcpl, &opts) < 0) FAIL_STACK_ERROR
+    opts |= H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS;
+    if(H5Pset_chunk_opts(dcpl, opts) < 0) FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, DSET_CHUNKED_NAME, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+
+    for(i = 0; i < FILTER_NTHREADS_DIM1; i++)
+        for(j = 0; j < FILTER_NTHREADS_DIM2; j++)
+            wbuf[i][j] = (i < FILTER_NTHREADS_CHUNK1) ? 0 : (i * FILTER_NTHREADS_DIM2 + j) % 1000;
+    start[0] = FILTER_NTHREADS_CHUNK1;
+    start[1] = 0;
+    count[0] = FILTER_NTHREADS_DIM1 - FILTER_NTHREADS_CHUNK1;
+    count[1] = FILTER_NTHREADS_DIM2;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+
+    /* Re-open the dataset (with an empty chunk cache) */
+    if((did = H5Dopen2(fid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+    /* Read one chunk into the cache, then the whole dataset */
+    start[0] = start[1] = FILTER_NTHREADS_CHUNK1;
+    count[0] = count[1] = 1;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dread(did, H5T_NATIVE_INT, sid, sid, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0xff, sizeof(rbuf));
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < FILTER_NTHREADS_DIM1; i++)
+        for(j = 0; j < FILTER_NTHREADS_DIM2; j++)
+            if(rbuf[i][j] != wbuf[i][j]) {
+                H5_FAILED();
+                printf("    Read different values than written.\n");
+                printf("    At index %d,%d\n", i, j);
+                goto error;
+            } /* end if */
+
+    /* Read again with more threads than chunks in a batch */
+    if(H5Pset_filter_nthreads(dxpl, 64) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0xff, sizeof(rbuf));
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(rbuf, wbuf, sizeof(rbuf))) TEST_ERROR
+
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Sclose(sid);
+        H5Pclose(dcpl);
+        H5Pclose(dxpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_filter_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_cache_policy_read
+ *
+ * Purpose:     Helper for test_chunk_cache_policy: reads chunks FIRST
+ *              through LAST (inclusive) one at a time and verifies the
+ *              data.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_policy_read(hid_t did, int first, int last, int expect_offset)
+{
+    hid_t       sid = -1, mid = -1;     /* Dataspace IDs */
+    hsize_t     start, count = CACHE_POLICY_CHUNK;  /* Hyperslab selection */
+    int         rbuf[CACHE_POLICY_CHUNK];   /* Read buffer */
+    int         i, j;                   /* Local index variables */
+
+    if((sid = H5Dget_space(did)) < 0) TEST_ERROR
+    if((mid = H5Screate_simple(1, &count, NULL)) < 0) TEST_ERROR
+
+    for(i = first; i <= last; i++) {
+        start = (hsize_t)i * CACHE_POLICY_CHUNK;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) TEST_ERROR
+        if(H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0) TEST_ERROR
+        for(j = 0; j < CACHE_POLICY_CHUNK; j++)
+            if(rbuf[j] != (i * CACHE_POLICY_CHUNK) + j + expect_offset) {
+                printf("    Read different values than written in chunk %d.\n", i);
+                TEST_ERROR
+            } /* end if */
+    } /* end for */
+
+    if(H5Sclose(mid) < 0) TEST_ERROR
+    if(H5Sclose(sid) < 0) TEST_ERROR
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Sclose(mid);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_cache_policy_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_cache_policy
+ *
+ * Purpose:     Tests the 2Q chunk cache replacement policy: the property
+ *              itself, growing the slot table past its initial size,
+ *              flushing dirty chunks on preemption, and that a
+ *              frequently used set of chunks survives a scan over many
+ *              other chunks.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_policy(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1, dapl2 = -1;  /* Dataset access property list IDs */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim = CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK;   /* Dataset dimensions */
+    hsize_t     chunk_dim = CACHE_POLICY_CHUNK;     /* Chunk dimensions */
+    static int  wbuf[CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK];   /* Write buffer */
+    H5D_chunk_cache_policy_t policy;    /* Chunk cache policy */
+    herr_t      ret;                    /* Generic return value */
+    int         i;                      /* Local index variable */
+
+    TESTING("2Q chunk cache replacement policy");
+
+    h5_fixname(FILENAME[21], fapl, filename, sizeof filename);
+
+    /* Check the property's default value and argument checking */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_policy(dapl, &policy) < 0) FAIL_STACK_ERROR
+    if(policy != H5D_CHUNK_CACHE_LRU) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_cache_policy(dapl, H5D_CHUNK_CACHE_POLICY_ERROR);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pset_chunk_cache_policy(dapl, H5D_CHUNK_CACHE_2Q) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_policy(dapl, &policy) < 0) FAIL_STACK_ERROR
+    if(policy != H5D_CHUNK_CACHE_2Q) TEST_ERROR
+
+    /* Room for CACHE_POLICY_NCACHED chunks, starting with a single slot */
+    if(H5Pset_chunk_cache(dapl, (size_t)1, CACHE_POLICY_NCACHED * CACHE_POLICY_CHUNK * sizeof(int), 0.0F) < 0)
+        FAIL_STACK_ERROR
+
+    /* Create a 1-D dataset with a filter which counts the bytes read */
+    if(H5Zregister(H5Z_COUNT) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0, (size_t)0, NULL) < 0) FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+
+    /* The policy should be reported by the dataset */
+    if((dapl2 = H5Dget_access_plist(did)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_policy(dapl2, &policy) < 0) FAIL_STACK_ERROR
+    if(policy != H5D_CHUNK_CACHE_2Q) TEST_ERROR
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+
+    /* Write the whole dataset through the cache (many more chunks than fit) */
+    for(i = 0; i < CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK; i++)
+        wbuf[i] = i;
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(test_chunk_cache_policy_read(did, 0, CACHE_POLICY_NCHUNKS - 1, 0) < 0) TEST_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+
+    /* Read the hot chunks once, then enough other chunks to push them out
+     * of the 'A1in' queue, then the hot chunks again, which promotes them.
+     */
+    if((did = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+    if(test_chunk_cache_policy_read(did, 0, CACHE_POLICY_NHOT - 1, 0) < 0) TEST_ERROR
+    if(test_chunk_cache_policy_read(did, CACHE_POLICY_NHOT, CACHE_POLICY_NCACHED + CACHE_POLICY_NHOT - 1, 0) < 0) TEST_ERROR
+    if(test_chunk_cache_policy_read(did, 0, CACHE_POLICY_NHOT - 1, 0) < 0) TEST_ERROR
+
+    /* Scan all the chunks not touched yet once */
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did, CACHE_POLICY_NCACHED + CACHE_POLICY_NHOT, CACHE_POLICY_NCHUNKS - 1, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != (CACHE_POLICY_NCHUNKS - CACHE_POLICY_NCACHED - CACHE_POLICY_NHOT) * CACHE_POLICY_CHUNK * sizeof(int)) TEST_ERROR
+
+    /* The hot chunks should still be cached */
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did, 0, CACHE_POLICY_NHOT - 1, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != 0) TEST_ERROR
+
+    /* Modify every chunk, so dirty chunks are preempted from both queues */
+    for(i = 0; i < CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK; i++)
+        wbuf[i] = i + 1;
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+
+    /* Verify the data with the default cache */
+    if((did = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(test_chunk_cache_policy_read(did, 0, CACHE_POLICY_NCHUNKS - 1, 1) < 0) TEST_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(did);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_cache_policy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_shared_chunk_cache
+ *
+ * Purpose:     Tests the chunk cache shared by all the datasets in a file:
+ *              the property itself, that the chunks of all the datasets
+ *              stay within its size, even when none of them can be
+ *              preempted, and that dirty chunks of one dataset are
+ *              flushed correctly when preempted by another.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_shared_chunk_cache(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       my_fapl = -1, fapl2 = -1;   /* File access property list IDs */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       sid = -1, mid = -1;     /* Dataspace IDs */
+    hid_t       did_a = -1, did_b = -1, did_b2 = -1;    /* Dataset IDs */
+    hsize_t     dim = CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK;   /* Dataset dimensions */
+    hsize_t     chunk_dim = CACHE_POLICY_CHUNK;     /* Chunk dimensions */
+    hsize_t     start = 0;              /* Hyperslab selection */
+    static int  wbuf[CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK];   /* Write buffer */
+    size_t      nbytes;                 /* Size of shared cache */
+    int         i;                      /* Local index variable */
+
+    TESTING("chunk cache shared by the datasets in a file");
+
+    h5_fixname(FILENAME[22], fapl, filename, sizeof filename);
+
+    /* Room for CACHE_POLICY_NCACHED chunks, in all the datasets together */
+    if((my_fapl = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_shared_chunk_cache(my_fapl, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != 0) TEST_ERROR
+    if(H5Pset_shared_chunk_cache(my_fapl, CACHE_POLICY_NCACHED * CACHE_POLICY_CHUNK * sizeof(int)) < 0) FAIL_STACK_ERROR
+
+    /* Create two 1-D datasets with a filter which counts the bytes read */
+    if(H5Zregister(H5Z_COUNT) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0) FAIL_STACK_ERROR
+    if((fapl2 = H5Fget_access_plist(fid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_shared_chunk_cache(fapl2, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != CACHE_POLICY_NCACHED * CACHE_POLICY_CHUNK * sizeof(int)) TEST_ERROR
+    if(H5Pclose(fapl2) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0, (size_t)0, NULL) < 0) FAIL_STACK_ERROR
+    if((did_a = H5Dcreate2(fid, "dset_a", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((did_b = H5Dcreate2(fid, "dset_b", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+    /* Write both datasets, so the second one preempts dirty chunks of the first */
+    for(i = 0; i < CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK; i++)
+        wbuf[i] = i;
+    if(H5Dwrite(did_a, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK; i++)
+        wbuf[i] = i + 1;
+    if(H5Dwrite(did_b, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+    /* Reading chunks of the first dataset preempts the cached ones of the second */
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did_a, 0, CACHE_POLICY_NCACHED - 1, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != CACHE_POLICY_NCACHED * CACHE_POLICY_CHUNK * sizeof(int)) TEST_ERROR
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did_b, CACHE_POLICY_NCHUNKS - CACHE_POLICY_NCACHED, CACHE_POLICY_NCHUNKS - 1, 1) < 0) TEST_ERROR
+    if(count_nbytes_read != CACHE_POLICY_NCACHED * CACHE_POLICY_CHUNK * sizeof(int)) TEST_ERROR
+
+    /* Chunks of both datasets that fit together stay cached */
+    if(test_chunk_cache_policy_read(did_a, 0, CACHE_POLICY_NHOT - 1, 0) < 0) TEST_ERROR
+    if(test_chunk_cache_policy_read(did_b, 0, CACHE_POLICY_NHOT - 1, 1) < 0) TEST_ERROR
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did_a, 0, CACHE_POLICY_NHOT - 1, 0) < 0) TEST_ERROR
+    if(test_chunk_cache_policy_read(did_b, 0, CACHE_POLICY_NHOT - 1, 1) < 0) TEST_ERROR
+    if(count_nbytes_read != 0) TEST_ERROR
+
+    /* Dirty a chunk through a second handle for a dataset and close that
+     * handle, then read all the chunks of the other dataset.
+     */
+    if((did_b2 = H5Dopen2(fid, "dset_b", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(1, &chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &chunk_dim, NULL) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < CACHE_POLICY_CHUNK; i++)
+        wbuf[i] = i + 2;
+    if(H5Dwrite(did_b2, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(did_b2) < 0) FAIL_STACK_ERROR
+    if(test_chunk_cache_policy_read(did_a, 0, CACHE_POLICY_NCHUNKS - 1, 0) < 0) TEST_ERROR
+    if(test_chunk_cache_policy_read(did_b, 0, 0, 2) < 0) TEST_ERROR
+
+    /* Fill the cache with chunks read through a handle which is then closed,
+     * so that none of them can be preempted.  Chunks of the other dataset
+     * are then read without being cached, rather than going over the size.
+     */
+    if((did_b2 = H5Dopen2(fid, "dset_b", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(test_chunk_cache_policy_read(did_b2, 1, CACHE_POLICY_NCACHED, 1) < 0) TEST_ERROR
+    if(H5Dclose(did_b2) < 0) FAIL_STACK_ERROR
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did_a, 0, 0, 0) < 0) TEST_ERROR
+    if(test_chunk_cache_policy_read(did_a, 0, 0, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != 2 * CACHE_POLICY_CHUNK * sizeof(int)) TEST_ERROR
+
+    if(H5Dclose(did_a) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(did_b) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Verify the data with the default cache */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    if((did_a = H5Dopen2(fid, "dset_a", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((did_b = H5Dopen2(fid, "dset_b", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(test_chunk_cache_policy_read(did_a, 0, CACHE_POLICY_NCHUNKS - 1, 0) < 0) TEST_ERROR
+    if(test_chunk_cache_policy_read(did_b, 0, 0, 2) < 0) TEST_ERROR
+    if(test_chunk_cache_policy_read(did_b, 1, CACHE_POLICY_NCHUNKS - 1, 1) < 0) TEST_ERROR
+    if(H5Dclose(did_a) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(did_b) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl2);
+        H5Pclose(my_fapl);
+        H5Pclose(dcpl);
+        H5Dclose(did_a);
+        H5Dclose(did_b);
+        H5Dclose(did_b2);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_shared_chunk_cache() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_read_ahead
+ *
+ * Purpose:     Tests reading chunks ahead of sequential reads: the
+ *              property itself, that the chunks following a sequential
+ *              read are loaded into the cache in advance (and only
+ *              once), and that reads out of sequence don't trigger it.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_read_ahead(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1, dapl2 = -1;  /* Dataset access property list IDs */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim = CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK;   /* Dataset dimensions */
+    hsize_t     chunk_dim = CACHE_POLICY_CHUNK;     /* Chunk dimensions */
+    static int  wbuf[CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK];   /* Write buffer */
+    const size_t chunk_nbytes = CACHE_POLICY_CHUNK * sizeof(int);  /* Size of a chunk */
+    unsigned    nchunks;                /* # of chunks to read ahead */
+    int         i;                      /* Local index variable */
+
+    TESTING("reading chunks ahead of sequential reads");
+
+    h5_fixname(FILENAME[23], fapl, filename, sizeof filename);
+
+    /* Check the property's default value */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_ahead(dapl, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != 0) TEST_ERROR
+
+    /* Read ahead up to CACHE_POLICY_NHOT chunks, with room for
+     * CACHE_POLICY_NCACHED chunks in the cache
+     */
+    if(H5Pset_chunk_read_ahead(dapl, CACHE_POLICY_NHOT) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, CACHE_POLICY_NCACHED * chunk_nbytes, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+
+    /* Create a 1-D dataset with a filter which counts the bytes read */
+    if(H5Zregister(H5Z_COUNT) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0, (size_t)0, NULL) < 0) FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK; i++)
+        wbuf[i] = i;
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+
+    /* The setting should be reported by the dataset */
+    if((did = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+    if((dapl2 = H5Dget_access_plist(did)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_ahead(dapl2, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != CACHE_POLICY_NHOT) TEST_ERROR
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+
+    /* The second chunk in sequence brings in the next CACHE_POLICY_NHOT */
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did, 0, 0, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != chunk_nbytes) TEST_ERROR
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did, 1, 1, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != (CACHE_POLICY_NHOT + 1) * chunk_nbytes) TEST_ERROR
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did, 2, CACHE_POLICY_NHOT / 2 + 1, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != 0) TEST_ERROR
+
+    /* The remaining chunks are each read exactly once while scanning on */
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did, CACHE_POLICY_NHOT / 2 + 2, CACHE_POLICY_NCHUNKS - 1, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != (CACHE_POLICY_NCHUNKS - CACHE_POLICY_NHOT - 2) * chunk_nbytes) TEST_ERROR
+
+    /* Reads out of sequence don't read ahead, until a new run starts */
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did, CACHE_POLICY_NCHUNKS / 4, CACHE_POLICY_NCHUNKS / 4, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != chunk_nbytes) TEST_ERROR
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did, 0, 0, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != chunk_nbytes) TEST_ERROR
+    count_nbytes_read = 0;
+    if(test_chunk_cache_policy_read(did, 1, 1, 0) < 0) TEST_ERROR
+    if(count_nbytes_read != (CACHE_POLICY_NHOT + 1) * chunk_nbytes) TEST_ERROR
+
+    /* Reading the whole dataset at once is a sequential read too */
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK; i++)
+        if(wbuf[i] != i) TEST_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(did);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_iter_cb
+ *
+ * Purpose:     Callback for test_chunk_iter: count the chunks visited and
+ *              stop after the number given in op_data.
+ *
+ * Return:      Success: 0, or 1 to stop the iteration
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_chunk_iter_cb(const hsize_t H5_ATTR_UNUSED *offset, unsigned H5_ATTR_UNUSED filter_mask,
+    haddr_t H5_ATTR_UNUSED addr, hsize_t H5_ATTR_UNUSED nbytes, void *op_data)
+{
+    unsigned *nleft = (unsigned *)op_data;
+
+    return(--(*nleft) == 0 ? 1 : 0);
+} /* end test_chunk_iter_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_iter
+ *
+ * Purpose:     Tests H5Dget_num_chunks, H5Dget_chunk_info_all and
+ *              H5Dchunk_iter on a partially written chunked dataset,
+ *              including chunks which are still dirty in the chunk cache.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define CHUNK_ITER_DIM          8
+#define CHUNK_ITER_CHUNK        2
+#define CHUNK_ITER_NWRITTEN     5
+static herr_t
+test_chunk_iter(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       mid = -1;               /* Memory dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hid_t       did2 = -1;              /* Contiguous dataset ID */
+    const hsize_t dims[2] = {CHUNK_ITER_DIM, CHUNK_ITER_DIM};  /* Dataset dimensions */
+    const hsize_t max_dims[2] = {H5S_UNLIMITED, H5S_UNLIMITED};   /* Maximum dataset dimensions */
+    const hsize_t chunk_dims[2] = {CHUNK_ITER_CHUNK, CHUNK_ITER_CHUNK};    /* Chunk dimensions */
+    const hsize_t written[CHUNK_ITER_NWRITTEN][2] = {{0, 0}, {0, 6}, {2, 2}, {4, 4}, {6, 6}};   /* Chunks written */
+    hsize_t     offsets[CHUNK_ITER_NWRITTEN][2];    /* Chunk offsets */
+    unsigned    filter_masks[CHUNK_ITER_NWRITTEN];  /* Chunk filter masks */
+    haddr_t     addrs[CHUNK_ITER_NWRITTEN];         /* Chunk addresses */
+    hsize_t     nbytes[CHUNK_ITER_NWRITTEN];        /* Chunk sizes */
+    hsize_t     chunk_nbytes;           /* Size of a chunk */
+    hsize_t     num_chunks;             /* # of chunks allocated */
+    size_t      nchunks;                /* # of chunks returned */
+    unsigned    nleft;                  /* # of chunks left to visit */
+    int         wbuf[CHUNK_ITER_CHUNK * CHUNK_ITER_CHUNK];  /* Write buffer */
+    herr_t      ret;                    /* Generic return value */
+    unsigned    u, v;                   /* Local index variables */
+
+    TESTING("iterating over the chunks of a dataset");
+
+    h5_fixname(FILENAME[24], fapl, filename, sizeof filename);
+
+    /* Create a chunked dataset, with a chunk index which supports iteration
+     * for each file format
+     */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, max_dims)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(2, chunk_dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+
+    /* Nothing is allocated yet */
+    if(H5Dget_num_chunks(did, &num_chunks) < 0) FAIL_STACK_ERROR
+    if(num_chunks != 0) TEST_ERROR
+    if(H5Dget_chunk_info_all(did, (size_t)CHUNK_ITER_NWRITTEN, &offsets[0][0], filter_masks, addrs, nbytes, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != 0) TEST_ERROR
+
+    /* Write some of the chunks, leaving them dirty in the chunk cache */
+    for(u = 0; u < CHUNK_ITER_CHUNK * CHUNK_ITER_CHUNK; u++)
+        wbuf[u] = (int)u;
+    for(u = 0; u < CHUNK_ITER_NWRITTEN; u++) {
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, written[u], NULL, chunk_dims, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* The written chunks are counted */
+    if(H5Dget_num_chunks(did, &num_chunks) < 0) FAIL_STACK_ERROR
+    if(num_chunks != CHUNK_ITER_NWRITTEN) TEST_ERROR
+
+    /* Each written chunk is reported once, matching its stored size */
+    if(H5Dget_chunk_info_all(did, (size_t)CHUNK_ITER_NWRITTEN, &offsets[0][0], filter_masks, addrs, nbytes, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != CHUNK_ITER_NWRITTEN) TEST_ERROR
+    for(u = 0; u < CHUNK_ITER_NWRITTEN; u++) {
+        for(v = 0; v < CHUNK_ITER_NWRITTEN; v++)
+            if(offsets[v][0] == written[u][0] && offsets[v][1] == written[u][1])
+                break;
+        if(v == CHUNK_ITER_NWRITTEN) TEST_ERROR
+        if(filter_masks[v] != 0) TEST_ERROR
+        if(addrs[v] == HADDR_UNDEF) TEST_ERROR
+        if(H5Dget_chunk_storage_size(did, offsets[v], &chunk_nbytes) < 0) FAIL_STACK_ERROR
+        if(nbytes[v] != chunk_nbytes) TEST_ERROR
+        if(nbytes[v] != CHUNK_ITER_CHUNK * CHUNK_ITER_CHUNK * sizeof(int)) TEST_ERROR
+    } /* end for */
+    for(u = 0; u < CHUNK_ITER_NWRITTEN; u++)
+        for(v = 0; v < u; v++)
+            if(addrs[v] == addrs[u]) TEST_ERROR
+
+    /* Only as many chunks as the arrays hold are returned, and the arrays
+     * are optional
+     */
+    if(H5Dget_chunk_info_all(did, (size_t)2, NULL, NULL, addrs, NULL, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != 2) TEST_ERROR
+
+    /* The operator can stop the iteration early */
+    nleft = 3;
+    if((ret = H5Dchunk_iter(did, test_chunk_iter_cb, &nleft)) != 1) TEST_ERROR
+    if(nleft != 0) TEST_ERROR
+    nleft = CHUNK_ITER_NWRITTEN + 1;
+    if((ret = H5Dchunk_iter(did, test_chunk_iter_cb, &nleft)) != 0) TEST_ERROR
+    if(nleft != 1) TEST_ERROR
+
+    /* The routines only apply to chunked datasets */
+    if((did2 = H5Dcreate2(fid, "contig", H5T_NATIVE_INT, mid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dget_num_chunks(did2, &num_chunks);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dchunk_iter(did2, test_chunk_iter_cb, &nleft);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Dclose(did2) < 0) FAIL_STACK_ERROR
+
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(did2);
+        H5Dclose(did);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_iter() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_flush_sorted
+ *
+ * Purpose:     Tests writing back dirty chunks in address order, with
+ *              H5Pset_chunk_flush_sorted.  Chunks written in reverse
+ *              order should be allocated in chunk index order when the
+ *              dataset is flushed, and the data should survive flushes
+ *              caused by preempting chunks from a small cache, with and
+ *              without a filter.  Preempting chunks should only write
+ *              back those chunks.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_flush_sorted(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1, dapl2 = -1;  /* Dataset access property list IDs */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       mid = -1;               /* Memory dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim = CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK;   /* Dataset dimensions */
+    hsize_t     chunk_dim = CACHE_POLICY_CHUNK;     /* Chunk dimensions */
+    hsize_t     start;                  /* Start of hyperslab selection */
+    hsize_t     offsets[CACHE_POLICY_NCHUNKS];      /* Chunk offsets */
+    haddr_t     addrs[CACHE_POLICY_NCHUNKS];        /* Chunk addresses, by chunk */
+    haddr_t     addr;                   /* Chunk address */
+    size_t      nchunks;                /* # of chunks allocated */
+    static int  buf[CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK];    /* Data buffer */
+    hbool_t     sorted;                 /* Property value */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    const char  *dset_name[2] = {"dset", "dset_filtered"};  /* Dataset names */
+    int         d, i, j;                /* Local index variables */
+
+    TESTING("writing back dirty chunks in address order");
+
+    h5_fixname(FILENAME[25], fapl, filename, sizeof filename);
+
+    /* Check the property's default value */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_flush_sorted(dapl, &sorted) < 0) FAIL_STACK_ERROR
+    if(sorted) TEST_ERROR
+    if(H5Pset_chunk_flush_sorted(dapl, TRUE) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+
+    if(H5Zregister(H5Z_COUNT) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(1, &chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+
+    /* Write all the chunks of a dataset into its cache in reverse order */
+    if((did = H5Dcreate2(fid, dset_name[0], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+    if((dapl2 = H5Dget_access_plist(did)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_flush_sorted(dapl2, &sorted) < 0) FAIL_STACK_ERROR
+    if(!sorted) TEST_ERROR
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+    for(i = CACHE_POLICY_NCHUNKS - 1; i >= 0; i--) {
+        for(j = 0; j < CACHE_POLICY_CHUNK; j++)
+            buf[j] = (i * CACHE_POLICY_CHUNK) + j;
+        start = (hsize_t)i * CACHE_POLICY_CHUNK;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &chunk_dim, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* After flushing, the chunks' addresses increase with their offsets */
+    if(H5Dflush(did) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_info_all(did, (size_t)CACHE_POLICY_NCHUNKS, offsets, NULL, addrs, NULL, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != CACHE_POLICY_NCHUNKS) TEST_ERROR
+    for(i = 0; i < CACHE_POLICY_NCHUNKS; i++)
+        for(j = i + 1; j < CACHE_POLICY_NCHUNKS; j++)
+            if(offsets[j] < offsets[i]) {
+                start = offsets[i]; offsets[i] = offsets[j]; offsets[j] = start;
+                addr = addrs[i]; addrs[i] = addrs[j]; addrs[j] = addr;
+            } /* end if */
+    for(i = 1; i < CACHE_POLICY_NCHUNKS; i++)
+        if(addrs[i] <= addrs[i - 1]) TEST_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+
+    /* Write datasets in reverse order through a cache with room for only a
+     * few chunks, without and with a filter
+     */
+    if(H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, CACHE_POLICY_NCACHED * CACHE_POLICY_CHUNK * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0, (size_t)0, NULL) < 0) FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, dset_name[1], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    for(d = 0; d < 2; d++) {
+        if((did = H5Dopen2(fid, dset_name[d], dapl)) < 0) FAIL_STACK_ERROR
+        for(i = CACHE_POLICY_NCHUNKS - 1; i >= 0; i--) {
+            for(j = 0; j < CACHE_POLICY_CHUNK; j++)
+                buf[j] = (i * CACHE_POLICY_CHUNK) + j + d;
+            start = (hsize_t)i * CACHE_POLICY_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &chunk_dim, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+        } /* end for */
+        if(H5Dget_chunk_cache_stats(did, &stats) < 0) FAIL_STACK_ERROR
+        if(stats.nflushes != CACHE_POLICY_NCHUNKS - CACHE_POLICY_NCACHED) TEST_ERROR
+        if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Check the data */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    for(d = 0; d < 2; d++) {
+        if((did = H5Dopen2(fid, dset_name[d], H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < CACHE_POLICY_NCHUNKS * CACHE_POLICY_CHUNK; i++)
+            if(buf[i] != i + d) TEST_ERROR
+        if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(did);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_flush_sorted() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_sparse_read
+ *
+ * Purpose:     Tests reading the fill value from chunks which were never
+ *              written, around and across a written chunk, with and
+ *              without datatype conversion, for a user-defined fill
+ *              value, the default fill value and no fill value.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define SPARSE_DIM      100
+#define SPARSE_CHUNK    10
+#define SPARSE_FILL     7
+static herr_t
+test_sparse_read(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       mid = -1;               /* Memory dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    const hsize_t dims[2] = {SPARSE_DIM, SPARSE_DIM};   /* Dataset dimensions */
+    const hsize_t chunk_dims[2] = {SPARSE_CHUNK, SPARSE_CHUNK};    /* Chunk dimensions */
+    const hsize_t wstart[2] = {20, 30};         /* Start of the written chunk */
+    const hsize_t rstart[2] = {15, 25};         /* Start of the region read */
+    const hsize_t rcount[2] = {30, 30};         /* Size of the region read */
+    const hsize_t mdims[2] = {40, 40};          /* Memory buffer dimensions */
+    const hsize_t mstart[2] = {5, 5};           /* Start of the region in memory */
+    int         fill = SPARSE_FILL;     /* Fill value */
+    int         wbuf[SPARSE_CHUNK][SPARSE_CHUNK];   /* Written chunk */
+    static int  ibuf[SPARSE_DIM][SPARSE_DIM];   /* Read buffer */
+    static double dbuf[40][40];         /* Read buffer for converted data */
+    const char  *dset_name[3] = {"user_fill", "default_fill", "no_fill"};  /* Dataset names */
+    int         expect_fill;            /* Fill value expected */
+    int         d, i, j;                /* Local index variables */
+
+    TESTING("reading unwritten chunks");
+
+    h5_fixname(FILENAME[26], fapl, filename, sizeof filename);
+
+    /* Keep the written chunk in the chunk cache */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < SPARSE_CHUNK; i++)
+        for(j = 0; j < SPARSE_CHUNK; j++)
+            wbuf[i][j] = 1000 + (i * SPARSE_CHUNK) + j;
+
+    for(d = 0; d < 3; d++) {
+        /* Create the dataset */
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+        if(0 == d) {
+            if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+            expect_fill = SPARSE_FILL;
+        } /* end if */
+        else {
+            if(2 == d && H5Pset_fill_time(dcpl, H5D_FILL_TIME_NEVER) < 0) FAIL_STACK_ERROR
+            expect_fill = 0;
+        } /* end else */
+        if((did = H5Dcreate2(fid, dset_name[d], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+        if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+
+        /* Read the whole dataset before anything is written */
+        for(i = 0; i < SPARSE_DIM; i++)
+            for(j = 0; j < SPARSE_DIM; j++)
+                ibuf[i][j] = -1;
+        if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, ibuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < SPARSE_DIM; i++)
+            for(j = 0; j < SPARSE_DIM; j++)
+                if(ibuf[i][j] != (2 == d ? -1 : expect_fill)) TEST_ERROR
+
+        /* Write one chunk */
+        if((mid = H5Screate_simple(2, chunk_dims, NULL)) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, wstart, NULL, chunk_dims, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+
+        /* Read a region around the chunk into the middle of a larger buffer,
+         * converting the data
+         */
+        if((mid = H5Screate_simple(2, mdims, NULL)) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_hyperslab(mid, H5S_SELECT_SET, mstart, NULL, rcount, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, rstart, NULL, rcount, NULL) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 40; i++)
+            for(j = 0; j < 40; j++)
+                dbuf[i][j] = -1.0;
+        if(H5Dread(did, H5T_NATIVE_DOUBLE, mid, sid, H5P_DEFAULT, dbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 40; i++)
+            for(j = 0; j < 40; j++) {
+                double expect = -1.0;           /* Expected value */
+
+                if(i >= 5 && i < 35 && j >= 5 && j < 35) {
+                    int row = i - 5 + 15, col = j - 5 + 25;     /* Position in dataset */
+
+                    if(row >= 20 && row < 30 && col >= 30 && col < 40)
+                        expect = (double)wbuf[row - 20][col - 30];
+                    else if(2 != d)
+                        expect = (double)expect_fill;
+                } /* end if */
+                if(!H5_DBL_ABS_EQUAL(dbuf[i][j], expect)) TEST_ERROR
+            } /* end for */
+        if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+        if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(did);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_sparse_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_cache_stats
+ *
+ * Purpose:     Tests the chunk cache statistics of a dataset, resetting
+ *              them and the chunk cache parameters recommended from them.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define CACHE_STATS_CHUNK       100
+#define CACHE_STATS_NCHUNKS     64
+#define CACHE_STATS_NSLOTS      7
+static herr_t
+test_chunk_cache_stats(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       mid = -1;               /* Memory dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hid_t       cdid = -1;              /* Contiguous dataset ID */
+    const hsize_t dims[1] = {CACHE_STATS_CHUNK * CACHE_STATS_NCHUNKS};  /* Dataset dimensions */
+    const hsize_t chunk_dims[1] = {CACHE_STATS_CHUNK};  /* Chunk dimensions */
+    hsize_t     start[1], count[1];     /* Hyperslab selection */
+    static int  buf[CACHE_STATS_CHUNK * CACHE_STATS_NCHUNKS];   /* Data buffer */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    size_t      nslots, nbytes;         /* Recommended cache parameters */
+    herr_t      ret;                    /* Generic return value */
+    int         i;                      /* Local index variable */
+
+    TESTING("chunk cache statistics");
+
+    h5_fixname(FILENAME[27], fapl, filename, sizeof filename);
+
+    /* Cache up to four (filtered) chunks in a few hash slots */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)CACHE_STATS_NSLOTS, 4 * CACHE_STATS_CHUNK * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+
+    /* Create and write the datasets */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < CACHE_STATS_CHUNK * CACHE_STATS_NCHUNKS; i++)
+        buf[i] = i;
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    if((cdid = H5Dcreate2(fid, "contig", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+    /* Statistics are only kept for chunked datasets */
+    H5E_BEGIN_TRY {
+        ret = H5Dget_chunk_cache_stats(cdid, &stats);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dget_chunk_cache_advice(cdid, &nslots, &nbytes);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Dclose(cdid) < 0) FAIL_STACK_ERROR
+
+    /* The statistics of a newly opened dataset are empty */
+    if((did = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nhits != 0 || stats.nmisses != 0 || stats.ninits != 0
+            || stats.nevictions != 0 || stats.ncollisions != 0
+            || stats.nflushes != 0 || stats.nbytes_read != 0
+            || stats.nbytes_decoded != 0 || stats.max_sel_chunks != 0)
+        TEST_ERROR
+
+    /* Read the first chunk twice: one miss, then one hit */
+    if((mid = H5Screate_simple(1, chunk_dims, NULL)) < 0) FAIL_STACK_ERROR
+    start[0] = 0;
+    count[0] = CACHE_STATS_CHUNK;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 2; i++)
+        if(H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nmisses != 1 || stats.nhits != 1 || stats.nevictions != 0) TEST_ERROR
+    if(stats.nbytes_read == 0 || stats.nbytes_decoded != CACHE_STATS_CHUNK * sizeof(int)) TEST_ERROR
+    if(stats.max_sel_chunks != 1) TEST_ERROR
+
+    /* Read the chunk which hashes to the same slot */
+    start[0] = CACHE_STATS_NSLOTS * CACHE_STATS_CHUNK;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nmisses != 2 || stats.ncollisions != 1 || stats.nevictions != 1) TEST_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+
+    /* Read ten chunks at once, more than the cache holds */
+    start[0] = 0;
+    count[0] = 10 * CACHE_STATS_CHUNK;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(1, count, NULL)) < 0) FAIL_STACK_ERROR
+    if(H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 10 * CACHE_STATS_CHUNK; i++)
+        if(buf[i] != i) TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.max_sel_chunks != 10) TEST_ERROR
+    if(stats.nevictions <= stats.ncollisions) TEST_ERROR
+
+    /* The advice is to cache all ten chunks, in a prime number of slots */
+    if(H5Dget_chunk_cache_advice(did, &nslots, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != 10 * CACHE_STATS_CHUNK * sizeof(int)) TEST_ERROR
+    if(nslots != 1009) TEST_ERROR
+
+    /* Reset the statistics */
+    if(H5Dreset_chunk_cache_stats(did) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nhits != 0 || stats.nmisses != 0 || stats.nevictions != 0
+            || stats.ncollisions != 0 || stats.nbytes_read != 0
+            || stats.max_sel_chunks != 0)
+        TEST_ERROR
+    if(H5Dget_chunk_cache_advice(did, &nslots, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != CACHE_STATS_CHUNK * sizeof(int) || nslots != 101) TEST_ERROR
+
+    /* Modify the data and write it back */
+    if(H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    if(H5Dflush(did) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nflushes == 0) TEST_ERROR
+
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(cdid);
+        H5Dclose(did);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_cache_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_store_raw
+ *
+ * Purpose:     Tests storing incompressible chunks unfiltered
+ *              (H5Pset_chunk_store_raw), with and without a fletcher32
+ *              checksum after the compression filter.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define STORE_RAW_CHUNK         1024
+#define STORE_RAW_NCHUNKS       64
+#define STORE_RAW_RATIO         0.9
+static herr_t
+test_chunk_store_raw(hid_t fapl)
+{
+#ifdef H5_HAVE_FILTER_DEFLATE
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    const hsize_t dims[1] = {STORE_RAW_CHUNK * STORE_RAW_NCHUNKS};  /* Dataset dimensions */
+    const hsize_t chunk_dims[1] = {STORE_RAW_CHUNK};  /* Chunk dimensions */
+    static int  wbuf[STORE_RAW_CHUNK * STORE_RAW_NCHUNKS];  /* Data written */
+    static int  rbuf[STORE_RAW_CHUNK * STORE_RAW_NCHUNKS];  /* Data read */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    hsize_t     storage_size;           /* Dataset's storage size */
+    double      ratio;                  /* Store-raw ratio */
+    const char  *dset_name[2] = {"deflate", "deflate_fletcher32"};
+    herr_t      ret;                    /* Generic return value */
+    int         i, n;                   /* Local index variables */
+
+    TESTING("storing incompressible chunks raw");
+
+    h5_fixname(FILENAME[28], fapl, filename, sizeof filename);
+
+    /* Check the property */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_store_raw(dcpl, &ratio) < 0) FAIL_STACK_ERROR
+    if(ratio != 0.0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_store_raw(dcpl, -0.5);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_store_raw(dcpl, 1.5);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pset_chunk_store_raw(dcpl, STORE_RAW_RATIO) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_store_raw(dcpl, &ratio) < 0) FAIL_STACK_ERROR
+    if(ratio != STORE_RAW_RATIO) TEST_ERROR
+
+    /* Half the chunks are random, half compress well */
+    for(i = 0; i < STORE_RAW_CHUNK * STORE_RAW_NCHUNKS / 2; i++)
+        wbuf[i] = (int)HDrandom();
+    for(; i < STORE_RAW_CHUNK * STORE_RAW_NCHUNKS; i++)
+        wbuf[i] = i % 7;
+
+    /* Create and write the datasets */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+    for(n = 0; n < 2; n++) {
+        if(n == 1)
+            if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+        if((did = H5Dcreate2(fid, dset_name[n], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dflush(did) < 0) FAIL_STACK_ERROR
+
+        /* All the random chunks are stored raw, some without trying to
+         * compress them, and some of the others are compressed
+         */
+        if(H5Dget_chunk_cache_stats(did, &stats) < 0) FAIL_STACK_ERROR
+        if(stats.nraw < STORE_RAW_NCHUNKS / 2 || stats.nraw >= STORE_RAW_NCHUNKS) TEST_ERROR
+        if(stats.nraw_untried == 0 || stats.nraw_untried >= stats.nraw) TEST_ERROR
+        storage_size = H5Dget_storage_size(did);
+        if(storage_size <= (hsize_t)(STORE_RAW_NCHUNKS / 2) * STORE_RAW_CHUNK * sizeof(int)
+                || storage_size >= (hsize_t)STORE_RAW_NCHUNKS * STORE_RAW_CHUNK * sizeof(int))
+            TEST_ERROR
+        if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Read the data back */
+    if((fid = H5Fopen(filename, H5F_ACC_RDWR, fapl)) < 0) FAIL_STACK_ERROR
+    for(n = 0; n < 2; n++) {
+        if((did = H5Dopen2(fid, dset_name[n], H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, sizeof(rbuf));
+        if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < STORE_RAW_CHUNK * STORE_RAW_NCHUNKS; i++)
+            if(rbuf[i] != wbuf[i]) TEST_ERROR
+
+        /* The ratio isn't stored in the file: rewriting the chunks of the
+         * reopened dataset compresses them all
+         */
+        if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dflush(did) < 0) FAIL_STACK_ERROR
+        if(H5Dget_chunk_cache_stats(did, &stats) < 0) FAIL_STACK_ERROR
+        if(stats.nflushes != STORE_RAW_NCHUNKS || stats.nraw != 0) TEST_ERROR
+        if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Dclose(did);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+#else /* H5_HAVE_FILTER_DEFLATE */
+    TESTING("storing incompressible chunks raw");
+    SKIPPED();
+    puts("    Deflate filter not enabled");
+    return 0;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+} /* end test_chunk_store_raw() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_scatter
@@ -12030,7 +13913,10 @@ main(void)
         nerrors += (test_conv_buffer(file) < 0		        ? 1 : 0);
         nerrors += (test_tconv(file) < 0			? 1 : 0);
         nerrors += (test_filters(file, my_fapl) < 0		? 1 : 0);
+        nerrors += (test_deflate_streams(file) < 0		? 1 : 0);
+        nerrors += (test_bitshuffle_lz(file) < 0		? 1 : 0);
         nerrors += (test_onebyte_shuffle(file) < 0 		? 1 : 0);
+        nerrors += (test_shuffle_kernels() < 0 		        ? 1 : 0);
         nerrors += (test_nbit_int(file) < 0 		        ? 1 : 0);
         nerrors += (test_nbit_float(file) < 0         	        ? 1 : 0);
         nerrors += (test_nbit_double(file) < 0         	        ? 1 : 0);
@@ -12040,12 +13926,14 @@ main(void)
         nerrors += (test_nbit_compound_3(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_int_size(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_flt_size(file) < 0 		? 1 : 0);
+        nerrors += (test_nbit_widths(file) < 0 		        ? 1 : 0);
         nerrors += (test_scaleoffset_int(file) < 0 		? 1 : 0);
         nerrors += (test_scaleoffset_int_2(file) < 0 	        ? 1 : 0);
         nerrors += (test_scaleoffset_float(file) < 0 	        ? 1 : 0);
         nerrors += (test_scaleoffset_float_2(file) < 0 	        ? 1 : 0);
         nerrors += (test_scaleoffset_double(file) < 0 	        ? 1 : 0);
         nerrors += (test_scaleoffset_double_2(file) < 0 	? 1 : 0);
+        nerrors += (test_scaleoffset_widths(file) < 0 	        ? 1 : 0);
         nerrors += (test_multiopen (file) < 0		        ? 1 : 0);
         nerrors += (test_types(file) < 0       		        ? 1 : 0);
         nerrors += (test_userblock_offset(envval, my_fapl) < 0  ? 1 : 0);
@@ -12079,6 +13967,15 @@ main(void)
         nerrors += (test_large_chunk_shrink(my_fapl) < 0        ? 1 : 0);
         nerrors += (test_zero_dim_dset(my_fapl) < 0             ? 1 : 0);
         nerrors += (test_storage_size(my_fapl) < 0              ? 1 : 0);
+        nerrors += (test_filter_nthreads(my_fapl) < 0           ? 1 : 0);
+        nerrors += (test_chunk_cache_policy(my_fapl) < 0        ? 1 : 0);
+        nerrors += (test_shared_chunk_cache(my_fapl) < 0        ? 1 : 0);
+        nerrors += (test_chunk_read_ahead(my_fapl) < 0         ? 1 : 0);
+        nerrors += (test_chunk_iter(my_fapl) < 0               ? 1 : 0);
+        nerrors += (test_chunk_flush_sorted(my_fapl) < 0       ? 1 : 0);
+        nerrors += (test_sparse_read(my_fapl) < 0              ? 1 : 0);
+        nerrors += (test_chunk_cache_stats(my_fapl) < 0        ? 1 : 0);
+        nerrors += (test_chunk_store_raw(my_fapl) < 0          ? 1 : 0);
 
         if(H5Fclose(file) < 0)
             goto error;
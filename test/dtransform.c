@@ -18,12 +18,14 @@
 #define ROWS    12
 #define COLS    18
 #define FLOAT_TOL 0.0001F
+#define LONG_NELMTS 5000
 
 static int init_test(hid_t file_id);
 static int test_copy(const hid_t dxpl_id_c_to_f_copy, const hid_t dxpl_id_polynomial_copy);
 static int test_trivial(const hid_t dxpl_id_simple);
 static int test_poly(const hid_t dxpl_id_polynomial);
 static int test_specials(hid_t file);
+static int test_long(hid_t file);
 static int test_set(void);
 static int test_getset(const hid_t dxpl_id_simple);
 
@@ -327,6 +329,7 @@ int main(void)
     if(test_poly(dxpl_id_polynomial) < 0) TEST_ERROR;
     if(test_getset(dxpl_id_c_to_f) < 0) TEST_ERROR;
     if(test_specials(file_id) < 0) TEST_ERROR;
+    if(test_long(file_id) < 0) TEST_ERROR;
 
     /* Close the objects we opened/created */
     if(H5Dclose(dset_id_int) < 0) TEST_ERROR;
@@ -650,6 +653,85 @@ error:
      return -1;
 }
 
+static int
+test_long(hid_t file)
+{
+    hid_t dxpl_id = -1, dxpl_id_copy = -1, dset_id = -1, dataspace = -1;
+    hsize_t dim[1] = { LONG_NELMTS };
+    double *data = NULL;
+    double *read_buf = NULL;
+    double res;
+    const char* long_poly = "(x+1)*(x-2)/4+x*3-x";
+    size_t i;
+
+    TESTING("data transform of a long polynomial dataset")
+
+    /* Use more elements than are transformed at a time, and not a
+     * multiple of that number, so the transform works across several
+     * pieces and a partial last one */
+    if(NULL == (data = (double *)HDmalloc(LONG_NELMTS * sizeof(double))))
+        TEST_ERROR
+    if(NULL == (read_buf = (double *)HDmalloc(LONG_NELMTS * sizeof(double))))
+        TEST_ERROR
+    for(i = 0; i < LONG_NELMTS; i++)
+        data[i] = ((double)i - 2000.0) / 8.0;
+
+    if((dataspace = H5Screate_simple(1, dim, NULL)) < 0) TEST_ERROR
+    if((dset_id = H5Dcreate2(file, "/long", H5T_NATIVE_DOUBLE,
+            dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(H5Dwrite(dset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+            H5P_DEFAULT, data) < 0)
+        TEST_ERROR
+
+    if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0) TEST_ERROR
+    if(H5Pset_data_transform(dxpl_id, long_poly) < 0) TEST_ERROR
+    if((dxpl_id_copy = H5Pcopy(dxpl_id)) < 0) TEST_ERROR
+
+    /* Read with the transform and with a copy of it */
+    if(H5Dread(dset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+            dxpl_id, read_buf) < 0)
+        TEST_ERROR
+    for(i = 0; i < LONG_NELMTS; i++) {
+        res = ((data[i] + 1) * (data[i] - 2)) / 4 + data[i] * 3 - data[i];
+        if(HDfabs(read_buf[i] - res) > 1e-9 * (1 + HDfabs(res)))
+            FAIL_PUTS_ERROR("    ERROR: data failed to match computed data\n")
+    }
+
+    HDmemset(read_buf, 0, LONG_NELMTS * sizeof(double));
+    if(H5Dread(dset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+            dxpl_id_copy, read_buf) < 0)
+        TEST_ERROR
+    for(i = 0; i < LONG_NELMTS; i++) {
+        res = ((data[i] + 1) * (data[i] - 2)) / 4 + data[i] * 3 - data[i];
+        if(HDfabs(read_buf[i] - res) > 1e-9 * (1 + HDfabs(res)))
+            FAIL_PUTS_ERROR("    ERROR: data failed to match computed data\n")
+    }
+
+    if(H5Pclose(dxpl_id_copy) < 0) TEST_ERROR
+    if(H5Pclose(dxpl_id) < 0) TEST_ERROR
+    if(H5Dclose(dset_id) < 0) TEST_ERROR
+    if(H5Sclose(dataspace) < 0) TEST_ERROR
+    HDfree(read_buf);
+    HDfree(data);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dxpl_id_copy);
+        H5Pclose(dxpl_id);
+        H5Dclose(dset_id);
+        H5Sclose(dataspace);
+    } H5E_END_TRY
+    if(read_buf)
+        HDfree(read_buf);
+    if(data)
+        HDfree(data);
+    return -1;
+}
+
 static int
 test_copy(const hid_t dxpl_id_c_to_f_copy, const hid_t dxpl_id_polynomial_copy)
 {
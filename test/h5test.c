@@ -899,6 +899,17 @@ h5_fileaccess(void)
          * and copy buffer size to the default values. */
         if(H5Pset_fapl_direct(fapl, 1024, 4096, 8 * 4096) < 0)
             return -1;
+#endif
+    }
+    else if(!HDstrcmp(name, "async")) {
+#ifdef H5_HAVE_ASYNC_VFD
+        /* Linux io_uring or native AIO, with an optional queue depth */
+        unsigned depth = 0;
+
+        if((val = HDstrtok(NULL, " \t\n\r")))
+            depth = (unsigned)HDstrtol(val, NULL, 0);
+        if(H5Pset_fapl_async(fapl, depth, H5FD_ASYNC_ENGINE_DEFAULT) < 0)
+            return -1;
 #endif
     }
     else if(!HDstrcmp(name, "latest")) {
@@ -1036,6 +1047,19 @@ h5_get_vfd_fapl(void)
          */
         if(H5Pset_fapl_direct(fapl, 1024, 4096, 8*4096)<0)
             return -1;
+#endif
+#ifdef H5_HAVE_ASYNC_VFD
+    } else if(!HDstrcmp(tok, "async")) {
+        /* Linux io_uring or native AIO.  Was a queue depth specified in
+         * the environment variable?
+         */
+        unsigned depth = 0;
+
+        if((tok = HDstrtok(NULL, " \t\n\r")))
+            depth = (unsigned)HDstrtol(tok, NULL, 0);
+
+        if(H5Pset_fapl_async(fapl, depth, H5FD_ASYNC_ENGINE_DEFAULT) < 0)
+            return -1;
 #endif
     } else {
         /* Unknown driver */
@@ -1319,6 +1343,9 @@ h5_get_file_size(const char *filename, hid_t fapl)
 #ifdef H5_HAVE_DIRECT
                 driver == H5FD_DIRECT ||
 #endif /* H5_HAVE_DIRECT */
+#ifdef H5_HAVE_ASYNC_VFD
+                driver == H5FD_ASYNC ||
+#endif /* H5_HAVE_ASYNC_VFD */
                 driver == H5FD_LOG) {
             /* Get the file's statistics */
             if(0 == HDstat(filename, &sb))
@@ -0,0 +1,823 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Tests the file page buffer.
+ */
+#include "h5test.h"
+
+#define H5F_FRIEND		/*suppress error about including H5Fpkg	  */
+#include "H5Fpkg.h"
+#include "H5FDprivate.h"
+#include "H5Iprivate.h"
+
+const char *FILENAME[] = {
+    "page_buffer",
+    NULL
+};
+
+/* Page buffer settings */
+#define PB_PAGE_SIZE    4096
+#define PB_NPAGES       8
+#define PB_BUF_SIZE     (PB_NPAGES * PB_PAGE_SIZE)
+
+/* Number of pages in the page buffer for the eviction tests */
+#define PB_EVICT_NPAGES 4
+
+/* Address of page N in the eviction tests, well past the file's own data */
+#define PB_PAGE(N)      ((haddr_t)(1024 * 1024 + (N) * PB_PAGE_SIZE))
+
+/* Object test values */
+#define PB_NGROUPS      32
+#define PB_BIG_NELMTS   (16 * PB_PAGE_SIZE / sizeof(int))
+#define PB_SMALL_NELMTS 100
+#define PB_CHUNK_NELMTS 50
+#define PB_CHUNKED_NELMTS (40 * PB_CHUNK_NELMTS)
+
+/* Private wrappers for I/O through the page buffer */
+#define meta_write(f,a,s,b) H5F_block_write(f, H5FD_MEM_SUPER, (haddr_t)(a), (size_t)(s), H5AC_ind_read_dxpl_id, (b))
+#define meta_read(f,a,s,b)  H5F_block_read(f, H5FD_MEM_SUPER, (haddr_t)(a), (size_t)(s), H5AC_ind_read_dxpl_id, (b))
+#define raw_write(f,a,s,b)  H5F_block_write(f, H5FD_MEM_DRAW, (haddr_t)(a), (size_t)(s), H5AC_rawdata_dxpl_id, (b))
+#define raw_read(f,a,s,b)   H5F_block_read(f, H5FD_MEM_DRAW, (haddr_t)(a), (size_t)(s), H5AC_rawdata_dxpl_id, (b))
+
+
+/*-------------------------------------------------------------------------
+ * Function:    page_cached
+ *
+ * Purpose:     Checks whether page N of the eviction tests is in a file's
+ *              page buffer.
+ *
+ * Return:      TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+page_cached(const H5F_t *f, unsigned n)
+{
+    haddr_t     addr = PB_PAGE(n);      /* Address of page */
+
+    return(NULL != H5SL_search(f->shared->page_buf->pages, &addr));
+} /* end page_cached() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    reset_page_buffer
+ *
+ * Purpose:     Writes out and empties a file's page buffer, replacing it
+ *              with one of NPAGES pages and the given minimum shares, so
+ *              that a test starts from a known state.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+reset_page_buffer(H5F_t *f, size_t npages, unsigned min_meta_perc,
+    unsigned min_raw_perc)
+{
+    H5F_io_info_t fio_info;             /* I/O info for operation */
+
+    fio_info.f = f;
+    if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(H5AC_ind_read_dxpl_id)))
+        return -1;
+    if(H5F__page_flush(&fio_info) < 0)
+        return -1;
+    if(H5F__page_dest(f->shared) < 0)
+        return -1;
+    if(H5F__page_create(f->shared, (size_t)PB_PAGE_SIZE, npages * PB_PAGE_SIZE, min_meta_perc, min_raw_perc) < 0)
+        return -1;
+
+    return 0;
+} /* end reset_page_buffer() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_page_buffer_props
+ *
+ * Purpose:     Tests the page buffer property routines, the page buffer
+ *              settings of an open file and the page alignment of file
+ *              space while the page buffer is on.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_page_buffer_props(hid_t fapl)
+{
+    hid_t       my_fapl = -1;           /* File access property list */
+    hid_t       access_fapl = -1;       /* File's access property list */
+    hid_t       fcpl = -1;              /* File creation property list */
+    hid_t       file = -1;              /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list */
+    hid_t       space = -1;             /* Dataspace ID */
+    hid_t       dset = -1;              /* Dataset ID */
+    char        filename[1024];         /* Filename */
+    hsize_t     dims[1] = {3 * PB_PAGE_SIZE};
+    size_t      page_size, buf_size;    /* Page buffer settings */
+    unsigned    min_meta_perc, min_raw_perc;
+    hsize_t     threshold, alignment;   /* Alignment settings */
+    haddr_t     offset;                 /* Address of dataset */
+    H5F_page_buf_stats_t stats;         /* Page buffer statistics */
+    herr_t      ret;                    /* Generic return value */
+
+    TESTING("page buffer properties");
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof(filename));
+    if((my_fapl = H5Pcopy(fapl)) < 0)
+        TEST_ERROR
+
+    /* Check the defaults */
+    if(H5Pget_page_buffer(my_fapl, &page_size, &buf_size, &min_meta_perc, &min_raw_perc) < 0)
+        TEST_ERROR
+    if(page_size != 4096 || buf_size != 0 || min_meta_perc != 0 || min_raw_perc != 0)
+        TEST_ERROR
+
+    /* Set & check some values */
+    if(H5Pset_page_buffer(my_fapl, (size_t)PB_PAGE_SIZE, (size_t)PB_BUF_SIZE, 20, 30) < 0)
+        TEST_ERROR
+    if(H5Pget_page_buffer(my_fapl, &page_size, &buf_size, &min_meta_perc, &min_raw_perc) < 0)
+        TEST_ERROR
+    if(page_size != PB_PAGE_SIZE || buf_size != PB_BUF_SIZE || min_meta_perc != 20 || min_raw_perc != 30)
+        TEST_ERROR
+
+    /* Bad values */
+    H5E_BEGIN_TRY {
+        ret = H5Pset_page_buffer(my_fapl, (size_t)1000, (size_t)PB_BUF_SIZE, 0, 0);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("page size that isn't a power of two accepted");
+    H5E_BEGIN_TRY {
+        ret = H5Pset_page_buffer(my_fapl, (size_t)256, (size_t)PB_BUF_SIZE, 0, 0);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("page size below 512 accepted");
+    H5E_BEGIN_TRY {
+        ret = H5Pset_page_buffer(my_fapl, (size_t)PB_PAGE_SIZE, (size_t)(PB_PAGE_SIZE / 2), 0, 0);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("page buffer smaller than a page accepted");
+    H5E_BEGIN_TRY {
+        ret = H5Pset_page_buffer(my_fapl, (size_t)PB_PAGE_SIZE, (size_t)PB_BUF_SIZE, 101, 0);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("minimum percentage above 100 accepted");
+    H5E_BEGIN_TRY {
+        ret = H5Pset_page_buffer(my_fapl, (size_t)PB_PAGE_SIZE, (size_t)PB_BUF_SIZE, 60, 50);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("minimum percentages adding up to more than 100 accepted");
+
+    /* The settings are unchanged */
+    if(H5Pget_page_buffer(my_fapl, &page_size, &buf_size, &min_meta_perc, &min_raw_perc) < 0)
+        TEST_ERROR
+    if(page_size != PB_PAGE_SIZE || buf_size != PB_BUF_SIZE || min_meta_perc != 20 || min_raw_perc != 30)
+        TEST_ERROR
+
+    /* A file opened with the page buffer reports its settings, and the page
+     * alignment it uses when no alignment was set */
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0)
+        TEST_ERROR
+    if((access_fapl = H5Fget_access_plist(file)) < 0)
+        TEST_ERROR
+    if(H5Pget_page_buffer(access_fapl, &page_size, &buf_size, &min_meta_perc, &min_raw_perc) < 0)
+        TEST_ERROR
+    if(page_size != PB_PAGE_SIZE || buf_size != PB_BUF_SIZE || min_meta_perc != 20 || min_raw_perc != 30)
+        TEST_ERROR
+    if(H5Pget_alignment(access_fapl, &threshold, &alignment) < 0)
+        TEST_ERROR
+    if(H5Pclose(access_fapl) < 0)
+        TEST_ERROR
+
+    if(threshold != PB_PAGE_SIZE || alignment != PB_PAGE_SIZE)
+        TEST_ERROR
+
+    /* Objects of a page or more start on a page */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR
+    if(H5Pset_alloc_time(dcpl, H5D_ALLOC_TIME_EARLY) < 0)
+        TEST_ERROR
+    if((space = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    if((dset = H5Dcreate2(file, "dset", H5T_NATIVE_UCHAR, space, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(HADDR_UNDEF == (offset = H5Dget_offset(dset)))
+        TEST_ERROR
+    if(0 != offset % PB_PAGE_SIZE)
+        TEST_ERROR
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+
+    /* The statistics can be read & reset */
+    if(H5Fflush(file, H5F_SCOPE_GLOBAL) < 0)
+        TEST_ERROR
+    if(H5Fget_page_buffering_stats(file, &stats) < 0)
+        TEST_ERROR
+    if(0 == stats.accesses[0] || 0 == stats.misses[0])
+        TEST_ERROR
+    if(H5Freset_page_buffering_stats(file) < 0)
+        TEST_ERROR
+    if(H5Fget_page_buffering_stats(file, &stats) < 0)
+        TEST_ERROR
+    if(0 != stats.accesses[0] || 0 != stats.misses[0] || 0 != stats.hits[0])
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    /* An alignment the application sets is kept */
+    if(H5Pset_alignment(my_fapl, (hsize_t)1, (hsize_t)512) < 0)
+        TEST_ERROR
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0)
+        TEST_ERROR
+    if((access_fapl = H5Fget_access_plist(file)) < 0)
+        TEST_ERROR
+    if(H5Pget_alignment(access_fapl, &threshold, &alignment) < 0)
+        TEST_ERROR
+    if(threshold != 1 || alignment != 512)
+        TEST_ERROR
+    if(H5Pclose(access_fapl) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    /* A userblock smaller than a page doesn't get in the way (the family
+     * driver can't reopen a file with a userblock) */
+    if(H5FD_FAMILY != H5Pget_driver(fapl)) {
+        if(H5Pset_alignment(my_fapl, (hsize_t)1, (hsize_t)1) < 0)
+            TEST_ERROR
+        if((fcpl = H5Pcreate(H5P_FILE_CREATE)) < 0)
+            TEST_ERROR
+        if(H5Pset_userblock(fcpl, (hsize_t)512) < 0)
+            TEST_ERROR
+        if((file = H5Fcreate(filename, H5F_ACC_TRUNC, fcpl, my_fapl)) < 0)
+            TEST_ERROR
+        if((dset = H5Dcreate2(file, "dset", H5T_NATIVE_UCHAR, space, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            TEST_ERROR
+        if(H5Dclose(dset) < 0)
+            TEST_ERROR
+        if(H5Fclose(file) < 0)
+            TEST_ERROR
+        if((file = H5Fopen(filename, H5F_ACC_RDONLY, my_fapl)) < 0)
+            TEST_ERROR
+        if((dset = H5Dopen2(file, "dset", H5P_DEFAULT)) < 0)
+            TEST_ERROR
+        if(H5Dclose(dset) < 0)
+            TEST_ERROR
+        if(H5Fclose(file) < 0)
+            TEST_ERROR
+        if(H5Pclose(fcpl) < 0)
+            TEST_ERROR
+    } /* end if */
+
+    /* There are no statistics without the page buffer */
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Fget_page_buffering_stats(file, &stats);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("page buffer statistics returned for file without page buffer");
+    H5E_BEGIN_TRY {
+        ret = H5Freset_page_buffering_stats(file);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("page buffer statistics reset for file without page buffer");
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    if(H5Sclose(space) < 0)
+        TEST_ERROR
+    if(H5Pclose(dcpl) < 0)
+        TEST_ERROR
+    if(H5Pclose(my_fapl) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dset);
+        H5Sclose(space);
+        H5Pclose(dcpl);
+        H5Pclose(access_fapl);
+        H5Pclose(fcpl);
+        H5Fclose(file);
+        H5Pclose(my_fapl);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_page_buffer_props() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    check_objects
+ *
+ * Purpose:     Checks the groups and datasets test_page_buffer_objects()
+ *              creates.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+check_objects(hid_t file, int *rbuf)
+{
+    hid_t       gid = -1;               /* Group ID */
+    hid_t       aid = -1;               /* Attribute ID */
+    hid_t       dset = -1;              /* Dataset ID */
+    char        name[32];               /* Object name */
+    int         val;                    /* Attribute value */
+    size_t      u;                      /* Local index variable */
+
+    for(u = 0; u < PB_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", (unsigned)u);
+        if((gid = H5Gopen2(file, name, H5P_DEFAULT)) < 0)
+            goto error;
+        if((aid = H5Aopen(gid, "attr", H5P_DEFAULT)) < 0)
+            goto error;
+        if(H5Aread(aid, H5T_NATIVE_INT, &val) < 0)
+            goto error;
+        if(val != (int)u)
+            goto error;
+        if(H5Aclose(aid) < 0)
+            goto error;
+        if(H5Gclose(gid) < 0)
+            goto error;
+    } /* end for */
+
+    if((dset = H5Dopen2(file, "big", H5P_DEFAULT)) < 0)
+        goto error;
+    if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        goto error;
+    for(u = 0; u < PB_BIG_NELMTS; u++)
+        if(rbuf[u] != (int)u)
+            goto error;
+    if(H5Dclose(dset) < 0)
+        goto error;
+
+    if((dset = H5Dopen2(file, "small", H5P_DEFAULT)) < 0)
+        goto error;
+    if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        goto error;
+    for(u = 0; u < PB_SMALL_NELMTS; u++)
+        if(rbuf[u] != -(int)u)
+            goto error;
+    if(H5Dclose(dset) < 0)
+        goto error;
+
+    if((dset = H5Dopen2(file, "chunked", H5P_DEFAULT)) < 0)
+        goto error;
+    if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        goto error;
+    for(u = 0; u < PB_CHUNKED_NELMTS; u++)
+        if(rbuf[u] != (int)(3 * u))
+            goto error;
+    if(H5Dclose(dset) < 0)
+        goto error;
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Aclose(aid);
+        H5Gclose(gid);
+        H5Dclose(dset);
+    } H5E_END_TRY;
+    return -1;
+} /* end check_objects() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_page_buffer_objects
+ *
+ * Purpose:     Writes groups, attributes and datasets through the page
+ *              buffer and reads them back, with and without it.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_page_buffer_objects(hid_t fapl)
+{
+    hid_t       pb_fapl = -1;           /* File access property list with page buffer */
+    hid_t       file = -1;              /* File ID */
+    hid_t       gid = -1;               /* Group ID */
+    hid_t       aid = -1;               /* Attribute ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list */
+    hid_t       dset = -1;              /* Dataset ID */
+    char        filename[1024];         /* Filename */
+    char        name[32];               /* Object name */
+    hsize_t     dims[1];                /* Dataset dimensions */
+    hsize_t     chunk_dims[1] = {PB_CHUNK_NELMTS};
+    H5F_page_buf_stats_t stats;         /* Page buffer statistics */
+    int         *wbuf = NULL;           /* Data written */
+    int         *rbuf = NULL;           /* Data read */
+    int         val;                    /* Attribute value */
+    size_t      u;                      /* Local index variable */
+
+    TESTING("objects through page buffer");
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof(filename));
+    if((pb_fapl = H5Pcopy(fapl)) < 0)
+        TEST_ERROR
+    if(H5Pset_page_buffer(pb_fapl, (size_t)PB_PAGE_SIZE, (size_t)PB_BUF_SIZE, 25, 25) < 0)
+        TEST_ERROR
+    if(NULL == (wbuf = (int *)HDmalloc(PB_BIG_NELMTS * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(PB_BIG_NELMTS * sizeof(int))))
+        TEST_ERROR
+
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, pb_fapl)) < 0)
+        TEST_ERROR
+
+    /* Enough groups & attributes to cycle metadata pages through the buffer */
+    if((sid = H5Screate(H5S_SCALAR)) < 0)
+        TEST_ERROR
+    for(u = 0; u < PB_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", (unsigned)u);
+        if((gid = H5Gcreate2(file, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+            TEST_ERROR
+        if((aid = H5Acreate2(gid, "attr", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+            TEST_ERROR
+        val = (int)u;
+        if(H5Awrite(aid, H5T_NATIVE_INT, &val) < 0)
+            TEST_ERROR
+        if(H5Aclose(aid) < 0)
+            TEST_ERROR
+        if(H5Gclose(gid) < 0)
+            TEST_ERROR
+    } /* end for */
+    if(H5Sclose(sid) < 0)
+        TEST_ERROR
+
+    /* A dataset bigger than a page, written around the page buffer */
+    dims[0] = PB_BIG_NELMTS;
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    if((dset = H5Dcreate2(file, "big", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    for(u = 0; u < PB_BIG_NELMTS; u++)
+        wbuf[u] = (int)u;
+    if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        TEST_ERROR
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+    if(H5Sclose(sid) < 0)
+        TEST_ERROR
+
+    /* A dataset smaller than a page */
+    dims[0] = PB_SMALL_NELMTS;
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    if((dset = H5Dcreate2(file, "small", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    for(u = 0; u < PB_SMALL_NELMTS; u++)
+        wbuf[u] = -(int)u;
+    if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        TEST_ERROR
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+    if(H5Sclose(sid) < 0)
+        TEST_ERROR
+
+    /* A dataset of small chunks, many to a page */
+    dims[0] = PB_CHUNKED_NELMTS;
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR
+    if(H5Pset_chunk(dcpl, 1, chunk_dims) < 0)
+        TEST_ERROR
+    if((dset = H5Dcreate2(file, "chunked", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    for(u = 0; u < PB_CHUNKED_NELMTS; u++)
+        wbuf[u] = (int)(3 * u);
+    if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        TEST_ERROR
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+    if(H5Pclose(dcpl) < 0)
+        TEST_ERROR
+    if(H5Sclose(sid) < 0)
+        TEST_ERROR
+
+    /* Read everything back while the file is open, with the metadata
+     * cache flushed so that metadata comes back through the page buffer */
+    if(H5Fflush(file, H5F_SCOPE_GLOBAL) < 0)
+        TEST_ERROR
+    if(check_objects(file, rbuf) < 0)
+        TEST_ERROR
+
+    /* Both kinds of I/O went through the page buffer, the large dataset
+     * went around it, and pages were evicted to make room */
+    if(H5Fget_page_buffering_stats(file, &stats) < 0)
+        TEST_ERROR
+    if(0 == stats.accesses[0] || 0 == stats.accesses[1])
+        TEST_ERROR
+    if(0 == stats.hits[0] || 0 == stats.misses[0] || 0 == stats.misses[1])
+        TEST_ERROR
+    if(0 == stats.bypasses[1])
+        TEST_ERROR
+    if(0 == stats.evictions[0] + stats.evictions[1])
+        TEST_ERROR
+    if(0 == stats.writes[0] || 0 == stats.writes[1])
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    /* The file is complete without the page buffer */
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR
+    if(check_objects(file, rbuf) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    /* Reading through the page buffer writes nothing */
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, pb_fapl)) < 0)
+        TEST_ERROR
+    if(check_objects(file, rbuf) < 0)
+        TEST_ERROR
+    if(H5Fget_page_buffering_stats(file, &stats) < 0)
+        TEST_ERROR
+    if(0 == stats.hits[0] || 0 != stats.writes[0] || 0 != stats.writes[1])
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    if(H5Pclose(pb_fapl) < 0)
+        TEST_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Aclose(aid);
+        H5Gclose(gid);
+        H5Dclose(dset);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(file);
+        H5Pclose(pb_fapl);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    return 1;
+} /* end test_page_buffer_objects() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_page_buffer_evict
+ *
+ * Purpose:     Tests the page buffer's least-recently-used eviction, the
+ *              protection of each class's minimum share, I/O that goes
+ *              around the page buffer, and freeing of file space.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_page_buffer_evict(hid_t fapl)
+{
+    hid_t       pb_fapl = -1;           /* File access property list with page buffer */
+    hid_t       file = -1;              /* File ID */
+    H5F_t       *f;                     /* Internal file struct */
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    char        filename[1024];         /* Filename */
+    unsigned char wbuf[2 * PB_PAGE_SIZE]; /* Data written */
+    unsigned char rbuf[2 * PB_PAGE_SIZE]; /* Data read */
+    unsigned    u;                      /* Local index variable */
+
+    TESTING("page buffer eviction");
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof(filename));
+    if((pb_fapl = H5Pcopy(fapl)) < 0)
+        TEST_ERROR
+    if(H5Pset_page_buffer(pb_fapl, (size_t)PB_PAGE_SIZE, (size_t)PB_BUF_SIZE, 0, 0) < 0)
+        TEST_ERROR
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, pb_fapl)) < 0)
+        TEST_ERROR
+    if(NULL == (f = (H5F_t *)H5I_object(file)))
+        FAIL_STACK_ERROR
+
+    /* Make room for the pages written */
+    if(H5FD_set_eoa(f->shared->lf, H5FD_MEM_DEFAULT, PB_PAGE(32)) < 0)
+        FAIL_STACK_ERROR
+
+    /* Start with PB_EVICT_NPAGES pages, half of them kept for raw data */
+    if(reset_page_buffer(f, (size_t)PB_EVICT_NPAGES, 0, 50) < 0)
+        FAIL_STACK_ERROR
+    pb = f->shared->page_buf;
+
+    /* Fill the buffer with metadata pages, then use page 0 again */
+    for(u = 0; u < 4; u++) {
+        HDmemset(wbuf, (int)u + 1, (size_t)100);
+        if(meta_write(f, PB_PAGE(u) + 10, 100, wbuf) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    if(pb->stats.misses[0] != 4 || pb->npages[0] != 4)
+        TEST_ERROR
+    if(meta_read(f, PB_PAGE(0) + 10, 100, rbuf) < 0)
+        FAIL_STACK_ERROR
+    if(pb->stats.hits[0] != 1 || rbuf[0] != 1 || rbuf[99] != 1)
+        TEST_ERROR
+
+    /* Another page evicts the least recently used one, page 1, which is
+     * written to the file first */
+    HDmemset(wbuf, 5, (size_t)100);
+    if(meta_write(f, PB_PAGE(4) + 10, 100, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(pb->stats.evictions[0] != 1 || pb->stats.writes[0] != 1)
+        TEST_ERROR
+    if(page_cached(f, 1) || !page_cached(f, 0))
+        TEST_ERROR
+    if(meta_read(f, PB_PAGE(1) + 10, 100, rbuf) < 0)
+        FAIL_STACK_ERROR
+    if(rbuf[0] != 2 || rbuf[99] != 2)
+        TEST_ERROR
+    if(pb->stats.evictions[0] != 2 || page_cached(f, 2))
+        TEST_ERROR
+
+    /* Raw data pages evict metadata pages */
+    for(u = 8; u < 10; u++) {
+        HDmemset(wbuf, (int)u + 1, (size_t)200);
+        if(raw_write(f, PB_PAGE(u) + 100, 200, wbuf) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    if(pb->npages[0] != 2 || pb->npages[1] != 2)
+        TEST_ERROR
+
+    /* Make the raw data pages the least recently used: they are kept, at
+     * their minimum, when a metadata page needs room */
+    if(meta_read(f, PB_PAGE(1) + 10, 100, rbuf) < 0)
+        FAIL_STACK_ERROR
+    if(meta_read(f, PB_PAGE(4) + 10, 100, rbuf) < 0)
+        FAIL_STACK_ERROR
+    HDmemset(wbuf, 11, (size_t)100);
+    if(meta_write(f, PB_PAGE(10) + 10, 100, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(!page_cached(f, 8) || !page_cached(f, 9) || page_cached(f, 1))
+        TEST_ERROR
+    if(pb->stats.evictions[1] != 0)
+        TEST_ERROR
+
+    /* A raw data page still evicts the least recently used raw data page */
+    HDmemset(wbuf, 14, (size_t)200);
+    if(raw_write(f, PB_PAGE(13), 200, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(page_cached(f, 8) || !page_cached(f, 9) || pb->stats.evictions[1] != 1)
+        TEST_ERROR
+
+    /* A write of a page or more goes around the page buffer, but updates
+     * the pages it overlaps */
+    HDmemset(wbuf, 21, (size_t)PB_PAGE_SIZE);
+    if(raw_write(f, PB_PAGE(8) + PB_PAGE_SIZE / 2, PB_PAGE_SIZE, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(pb->stats.bypasses[1] != 1 || page_cached(f, 8))
+        TEST_ERROR
+    if(raw_read(f, PB_PAGE(9) + 100, 200, rbuf) < 0)
+        FAIL_STACK_ERROR
+    if(rbuf[0] != 21 || rbuf[199] != 21)
+        TEST_ERROR
+    if(raw_read(f, PB_PAGE(8) + PB_PAGE_SIZE / 2, 100, rbuf) < 0)
+        FAIL_STACK_ERROR
+    if(rbuf[0] != 21 || rbuf[99] != 21 || !page_cached(f, 8))
+        TEST_ERROR
+
+    /* A read of a page or more goes around the page buffer, but sees the
+     * newer data in dirty pages */
+    HDmemset(wbuf, 22, (size_t)100);
+    if(raw_write(f, PB_PAGE(13) + 1000, 100, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(raw_read(f, PB_PAGE(13), 2 * PB_PAGE_SIZE, rbuf) < 0)
+        FAIL_STACK_ERROR
+    if(pb->stats.bypasses[1] != 2)
+        TEST_ERROR
+    if(rbuf[0] != 14 || rbuf[199] != 14 || rbuf[200] != 0 || rbuf[1000] != 22 || rbuf[1099] != 22)
+        TEST_ERROR
+
+    /* Pages within freed file space are dropped */
+    if(H5F__page_free(f, PB_PAGE(13), (hsize_t)PB_PAGE_SIZE) < 0)
+        FAIL_STACK_ERROR
+    if(page_cached(f, 13))
+        TEST_ERROR
+    if(H5F__page_free(f, PB_PAGE(9) + 1, (hsize_t)PB_PAGE_SIZE) < 0)
+        FAIL_STACK_ERROR
+    if(!page_cached(f, 9))
+        TEST_ERROR
+
+    /* With the buffer full of metadata pages at their minimum, raw data
+     * has no room and goes around the page buffer */
+    if(reset_page_buffer(f, (size_t)PB_EVICT_NPAGES, 100, 0) < 0)
+        FAIL_STACK_ERROR
+    pb = f->shared->page_buf;
+    for(u = 0; u < 4; u++)
+        if(meta_read(f, PB_PAGE(u), 100, rbuf) < 0)
+            FAIL_STACK_ERROR
+    HDmemset(wbuf, 31, (size_t)100);
+    if(raw_write(f, PB_PAGE(8), 100, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(pb->stats.bypasses[1] != 1 || pb->npages[1] != 0 || page_cached(f, 8))
+        TEST_ERROR
+    if(raw_read(f, PB_PAGE(8), 100, rbuf) < 0)
+        FAIL_STACK_ERROR
+    if(rbuf[0] != 31 || rbuf[99] != 31)
+        TEST_ERROR
+
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+    if(H5Pclose(pb_fapl) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Fclose(file);
+        H5Pclose(pb_fapl);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_page_buffer_evict() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    main
+ *
+ * Purpose:     Tests the file page buffer
+ *
+ * Return:      Success:        EXIT_SUCCESS
+ *              Failure:        EXIT_FAILURE
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(void)
+{
+    hid_t       fapl = -1;              /* File access property list */
+    hid_t       sec2_fapl = -1;         /* sec2 file access property list */
+    unsigned    nerrors = 0;            /* Number of errors */
+
+    h5_reset();
+    if((fapl = h5_fileaccess()) < 0)
+        TEST_ERROR
+
+    /* The multi driver splits the address space between files at addresses
+     * that aren't on page boundaries, so it can't have a page buffer */
+    if(H5FD_MULTI == H5Pget_driver(fapl)) {
+        puts("All page buffer tests skipped - Incompatible with current Virtual File Driver");
+        h5_cleanup(FILENAME, fapl);
+        HDexit(EXIT_SUCCESS);
+    } /* end if */
+
+    nerrors += test_page_buffer_props(fapl);
+    nerrors += test_page_buffer_objects(fapl);
+
+    /* The eviction test lays out pages by address, so it needs a driver
+     * with a single address space */
+    if((sec2_fapl = H5Pcopy(fapl)) < 0)
+        TEST_ERROR
+    if(H5Pset_fapl_sec2(sec2_fapl) < 0)
+        TEST_ERROR
+    nerrors += test_page_buffer_evict(sec2_fapl);
+    if(H5Pclose(sec2_fapl) < 0)
+        TEST_ERROR
+
+    if(nerrors)
+        goto error;
+
+    puts("All page buffer tests passed.");
+    h5_cleanup(FILENAME, fapl);
+    HDexit(EXIT_SUCCESS);
+
+error:
+    puts("*** TESTS FAILED ***");
+    H5E_BEGIN_TRY {
+        H5Pclose(sec2_fapl);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    HDexit(EXIT_FAILURE);
+} /* end main() */
@@ -34,6 +34,12 @@
 /**********/
 #define BUF_LEN 3093    /* No particular value */
 
+/* Size of the buffer the fast checksum paths are compared over */
+#define CMP_BUF_LEN     20000
+
+/* Offsets the fast checksum paths are compared at, to vary alignment */
+#define CMP_NOFFSETS    4
+
 /*******************/
 /* Local variables */
 /*******************/
@@ -213,6 +219,107 @@ test_chksum_large(void)
     VERIFY(chksum, 0x930c7afc, "H5_checksum_lookup3");
 } /* test_chksum_large() */
 
+
+/****************************************************************
+**
+**  ref_fletcher32(): Reference fletcher32 checksum, summing one
+**      16-bit word at a time and reducing each sum every word
+**
+****************************************************************/
+static uint32_t
+ref_fletcher32(const uint8_t *data, size_t len)
+{
+    uint32_t sum1 = 0, sum2 = 0;
+    size_t u;
+
+    for(u = 0; u + 1 < len; u += 2) {
+        sum1 += ((uint32_t)data[u] << 8) | (uint32_t)data[u + 1];
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 += sum1;
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    } /* end for */
+    if(len % 2) {
+        sum1 += (uint32_t)data[len - 1] << 8;
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 += sum1;
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    } /* end if */
+
+    return (sum2 << 16) | sum1;
+} /* ref_fletcher32() */
+
+
+/****************************************************************
+**
+**  ref_crc(): Reference CRC checksum, one byte and one bit at
+**      a time
+**
+****************************************************************/
+static uint32_t
+ref_crc(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    size_t u;
+    unsigned k;
+
+    for(u = 0; u < len; u++) {
+        crc ^= data[u];
+        for(k = 0; k < 8; k++)
+            crc = (crc & 1) ? (0x04C11DB7 ^ (crc >> 1)) : (crc >> 1);
+    } /* end for */
+
+    return crc ^ 0xffffffff;
+} /* ref_crc() */
+
+
+/****************************************************************
+**
+**  test_chksum_fast_paths(): Compare the checksums against simple
+**      reference versions for buffers of many lengths and
+**      alignments, covering the vector fletcher32 kernels (and the
+**      word-at-a-time CRC), their leftovers and the sums' wrap-around
+**
+****************************************************************/
+static void
+test_chksum_fast_paths(void)
+{
+    uint8_t *buf;               /* Buffer to checksum */
+    size_t len;                 /* Length checksummed */
+    unsigned fill;              /* Kind of data in buffer */
+    unsigned off;               /* Offset into buffer */
+    size_t u;                   /* Local index variable */
+
+    buf = (uint8_t *)HDmalloc(CMP_BUF_LEN + CMP_NOFFSETS);
+    CHECK_PTR(buf, "HDmalloc");
+
+    for(fill = 0; fill < 4; fill++) {
+        /* All ones (the largest sums), all zeros (sums of zero), a single
+         * non-zero byte (sums wrapping to zero) and a counting pattern */
+        for(u = 0; u < CMP_BUF_LEN + CMP_NOFFSETS; u++)
+            if(fill == 0)
+                buf[u] = 0xff;
+            else if(fill == 1)
+                buf[u] = 0;
+            else if(fill == 2)
+                buf[u] = (uint8_t)(u == 1000 ? 1 : 0);
+            else
+                buf[u] = (uint8_t)(u * 7 + u / 251);
+
+        for(len = 1; len <= CMP_BUF_LEN; len += (len < 300 ? 1 : len / 8))
+            for(off = 0; off < CMP_NOFFSETS; off++) {
+                uint32_t chksum;    /* Checksum value */
+
+                chksum = H5_checksum_fletcher32(buf + off, len);
+                VERIFY(chksum, ref_fletcher32(buf + off, len), "H5_checksum_fletcher32");
+
+                chksum = H5_checksum_crc(buf + off, len);
+                VERIFY(chksum, ref_crc(buf + off, len), "H5_checksum_crc");
+            } /* end for */
+    } /* end for */
+
+    HDfree(buf);
+} /* test_chksum_fast_paths() */
+
 
 /****************************************************************
 **
@@ -231,6 +338,7 @@ test_checksum(void)
     test_chksum_size_three();		/* Test buffer w/only 3 bytes */
     test_chksum_size_four();		/* Test buffer w/only 4 bytes */
     test_chksum_large();		/* Test buffer w/larger # of bytes */
+    test_chksum_fast_paths();		/* Test against reference checksums */
 
 } /* test_checksum() */
 
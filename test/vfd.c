@@ -60,11 +60,33 @@ const char *FILENAME[] = {
     "stdio_file",        /*7*/
     "windows_file",      /*8*/
     "new_multi_file_v16",/*9*/
+    "vector_file",       /*10*/
+    "mmap_file",         /*11*/
+    "async_file",        /*12*/
     NULL
 };
 
 #define LOG_FILENAME "log_vfd_out.log"
 
+/* Macros for vector I/O tests */
+#define VEC_FILE_SIZE   (8*KB)
+#define VEC_NPIECES     64
+#define VEC_DSET_NAME   "vector dset"
+#define VEC_DSET_DIM1   64
+#define VEC_DSET_DIM2   1024
+#define VEC_SIEVE_SIZE  (1*KB)
+
+/* Macros for mmap VFD tests */
+#define MMAP_DSET_NAME  "mmap dset"
+#define MMAP_CHUNK_NAME "mmap chunked dset"
+#define MMAP_DSET_DIM1  64
+#define MMAP_DSET_DIM2  1024
+#define MMAP_GROW_SIZE  (4*KB)
+
+#define ASYNC_DEPTH     4
+#define ASYNC_NPIECES   (4 * ASYNC_DEPTH + 1)
+#define ASYNC_PIECE     (1*KB)
+
 #define COMPAT_BASENAME "family_v16_"
 #define MULTI_COMPAT_BASENAME "multi_file_v16"
 
@@ -1737,6 +1759,837 @@ error:
 
 
 
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io_driver
+ *
+ * Purpose:     Writes a vector of pieces to a file with one driver using
+ *              H5FDwrite_vector(), and checks them with H5FDread() and
+ *              H5FDread_vector().  Some pieces are adjacent in the file,
+ *              some are not, and with the family driver some cross member
+ *              boundaries.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io_driver(hid_t fapl)
+{
+    H5FD_t      *file = NULL;               /* VFD file struct          */
+    char        filename[1024];             /* filename                 */
+    H5FD_mem_t  types[VEC_NPIECES];         /* type of each piece       */
+    haddr_t     addrs[VEC_NPIECES];         /* address of each piece    */
+    size_t      sizes[VEC_NPIECES];         /* size of each piece       */
+    const void  *wbufs[VEC_NPIECES];        /* pieces written           */
+    void        *rbufs[VEC_NPIECES];        /* pieces read              */
+    unsigned char *wbuf = NULL;             /* buffer of pieces written */
+    unsigned char *rbuf = NULL;             /* buffer of pieces read    */
+    haddr_t     addr = 0;                   /* address of next piece    */
+    size_t      off = 0;                    /* offset of next piece     */
+    size_t      u;                          /* local index variable     */
+
+    h5_fixname(FILENAME[10], fapl, filename, sizeof(filename));
+
+    if(NULL == (wbuf = (unsigned char *)HDmalloc(VEC_FILE_SIZE)))
+        TEST_ERROR;
+    if(NULL == (rbuf = (unsigned char *)HDcalloc((size_t)1, VEC_FILE_SIZE)))
+        TEST_ERROR;
+    for(u = 0; u < VEC_FILE_SIZE; u++)
+        wbuf[u] = (unsigned char)(u * 7 + 3);
+
+    /* Lay out the pieces: runs of three adjacent pieces separated by gaps,
+     * written from buffers in the reverse order of their file addresses.
+     */
+    for(u = 0; u < VEC_NPIECES; u++) {
+        types[u] = H5FD_MEM_DRAW;
+        sizes[u] = 16 + (u % 5) * 8;
+        addrs[u] = addr;
+        addr += sizes[u] + ((u % 3) == 2 ? 40 : 0);
+        off += sizes[u];
+        wbufs[u] = wbuf + VEC_FILE_SIZE - off;
+        rbufs[u] = rbuf + VEC_FILE_SIZE - off;
+    } /* end for */
+    if(addr > VEC_FILE_SIZE || off > VEC_FILE_SIZE)
+        TEST_ERROR;
+
+    if(NULL == (file = H5FDopen(filename, H5F_ACC_RDWR | H5F_ACC_CREAT | H5F_ACC_TRUNC, fapl, HADDR_UNDEF)))
+        TEST_ERROR;
+    if(H5FDset_eoa(file, H5FD_MEM_DRAW, (haddr_t)VEC_FILE_SIZE) < 0)
+        TEST_ERROR;
+
+    /* Write the pieces */
+    if(H5FDwrite_vector(file, H5P_DEFAULT, (size_t)VEC_NPIECES, types, addrs, sizes, wbufs) < 0)
+        TEST_ERROR;
+
+    /* Check them one at a time */
+    for(u = 0; u < VEC_NPIECES; u++) {
+        if(H5FDread(file, H5FD_MEM_DRAW, H5P_DEFAULT, addrs[u], sizes[u], rbufs[u]) < 0)
+            TEST_ERROR;
+        if(HDmemcmp(rbufs[u], wbufs[u], sizes[u]))
+            FAIL_PUTS_ERROR("wrong data read after vector write");
+    } /* end for */
+
+    /* Check them all at once */
+    HDmemset(rbuf, 0, VEC_FILE_SIZE);
+    if(H5FDread_vector(file, H5P_DEFAULT, (size_t)VEC_NPIECES, types, addrs, sizes, rbufs) < 0)
+        TEST_ERROR;
+    if(HDmemcmp(rbuf + VEC_FILE_SIZE - off, wbuf + VEC_FILE_SIZE - off, off))
+        FAIL_PUTS_ERROR("wrong data read by vector read");
+
+    /* A piece past the end of allocated space fails the whole request */
+    addrs[VEC_NPIECES - 1] = (haddr_t)VEC_FILE_SIZE;
+    H5E_BEGIN_TRY {
+        if(H5FDread_vector(file, H5P_DEFAULT, (size_t)VEC_NPIECES, types, addrs, sizes, rbufs) >= 0)
+            FAIL_PUTS_ERROR("vector read past the end of allocated space succeeded");
+    } H5E_END_TRY;
+
+    if(H5FDclose(file) < 0)
+        TEST_ERROR;
+    file = NULL;
+    h5_delete_test_file(FILENAME[10], fapl);
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(file)
+            H5FDclose(file);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    return -1;
+} /* end test_vector_io_driver() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io_dset
+ *
+ * Purpose:     Reads and writes a column of a contiguous dataset, which
+ *              is too sparse for data sieving and is moved with vector
+ *              I/O, and checks the data against reads through the sieve
+ *              buffer.  The file is accessed with the driver set in
+ *              DRIVER_FAPL.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io_dset(hid_t driver_fapl)
+{
+    hid_t       fapl = -1;                  /* file access property list ID */
+    hid_t       file = -1;                  /* file ID                      */
+    hid_t       dset = -1;                  /* dataset ID                   */
+    hid_t       space = -1;                 /* dataspace ID                 */
+    hid_t       mspace = -1;                /* column dataspace ID          */
+    hid_t       rspace = -1;                /* row dataspace ID             */
+    char        filename[1024];             /* filename                     */
+    hsize_t     dims[2] = {VEC_DSET_DIM1, VEC_DSET_DIM2};
+    hsize_t     col_dims[1] = {VEC_DSET_DIM1};
+    hsize_t     row_dims[1] = {16};
+    hsize_t     start[2], count[2];         /* hyperslab of a column        */
+    int         *data = NULL;               /* whole dataset                */
+    int         col[VEC_DSET_DIM1];         /* one column                   */
+    int         row[16];                    /* start of one row             */
+    size_t      u, v;                       /* local index variables        */
+
+    /* Use a small sieve buffer, so that the rows are far apart for it */
+    if((fapl = H5Pcopy(driver_fapl)) < 0)
+        TEST_ERROR;
+    if(H5Pset_sieve_buf_size(fapl, (size_t)VEC_SIEVE_SIZE) < 0)
+        TEST_ERROR;
+    h5_fixname(FILENAME[10], fapl, filename, sizeof(filename));
+
+    if(NULL == (data = (int *)HDmalloc(VEC_DSET_DIM1 * VEC_DSET_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    for(u = 0; u < VEC_DSET_DIM1 * VEC_DSET_DIM2; u++)
+        data[u] = (int)u;
+
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR;
+    if((space = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR;
+    if((dset = H5Dcreate2(file, VEC_DSET_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0)
+        TEST_ERROR;
+    if((mspace = H5Screate_simple(1, col_dims, NULL)) < 0)
+        TEST_ERROR;
+    if((rspace = H5Screate_simple(1, row_dims, NULL)) < 0)
+        TEST_ERROR;
+
+    /* Read column 5 */
+    start[0] = 0; start[1] = 5;
+    count[0] = VEC_DSET_DIM1; count[1] = 1;
+    if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+        TEST_ERROR;
+    if(H5Dread(dset, H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, col) < 0)
+        TEST_ERROR;
+    for(u = 0; u < VEC_DSET_DIM1; u++)
+        if(col[u] != data[u * VEC_DSET_DIM2 + 5])
+            FAIL_PUTS_ERROR("wrong data read from column");
+
+    /* Read the start of row 3, through the sieve buffer */
+    start[0] = 3; start[1] = 0;
+    count[0] = 1; count[1] = 16;
+    if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+        TEST_ERROR;
+    if(H5Dread(dset, H5T_NATIVE_INT, rspace, space, H5P_DEFAULT, row) < 0)
+        TEST_ERROR;
+
+    /* Overwrite column 5, which crosses the sieve buffer */
+    for(u = 0; u < VEC_DSET_DIM1; u++)
+        col[u] = -(int)u;
+    start[0] = 0; start[1] = 5;
+    count[0] = VEC_DSET_DIM1; count[1] = 1;
+    if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+        TEST_ERROR;
+    if(H5Dwrite(dset, H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, col) < 0)
+        TEST_ERROR;
+    for(u = 0; u < VEC_DSET_DIM1; u++)
+        data[u * VEC_DSET_DIM2 + 5] = -(int)u;
+
+    /* Re-read the start of row 3, which must not be stale */
+    start[0] = 3; start[1] = 0;
+    count[0] = 1; count[1] = 16;
+    if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+        TEST_ERROR;
+    if(H5Dread(dset, H5T_NATIVE_INT, rspace, space, H5P_DEFAULT, row) < 0)
+        TEST_ERROR;
+    for(v = 0; v < 16; v++)
+        if(row[v] != data[3 * VEC_DSET_DIM2 + v])
+            FAIL_PUTS_ERROR("stale data read through the sieve buffer");
+
+    /* Check the whole dataset */
+    HDmemset(data, 0, VEC_DSET_DIM1 * VEC_DSET_DIM2 * sizeof(int));
+    if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0)
+        TEST_ERROR;
+    for(u = 0; u < VEC_DSET_DIM1; u++)
+        for(v = 0; v < VEC_DSET_DIM2; v++)
+            if(data[u * VEC_DSET_DIM2 + v] != (5 == v ? -(int)u : (int)(u * VEC_DSET_DIM2 + v)))
+                FAIL_PUTS_ERROR("wrong data read from dataset");
+
+    if(H5Sclose(rspace) < 0)
+        TEST_ERROR;
+    if(H5Sclose(mspace) < 0)
+        TEST_ERROR;
+    if(H5Sclose(space) < 0)
+        TEST_ERROR;
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if(H5Fclose(file) < 0)
+        TEST_ERROR;
+    h5_delete_test_file(FILENAME[10], fapl);
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    HDfree(data);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Sclose(rspace);
+        H5Sclose(mspace);
+        H5Sclose(space);
+        H5Dclose(dset);
+        H5Fclose(file);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    HDfree(data);
+    return -1;
+} /* end test_vector_io_dset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io
+ *
+ * Purpose:     Tests vector reads and writes, with drivers that carry
+ *              them out themselves (sec2, core and family) and with one
+ *              that doesn't (stdio), and through a dataset.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io(void)
+{
+    hid_t       fapl = -1;                  /* file access property list ID */
+
+    TESTING("vector I/O");
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR;
+
+    if(H5Pset_fapl_sec2(fapl) < 0)
+        TEST_ERROR;
+    if(test_vector_io_driver(fapl) < 0)
+        FAIL_PUTS_ERROR("sec2 driver");
+
+    if(H5Pset_fapl_core(fapl, (size_t)CORE_INCREMENT, FALSE) < 0)
+        TEST_ERROR;
+    if(test_vector_io_driver(fapl) < 0)
+        FAIL_PUTS_ERROR("core driver");
+
+    if(H5Pset_fapl_family(fapl, (hsize_t)FAMILY_SIZE, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if(test_vector_io_driver(fapl) < 0)
+        FAIL_PUTS_ERROR("family driver");
+
+    if(H5Pset_fapl_stdio(fapl) < 0)
+        TEST_ERROR;
+    if(test_vector_io_driver(fapl) < 0)
+        FAIL_PUTS_ERROR("stdio driver");
+
+    if(H5Pset_fapl_sec2(fapl) < 0)
+        TEST_ERROR;
+    if(test_vector_io_dset(fapl) < 0)
+        FAIL_PUTS_ERROR("dataset");
+
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_vector_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_mmap
+ *
+ * Purpose:     Tests the mmap driver: that it refuses to create or write
+ *              files, reads datasets written through the sec2 driver with
+ *              each kind of access advice, and picks up growth of the
+ *              file while it is open.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_mmap(void)
+{
+#ifdef H5_HAVE_MMAP
+    hid_t       fapl = -1;                  /* sec2 file access property list */
+    hid_t       mmap_fapl = -1;             /* mmap file access property list */
+    hid_t       access_fapl = -1;           /* file's access property list    */
+    hid_t       dapl = -1;                  /* dataset access property list   */
+    hid_t       dcpl = -1;                  /* dataset creation property list */
+    hid_t       file = -1;                  /* file ID                        */
+    hid_t       dset = -1;                  /* dataset ID                     */
+    hid_t       space = -1;                 /* dataspace ID                   */
+    hid_t       mspace = -1;                /* column dataspace ID            */
+    H5FD_t      *lf = NULL;                 /* VFD file struct                */
+    char        filename[1024];             /* filename                       */
+    hsize_t     dims[2] = {MMAP_DSET_DIM1, MMAP_DSET_DIM2};
+    hsize_t     chunk_dims[2] = {8, 128};
+    hsize_t     col_dims[1] = {MMAP_DSET_DIM1};
+    hsize_t     start[2], count[2];         /* hyperslab of a column          */
+    hsize_t     file_size = 0;              /* size of the file               */
+    haddr_t     eof;                        /* end of the file before growth  */
+    H5FD_advice_t advice;                   /* access advice                  */
+    int         *data = NULL;               /* whole dataset                  */
+    int         *rdata = NULL;              /* whole dataset read             */
+    int         col[MMAP_DSET_DIM1];        /* one column                     */
+    int         *fhandle = NULL;            /* file descriptor                */
+    unsigned char grow[MMAP_GROW_SIZE];     /* bytes the file grows by        */
+    unsigned char check[MMAP_GROW_SIZE];    /* bytes read after growth        */
+    h5_stat_t   sb;                         /* file status                    */
+    int         fd = -1;                    /* file descriptor for growing    */
+    herr_t      ret;                        /* generic return value           */
+    size_t      u;                          /* local index variable           */
+    int         i;                          /* local index variable           */
+#endif /* H5_HAVE_MMAP */
+
+    TESTING("MMAP file driver");
+
+#ifndef H5_HAVE_MMAP
+
+    SKIPPED();
+    return 0;
+
+#else /* H5_HAVE_MMAP */
+
+    if((fapl = h5_fileaccess()) < 0)
+        TEST_ERROR;
+    if(H5Pset_fapl_sec2(fapl) < 0)
+        TEST_ERROR;
+    if((mmap_fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR;
+    if(H5Pset_fapl_mmap(mmap_fapl) < 0)
+        TEST_ERROR;
+    h5_fixname(FILENAME[11], fapl, filename, sizeof(filename));
+
+    /* The driver can't create files */
+    H5E_BEGIN_TRY {
+        file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, mmap_fapl);
+    } H5E_END_TRY;
+    if(file >= 0)
+        FAIL_PUTS_ERROR("file created through the mmap driver");
+
+    /* Write a contiguous and a chunked dataset through the sec2 driver */
+    if(NULL == (data = (int *)HDmalloc(MMAP_DSET_DIM1 * MMAP_DSET_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    if(NULL == (rdata = (int *)HDmalloc(MMAP_DSET_DIM1 * MMAP_DSET_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    for(u = 0; u < MMAP_DSET_DIM1 * MMAP_DSET_DIM2; u++)
+        data[u] = (int)u;
+
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR;
+    if((space = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR;
+    if((dset = H5Dcreate2(file, MMAP_DSET_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0)
+        TEST_ERROR;
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR;
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0)
+        TEST_ERROR;
+    if((dset = H5Dcreate2(file, MMAP_CHUNK_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0)
+        TEST_ERROR;
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if(H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    /* The driver can't open files for writing */
+    H5E_BEGIN_TRY {
+        file = H5Fopen(filename, H5F_ACC_RDWR, mmap_fapl);
+    } H5E_END_TRY;
+    if(file >= 0)
+        FAIL_PUTS_ERROR("file opened for writing through the mmap driver");
+
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, mmap_fapl)) < 0)
+        TEST_ERROR;
+
+    /* Check that the driver is correct */
+    if((access_fapl = H5Fget_access_plist(file)) < 0)
+        TEST_ERROR;
+    if(H5FD_MMAP != H5Pget_driver(access_fapl))
+        TEST_ERROR;
+    if(H5Pclose(access_fapl) < 0)
+        TEST_ERROR;
+
+    /* Check file handle and file size APIs */
+    if(H5Fget_vfd_handle(file, H5P_DEFAULT, (void **)&fhandle) < 0)
+        TEST_ERROR;
+    if(*fhandle < 0)
+        TEST_ERROR;
+    if(H5Fget_filesize(file, &file_size) < 0)
+        TEST_ERROR;
+    if(HDstat(filename, &sb) < 0)
+        TEST_ERROR;
+    if(file_size != (hsize_t)sb.st_size)
+        TEST_ERROR;
+
+    /* Check the access advice property */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        TEST_ERROR;
+    if(H5Pget_access_advice(dapl, &advice) < 0)
+        TEST_ERROR;
+    if(H5FD_ADVICE_NORMAL != advice)
+        TEST_ERROR;
+    H5E_BEGIN_TRY {
+        ret = H5Pset_access_advice(dapl, H5FD_ADVICE_ERROR);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("invalid access advice set");
+
+    /* Read the datasets with each kind of advice */
+    if((mspace = H5Screate_simple(1, col_dims, NULL)) < 0)
+        TEST_ERROR;
+    for(i = (int)H5FD_ADVICE_NORMAL; i <= (int)H5FD_ADVICE_WILLNEED; i++) {
+        if(H5Pset_access_advice(dapl, (H5FD_advice_t)i) < 0)
+            TEST_ERROR;
+        if(H5Pget_access_advice(dapl, &advice) < 0)
+            TEST_ERROR;
+        if((H5FD_advice_t)i != advice)
+            TEST_ERROR;
+
+        /* The whole contiguous dataset */
+        if((dset = H5Dopen2(file, MMAP_DSET_NAME, dapl)) < 0)
+            TEST_ERROR;
+        HDmemset(rdata, 0, MMAP_DSET_DIM1 * MMAP_DSET_DIM2 * sizeof(int));
+        if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata) < 0)
+            TEST_ERROR;
+        if(HDmemcmp(data, rdata, MMAP_DSET_DIM1 * MMAP_DSET_DIM2 * sizeof(int)))
+            FAIL_PUTS_ERROR("wrong data read from contiguous dataset");
+
+        /* One of its columns */
+        start[0] = 0; start[1] = (hsize_t)(7 + i);
+        count[0] = MMAP_DSET_DIM1; count[1] = 1;
+        if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+            TEST_ERROR;
+        if(H5Dread(dset, H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, col) < 0)
+            TEST_ERROR;
+        for(u = 0; u < MMAP_DSET_DIM1; u++)
+            if(col[u] != data[u * MMAP_DSET_DIM2 + start[1]])
+                FAIL_PUTS_ERROR("wrong data read from column");
+
+        /* Writes fail */
+        H5E_BEGIN_TRY {
+            ret = H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+        } H5E_END_TRY;
+        if(ret >= 0)
+            FAIL_PUTS_ERROR("dataset written through the mmap driver");
+        if(H5Dclose(dset) < 0)
+            TEST_ERROR;
+
+        /* The whole chunked dataset */
+        if((dset = H5Dopen2(file, MMAP_CHUNK_NAME, dapl)) < 0)
+            TEST_ERROR;
+        HDmemset(rdata, 0, MMAP_DSET_DIM1 * MMAP_DSET_DIM2 * sizeof(int));
+        if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata) < 0)
+            TEST_ERROR;
+        if(HDmemcmp(data, rdata, MMAP_DSET_DIM1 * MMAP_DSET_DIM2 * sizeof(int)))
+            FAIL_PUTS_ERROR("wrong data read from chunked dataset");
+        if(H5Dclose(dset) < 0)
+            TEST_ERROR;
+    } /* end for */
+
+    if(H5Sclose(mspace) < 0)
+        TEST_ERROR;
+    if(H5Sclose(space) < 0)
+        TEST_ERROR;
+    if(H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    /* Grow the file while it is open through the driver; the new bytes
+     * must be read, not zeros
+     */
+    if(NULL == (lf = H5FDopen(filename, H5F_ACC_RDONLY, mmap_fapl, HADDR_UNDEF)))
+        TEST_ERROR;
+    if(HADDR_UNDEF == (eof = H5FDget_eof(lf, H5FD_MEM_DEFAULT)))
+        TEST_ERROR;
+    if(eof != (haddr_t)sb.st_size)
+        TEST_ERROR;
+    if(H5FDset_eoa(lf, H5FD_MEM_DEFAULT, eof + 2 * MMAP_GROW_SIZE) < 0)
+        TEST_ERROR;
+    for(u = 0; u < MMAP_GROW_SIZE; u++)
+        grow[u] = (unsigned char)(u * 7 + 1);
+    if((fd = HDopen(filename, O_WRONLY | O_APPEND, 0)) < 0)
+        TEST_ERROR;
+    if(HDwrite(fd, grow, sizeof(grow)) != (h5_posix_io_ret_t)sizeof(grow))
+        TEST_ERROR;
+    if(HDclose(fd) < 0)
+        TEST_ERROR;
+    fd = -1;
+    if(H5FDread(lf, H5FD_MEM_DRAW, H5P_DEFAULT, eof, sizeof(check), check) < 0)
+        TEST_ERROR;
+    if(HDmemcmp(grow, check, sizeof(grow)))
+        FAIL_PUTS_ERROR("growth of the file not read");
+
+    /* Past the end of the file reads zeros */
+    HDmemset(check, 0xff, sizeof(check));
+    if(H5FDread(lf, H5FD_MEM_DRAW, H5P_DEFAULT, eof + MMAP_GROW_SIZE, sizeof(check), check) < 0)
+        TEST_ERROR;
+    for(u = 0; u < MMAP_GROW_SIZE; u++)
+        if(check[u])
+            FAIL_PUTS_ERROR("past the end of the file not read as zeros");
+
+    /* Writes fail */
+    H5E_BEGIN_TRY {
+        ret = H5FDwrite(lf, H5FD_MEM_DRAW, H5P_DEFAULT, eof, sizeof(grow), grow);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("file written through the mmap driver");
+    if(H5FDclose(lf) < 0)
+        TEST_ERROR;
+    lf = NULL;
+
+    h5_delete_test_file(FILENAME[11], fapl);
+    if(H5Pclose(dapl) < 0)
+        TEST_ERROR;
+    if(H5Pclose(dcpl) < 0)
+        TEST_ERROR;
+    if(H5Pclose(mmap_fapl) < 0)
+        TEST_ERROR;
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    HDfree(data);
+    HDfree(rdata);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(fd >= 0)
+            HDclose(fd);
+        if(lf)
+            H5FDclose(lf);
+        H5Sclose(mspace);
+        H5Sclose(space);
+        H5Dclose(dset);
+        H5Fclose(file);
+        H5Pclose(access_fapl);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Pclose(mmap_fapl);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    HDfree(data);
+    HDfree(rdata);
+    return -1;
+
+#endif /* H5_HAVE_MMAP */
+} /* end test_mmap() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_async_vector
+ *
+ * Purpose:     Checks the async driver's handling of vector requests of
+ *              more pieces than its queue depth: a write of pieces in
+ *              the reverse order of their addresses, two of which
+ *              overlap and must land in request order, and a read that
+ *              runs past the end of the file, whose part past it must
+ *              read as zeros.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_async_vector(hid_t fapl)
+{
+    H5FD_t      *file = NULL;               /* VFD file struct          */
+    char        filename[1024];             /* filename                 */
+    H5FD_mem_t  types[ASYNC_NPIECES];       /* type of each piece       */
+    haddr_t     addrs[ASYNC_NPIECES];       /* address of each piece    */
+    size_t      sizes[ASYNC_NPIECES];       /* size of each piece       */
+    const void  *wbufs[ASYNC_NPIECES];      /* pieces written           */
+    void        *rbufs[ASYNC_NPIECES];      /* pieces read              */
+    unsigned char *wbuf = NULL;             /* buffer of pieces written */
+    unsigned char *rbuf = NULL;             /* buffer of pieces read    */
+    unsigned char *expect = NULL;           /* expected file contents   */
+    size_t      nbytes = ASYNC_NPIECES * ASYNC_PIECE;
+    size_t      u;                          /* local index variable     */
+
+    h5_fixname(FILENAME[12], fapl, filename, sizeof(filename));
+
+    if(NULL == (wbuf = (unsigned char *)HDmalloc(nbytes)))
+        TEST_ERROR;
+    if(NULL == (rbuf = (unsigned char *)HDmalloc(2 * nbytes)))
+        TEST_ERROR;
+    if(NULL == (expect = (unsigned char *)HDcalloc((size_t)1, 2 * nbytes)))
+        TEST_ERROR;
+    for(u = 0; u < nbytes; u++)
+        wbuf[u] = (unsigned char)(u % 251 + 1);
+
+    /* Piece u is written from block u of the buffer to the block
+     * ASYNC_NPIECES - u - 1 of the file, except that the last piece
+     * overwrites the second half of the first and the first half of the
+     * second.
+     */
+    for(u = 0; u < ASYNC_NPIECES; u++) {
+        types[u] = H5FD_MEM_DRAW;
+        sizes[u] = ASYNC_PIECE;
+        addrs[u] = (haddr_t)((ASYNC_NPIECES - u - 1) * ASYNC_PIECE);
+        wbufs[u] = wbuf + u * ASYNC_PIECE;
+    } /* end for */
+    addrs[ASYNC_NPIECES - 1] = addrs[0] - ASYNC_PIECE / 2;
+    for(u = 0; u < ASYNC_NPIECES; u++)
+        HDmemcpy(expect + addrs[u], wbufs[u], sizes[u]);
+
+    if(NULL == (file = H5FDopen(filename, H5F_ACC_RDWR | H5F_ACC_CREAT | H5F_ACC_TRUNC, fapl, HADDR_UNDEF)))
+        TEST_ERROR;
+    if(H5FDset_eoa(file, H5FD_MEM_DRAW, (haddr_t)(2 * nbytes)) < 0)
+        TEST_ERROR;
+    if(H5FDwrite_vector(file, H5P_DEFAULT, (size_t)ASYNC_NPIECES, types, addrs, sizes, wbufs) < 0)
+        TEST_ERROR;
+    if(H5FDget_eof(file, H5FD_MEM_DRAW) != (haddr_t)nbytes)
+        FAIL_PUTS_ERROR("wrong end of file after vector write");
+
+    /* Read the file back, and as much again past its end */
+    HDmemset(rbuf, 0xff, 2 * nbytes);
+    for(u = 0; u < ASYNC_NPIECES; u++) {
+        sizes[u] = 2 * ASYNC_PIECE;
+        addrs[u] = (haddr_t)(u * 2 * ASYNC_PIECE);
+        rbufs[u] = rbuf + u * 2 * ASYNC_PIECE;
+    } /* end for */
+    if(H5FDread_vector(file, H5P_DEFAULT, (size_t)ASYNC_NPIECES, types, addrs, sizes, rbufs) < 0)
+        TEST_ERROR;
+    if(HDmemcmp(rbuf, expect, 2 * nbytes))
+        FAIL_PUTS_ERROR("wrong data read by vector read");
+
+    if(H5FDclose(file) < 0)
+        TEST_ERROR;
+    file = NULL;
+    h5_delete_test_file(FILENAME[12], fapl);
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(expect);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(file)
+            H5FDclose(file);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(expect);
+    return -1;
+} /* end test_async_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_async
+ *
+ * Purpose:     Tests the async driver: its properties, the engine an
+ *              open file reports, and vector I/O and dataset I/O with
+ *              each engine available, with a queue depth small enough
+ *              that the queue is refilled many times per request.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_async(void)
+{
+#ifdef H5_HAVE_ASYNC_VFD
+    hid_t       fid = -1;                   /* file ID                      */
+    hid_t       fapl = -1;                  /* file access property list ID */
+    hid_t       fapl_out = -1;              /* from H5Fget_access_plist     */
+    char        filename[1024];             /* filename                     */
+    void        *os_file_handle = NULL;     /* OS file handle               */
+    hsize_t     file_size;                  /* file size                    */
+    unsigned    depth;                      /* queue depth                  */
+    H5FD_async_engine_t engine;             /* engine                       */
+    H5FD_t      *file = NULL;               /* VFD file struct              */
+    int         i;                          /* local index variable         */
+    herr_t      ret;                        /* generic return value         */
+#endif /* H5_HAVE_ASYNC_VFD */
+
+    TESTING("ASYNC file driver");
+
+#ifndef H5_HAVE_ASYNC_VFD
+    SKIPPED();
+    return 0;
+#else /* H5_HAVE_ASYNC_VFD */
+    if((fapl = h5_fileaccess()) < 0)
+        TEST_ERROR;
+
+    /* Check the properties */
+    if(H5Pset_fapl_async(fapl, 0, H5FD_ASYNC_ENGINE_DEFAULT) < 0)
+        TEST_ERROR;
+    if(H5Pget_fapl_async(fapl, &depth, &engine) < 0)
+        TEST_ERROR;
+    if(H5FD_ASYNC_QUEUE_DEPTH_DEF != depth || H5FD_ASYNC_ENGINE_DEFAULT != engine)
+        FAIL_PUTS_ERROR("wrong async properties");
+    H5E_BEGIN_TRY {
+        ret = H5Pset_fapl_async(fapl, H5FD_ASYNC_QUEUE_DEPTH_MAX + 1, H5FD_ASYNC_ENGINE_DEFAULT);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("queue depth too large was accepted");
+    H5E_BEGIN_TRY {
+        ret = H5Pset_fapl_async(fapl, 0, (H5FD_async_engine_t)(H5FD_ASYNC_ENGINE_SYNC + 1));
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("invalid engine was accepted");
+
+    /* An open file reports the engine it is using */
+    h5_fixname(FILENAME[12], fapl, filename, sizeof(filename));
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR;
+    if((fapl_out = H5Fget_access_plist(fid)) < 0)
+        TEST_ERROR;
+    if(H5FD_ASYNC != H5Pget_driver(fapl_out))
+        TEST_ERROR;
+    if(H5Pget_fapl_async(fapl_out, &depth, &engine) < 0)
+        TEST_ERROR;
+    if(H5FD_ASYNC_QUEUE_DEPTH_DEF != depth)
+        FAIL_PUTS_ERROR("wrong queue depth for open file");
+    if(H5FD_ASYNC_ENGINE_IO_URING != engine && H5FD_ASYNC_ENGINE_LINUX_AIO != engine && H5FD_ASYNC_ENGINE_SYNC != engine)
+        FAIL_PUTS_ERROR("open file reports no engine");
+    if(H5Pclose(fapl_out) < 0)
+        TEST_ERROR;
+    if(H5Fget_vfd_handle(fid, H5P_DEFAULT, &os_file_handle) < 0)
+        TEST_ERROR;
+    if(os_file_handle == NULL)
+        FAIL_PUTS_ERROR("NULL os-specific vfd/file handle was returned from H5Fget_vfd_handle");
+    if(H5Fget_filesize(fid, &file_size) < 0)
+        TEST_ERROR;
+    if(file_size < 1 * KB || file_size > 4 * KB)
+        FAIL_PUTS_ERROR("suspicious file size obtained from H5Fget_filesize");
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR;
+    h5_delete_test_file(FILENAME[12], fapl);
+
+    /* Vector and dataset I/O with each engine this system has */
+    for(i = (int)H5FD_ASYNC_ENGINE_IO_URING; i <= (int)H5FD_ASYNC_ENGINE_SYNC; i++) {
+        if(H5Pset_fapl_async(fapl, ASYNC_DEPTH, (H5FD_async_engine_t)i) < 0)
+            TEST_ERROR;
+
+        /* The kernel may not offer this engine */
+        H5E_BEGIN_TRY {
+            file = H5FDopen(filename, H5F_ACC_RDWR | H5F_ACC_CREAT | H5F_ACC_TRUNC, fapl, HADDR_UNDEF);
+        } H5E_END_TRY;
+        if(NULL == file) {
+            if(H5FD_ASYNC_ENGINE_SYNC == (H5FD_async_engine_t)i)
+                FAIL_PUTS_ERROR("can't open file with pread()/pwrite() engine");
+            continue;
+        } /* end if */
+        if(H5FDclose(file) < 0)
+            TEST_ERROR;
+        file = NULL;
+        h5_delete_test_file(FILENAME[12], fapl);
+
+        if(test_vector_io_driver(fapl) < 0)
+            FAIL_PUTS_ERROR("vector I/O");
+        if(test_async_vector(fapl) < 0)
+            FAIL_PUTS_ERROR("vector I/O past queue depth");
+        if(test_vector_io_dset(fapl) < 0)
+            FAIL_PUTS_ERROR("dataset");
+    } /* end for */
+
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(file)
+            H5FDclose(file);
+        H5Pclose(fapl_out);
+        H5Pclose(fapl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+#endif /* H5_HAVE_ASYNC_VFD */
+} /* end test_async() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    main
  *
@@ -1769,6 +2622,9 @@ main(void)
     nerrors += test_log() < 0            ? 1 : 0;
     nerrors += test_stdio() < 0          ? 1 : 0;
     nerrors += test_windows() < 0        ? 1 : 0;
+    nerrors += test_vector_io() < 0      ? 1 : 0;
+    nerrors += test_mmap() < 0           ? 1 : 0;
+    nerrors += test_async() < 0          ? 1 : 0;
 
     if(nerrors) {
         HDprintf("***** %d Virtual File Driver TEST%s FAILED! *****\n",
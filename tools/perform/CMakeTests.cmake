@@ -45,6 +45,17 @@ add_test (NAME PERFORM_perf_meta COMMAND $<TARGET_FILE:perf_meta>)
 add_test (NAME PERFORM_zip_perf_help COMMAND $<TARGET_FILE:zip_perf> "-h")
 add_test (NAME PERFORM_zip_perf COMMAND $<TARGET_FILE:zip_perf> tfilters.h5)
 
+add_test (NAME PERFORM_shuffle_perf COMMAND $<TARGET_FILE:shuffle_perf> -n 1048576 -i 2)
+
+add_test (NAME PERFORM_checksum_perf COMMAND $<TARGET_FILE:checksum_perf> -n 1048576 -i 2)
+
+add_test (NAME PERFORM_sec2_perf COMMAND $<TARGET_FILE:sec2_perf> -s 1048576 -n 1000)
+
+add_test (NAME PERFORM_async_perf COMMAND $<TARGET_FILE:async_perf> -s 4194304 -n 256 -v 16 -q 8)
+
+add_test (NAME PERFORM_pline_perf COMMAND $<TARGET_FILE:pline_perf> -i 2 ${HDF5_TOOLS_DIR}/testfiles/tfilters.h5 /deflate)
+add_test (NAME PERFORM_pline_perf_csv COMMAND $<TARGET_FILE:pline_perf> -i 2 -c -p shuffle+deflate,nbit,fletcher32 ${HDF5_TOOLS_DIR}/testfiles/tfilters.h5 /contiguous)
+
 if (H5_HAVE_PARALLEL)
   add_test (NAME PERFORM_h5perf COMMAND ${MPIEXEC} ${MPIEXEC_PREFLAGS} ${MPIEXEC_NUMPROC_FLAG} ${MPIEXEC_MAX_NUMPROCS} ${MPIEXEC_POSTFLAGS} $<TARGET_FILE:h5perf>)
 
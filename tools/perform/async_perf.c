@@ -0,0 +1,324 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Measures random chunk-sized reads, the pattern of reading
+ *		scattered chunks of a dataset, through the sec2 and async
+ *		drivers.  The same random sequence of blocks is read with
+ *		H5FDread() one block at a time through the sec2 driver, and
+ *		with H5FDread_vector() a batch of blocks at a time through
+ *		the sec2 driver and through the async driver with each
+ *		engine it has.  Every block read is checked.
+ *
+ *		Once the file has been written it is usually in the page
+ *		cache, which hides most of what queueing the reads saves;
+ *		drop the cache before running, or use a file larger than
+ *		memory, to measure reads from the device.
+ */
+
+#include "hdf5.h"
+#include "H5private.h"
+
+#define ONE_MB		(1024 * 1024)
+#define DEF_FILE_SIZE	(256 * ONE_MB)	/* Default size of the file read */
+#define DEF_BLOCK_SIZE	(64 * 1024)	/* Default size of each read */
+#define DEF_NREADS	4096		/* Default number of reads timed */
+#define DEF_BATCH	64		/* Default number of reads per vector */
+#define DEF_FILENAME	"async_perf.h5"	/* Default name of the file read */
+
+/* The ways the reads are made */
+typedef enum {
+    READ_SEC2,          /* H5FDread() through the sec2 driver */
+    READ_SEC2_VECTOR,   /* H5FDread_vector() through the sec2 driver */
+    READ_URING,         /* H5FDread_vector() through io_uring */
+    READ_AIO,           /* H5FDread_vector() through Linux AIO */
+    READ_SYNC,          /* H5FDread_vector() through the async driver's pread() */
+    READ_NMODES
+} read_mode_t;
+
+static const char *mode_name[READ_NMODES] = {"sec2", "sec2 vector",
+    "io_uring", "linux aio", "async sync"};
+
+
+/*-------------------------------------------------------------------------
+ * Function:	usage
+ *
+ * Purpose:	Prints a usage message and exits.
+ *
+ * Return:	never returns
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-s FILESIZE] [-b BLOCKSIZE] [-n NREADS] [-v BATCH] [-q DEPTH] [-f FILENAME]\n", prog);
+    fprintf(stderr, "\
+    Writes a file of FILESIZE bytes (default %d) named FILENAME (default\n\
+    %s), then reads NREADS blocks (default %d) of BLOCKSIZE bytes\n\
+    (default %d) from it at random block-aligned offsets in each of the\n\
+    ways measured, and prints the rate of each.  Vector reads are of\n\
+    BATCH blocks (default %d); the async driver keeps DEPTH (default %d)\n\
+    of them outstanding.\n",
+            DEF_FILE_SIZE, DEF_FILENAME, DEF_NREADS, DEF_BLOCK_SIZE, DEF_BATCH,
+            H5FD_ASYNC_QUEUE_DEPTH_DEF);
+    exit(1);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	check_block
+ *
+ * Purpose:	Checks that a block read holds its block number, which is
+ *		written at its start.
+ *
+ * Return:	TRUE if it does, FALSE if not
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+check_block(const uint8_t *buf, hsize_t block)
+{
+    hsize_t	stored;
+
+    HDmemcpy(&stored, buf, sizeof(stored));
+
+    return (hbool_t)(stored == block);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	time_reads
+ *
+ * Purpose:	Times the reads of the blocks in BLOCKS through the file
+ *		driver set in FAPL, singly or BATCH at a time.
+ *
+ * Return:	Success:	Elapsed wall-clock seconds
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+time_reads(read_mode_t mode, const char *filename, hid_t fapl, hbool_t vector,
+    const hsize_t *blocks, size_t nreads, size_t batch, size_t block_size,
+    hsize_t file_size)
+{
+    H5FD_t	*file = NULL;
+    uint8_t	*buf = NULL;
+    H5FD_mem_t	*types = NULL;
+    haddr_t	*addrs = NULL;
+    size_t	*sizes = NULL;
+    void	**bufs = NULL;
+    H5_timer_t	timer, total;
+    size_t	u, v, n;
+    double	ret_value = -1.0;
+
+    if(NULL == (buf = (uint8_t *)HDmalloc(batch * block_size)))
+        goto done;
+    if(NULL == (types = (H5FD_mem_t *)HDmalloc(batch * sizeof(H5FD_mem_t))))
+        goto done;
+    if(NULL == (addrs = (haddr_t *)HDmalloc(batch * sizeof(haddr_t))))
+        goto done;
+    if(NULL == (sizes = (size_t *)HDmalloc(batch * sizeof(size_t))))
+        goto done;
+    if(NULL == (bufs = (void **)HDmalloc(batch * sizeof(void *))))
+        goto done;
+    for(v = 0; v < batch; v++) {
+        types[v] = H5FD_MEM_DRAW;
+        sizes[v] = block_size;
+        bufs[v] = buf + v * block_size;
+    }
+
+    if(NULL == (file = H5FDopen(filename, H5F_ACC_RDONLY, fapl, HADDR_UNDEF)))
+        goto done;
+    if(H5FDset_eoa(file, H5FD_MEM_DEFAULT, (haddr_t)file_size) < 0)
+        goto done;
+
+    H5_timer_reset(&total);
+    H5_timer_begin(&timer);
+    for(u = 0; u < nreads; u += n) {
+        n = MIN(batch, nreads - u);
+        for(v = 0; v < n; v++)
+            addrs[v] = (haddr_t)(blocks[u + v] * block_size);
+
+        if(vector) {
+            if(H5FDread_vector(file, H5P_DEFAULT, n, types, addrs, sizes, bufs) < 0)
+                goto done;
+        }
+        else
+            for(v = 0; v < n; v++)
+                if(H5FDread(file, H5FD_MEM_DRAW, H5P_DEFAULT, addrs[v], block_size, bufs[v]) < 0)
+                    goto done;
+
+        for(v = 0; v < n; v++)
+            if(!check_block((const uint8_t *)bufs[v], blocks[u + v])) {
+                fprintf(stderr, "%s: wrong data read from block %llu\n",
+                        mode_name[mode], (unsigned long long)blocks[u + v]);
+                goto done;
+            }
+    }
+    H5_timer_end(&total, &timer);
+
+    ret_value = total.etime;
+
+done:
+    if(file)
+        H5FDclose(file);
+    HDfree(bufs);
+    HDfree(sizes);
+    HDfree(addrs);
+    HDfree(types);
+    HDfree(buf);
+
+    return ret_value;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	main
+ *
+ * Purpose:	Runs the random chunk read benchmark.
+ *
+ * Return:	Success:	0
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(int argc, char *argv[])
+{
+    hsize_t	file_size = DEF_FILE_SIZE;
+    size_t	block_size = DEF_BLOCK_SIZE;
+    size_t	nreads = DEF_NREADS;
+    size_t	batch = DEF_BATCH;
+    unsigned	depth = H5FD_ASYNC_QUEUE_DEPTH_DEF;
+    const char	*filename = DEF_FILENAME;
+    hsize_t	nblocks, block;
+    hsize_t	*blocks = NULL;
+    uint8_t	*buf = NULL;
+    H5FD_t	*file = NULL;
+    hid_t	fapl = -1;
+    size_t	u;
+    int		argno, mode;
+
+    /* Parse command-line options */
+    for(argno = 1; argno < argc; argno++) {
+        if(!HDstrcmp(argv[argno], "-s") && argno + 1 < argc)
+            file_size = (hsize_t)HDstrtoull(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-b") && argno + 1 < argc)
+            block_size = (size_t)HDstrtoul(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-n") && argno + 1 < argc)
+            nreads = (size_t)HDstrtoul(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-v") && argno + 1 < argc)
+            batch = (size_t)HDstrtoul(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-q") && argno + 1 < argc)
+            depth = (unsigned)HDstrtoul(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-f") && argno + 1 < argc)
+            filename = argv[++argno];
+        else
+            usage(argv[0]);
+    }
+    if(block_size < sizeof(hsize_t) || file_size < block_size || 0 == nreads ||
+            0 == batch || depth > H5FD_ASYNC_QUEUE_DEPTH_MAX)
+        usage(argv[0]);
+    nblocks = file_size / block_size;
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        goto error;
+    if(H5Pset_fapl_sec2(fapl) < 0)
+        goto error;
+
+    /* Write the file, each block starting with its block number */
+    if(NULL == (buf = (uint8_t *)HDcalloc((size_t)1, block_size)))
+        goto error;
+    if(NULL == (file = H5FDopen(filename, H5F_ACC_RDWR | H5F_ACC_CREAT | H5F_ACC_TRUNC, fapl, HADDR_UNDEF)))
+        goto error;
+    if(H5FDset_eoa(file, H5FD_MEM_DEFAULT, (haddr_t)(nblocks * block_size)) < 0)
+        goto error;
+    for(block = 0; block < nblocks; block++) {
+        HDmemcpy(buf, &block, sizeof(block));
+        if(H5FDwrite(file, H5FD_MEM_DRAW, H5P_DEFAULT, (haddr_t)(block * block_size), block_size, buf) < 0)
+            goto error;
+    }
+    if(H5FDclose(file) < 0)
+        goto error;
+    file = NULL;
+
+    /* Pick the blocks read */
+    if(NULL == (blocks = (hsize_t *)HDmalloc(nreads * sizeof(hsize_t))))
+        goto error;
+    for(u = 0; u < nreads; u++)
+        blocks[u] = (hsize_t)HDrandom() % nblocks;
+
+    printf("Reading %lu random %lu-byte blocks from a %llu-byte file, %lu per vector\n",
+           (unsigned long)nreads, (unsigned long)block_size,
+           (unsigned long long)(nblocks * block_size), (unsigned long)batch);
+    printf("%-12s  %12s  %12s  %10s\n", "Reads", "Reads/s", "Bandwidth", "us/read");
+    printf("%-12s  %12s  %12s  %10s\n", "-----", "-------", "---------", "-------");
+    for(mode = 0; mode < READ_NMODES; mode++) {
+        char	bw[32];
+        double	t;
+
+        if(mode >= READ_URING) {
+#ifdef H5_HAVE_ASYNC_VFD
+            H5FD_async_engine_t engine = READ_URING == mode ? H5FD_ASYNC_ENGINE_IO_URING :
+                    (READ_AIO == mode ? H5FD_ASYNC_ENGINE_LINUX_AIO : H5FD_ASYNC_ENGINE_SYNC);
+
+            if(H5Pset_fapl_async(fapl, depth, engine) < 0)
+                goto error;
+
+            /* The kernel may not offer this engine */
+            H5E_BEGIN_TRY {
+                file = H5FDopen(filename, H5F_ACC_RDONLY, fapl, HADDR_UNDEF);
+            } H5E_END_TRY;
+            if(NULL == file) {
+                printf("%-12s  %12s\n", mode_name[mode], "(unavailable)");
+                continue;
+            }
+            if(H5FDclose(file) < 0)
+                goto error;
+            file = NULL;
+#else /* H5_HAVE_ASYNC_VFD */
+            printf("%-12s  %12s\n", mode_name[mode], "(no async)");
+            continue;
+#endif /* H5_HAVE_ASYNC_VFD */
+        }
+
+        if((t = time_reads((read_mode_t)mode, filename, fapl, (hbool_t)(READ_SEC2 != mode),
+                blocks, nreads, batch, block_size, nblocks * block_size)) < 0.0)
+            goto error;
+        H5_bandwidth(bw, (double)nreads * (double)block_size, t);
+        printf("%-12s  %12.0f  %12s  %10.3f\n", mode_name[mode],
+               t > 0.0 ? (double)nreads / t : 0.0, bw, 1.0e6 * t / (double)nreads);
+    }
+
+    HDfree(blocks);
+    HDfree(buf);
+    H5Pclose(fapl);
+    HDremove(filename);
+
+    return 0;
+
+error:
+    if(file)
+        H5FDclose(file);
+    HDfree(blocks);
+    HDfree(buf);
+    if(fapl >= 0)
+        H5Pclose(fapl);
+    HDremove(filename);
+    fprintf(stderr, "*** ERRORS DETECTED ***\n");
+    return 1;
+}
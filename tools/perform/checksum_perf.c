@@ -0,0 +1,269 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Measures the speed of the library's checksums: fletcher32
+ *		(the fletcher32 filter), the CRC and lookup3 (metadata).  The
+ *		fletcher32 and CRC results are checked against, and their
+ *		speed compared with, the simplest portable implementations.
+ */
+
+#include "hdf5.h"
+#include "H5private.h"
+
+#define ONE_MB		(1024 * 1024)
+#define DEF_NBYTES	(16 * ONE_MB)	/* Default size of the buffer summed */
+#define DEF_NITER	10		/* Default number of passes timed */
+
+/* The checksums timed */
+typedef enum {
+    CHKSUM_FLETCHER32,
+    CHKSUM_CRC,
+    CHKSUM_LOOKUP3,
+    CHKSUM_NALGS
+} chksum_alg_t;
+
+static const char *alg_name[CHKSUM_NALGS] = {"fletcher32", "crc", "lookup3"};
+
+
+/*-------------------------------------------------------------------------
+ * Function:	usage
+ *
+ * Purpose:	Prints a usage message and exits.
+ *
+ * Return:	never returns
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-n NBYTES] [-i NITER]\n", prog);
+    fprintf(stderr, "\
+    Checksums a buffer of NBYTES bytes (default %d) NITER times\n\
+    (default %d) with each of the library's checksums, and prints the\n\
+    speed of each.\n", DEF_NBYTES, DEF_NITER);
+    exit(1);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	ref_fletcher32
+ *
+ * Purpose:	Portable fletcher32 checksum, one 16-bit word at a time.
+ *
+ * Return:	32-bit fletcher checksum
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint32_t
+ref_fletcher32(const uint8_t *data, size_t len)
+{
+    uint32_t	sum1 = 0, sum2 = 0;
+    size_t	u;
+
+    for(u = 0; u + 1 < len; u += 2) {
+        sum1 += ((uint32_t)data[u] << 8) | (uint32_t)data[u + 1];
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 += sum1;
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+    if(len % 2) {
+        sum1 += (uint32_t)data[len - 1] << 8;
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 += sum1;
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+
+    return (sum2 << 16) | sum1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	ref_crc
+ *
+ * Purpose:	Portable CRC checksum, one byte at a time from a single
+ *		table.
+ *
+ * Return:	32-bit CRC
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint32_t
+ref_crc(const uint8_t *data, size_t len)
+{
+    static uint32_t table[256];
+    static hbool_t table_made = FALSE;
+    uint32_t	crc = 0xffffffff;
+    size_t	u;
+
+    if(!table_made) {
+        unsigned n, k;
+
+        for(n = 0; n < 256; n++) {
+            uint32_t c = (uint32_t)n;
+
+            for(k = 0; k < 8; k++)
+                c = (c & 1) ? (0x04C11DB7 ^ (c >> 1)) : (c >> 1);
+            table[n] = c;
+        }
+        table_made = TRUE;
+    }
+
+    for(u = 0; u < len; u++)
+        crc = table[(crc ^ data[u]) & 0xff] ^ (crc >> 8);
+
+    return crc ^ 0xffffffff;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	chksum
+ *
+ * Purpose:	Checksums NBYTES bytes at BUF with one of the library's
+ *		checksums (LIB set) or its portable reference version.
+ *
+ * Return:	The checksum
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint32_t
+chksum(chksum_alg_t alg, hbool_t lib, const uint8_t *buf, size_t nbytes)
+{
+    switch(alg) {
+        case CHKSUM_FLETCHER32:
+            return lib ? H5_checksum_fletcher32(buf, nbytes) : ref_fletcher32(buf, nbytes);
+
+        case CHKSUM_CRC:
+            return lib ? H5_checksum_crc(buf, nbytes) : ref_crc(buf, nbytes);
+
+        case CHKSUM_LOOKUP3:
+        case CHKSUM_NALGS:
+        default:
+            return H5_checksum_lookup3(buf, nbytes, 0);
+    }
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	time_chksum
+ *
+ * Purpose:	Times NITER passes of one checksum over NBYTES bytes.
+ *
+ * Return:	Elapsed wall-clock seconds
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+time_chksum(chksum_alg_t alg, hbool_t lib, const uint8_t *buf, size_t nbytes,
+    unsigned niter)
+{
+    H5_timer_t	timer, total;
+    uint32_t	sum = 0;
+    unsigned	u;
+
+    H5_timer_reset(&total);
+    H5_timer_begin(&timer);
+    for(u = 0; u < niter; u++)
+        sum ^= chksum(alg, lib, buf, nbytes);
+    H5_timer_end(&total, &timer);
+
+    /* (Keep the compiler from dropping the checksums) */
+    if(sum == 0x12345678)
+        printf("\n");
+
+    return total.etime;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	main
+ *
+ * Purpose:	Runs the checksum benchmark.
+ *
+ * Return:	Success:	0
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(int argc, char *argv[])
+{
+    size_t	nbytes = DEF_NBYTES;
+    unsigned	niter = DEF_NITER;
+    uint8_t	*buf = NULL;
+    size_t	i;
+    int		argno, alg, nerrors = 0;
+
+    /* Parse command-line options */
+    for(argno = 1; argno < argc; argno++) {
+        if(!HDstrcmp(argv[argno], "-n") && argno + 1 < argc)
+            nbytes = (size_t)HDstrtoul(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-i") && argno + 1 < argc)
+            niter = (unsigned)HDstrtoul(argv[++argno], NULL, 0);
+        else
+            usage(argv[0]);
+    }
+    if(0 == nbytes || 0 == niter)
+        usage(argv[0]);
+
+    if(H5open() < 0)
+        goto error;
+
+    if(NULL == (buf = (uint8_t *)HDmalloc(nbytes)))
+        goto error;
+    for(i = 0; i < nbytes; i++)
+        buf[i] = (uint8_t)HDrandom();
+
+    printf("Checksumming %lu bytes %u times\n", (unsigned long)nbytes, niter);
+    printf("%-10s  %10s  %10s %7s\n", "Checksum", "Library", "Portable", "");
+    printf("%-10s  %10s  %10s %7s\n", "--------", "-------", "--------", "");
+    for(alg = 0; alg < CHKSUM_NALGS; alg++) {
+        char	bw[2][32];
+        double	t[2];
+
+        /* lookup3 has no separate portable version */
+        if(alg == CHKSUM_LOOKUP3) {
+            t[0] = time_chksum((chksum_alg_t)alg, TRUE, buf, nbytes, niter);
+            H5_bandwidth(bw[0], (double)nbytes * niter, t[0]);
+            printf("%-10s  %10s  %10s\n", alg_name[alg], bw[0], "-");
+            continue;
+        }
+
+        /* Check the library's checksum before timing it */
+        if(chksum((chksum_alg_t)alg, TRUE, buf, nbytes) != chksum((chksum_alg_t)alg, FALSE, buf, nbytes)) {
+            fprintf(stderr, "%s checksum differs from the portable one\n", alg_name[alg]);
+            nerrors++;
+            continue;
+        }
+
+        t[0] = time_chksum((chksum_alg_t)alg, TRUE, buf, nbytes, niter);
+        t[1] = time_chksum((chksum_alg_t)alg, FALSE, buf, nbytes, niter);
+        H5_bandwidth(bw[0], (double)nbytes * niter, t[0]);
+        H5_bandwidth(bw[1], (double)nbytes * niter, t[1]);
+        printf("%-10s  %10s  %10s %6.2fx\n", alg_name[alg], bw[0], bw[1],
+               t[0] > 0.0 ? t[1] / t[0] : 0.0);
+    }
+
+    HDfree(buf);
+
+    if(nerrors)
+        goto error;
+    return 0;
+
+error:
+    fprintf(stderr, "*** ERRORS DETECTED ***\n");
+    return 1;
+}
@@ -73,6 +73,10 @@
 /* #define DIAG_W0		0.65F */
 /* #define DIAG_NRDCC		521 */
 
+/* Hot window plus scan test */
+#define HS_CACHE	25		/*cache size in chunks		*/
+#define HS_HOT		3		/*hot window, squared in chunks	*/
+
 static size_t	nio_g;
 static hid_t	fapl_g = -1;
 
@@ -323,6 +327,75 @@ test_diag (int op, size_t cache_size, size_t io_size, size_t offset)
     return (double)nio/(double)nio_g;
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	test_hotscan
+ *
+ * Purpose:	Alternates between reading a small window of "hot" chunks
+ *		in the corner of the dataset and reading the next row of
+ *		chunks one chunk at a time, so the whole dataset is scanned
+ *		once while the hot chunks are read DS_SIZE times.  A
+ *		scan-resistant chunk cache replacement policy keeps the hot
+ *		chunks cached during the scan.
+ *
+ * Return:	Efficiency.
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+test_hotscan (H5D_chunk_cache_policy_t policy, size_t cache_size)
+{
+    hid_t	file, dset, dapl, mem_space, file_space;
+    hsize_t	i, j, hs_size[2];
+    hsize_t	hs_offset[2];
+    hsize_t	nio = 0;
+    signed char	*buf = (signed char *)calloc(1, (size_t)(SQUARE (HS_HOT*CH_SIZE)));
+
+    dapl = H5Pcreate (H5P_DATASET_ACCESS);
+    H5Pset_chunk_cache (dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT,
+			cache_size*SQUARE (CH_SIZE), H5D_CHUNK_CACHE_W0_DEFAULT);
+    H5Pset_chunk_cache_policy (dapl, policy);
+    file = H5Fopen(FILE_NAME, H5F_ACC_RDONLY, fapl_g);
+    dset = H5Dopen2(file, "dset", dapl);
+    file_space = H5Dget_space(dset);
+    nio_g = 0;
+
+    for (i=0; i<DS_SIZE; i++) {
+	/* The hot window */
+	hs_offset[0] = hs_offset[1] = 0;
+	hs_size[0] = hs_size[1] = HS_HOT*CH_SIZE;
+	mem_space = H5Screate_simple (2, hs_size, hs_size);
+	H5Sselect_hyperslab (file_space, H5S_SELECT_SET, hs_offset, NULL,
+			     hs_size, NULL);
+	H5Dread (dset, H5T_NATIVE_SCHAR, mem_space, file_space,
+		 H5P_DEFAULT, buf);
+	H5Sclose (mem_space);
+	nio += SQUARE (HS_HOT*CH_SIZE);
+
+	/* The next row of chunks */
+	hs_size[0] = hs_size[1] = CH_SIZE;
+	mem_space = H5Screate_simple (2, hs_size, hs_size);
+	for (j=0; j<DS_SIZE; j++) {
+	    hs_offset[0] = i*CH_SIZE;
+	    hs_offset[1] = j*CH_SIZE;
+	    H5Sselect_hyperslab (file_space, H5S_SELECT_SET, hs_offset, NULL,
+				 hs_size, NULL);
+	    H5Dread (dset, H5T_NATIVE_SCHAR, mem_space, file_space,
+		     H5P_DEFAULT, buf);
+	    nio += SQUARE (CH_SIZE);
+	}
+	H5Sclose (mem_space);
+    }
+
+    free (buf);
+    H5Sclose (file_space);
+    H5Dclose (dset);
+    H5Fclose (file);
+    H5Pclose (dapl);
+
+    return (double)nio/(double)nio_g;
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:	main
@@ -542,6 +615,17 @@ main (void)
     fprintf (f, "pause -1\n");
 #endif
 
+#if 1
+    /*
+     * Compare the chunk cache replacement policies on repeated reads of a
+     * few chunks mixed with a scan of the whole dataset.
+     */
+    printf ("Hotscan   %8d %8s %8.2f\n", HS_CACHE, "LRU",
+	    test_hotscan (H5D_CHUNK_CACHE_LRU, HS_CACHE));
+    printf ("Hotscan   %8d %8s %8.2f\n", HS_CACHE, "2Q",
+	    test_hotscan (H5D_CHUNK_CACHE_2Q, HS_CACHE));
+#endif
+
 
     H5Pclose (fapl_g);
     fclose (f);
@@ -0,0 +1,710 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Measures how well, and how fast, filter pipelines work on the
+ *		data of an existing dataset.  The dataset is read one chunk
+ *		at a time (contiguous and compact datasets are cut into
+ *		chunks of about 1MB) and the chunks are run through each
+ *		pipeline with H5Z_pipeline, the way the library filters them
+ *		when writing and reading the dataset.  For each pipeline and
+ *		number of threads the compression ratio and the encoding and
+ *		decoding speeds are printed, as a table or as CSV.
+ */
+
+#include "hdf5.h"
+#include "H5private.h"
+#include "H5Eprivate.h"
+#include "H5Oprivate.h"
+#include "H5Pprivate.h"
+#include "H5Zprivate.h"
+
+/*
+ * Running the pipeline in several threads requires a thread-safe build, as
+ * for the parallel chunk decoding in the library (see H5Dchunk.c)
+ */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5Z_DEBUG) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK)
+#define PLINE_PERF_THREADS
+#include "H5TSprivate.h"
+#endif
+
+#define ONE_MB		(1024 * 1024)
+#define DEF_NITER	3		/* Default number of passes timed */
+#define DEF_CHUNK_NBYTES ONE_MB		/* Size of the chunks of unchunked datasets */
+#define MAX_THREADS	64		/* Largest number of threads */
+#define MAX_NTHREADS	16		/* Largest number of thread counts */
+
+/* The pipelines tried by default */
+static const char *def_plines[] = {
+    "shuffle",
+    "deflate",
+    "shuffle+deflate",
+    "bitshuffle_lz",
+    "nbit",
+    "nbit+deflate",
+    "scaleoffset",
+    "scaleoffset+deflate",
+    "szip",
+    NULL
+};
+
+/* A chunk of the dataset, and its filtered version */
+typedef struct {
+    uint8_t	*raw;		/* Chunk data */
+    void	*enc;		/* Filtered chunk */
+    size_t	enc_nbytes;	/* Size of filtered chunk */
+    size_t	enc_alloc;	/* Bytes allocated for filtered chunk */
+    unsigned	filter_mask;	/* Filters skipped for the chunk */
+} chunk_t;
+
+/* What the threads running a pipeline share */
+typedef struct {
+    const H5O_pline_t *pline;	/* Pipeline run */
+    chunk_t	*chunk;		/* Chunks of the dataset */
+    size_t	nchunks;	/* # of chunks */
+    size_t	chunk_nbytes;	/* Size of each chunk */
+    hbool_t	decode;		/* Whether to decode the filtered chunks */
+    hbool_t	check;		/* Whether to compare the decoded chunks with the originals */
+    unsigned	nthreads;	/* # of threads */
+    int		nerrors;	/* # of pipeline failures */
+    int		nlossy;		/* # of chunks decoded differently */
+} run_t;
+
+/* One thread's part of a run */
+typedef struct {
+    run_t	*run;		/* Shared information */
+    unsigned	thread_idx;	/* Thread's index */
+    int		nerrors;	/* # of pipeline failures in the thread */
+    int		nlossy;		/* # of chunks the thread decoded differently */
+} run_thread_t;
+
+
+/*-------------------------------------------------------------------------
+ * Function:	usage
+ *
+ * Purpose:	Prints a usage message and exits.
+ *
+ * Return:	never returns
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+usage(const char *prog)
+{
+    int i;
+
+    fprintf(stderr, "usage: %s [-i NITER] [-t NTHREADS,...] [-p PIPELINE,...] [-c] FILE DATASET\n", prog);
+    fprintf(stderr, "\
+    Runs the chunks of DATASET in FILE through filter pipelines NITER\n\
+    times (default %d) with each number of threads NTHREADS (default 1),\n\
+    and prints the compression ratio and the encoding and decoding\n\
+    speeds of each pipeline.  -c prints them as CSV.\n\
+\n\
+    A pipeline is a list of filters separated by '+', each one of\n\
+    shuffle, bitshuffle_lz, nbit, scaleoffset[=N], deflate[=LEVEL],\n\
+    szip or fletcher32.  N is the number of decimal digits kept by\n\
+    scaleoffset for floating-point data (which is otherwise skipped),\n\
+    or the number of bits kept for integers.  The default pipelines are\n\
+   ", DEF_NITER);
+    for(i = 0; def_plines[i]; i++)
+        fprintf(stderr, " %s", def_plines[i]);
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	add_filter
+ *
+ * Purpose:	Adds the filter named by the NAME_LEN characters at NAME
+ *		to DCPL, for data of type TID.
+ *
+ * Return:	Success:	0
+ *		Failure:	-1, with the reason in WHY
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+add_filter(hid_t dcpl, hid_t tid, const char *name, size_t name_len, const char **why)
+{
+    const char	*arg = HDmemchr(name, '=', name_len);
+    H5Z_filter_t filter;
+    unsigned	config = 0;
+    size_t	len = arg ? (size_t)(arg - name) : name_len;
+    int		value = -1;
+    herr_t	ret;
+
+    if(arg)
+        value = (int)HDstrtol(arg + 1, NULL, 10);
+
+    if(len == 7 && !HDstrncmp(name, "shuffle", len))
+        filter = H5Z_FILTER_SHUFFLE;
+    else if(len == 13 && !HDstrncmp(name, "bitshuffle_lz", len))
+        filter = H5Z_FILTER_BITSHUFFLE_LZ;
+    else if(len == 4 && !HDstrncmp(name, "nbit", len))
+        filter = H5Z_FILTER_NBIT;
+    else if(len == 11 && !HDstrncmp(name, "scaleoffset", len))
+        filter = H5Z_FILTER_SCALEOFFSET;
+    else if(len == 7 && !HDstrncmp(name, "deflate", len))
+        filter = H5Z_FILTER_DEFLATE;
+    else if(len == 4 && !HDstrncmp(name, "szip", len))
+        filter = H5Z_FILTER_SZIP;
+    else if(len == 10 && !HDstrncmp(name, "fletcher32", len))
+        filter = H5Z_FILTER_FLETCHER32;
+    else {
+        *why = "unknown filter";
+        return -1;
+    }
+
+    if(H5Zfilter_avail(filter) <= 0 || H5Zget_filter_info(filter, &config) < 0
+            || !(config & H5Z_FILTER_CONFIG_ENCODE_ENABLED)) {
+        *why = "filter not available";
+        return -1;
+    }
+
+    if(filter == H5Z_FILTER_SCALEOFFSET && H5Tget_class(tid) == H5T_FLOAT && value < 0) {
+        *why = "scaleoffset is lossy for floating-point data";
+        return -1;
+    }
+
+    H5E_BEGIN_TRY {
+        switch(filter) {
+            case H5Z_FILTER_SHUFFLE:
+                ret = H5Pset_shuffle(dcpl);
+                break;
+
+            case H5Z_FILTER_BITSHUFFLE_LZ:
+                ret = H5Pset_bitshuffle_lz(dcpl);
+                break;
+
+            case H5Z_FILTER_NBIT:
+                ret = H5Pset_nbit(dcpl);
+                break;
+
+            case H5Z_FILTER_SCALEOFFSET:
+                if(H5Tget_class(tid) == H5T_FLOAT)
+                    ret = H5Pset_scaleoffset(dcpl, H5Z_SO_FLOAT_DSCALE, value);
+                else
+                    ret = H5Pset_scaleoffset(dcpl, H5Z_SO_INT, value < 0 ? H5Z_SO_INT_MINBITS_DEFAULT : value);
+                break;
+
+            case H5Z_FILTER_DEFLATE:
+                ret = H5Pset_deflate(dcpl, value < 0 ? 6 : (unsigned)value);
+                break;
+
+            case H5Z_FILTER_SZIP:
+                ret = H5Pset_szip(dcpl, H5_SZIP_NN_OPTION_MASK, 8);
+                break;
+
+            case H5Z_FILTER_FLETCHER32:
+            default:
+                ret = H5Pset_fletcher32(dcpl);
+                break;
+        }
+    } H5E_END_TRY;
+    if(ret < 0) {
+        *why = "can't set filter";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	make_pline
+ *
+ * Purpose:	Creates a dataset creation property list with the chunk
+ *		dimensions CDIMS and the pipeline described by SPEC, set up
+ *		for data of type TID as when a dataset is created.
+ *
+ * Return:	Success:	The property list
+ *		Failure:	-1, with the reason in WHY
+ *
+ *-------------------------------------------------------------------------
+ */
+static hid_t
+make_pline(const char *spec, hid_t tid, int rank, const hsize_t *cdims, const char **why)
+{
+    hid_t	dcpl = -1;
+    const char	*s, *end;
+    herr_t	ret;
+
+    *why = "can't create property list";
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+    if(H5Pset_chunk(dcpl, rank, cdims) < 0)
+        goto error;
+
+    for(s = spec; *s; s = *end ? end + 1 : end) {
+        if(NULL == (end = HDstrchr(s, '+')))
+            end = s + HDstrlen(s);
+        if(add_filter(dcpl, tid, s, (size_t)(end - s), why) < 0)
+            goto error;
+    }
+
+    /* Let the filters check the datatype and set their parameters */
+    H5E_BEGIN_TRY {
+        ret = H5Z_can_apply(dcpl, tid);
+    } H5E_END_TRY;
+    if(ret < 0) {
+        *why = "can't be applied to the data";
+        goto error;
+    }
+    H5E_BEGIN_TRY {
+        ret = H5Z_set_local(dcpl, tid);
+    } H5E_END_TRY;
+    if(ret < 0) {
+        *why = "can't set local filter parameters";
+        goto error;
+    }
+
+    return dcpl;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+    } H5E_END_TRY;
+    return -1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	run_thread
+ *
+ * Purpose:	Encodes, or decodes, every NTHREADS'th chunk of a run,
+ *		starting at the thread's index.
+ *
+ * Return:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+run_thread(void *_udata)
+{
+    run_thread_t *udata = (run_thread_t *)_udata;
+    run_t	*run = udata->run;
+    H5Z_cb_t	filter_cb = {NULL, NULL};
+    size_t	u;
+
+    for(u = udata->thread_idx; u < run->nchunks; u += run->nthreads) {
+        chunk_t	*chunk = &run->chunk[u];
+        size_t	nbytes, alloc;
+        void	*buf;
+
+        if(!run->decode) {
+            /* Filter a copy of the chunk, keeping the result */
+            H5Z_buf_free(chunk->enc, chunk->enc_alloc);
+            chunk->enc = NULL;
+            chunk->enc_alloc = 0;
+            if(NULL == (buf = H5Z_buf_alloc(run->chunk_nbytes, &alloc))) {
+                udata->nerrors++;
+                continue;
+            }
+            HDmemcpy(buf, chunk->raw, run->chunk_nbytes);
+            nbytes = run->chunk_nbytes;
+            chunk->filter_mask = 0;
+            if(H5Z_pipeline(run->pline, 0, &chunk->filter_mask, H5Z_ENABLE_EDC,
+                    filter_cb, &nbytes, &alloc, &buf) < 0) {
+                H5E_clear_stack(NULL);
+                H5Z_buf_free(buf, alloc);
+                udata->nerrors++;
+                continue;
+            }
+            chunk->enc = buf;
+            chunk->enc_nbytes = nbytes;
+            chunk->enc_alloc = alloc;
+        }
+        else {
+            /* Unfilter a copy of the filtered chunk */
+            if(NULL == chunk->enc || NULL == (buf = H5Z_buf_alloc(chunk->enc_nbytes, &alloc))) {
+                udata->nerrors++;
+                continue;
+            }
+            HDmemcpy(buf, chunk->enc, chunk->enc_nbytes);
+            nbytes = chunk->enc_nbytes;
+            if(H5Z_pipeline(run->pline, H5Z_FLAG_REVERSE, &chunk->filter_mask,
+                    H5Z_ENABLE_EDC, filter_cb, &nbytes, &alloc, &buf) < 0) {
+                H5E_clear_stack(NULL);
+                H5Z_buf_free(buf, alloc);
+                udata->nerrors++;
+                continue;
+            }
+            if(run->check && (nbytes != run->chunk_nbytes
+                    || HDmemcmp(buf, chunk->raw, run->chunk_nbytes)))
+                udata->nlossy++;
+            H5Z_buf_free(buf, alloc);
+        }
+    }
+
+    return NULL;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	time_run
+ *
+ * Purpose:	Runs RUN NITER times with its number of threads.
+ *
+ * Return:	Elapsed wall-clock seconds
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+time_run(run_t *run, unsigned niter)
+{
+    run_thread_t thread_info[MAX_THREADS];
+#ifdef PLINE_PERF_THREADS
+    H5TS_thread_t threads[MAX_THREADS];
+#endif
+    H5_timer_t	timer, total;
+    unsigned	u, v;
+
+    for(v = 0; v < run->nthreads; v++) {
+        thread_info[v].run = run;
+        thread_info[v].thread_idx = v;
+        thread_info[v].nerrors = 0;
+        thread_info[v].nlossy = 0;
+    }
+
+    H5_timer_reset(&total);
+    H5_timer_begin(&timer);
+    for(u = 0; u < niter; u++) {
+#ifdef PLINE_PERF_THREADS
+        for(v = 1; v < run->nthreads; v++)
+            threads[v] = H5TS_create_thread(run_thread, NULL, &thread_info[v]);
+#endif
+        (void)run_thread(&thread_info[0]);
+#ifdef PLINE_PERF_THREADS
+        for(v = 1; v < run->nthreads; v++)
+            H5TS_wait_for_thread(threads[v]);
+#endif
+    }
+    H5_timer_end(&total, &timer);
+
+    for(v = 0; v < run->nthreads; v++) {
+        run->nerrors += thread_info[v].nerrors;
+        run->nlossy += thread_info[v].nlossy;
+    }
+
+    return total.etime;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	read_chunks
+ *
+ * Purpose:	Reads the dataset DSET, of type TID in memory, one chunk of
+ *		dimensions CDIMS at a time.  Partial edge chunks are padded
+ *		with zeros.
+ *
+ * Return:	Success:	The chunks, *NCHUNKS of them
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static chunk_t *
+read_chunks(hid_t dset, hid_t tid, int rank, const hsize_t *dims,
+    const hsize_t *cdims, size_t chunk_nbytes, size_t *nchunks)
+{
+    chunk_t	*chunk = NULL;
+    hid_t	fspace = -1, mspace = -1;
+    hsize_t	scaled[H5S_MAX_RANK], start[H5S_MAX_RANK], count[H5S_MAX_RANK];
+    hsize_t	zero[H5S_MAX_RANK];
+    size_t	n = 1, u;
+    int		i;
+
+    for(i = 0; i < rank; i++) {
+        n *= (size_t)((dims[i] + cdims[i] - 1) / cdims[i]);
+        scaled[i] = zero[i] = 0;
+    }
+    if(n == 0) {
+        fprintf(stderr, "dataset is empty\n");
+        return NULL;
+    }
+    if(NULL == (chunk = (chunk_t *)HDcalloc(n, sizeof(chunk_t))))
+        goto error;
+    if((fspace = H5Dget_space(dset)) < 0)
+        goto error;
+    if((mspace = H5Screate_simple(rank, cdims, NULL)) < 0)
+        goto error;
+
+    for(u = 0; u < n; u++) {
+        if(NULL == (chunk[u].raw = (uint8_t *)HDcalloc(1, chunk_nbytes)))
+            goto error;
+
+        for(i = 0; i < rank; i++) {
+            start[i] = scaled[i] * cdims[i];
+            count[i] = MIN(cdims[i], dims[i] - start[i]);
+        }
+        if(H5Sselect_hyperslab(fspace, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+            goto error;
+        if(H5Sselect_hyperslab(mspace, H5S_SELECT_SET, zero, NULL, count, NULL) < 0)
+            goto error;
+        if(H5Dread(dset, tid, mspace, fspace, H5P_DEFAULT, chunk[u].raw) < 0)
+            goto error;
+
+        /* Move to the next chunk */
+        for(i = rank - 1; i >= 0; i--)
+            if(++scaled[i] * cdims[i] < dims[i])
+                break;
+            else
+                scaled[i] = 0;
+    }
+
+    H5Sclose(mspace);
+    H5Sclose(fspace);
+    *nchunks = n;
+    return chunk;
+
+error:
+    if(chunk) {
+        for(u = 0; u < n; u++)
+            HDfree(chunk[u].raw);
+        HDfree(chunk);
+    }
+    H5E_BEGIN_TRY {
+        H5Sclose(mspace);
+        H5Sclose(fspace);
+    } H5E_END_TRY;
+    return NULL;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	main
+ *
+ * Purpose:	Runs the filter pipeline benchmark.
+ *
+ * Return:	Success:	0
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(int argc, char *argv[])
+{
+    const char	*plines_arg = NULL;	/* Pipelines given with -p */
+    char	*plines_buf = NULL;	/* Copy of plines_arg, split up */
+    const char	*plines[64];		/* Pipelines tried */
+    unsigned	nthreads[MAX_NTHREADS] = {1};	/* Thread counts */
+    unsigned	nnthreads = 1;
+    unsigned	niter = DEF_NITER;
+    hbool_t	csv = FALSE;
+    const char	*fname, *dname;
+    hid_t	file = -1, dset = -1, ftid = -1, tid = -1, space = -1, dcpl = -1;
+    hsize_t	dims[H5S_MAX_RANK], cdims[H5S_MAX_RANK];
+    chunk_t	*chunk = NULL;
+    size_t	nchunks = 0, chunk_nbytes, u;
+    hsize_t	raw_nbytes;
+    int		rank, argno, i, p, nerrors = 0;
+
+    /* Parse command-line options */
+    for(argno = 1; argno < argc && '-' == argv[argno][0]; argno++) {
+        if(!HDstrcmp(argv[argno], "-i") && argno + 1 < argc)
+            niter = (unsigned)HDstrtoul(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-t") && argno + 1 < argc) {
+            char *s = argv[++argno];
+
+            for(nnthreads = 0; *s && nnthreads < MAX_NTHREADS; nnthreads++) {
+                nthreads[nnthreads] = (unsigned)HDstrtoul(s, &s, 0);
+                if(0 == nthreads[nnthreads] || nthreads[nnthreads] > MAX_THREADS)
+                    usage(argv[0]);
+                if(',' == *s)
+                    s++;
+            }
+        }
+        else if(!HDstrcmp(argv[argno], "-p") && argno + 1 < argc)
+            plines_arg = argv[++argno];
+        else if(!HDstrcmp(argv[argno], "-c"))
+            csv = TRUE;
+        else
+            usage(argv[0]);
+    }
+    if(argno + 2 != argc || 0 == niter || 0 == nnthreads)
+        usage(argv[0]);
+    fname = argv[argno];
+    dname = argv[argno + 1];
+
+#ifndef PLINE_PERF_THREADS
+    for(u = 0; u < nnthreads; u++)
+        if(nthreads[u] > 1) {
+            fprintf(stderr, "The library is not thread-safe: using 1 thread only\n");
+            nthreads[0] = 1;
+            nnthreads = 1;
+            break;
+        }
+#endif
+
+    /* The pipelines to try */
+    if(plines_arg) {
+        char *s;
+
+        if(NULL == (plines_buf = HDstrdup(plines_arg)))
+            goto error;
+        for(p = 0, s = HDstrtok(plines_buf, ","); s && p < 63; s = HDstrtok(NULL, ","))
+            plines[p++] = s;
+        plines[p] = NULL;
+    }
+    else {
+        for(p = 0; def_plines[p]; p++)
+            plines[p] = def_plines[p];
+        plines[p] = NULL;
+    }
+
+    /* Open the dataset and find its chunks */
+    if((file = H5Fopen(fname, H5F_ACC_RDONLY, H5P_DEFAULT)) < 0)
+        goto error;
+    if((dset = H5Dopen2(file, dname, H5P_DEFAULT)) < 0)
+        goto error;
+    if((ftid = H5Dget_type(dset)) < 0)
+        goto error;
+    if(H5Tdetect_class(ftid, H5T_VLEN) > 0 || H5Tis_variable_str(ftid) > 0) {
+        fprintf(stderr, "%s: variable-length data can't be filtered\n", dname);
+        goto error;
+    }
+    if((tid = H5Tget_native_type(ftid, H5T_DIR_DEFAULT)) < 0)
+        goto error;
+    if((space = H5Dget_space(dset)) < 0)
+        goto error;
+    if((rank = H5Sget_simple_extent_dims(space, dims, NULL)) <= 0) {
+        fprintf(stderr, "%s: dataset has no dimensions\n", dname);
+        goto error;
+    }
+    if((dcpl = H5Dget_create_plist(dset)) < 0)
+        goto error;
+    if(H5D_CHUNKED == H5Pget_layout(dcpl)) {
+        if(H5Pget_chunk(dcpl, rank, cdims) < 0)
+            goto error;
+    }
+    else {
+        hsize_t nbytes = H5Tget_size(tid);
+
+        /* Cut up the dataset in chunks of about DEF_CHUNK_NBYTES bytes */
+        for(i = 0; i < rank; i++)
+            nbytes *= (cdims[i] = MAX(dims[i], 1));
+        for(i = 0; i < rank && nbytes > DEF_CHUNK_NBYTES; i++) {
+            nbytes /= cdims[i];
+            cdims[i] = MAX(1, DEF_CHUNK_NBYTES / nbytes);
+            nbytes *= cdims[i];
+        }
+    }
+    chunk_nbytes = H5Tget_size(tid);
+    for(i = 0; i < rank; i++)
+        chunk_nbytes *= (size_t)cdims[i];
+    if(NULL == (chunk = read_chunks(dset, tid, rank, dims, cdims, chunk_nbytes, &nchunks)))
+        goto error;
+    raw_nbytes = (hsize_t)nchunks * chunk_nbytes;
+
+    if(csv)
+        printf("pipeline,threads,chunks,raw_bytes,filtered_bytes,ratio,encode_mbps,decode_mbps,lossless\n");
+    else {
+        printf("%s %s: %lu chunks of %lu bytes, %u passes\n", fname, dname,
+               (unsigned long)nchunks, (unsigned long)chunk_nbytes, niter);
+        printf("%-24s %7s %7s %12s %12s %8s\n", "Pipeline", "Threads", "Ratio", "Encode", "Decode", "Lossless");
+        printf("%-24s %7s %7s %12s %12s %8s\n", "--------", "-------", "-----", "------", "------", "--------");
+    }
+
+    for(p = 0; plines[p]; p++) {
+        const H5O_pline_t *pline;
+        H5O_pline_t pline_buf;
+        H5P_genplist_t *plist;
+        const char *why = NULL;
+        hid_t	pdcpl;
+        run_t	run;
+        unsigned t;
+
+        if((pdcpl = make_pline(plines[p], tid, rank, cdims, &why)) < 0) {
+            if(csv)
+                fprintf(stderr, "%s: %s\n", plines[p], why);
+            else
+                printf("%-24s %s\n", plines[p], why);
+            continue;
+        }
+        if(NULL == (plist = H5P_object_verify(pdcpl, H5P_DATASET_CREATE))
+                || H5P_peek(plist, H5O_CRT_PIPELINE_NAME, &pline_buf) < 0) {
+            H5Pclose(pdcpl);
+            goto error;
+        }
+        pline = &pline_buf;
+
+        for(t = 0; t < nnthreads; t++) {
+            char	bw[2][32];
+            double	etime[2];
+            hsize_t	enc_nbytes = 0;
+
+            HDmemset(&run, 0, sizeof(run));
+            run.pline = pline;
+            run.chunk = chunk;
+            run.nchunks = nchunks;
+            run.chunk_nbytes = chunk_nbytes;
+            run.nthreads = nthreads[t];
+
+            /* Time the encoding and decoding, then check the result */
+            etime[0] = time_run(&run, niter);
+            run.decode = TRUE;
+            etime[1] = time_run(&run, niter);
+            run.check = TRUE;
+            (void)time_run(&run, 1);
+            if(run.nerrors) {
+                fprintf(stderr, "%s: filter pipeline failed\n", plines[p]);
+                nerrors++;
+                break;
+            }
+            for(u = 0; u < nchunks; u++)
+                enc_nbytes += chunk[u].enc_nbytes;
+
+            if(csv)
+                printf("%s,%u,%lu,%llu,%llu,%.4f,%.2f,%.2f,%s\n", plines[p], nthreads[t],
+                       (unsigned long)nchunks, (unsigned long long)raw_nbytes,
+                       (unsigned long long)enc_nbytes, (double)raw_nbytes / (double)enc_nbytes,
+                       etime[0] > 0.0 ? (double)raw_nbytes * niter / etime[0] / ONE_MB : 0.0,
+                       etime[1] > 0.0 ? (double)raw_nbytes * niter / etime[1] / ONE_MB : 0.0,
+                       run.nlossy ? "no" : "yes");
+            else {
+                H5_bandwidth(bw[0], (double)raw_nbytes * niter, etime[0]);
+                H5_bandwidth(bw[1], (double)raw_nbytes * niter, etime[1]);
+                printf("%-24s %7u %7.3f %12s %12s %8s\n", plines[p], nthreads[t],
+                       (double)raw_nbytes / (double)enc_nbytes, bw[0], bw[1],
+                       run.nlossy ? "no" : "yes");
+            }
+        }
+
+        for(u = 0; u < nchunks; u++) {
+            chunk[u].enc = H5Z_buf_free(chunk[u].enc, chunk[u].enc_alloc);
+            chunk[u].enc_alloc = 0;
+        }
+        H5Pclose(pdcpl);
+    }
+
+    for(u = 0; u < nchunks; u++)
+        HDfree(chunk[u].raw);
+    HDfree(chunk);
+    HDfree(plines_buf);
+    H5Pclose(dcpl);
+    H5Sclose(space);
+    H5Tclose(tid);
+    H5Tclose(ftid);
+    H5Dclose(dset);
+    H5Fclose(file);
+
+    if(nerrors)
+        goto error;
+    return 0;
+
+error:
+    fprintf(stderr, "*** ERRORS DETECTED ***\n");
+    return 1;
+}
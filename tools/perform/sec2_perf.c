@@ -0,0 +1,281 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Measures small random reads, the pattern of metadata reads,
+ *		through the sec2 driver.  The same random sequence of
+ *		block-sized reads is timed through H5FDread() with the sec2
+ *		driver, and with plain system calls: lseek() followed by
+ *		read(), as the driver did before it used positional I/O,
+ *		and pread().  Every block read is checked.
+ */
+
+#include "hdf5.h"
+#include "H5private.h"
+
+#define ONE_MB		(1024 * 1024)
+#define DEF_FILE_SIZE	(64 * ONE_MB)	/* Default size of the file read */
+#define DEF_BLOCK_SIZE	4096		/* Default size of each read */
+#define DEF_NREADS	100000		/* Default number of reads timed */
+#define DEF_FILENAME	"sec2_perf.h5"	/* Default name of the file read */
+
+/* The ways the reads are made */
+typedef enum {
+    READ_SEC2,          /* H5FDread() through the sec2 driver */
+    READ_LSEEK,         /* lseek() + read() */
+    READ_PREAD,         /* pread() */
+    READ_NMODES
+} read_mode_t;
+
+static const char *mode_name[READ_NMODES] = {"sec2", "lseek+read", "pread"};
+
+
+/*-------------------------------------------------------------------------
+ * Function:	usage
+ *
+ * Purpose:	Prints a usage message and exits.
+ *
+ * Return:	never returns
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-s FILESIZE] [-b BLOCKSIZE] [-n NREADS] [-f FILENAME]\n", prog);
+    fprintf(stderr, "\
+    Writes a file of FILESIZE bytes (default %d) named FILENAME (default\n\
+    %s), then reads NREADS blocks (default %d) of BLOCKSIZE bytes\n\
+    (default %d) from it at random block-aligned offsets in each of the\n\
+    ways measured, and prints the rate of each.\n",
+            DEF_FILE_SIZE, DEF_FILENAME, DEF_NREADS, DEF_BLOCK_SIZE);
+    exit(1);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	check_block
+ *
+ * Purpose:	Checks that a block read holds its block number, which is
+ *		written at its start.
+ *
+ * Return:	TRUE if it does, FALSE if not
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+check_block(const uint8_t *buf, hsize_t block)
+{
+    hsize_t	stored;
+
+    HDmemcpy(&stored, buf, sizeof(stored));
+
+    return (hbool_t)(stored == block);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	time_reads
+ *
+ * Purpose:	Times the reads of the blocks in BLOCKS, one way.
+ *
+ * Return:	Success:	Elapsed wall-clock seconds
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+time_reads(read_mode_t mode, const char *filename, hid_t fapl,
+    const hsize_t *blocks, size_t nreads, size_t block_size, hsize_t file_size)
+{
+    H5FD_t	*file = NULL;
+    int		fd = -1;
+    uint8_t	*buf = NULL;
+    H5_timer_t	timer, total;
+    size_t	u;
+    double	ret_value = -1.0;
+
+    if(NULL == (buf = (uint8_t *)HDmalloc(block_size)))
+        goto done;
+
+    if(READ_SEC2 == mode) {
+        if(NULL == (file = H5FDopen(filename, H5F_ACC_RDONLY, fapl, HADDR_UNDEF)))
+            goto done;
+        if(H5FDset_eoa(file, H5FD_MEM_DEFAULT, (haddr_t)file_size) < 0)
+            goto done;
+    }
+    else if((fd = HDopen(filename, O_RDONLY, 0)) < 0)
+        goto done;
+
+    H5_timer_reset(&total);
+    H5_timer_begin(&timer);
+    for(u = 0; u < nreads; u++) {
+        HDoff_t off = (HDoff_t)(blocks[u] * block_size);
+
+        switch(mode) {
+            case READ_SEC2:
+                if(H5FDread(file, H5FD_MEM_SUPER, H5P_DEFAULT, (haddr_t)off, block_size, buf) < 0)
+                    goto done;
+                break;
+
+            case READ_LSEEK:
+                if(HDlseek(fd, off, SEEK_SET) < 0)
+                    goto done;
+                if(HDread(fd, buf, block_size) != (h5_posix_io_ret_t)block_size)
+                    goto done;
+                break;
+
+            case READ_PREAD:
+#ifdef H5_HAVE_PREADWRITE
+                if(HDpread(fd, buf, block_size, off) != (h5_posix_io_ret_t)block_size)
+                    goto done;
+#endif /* H5_HAVE_PREADWRITE */
+                break;
+
+            case READ_NMODES:
+            default:
+                goto done;
+        }
+
+        if(!check_block(buf, blocks[u])) {
+            fprintf(stderr, "%s: wrong data read from block %llu\n",
+                    mode_name[mode], (unsigned long long)blocks[u]);
+            goto done;
+        }
+    }
+    H5_timer_end(&total, &timer);
+
+    ret_value = total.etime;
+
+done:
+    if(file)
+        H5FDclose(file);
+    if(fd >= 0)
+        HDclose(fd);
+    HDfree(buf);
+
+    return ret_value;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	main
+ *
+ * Purpose:	Runs the random read benchmark.
+ *
+ * Return:	Success:	0
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(int argc, char *argv[])
+{
+    hsize_t	file_size = DEF_FILE_SIZE;
+    size_t	block_size = DEF_BLOCK_SIZE;
+    size_t	nreads = DEF_NREADS;
+    const char	*filename = DEF_FILENAME;
+    hsize_t	nblocks, block;
+    hsize_t	*blocks = NULL;
+    uint8_t	*buf = NULL;
+    H5FD_t	*file = NULL;
+    hid_t	fapl = -1;
+    size_t	u;
+    int		argno, mode;
+
+    /* Parse command-line options */
+    for(argno = 1; argno < argc; argno++) {
+        if(!HDstrcmp(argv[argno], "-s") && argno + 1 < argc)
+            file_size = (hsize_t)HDstrtoull(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-b") && argno + 1 < argc)
+            block_size = (size_t)HDstrtoul(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-n") && argno + 1 < argc)
+            nreads = (size_t)HDstrtoul(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-f") && argno + 1 < argc)
+            filename = argv[++argno];
+        else
+            usage(argv[0]);
+    }
+    if(block_size < sizeof(hsize_t) || file_size < block_size || 0 == nreads)
+        usage(argv[0]);
+    nblocks = file_size / block_size;
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        goto error;
+    if(H5Pset_fapl_sec2(fapl) < 0)
+        goto error;
+
+    /* Write the file, each block starting with its block number */
+    if(NULL == (buf = (uint8_t *)HDcalloc((size_t)1, block_size)))
+        goto error;
+    if(NULL == (file = H5FDopen(filename, H5F_ACC_RDWR | H5F_ACC_CREAT | H5F_ACC_TRUNC, fapl, HADDR_UNDEF)))
+        goto error;
+    if(H5FDset_eoa(file, H5FD_MEM_DEFAULT, (haddr_t)(nblocks * block_size)) < 0)
+        goto error;
+    for(block = 0; block < nblocks; block++) {
+        HDmemcpy(buf, &block, sizeof(block));
+        if(H5FDwrite(file, H5FD_MEM_DRAW, H5P_DEFAULT, (haddr_t)(block * block_size), block_size, buf) < 0)
+            goto error;
+    }
+    if(H5FDclose(file) < 0)
+        goto error;
+    file = NULL;
+
+    /* Pick the blocks read */
+    if(NULL == (blocks = (hsize_t *)HDmalloc(nreads * sizeof(hsize_t))))
+        goto error;
+    for(u = 0; u < nreads; u++)
+        blocks[u] = (hsize_t)HDrandom() % nblocks;
+
+    printf("Reading %lu random %lu-byte blocks from a %llu-byte file\n",
+           (unsigned long)nreads, (unsigned long)block_size, (unsigned long long)(nblocks * block_size));
+    printf("%-12s  %12s  %12s  %10s\n", "Reads", "Reads/s", "Bandwidth", "us/read");
+    printf("%-12s  %12s  %12s  %10s\n", "-----", "-------", "---------", "-------");
+    for(mode = 0; mode < READ_NMODES; mode++) {
+        char	bw[32];
+        double	t;
+
+#ifndef H5_HAVE_PREADWRITE
+        if(READ_PREAD == mode) {
+            printf("%-12s  %12s\n", mode_name[mode], "(no pread)");
+            continue;
+        }
+#endif /* H5_HAVE_PREADWRITE */
+
+        if((t = time_reads((read_mode_t)mode, filename, fapl, blocks, nreads, block_size, nblocks * block_size)) < 0.0)
+            goto error;
+        H5_bandwidth(bw, (double)nreads * (double)block_size, t);
+        printf("%-12s  %12.0f  %12s  %10.3f\n", mode_name[mode],
+               t > 0.0 ? (double)nreads / t : 0.0, bw, 1.0e6 * t / (double)nreads);
+    }
+
+    HDfree(blocks);
+    HDfree(buf);
+    H5Pclose(fapl);
+    HDremove(filename);
+
+    return 0;
+
+error:
+    if(file)
+        H5FDclose(file);
+    HDfree(blocks);
+    HDfree(buf);
+    if(fapl >= 0)
+        H5Pclose(fapl);
+    HDremove(filename);
+    fprintf(stderr, "*** ERRORS DETECTED ***\n");
+    return 1;
+}
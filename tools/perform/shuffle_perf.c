@@ -0,0 +1,212 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Compares the speed of the byte shuffle kernels used by the
+ *		shuffle filter: the portable one and each vector one the CPU
+ *		supports.  Every kernel's output is checked against the
+ *		portable kernel's.
+ */
+
+#define H5Z_FRIEND		/*suppress error about including H5Zpkg	  */
+
+#include "hdf5.h"
+#include "H5private.h"
+#include "H5Zpkg.h"
+
+#define ONE_MB		(1024 * 1024)
+#define DEF_NBYTES	(16 * ONE_MB)	/* Default size of the buffer shuffled */
+#define DEF_NITER	10		/* Default number of passes timed */
+
+static const char *kern_name[H5Z_SHUFFLE_KERN_NKERNS] = {"scalar", "sse2", "avx2"};
+
+
+/*-------------------------------------------------------------------------
+ * Function:	usage
+ *
+ * Purpose:	Prints a usage message and exits.
+ *
+ * Return:	never returns
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-n NBYTES] [-i NITER] [SIZE...]\n", prog);
+    fprintf(stderr, "\
+    Shuffles and unshuffles a buffer of NBYTES bytes (default %d) of\n\
+    elements of each SIZE bytes (default 2, 4, 8, 16 and 3) NITER times\n\
+    (default %d) with each shuffle kernel the CPU supports, and prints\n\
+    the speed of each.\n", DEF_NBYTES, DEF_NITER);
+    exit(1);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	time_kern
+ *
+ * Purpose:	Times NITER passes of one shuffle kernel over NBYTES bytes
+ *		from SRC into DEST.
+ *
+ * Return:	Elapsed wall-clock seconds
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+time_kern(H5Z_shuffle_kern_t kern, hbool_t reverse, unsigned elmt_size,
+    size_t nbytes, unsigned niter, const unsigned char *src, unsigned char *dest)
+{
+    H5_timer_t	timer, total;
+    unsigned	u;
+
+    H5_timer_reset(&total);
+    H5_timer_begin(&timer);
+    for(u = 0; u < niter; u++)
+        H5Z__shuffle_bytes(kern, reverse, elmt_size, nbytes, src, dest);
+    H5_timer_end(&total, &timer);
+
+    return total.etime;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_size
+ *
+ * Purpose:	Times and checks every supported kernel for elements of
+ *		ELMT_SIZE bytes.
+ *
+ * Return:	Success:	0
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_size(unsigned elmt_size, size_t nbytes, unsigned niter,
+    const unsigned char *orig, unsigned char *ref, unsigned char *shuf,
+    unsigned char *unshuf)
+{
+    H5Z_shuffle_kern_t best = H5Z__shuffle_best_kern();
+    double	scalar_time[2] = {0.0, 0.0};
+    int		kern;
+
+    /* The portable kernel's output is the reference */
+    H5Z__shuffle_bytes(H5Z_SHUFFLE_KERN_SCALAR, FALSE, elmt_size, nbytes, orig, ref);
+
+    for(kern = H5Z_SHUFFLE_KERN_SCALAR; kern <= (int)best; kern++) {
+        double	t[2];
+        char	bw[2][32];
+        int	dir;
+
+        /* Check the kernel before timing it */
+        H5Z__shuffle_bytes((H5Z_shuffle_kern_t)kern, FALSE, elmt_size, nbytes, orig, shuf);
+        H5Z__shuffle_bytes((H5Z_shuffle_kern_t)kern, TRUE, elmt_size, nbytes, shuf, unshuf);
+        if(HDmemcmp(shuf, ref, nbytes) || HDmemcmp(unshuf, orig, nbytes)) {
+            fprintf(stderr, "%s kernel output differs for %u-byte elements\n", kern_name[kern], elmt_size);
+            return 1;
+        }
+
+        t[0] = time_kern((H5Z_shuffle_kern_t)kern, FALSE, elmt_size, nbytes, niter, orig, shuf);
+        t[1] = time_kern((H5Z_shuffle_kern_t)kern, TRUE, elmt_size, nbytes, niter, shuf, unshuf);
+        if(kern == H5Z_SHUFFLE_KERN_SCALAR) {
+            scalar_time[0] = t[0];
+            scalar_time[1] = t[1];
+        }
+
+        for(dir = 0; dir < 2; dir++)
+            H5_bandwidth(bw[dir], (double)nbytes * niter, t[dir]);
+        printf("%4u  %-6s  %10s %6.2fx  %10s %6.2fx\n", elmt_size, kern_name[kern],
+               bw[0], t[0] > 0.0 ? scalar_time[0] / t[0] : 0.0,
+               bw[1], t[1] > 0.0 ? scalar_time[1] / t[1] : 0.0);
+    }
+
+    return 0;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	main
+ *
+ * Purpose:	Runs the shuffle kernel benchmark.
+ *
+ * Return:	Success:	0
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(int argc, char *argv[])
+{
+    const unsigned def_sizes[] = {2, 4, 8, 16, 3};
+    unsigned	sizes[64];
+    size_t	nsizes = 0;
+    size_t	nbytes = DEF_NBYTES;
+    unsigned	niter = DEF_NITER;
+    unsigned char *orig = NULL, *ref = NULL, *shuf = NULL, *unshuf = NULL;
+    size_t	i;
+    int		argno, nerrors = 0;
+
+    /* Parse command-line options */
+    for(argno = 1; argno < argc; argno++) {
+        if(!HDstrcmp(argv[argno], "-n") && argno + 1 < argc)
+            nbytes = (size_t)HDstrtoul(argv[++argno], NULL, 0);
+        else if(!HDstrcmp(argv[argno], "-i") && argno + 1 < argc)
+            niter = (unsigned)HDstrtoul(argv[++argno], NULL, 0);
+        else if(HDisdigit(argv[argno][0]) && nsizes < NELMTS(sizes)) {
+            if(0 == (sizes[nsizes++] = (unsigned)HDstrtoul(argv[argno], NULL, 0)))
+                usage(argv[0]);
+        }
+        else
+            usage(argv[0]);
+    }
+    if(0 == nbytes || 0 == niter)
+        usage(argv[0]);
+    if(0 == nsizes)
+        for(nsizes = 0; nsizes < NELMTS(def_sizes); nsizes++)
+            sizes[nsizes] = def_sizes[nsizes];
+
+    if(H5open() < 0)
+        goto error;
+
+    if(NULL == (orig = (unsigned char *)HDmalloc(nbytes)) ||
+            NULL == (ref = (unsigned char *)HDmalloc(nbytes)) ||
+            NULL == (shuf = (unsigned char *)HDmalloc(nbytes)) ||
+            NULL == (unshuf = (unsigned char *)HDmalloc(nbytes)))
+        goto error;
+
+    /* Smooth data, the kind shuffling is used for */
+    for(i = 0; i < nbytes; i++)
+        orig[i] = (unsigned char)(i / 64 + (HDrandom() & 3));
+
+    printf("Shuffling %lu bytes %u times, best kernel: %s\n",
+           (unsigned long)nbytes, niter, kern_name[H5Z__shuffle_best_kern()]);
+    printf("%4s  %-6s  %10s %7s  %10s %7s\n", "Size", "Kernel", "Shuffle", "", "Unshuffle", "");
+    printf("%4s  %-6s  %10s %7s  %10s %7s\n", "----", "------", "-------", "", "---------", "");
+    for(i = 0; i < nsizes; i++)
+        nerrors += test_size(sizes[i], nbytes, niter, orig, ref, shuf, unshuf);
+
+    HDfree(orig);
+    HDfree(ref);
+    HDfree(shuf);
+    HDfree(unshuf);
+
+    if(nerrors)
+        goto error;
+    return 0;
+
+error:
+    fprintf(stderr, "*** ERRORS DETECTED ***\n");
+    return 1;
+}